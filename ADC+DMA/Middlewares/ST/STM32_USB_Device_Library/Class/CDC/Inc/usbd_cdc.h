@@ -95,12 +95,18 @@ typedef struct
   uint8_t  datatype;
 }USBD_CDC_LineCodingTypeDef;
 
+/* Control(cmd, pbuf, length) is called for each class request. With a data
+   stage (length > 0), pbuf is the data buffer: filled by Control for a
+   device to host request, received from the host otherwise. With no data
+   stage (length == 0), pbuf points to the USBD_SetupReqTypedef of the
+   request, for its wValue (e.g. DTR and RTS of CDC_SET_CONTROL_LINE_STATE). */
 typedef struct _USBD_CDC_Itf
 {
   int8_t (* Init)          (void);
   int8_t (* DeInit)        (void);
   int8_t (* Control)       (uint8_t, uint8_t * , uint16_t);   
   int8_t (* Receive)       (uint8_t *, uint32_t *);  
+  int8_t (* TransmitCplt)  (uint8_t *, uint32_t *, uint8_t);  /* Optional, may be NULL */
 
 }USBD_CDC_ItfTypeDef;
 
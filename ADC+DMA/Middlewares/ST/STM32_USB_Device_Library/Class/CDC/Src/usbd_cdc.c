@@ -59,7 +59,7 @@
   */ 
 
 /* Includes ------------------------------------------------------------------*/
-#include "USBD_CDC.h"
+#include "usbd_cdc.h"
 #include "usbd_desc.h"
 #include "usbd_ctlreq.h"
 
@@ -628,9 +628,11 @@ static uint8_t  USBD_CDC_Setup (USBD_HandleTypeDef *pdev,
     }
     else
     {
-        ((USBD_CDC_ItfTypeDef *)pdev->pUserData)->Control(req->bRequest,
-                                                          NULL,
-                                                          0);
+      /* No data stage: the request is passed, for the wValue of
+         CDC_SET_CONTROL_LINE_STATE (DTR, RTS) */
+      ((USBD_CDC_ItfTypeDef *)pdev->pUserData)->Control(req->bRequest,
+                                                        (uint8_t *)req,
+                                                        0);
     }
     break;
  
@@ -655,6 +657,15 @@ static uint8_t  USBD_CDC_DataIn (USBD_HandleTypeDef *pdev, uint8_t epnum)
   {
     
     hcdc->TxState = 0;
+    
+    /* The next transfer can be started from the callback */
+    if((epnum == (CDC_IN_EP & 0x7F)) &&
+       (((USBD_CDC_ItfTypeDef *)pdev->pUserData)->TransmitCplt != NULL))
+    {
+      ((USBD_CDC_ItfTypeDef *)pdev->pUserData)->TransmitCplt(hcdc->TxBuffer,
+                                                             &hcdc->TxLength,
+                                                             epnum);
+    }
 
     return USBD_OK;
   }
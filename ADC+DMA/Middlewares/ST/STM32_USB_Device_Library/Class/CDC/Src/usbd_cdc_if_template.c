@@ -71,13 +71,15 @@ static int8_t TEMPLATE_Init     (void);
 static int8_t TEMPLATE_DeInit   (void);
 static int8_t TEMPLATE_Control  (uint8_t cmd, uint8_t* pbuf, uint16_t length);
 static int8_t TEMPLATE_Receive  (uint8_t* pbuf, uint32_t *Len);
+static int8_t TEMPLATE_TransmitCplt (uint8_t* pbuf, uint32_t *Len, uint8_t epnum);
 
 USBD_CDC_ItfTypeDef USBD_CDC_Template_fops = 
 {
   TEMPLATE_Init,
   TEMPLATE_DeInit,
   TEMPLATE_Control,
-  TEMPLATE_Receive
+  TEMPLATE_Receive,
+  TEMPLATE_TransmitCplt
 };
 
 USBD_CDC_LineCodingTypeDef linecoding =
@@ -123,7 +125,8 @@ static int8_t TEMPLATE_DeInit(void)
   * @brief  TEMPLATE_Control
   *         Manage the CDC class requests
   * @param  Cmd: Command code            
-  * @param  Buf: Buffer containing command data (request parameters)
+  * @param  Buf: Buffer containing command data (request parameters), or the
+  *              USBD_SetupReqTypedef of the request when Len is 0
   * @param  Len: Number of data to be sent (in bytes)
   * @retval Result of the opeartion: USBD_OK if all operations are OK else USBD_FAIL
   */
@@ -174,6 +177,7 @@ static int8_t TEMPLATE_Control  (uint8_t cmd, uint8_t* pbuf, uint16_t length)
     break;
 
   case CDC_SET_CONTROL_LINE_STATE:
+    /* pbuf is the request: DTR is bit 0 and RTS bit 1 of its wValue */
     /* Add your code here */
     break;
 
@@ -209,6 +213,21 @@ static int8_t TEMPLATE_Receive (uint8_t* Buf, uint32_t *Len)
   return (0);
 }
 
+/**
+  * @brief  TEMPLATE_TransmitCplt
+  *         Called in the USB interrupt when the transfer started by
+  *         USBD_CDC_TransmitPacket is complete, the next one can be started.
+  * @param  Buf: Buffer of the data sent
+  * @param  Len: Number of data sent (in bytes)
+  * @param  epnum: IN endpoint number
+  * @retval Result of the opeartion: USBD_OK if all operations are OK else USBD_FAIL
+  */
+static int8_t TEMPLATE_TransmitCplt (uint8_t* Buf, uint32_t *Len, uint8_t epnum)
+{
+ 
+  return (0);
+}
+
 /**
   * @}
   */ 
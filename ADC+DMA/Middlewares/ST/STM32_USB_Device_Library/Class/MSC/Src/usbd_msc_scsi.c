@@ -343,6 +343,13 @@ static int8_t SCSI_ModeSense6 (USBD_HandleTypeDef  *pdev, uint8_t lun, uint8_t *
     len--;
     hmsc->bot_data[len] = MSC_Mode_Sense6_data[len];
   }
+  
+  /* WP bit of the device specific parameter: the host mounts a write
+     protected medium read-only instead of failing its writes */
+  if(((USBD_StorageTypeDef *)pdev->pUserData)->IsWriteProtected(lun) != 0)
+  {
+    hmsc->bot_data[2] |= 0x80;
+  }
   return 0;
 }
 
@@ -365,6 +372,12 @@ static int8_t SCSI_ModeSense10 (USBD_HandleTypeDef  *pdev, uint8_t lun, uint8_t
     len--;
     hmsc->bot_data[len] = MSC_Mode_Sense10_data[len];
   }
+  
+  /* WP bit of the device specific parameter */
+  if(((USBD_StorageTypeDef *)pdev->pUserData)->IsWriteProtected(lun) != 0)
+  {
+    hmsc->bot_data[3] |= 0x80;
+  }
   return 0;
 }
 
@@ -549,12 +562,13 @@ static int8_t SCSI_Write10 (USBD_HandleTypeDef  *pdev, uint8_t lun , uint8_t *pa
       return -1;
     } 
     
-    /* Check If media is write-protected */
+    /* Check If media is write-protected: data protect, which the host does
+       not retry as a medium not ready */
     if(((USBD_StorageTypeDef *)pdev->pUserData)->IsWriteProtected(lun) !=0 )
     {
       SCSI_SenseCode(pdev,
                      lun,
-                     NOT_READY, 
+                     DATA_PROTECT, 
                      WRITE_PROTECTED);
       return -1;
     } 
@@ -0,0 +1,141 @@
+/**
+  ******************************************************************************
+  * @file    usbd_vendor.h
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Header file for the usbd_vendor.c file.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __USB_VENDOR_CORE_H_
+#define __USB_VENDOR_CORE_H_
+
+#include  "usbd_ioreq.h"
+
+/** @addtogroup STM32_USB_DEVICE_LIBRARY
+  * @{
+  */
+
+/** @defgroup USBD_VENDOR
+  * @brief This file is the Header file for usbd_vendor.c
+  * @{
+  */
+
+
+/** @defgroup USBD_VENDOR_Exported_Defines
+  * @{
+  */
+#define VENDOR_IN_EP                       0x81  /* EP1 for data IN */
+
+#define VENDOR_DATA_HS_MAX_PACKET_SIZE     512   /* Endpoint IN packet size */
+#define VENDOR_DATA_FS_MAX_PACKET_SIZE     64    /* Endpoint IN packet size */
+
+/* Largest data stage of the vendor requests */
+#define VENDOR_CTRL_DATA_SIZE              64
+
+#define USB_VENDOR_CONFIG_DESC_SIZ         25
+
+/**
+  * @}
+  */
+
+
+/** @defgroup USBD_VENDOR_Exported_TypesDefinitions
+  * @{
+  */
+
+/**
+  * @brief  Callbacks of the application. Control is called for the vendor
+  *         requests to the interface: for an IN request it writes the data
+  *         to send in pbuf and their number in length (at most wLength), for
+  *         an OUT request it gets the data received in pbuf, after the data
+  *         stage. USBD_FAIL STALLs the request, except after an OUT data
+  *         stage, which is already acknowledged.
+  */
+typedef struct _USBD_VENDOR_Itf
+{
+  int8_t (* Init)          (void);
+  int8_t (* DeInit)        (void);
+  int8_t (* Control)       (USBD_SetupReqTypedef *req, uint8_t *pbuf, uint16_t *length);
+  int8_t (* TransmitCplt)  (uint8_t *pbuf, uint32_t length);  /* Optional, may be NULL */
+
+}USBD_VENDOR_ItfTypeDef;
+
+
+typedef struct
+{
+  uint32_t data[VENDOR_CTRL_DATA_SIZE / 4];      /* Force 32bits alignment */
+  USBD_SetupReqTypedef CmdRequest;               /* Request waiting for its OUT data stage */
+  uint8_t  *TxBuffer;
+  uint32_t TxLength;
+
+  __IO uint32_t TxState;
+}
+USBD_VENDOR_HandleTypeDef;
+
+/**
+  * @}
+  */
+
+
+
+/** @defgroup USBD_VENDOR_Exported_Macros
+  * @{
+  */
+
+/**
+  * @}
+  */
+
+/** @defgroup USBD_VENDOR_Exported_Variables
+  * @{
+  */
+
+extern USBD_ClassTypeDef  USBD_VENDOR;
+#define USBD_VENDOR_CLASS    &USBD_VENDOR
+/**
+  * @}
+  */
+
+/** @defgroup USBD_VENDOR_Exported_Functions
+  * @{
+  */
+uint8_t  USBD_VENDOR_RegisterInterface  (USBD_HandleTypeDef   *pdev,
+                                         USBD_VENDOR_ItfTypeDef *fops);
+
+uint8_t  USBD_VENDOR_Transmit  (USBD_HandleTypeDef *pdev,
+                                uint8_t  *pbuff,
+                                uint32_t length);
+/**
+  * @}
+  */
+
+#endif  /* __USB_VENDOR_CORE_H_ */
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,611 @@
+/**
+  ******************************************************************************
+  * @file    usbd_vendor.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   This file provides the high layer firmware functions to manage a
+  *          vendor specific class with one bulk IN endpoint:
+  *           - Initialization and Configuration of high and low layer
+  *           - Enumeration as vendor specific device (class 0xFF), no driver
+  *             of the PC operating system claims it
+  *           - Vendor requests to the interface, passed to the application
+  *           - Bulk IN transfers straight from the buffers of the application
+  *
+  *  @verbatim
+  *
+  *          ===================================================================
+  *                                VENDOR Class Driver Description
+  *          ===================================================================
+  *           Built from the template class. The application registers its
+  *           callbacks with USBD_VENDOR_RegisterInterface:
+  *             - the vendor requests (bmRequestType 0x41 / 0xC1) go to its
+  *               Control callback, which fills the data of the IN requests
+  *               and may refuse a request: it is then STALLed.
+  *             - USBD_VENDOR_Transmit starts a transfer of any length from a
+  *               buffer of the application, which must stay untouched until
+  *               the TransmitCplt callback. No copy is made: the driver
+  *               writes the packets to the endpoint FIFO from the buffer.
+  *               No zero length packet is added, the application ends its
+  *               transfers as its protocol needs.
+  *
+  *  @endverbatim
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbd_vendor.h"
+#include "usbd_desc.h"
+#include "usbd_ctlreq.h"
+
+
+/** @addtogroup STM32_USB_DEVICE_LIBRARY
+  * @{
+  */
+
+
+/** @defgroup USBD_VENDOR
+  * @brief usbd core module
+  * @{
+  */
+
+/** @defgroup USBD_VENDOR_Private_TypesDefinitions
+  * @{
+  */
+/**
+  * @}
+  */
+
+
+/** @defgroup USBD_VENDOR_Private_Defines
+  * @{
+  */
+
+/**
+  * @}
+  */
+
+
+/** @defgroup USBD_VENDOR_Private_Macros
+  * @{
+  */
+
+/**
+  * @}
+  */
+
+
+
+
+/** @defgroup USBD_VENDOR_Private_FunctionPrototypes
+  * @{
+  */
+
+
+static uint8_t  USBD_VENDOR_Init (USBD_HandleTypeDef *pdev,
+                                  uint8_t cfgidx);
+
+static uint8_t  USBD_VENDOR_DeInit (USBD_HandleTypeDef *pdev,
+                                    uint8_t cfgidx);
+
+static uint8_t  USBD_VENDOR_Setup (USBD_HandleTypeDef *pdev,
+                                   USBD_SetupReqTypedef *req);
+
+static uint8_t  USBD_VENDOR_DataIn (USBD_HandleTypeDef *pdev,
+                                    uint8_t epnum);
+
+static uint8_t  USBD_VENDOR_EP0_RxReady (USBD_HandleTypeDef *pdev);
+
+static uint8_t  *USBD_VENDOR_GetFSCfgDesc (uint16_t *length);
+
+static uint8_t  *USBD_VENDOR_GetHSCfgDesc (uint16_t *length);
+
+static uint8_t  *USBD_VENDOR_GetOtherSpeedCfgDesc (uint16_t *length);
+
+uint8_t  *USBD_VENDOR_GetDeviceQualifierDescriptor (uint16_t *length);
+
+/**
+  * @}
+  */
+
+/** @defgroup USBD_VENDOR_Private_Variables
+  * @{
+  */
+
+USBD_ClassTypeDef  USBD_VENDOR =
+{
+  USBD_VENDOR_Init,
+  USBD_VENDOR_DeInit,
+  USBD_VENDOR_Setup,
+  NULL,                 /* EP0_TxSent */
+  USBD_VENDOR_EP0_RxReady,
+  USBD_VENDOR_DataIn,
+  NULL,                 /* DataOut: no OUT endpoint */
+  NULL,                 /* SOF */
+  NULL,
+  NULL,
+  USBD_VENDOR_GetHSCfgDesc,
+  USBD_VENDOR_GetFSCfgDesc,
+  USBD_VENDOR_GetOtherSpeedCfgDesc,
+  USBD_VENDOR_GetDeviceQualifierDescriptor,
+};
+
+/* USB VENDOR device Configuration Descriptor */
+__ALIGN_BEGIN static uint8_t USBD_VENDOR_CfgHSDesc[USB_VENDOR_CONFIG_DESC_SIZ] __ALIGN_END =
+{
+  0x09, /* bLength: Configuation Descriptor size */
+  USB_DESC_TYPE_CONFIGURATION, /* bDescriptorType: Configuration */
+  USB_VENDOR_CONFIG_DESC_SIZ,
+  /* wTotalLength: Bytes returned */
+  0x00,
+  0x01,         /*bNumInterfaces: 1 interface*/
+  0x01,         /*bConfigurationValue: Configuration value*/
+  0x00,         /*iConfiguration: Index of string descriptor describing the configuration*/
+  0xC0,         /*bmAttributes: self powered */
+  0x32,         /*MaxPower 100 mA: this current is used for detecting Vbus*/
+  /* 09 */
+
+  /**********  Descriptor of VENDOR interface 0 Alternate setting 0 **************/
+  0x09,   /* bLength: Interface Descriptor size */
+  USB_DESC_TYPE_INTERFACE,  /* bDescriptorType: Interface */
+  0x00,   /* bInterfaceNumber: Number of Interface */
+  0x00,   /* bAlternateSetting: Alternate setting */
+  0x01,   /* bNumEndpoints: One endpoint used */
+  0xFF,   /* bInterfaceClass: Vendor specific */
+  0x00,   /* bInterfaceSubClass */
+  0x00,   /* bInterfaceProtocol */
+  0x00,   /* iInterface */
+  /* 18 */
+
+  /*Endpoint IN Descriptor*/
+  0x07,   /* bLength: Endpoint Descriptor size */
+  USB_DESC_TYPE_ENDPOINT,      /* bDescriptorType: Endpoint */
+  VENDOR_IN_EP,                      /* bEndpointAddress */
+  0x02,                              /* bmAttributes: Bulk */
+  LOBYTE(VENDOR_DATA_HS_MAX_PACKET_SIZE),  /* wMaxPacketSize: */
+  HIBYTE(VENDOR_DATA_HS_MAX_PACKET_SIZE),
+  0x00                               /* bInterval: ignore for Bulk transfer */
+  /* 25 */
+};
+
+/* USB VENDOR device Configuration Descriptor */
+__ALIGN_BEGIN static uint8_t USBD_VENDOR_CfgFSDesc[USB_VENDOR_CONFIG_DESC_SIZ] __ALIGN_END =
+{
+  0x09, /* bLength: Configuation Descriptor size */
+  USB_DESC_TYPE_CONFIGURATION, /* bDescriptorType: Configuration */
+  USB_VENDOR_CONFIG_DESC_SIZ,
+  /* wTotalLength: Bytes returned */
+  0x00,
+  0x01,         /*bNumInterfaces: 1 interface*/
+  0x01,         /*bConfigurationValue: Configuration value*/
+  0x00,         /*iConfiguration: Index of string descriptor describing the configuration*/
+  0xC0,         /*bmAttributes: self powered */
+  0x32,         /*MaxPower 100 mA: this current is used for detecting Vbus*/
+  /* 09 */
+
+  /**********  Descriptor of VENDOR interface 0 Alternate setting 0 **************/
+  0x09,   /* bLength: Interface Descriptor size */
+  USB_DESC_TYPE_INTERFACE,  /* bDescriptorType: Interface */
+  0x00,   /* bInterfaceNumber: Number of Interface */
+  0x00,   /* bAlternateSetting: Alternate setting */
+  0x01,   /* bNumEndpoints: One endpoint used */
+  0xFF,   /* bInterfaceClass: Vendor specific */
+  0x00,   /* bInterfaceSubClass */
+  0x00,   /* bInterfaceProtocol */
+  0x00,   /* iInterface */
+  /* 18 */
+
+  /*Endpoint IN Descriptor*/
+  0x07,   /* bLength: Endpoint Descriptor size */
+  USB_DESC_TYPE_ENDPOINT,      /* bDescriptorType: Endpoint */
+  VENDOR_IN_EP,                      /* bEndpointAddress */
+  0x02,                              /* bmAttributes: Bulk */
+  LOBYTE(VENDOR_DATA_FS_MAX_PACKET_SIZE),  /* wMaxPacketSize: */
+  HIBYTE(VENDOR_DATA_FS_MAX_PACKET_SIZE),
+  0x00                               /* bInterval: ignore for Bulk transfer */
+  /* 25 */
+};
+
+__ALIGN_BEGIN static uint8_t USBD_VENDOR_OtherSpeedCfgDesc[USB_VENDOR_CONFIG_DESC_SIZ] __ALIGN_END =
+{
+  0x09,   /* bLength: Configuation Descriptor size */
+  USB_DESC_TYPE_OTHER_SPEED_CONFIGURATION,
+  USB_VENDOR_CONFIG_DESC_SIZ,
+  0x00,
+  0x01,   /* bNumInterfaces: 1 interface */
+  0x01,   /* bConfigurationValue: */
+  0x00,   /* iConfiguration: */
+  0xC0,   /* bmAttributes: */
+  0x32,   /* MaxPower 100 mA */
+
+  /**********  Descriptor of VENDOR interface 0 Alternate setting 0 **************/
+  0x09,   /* bLength: Interface Descriptor size */
+  USB_DESC_TYPE_INTERFACE,  /* bDescriptorType: Interface */
+  0x00,   /* bInterfaceNumber: Number of Interface */
+  0x00,   /* bAlternateSetting: Alternate setting */
+  0x01,   /* bNumEndpoints: One endpoint used */
+  0xFF,   /* bInterfaceClass: Vendor specific */
+  0x00,   /* bInterfaceSubClass */
+  0x00,   /* bInterfaceProtocol */
+  0x00,   /* iInterface */
+
+  /*Endpoint IN Descriptor*/
+  0x07,   /* bLength: Endpoint Descriptor size */
+  USB_DESC_TYPE_ENDPOINT,     /* bDescriptorType: Endpoint */
+  VENDOR_IN_EP,                     /* bEndpointAddress */
+  0x02,                             /* bmAttributes: Bulk */
+  0x40,                             /* wMaxPacketSize: */
+  0x00,
+  0x00                              /* bInterval */
+};
+
+/* USB Standard Device Descriptor */
+__ALIGN_BEGIN static uint8_t USBD_VENDOR_DeviceQualifierDesc[USB_LEN_DEV_QUALIFIER_DESC] __ALIGN_END =
+{
+  USB_LEN_DEV_QUALIFIER_DESC,
+  USB_DESC_TYPE_DEVICE_QUALIFIER,
+  0x00,
+  0x02,
+  0x00,
+  0x00,
+  0x00,
+  0x40,
+  0x01,
+  0x00,
+};
+
+/**
+  * @}
+  */
+
+/** @defgroup USBD_VENDOR_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  USBD_VENDOR_Init
+  *         Initialize the VENDOR interface
+  * @param  pdev: device instance
+  * @param  cfgidx: Configuration index
+  * @retval status
+  */
+static uint8_t  USBD_VENDOR_Init (USBD_HandleTypeDef *pdev,
+                                  uint8_t cfgidx)
+{
+  uint8_t ret = 0;
+  USBD_VENDOR_HandleTypeDef   *hvendor;
+
+  if(pdev->dev_speed == USBD_SPEED_HIGH  )
+  {
+    /* Open EP IN */
+    USBD_LL_OpenEP(pdev,
+                   VENDOR_IN_EP,
+                   USBD_EP_TYPE_BULK,
+                   VENDOR_DATA_HS_MAX_PACKET_SIZE);
+  }
+  else
+  {
+    /* Open EP IN */
+    USBD_LL_OpenEP(pdev,
+                   VENDOR_IN_EP,
+                   USBD_EP_TYPE_BULK,
+                   VENDOR_DATA_FS_MAX_PACKET_SIZE);
+  }
+
+  pdev->pClassData = USBD_malloc(sizeof (USBD_VENDOR_HandleTypeDef));
+
+  if(pdev->pClassData == NULL)
+  {
+    ret = 1;
+  }
+  else
+  {
+    hvendor = pdev->pClassData;
+
+    /* Init Xfer states */
+    hvendor->TxState = 0;
+    hvendor->CmdRequest.bmRequest = 0;
+
+    /* Init  physical Interface components */
+    ((USBD_VENDOR_ItfTypeDef *)pdev->pUserData)->Init();
+  }
+  return ret;
+}
+
+/**
+  * @brief  USBD_VENDOR_DeInit
+  *         DeInitialize the VENDOR layer
+  * @param  pdev: device instance
+  * @param  cfgidx: Configuration index
+  * @retval status
+  */
+static uint8_t  USBD_VENDOR_DeInit (USBD_HandleTypeDef *pdev,
+                                    uint8_t cfgidx)
+{
+  /* Close EP IN */
+  USBD_LL_CloseEP(pdev,
+                  VENDOR_IN_EP);
+
+  /* DeInit  physical Interface components */
+  if(pdev->pClassData != NULL)
+  {
+    ((USBD_VENDOR_ItfTypeDef *)pdev->pUserData)->DeInit();
+    USBD_free(pdev->pClassData);
+    pdev->pClassData = NULL;
+  }
+
+  return USBD_OK;
+}
+
+/**
+  * @brief  USBD_VENDOR_Setup
+  *         Handle the VENDOR specific requests
+  * @param  pdev: instance
+  * @param  req: usb requests
+  * @retval status
+  */
+static uint8_t  USBD_VENDOR_Setup (USBD_HandleTypeDef *pdev,
+                                   USBD_SetupReqTypedef *req)
+{
+  USBD_VENDOR_HandleTypeDef   *hvendor = pdev->pClassData;
+  uint16_t len = 0;
+
+  switch (req->bmRequest & USB_REQ_TYPE_MASK)
+  {
+  case USB_REQ_TYPE_VENDOR :
+    if ((req->wLength != 0) && ((req->bmRequest & 0x80) == 0))
+    {
+      /* The data are passed to the application after the data stage */
+      if (req->wLength > VENDOR_CTRL_DATA_SIZE)
+      {
+        USBD_CtlError (pdev, req);
+        return USBD_FAIL;
+      }
+      hvendor->CmdRequest = *req;
+      USBD_CtlPrepareRx (pdev,
+                         (uint8_t *)hvendor->data,
+                         req->wLength);
+    }
+    else
+    {
+      if (((USBD_VENDOR_ItfTypeDef *)pdev->pUserData)->Control(req,
+                                                               (uint8_t *)hvendor->data,
+                                                               &len) != USBD_OK)
+      {
+        USBD_CtlError (pdev, req);
+        return USBD_FAIL;
+      }
+      if (req->wLength != 0)
+      {
+        USBD_CtlSendData (pdev,
+                          (uint8_t *)hvendor->data,
+                          MIN(len, req->wLength));
+      }
+    }
+    break;
+
+  case USB_REQ_TYPE_STANDARD:
+    switch (req->bRequest)
+    {
+    case USB_REQ_GET_INTERFACE :
+      /* Alternate setting 0 only */
+      *(uint8_t *)hvendor->data = 0;
+      USBD_CtlSendData (pdev,
+                        (uint8_t *)hvendor->data,
+                        1);
+      break;
+
+    case USB_REQ_SET_INTERFACE :
+      if (req->wValue != 0)
+      {
+        USBD_CtlError (pdev, req);
+        return USBD_FAIL;
+      }
+      break;
+
+    default:
+      break;
+    }
+    break;
+
+  default:
+    USBD_CtlError (pdev, req);
+    return USBD_FAIL;
+  }
+  return USBD_OK;
+}
+
+/**
+  * @brief  USBD_VENDOR_DataIn
+  *         Data sent on non-control IN endpoint
+  * @param  pdev: device instance
+  * @param  epnum: endpoint number
+  * @retval status
+  */
+static uint8_t  USBD_VENDOR_DataIn (USBD_HandleTypeDef *pdev, uint8_t epnum)
+{
+  USBD_VENDOR_HandleTypeDef   *hvendor = pdev->pClassData;
+
+  if(pdev->pClassData != NULL)
+  {
+    hvendor->TxState = 0;
+
+    /* The next transfer can be started from the callback */
+    if(((USBD_VENDOR_ItfTypeDef *)pdev->pUserData)->TransmitCplt != NULL)
+    {
+      ((USBD_VENDOR_ItfTypeDef *)pdev->pUserData)->TransmitCplt(hvendor->TxBuffer,
+                                                                hvendor->TxLength);
+    }
+    return USBD_OK;
+  }
+  else
+  {
+    return USBD_FAIL;
+  }
+}
+
+/**
+  * @brief  USBD_VENDOR_EP0_RxReady
+  *         Data stage of a vendor OUT request received
+  * @param  pdev: device instance
+  * @retval status
+  */
+static uint8_t  USBD_VENDOR_EP0_RxReady (USBD_HandleTypeDef *pdev)
+{
+  USBD_VENDOR_HandleTypeDef   *hvendor = pdev->pClassData;
+  uint16_t len;
+
+  if((hvendor != NULL) && (hvendor->CmdRequest.bmRequest != 0))
+  {
+    len = hvendor->CmdRequest.wLength;
+    ((USBD_VENDOR_ItfTypeDef *)pdev->pUserData)->Control(&hvendor->CmdRequest,
+                                                         (uint8_t *)hvendor->data,
+                                                         &len);
+    hvendor->CmdRequest.bmRequest = 0;
+  }
+  return USBD_OK;
+}
+
+/**
+  * @brief  USBD_VENDOR_GetFSCfgDesc
+  *         Return configuration descriptor
+  * @param  length : pointer data length
+  * @retval pointer to descriptor buffer
+  */
+static uint8_t  *USBD_VENDOR_GetFSCfgDesc (uint16_t *length)
+{
+  *length = sizeof (USBD_VENDOR_CfgFSDesc);
+  return USBD_VENDOR_CfgFSDesc;
+}
+
+/**
+  * @brief  USBD_VENDOR_GetHSCfgDesc
+  *         Return configuration descriptor
+  * @param  length : pointer data length
+  * @retval pointer to descriptor buffer
+  */
+static uint8_t  *USBD_VENDOR_GetHSCfgDesc (uint16_t *length)
+{
+  *length = sizeof (USBD_VENDOR_CfgHSDesc);
+  return USBD_VENDOR_CfgHSDesc;
+}
+
+/**
+  * @brief  USBD_VENDOR_GetOtherSpeedCfgDesc
+  *         Return configuration descriptor
+  * @param  length : pointer data length
+  * @retval pointer to descriptor buffer
+  */
+static uint8_t  *USBD_VENDOR_GetOtherSpeedCfgDesc (uint16_t *length)
+{
+  *length = sizeof (USBD_VENDOR_OtherSpeedCfgDesc);
+  return USBD_VENDOR_OtherSpeedCfgDesc;
+}
+
+/**
+* @brief  DeviceQualifierDescriptor
+*         return Device Qualifier descriptor
+* @param  length : pointer data length
+* @retval pointer to descriptor buffer
+*/
+uint8_t  *USBD_VENDOR_GetDeviceQualifierDescriptor (uint16_t *length)
+{
+  *length = sizeof (USBD_VENDOR_DeviceQualifierDesc);
+  return USBD_VENDOR_DeviceQualifierDesc;
+}
+
+/**
+  * @brief  USBD_VENDOR_RegisterInterface
+  * @param  pdev: device instance
+  * @param  fops: Interface callbacks
+  * @retval status
+  */
+uint8_t  USBD_VENDOR_RegisterInterface  (USBD_HandleTypeDef   *pdev,
+                                         USBD_VENDOR_ItfTypeDef *fops)
+{
+  uint8_t  ret = USBD_FAIL;
+
+  if(fops != NULL)
+  {
+    pdev->pUserData= fops;
+    ret = USBD_OK;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  USBD_VENDOR_Transmit
+  *         Starts a transfer on the IN endpoint. The buffer is sent as is,
+  *         it belongs to the driver until the TransmitCplt callback.
+  * @param  pdev: device instance
+  * @param  pbuff: Data to send
+  * @param  length: Number of bytes
+  * @retval USBD_OK, USBD_BUSY while the previous transfer is on the bus, or
+  *         USBD_FAIL if the device is not configured
+  */
+uint8_t  USBD_VENDOR_Transmit(USBD_HandleTypeDef *pdev,
+                              uint8_t  *pbuff,
+                              uint32_t length)
+{
+  USBD_VENDOR_HandleTypeDef   *hvendor = pdev->pClassData;
+
+  if(pdev->pClassData != NULL)
+  {
+    if(hvendor->TxState == 0)
+    {
+      /* Tx Transfer in progress */
+      hvendor->TxState = 1;
+      hvendor->TxBuffer = pbuff;
+      hvendor->TxLength = length;
+
+      USBD_LL_Transmit(pdev,
+                       VENDOR_IN_EP,
+                       pbuff,
+                       length);
+      return USBD_OK;
+    }
+    else
+    {
+      return USBD_BUSY;
+    }
+  }
+  else
+  {
+    return USBD_FAIL;
+  }
+}
+
+/**
+  * @}
+  */
+
+
+/**
+  * @}
+  */
+
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
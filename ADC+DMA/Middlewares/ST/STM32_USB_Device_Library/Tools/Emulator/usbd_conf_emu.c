@@ -0,0 +1,980 @@
+/**
+  ******************************************************************************
+  * @file    usbd_conf_emu.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   USB Device low level driver on a host emulator of the USB OTG FS
+  *          controller, in place of the HAL_PCD driver of usbd_conf.c
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbd_core.h"
+#include "usbd_emu.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Endpoint, as the endpoints of the OTG FS core */
+typedef struct
+{
+  uint8_t  open;
+  uint8_t  type;
+  uint16_t mps;
+  uint8_t  stalled;
+  uint8_t  *buff;
+  uint32_t length;
+  uint32_t count;                   /* Transferred bytes */
+  uint8_t  state;                   /* EMU_EP_xxx */
+  uint64_t next;                    /* Time of the completion interrupt */
+}EMU_EndpointTypeDef;
+
+/* Pipe of the host. IN: the host polls the endpoint while its buffer has
+   room for a packet. OUT: the host sends the transfer written in its buffer,
+   from head, fill bytes left. A STALL halts the pipe until the host clears
+   the halt of the endpoint */
+typedef struct
+{
+  uint8_t  *buff;
+  uint32_t size;
+  uint32_t head;
+  uint32_t fill;
+  uint8_t  halted;
+}EMU_PipeTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define EMU_ENDPOINTS             4
+
+#define EMU_EP_IDLE               0
+#define EMU_EP_XFER               1 /* Transactions on the bus */
+#define EMU_EP_DONE               2 /* Completion interrupt pending */
+
+/* Largest bulk packet at full speed, the room the host needs to poll */
+#define EMU_PIPE_MPS              64
+
+/* Full speed bus: 12 Mbit/s, 1 ms frames */
+#define EMU_BIT_TIME(bits)        (((uint64_t)(bits) * 1000) / 12)
+#define EMU_FRAME_NS              1000000ULL
+#define EMU_SOF_NS                EMU_BIT_TIME(48)
+#define EMU_EOF_NS                EMU_BIT_TIME(32)
+
+/* Token, data and handshake packets with the inter packet delays */
+#define EMU_DATA_NS(len)          EMU_BIT_TIME(121 + 8 * (len))
+#define EMU_HANDSHAKE_NS          EMU_BIT_TIME(70)
+
+/* Transfer complete interrupt of the HAL after the last packet, before the
+   endpoint can be armed again */
+#define EMU_IRQ_NS                2000ULL
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static USBD_HandleTypeDef *Emu_Device = NULL;
+static EMU_EndpointTypeDef Emu_In[EMU_ENDPOINTS];
+static EMU_EndpointTypeDef Emu_Out[EMU_ENDPOINTS];
+static EMU_PipeTypeDef Emu_Pipe[EMU_ENDPOINTS];
+static EMU_PipeTypeDef Emu_OutPipe[EMU_ENDPOINTS];
+static uint8_t  Emu_Setup[8];
+static uint8_t  Emu_Started = 0;          /* Pull-up on D+ */
+static uint8_t  Emu_Attached = 0;
+static uint8_t  Emu_Address = 0;
+static uint8_t  Emu_NextPipe = 0;          /* Pipe polled first, in turn */
+
+/* Emulated time in ns */
+static uint64_t Emu_Now = 0;
+static uint64_t Emu_BusFree = 0;
+static uint64_t Emu_NextSof = 0;
+static uint8_t  Emu_InAdvance = 0;
+
+static USBD_EMU_StatsTypeDef EMU_Stats;
+
+/* Private function prototypes -----------------------------------------------*/
+static void    EMU_Advance(uint64_t until);
+static void    EMU_Transaction(uint8_t num);
+static void    EMU_OutTransaction(uint8_t num);
+static uint8_t EMU_PollPipe(void);
+static void    EMU_AbortEndpoints(void);
+
+/* Private functions ---------------------------------------------------------*/
+
+/*******************************************************************************
+                       Emulator control
+*******************************************************************************/
+/**
+  * @brief  Attaches the device to the emulated host, or resets the bus if it
+  *         is attached: the endpoints are aborted, the data not read by the
+  *         host are lost, and the stack sees the reset as from the HAL.
+  * @param  None
+  * @retval None
+  */
+void USBD_EMU_Attach(void)
+{
+  uint8_t i;
+
+  if(!Emu_Started || (Emu_Device == NULL))
+  {
+    return;
+  }
+
+  EMU_AbortEndpoints();
+  for(i = 0; i < EMU_ENDPOINTS; i++)
+  {
+    Emu_Pipe[i].head = 0;
+    Emu_Pipe[i].fill = 0;
+    Emu_Pipe[i].halted = 0;
+    Emu_OutPipe[i].head = 0;
+    Emu_OutPipe[i].fill = 0;
+    Emu_OutPipe[i].halted = 0;
+  }
+  Emu_Address = 0;
+  Emu_Attached = 1;
+  Emu_NextSof = Emu_Now;
+  Emu_BusFree = Emu_Now;
+
+  /* As HAL_PCD_ResetCallback */
+  USBD_LL_SetSpeed(Emu_Device, USBD_SPEED_FULL);
+  USBD_LL_Reset(Emu_Device);
+}
+
+/**
+  * @brief  Runs a control transfer of the host: setup, data and status
+  *         stages, followed by the frame the host takes for it.
+  * @param  setup: The 8 bytes of the setup packet
+  * @param  data: Data of the OUT stage, or receives the data of the IN stage
+  * @param  length: Receives the number of data bytes transferred, may be NULL
+  * @retval USBD_OK, or USBD_FAIL if the device STALLed the request or broke
+  *         the control sequence
+  */
+uint8_t USBD_EMU_Control(const uint8_t *setup, uint8_t *data, uint16_t *length)
+{
+  EMU_EndpointTypeDef *in = &Emu_In[0], *out = &Emu_Out[0];
+  uint16_t wlength = setup[6] | (setup[7] << 8);
+  uint16_t count = 0, n;
+  uint8_t  status = USBD_OK;
+
+  if(!Emu_Attached)
+  {
+    return USBD_FAIL;
+  }
+  EMU_Stats.setups++;
+
+  /* A SETUP packet is always accepted, and clears the stall of EP0 */
+  memcpy(Emu_Setup, setup, sizeof(Emu_Setup));
+  in->stalled = 0;
+  out->stalled = 0;
+  in->state = EMU_EP_IDLE;
+  out->state = EMU_EP_IDLE;
+  Emu_InAdvance = 1;
+  USBD_LL_SetupStage(Emu_Device, Emu_Setup);
+
+  if((setup[0] & 0x80) && (wlength != 0))
+  {
+    /* Data IN stage, up to a short packet, then status OUT */
+    for(;;)
+    {
+      if(in->stalled || (in->state != EMU_EP_XFER))
+      {
+        status = USBD_FAIL;
+        break;
+      }
+      /* One packet per transfer on EP0, as the HAL */
+      n = in->length - in->count;
+      n = (n < in->mps) ? n : in->mps;
+      if(n > wlength - count)
+      {
+        /* Babble */
+        EMU_Stats.errors++;
+        n = wlength - count;
+      }
+      if(n != 0)
+      {
+        memcpy(data + count, in->buff + in->count, n);
+      }
+      in->count += n;
+      count += n;
+      in->state = EMU_EP_IDLE;
+      USBD_LL_DataInStage(Emu_Device, 0, (in->buff != NULL) ? in->buff + in->count : NULL);
+      if((n < in->mps) || (count == wlength))
+      {
+        break;
+      }
+    }
+    if(status == USBD_OK)
+    {
+      if(out->stalled || (out->state != EMU_EP_XFER))
+      {
+        status = USBD_FAIL;
+      }
+      else
+      {
+        out->state = EMU_EP_IDLE;
+        out->count = 0;
+        USBD_LL_DataOutStage(Emu_Device, 0, out->buff);
+      }
+    }
+  }
+  else
+  {
+    /* Data OUT stage, then status IN */
+    while((status == USBD_OK) && (count < wlength))
+    {
+      if(out->stalled || (out->state != EMU_EP_XFER))
+      {
+        status = USBD_FAIL;
+        break;
+      }
+      n = wlength - count;
+      n = (n < out->mps) ? n : out->mps;
+      if(n > out->length)
+      {
+        EMU_Stats.errors++;
+        n = out->length;
+      }
+      memcpy(out->buff, data + count, n);
+      out->count = n;
+      count += n;
+      out->state = EMU_EP_IDLE;
+      USBD_LL_DataOutStage(Emu_Device, 0, out->buff + n);
+    }
+    if(status == USBD_OK)
+    {
+      if(in->stalled || (in->state != EMU_EP_XFER) || (in->length != 0))
+      {
+        status = USBD_FAIL;
+      }
+      else
+      {
+        in->state = EMU_EP_IDLE;
+        USBD_LL_DataInStage(Emu_Device, 0, NULL);
+      }
+    }
+  }
+  Emu_InAdvance = 0;
+
+  if(status != USBD_OK)
+  {
+    if(in->stalled || out->stalled)
+    {
+      EMU_Stats.stalls++;
+    }
+    else
+    {
+      /* The device neither answered nor STALLed */
+      EMU_Stats.errors++;
+    }
+  }
+  else if((setup[0] == 0x02) && (setup[1] == USB_REQ_CLEAR_FEATURE) &&
+          (setup[2] == USB_FEATURE_EP_HALT) && (setup[3] == 0))
+  {
+    /* The host resumes the pipe of the endpoint */
+    if(setup[4] & 0x80)
+    {
+      Emu_Pipe[setup[4] & 0x7F & (EMU_ENDPOINTS - 1)].halted = 0;
+    }
+    else
+    {
+      Emu_OutPipe[setup[4] & (EMU_ENDPOINTS - 1)].halted = 0;
+    }
+  }
+  if(length != NULL)
+  {
+    *length = count;
+  }
+
+  EMU_Advance(Emu_Now + EMU_FRAME_NS);
+  return status;
+}
+
+/**
+  * @brief  Starts the reading of the host on an IN endpoint, as an open port
+  *         of the PC, or opens an OUT endpoint for USBD_EMU_Write.
+  * @param  ep_addr: Endpoint address
+  * @param  buffer_size: IN: bytes the host buffers before the application
+  *         reads them. OUT: largest transfer written.
+  * @retval None
+  */
+void USBD_EMU_OpenPipe(uint8_t ep_addr, uint32_t buffer_size)
+{
+  EMU_PipeTypeDef *pipe = (ep_addr & 0x80) ? &Emu_Pipe[ep_addr & 0x7F] : &Emu_OutPipe[ep_addr];
+
+  USBD_EMU_ClosePipe(ep_addr);
+  pipe->buff = malloc(buffer_size);
+  pipe->size = (pipe->buff != NULL) ? buffer_size : 0;
+}
+
+/**
+  * @brief  Stops the reading of the host on an IN endpoint, the data it has
+  *         buffered are lost, or the transfer on an OUT endpoint.
+  * @param  ep_addr: Endpoint address
+  * @retval None
+  */
+void USBD_EMU_ClosePipe(uint8_t ep_addr)
+{
+  EMU_PipeTypeDef *pipe = (ep_addr & 0x80) ? &Emu_Pipe[ep_addr & 0x7F] : &Emu_OutPipe[ep_addr];
+
+  free(pipe->buff);
+  memset(pipe, 0, sizeof(*pipe));
+}
+
+/**
+  * @brief  Reads the data the host received on an IN endpoint.
+  * @param  ep_addr: IN endpoint address
+  * @param  buff: Receives the data
+  * @param  length: Size of the buffer
+  * @retval Number of bytes read
+  */
+uint32_t USBD_EMU_Read(uint8_t ep_addr, uint8_t *buff, uint32_t length)
+{
+  EMU_PipeTypeDef *pipe = &Emu_Pipe[ep_addr & 0x7F];
+  uint32_t n, count = 0;
+
+  while((length > 0) && (pipe->fill > 0))
+  {
+    n = pipe->size - pipe->head;
+    n = (n < pipe->fill) ? n : pipe->fill;
+    n = (n < length) ? n : length;
+    memcpy(buff, pipe->buff + pipe->head, n);
+    pipe->head = (pipe->head + n) % pipe->size;
+    pipe->fill -= n;
+    buff += n;
+    length -= n;
+    count += n;
+  }
+  return count;
+}
+
+/**
+  * @brief  Starts a transfer of the host on an OUT endpoint. It is sent by
+  *         packets of the endpoint size as the time runs, the last one short
+  *         or full, without zero length packet.
+  * @param  ep_addr: OUT endpoint address
+  * @param  buff: Data of the transfer
+  * @param  length: Number of bytes, up to the size given to USBD_EMU_OpenPipe
+  * @retval length, or 0 while the previous transfer is pending or the pipe is
+  *         halted
+  */
+uint32_t USBD_EMU_Write(uint8_t ep_addr, const uint8_t *buff, uint32_t length)
+{
+  EMU_PipeTypeDef *pipe = &Emu_OutPipe[ep_addr & 0x7F];
+
+  if((pipe->fill != 0) || pipe->halted || (length == 0) || (length > pipe->size))
+  {
+    return 0;
+  }
+  memcpy(pipe->buff, buff, length);
+  pipe->head = 0;
+  pipe->fill = length;
+  return length;
+}
+
+/**
+  * @brief  Returns the bytes of the transfer on an OUT endpoint not sent yet.
+  * @param  ep_addr: OUT endpoint address
+  * @retval Number of bytes, 0 once the transfer is done or aborted by a STALL
+  */
+uint32_t USBD_EMU_Pending(uint8_t ep_addr)
+{
+  return Emu_OutPipe[ep_addr & 0x7F].fill;
+}
+
+/**
+  * @brief  Tells whether the device STALLed the pipe of an endpoint: the
+  *         host neither polls nor sends on it until a CLEAR_FEATURE
+  *         (ENDPOINT_HALT) of the endpoint is run with USBD_EMU_Control.
+  * @param  ep_addr: Endpoint address
+  * @retval 1 if halted
+  */
+uint8_t USBD_EMU_Halted(uint8_t ep_addr)
+{
+  return (ep_addr & 0x80) ? Emu_Pipe[ep_addr & 0x7F].halted : Emu_OutPipe[ep_addr].halted;
+}
+
+/**
+  * @brief  Lets the emulated time run, with its interrupts, as the
+  *         application code between two events of its loop.
+  * @param  us: Time in us
+  * @retval None
+  */
+void USBD_EMU_Run(uint32_t us)
+{
+  EMU_Advance(Emu_Now + (uint64_t)us * 1000);
+}
+
+/**
+  * @brief  Returns the emulated time.
+  * @param  None
+  * @retval Time in us
+  */
+uint64_t USBD_EMU_GetTime(void)
+{
+  return Emu_Now / 1000;
+}
+
+/**
+  * @brief  Returns the counters of the emulated bus and host.
+  * @param  stats: Receives the counters
+  * @retval None
+  */
+void USBD_EMU_GetStats(USBD_EMU_StatsTypeDef *stats)
+{
+  *stats = EMU_Stats;
+}
+
+/**
+  * @brief  Clears the counters of the emulated bus and host.
+  * @param  None
+  * @retval None
+  */
+void USBD_EMU_ResetStats(void)
+{
+  memset(&EMU_Stats, 0, sizeof(EMU_Stats));
+}
+
+/*******************************************************************************
+                       Emulated controller
+*******************************************************************************/
+/**
+  * @brief  Runs the emulated time up to a date: start of frames, IN and OUT
+  *         transactions of the host and transfer complete interrupts, in
+  *         their order. The callbacks of the stack are called as from the
+  *         interrupt handler.
+  * @param  until: Date in ns
+  * @retval None
+  */
+static void EMU_Advance(uint64_t until)
+{
+  EMU_EndpointTypeDef *ep;
+  uint64_t t, start;
+  uint8_t  i, what, num = 0;
+
+  if(Emu_InAdvance)
+  {
+    return;
+  }
+  Emu_InAdvance = 1;
+
+  for(;;)
+  {
+    t = until;
+    what = 0;
+
+    if(Emu_Attached && (Emu_NextSof <= t))
+    {
+      t = Emu_NextSof;
+      what = 1;
+    }
+    for(i = 1; i < EMU_ENDPOINTS; i++)
+    {
+      ep = &Emu_In[i];
+      if((ep->state == EMU_EP_DONE) && ((ep->next < t) || ((ep->next == t) && (what == 0))))
+      {
+        t = ep->next;
+        what = 2;
+        num = i;
+      }
+      ep = &Emu_Out[i];
+      if((ep->state == EMU_EP_DONE) && ((ep->next < t) || ((ep->next == t) && (what == 0))))
+      {
+        t = ep->next;
+        what = 4;
+        num = i;
+      }
+    }
+    if(Emu_Attached && ((i = EMU_PollPipe()) != 0xFF))
+    {
+      start = (Emu_BusFree > Emu_Now) ? Emu_BusFree : Emu_Now;
+      if((start < t) || ((start == t) && (what == 0)))
+      {
+        t = start;
+        what = 3;
+        num = i;
+      }
+    }
+    if(what == 0)
+    {
+      break;
+    }
+    Emu_Now = t;
+
+    switch(what)
+    {
+    case 1:
+      if(Emu_BusFree < Emu_Now + EMU_SOF_NS)
+      {
+        Emu_BusFree = Emu_Now + EMU_SOF_NS;
+      }
+      Emu_NextSof += EMU_FRAME_NS;
+      EMU_Stats.sofs++;
+      USBD_LL_SOF(Emu_Device);
+      break;
+
+    case 2:
+      /* As HAL_PCD_DataInStageCallback, with the buffer past the data */
+      ep = &Emu_In[num];
+      ep->state = EMU_EP_IDLE;
+      EMU_Stats.transfers++;
+      USBD_LL_DataInStage(Emu_Device, num, ep->buff + ep->count);
+      break;
+
+    case 4:
+      /* As HAL_PCD_DataOutStageCallback */
+      ep = &Emu_Out[num];
+      ep->state = EMU_EP_IDLE;
+      EMU_Stats.transfers++;
+      USBD_LL_DataOutStage(Emu_Device, num, ep->buff + ep->count);
+      break;
+
+    default:
+      /* Pipes 0..2: IN 1..3, pipes 3..5: OUT 1..3 */
+      if(num < EMU_ENDPOINTS - 1)
+      {
+        EMU_Transaction(num + 1);
+      }
+      else
+      {
+        EMU_OutTransaction(num - (EMU_ENDPOINTS - 1) + 1);
+      }
+      Emu_NextPipe = (num + 1) % (2 * (EMU_ENDPOINTS - 1));
+      break;
+    }
+  }
+
+  Emu_Now = until;
+  Emu_InAdvance = 0;
+}
+
+/**
+  * @brief  Chooses the pipe the host serves next, in turn among the IN pipes
+  *         it has room to read from and the OUT pipes with data to send.
+  * @param  None
+  * @retval Pipe: 0..2 for IN 1..3, 3..5 for OUT 1..3, 0xFF if none
+  */
+static uint8_t EMU_PollPipe(void)
+{
+  EMU_PipeTypeDef *pipe;
+  uint8_t i, num;
+
+  for(i = 0; i < 2 * (EMU_ENDPOINTS - 1); i++)
+  {
+    num = (Emu_NextPipe + i) % (2 * (EMU_ENDPOINTS - 1));
+    if(num < EMU_ENDPOINTS - 1)
+    {
+      pipe = &Emu_Pipe[num + 1];
+      if((pipe->buff != NULL) && !pipe->halted && (pipe->size - pipe->fill >= EMU_PIPE_MPS))
+      {
+        return num;
+      }
+    }
+    else
+    {
+      pipe = &Emu_OutPipe[num - (EMU_ENDPOINTS - 1) + 1];
+      if(!pipe->halted && (pipe->fill != 0))
+      {
+        return num;
+      }
+    }
+  }
+  return 0xFF;
+}
+
+/**
+  * @brief  Runs an IN transaction of the host on an endpoint.
+  * @param  num: Endpoint number
+  * @retval None
+  */
+static void EMU_Transaction(uint8_t num)
+{
+  EMU_EndpointTypeDef *ep = &Emu_In[num];
+  EMU_PipeTypeDef *pipe = &Emu_Pipe[num];
+  uint32_t n, tail, chunk;
+
+  if(ep->open && ep->stalled)
+  {
+    if(Emu_Now + EMU_HANDSHAKE_NS > Emu_NextSof - EMU_EOF_NS)
+    {
+      Emu_BusFree = Emu_NextSof;
+      return;
+    }
+    Emu_BusFree = Emu_Now + EMU_HANDSHAKE_NS;
+    EMU_Stats.stalls++;
+    pipe->halted = 1;
+    return;
+  }
+  if(!ep->open || (ep->state != EMU_EP_XFER))
+  {
+    if(Emu_Now + EMU_HANDSHAKE_NS > Emu_NextSof - EMU_EOF_NS)
+    {
+      Emu_BusFree = Emu_NextSof;
+      return;
+    }
+    Emu_BusFree = Emu_Now + EMU_HANDSHAKE_NS;
+    EMU_Stats.naks++;
+    return;
+  }
+
+  n = ep->length - ep->count;
+  n = (n < ep->mps) ? n : ep->mps;
+
+  /* A transaction does not cross the end of the frame */
+  if(Emu_Now + EMU_DATA_NS(n) > Emu_NextSof - EMU_EOF_NS)
+  {
+    Emu_BusFree = Emu_NextSof;
+    return;
+  }
+  Emu_BusFree = Emu_Now + EMU_DATA_NS(n);
+
+  tail = (pipe->head + pipe->fill) % pipe->size;
+  chunk = pipe->size - tail;
+  chunk = (chunk < n) ? chunk : n;
+  memcpy(pipe->buff + tail, ep->buff + ep->count, chunk);
+  memcpy(pipe->buff, ep->buff + ep->count + chunk, n - chunk);
+  pipe->fill += n;
+
+  ep->count += n;
+  EMU_Stats.packets++;
+  EMU_Stats.bytes += n;
+  EMU_Stats.busy_ns += EMU_DATA_NS(n);
+
+  /* A short packet or the last byte ends the transfer, no zero length
+     packet is added: the HAL does not */
+  if((n < ep->mps) || (ep->count == ep->length))
+  {
+    ep->state = EMU_EP_DONE;
+    ep->next = Emu_BusFree + EMU_IRQ_NS;
+  }
+}
+
+/**
+  * @brief  Runs an OUT transaction of the host on an endpoint: the data
+  *         packet is on the bus before the device answers, ACK, NAK while no
+  *         transfer is armed, or STALL, which aborts the transfer of the
+  *         host.
+  * @param  num: Endpoint number
+  * @retval None
+  */
+static void EMU_OutTransaction(uint8_t num)
+{
+  EMU_EndpointTypeDef *ep = &Emu_Out[num];
+  EMU_PipeTypeDef *pipe = &Emu_OutPipe[num];
+  uint32_t n, sent, mps = ep->open ? ep->mps : EMU_PIPE_MPS;
+
+  n = (pipe->fill < mps) ? pipe->fill : mps;
+
+  /* A transaction does not cross the end of the frame */
+  if(Emu_Now + EMU_DATA_NS(n) > Emu_NextSof - EMU_EOF_NS)
+  {
+    Emu_BusFree = Emu_NextSof;
+    return;
+  }
+  Emu_BusFree = Emu_Now + EMU_DATA_NS(n);
+
+  if(ep->open && ep->stalled)
+  {
+    EMU_Stats.stalls++;
+    pipe->fill = 0;
+    pipe->halted = 1;
+    return;
+  }
+  if(!ep->open || (ep->state != EMU_EP_XFER))
+  {
+    EMU_Stats.naks++;
+    return;
+  }
+
+  /* The packet leaves the host whole */
+  sent = n;
+  pipe->head += n;
+  pipe->fill -= n;
+  if(n > ep->length - ep->count)
+  {
+    /* Babble: more than the device armed */
+    EMU_Stats.errors++;
+    n = ep->length - ep->count;
+  }
+  memcpy(ep->buff + ep->count, pipe->buff + pipe->head - sent, n);
+
+  ep->count += n;
+  EMU_Stats.packets++;
+  EMU_Stats.bytes += n;
+  EMU_Stats.busy_ns += EMU_DATA_NS(n);
+
+  /* A short packet or the length armed ends the transfer */
+  if((n < ep->mps) || (ep->count == ep->length))
+  {
+    ep->state = EMU_EP_DONE;
+    ep->next = Emu_BusFree + EMU_IRQ_NS;
+  }
+}
+
+/**
+  * @brief  Aborts the transfers of all the endpoints, on a bus reset.
+  * @param  None
+  * @retval None
+  */
+static void EMU_AbortEndpoints(void)
+{
+  uint8_t i;
+
+  for(i = 0; i < EMU_ENDPOINTS; i++)
+  {
+    Emu_In[i].state = EMU_EP_IDLE;
+    Emu_In[i].stalled = 0;
+    Emu_Out[i].state = EMU_EP_IDLE;
+    Emu_Out[i].stalled = 0;
+  }
+}
+
+/*******************************************************************************
+                       LL Driver Interface (USB Device Library --> PCD)
+*******************************************************************************/
+/**
+  * @brief  Initializes the Low Level portion of the Device driver.
+  * @param  pdev: Device handle
+  * @retval USBD Status
+  */
+USBD_StatusTypeDef USBD_LL_Init(USBD_HandleTypeDef *pdev)
+{
+  Emu_Device = pdev;
+  pdev->pData = NULL;
+  memset(Emu_In, 0, sizeof(Emu_In));
+  memset(Emu_Out, 0, sizeof(Emu_Out));
+  return USBD_OK;
+}
+
+/**
+  * @brief  De-Initializes the Low Level portion of the Device driver.
+  * @param  pdev: Device handle
+  * @retval USBD Status
+  */
+USBD_StatusTypeDef USBD_LL_DeInit(USBD_HandleTypeDef *pdev)
+{
+  Emu_Device = NULL;
+  Emu_Attached = 0;
+  return USBD_OK;
+}
+
+/**
+  * @brief  Starts the Low Level portion of the Device driver: the pull-up
+  *         lets the host see the device, USBD_EMU_Attach.
+  * @param  pdev: Device handle
+  * @retval USBD Status
+  */
+USBD_StatusTypeDef USBD_LL_Start(USBD_HandleTypeDef *pdev)
+{
+  Emu_Started = 1;
+  return USBD_OK;
+}
+
+/**
+  * @brief  Stops the Low Level portion of the Device driver.
+  * @param  pdev: Device handle
+  * @retval USBD Status
+  */
+USBD_StatusTypeDef USBD_LL_Stop(USBD_HandleTypeDef *pdev)
+{
+  Emu_Started = 0;
+  Emu_Attached = 0;
+  EMU_AbortEndpoints();
+  return USBD_OK;
+}
+
+/**
+  * @brief  Opens an endpoint of the Low Level Driver.
+  * @param  pdev: Device handle
+  * @param  ep_addr: Endpoint Number
+  * @param  ep_type: Endpoint Type
+  * @param  ep_mps: Endpoint Max Packet Size
+  * @retval USBD Status
+  */
+USBD_StatusTypeDef USBD_LL_OpenEP(USBD_HandleTypeDef *pdev,
+                                  uint8_t ep_addr,
+                                  uint8_t ep_type,
+                                  uint16_t ep_mps)
+{
+  EMU_EndpointTypeDef *ep = (ep_addr & 0x80) ? &Emu_In[ep_addr & 0x7F] : &Emu_Out[ep_addr & 0x7F];
+
+  ep->open = 1;
+  ep->type = ep_type;
+  ep->mps = ep_mps;
+  ep->stalled = 0;
+  ep->state = EMU_EP_IDLE;
+  return USBD_OK;
+}
+
+/**
+  * @brief  Closes an endpoint of the Low Level Driver.
+  * @param  pdev: Device handle
+  * @param  ep_addr: Endpoint Number
+  * @retval USBD Status
+  */
+USBD_StatusTypeDef USBD_LL_CloseEP(USBD_HandleTypeDef *pdev, uint8_t ep_addr)
+{
+  EMU_EndpointTypeDef *ep = (ep_addr & 0x80) ? &Emu_In[ep_addr & 0x7F] : &Emu_Out[ep_addr & 0x7F];
+
+  ep->open = 0;
+  ep->state = EMU_EP_IDLE;
+  return USBD_OK;
+}
+
+/**
+  * @brief  Flushes an endpoint of the Low Level Driver: the transfer in
+  *         progress is aborted.
+  * @param  pdev: Device handle
+  * @param  ep_addr: Endpoint Number
+  * @retval USBD Status
+  */
+USBD_StatusTypeDef USBD_LL_FlushEP(USBD_HandleTypeDef *pdev, uint8_t ep_addr)
+{
+  EMU_EndpointTypeDef *ep = (ep_addr & 0x80) ? &Emu_In[ep_addr & 0x7F] : &Emu_Out[ep_addr & 0x7F];
+
+  ep->state = EMU_EP_IDLE;
+  return USBD_OK;
+}
+
+/**
+  * @brief  Sets a Stall condition on an endpoint of the Low Level Driver.
+  * @param  pdev: Device handle
+  * @param  ep_addr: Endpoint Number
+  * @retval USBD Status
+  */
+USBD_StatusTypeDef USBD_LL_StallEP(USBD_HandleTypeDef *pdev, uint8_t ep_addr)
+{
+  EMU_EndpointTypeDef *ep = (ep_addr & 0x80) ? &Emu_In[ep_addr & 0x7F] : &Emu_Out[ep_addr & 0x7F];
+
+  ep->stalled = 1;
+  return USBD_OK;
+}
+
+/**
+  * @brief  Clears a Stall condition on an endpoint of the Low Level Driver.
+  * @param  pdev: Device handle
+  * @param  ep_addr: Endpoint Number
+  * @retval USBD Status
+  */
+USBD_StatusTypeDef USBD_LL_ClearStallEP(USBD_HandleTypeDef *pdev, uint8_t ep_addr)
+{
+  EMU_EndpointTypeDef *ep = (ep_addr & 0x80) ? &Emu_In[ep_addr & 0x7F] : &Emu_Out[ep_addr & 0x7F];
+
+  ep->stalled = 0;
+  return USBD_OK;
+}
+
+/**
+  * @brief  Returns Stall condition.
+  * @param  pdev: Device handle
+  * @param  ep_addr: Endpoint Number
+  * @retval Stall (1: yes, 0: No)
+  */
+uint8_t USBD_LL_IsStallEP(USBD_HandleTypeDef *pdev, uint8_t ep_addr)
+{
+  EMU_EndpointTypeDef *ep = (ep_addr & 0x80) ? &Emu_In[ep_addr & 0x7F] : &Emu_Out[ep_addr & 0x7F];
+
+  return ep->stalled;
+}
+
+/**
+  * @brief  Assigns an USB address to the device.
+  * @param  pdev: Device handle
+  * @param  dev_addr: USB address
+  * @retval USBD Status
+  */
+USBD_StatusTypeDef USBD_LL_SetUSBAddress(USBD_HandleTypeDef *pdev, uint8_t dev_addr)
+{
+  Emu_Address = dev_addr;
+  return USBD_OK;
+}
+
+/**
+  * @brief  Transmits data over an endpoint. The control endpoint is given
+  *         with or without its direction bit by the core, the transfers are
+  *         always IN.
+  * @param  pdev: Device handle
+  * @param  ep_addr: Endpoint Number
+  * @param  pbuf: Pointer to data to be sent
+  * @param  size: Data size
+  * @retval USBD Status
+  */
+USBD_StatusTypeDef USBD_LL_Transmit(USBD_HandleTypeDef *pdev,
+                                    uint8_t ep_addr,
+                                    uint8_t *pbuf,
+                                    uint16_t size)
+{
+  EMU_EndpointTypeDef *ep = &Emu_In[ep_addr & 0x7F];
+
+  EMU_Stats.calls++;
+  if(!ep->open || (ep->state != EMU_EP_IDLE))
+  {
+    /* The HAL would corrupt the transfer in progress */
+    EMU_Stats.errors++;
+  }
+  ep->buff = pbuf;
+  ep->length = size;
+  ep->count = 0;
+  ep->state = EMU_EP_XFER;
+  return USBD_OK;
+}
+
+/**
+  * @brief  Prepares an endpoint for reception.
+  * @param  pdev: Device handle
+  * @param  ep_addr: Endpoint Number
+  * @param  pbuf: Pointer to data to be received
+  * @param  size: Data size
+  * @retval USBD Status
+  */
+USBD_StatusTypeDef USBD_LL_PrepareReceive(USBD_HandleTypeDef *pdev,
+                                          uint8_t ep_addr,
+                                          uint8_t *pbuf,
+                                          uint16_t size)
+{
+  EMU_EndpointTypeDef *ep = &Emu_Out[ep_addr & 0x7F];
+
+  EMU_Stats.calls++;
+  if(!ep->open)
+  {
+    EMU_Stats.errors++;
+  }
+  ep->buff = pbuf;
+  ep->length = size;
+  ep->count = 0;
+  ep->state = EMU_EP_XFER;
+  return USBD_OK;
+}
+
+/**
+  * @brief  Returns the last transferred packet size.
+  * @param  pdev: Device handle
+  * @param  ep_addr: Endpoint Number
+  * @retval Received Data Size
+  */
+uint32_t USBD_LL_GetRxDataSize(USBD_HandleTypeDef *pdev, uint8_t ep_addr)
+{
+  return Emu_Out[ep_addr & 0x7F].count;
+}
+
+/**
+  * @brief  Delay routine for the USB Device Library, on the emulated time.
+  * @param  Delay: Delay in ms
+  * @retval None
+  */
+void USBD_LL_Delay(uint32_t Delay)
+{
+  EMU_Advance(Emu_Now + (uint64_t)Delay * 1000000);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
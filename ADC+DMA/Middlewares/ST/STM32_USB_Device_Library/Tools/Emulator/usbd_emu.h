@@ -0,0 +1,79 @@
+/**
+  ******************************************************************************
+  * @file    usbd_emu.h
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Header file of the device emulator of the USB OTG FS controller
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __USBD_EMU_H
+#define __USBD_EMU_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/**
+  * @brief  Counters of the emulated bus and host
+  */
+typedef struct
+{
+  uint32_t calls;           /*!< Calls of the library to USBD_LL_Transmit and USBD_LL_PrepareReceive */
+  uint32_t transfers;       /*!< Completed transfers of the non-control endpoints                   */
+  uint32_t packets;         /*!< Acknowledged data packets of the non-control endpoints             */
+  uint32_t naks;            /*!< IN tokens and OUT packets NAKed: no transfer armed on the endpoint */
+  uint32_t sofs;            /*!< Start of frames                                                    */
+  uint32_t setups;          /*!< Control transfers                                                  */
+  uint32_t stalls;          /*!< Control transfers and bulk transactions STALLed by the device      */
+  uint32_t errors;          /*!< Protocol errors: endpoint busy or closed, control sequence         */
+  uint64_t bytes;           /*!< Data bytes of the non-control endpoints                            */
+  uint64_t busy_ns;         /*!< Bus time of their data transactions                                */
+}USBD_EMU_StatsTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+/* Emulator control, for the host test programs: the host side of the bus */
+void     USBD_EMU_Attach(void);
+uint8_t  USBD_EMU_Control(const uint8_t *setup, uint8_t *data, uint16_t *length);
+void     USBD_EMU_OpenPipe(uint8_t ep_addr, uint32_t buffer_size);
+void     USBD_EMU_ClosePipe(uint8_t ep_addr);
+uint32_t USBD_EMU_Read(uint8_t ep_addr, uint8_t *buff, uint32_t length);
+uint32_t USBD_EMU_Write(uint8_t ep_addr, const uint8_t *buff, uint32_t length);
+uint32_t USBD_EMU_Pending(uint8_t ep_addr);
+uint8_t  USBD_EMU_Halted(uint8_t ep_addr);
+void     USBD_EMU_Run(uint32_t us);
+uint64_t USBD_EMU_GetTime(void);
+void     USBD_EMU_GetStats(USBD_EMU_StatsTypeDef *stats);
+void     USBD_EMU_ResetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __USBD_EMU_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
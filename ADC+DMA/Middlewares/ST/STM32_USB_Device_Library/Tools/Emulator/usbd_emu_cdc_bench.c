@@ -0,0 +1,621 @@
+/**
+  ******************************************************************************
+  * @file    usbd_emu_cdc_bench.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Loopback bench of the spectrum streaming of the application on
+  *          the device emulator: the CDC class and usbd_cdc_interface.c of
+  *          the application send frames to the emulated host, read back by
+  *          the parser of the SpectrumReader tool.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "usbd_core.h"
+#include "usbd_ctlreq.h"
+#include "usbd_cdc.h"
+#include "usbd_cdc_interface.h"
+#include "spectrum_parser.h"
+#include "usbd_emu.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/**
+  * @brief  Application loop of main.c in device mode: capture by the DMA,
+  *         then the FFT if a frame buffer is free
+  */
+typedef struct
+{
+  uint32_t capture_us;      /* SAMPLES_SIZE at ADCx_SAMPLE_RATE_HZ */
+  uint32_t fft_us;          /* Conversion, FFT and magnitudes */
+  uint32_t filled;          /* Frames given to CDC_Stream_SendFrame */
+  uint32_t nulls;           /* CDC_Stream_GetFrame returned NULL, the port open */
+  uint8_t  open;            /* Port open, as seen by the bench */
+}BENCH_AppTypeDef;
+
+/**
+  * @brief  Program of the PC reading the port
+  */
+typedef struct
+{
+  SPECTRUM_ParserTypeDef parser;
+  uint8_t  open;
+  uint32_t rate;            /* Bytes/s, 0 to read all the data received */
+  double   credit;
+  uint8_t  synced;
+  float    last_base;
+  uint32_t last_seq;
+  uint32_t last_dropped;
+  uint32_t bad;             /* Frames with wrong magnitudes */
+}BENCH_ReaderTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define BENCH_BINS          2048    /* SAMPLES_SIZE / 2 of main.c */
+#define BENCH_SAMPLE_RATE   225000  /* ADCx_SAMPLE_RATE_HZ of main.h */
+#define BENCH_SLICE_US      250     /* Period of the reads of the PC */
+#define BENCH_DRAIN_US      300000  /* End of a run: the frames on the bus */
+
+#define CHECK(x)  do { if ((x) != USBD_OK) { \
+                    printf("%s failed at line %d\n", #x, __LINE__); exit(1); } } while (0)
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+USBD_HandleTypeDef USBD_Device;
+
+static BENCH_AppTypeDef App;
+static BENCH_ReaderTypeDef Reader;
+static uint32_t PipeSize = 4096;
+static uint32_t Errors;
+
+/* Descriptors of usbd_desc.c, whose serial number is read from the unique ID
+   of the STM32 */
+static uint8_t BENCH_DeviceDesc[USB_LEN_DEV_DESC] =
+{
+  0x12, USB_DESC_TYPE_DEVICE, 0x00, 0x02, 0x00, 0x00, 0x00, USB_MAX_EP0_SIZE,
+  LOBYTE(0x0483), HIBYTE(0x0483), LOBYTE(0x5740), HIBYTE(0x5740),
+  0x00, 0x02, USBD_IDX_MFC_STR, USBD_IDX_PRODUCT_STR, USBD_IDX_SERIAL_STR,
+  USBD_MAX_NUM_CONFIGURATION
+};
+static uint8_t BENCH_LangIDDesc[USB_LEN_LANGID_STR_DESC] =
+{
+  USB_LEN_LANGID_STR_DESC, USB_DESC_TYPE_STRING, LOBYTE(0x409), HIBYTE(0x409)
+};
+static uint8_t BENCH_StrDesc[USBD_MAX_STR_DESC_SIZ];
+
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t *BENCH_DeviceDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+static uint8_t *BENCH_LangIDStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+static uint8_t *BENCH_ManufacturerStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+static uint8_t *BENCH_ProductStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+static uint8_t *BENCH_SerialStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+static uint8_t *BENCH_ConfigStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+static uint8_t *BENCH_InterfaceStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+
+static USBD_DescriptorsTypeDef BENCH_Desc =
+{
+  BENCH_DeviceDescriptor,
+  BENCH_LangIDStrDescriptor,
+  BENCH_ManufacturerStrDescriptor,
+  BENCH_ProductStrDescriptor,
+  BENCH_SerialStrDescriptor,
+  BENCH_ConfigStrDescriptor,
+  BENCH_InterfaceStrDescriptor,
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+static uint8_t *BENCH_DeviceDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  *length = sizeof(BENCH_DeviceDesc);
+  return BENCH_DeviceDesc;
+}
+
+static uint8_t *BENCH_LangIDStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  *length = sizeof(BENCH_LangIDDesc);
+  return BENCH_LangIDDesc;
+}
+
+static uint8_t *BENCH_ManufacturerStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  USBD_GetString((uint8_t *)"STMicroelectronics", BENCH_StrDesc, length);
+  return BENCH_StrDesc;
+}
+
+static uint8_t *BENCH_ProductStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  USBD_GetString((uint8_t *)"STM32 Virtual ComPort in FS Mode", BENCH_StrDesc, length);
+  return BENCH_StrDesc;
+}
+
+static uint8_t *BENCH_SerialStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  USBD_GetString((uint8_t *)"00000000001A", BENCH_StrDesc, length);
+  return BENCH_StrDesc;
+}
+
+static uint8_t *BENCH_ConfigStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  USBD_GetString((uint8_t *)"VCP Config", BENCH_StrDesc, length);
+  return BENCH_StrDesc;
+}
+
+static uint8_t *BENCH_InterfaceStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  USBD_GetString((uint8_t *)"VCP Interface", BENCH_StrDesc, length);
+  return BENCH_StrDesc;
+}
+
+/**
+  * @brief  Runs a control transfer of the host.
+  * @param  bmRequest, bRequest, wValue, wIndex, wLength: Setup packet
+  * @param  data: Data of the request
+  * @param  length: Receives the number of data bytes, may be NULL
+  * @retval USBD_OK, or USBD_FAIL if the request failed
+  */
+static uint8_t BENCH_Request(uint8_t bmRequest, uint8_t bRequest, uint16_t wValue,
+                             uint16_t wIndex, uint16_t wLength, uint8_t *data, uint16_t *length)
+{
+  uint8_t setup[8];
+
+  setup[0] = bmRequest;
+  setup[1] = bRequest;
+  setup[2] = LOBYTE(wValue);
+  setup[3] = HIBYTE(wValue);
+  setup[4] = LOBYTE(wIndex);
+  setup[5] = HIBYTE(wIndex);
+  setup[6] = LOBYTE(wLength);
+  setup[7] = HIBYTE(wLength);
+  return USBD_EMU_Control(setup, data, length);
+}
+
+/**
+  * @brief  Enumerates the device and checks its descriptors, as the PC.
+  * @param  None
+  * @retval None
+  */
+static void BENCH_Enumerate(void)
+{
+  uint8_t  desc[256];
+  uint8_t  coding[7] = { 0x00, 0x10, 0x0E, 0x00, 0x00, 0x00, 0x08 };   /* 921600 8N1 */
+  uint16_t len, total, i, in_mps = 0;
+  uint64_t start = USBD_EMU_GetTime();
+  USBD_EMU_StatsTypeDef st;
+
+  USBD_EMU_ResetStats();
+  USBD_EMU_Attach();
+
+  CHECK(BENCH_Request(0x80, USB_REQ_GET_DESCRIPTOR, USB_DESC_TYPE_DEVICE << 8, 0, 64, desc, &len));
+  CHECK(BENCH_Request(0x00, USB_REQ_SET_ADDRESS, 1, 0, 0, NULL, NULL));
+  CHECK(BENCH_Request(0x80, USB_REQ_GET_DESCRIPTOR, USB_DESC_TYPE_DEVICE << 8, 0, USB_LEN_DEV_DESC, desc, &len));
+  if((len != USB_LEN_DEV_DESC) || (desc[1] != USB_DESC_TYPE_DEVICE))
+  {
+    printf("Invalid device descriptor\n");
+    exit(1);
+  }
+  printf("  device                   : VID %04X PID %04X, EP0 %u bytes\n",
+         desc[8] | (desc[9] << 8), desc[10] | (desc[11] << 8), desc[7]);
+
+  CHECK(BENCH_Request(0x80, USB_REQ_GET_DESCRIPTOR, USB_DESC_TYPE_CONFIGURATION << 8, 0, 9, desc, &len));
+  total = desc[2] | (desc[3] << 8);
+  CHECK(BENCH_Request(0x80, USB_REQ_GET_DESCRIPTOR, USB_DESC_TYPE_CONFIGURATION << 8, 0, sizeof(desc), desc, &len));
+  if(len != total)
+  {
+    printf("Configuration descriptor of %u bytes, %u expected\n", len, total);
+    exit(1);
+  }
+  for(i = 0; i + 6 < len; i += desc[i])
+  {
+    if((desc[i + 1] == USB_DESC_TYPE_ENDPOINT) && (desc[i + 2] == CDC_IN_EP) && (desc[i + 3] == 0x02))
+    {
+      in_mps = desc[i + 4] | (desc[i + 5] << 8);
+    }
+    if(desc[i] == 0)
+    {
+      break;
+    }
+  }
+  if(in_mps != CDC_DATA_FS_MAX_PACKET_SIZE)
+  {
+    printf("No bulk IN endpoint %02X of %u bytes\n", CDC_IN_EP, CDC_DATA_FS_MAX_PACKET_SIZE);
+    exit(1);
+  }
+  printf("  configuration            : %u bytes, bulk IN %02X of %u bytes\n", total, CDC_IN_EP, in_mps);
+
+  /* Strings: the product takes two packets of EP0 */
+  CHECK(BENCH_Request(0x80, USB_REQ_GET_DESCRIPTOR, USB_DESC_TYPE_STRING << 8, 0, 255, desc, &len));
+  CHECK(BENCH_Request(0x80, USB_REQ_GET_DESCRIPTOR, (USB_DESC_TYPE_STRING << 8) | USBD_IDX_PRODUCT_STR,
+                      0x409, 255, desc, &len));
+  printf("  product string           : %u bytes\n", len);
+
+  /* No device qualifier at full speed: a STALL is expected */
+  if(BENCH_Request(0x80, USB_REQ_GET_DESCRIPTOR, USB_DESC_TYPE_DEVICE_QUALIFIER << 8, 0, 10, desc, &len) == USBD_OK)
+  {
+    printf("  device qualifier not STALLed\n");
+    Errors++;
+  }
+
+  CHECK(BENCH_Request(0x00, USB_REQ_SET_CONFIGURATION, 1, 0, 0, NULL, NULL));
+  if(USBD_Device.dev_state != USBD_STATE_CONFIGURED)
+  {
+    printf("Device not configured\n");
+    exit(1);
+  }
+
+  /* The requests of the serial driver of the PC */
+  CHECK(BENCH_Request(0x21, CDC_SET_LINE_CODING, 0, 0, sizeof(coding), coding, NULL));
+  CHECK(BENCH_Request(0xA1, CDC_GET_LINE_CODING, 0, 0, sizeof(coding), desc, &len));
+  if((len != sizeof(coding)) || (memcmp(desc, coding, sizeof(coding)) != 0))
+  {
+    printf("  line coding not reported back\n");
+    Errors++;
+  }
+
+  USBD_EMU_GetStats(&st);
+  printf("  enumeration              : %7.1f ms  %5lu control transfers %3lu STALLs %5lu SOFs\n",
+         (USBD_EMU_GetTime() - start) / 1000.0, (unsigned long)st.setups,
+         (unsigned long)st.stalls, (unsigned long)st.sofs);
+  Errors += st.errors;
+}
+
+/**
+  * @brief  Frame callback of the parser: checks the magnitudes written by
+  *         BENCH_Capture, and their order.
+  * @param  header: Frame header
+  * @param  bins: Magnitudes
+  * @param  context: Reader
+  * @retval None
+  */
+static void BENCH_OnFrame(const SPECTRUM_FrameHeaderTypeDef *header, const float *bins, void *context)
+{
+  BENCH_ReaderTypeDef *reader = (BENCH_ReaderTypeDef *)context;
+  uint32_t i;
+  uint8_t  bad = 0;
+
+  if((header->bins != BENCH_BINS) || (header->sample_rate != BENCH_SAMPLE_RATE))
+  {
+    bad = 1;
+  }
+  for(i = 0; (i < header->bins) && !bad; i++)
+  {
+    if(bins[i] != bins[0] + i)
+    {
+      bad = 1;
+    }
+  }
+  if(reader->synced && !bad)
+  {
+    /* Following frames carry following magnitudes, and a frame is never
+       received twice */
+    if((header->seq == reader->last_seq + 1) && (header->dropped == reader->last_dropped))
+    {
+      bad = (bins[0] != reader->last_base + 1);
+    }
+    else
+    {
+      bad = (bins[0] <= reader->last_base);
+    }
+  }
+  if(bad)
+  {
+    reader->bad++;
+  }
+  reader->synced = 1;
+  reader->last_base = bins[0];
+  reader->last_seq = header->seq;
+  reader->last_dropped = header->dropped;
+}
+
+/**
+  * @brief  Opens the port: starts the reading of the PC and sets DTR.
+  * @param  None
+  * @retval None
+  */
+static void BENCH_Open(void)
+{
+  SPECTRUM_ParserInit(&Reader.parser, BENCH_OnFrame, &Reader);
+  Reader.synced = 0;
+  Reader.credit = 0;
+  Reader.open = 1;
+  USBD_EMU_OpenPipe(CDC_IN_EP, PipeSize);
+  CHECK(BENCH_Request(0x21, CDC_SET_CONTROL_LINE_STATE, 0x0003, 0, 0, NULL, NULL));
+  App.open = 1;
+}
+
+/**
+  * @brief  Closes the port: clears DTR, the data not read are lost.
+  * @param  None
+  * @retval None
+  */
+static void BENCH_Close(void)
+{
+  CHECK(BENCH_Request(0x21, CDC_SET_CONTROL_LINE_STATE, 0x0000, 0, 0, NULL, NULL));
+  USBD_EMU_ClosePipe(CDC_IN_EP);
+  Reader.open = 0;
+  App.open = 0;
+}
+
+/**
+  * @brief  Lets the time run, with the reads of the PC.
+  * @param  us: Time in us
+  * @retval None
+  */
+static void BENCH_Run(uint32_t us)
+{
+  static uint8_t buff[65536];
+  uint32_t step, n, max;
+
+  while(us > 0)
+  {
+    step = (us < BENCH_SLICE_US) ? us : BENCH_SLICE_US;
+    USBD_EMU_Run(step);
+    us -= step;
+
+    if(!Reader.open)
+    {
+      continue;
+    }
+    max = sizeof(buff);
+    if(Reader.rate != 0)
+    {
+      Reader.credit += (double)Reader.rate * step / 1e6;
+      max = (Reader.credit < max) ? (uint32_t)Reader.credit : max;
+    }
+    n = USBD_EMU_Read(CDC_IN_EP, buff, max);
+    SPECTRUM_Parse(&Reader.parser, buff, n);
+    if(Reader.rate != 0)
+    {
+      /* No credit saved while there is nothing to read */
+      Reader.credit = (n < max) ? 0 : Reader.credit - n;
+    }
+  }
+}
+
+/**
+  * @brief  One pass of the loop of main.c: end of the capture, then the
+  *         spectrum streamed if a buffer is free (stream_spectrum).
+  * @param  None
+  * @retval None
+  */
+static void BENCH_Capture(void)
+{
+  float *bins;
+  uint32_t i;
+
+  BENCH_Run(App.capture_us);
+
+  bins = CDC_Stream_GetFrame();
+  if(bins == NULL)
+  {
+    if(App.open)
+    {
+      App.nulls++;
+    }
+    return;
+  }
+
+  BENCH_Run(App.fft_us);
+  for(i = 0; i < BENCH_BINS; i++)
+  {
+    bins[i] = (float)(App.filled + i);
+  }
+  App.filled++;
+  CDC_Stream_SendFrame(BENCH_BINS, BENCH_SAMPLE_RATE);
+}
+
+/**
+  * @brief  Streams for a time with the port open, then drains the bus and
+  *         checks that the frames sent are those received.
+  * @param  name: Name of the run
+  * @param  seconds: Time of the capture
+  * @retval None
+  */
+static void BENCH_Stream(const char *name, uint32_t seconds)
+{
+  SPECTRUM_ParserTypeDef *p = &Reader.parser;
+  USBD_EMU_StatsTypeDef st;
+  uint32_t sent0, dropped0, sent, dropped, filled0, nulls0;
+  uint64_t start, end, bytes;
+  double   s;
+
+  CDC_Stream_GetStats(&sent0, &dropped0);
+  filled0 = App.filled;
+  nulls0 = App.nulls;
+  Reader.bad = 0;
+  BENCH_Open();
+  USBD_EMU_ResetStats();
+  start = USBD_EMU_GetTime();
+
+  while(USBD_EMU_GetTime() < start + (uint64_t)seconds * 1000000)
+  {
+    BENCH_Capture();
+  }
+  end = USBD_EMU_GetTime();
+  bytes = p->bytes;
+  USBD_EMU_GetStats(&st);
+
+  /* The frames queued before the end reach the PC */
+  BENCH_Run(BENCH_DRAIN_US);
+  CDC_Stream_GetStats(&sent, &dropped);
+  sent -= sent0;
+  dropped -= dropped0;
+
+  s = (end - start) / 1e6;
+  printf("  %-24s : %6.3f MB/s %6.1f frames/s  %5lu sent %5lu dropped  %4.1f %% of the bus, %lu NAKs\n",
+         name, bytes / s / 1e6, p->frames / s, (unsigned long)sent, (unsigned long)dropped,
+         100.0 * st.busy_ns / ((end - start) * 1000.0), (unsigned long)st.naks);
+  printf("  %-24s   received %5lu frames, %lu dropped in the headers, %lu lost, %lu skipped bytes, "
+         "%lu errors, %lu bad\n", "", (unsigned long)p->frames, (unsigned long)p->dropped,
+         (unsigned long)(p->missed - p->dropped), (unsigned long)p->skipped,
+         (unsigned long)p->errors, (unsigned long)Reader.bad);
+
+  /* Every frame filled is sent and received intact; the drops are whole
+     frames and are told to the reader */
+  if((sent != App.filled - filled0) || (p->frames != sent) || (dropped != App.nulls - nulls0) ||
+     (p->missed != p->dropped) || (p->dropped > dropped) ||
+     (p->skipped != 0) || (p->errors != 0) || (Reader.bad != 0))
+  {
+    printf("  frame accounting mismatch\n");
+    Errors++;
+  }
+  Errors += st.errors;
+
+  BENCH_Close();
+}
+
+/**
+  * @brief  Closes and reopens the port, then resets the bus while streaming:
+  *         the stream resumes each time, the reader resyncs on a header.
+  * @param  None
+  * @retval None
+  */
+static void BENCH_Reopen(void)
+{
+  SPECTRUM_ParserTypeDef *p = &Reader.parser;
+  USBD_EMU_StatsTypeDef st;
+  uint32_t frames;
+  uint64_t end;
+
+  USBD_EMU_ResetStats();
+  Reader.bad = 0;
+  BENCH_Open();
+  for(end = USBD_EMU_GetTime() + 500000; USBD_EMU_GetTime() < end;)
+  {
+    BENCH_Capture();
+  }
+  frames = p->frames;
+
+  /* The frame on the bus stays there while the port is closed */
+  BENCH_Close();
+  for(end = USBD_EMU_GetTime() + 200000; USBD_EMU_GetTime() < end;)
+  {
+    BENCH_Capture();
+  }
+  BENCH_Open();
+  for(end = USBD_EMU_GetTime() + 500000; USBD_EMU_GetTime() < end;)
+  {
+    BENCH_Capture();
+  }
+  printf("  %-24s : %5lu frames before, %5lu after, %lu bytes of the old frame skipped, %lu errors, %lu bad\n",
+         "close and reopen", (unsigned long)frames, (unsigned long)p->frames,
+         (unsigned long)p->skipped, (unsigned long)p->errors, (unsigned long)Reader.bad);
+  if((frames == 0) || (p->frames == 0) || (p->errors != 0) || (Reader.bad != 0))
+  {
+    printf("  stream not resumed\n");
+    Errors++;
+  }
+
+  /* Bus reset: the transfers are aborted, the PC enumerates again */
+  Reader.open = 0;
+  App.open = 0;
+  USBD_EMU_ClosePipe(CDC_IN_EP);
+  USBD_EMU_GetStats(&st);
+  Errors += st.errors;
+  BENCH_Enumerate();
+  Reader.bad = 0;
+  BENCH_Open();
+  for(end = USBD_EMU_GetTime() + 500000; USBD_EMU_GetTime() < end;)
+  {
+    BENCH_Capture();
+  }
+  USBD_EMU_GetStats(&st);
+  printf("  %-24s : %5lu frames after, %lu skipped bytes, %lu errors, %lu bad\n",
+         "bus reset", (unsigned long)p->frames,
+         (unsigned long)p->skipped, (unsigned long)p->errors, (unsigned long)Reader.bad);
+  if((p->frames == 0) || (p->errors != 0) || (p->skipped != 0) || (Reader.bad != 0))
+  {
+    printf("  stream not resumed after the reset\n");
+    Errors++;
+  }
+  Errors += st.errors;
+  BENCH_Close();
+}
+
+/**
+  * @brief  Main program.
+  * @param  argc, argv: usbd_emu_cdc_bench [-t s] [-c capture_us] [-f fft_us]
+  *         [-r KB/s] [-b bytes]
+  * @retval 0, 1 on a protocol or data error
+  */
+int main(int argc, char **argv)
+{
+  uint32_t seconds = 5, capture_us = 18204, fft_us = 3000, rate = 200;
+  int opt;
+
+  while((opt = getopt(argc, argv, "t:c:f:r:b:")) != -1)
+  {
+    switch(opt)
+    {
+    case 't': seconds = strtoul(optarg, NULL, 0); break;
+    case 'c': capture_us = strtoul(optarg, NULL, 0); break;
+    case 'f': fft_us = strtoul(optarg, NULL, 0); break;
+    case 'r': rate = strtoul(optarg, NULL, 0); break;
+    case 'b': PipeSize = strtoul(optarg, NULL, 0); break;
+    default:
+      printf("usage: %s [-t seconds] [-c capture_us] [-f fft_us] [-r reader_KB/s] [-b pc_buffer]\n",
+             argv[0]);
+      return 1;
+    }
+  }
+  if((seconds == 0) || (PipeSize < CDC_DATA_FS_MAX_PACKET_SIZE))
+  {
+    printf("Invalid parameters\n");
+    return 1;
+  }
+
+  printf("USB device emulator, CDC streaming of %u bins (%u bytes frames), %lu us capture, %lu us FFT, "
+         "%lu bytes PC buffer\n", BENCH_BINS, (unsigned)SPECTRUM_FRAME_SIZE(BENCH_BINS, CDC_DATA_FS_MAX_PACKET_SIZE),
+         (unsigned long)capture_us, (unsigned long)fft_us, (unsigned long)PipeSize);
+
+  /* As main.c in device mode */
+  CHECK(USBD_Init(&USBD_Device, &BENCH_Desc, 0));
+  CHECK(USBD_RegisterClass(&USBD_Device, USBD_CDC_CLASS));
+  CHECK(USBD_CDC_RegisterInterface(&USBD_Device, &USBD_CDC_fops));
+  CHECK(USBD_Start(&USBD_Device));
+  BENCH_Enumerate();
+
+  App.capture_us = capture_us;
+  App.fft_us = fft_us;
+  Reader.rate = 0;
+  BENCH_Stream("capture rate", seconds);
+
+  /* Spectra faster than the bus: the link limit, and dropped frames */
+  App.capture_us = 1000;
+  App.fft_us = 1000;
+  BENCH_Stream("saturated", seconds);
+
+  /* PC reading slower than the capture */
+  App.capture_us = capture_us;
+  App.fft_us = fft_us;
+  Reader.rate = rate * 1000;
+  BENCH_Stream("slow reader", seconds);
+  Reader.rate = 0;
+
+  BENCH_Reopen();
+
+  printf("  protocol errors          : %lu\n", (unsigned long)Errors);
+  return (Errors != 0) ? 1 : 0;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,844 @@
+/**
+  ******************************************************************************
+  * @file    usbd_emu_msc_bench.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Bench of the export of the capture log volume of the application
+  *          on the device emulator: the MSC class and usbd_storage.c of the
+  *          application serve the RAM disk to the emulated host, which runs
+  *          the Bulk-Only Transport commands of a PC, reads the volume while
+  *          the application appends rows to the log, and checks what it
+  *          sees.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "usbd_core.h"
+#include "usbd_ctlreq.h"
+#include "usbd_msc.h"
+#include "usbd_msc_bot.h"
+#include "usbd_msc_scsi.h"
+#include "usbd_storage.h"
+#include "ramdisk_diskio.h"
+#include "usbd_emu.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/**
+  * @brief  Log of main.c in MSC mode (log_volume_init, log_spectrum)
+  */
+typedef struct
+{
+  FATFS    fs;
+  FIL      file;
+  char     path[4];
+  uint8_t  ready;
+  uint32_t rows;            /* Rows appended */
+  uint32_t period_us;       /* Time between two rows */
+  uint64_t next;            /* Date of the next row, in us */
+}BENCH_LogTypeDef;
+
+/**
+  * @brief  What the PC sees of the log file in an image of the volume
+  */
+typedef struct
+{
+  uint32_t size;            /* Size of the directory entry */
+  uint32_t rows;            /* Whole rows checked */
+  uint8_t  stale;           /* FAT read before the entry: chain too short */
+  uint8_t  bad;             /* Row torn or wrong, or entry missing */
+}BENCH_ViewTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define BENCH_SECTORS       128     /* LOG_VOLUME_SECTORS of main.c */
+#define BENCH_SECTOR_SIZE   512
+#define BENCH_SLICE_US      100     /* Period of the PC driver */
+#define BENCH_TIMEOUT_US    2000000 /* Command without CSW */
+#define BENCH_LOG_NAME      "log.csv"
+#define BENCH_LOG_HEADER    "captura, tempo_ms, media, pico_hz, magnitude"
+
+#define CHECK(x)  do { if ((x) != USBD_OK) { \
+                    printf("%s failed at line %d\n", #x, __LINE__); exit(1); } } while (0)
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+USBD_HandleTypeDef USBD_Device;
+
+static BENCH_LogTypeDef Log;
+static BYTE Volume[BENCH_SECTORS * BENCH_SECTOR_SIZE];
+static uint8_t Image[BENCH_SECTORS * BENCH_SECTOR_SIZE];
+static uint8_t Data[BENCH_SECTORS * BENCH_SECTOR_SIZE + USBD_BOT_CSW_LENGTH];
+static uint32_t Tag;
+static uint32_t Errors;
+
+/* Descriptors of usbd_desc.c, whose serial number is read from the unique ID
+   of the STM32 */
+static uint8_t BENCH_DeviceDesc[USB_LEN_DEV_DESC] =
+{
+  0x12, USB_DESC_TYPE_DEVICE, 0x00, 0x02, 0x00, 0x00, 0x00, USB_MAX_EP0_SIZE,
+  LOBYTE(0x0483), HIBYTE(0x0483), LOBYTE(0x5720), HIBYTE(0x5720),
+  0x00, 0x02, USBD_IDX_MFC_STR, USBD_IDX_PRODUCT_STR, USBD_IDX_SERIAL_STR,
+  USBD_MAX_NUM_CONFIGURATION
+};
+static uint8_t BENCH_LangIDDesc[USB_LEN_LANGID_STR_DESC] =
+{
+  USB_LEN_LANGID_STR_DESC, USB_DESC_TYPE_STRING, LOBYTE(0x409), HIBYTE(0x409)
+};
+static uint8_t BENCH_StrDesc[USBD_MAX_STR_DESC_SIZ];
+
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t *BENCH_DeviceDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+static uint8_t *BENCH_LangIDStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+static uint8_t *BENCH_ManufacturerStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+static uint8_t *BENCH_ProductStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+static uint8_t *BENCH_SerialStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+static uint8_t *BENCH_ConfigStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+static uint8_t *BENCH_InterfaceStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+
+static USBD_DescriptorsTypeDef BENCH_Desc =
+{
+  BENCH_DeviceDescriptor,
+  BENCH_LangIDStrDescriptor,
+  BENCH_ManufacturerStrDescriptor,
+  BENCH_ProductStrDescriptor,
+  BENCH_SerialStrDescriptor,
+  BENCH_ConfigStrDescriptor,
+  BENCH_InterfaceStrDescriptor,
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+static uint8_t *BENCH_DeviceDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  *length = sizeof(BENCH_DeviceDesc);
+  return BENCH_DeviceDesc;
+}
+
+static uint8_t *BENCH_LangIDStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  *length = sizeof(BENCH_LangIDDesc);
+  return BENCH_LangIDDesc;
+}
+
+static uint8_t *BENCH_ManufacturerStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  USBD_GetString((uint8_t *)"STMicroelectronics", BENCH_StrDesc, length);
+  return BENCH_StrDesc;
+}
+
+static uint8_t *BENCH_ProductStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  USBD_GetString((uint8_t *)"STM32 Capture Log", BENCH_StrDesc, length);
+  return BENCH_StrDesc;
+}
+
+static uint8_t *BENCH_SerialStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  USBD_GetString((uint8_t *)"00000000001A", BENCH_StrDesc, length);
+  return BENCH_StrDesc;
+}
+
+static uint8_t *BENCH_ConfigStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  USBD_GetString((uint8_t *)"MSC Config", BENCH_StrDesc, length);
+  return BENCH_StrDesc;
+}
+
+static uint8_t *BENCH_InterfaceStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  USBD_GetString((uint8_t *)"MSC Interface", BENCH_StrDesc, length);
+  return BENCH_StrDesc;
+}
+
+/**
+  * @brief  Runs a control transfer of the host.
+  * @param  bmRequest, bRequest, wValue, wIndex, wLength: Setup packet
+  * @param  data: Data of the request
+  * @param  length: Receives the number of data bytes, may be NULL
+  * @retval USBD_OK, or USBD_FAIL if the request failed
+  */
+static uint8_t BENCH_Request(uint8_t bmRequest, uint8_t bRequest, uint16_t wValue,
+                             uint16_t wIndex, uint16_t wLength, uint8_t *data, uint16_t *length)
+{
+  uint8_t setup[8];
+
+  setup[0] = bmRequest;
+  setup[1] = bRequest;
+  setup[2] = LOBYTE(wValue);
+  setup[3] = HIBYTE(wValue);
+  setup[4] = LOBYTE(wIndex);
+  setup[5] = HIBYTE(wIndex);
+  setup[6] = LOBYTE(wLength);
+  setup[7] = HIBYTE(wLength);
+  return USBD_EMU_Control(setup, data, length);
+}
+
+/**
+  * @brief  Writes the row of a capture, as log_spectrum: the values are
+  *         made from its number, so that the PC can check each row.
+  * @param  row: Receives the row
+  * @param  capture: Number of the capture, from 1
+  * @retval Length of the row
+  */
+static uint32_t BENCH_Row(char *row, uint32_t capture)
+{
+  return sprintf(row, "%lu, %lu, %.1f, %lu, %.1f\r\n", (unsigned long)capture,
+                 (unsigned long)(capture * 1000), (capture % 4096) / 2.0,
+                 (unsigned long)((capture * 37) % 112500), capture * 0.5);
+}
+
+/**
+  * @brief  Mounts the RAM disk and opens the log file, as log_volume_init.
+  * @param  None
+  * @retval None
+  */
+static void BENCH_LogInit(void)
+{
+  char path[16];
+
+  RAMDISK_Attach(Volume, BENCH_SECTORS);
+  if(FATFS_LinkDriver(&RAMDISK_Driver, Log.path) != 0)
+  {
+    printf("Driver not linked\n");
+    exit(1);
+  }
+  if(f_mount(&Log.fs, (TCHAR const *)Log.path, 1) == FR_NO_FILESYSTEM)
+  {
+    f_mkfs((TCHAR const *)Log.path, 1, 512);
+    f_mount(&Log.fs, (TCHAR const *)Log.path, 1);
+  }
+  sprintf(path, "%s%s", Log.path, BENCH_LOG_NAME);
+  if(f_open(&Log.file, path, FA_OPEN_ALWAYS | FA_WRITE) == FR_OK)
+  {
+    f_lseek(&Log.file, f_size(&Log.file));
+    if(f_size(&Log.file) == 0)
+    {
+      /* f_puts writes the line end of the PC */
+      f_puts(BENCH_LOG_HEADER "\n", &Log.file);
+    }
+    Log.ready = (f_sync(&Log.file) == FR_OK);
+  }
+  if(!Log.ready)
+  {
+    printf("Log file not created\n");
+    exit(1);
+  }
+  STORAGE_Attach(&RAMDISK_Driver);
+}
+
+/**
+  * @brief  Appends the rows due, as log_spectrum: the interrupts of the
+  *         emulator do not run meanwhile, as with OTG_FS_IRQn masked. Once
+  *         the volume is full, the last row written in part is removed.
+  * @param  None
+  * @retval None
+  */
+static void BENCH_Log(void)
+{
+  char row[64];
+  UINT len, written;
+  DWORD size;
+
+  while(Log.ready && (Log.period_us != 0) && (USBD_EMU_GetTime() >= Log.next))
+  {
+    Log.next += Log.period_us;
+    len = BENCH_Row(row, Log.rows + 1);
+    size = f_size(&Log.file);
+    if((f_write(&Log.file, row, len, &written) != FR_OK) || (written != len))
+    {
+      f_lseek(&Log.file, size);
+      f_truncate(&Log.file);
+      Log.ready = 0;
+    }
+    else
+    {
+      Log.rows++;
+    }
+    f_sync(&Log.file);
+  }
+}
+
+/**
+  * @brief  Runs a SCSI command with the Bulk-Only Transport: CBW, data stage
+  *         and CSW, with the reset recovery of the pipes the device STALLs.
+  * @param  cb: Command block
+  * @param  cb_len: Length of the command block
+  * @param  dir_in: 1 for data from the device
+  * @param  data: Data to send, or receives the data
+  * @param  length: Data length of the CBW
+  * @param  received: Receives the data bytes from the device, may be NULL
+  * @retval CSW status, 0xFF without a valid CSW
+  */
+static uint8_t BENCH_Command(const uint8_t *cb, uint8_t cb_len, uint8_t dir_in,
+                             uint8_t *data, uint32_t length, uint32_t *received)
+{
+  static uint8_t rx[sizeof(Data)];
+  uint8_t  cbw[USBD_BOT_CBW_LENGTH];
+  uint8_t *csw;
+  uint32_t count = 0, sig, tag;
+  uint8_t  data_sent = dir_in || (length == 0), out_done;
+  uint64_t end = USBD_EMU_GetTime() + BENCH_TIMEOUT_US;
+
+  memset(cbw, 0, sizeof(cbw));
+  Tag++;
+  sig = USBD_BOT_CBW_SIGNATURE;
+  memcpy(&cbw[0], &sig, 4);
+  memcpy(&cbw[4], &Tag, 4);
+  memcpy(&cbw[8], &length, 4);
+  cbw[12] = dir_in ? 0x80 : 0x00;
+  cbw[13] = 0;
+  cbw[14] = cb_len;
+  memcpy(&cbw[15], cb, cb_len);
+  if(USBD_EMU_Write(MSC_EPOUT_ADDR, cbw, sizeof(cbw)) != sizeof(cbw))
+  {
+    printf("  CBW not sent\n");
+    Errors++;
+    return 0xFF;
+  }
+
+  while(USBD_EMU_GetTime() < end)
+  {
+    USBD_EMU_Run(BENCH_SLICE_US);
+    BENCH_Log();
+
+    if(!data_sent && (USBD_EMU_Pending(MSC_EPOUT_ADDR) == 0))
+    {
+      /* The CBW is out: the data follow, unless the device has halted the
+         pipe on the command */
+      data_sent = USBD_EMU_Halted(MSC_EPOUT_ADDR) ||
+                  (USBD_EMU_Write(MSC_EPOUT_ADDR, data, length) == length);
+    }
+    if(USBD_EMU_Halted(MSC_EPOUT_ADDR))
+    {
+      CHECK(BENCH_Request(0x02, USB_REQ_CLEAR_FEATURE, USB_FEATURE_EP_HALT, MSC_EPOUT_ADDR, 0, NULL, NULL));
+      data_sent = 1;
+    }
+    out_done = data_sent && (USBD_EMU_Pending(MSC_EPOUT_ADDR) == 0);
+
+    /* The IN pipe is cleared in the status stage only, as a PC does: the
+       class arms the next CBW when it sends the CSW, and the clear of the
+       OUT pipe would abort that */
+    if(out_done && USBD_EMU_Halted(MSC_EPIN_ADDR))
+    {
+      CHECK(BENCH_Request(0x02, USB_REQ_CLEAR_FEATURE, USB_FEATURE_EP_HALT, MSC_EPIN_ADDR, 0, NULL, NULL));
+    }
+
+    count += USBD_EMU_Read(MSC_EPIN_ADDR, rx + count, sizeof(rx) - count);
+
+    /* The CSW ends the data, shorter than asked if the device has less; it
+       is not read before the data out stage is over */
+    if(out_done && (count >= USBD_BOT_CSW_LENGTH) && (count - USBD_BOT_CSW_LENGTH <= (dir_in ? length : 0)))
+    {
+      csw = rx + count - USBD_BOT_CSW_LENGTH;
+      memcpy(&sig, &csw[0], 4);
+      memcpy(&tag, &csw[4], 4);
+      if((sig == USBD_BOT_CSW_SIGNATURE) && (tag == Tag))
+      {
+        count -= USBD_BOT_CSW_LENGTH;
+        if(dir_in)
+        {
+          memcpy(data, rx, count);
+        }
+        if(received != NULL)
+        {
+          *received = count;
+        }
+        return csw[12];
+      }
+    }
+  }
+  printf("  no CSW for the command %02X\n", cb[0]);
+  Errors++;
+  return 0xFF;
+}
+
+/**
+  * @brief  Reads sectors with READ(10).
+  * @param  lba: First sector
+  * @param  count: Number of sectors
+  * @param  buff: Receives the sectors
+  * @retval 0 if all the sectors were read
+  */
+static uint8_t BENCH_Read10(uint32_t lba, uint16_t count, uint8_t *buff)
+{
+  uint8_t  cb[10] = { SCSI_READ10, 0, lba >> 24, lba >> 16, lba >> 8, lba, 0, count >> 8, count, 0 };
+  uint32_t received = 0;
+
+  if((BENCH_Command(cb, sizeof(cb), 1, buff, (uint32_t)count * BENCH_SECTOR_SIZE, &received) != 0) ||
+     (received != (uint32_t)count * BENCH_SECTOR_SIZE))
+  {
+    return 1;
+  }
+  return 0;
+}
+
+/**
+  * @brief  Enumerates the device and checks its descriptors, as the PC, then
+  *         opens the bulk pipes.
+  * @param  None
+  * @retval None
+  */
+static void BENCH_Enumerate(void)
+{
+  uint8_t  desc[256];
+  uint16_t len, total, i, in_mps = 0, out_mps = 0;
+  uint64_t start = USBD_EMU_GetTime();
+  USBD_EMU_StatsTypeDef st;
+
+  USBD_EMU_ResetStats();
+  USBD_EMU_Attach();
+
+  CHECK(BENCH_Request(0x80, USB_REQ_GET_DESCRIPTOR, USB_DESC_TYPE_DEVICE << 8, 0, 64, desc, &len));
+  CHECK(BENCH_Request(0x00, USB_REQ_SET_ADDRESS, 1, 0, 0, NULL, NULL));
+  CHECK(BENCH_Request(0x80, USB_REQ_GET_DESCRIPTOR, USB_DESC_TYPE_DEVICE << 8, 0, USB_LEN_DEV_DESC, desc, &len));
+  if((len != USB_LEN_DEV_DESC) || (desc[1] != USB_DESC_TYPE_DEVICE))
+  {
+    printf("Invalid device descriptor\n");
+    exit(1);
+  }
+  printf("  device                   : VID %04X PID %04X, EP0 %u bytes\n",
+         desc[8] | (desc[9] << 8), desc[10] | (desc[11] << 8), desc[7]);
+
+  CHECK(BENCH_Request(0x80, USB_REQ_GET_DESCRIPTOR, USB_DESC_TYPE_CONFIGURATION << 8, 0, 9, desc, &len));
+  total = desc[2] | (desc[3] << 8);
+  CHECK(BENCH_Request(0x80, USB_REQ_GET_DESCRIPTOR, USB_DESC_TYPE_CONFIGURATION << 8, 0, sizeof(desc), desc, &len));
+  if(len != total)
+  {
+    printf("Configuration descriptor of %u bytes, %u expected\n", len, total);
+    exit(1);
+  }
+  for(i = 0; i + 6 < len; i += desc[i])
+  {
+    if((desc[i + 1] == USB_DESC_TYPE_ENDPOINT) && (desc[i + 3] == 0x02))
+    {
+      if(desc[i + 2] == MSC_EPIN_ADDR)
+      {
+        in_mps = desc[i + 4] | (desc[i + 5] << 8);
+      }
+      else if(desc[i + 2] == MSC_EPOUT_ADDR)
+      {
+        out_mps = desc[i + 4] | (desc[i + 5] << 8);
+      }
+    }
+    if(desc[i] == 0)
+    {
+      break;
+    }
+  }
+  if((in_mps != MSC_MAX_FS_PACKET) || (out_mps != MSC_MAX_FS_PACKET))
+  {
+    printf("No bulk endpoints %02X and %02X of %u bytes\n", MSC_EPIN_ADDR, MSC_EPOUT_ADDR, MSC_MAX_FS_PACKET);
+    exit(1);
+  }
+  printf("  configuration            : %u bytes, bulk IN %02X and OUT %02X of %u bytes\n",
+         total, MSC_EPIN_ADDR, MSC_EPOUT_ADDR, in_mps);
+
+  CHECK(BENCH_Request(0x00, USB_REQ_SET_CONFIGURATION, 1, 0, 0, NULL, NULL));
+  if(USBD_Device.dev_state != USBD_STATE_CONFIGURED)
+  {
+    printf("Device not configured\n");
+    exit(1);
+  }
+
+  /* The request of the mass storage driver of the PC */
+  CHECK(BENCH_Request(0xA1, BOT_GET_MAX_LUN, 0, 0, 1, desc, &len));
+  if((len != 1) || (desc[0] != 0))
+  {
+    printf("  %u LUNs reported, 1 expected\n", desc[0] + 1);
+    Errors++;
+  }
+
+  USBD_EMU_GetStats(&st);
+  printf("  enumeration              : %7.1f ms  %5lu control transfers %3lu STALLs %5lu SOFs\n",
+         (USBD_EMU_GetTime() - start) / 1000.0, (unsigned long)st.setups,
+         (unsigned long)st.stalls, (unsigned long)st.sofs);
+  Errors += st.errors;
+
+  USBD_EMU_OpenPipe(MSC_EPIN_ADDR, 65536);
+  USBD_EMU_OpenPipe(MSC_EPOUT_ADDR, sizeof(Data));
+}
+
+/**
+  * @brief  Runs the commands a PC sends when the drive appears, and checks
+  *         the answers.
+  * @param  None
+  * @retval None
+  */
+static void BENCH_Identify(void)
+{
+  uint8_t  inquiry[6] = { SCSI_INQUIRY, 0, 0, 0, STANDARD_INQUIRY_DATA_LEN, 0 };
+  uint8_t  ready[6] = { SCSI_TEST_UNIT_READY, 0, 0, 0, 0, 0 };
+  uint8_t  capacity[10] = { SCSI_READ_CAPACITY10, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+  uint8_t  sense6[6] = { SCSI_MODE_SENSE6, 0, 0x3F, 0, MODE_SENSE6_DATA_LEN, 0 };
+  uint32_t received, last, size;
+
+  if((BENCH_Command(inquiry, sizeof(inquiry), 1, Data, STANDARD_INQUIRY_DATA_LEN, &received) != 0) ||
+     (received != STANDARD_INQUIRY_DATA_LEN))
+  {
+    printf("  INQUIRY failed\n");
+    Errors++;
+    return;
+  }
+  printf("  inquiry                  : %.8s %.16s %.4s\n", &Data[8], &Data[16], &Data[32]);
+
+  if(BENCH_Command(ready, sizeof(ready), 0, NULL, 0, NULL) != 0)
+  {
+    printf("  TEST UNIT READY failed\n");
+    Errors++;
+  }
+
+  if((BENCH_Command(capacity, sizeof(capacity), 1, Data, 8, &received) != 0) || (received != 8))
+  {
+    printf("  READ CAPACITY failed\n");
+    Errors++;
+    return;
+  }
+  last = ((uint32_t)Data[0] << 24) | ((uint32_t)Data[1] << 16) | ((uint32_t)Data[2] << 8) | Data[3];
+  size = ((uint32_t)Data[4] << 24) | ((uint32_t)Data[5] << 16) | ((uint32_t)Data[6] << 8) | Data[7];
+  printf("  capacity                 : %lu sectors of %lu bytes\n", (unsigned long)(last + 1), (unsigned long)size);
+  if((last + 1 != BENCH_SECTORS) || (size != BENCH_SECTOR_SIZE))
+  {
+    printf("  capacity of the RAM disk not reported\n");
+    Errors++;
+  }
+
+  if((BENCH_Command(sense6, sizeof(sense6), 1, Data, MODE_SENSE6_DATA_LEN, &received) != 0) || (received < 3))
+  {
+    printf("  MODE SENSE(6) failed\n");
+    Errors++;
+    return;
+  }
+  printf("  mode sense               : write protect %s\n", (Data[2] & 0x80) ? "set" : "clear");
+  if((Data[2] & 0x80) == 0)
+  {
+    Errors++;
+  }
+}
+
+/**
+  * @brief  Reads the whole volume with commands of a number of sectors, and
+  *         checks the data against the RAM disk. The log is not written.
+  * @param  sectors: Sectors per READ(10)
+  * @param  passes: Reads of the volume
+  * @retval None
+  */
+static void BENCH_Throughput(uint16_t sectors, uint32_t passes)
+{
+  USBD_EMU_StatsTypeDef st;
+  uint32_t pass, lba, count, commands = 0, bad = 0;
+  uint64_t start, bytes = 0;
+  double   s;
+  char     name[32];
+
+  USBD_EMU_ResetStats();
+  start = USBD_EMU_GetTime();
+  for(pass = 0; pass < passes; pass++)
+  {
+    for(lba = 0; lba < BENCH_SECTORS; lba += count)
+    {
+      count = (BENCH_SECTORS - lba < sectors) ? BENCH_SECTORS - lba : sectors;
+      if(BENCH_Read10(lba, count, Data) != 0)
+      {
+        printf("  READ(10) of %lu sectors at %lu failed\n", (unsigned long)count, (unsigned long)lba);
+        Errors++;
+        return;
+      }
+      if(memcmp(Data, Volume + lba * BENCH_SECTOR_SIZE, count * BENCH_SECTOR_SIZE) != 0)
+      {
+        bad++;
+      }
+      bytes += count * BENCH_SECTOR_SIZE;
+      commands++;
+    }
+  }
+  USBD_EMU_GetStats(&st);
+  s = (USBD_EMU_GetTime() - start) / 1e6;
+
+  sprintf(name, "read %u sectors", sectors);
+  printf("  %-24s : %6.3f MB/s %7.1f commands/s  %4.1f %% of the bus, %lu NAKs, %lu bad\n",
+         name, bytes / s / 1e6, commands / s, 100.0 * st.busy_ns / (s * 1e9),
+         (unsigned long)st.naks, (unsigned long)bad);
+  Errors += st.errors + bad;
+}
+
+/**
+  * @brief  Finds the log file in an image of the volume and checks its rows,
+  *         as the FAT driver of the PC sees them: boot sector, FAT and root
+  *         directory of the FAT12 volume made by f_mkfs.
+  * @param  image: Volume
+  * @param  view: Receives what the PC sees
+  * @retval None
+  */
+static void BENCH_Parse(const uint8_t *image, BENCH_ViewTypeDef *view)
+{
+  static char file[sizeof(Image) + 1];
+  const uint8_t *fat, *entry = NULL;
+  uint32_t bps, spc, rsv, nfats, nroot, fatsz, root, data, csize;
+  uint32_t i, n, cl, off, got = 0, capture = 0;
+  char     row[64], *line, *eol;
+
+  memset(view, 0, sizeof(*view));
+  bps = image[11] | (image[12] << 8);
+  spc = image[13];
+  rsv = image[14] | (image[15] << 8);
+  nfats = image[16];
+  nroot = image[17] | (image[18] << 8);
+  fatsz = image[22] | (image[23] << 8);
+  if((bps != BENCH_SECTOR_SIZE) || (spc == 0))
+  {
+    view->bad = 1;
+    return;
+  }
+  fat = image + rsv * bps;
+  root = rsv + nfats * fatsz;
+  data = root + (nroot * 32 + bps - 1) / bps;
+  csize = spc * bps;
+
+  for(i = 0; i < nroot; i++)
+  {
+    if(image[root * bps + i * 32] == 0)
+    {
+      break;
+    }
+    if(memcmp(image + root * bps + i * 32, "LOG     CSV", 11) == 0)
+    {
+      entry = image + root * bps + i * 32;
+      break;
+    }
+  }
+  if(entry == NULL)
+  {
+    view->bad = 1;
+    return;
+  }
+  view->size = entry[28] | (entry[29] << 8) | ((uint32_t)entry[30] << 16) | ((uint32_t)entry[31] << 24);
+  cl = entry[26] | (entry[27] << 8);
+
+  /* The clusters of the chain, up to the size of the entry */
+  while((got < view->size) && (cl >= 2) && (cl < 0xFF8))
+  {
+    if(data * bps + (cl - 2 + 1) * csize > sizeof(Image))
+    {
+      view->bad = 1;
+      return;
+    }
+    n = (view->size - got < csize) ? view->size - got : csize;
+    memcpy(file + got, image + data * bps + (cl - 2) * csize, n);
+    got += n;
+    off = cl + cl / 2;
+    cl = (cl & 1) ? (fat[off] | (fat[off + 1] << 8)) >> 4 : (fat[off] | (fat[off + 1] << 8)) & 0xFFF;
+  }
+  view->stale = (got < view->size);
+  file[got] = 0;
+
+  /* Header, then the rows of the following captures; only the last one
+     may be cut, by a chain too short */
+  line = file;
+  n = strlen(BENCH_LOG_HEADER "\r\n");
+  if((got >= n) && (memcmp(line, BENCH_LOG_HEADER "\r\n", n) != 0))
+  {
+    view->bad = 1;
+    return;
+  }
+  for(line += (got >= n) ? n : got; (eol = strstr(line, "\r\n")) != NULL; line = eol + 2)
+  {
+    n = BENCH_Row(row, ++capture);
+    if(((uint32_t)(eol + 2 - line) != n) || (memcmp(line, row, n) != 0))
+    {
+      view->bad = 1;
+      return;
+    }
+    view->rows++;
+  }
+  if(!view->stale && (*line != 0))
+  {
+    /* Entry covering part of a row */
+    view->bad = 1;
+  }
+}
+
+/**
+  * @brief  Reads the volume over and over while the application appends
+  *         rows, then checks each image: a row is seen whole or not at all.
+  * @param  seconds: Time of the run
+  * @param  sectors: Sectors per READ(10)
+  * @retval None
+  */
+static void BENCH_Concurrent(uint32_t seconds, uint16_t sectors)
+{
+  BENCH_ViewTypeDef view;
+  USBD_EMU_StatsTypeDef st;
+  uint32_t lba, count, images = 0, stale = 0, bad = 0, rows0 = Log.rows, last = 0;
+  uint64_t end;
+
+  USBD_EMU_ResetStats();
+  Log.next = USBD_EMU_GetTime();
+  end = USBD_EMU_GetTime() + (uint64_t)seconds * 1000000;
+  while(USBD_EMU_GetTime() < end)
+  {
+    for(lba = 0; lba < BENCH_SECTORS; lba += count)
+    {
+      count = (BENCH_SECTORS - lba < sectors) ? BENCH_SECTORS - lba : sectors;
+      if(BENCH_Read10(lba, count, Image + lba * BENCH_SECTOR_SIZE) != 0)
+      {
+        printf("  READ(10) of %lu sectors at %lu failed\n", (unsigned long)count, (unsigned long)lba);
+        Errors++;
+        return;
+      }
+    }
+    BENCH_Parse(Image, &view);
+    images++;
+    stale += view.stale;
+    bad += view.bad;
+    last = view.rows;
+  }
+  USBD_EMU_GetStats(&st);
+
+  /* Once the logging is over, the PC sees all the rows */
+  Log.period_us = 0;
+  for(lba = 0; lba < BENCH_SECTORS; lba += sectors)
+  {
+    if(BENCH_Read10(lba, sectors, Image + lba * BENCH_SECTOR_SIZE) != 0)
+    {
+      Errors++;
+      return;
+    }
+  }
+  BENCH_Parse(Image, &view);
+
+  printf("  %-24s : %5lu rows appended, %lu images read, %lu with the FAT behind the entry, %lu bad, "
+         "%lu NAKs\n", "read while logging", (unsigned long)(Log.rows - rows0),
+         (unsigned long)images, (unsigned long)stale, (unsigned long)bad, (unsigned long)st.naks);
+  printf("  %-24s   %5lu rows in the last image, %lu after the logging, volume %s\n", "",
+         (unsigned long)last, (unsigned long)view.rows, Log.ready ? "not full" : "full");
+  if((bad != 0) || view.bad || view.stale || (view.rows != Log.rows) || (Log.rows == rows0))
+  {
+    printf("  rows seen by the PC do not match the log\n");
+    Errors++;
+  }
+  Errors += st.errors;
+}
+
+/**
+  * @brief  Tries to write a sector: the device STALLs the data, the PC
+  *         clears the pipes and the status and the sense tell the write
+  *         protection. The volume is not changed.
+  * @param  None
+  * @retval None
+  */
+static void BENCH_WriteProtect(void)
+{
+  static uint8_t before[sizeof(Volume)];
+  uint8_t  write10[10] = { SCSI_WRITE10, 0, 0, 0, 0, 0, 0, 0, 1, 0 };
+  uint8_t  sense[6] = { SCSI_REQUEST_SENSE, 0, 0, 0, REQUEST_SENSE_DATA_LEN, 0 };
+  uint8_t  status;
+  uint32_t received;
+  USBD_EMU_StatsTypeDef st;
+
+  memcpy(before, Volume, sizeof(Volume));
+  memset(Data, 0xA5, BENCH_SECTOR_SIZE);
+  USBD_EMU_ResetStats();
+  status = BENCH_Command(write10, sizeof(write10), 0, Data, BENCH_SECTOR_SIZE, NULL);
+  USBD_EMU_GetStats(&st);
+
+  if((BENCH_Command(sense, sizeof(sense), 1, Data, REQUEST_SENSE_DATA_LEN, &received) != 0) ||
+     (received < 14))
+  {
+    printf("  REQUEST SENSE failed\n");
+    Errors++;
+    return;
+  }
+  printf("  %-24s : status %u, %lu STALLs, sense key %u ASC %02X, volume %s\n", "write refused",
+         status, (unsigned long)st.stalls, Data[2] & 0x0F, Data[12],
+         (memcmp(before, Volume, sizeof(Volume)) == 0) ? "unchanged" : "changed");
+  if((status != USBD_CSW_CMD_FAILED) || ((Data[2] & 0x0F) != DATA_PROTECT) ||
+     (Data[12] != WRITE_PROTECTED) || (memcmp(before, Volume, sizeof(Volume)) != 0))
+  {
+    Errors++;
+  }
+  Errors += st.errors;
+
+  /* The next command runs as usual */
+  if(BENCH_Read10(0, 1, Data) != 0)
+  {
+    printf("  no recovery after the STALL\n");
+    Errors++;
+  }
+}
+
+/**
+  * @brief  Main program.
+  * @param  argc, argv: usbd_emu_msc_bench [-t s] [-l ms] [-n passes]
+  * @retval 0, 1 on a protocol or data error
+  */
+int main(int argc, char **argv)
+{
+  uint32_t seconds = 2, period_ms = 5, passes = 8;
+  int opt;
+
+  while((opt = getopt(argc, argv, "t:l:n:")) != -1)
+  {
+    switch(opt)
+    {
+    case 't': seconds = strtoul(optarg, NULL, 0); break;
+    case 'l': period_ms = strtoul(optarg, NULL, 0); break;
+    case 'n': passes = strtoul(optarg, NULL, 0); break;
+    default:
+      printf("usage: %s [-t seconds] [-l log_period_ms] [-n passes]\n", argv[0]);
+      return 1;
+    }
+  }
+  if((seconds == 0) || (period_ms == 0) || (passes == 0))
+  {
+    printf("Invalid parameters\n");
+    return 1;
+  }
+
+  printf("USB device emulator, MSC export of a %u sectors log volume, %u bytes media packet, "
+         "a row every %lu ms\n", BENCH_SECTORS, MSC_MEDIA_PACKET, (unsigned long)period_ms);
+
+  /* As main.c in MSC mode */
+  BENCH_LogInit();
+  CHECK(USBD_Init(&USBD_Device, &BENCH_Desc, 0));
+  CHECK(USBD_RegisterClass(&USBD_Device, USBD_MSC_CLASS));
+  CHECK(USBD_MSC_RegisterStorage(&USBD_Device, &USBD_DISK_fops));
+  CHECK(USBD_Start(&USBD_Device));
+  BENCH_Enumerate();
+  BENCH_Identify();
+
+  BENCH_Throughput(1, passes);
+  BENCH_Throughput(8, passes);
+  BENCH_Throughput(64, passes);
+  BENCH_Throughput(128, passes);
+
+  Log.period_us = period_ms * 1000;
+  BENCH_Concurrent(seconds, 8);
+
+  BENCH_WriteProtect();
+
+  printf("  protocol errors          : %lu\n", (unsigned long)Errors);
+  return (Errors != 0) ? 1 : 0;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
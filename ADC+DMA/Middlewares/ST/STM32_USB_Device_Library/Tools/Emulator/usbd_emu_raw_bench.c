@@ -0,0 +1,915 @@
+/**
+  ******************************************************************************
+  * @file    usbd_emu_raw_bench.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Bench of the raw sample streaming of the application on the
+  *          device emulator: the vendor class and usbd_raw_interface.c of
+  *          the application, fed by an emulated double buffer DMA capture,
+  *          send frames to the emulated host, read back by the parser of the
+  *          RawReader tool.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "usbd_core.h"
+#include "usbd_ctlreq.h"
+#include "usbd_vendor.h"
+#include "usbd_raw_interface.h"
+#include "raw_parser.h"
+#include "usbd_emu.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/**
+  * @brief  ADC and DMA of main.c in raw mode: the DMA fills the two memories
+  *         in turn, the end of each one calls RAW_Stream_FrameCplt
+  */
+typedef struct
+{
+  uint32_t rate;            /* Set by RAW_Capture_SetRate */
+  uint8_t  running;
+  uint16_t *mem[2];
+  uint16_t samples;
+  uint8_t  current;         /* Memory the DMA writes */
+  uint64_t start_ns;
+  uint64_t frames;          /* Memories filled since the start */
+  uint32_t position;        /* Of the waveform */
+  uint32_t starts;
+  uint32_t misaligned;      /* Memories not word aligned, or outside the pool */
+  uint64_t end_us[256];     /* End of the capture of the frames, by sequence number */
+}BENCH_CaptureTypeDef;
+
+/**
+  * @brief  Program of the PC reading the bulk IN endpoint
+  */
+typedef struct
+{
+  RAW_ParserTypeDef parser;
+  uint8_t  open;
+  uint32_t rate;            /* Bytes/s, 0 to read all the data received */
+  double   credit;
+  uint8_t  synced;
+  uint16_t last_sample;
+  uint32_t last_seq;
+  uint32_t bad;             /* Frames with samples out of sequence */
+  uint32_t gaps;            /* Frames whose first sample does not follow the previous frame */
+  uint32_t trigger_bad;     /* Trigger index not at a crossing of the level */
+  uint8_t  check_gaps;      /* The frames sent follow each other in the capture */
+  uint8_t  trigger_mode;
+  uint16_t trigger_level;
+  double   latency_sum;
+  uint32_t latency_max;
+  uint32_t latency_count;
+  FILE     *record;
+}BENCH_ReaderTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define BENCH_PCLK2         72000000  /* SystemClock_Config of main.c */
+#define BENCH_PERIOD        4000      /* Sawtooth of the input, in samples */
+#define BENCH_SLICE_US      250       /* Period of the reads of the PC */
+#define BENCH_DRAIN_US      300000    /* End of a run: the frames on the bus */
+
+#define CHECK(x)  do { if ((x) != USBD_OK) { \
+                    printf("%s failed at line %d\n", #x, __LINE__); exit(1); } } while (0)
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+USBD_HandleTypeDef USBD_Device;
+
+static BENCH_CaptureTypeDef Capture;
+static BENCH_ReaderTypeDef Reader;
+static uint32_t PipeSize = 16384;
+static uint32_t Errors;
+static uint32_t ExpectedStalls;
+
+/* Descriptors of usbd_desc.c, whose serial number is read from the unique ID
+   of the STM32 */
+static uint8_t BENCH_DeviceDesc[USB_LEN_DEV_DESC] =
+{
+  0x12, USB_DESC_TYPE_DEVICE, 0x00, 0x02, 0x00, 0x00, 0x00, USB_MAX_EP0_SIZE,
+  LOBYTE(0x0483), HIBYTE(0x0483), LOBYTE(0x5721), HIBYTE(0x5721),
+  0x00, 0x02, USBD_IDX_MFC_STR, USBD_IDX_PRODUCT_STR, USBD_IDX_SERIAL_STR,
+  USBD_MAX_NUM_CONFIGURATION
+};
+static uint8_t BENCH_LangIDDesc[USB_LEN_LANGID_STR_DESC] =
+{
+  USB_LEN_LANGID_STR_DESC, USB_DESC_TYPE_STRING, LOBYTE(0x409), HIBYTE(0x409)
+};
+static uint8_t BENCH_StrDesc[USBD_MAX_STR_DESC_SIZ];
+
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t *BENCH_DeviceDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+static uint8_t *BENCH_LangIDStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+static uint8_t *BENCH_ManufacturerStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+static uint8_t *BENCH_ProductStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+static uint8_t *BENCH_SerialStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+static uint8_t *BENCH_ConfigStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+static uint8_t *BENCH_InterfaceStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+
+static USBD_DescriptorsTypeDef BENCH_Desc =
+{
+  BENCH_DeviceDescriptor,
+  BENCH_LangIDStrDescriptor,
+  BENCH_ManufacturerStrDescriptor,
+  BENCH_ProductStrDescriptor,
+  BENCH_SerialStrDescriptor,
+  BENCH_ConfigStrDescriptor,
+  BENCH_InterfaceStrDescriptor,
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+static uint8_t *BENCH_DeviceDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  *length = sizeof(BENCH_DeviceDesc);
+  return BENCH_DeviceDesc;
+}
+
+static uint8_t *BENCH_LangIDStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  *length = sizeof(BENCH_LangIDDesc);
+  return BENCH_LangIDDesc;
+}
+
+static uint8_t *BENCH_ManufacturerStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  USBD_GetString((uint8_t *)"STMicroelectronics", BENCH_StrDesc, length);
+  return BENCH_StrDesc;
+}
+
+static uint8_t *BENCH_ProductStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  USBD_GetString((uint8_t *)"STM32 Raw ADC Stream", BENCH_StrDesc, length);
+  return BENCH_StrDesc;
+}
+
+static uint8_t *BENCH_SerialStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  USBD_GetString((uint8_t *)"00000000001A", BENCH_StrDesc, length);
+  return BENCH_StrDesc;
+}
+
+static uint8_t *BENCH_ConfigStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  USBD_GetString((uint8_t *)"Raw Config", BENCH_StrDesc, length);
+  return BENCH_StrDesc;
+}
+
+static uint8_t *BENCH_InterfaceStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length)
+{
+  USBD_GetString((uint8_t *)"Raw Interface", BENCH_StrDesc, length);
+  return BENCH_StrDesc;
+}
+
+/**
+  * @brief  RAW_Capture_SetRate of main.c, on the PCLK2 of SystemClock_Config.
+  * @param  rate: Rate asked, in Hz
+  * @retval Rate set, in Hz, or 0 if the rate asked is below the slowest one
+  */
+uint32_t RAW_Capture_SetRate(uint32_t rate)
+{
+  static const uint16_t sampling_cycles[] = { 3, 15, 28, 56, 84, 112, 144, 480 };
+  uint32_t best = 0, value;
+  uint8_t p, s;
+
+  for(p = 0; p < 4; p++)
+  {
+    for(s = 0; s < 8; s++)
+    {
+      value = BENCH_PCLK2 / (2 * (p + 1)) / (sampling_cycles[s] + 12);
+      if((value <= rate) && (value > best))
+      {
+        best = value;
+      }
+    }
+  }
+  if(best != 0)
+  {
+    Capture.rate = best;
+  }
+  return best;
+}
+
+/**
+  * @brief  RAW_Capture_Start of main.c: the DMA starts on memory 0.
+  * @param  mem0, mem1: Samples of the first two frames
+  * @param  samples: Samples of a frame
+  * @retval None
+  */
+void RAW_Capture_Start(uint16_t *mem0, uint16_t *mem1, uint16_t samples)
+{
+  if(Capture.running)
+  {
+    printf("  capture started twice\n");
+    Errors++;
+  }
+  Capture.mem[0] = mem0;
+  Capture.mem[1] = mem1;
+  Capture.samples = samples;
+  Capture.current = 0;
+  Capture.frames = 0;
+  Capture.start_ns = USBD_EMU_GetTime() * 1000;
+  Capture.running = 1;
+  Capture.starts++;
+  if((((uintptr_t)mem0 | (uintptr_t)mem1) & 3) || (mem0 == mem1))
+  {
+    Capture.misaligned++;
+  }
+}
+
+/**
+  * @brief  RAW_Capture_Stop of main.c.
+  * @param  None
+  * @retval None
+  */
+void RAW_Capture_Stop(void)
+{
+  Capture.running = 0;
+}
+
+/**
+  * @brief  End of the capture of the next memory, in ns.
+  * @param  None
+  * @retval Date
+  */
+static uint64_t BENCH_CaptureEnd(void)
+{
+  return Capture.start_ns + (uint64_t)((Capture.frames + 1) * Capture.samples * 1e9 / Capture.rate + 0.5);
+}
+
+/**
+  * @brief  End of a memory: the DMA has written the samples of the input, a
+  *         sawtooth, and goes on with the other memory; the transfer complete
+  *         interrupt gives the memory after it.
+  * @param  None
+  * @retval None
+  */
+static void BENCH_CaptureCplt(void)
+{
+  uint16_t *samples = Capture.mem[Capture.current];
+  uint16_t *next;
+  uint16_t i;
+  RAW_FrameHeaderTypeDef *header;
+
+  for(i = 0; i < Capture.samples; i++)
+  {
+    samples[i] = Capture.position;
+    Capture.position = (Capture.position + 1) % BENCH_PERIOD;
+  }
+  Capture.frames++;
+
+  next = RAW_Stream_FrameCplt(samples, (uint32_t)(USBD_EMU_GetTime() / 1000));
+  if(next != samples)
+  {
+    /* Queued: the header is in front of the samples */
+    header = (RAW_FrameHeaderTypeDef *)((uint8_t *)samples - RAW_FRAME_HEADER_SIZE);
+    Capture.end_us[header->seq % 256] = USBD_EMU_GetTime();
+    if(((uintptr_t)next & 3) || (next == Capture.mem[Capture.current ^ 1]))
+    {
+      Capture.misaligned++;
+    }
+  }
+  Capture.mem[Capture.current] = next;
+  Capture.current ^= 1;
+}
+
+/**
+  * @brief  Runs a control transfer of the host.
+  * @param  bmRequest, bRequest, wValue, wIndex, wLength: Setup packet
+  * @param  data: Data of the request
+  * @param  length: Receives the number of data bytes, may be NULL
+  * @retval USBD_OK, or USBD_FAIL if the request failed
+  */
+static uint8_t BENCH_Request(uint8_t bmRequest, uint8_t bRequest, uint16_t wValue,
+                             uint16_t wIndex, uint16_t wLength, uint8_t *data, uint16_t *length)
+{
+  uint8_t setup[8];
+
+  setup[0] = bmRequest;
+  setup[1] = bRequest;
+  setup[2] = LOBYTE(wValue);
+  setup[3] = HIBYTE(wValue);
+  setup[4] = LOBYTE(wIndex);
+  setup[5] = HIBYTE(wIndex);
+  setup[6] = LOBYTE(wLength);
+  setup[7] = HIBYTE(wLength);
+  return USBD_EMU_Control(setup, data, length);
+}
+
+/**
+  * @brief  Vendor request of raw_frame.h without data.
+  * @param  bRequest, wValue: Request
+  * @retval USBD_OK, or USBD_FAIL if STALLed
+  */
+static uint8_t BENCH_Vendor(uint8_t bRequest, uint16_t wValue)
+{
+  return BENCH_Request(0x41, bRequest, wValue, 0, 0, NULL, NULL);
+}
+
+/**
+  * @brief  Reads the status of the stream.
+  * @param  status: Receives it
+  * @retval None
+  */
+static void BENCH_GetStatus(RAW_StatusTypeDef *status)
+{
+  uint8_t  data[64];
+  uint16_t len;
+
+  CHECK(BENCH_Request(0xC1, RAW_REQ_GET_STATUS, 0, 0, sizeof(data), data, &len));
+  if(len != RAW_STATUS_SIZE)
+  {
+    printf("  status of %u bytes\n", len);
+    Errors++;
+  }
+  status->sample_rate   = data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+  status->state         = data[4];
+  status->trigger_mode  = data[5];
+  status->trigger_level = data[6] | (data[7] << 8);
+  status->seq           = data[8] | (data[9] << 8) | (data[10] << 16) | ((uint32_t)data[11] << 24);
+  status->sent          = data[12] | (data[13] << 8) | (data[14] << 16) | ((uint32_t)data[15] << 24);
+  status->dropped       = data[16] | (data[17] << 8) | (data[18] << 16) | ((uint32_t)data[19] << 24);
+}
+
+/**
+  * @brief  Enumerates the device and checks its descriptors, as the PC.
+  * @param  None
+  * @retval None
+  */
+static void BENCH_Enumerate(void)
+{
+  uint8_t  desc[256];
+  uint16_t len, total, i, in_mps = 0;
+  uint8_t  itf_class = 0;
+  uint64_t start = USBD_EMU_GetTime();
+  USBD_EMU_StatsTypeDef st;
+
+  USBD_EMU_ResetStats();
+  USBD_EMU_Attach();
+
+  CHECK(BENCH_Request(0x80, USB_REQ_GET_DESCRIPTOR, USB_DESC_TYPE_DEVICE << 8, 0, 64, desc, &len));
+  CHECK(BENCH_Request(0x00, USB_REQ_SET_ADDRESS, 1, 0, 0, NULL, NULL));
+  CHECK(BENCH_Request(0x80, USB_REQ_GET_DESCRIPTOR, USB_DESC_TYPE_DEVICE << 8, 0, USB_LEN_DEV_DESC, desc, &len));
+  if((len != USB_LEN_DEV_DESC) || (desc[1] != USB_DESC_TYPE_DEVICE))
+  {
+    printf("Invalid device descriptor\n");
+    exit(1);
+  }
+  printf("  device                   : VID %04X PID %04X, EP0 %u bytes\n",
+         desc[8] | (desc[9] << 8), desc[10] | (desc[11] << 8), desc[7]);
+
+  CHECK(BENCH_Request(0x80, USB_REQ_GET_DESCRIPTOR, USB_DESC_TYPE_CONFIGURATION << 8, 0, 9, desc, &len));
+  total = desc[2] | (desc[3] << 8);
+  CHECK(BENCH_Request(0x80, USB_REQ_GET_DESCRIPTOR, USB_DESC_TYPE_CONFIGURATION << 8, 0, sizeof(desc), desc, &len));
+  if(len != total)
+  {
+    printf("Configuration descriptor of %u bytes, %u expected\n", len, total);
+    exit(1);
+  }
+  for(i = 0; i + 6 < len; i += desc[i])
+  {
+    if(desc[i + 1] == USB_DESC_TYPE_INTERFACE)
+    {
+      itf_class = desc[i + 5];
+    }
+    if((desc[i + 1] == USB_DESC_TYPE_ENDPOINT) && (desc[i + 2] == VENDOR_IN_EP) && (desc[i + 3] == 0x02))
+    {
+      in_mps = desc[i + 4] | (desc[i + 5] << 8);
+    }
+    if(desc[i] == 0)
+    {
+      break;
+    }
+  }
+  if((itf_class != 0xFF) || (in_mps != VENDOR_DATA_FS_MAX_PACKET_SIZE))
+  {
+    printf("No vendor interface with a bulk IN endpoint %02X of %u bytes\n",
+           VENDOR_IN_EP, VENDOR_DATA_FS_MAX_PACKET_SIZE);
+    exit(1);
+  }
+  printf("  configuration            : %u bytes, interface class %02X, bulk IN %02X of %u bytes\n",
+         total, itf_class, VENDOR_IN_EP, in_mps);
+
+  CHECK(BENCH_Request(0x80, USB_REQ_GET_DESCRIPTOR, USB_DESC_TYPE_STRING << 8, 0, 255, desc, &len));
+  CHECK(BENCH_Request(0x80, USB_REQ_GET_DESCRIPTOR, (USB_DESC_TYPE_STRING << 8) | USBD_IDX_PRODUCT_STR,
+                      0x409, 255, desc, &len));
+
+  CHECK(BENCH_Request(0x00, USB_REQ_SET_CONFIGURATION, 1, 0, 0, NULL, NULL));
+  if(USBD_Device.dev_state != USBD_STATE_CONFIGURED)
+  {
+    printf("Device not configured\n");
+    exit(1);
+  }
+
+  USBD_EMU_GetStats(&st);
+  printf("  enumeration              : %7.1f ms  %5lu control transfers %3lu STALLs %5lu SOFs\n",
+         (USBD_EMU_GetTime() - start) / 1000.0, (unsigned long)st.setups,
+         (unsigned long)st.stalls, (unsigned long)st.sofs);
+  Errors += st.errors;
+}
+
+/**
+  * @brief  Frame callback of the parser: checks the sawtooth of
+  *         BENCH_CaptureCplt, the continuity between the frames, the trigger
+  *         and the latency of the frame.
+  * @param  header: Frame header
+  * @param  samples: ADC codes
+  * @param  context: Reader
+  * @retval None
+  */
+static void BENCH_OnFrame(const RAW_FrameHeaderTypeDef *header, const uint16_t *samples, void *context)
+{
+  BENCH_ReaderTypeDef *reader = (BENCH_ReaderTypeDef *)context;
+  uint32_t i, expected, latency;
+  uint8_t  bad = 0;
+
+  if((header->samples != RAW_STREAM_SAMPLES) || (header->sample_rate != Capture.rate) ||
+     (header->bits != RAW_STREAM_BITS))
+  {
+    bad = 1;
+  }
+  for(i = 1; (i < header->samples) && !bad; i++)
+  {
+    if(samples[i] != (samples[i - 1] + 1) % BENCH_PERIOD)
+    {
+      bad = 1;
+    }
+  }
+  if(bad)
+  {
+    reader->bad++;
+  }
+
+  /* The first sample follows the last one of the previous frame, the frames
+     the device dropped included: no sample is lost between two memories */
+  if(reader->synced && reader->check_gaps && !bad)
+  {
+    expected = (reader->last_sample + 1 +
+                (header->seq - reader->last_seq - 1) * RAW_STREAM_SAMPLES) % BENCH_PERIOD;
+    if(samples[0] != expected)
+    {
+      reader->gaps++;
+    }
+  }
+
+  if(reader->trigger_mode != RAW_TRIGGER_NONE)
+  {
+    i = header->trigger;
+    if((i == RAW_FRAME_NO_TRIGGER) ? reader->check_gaps == 0 :
+       ((i > 0) && ((reader->trigger_mode == RAW_TRIGGER_RISING) ?
+                    !((samples[i - 1] < reader->trigger_level) && (samples[i] >= reader->trigger_level)) :
+                    !((samples[i - 1] >= reader->trigger_level) && (samples[i] < reader->trigger_level)))))
+    {
+      reader->trigger_bad++;
+    }
+  }
+
+  latency = (uint32_t)(USBD_EMU_GetTime() - Capture.end_us[header->seq % 256]);
+  reader->latency_sum += latency;
+  reader->latency_max = (latency > reader->latency_max) ? latency : reader->latency_max;
+  reader->latency_count++;
+
+  reader->synced = 1;
+  reader->last_sample = samples[header->samples - 1];
+  reader->last_seq = header->seq;
+}
+
+/**
+  * @brief  Starts the reading of the PC.
+  * @param  check_gaps: The frames follow each other in the capture
+  * @retval None
+  */
+static void BENCH_Open(uint8_t check_gaps)
+{
+  RAW_ParserInit(&Reader.parser, BENCH_OnFrame, &Reader);
+  Reader.synced = 0;
+  Reader.credit = 0;
+  Reader.bad = 0;
+  Reader.gaps = 0;
+  Reader.trigger_bad = 0;
+  Reader.check_gaps = check_gaps;
+  Reader.latency_sum = 0;
+  Reader.latency_max = 0;
+  Reader.latency_count = 0;
+  Reader.open = 1;
+  USBD_EMU_OpenPipe(VENDOR_IN_EP, PipeSize);
+}
+
+/**
+  * @brief  Stops the reading of the PC.
+  * @param  None
+  * @retval None
+  */
+static void BENCH_Close(void)
+{
+  USBD_EMU_ClosePipe(VENDOR_IN_EP);
+  Reader.open = 0;
+}
+
+/**
+  * @brief  Lets the time run: the capture, the bus and the reads of the PC.
+  * @param  us: Time in us
+  * @retval None
+  */
+static void BENCH_Run(uint32_t us)
+{
+  static uint8_t buff[65536];
+  uint64_t now, end = USBD_EMU_GetTime() * 1000 + (uint64_t)us * 1000, until, cplt;
+  uint32_t n, max;
+
+  while((now = USBD_EMU_GetTime() * 1000) < end)
+  {
+    until = now + BENCH_SLICE_US * 1000;
+    until = (until < end) ? until : end;
+    cplt = Capture.running ? BENCH_CaptureEnd() : until;
+    if(cplt < until)
+    {
+      until = cplt;
+    }
+    if(until > now)
+    {
+      USBD_EMU_Run((uint32_t)((until - now + 999) / 1000));
+    }
+    while(Capture.running && (BENCH_CaptureEnd() <= USBD_EMU_GetTime() * 1000))
+    {
+      BENCH_CaptureCplt();
+    }
+
+    if(!Reader.open)
+    {
+      continue;
+    }
+    max = sizeof(buff);
+    if(Reader.rate != 0)
+    {
+      Reader.credit += (double)Reader.rate * (USBD_EMU_GetTime() * 1000 - now) / 1e9;
+      max = (Reader.credit < max) ? (uint32_t)Reader.credit : max;
+    }
+    n = USBD_EMU_Read(VENDOR_IN_EP, buff, max);
+    if((n != 0) && (Reader.record != NULL))
+    {
+      fwrite(buff, 1, n, Reader.record);
+    }
+    RAW_Parse(&Reader.parser, buff, n);
+    if(Reader.rate != 0)
+    {
+      /* No credit saved while there is nothing to read */
+      Reader.credit = (n < max) ? 0 : Reader.credit - n;
+    }
+  }
+}
+
+/**
+  * @brief  Prints the figures of a run and checks the frames: every frame
+  *         sent is received intact, the drops are whole frames told to the
+  *         reader.
+  * @param  name: Name of the run
+  * @param  start, end: Time of the capture, in us
+  * @param  bytes: Bytes received during the capture
+  * @param  st: Bus counters of the capture
+  * @param  sent, dropped: Counters of the device for the run
+  * @retval None
+  */
+static void BENCH_Report(const char *name, uint64_t start, uint64_t end, uint64_t bytes,
+                         const USBD_EMU_StatsTypeDef *st, uint32_t sent, uint32_t dropped)
+{
+  RAW_ParserTypeDef *p = &Reader.parser;
+  double s = (end - start) / 1e6;
+
+  printf("  %-24s : %6.3f MB/s %6.1f frames/s  %5lu sent %5lu dropped  %4.1f %% of the bus, %lu NAKs\n",
+         name, bytes / s / 1e6, p->frames / s, (unsigned long)sent, (unsigned long)dropped,
+         100.0 * st->busy_ns / ((end - start) * 1000.0), (unsigned long)st->naks);
+  printf("  %-24s   received %5lu frames, %lu dropped in the headers, %lu lost, %lu gaps, "
+         "%lu errors, %lu bad, latency %.2f ms mean %.2f ms max\n", "",
+         (unsigned long)p->frames, (unsigned long)p->dropped,
+         (unsigned long)(p->missed - p->dropped), (unsigned long)Reader.gaps,
+         (unsigned long)p->errors, (unsigned long)Reader.bad,
+         Reader.latency_count ? Reader.latency_sum / Reader.latency_count / 1000.0 : 0.0,
+         Reader.latency_max / 1000.0);
+
+  if((p->frames != sent) || (p->missed != p->dropped) || (p->dropped > dropped) ||
+     (p->skipped != 0) || (p->errors != 0) || (Reader.bad != 0) || (Reader.gaps != 0) ||
+     (Reader.trigger_bad != 0) || (Capture.misaligned != 0))
+  {
+    printf("  frame accounting mismatch\n");
+    Errors++;
+  }
+  Errors += st->errors;
+}
+
+/**
+  * @brief  Streams at a rate until RAW_REQ_STOP, then drains the bus.
+  * @param  name: Name of the run
+  * @param  rate: Rate asked, in Hz
+  * @param  seconds: Time of the capture
+  * @retval None
+  */
+static void BENCH_Stream(const char *name, uint32_t rate, uint32_t seconds)
+{
+  USBD_EMU_StatsTypeDef st;
+  RAW_StatusTypeDef status;
+  uint32_t sent0, dropped0, sent, dropped;
+  uint64_t start, end, bytes;
+
+  CHECK(BENCH_Vendor(RAW_REQ_SET_RATE, (uint16_t)((rate + 99) / 100)));
+  BENCH_GetStatus(&status);
+  if(status.sample_rate != Capture.rate)
+  {
+    printf("  rate %lu Hz reported, %lu Hz set\n", (unsigned long)status.sample_rate,
+           (unsigned long)Capture.rate);
+    Errors++;
+  }
+  RAW_Stream_GetStats(&sent0, &dropped0);
+  BENCH_Open(1);
+  USBD_EMU_ResetStats();
+  start = USBD_EMU_GetTime();
+  CHECK(BENCH_Vendor(RAW_REQ_START, 0));
+  BENCH_Run(seconds * 1000000);
+  CHECK(BENCH_Vendor(RAW_REQ_STOP, 0));
+  end = USBD_EMU_GetTime();
+  bytes = Reader.parser.bytes;
+  USBD_EMU_GetStats(&st);
+
+  /* The frames queued before the stop reach the PC */
+  BENCH_Run(BENCH_DRAIN_US);
+  RAW_Stream_GetStats(&sent, &dropped);
+  BENCH_Report(name, start, end, bytes, &st, sent - sent0, dropped - dropped0);
+  BENCH_Close();
+}
+
+/**
+  * @brief  Single shot: a count of frames from a rising edge, then the
+  *         capture stops by itself.
+  * @param  None
+  * @retval None
+  */
+static void BENCH_SingleShot(void)
+{
+  RAW_ParserTypeDef *p = &Reader.parser;
+  RAW_StatusTypeDef status;
+  uint32_t first_trigger;
+
+  CHECK(BENCH_Vendor(RAW_REQ_SET_RATE, 2250));
+  CHECK(BENCH_Vendor(RAW_REQ_SET_TRIGGER, RAW_TRIGGER_VALUE(RAW_TRIGGER_RISING, 3000)));
+  Reader.trigger_mode = RAW_TRIGGER_RISING;
+  Reader.trigger_level = 3000;
+
+  BENCH_Open(1);
+  /* Input below the level at the start: the trigger is the first rising edge */
+  Capture.position = 0;
+  CHECK(BENCH_Vendor(RAW_REQ_START, 4));
+  BENCH_GetStatus(&status);
+  BENCH_Run(100000);
+  first_trigger = p->triggered;
+  BENCH_Run(BENCH_DRAIN_US);
+  BENCH_GetStatus(&status);
+
+  printf("  %-24s : %5lu frames, %lu with the trigger, state %u after, %lu lost, %lu gaps, %lu bad trigger\n",
+         "single shot 4 frames", (unsigned long)p->frames, (unsigned long)first_trigger,
+         status.state, (unsigned long)p->missed, (unsigned long)Reader.gaps,
+         (unsigned long)Reader.trigger_bad);
+  if((p->frames != 4) || (first_trigger == 0) || (status.state != RAW_STATE_IDLE) || Capture.running ||
+     (p->missed != 0) || (p->errors != 0) || (Reader.bad != 0) || (Reader.gaps != 0) ||
+     (Reader.trigger_bad != 0))
+  {
+    printf("  single shot failed\n");
+    Errors++;
+  }
+  BENCH_Close();
+}
+
+/**
+  * @brief  Normal trigger mode: each frame holding a falling edge is sent,
+  *         the others are skipped.
+  * @param  seconds: Time of the capture
+  * @retval None
+  */
+static void BENCH_Triggered(uint32_t seconds)
+{
+  RAW_ParserTypeDef *p = &Reader.parser;
+  uint64_t frames0;
+  uint32_t expected;
+
+  CHECK(BENCH_Vendor(RAW_REQ_SET_TRIGGER, RAW_TRIGGER_VALUE(RAW_TRIGGER_FALLING, 2000)));
+  Reader.trigger_mode = RAW_TRIGGER_FALLING;
+  Reader.trigger_level = 2000;
+
+  BENCH_Open(0);
+  CHECK(BENCH_Vendor(RAW_REQ_START, 0));
+  frames0 = Capture.frames;
+  BENCH_Run(seconds * 1000000);
+  CHECK(BENCH_Vendor(RAW_REQ_STOP, 0));
+  /* One falling edge per period of the sawtooth, at its wrap */
+  expected = (uint32_t)((Capture.frames - frames0) * RAW_STREAM_SAMPLES / BENCH_PERIOD);
+  BENCH_Run(BENCH_DRAIN_US);
+
+  printf("  %-24s : %5lu frames of %lu captured, %lu edges, %lu without the trigger, %lu bad trigger\n",
+         "triggered, falling edge", (unsigned long)p->frames, (unsigned long)(Capture.frames - frames0),
+         (unsigned long)expected, (unsigned long)(p->frames - p->triggered),
+         (unsigned long)Reader.trigger_bad);
+  if((p->frames + 1 < expected) || (p->frames > expected + 1) || (p->triggered != p->frames) ||
+     (p->errors != 0) || (Reader.bad != 0) || (Reader.trigger_bad != 0))
+  {
+    printf("  triggered capture failed\n");
+    Errors++;
+  }
+
+  CHECK(BENCH_Vendor(RAW_REQ_SET_TRIGGER, RAW_TRIGGER_VALUE(RAW_TRIGGER_NONE, 0)));
+  Reader.trigger_mode = RAW_TRIGGER_NONE;
+  BENCH_Close();
+}
+
+/**
+  * @brief  The requests the device must STALL, each followed by a request
+  *         that must pass on EP0.
+  * @param  None
+  * @retval None
+  */
+static void BENCH_Stalls(void)
+{
+  USBD_EMU_StatsTypeDef st;
+  RAW_StatusTypeDef status;
+  uint8_t  data[64];
+  uint16_t len;
+  uint32_t refused = 0;
+
+  USBD_EMU_ResetStats();
+  BENCH_Open(1);
+
+  /* Rate below the slowest one of the ADC, bad trigger mode, unknown request,
+     GET_STATUS as an OUT request, data stage on a request without one */
+  refused += (BENCH_Vendor(RAW_REQ_SET_RATE, 1) != USBD_OK);
+  refused += (BENCH_Vendor(RAW_REQ_SET_TRIGGER, (3 << 12) | 100) != USBD_OK);
+  refused += (BENCH_Vendor(0x7F, 0) != USBD_OK);
+  refused += (BENCH_Vendor(RAW_REQ_GET_STATUS, 0) != USBD_OK);
+  refused += (BENCH_Request(0xC1, RAW_REQ_START, 0, 0, sizeof(data), data, &len) != USBD_OK);
+
+  /* While running: rate, trigger and a second start */
+  CHECK(BENCH_Vendor(RAW_REQ_START, 0));
+  BENCH_Run(20000);
+  refused += (BENCH_Vendor(RAW_REQ_SET_RATE, 4500) != USBD_OK);
+  refused += (BENCH_Vendor(RAW_REQ_SET_TRIGGER, RAW_TRIGGER_VALUE(RAW_TRIGGER_RISING, 100)) != USBD_OK);
+  refused += (BENCH_Vendor(RAW_REQ_START, 0) != USBD_OK);
+  BENCH_GetStatus(&status);
+  CHECK(BENCH_Vendor(RAW_REQ_STOP, 0));
+  BENCH_Run(BENCH_DRAIN_US);
+
+  USBD_EMU_GetStats(&st);
+  printf("  %-24s : %lu of 8 refused, %lu STALLs, state %u while running, rate %lu Hz kept\n",
+         "requests refused", (unsigned long)refused, (unsigned long)st.stalls, status.state,
+         (unsigned long)status.sample_rate);
+  if((refused != 8) || (st.stalls != 8) || (status.state != RAW_STATE_RUNNING) ||
+     (status.sample_rate != RAW_STREAM_DEFAULT_RATE) || (Capture.rate != RAW_STREAM_DEFAULT_RATE) ||
+     (Capture.starts != 1))
+  {
+    printf("  request handling failed\n");
+    Errors++;
+  }
+  ExpectedStalls += st.stalls;
+  Errors += st.errors;
+  BENCH_Close();
+}
+
+/**
+  * @brief  Bus reset while streaming: the capture stops, the PC enumerates
+  *         again and the stream restarts from sequence number 0.
+  * @param  None
+  * @retval None
+  */
+static void BENCH_Reset(void)
+{
+  RAW_ParserTypeDef *p = &Reader.parser;
+  RAW_StatusTypeDef status;
+  uint8_t stopped;
+
+  CHECK(BENCH_Vendor(RAW_REQ_SET_RATE, 2250));
+  BENCH_Open(1);
+  CHECK(BENCH_Vendor(RAW_REQ_START, 0));
+  BENCH_Run(200000);
+  BENCH_Close();
+
+  BENCH_Enumerate();
+  stopped = !Capture.running;
+  BENCH_GetStatus(&status);
+
+  BENCH_Open(1);
+  CHECK(BENCH_Vendor(RAW_REQ_START, 0));
+  BENCH_Run(200000);
+  CHECK(BENCH_Vendor(RAW_REQ_STOP, 0));
+  BENCH_Run(BENCH_DRAIN_US);
+  printf("  %-24s : capture %s, state %u seq %lu after, %5lu frames from seq 0, %lu lost, %lu gaps, %lu bad\n",
+         "bus reset", stopped ? "stopped" : "running", status.state, (unsigned long)status.seq,
+         (unsigned long)p->frames, (unsigned long)p->missed, (unsigned long)Reader.gaps,
+         (unsigned long)Reader.bad);
+  if(!stopped || (status.state != RAW_STATE_IDLE) || (status.seq != 0) || (p->frames == 0) ||
+     (p->next_seq != p->frames) || (p->errors != 0) || (Reader.bad != 0) || (Reader.gaps != 0))
+  {
+    printf("  stream not resumed after the reset\n");
+    Errors++;
+  }
+  BENCH_Close();
+}
+
+/**
+  * @brief  Main program.
+  * @param  argc, argv: usbd_emu_raw_bench [-t s] [-r reader_KB/s] [-b bytes]
+  *         [-o file]
+  * @retval 0, 1 on a protocol or data error
+  */
+int main(int argc, char **argv)
+{
+  RAW_StatusTypeDef status;
+  uint32_t seconds = 2, rate = 200;
+  const char *record = NULL;
+  int opt;
+
+  while((opt = getopt(argc, argv, "t:r:b:o:")) != -1)
+  {
+    switch(opt)
+    {
+    case 't': seconds = strtoul(optarg, NULL, 0); break;
+    case 'r': rate = strtoul(optarg, NULL, 0); break;
+    case 'b': PipeSize = strtoul(optarg, NULL, 0); break;
+    case 'o': record = optarg; break;
+    default:
+      printf("usage: %s [-t seconds] [-r reader_KB/s] [-b pc_buffer] [-o file]\n", argv[0]);
+      return 1;
+    }
+  }
+  if((seconds == 0) || (PipeSize < VENDOR_DATA_FS_MAX_PACKET_SIZE))
+  {
+    printf("Invalid parameters\n");
+    return 1;
+  }
+
+  printf("USB device emulator, raw streaming of %u samples (%u bytes frames), %u frames pool, "
+         "%lu bytes PC buffer\n", RAW_STREAM_SAMPLES, (unsigned)RAW_STREAM_FRAME_SIZE, RAW_STREAM_FRAMES,
+         (unsigned long)PipeSize);
+
+  /* As main.c in device mode with USBD_STREAM_RAW */
+  CHECK(USBD_Init(&USBD_Device, &BENCH_Desc, 0));
+  CHECK(USBD_RegisterClass(&USBD_Device, USBD_VENDOR_CLASS));
+  CHECK(USBD_VENDOR_RegisterInterface(&USBD_Device, &USBD_RAW_fops));
+  CHECK(USBD_Start(&USBD_Device));
+  BENCH_Enumerate();
+
+  BENCH_GetStatus(&status);
+  printf("  %-24s : %lu Hz, state %u, trigger %u\n", "status", (unsigned long)status.sample_rate,
+         status.state, status.trigger_mode);
+  if((status.sample_rate != RAW_STREAM_DEFAULT_RATE) || (status.state != RAW_STATE_IDLE))
+  {
+    Errors++;
+  }
+
+  BENCH_Stalls();
+
+  if(record != NULL)
+  {
+    Reader.record = fopen(record, "wb");
+  }
+  BENCH_Stream("225 kHz", 225000, seconds);
+  if(Reader.record != NULL)
+  {
+    fclose(Reader.record);
+    Reader.record = NULL;
+  }
+  BENCH_Stream("450 kHz", 450000, seconds);
+  BENCH_Stream("529 kHz, 600 kHz asked", 600000, seconds);
+  BENCH_Stream("2.4 MHz, saturated", 6553500, seconds);
+
+  /* PC reading slower than the capture */
+  Reader.rate = rate * 1000;
+  BENCH_Stream("slow reader", 225000, seconds);
+  Reader.rate = 0;
+
+  BENCH_SingleShot();
+  BENCH_Triggered(seconds);
+  BENCH_Reset();
+
+  printf("  protocol errors          : %lu\n", (unsigned long)Errors);
+  return (Errors != 0) ? 1 : 0;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -91,6 +91,11 @@ MSC_ReqStateTypeDef;
 
 #define MAX_SUPPORTED_LUN       2
 
+/* Writes queued by USBH_MSC_StreamWrite, a power of 2 */
+#ifndef USBH_MSC_STREAM_DEPTH
+ #define USBH_MSC_STREAM_DEPTH      4
+#endif
+
 /* Structure for LUN */
 typedef struct
 {
@@ -105,6 +110,28 @@ typedef struct
 }
 MSC_LUNTypeDef; 
 
+/* Write queued in the stream */
+typedef struct
+{
+  uint32_t                    address;
+  uint8_t                     *pbuf;
+  uint32_t                    length;
+}
+MSC_StreamReqTypeDef;
+
+/* Structure for the write stream */
+typedef struct
+{
+  MSC_StreamReqTypeDef        req[USBH_MSC_STREAM_DEPTH];
+  __IO uint32_t               queued;      /* Queued writes, counted by USBH_MSC_StreamWrite */
+  __IO uint32_t               completed;   /* Completed writes, counted by the class process */
+  uint8_t                     cmd_count;   /* Writes of the WRITE10 command, 0 if none       */
+  uint8_t                     seg;         /* Write of its data stage                        */
+  uint8_t                     lun;
+  USBH_StatusTypeDef          status;      /* Status of the last command                     */
+}
+MSC_StreamTypeDef;
+
 /* Structure for MSC process */
 typedef struct _MSC_Process
 {
@@ -124,6 +151,12 @@ typedef struct _MSC_Process
   uint16_t             current_lun; 
   uint16_t             rw_lun;   
   uint32_t             timer;
+  MSC_StreamTypeDef    stream;
+#if (USBH_USE_OS == 1)
+  osSemaphoreId        rw_sem;      /* Released by the host task at the end of a Read/Write */
+  __IO uint8_t         rw_pending;  /* Read/Write of USBH_MSC_Read/Write run by the host task */
+  USBH_StatusTypeDef   rw_status;
+#endif
 }
 MSC_HandleTypeDef; 
 
@@ -182,6 +215,8 @@ int8_t             USBH_MSC_GetMaxLUN (USBH_HandleTypeDef *phost);
 uint8_t            USBH_MSC_UnitIsReady (USBH_HandleTypeDef *phost, uint8_t lun);
 
 USBH_StatusTypeDef USBH_MSC_GetLUNInfo(USBH_HandleTypeDef *phost, uint8_t lun, MSC_LUNTypeDef *info);
+
+USBH_StatusTypeDef USBH_MSC_CheckUnit(USBH_HandleTypeDef *phost, uint8_t lun);
                                  
 USBH_StatusTypeDef USBH_MSC_Read(USBH_HandleTypeDef *phost,
                                      uint8_t lun,
@@ -194,6 +229,26 @@ USBH_StatusTypeDef USBH_MSC_Write(USBH_HandleTypeDef *phost,
                                      uint32_t address,
                                      uint8_t *pbuf,
                                      uint32_t length);
+
+USBH_StatusTypeDef USBH_MSC_WriteStart(USBH_HandleTypeDef *phost,
+                                     uint8_t lun,
+                                     uint32_t address,
+                                     uint8_t *pbuf,
+                                     uint32_t length);
+
+USBH_StatusTypeDef USBH_MSC_RdWrPoll(USBH_HandleTypeDef *phost, uint8_t lun);
+
+USBH_StatusTypeDef USBH_MSC_StreamWrite(USBH_HandleTypeDef *phost,
+                                     uint8_t lun,
+                                     uint32_t address,
+                                     uint8_t *pbuf,
+                                     uint32_t length);
+
+USBH_StatusTypeDef USBH_MSC_StreamProcess(USBH_HandleTypeDef *phost);
+
+USBH_StatusTypeDef USBH_MSC_StreamWait(USBH_HandleTypeDef *phost);
+
+uint32_t           USBH_MSC_StreamCompleted(USBH_HandleTypeDef *phost);
 /**
   * @}
   */ 
@@ -135,6 +135,7 @@ typedef struct
   BOT_CSWTypeDef             csw; 
   uint8_t                    Reserved2[3];  
   uint8_t                    *pbuf;
+  uint32_t                   seg_len;     /* Bytes left in pbuf, 0 if pbuf holds the whole data stage */
 } 
 BOT_HandleTypeDef;
 
@@ -108,6 +108,12 @@ static USBH_StatusTypeDef USBH_MSC_SOFProcess(USBH_HandleTypeDef *phost);
 
 static USBH_StatusTypeDef USBH_MSC_RdWrProcess(USBH_HandleTypeDef *phost, uint8_t lun);
 
+static USBH_StatusTypeDef USBH_MSC_RdWrWait(USBH_HandleTypeDef *phost, uint8_t lun, uint32_t length);
+
+static void USBH_MSC_StreamStep(USBH_HandleTypeDef *phost);
+
+static void USBH_MSC_StreamStart(USBH_HandleTypeDef *phost);
+
 USBH_ClassTypeDef  USBH_msc = 
 {
   "MSC",
@@ -200,6 +206,15 @@ static USBH_StatusTypeDef USBH_MSC_InterfaceInit (USBH_HandleTypeDef *phost)
     
     /* De-Initialize LUNs information */
     USBH_memset(MSC_Handle->unit, 0, sizeof(MSC_Handle->unit));
+    USBH_memset(&MSC_Handle->stream, 0, sizeof(MSC_Handle->stream));
+    
+#if (USBH_USE_OS == 1)
+    /* Binary semaphore, created available */
+    osSemaphoreDef(MSC_RdWr);
+    MSC_Handle->rw_sem = osSemaphoreCreate(osSemaphore(MSC_RdWr), 1);
+    osSemaphoreWait(MSC_Handle->rw_sem, 0);
+    MSC_Handle->rw_pending = 0;
+#endif
     
     /* Open the new channels */
     USBH_OpenPipe  (phost,
@@ -250,6 +265,17 @@ USBH_StatusTypeDef USBH_MSC_InterfaceDeInit (USBH_HandleTypeDef *phost)
     MSC_Handle->InPipe = 0;     /* Reset the Channel as Free */
   } 
 
+#if (USBH_USE_OS == 1)
+  if(MSC_Handle->rw_pending)
+  {
+    /* Wake the caller of USBH_MSC_Read/Write */
+    MSC_Handle->rw_pending = 0;
+    MSC_Handle->rw_status = USBH_FAIL;
+    osSemaphoreRelease(MSC_Handle->rw_sem);
+  }
+  osSemaphoreDelete(MSC_Handle->rw_sem);
+#endif
+
   if(phost->pActiveClass->pData)
   {
     USBH_free (phost->pActiveClass->pData);
@@ -281,6 +307,11 @@ static USBH_StatusTypeDef USBH_MSC_ClassRequest(USBH_HandleTypeDef *phost)
     if(USBH_MSC_BOT_REQ_GetMaxLUN(phost, (uint8_t *)&MSC_Handle->max_lun) == USBH_OK )
     {
       MSC_Handle->max_lun = (uint8_t )(MSC_Handle->max_lun) + 1;
+      if(MSC_Handle->max_lun > MAX_SUPPORTED_LUN)
+      {
+        /* The units after the first ones are not used */
+        MSC_Handle->max_lun = MAX_SUPPORTED_LUN;
+      }
       USBH_UsrLog ("Number of supported LUN: %lu", (int32_t)(MSC_Handle->max_lun));
       
       for(i = 0; i < MSC_Handle->max_lun; i++)
@@ -461,6 +492,9 @@ static USBH_StatusTypeDef USBH_MSC_Process(USBH_HandleTypeDef *phost)
     
       case MSC_UNRECOVERED_ERROR: 
         MSC_Handle->current_lun++;
+#if (USBH_USE_OS == 1)
+        osMessagePut ( phost->os_event, USBH_CLASS_EVENT, 0);
+#endif       
         break;  
         
       default:
@@ -468,7 +502,11 @@ static USBH_StatusTypeDef USBH_MSC_Process(USBH_HandleTypeDef *phost)
       }
       
 #if (USBH_USE_OS == 1)
-    osMessagePut ( phost->os_event, USBH_CLASS_EVENT, 0);
+      /* A command in progress is resumed by the URB events */
+      if((scsi_status != USBH_BUSY) || (ready_status != USBH_BUSY))
+      {
+        osMessagePut ( phost->os_event, USBH_CLASS_EVENT, 0);
+      }
 #endif       
     }
     else
@@ -484,6 +522,33 @@ static USBH_StatusTypeDef USBH_MSC_Process(USBH_HandleTypeDef *phost)
 
   case MSC_IDLE:
     error = USBH_OK;  
+    /* Start the writes queued by USBH_MSC_StreamWrite */
+    USBH_MSC_StreamStep(phost);
+    break;
+    
+  case MSC_READ:
+  case MSC_WRITE:
+  case MSC_TEST_UNIT_READY:
+    if(MSC_Handle->stream.cmd_count != 0)
+    {
+      /* Command of the stream, completed on the URB events */
+      USBH_MSC_StreamStep(phost);
+    }
+#if (USBH_USE_OS == 1)
+    /* Operation of USBH_MSC_Read/Write/CheckUnit, its caller waits for the end */
+    else if(MSC_Handle->rw_pending)
+    {
+      scsi_status = USBH_MSC_RdWrProcess(phost, MSC_Handle->rw_lun);
+      
+      if(scsi_status != USBH_BUSY)
+      {
+        MSC_Handle->rw_status = scsi_status;
+        MSC_Handle->rw_pending = 0;
+        MSC_Handle->state = MSC_IDLE;
+        osSemaphoreRelease(MSC_Handle->rw_sem);
+      }
+    }
+#endif
     break;
     
   default:
@@ -521,6 +586,57 @@ static USBH_StatusTypeDef USBH_MSC_RdWrProcess(USBH_HandleTypeDef *phost, uint8_
   switch (MSC_Handle->unit[lun].state)
   {
  
+  case MSC_TEST_UNIT_READY:
+    scsi_status = USBH_MSC_SCSI_TestUnitReady(phost, lun);
+    
+    if(scsi_status == USBH_OK)
+    {
+      MSC_Handle->unit[lun].state = MSC_READ_CAPACITY10;
+    }
+    else if( scsi_status == USBH_FAIL)
+    {
+      MSC_Handle->unit[lun].state = MSC_REQUEST_SENSE;  
+    }
+    else if(scsi_status == USBH_UNRECOVERED_ERROR)
+    {
+      MSC_Handle->unit[lun].state = MSC_UNRECOVERED_ERROR;
+      error = USBH_FAIL;
+    }
+#if (USBH_USE_OS == 1)
+    if(scsi_status != USBH_BUSY)
+    {
+      osMessagePut ( phost->os_event, USBH_CLASS_EVENT, 0);
+    }
+#endif   
+    break;
+    
+  case MSC_READ_CAPACITY10:
+    scsi_status = USBH_MSC_SCSI_ReadCapacity(phost, lun, &MSC_Handle->unit[lun].capacity);
+    
+    if(scsi_status == USBH_OK)
+    {
+      MSC_Handle->unit[lun].state = MSC_IDLE;
+      MSC_Handle->unit[lun].error = MSC_OK;
+      MSC_Handle->unit[lun].prev_ready_state = USBH_OK;
+      error = USBH_OK;
+    }
+    else if( scsi_status == USBH_FAIL)
+    {
+      MSC_Handle->unit[lun].state = MSC_REQUEST_SENSE;  
+    }
+    else if(scsi_status == USBH_UNRECOVERED_ERROR)
+    {
+      MSC_Handle->unit[lun].state = MSC_UNRECOVERED_ERROR;
+      error = USBH_FAIL;
+    }
+#if (USBH_USE_OS == 1)
+    if(scsi_status != USBH_BUSY)
+    {
+      osMessagePut ( phost->os_event, USBH_CLASS_EVENT, 0);
+    }
+#endif   
+    break;
+    
   case MSC_READ: 
     scsi_status = USBH_MSC_SCSI_Read(phost,lun, 0, NULL, 0) ;
     
@@ -539,7 +655,10 @@ static USBH_StatusTypeDef USBH_MSC_RdWrProcess(USBH_HandleTypeDef *phost, uint8_
           error = USBH_FAIL;
     }
 #if (USBH_USE_OS == 1)
-    osMessagePut ( phost->os_event, USBH_CLASS_EVENT, 0);
+    if(scsi_status != USBH_BUSY)
+    {
+      osMessagePut ( phost->os_event, USBH_CLASS_EVENT, 0);
+    }
 #endif   
     break;     
     
@@ -561,7 +680,10 @@ static USBH_StatusTypeDef USBH_MSC_RdWrProcess(USBH_HandleTypeDef *phost, uint8_
           error = USBH_FAIL;
     }
 #if (USBH_USE_OS == 1)
-    osMessagePut ( phost->os_event, USBH_CLASS_EVENT, 0);
+    if(scsi_status != USBH_BUSY)
+    {
+      osMessagePut ( phost->os_event, USBH_CLASS_EVENT, 0);
+    }
 #endif       
     break; 
   
@@ -574,7 +696,17 @@ static USBH_StatusTypeDef USBH_MSC_RdWrProcess(USBH_HandleTypeDef *phost, uint8_
       USBH_UsrLog ("Additional Sense Code : %x", MSC_Handle->unit[lun].sense.asc);
       USBH_UsrLog ("Additional Sense Code Qualifier: %x", MSC_Handle->unit[lun].sense.ascq);
       MSC_Handle->unit[lun].state = MSC_IDLE;
-      MSC_Handle->unit[lun].error = MSC_ERROR;
+      /* The state and capacity of the unit are no longer known, they are
+         read again by USBH_MSC_CheckUnit */
+      if((MSC_Handle->unit[lun].sense.key == SCSI_SENSE_KEY_UNIT_ATTENTION) ||
+         (MSC_Handle->unit[lun].sense.key == SCSI_SENSE_KEY_NOT_READY))
+      {
+        MSC_Handle->unit[lun].error = MSC_NOT_READY;
+      }
+      else
+      {
+        MSC_Handle->unit[lun].error = MSC_ERROR;
+      }
       
       error = USBH_FAIL;
     }
@@ -588,7 +720,10 @@ static USBH_StatusTypeDef USBH_MSC_RdWrProcess(USBH_HandleTypeDef *phost, uint8_
           error = USBH_FAIL;
     }
 #if (USBH_USE_OS == 1)
-    osMessagePut ( phost->os_event, USBH_CLASS_EVENT, 0);
+    if(scsi_status != USBH_BUSY)
+    {
+      osMessagePut ( phost->os_event, USBH_CLASS_EVENT, 0);
+    }
 #endif       
     break;  
     
@@ -607,10 +742,11 @@ static USBH_StatusTypeDef USBH_MSC_RdWrProcess(USBH_HandleTypeDef *phost, uint8_
   */
 uint8_t  USBH_MSC_IsReady (USBH_HandleTypeDef *phost)
 {
-    MSC_HandleTypeDef *MSC_Handle =  phost->pActiveClass->pData;  
+  MSC_HandleTypeDef *MSC_Handle;  
     
-  if(phost->gState == HOST_CLASS)
+  if((phost->gState == HOST_CLASS) && (phost->pActiveClass != NULL))
   {
+    MSC_Handle =  phost->pActiveClass->pData;
     return (MSC_Handle->state == MSC_IDLE);
   }
   else
@@ -623,31 +759,44 @@ uint8_t  USBH_MSC_IsReady (USBH_HandleTypeDef *phost)
   * @brief  USBH_MSC_GetMaxLUN 
   *         The function return the Max LUN supported
   * @param  phost: Host handle
-  * @retval logical Unit Number supported
+  * @retval Number of logical units of the device, 0xFF until they are
+  *         initialized
   */
 int8_t  USBH_MSC_GetMaxLUN (USBH_HandleTypeDef *phost)
 {
-  MSC_HandleTypeDef *MSC_Handle =  phost->pActiveClass->pData;    
+  MSC_HandleTypeDef *MSC_Handle;
   
-  if ((phost->gState != HOST_CLASS) && (MSC_Handle->state == MSC_IDLE))
+  /* No class is active before the enumeration */
+  if ((phost->gState == HOST_CLASS) && (phost->pActiveClass != NULL))
   {
-    return  MSC_Handle->max_lun;
+    MSC_Handle =  phost->pActiveClass->pData;
+    if (MSC_Handle->state != MSC_INIT)
+    {
+      return  MSC_Handle->max_lun;
+    }
   }  
   return 0xFF;
 }
 
 /**
   * @brief  USBH_MSC_UnitIsReady 
-  *         The function check whether a LUN is ready
+  *         The function check whether a LUN is ready. No command is sent:
+  *         the state is the one of the enumeration, or of USBH_MSC_CheckUnit,
+  *         until a command of the LUN fails.
   * @param  phost: Host handle
   * @param  lun: logical Unit Number
   * @retval Lun status (0: not ready / 1: ready)
   */
 uint8_t  USBH_MSC_UnitIsReady (USBH_HandleTypeDef *phost, uint8_t lun)
 {
-  MSC_HandleTypeDef *MSC_Handle =  phost->pActiveClass->pData;  
+  MSC_HandleTypeDef *MSC_Handle;  
   
-  if(phost->gState == HOST_CLASS)
+  if((phost->gState != HOST_CLASS) || (phost->pActiveClass == NULL))
+  {
+    return 0;
+  }
+  MSC_Handle =  phost->pActiveClass->pData;
+  if(lun < MSC_Handle->max_lun)
   {
     return (MSC_Handle->unit[lun].error == MSC_OK);
   }
@@ -659,15 +808,23 @@ uint8_t  USBH_MSC_UnitIsReady (USBH_HandleTypeDef *phost, uint8_t lun)
       
 /**
   * @brief  USBH_MSC_GetLUNInfo 
-  *         The function return a LUN information
+  *         The function return a LUN information, without sending a
+  *         command: the capacity is the one read at the enumeration or by
+  *         USBH_MSC_CheckUnit
   * @param  phost: Host handle
   * @param  lun: logical Unit Number
   * @retval USBH Status
   */
 USBH_StatusTypeDef USBH_MSC_GetLUNInfo(USBH_HandleTypeDef *phost, uint8_t lun, MSC_LUNTypeDef *info)
 {
-  MSC_HandleTypeDef *MSC_Handle =  phost->pActiveClass->pData;    
-  if(phost->gState == HOST_CLASS)
+  MSC_HandleTypeDef *MSC_Handle;    
+  
+  if((phost->gState != HOST_CLASS) || (phost->pActiveClass == NULL))
+  {
+    return USBH_FAIL;
+  }
+  MSC_Handle =  phost->pActiveClass->pData;
+  if(lun < MSC_Handle->max_lun)
   {
     USBH_memcpy(info,&MSC_Handle->unit[lun], sizeof(MSC_LUNTypeDef));
     return USBH_OK;
@@ -678,6 +835,57 @@ USBH_StatusTypeDef USBH_MSC_GetLUNInfo(USBH_HandleTypeDef *phost, uint8_t lun, M
   }
 }
 
+/**
+  * @brief  USBH_MSC_CheckUnit 
+  *         The function reads again the state and the capacity of a LUN
+  *         that is not ready, after a failed command or a medium change:
+  *         TEST UNIT READY, then READ CAPACITY(10). A ready LUN is not
+  *         accessed.
+  * @param  phost: Host handle
+  * @param  lun: logical Unit Number
+  * @retval USBH Status: USBH_OK if the LUN is ready
+  * @note   With USBH_USE_OS the operation is run by the host task and the
+  *         calling thread, which must be another one, waits for its end
+  */
+USBH_StatusTypeDef USBH_MSC_CheckUnit(USBH_HandleTypeDef *phost, uint8_t lun)
+{
+  MSC_HandleTypeDef *MSC_Handle;   
+  USBH_StatusTypeDef status = USBH_FAIL;
+  uint8_t try;
+  
+  if ((phost->device.is_connected == 0) || 
+      (phost->gState != HOST_CLASS) || 
+      (phost->pActiveClass == NULL))
+  {
+    return  USBH_FAIL;
+  }
+  MSC_Handle =  phost->pActiveClass->pData;
+  if (lun >= MSC_Handle->max_lun)
+  {
+    return  USBH_FAIL;
+  }
+  if (MSC_Handle->unit[lun].error == MSC_OK)
+  {
+    return USBH_OK;
+  }
+  
+  /* The REQUEST SENSE of a failed try clears a UNIT ATTENTION, the report
+     of a medium change, and the next try finds the LUN ready */
+  for (try = 0; (try < 2) && (status != USBH_OK); try++)
+  {
+    if ((MSC_Handle->state != MSC_IDLE) ||
+        (MSC_Handle->unit[lun].state != MSC_IDLE))
+    {
+      return  USBH_FAIL;
+    }
+    MSC_Handle->state = MSC_TEST_UNIT_READY;
+    MSC_Handle->unit[lun].state = MSC_TEST_UNIT_READY;
+    MSC_Handle->rw_lun = lun;
+    status = USBH_MSC_RdWrWait(phost, lun, 1);
+  }
+  return status;
+}
+
 /**
   * @brief  USBH_MSC_Read 
   *         The function performs a Read operation 
@@ -687,6 +895,8 @@ USBH_StatusTypeDef USBH_MSC_GetLUNInfo(USBH_HandleTypeDef *phost, uint8_t lun, M
   * @param  pbuf: pointer to data
   * @param  length: number of sector to read
   * @retval USBH Status
+  * @note   With USBH_USE_OS the operation is run by the host task and the
+  *         calling thread, which must be another one, waits for its end
   */
 USBH_StatusTypeDef USBH_MSC_Read(USBH_HandleTypeDef *phost,
                                      uint8_t lun,
@@ -694,11 +904,17 @@ USBH_StatusTypeDef USBH_MSC_Read(USBH_HandleTypeDef *phost,
                                      uint8_t *pbuf,
                                      uint32_t length)
 {
-  uint32_t timeout;
-  MSC_HandleTypeDef *MSC_Handle =  phost->pActiveClass->pData;   
+  MSC_HandleTypeDef *MSC_Handle;   
   
   if ((phost->device.is_connected == 0) || 
       (phost->gState != HOST_CLASS) || 
+      (phost->pActiveClass == NULL))
+  {
+    return  USBH_FAIL;
+  }
+  MSC_Handle =  phost->pActiveClass->pData;
+  if ((lun >= MSC_Handle->max_lun) ||
+      (MSC_Handle->state != MSC_IDLE) ||
       (MSC_Handle->unit[lun].state != MSC_IDLE))
   {
     return  USBH_FAIL;
@@ -712,8 +928,94 @@ USBH_StatusTypeDef USBH_MSC_Read(USBH_HandleTypeDef *phost,
                      pbuf,
                      length);
   
+  return USBH_MSC_RdWrWait(phost, lun, length);
+}
+
+/**
+  * @brief  USBH_MSC_Write 
+  *         The function performs a Write operation 
+  * @param  phost: Host handle
+  * @param  lun: logical Unit Number
+  * @param  address: sector address
+  * @param  pbuf: pointer to data
+  * @param  length: number of sector to write
+  * @retval USBH Status
+  * @note   With USBH_USE_OS the operation is run by the host task and the
+  *         calling thread, which must be another one, waits for its end
+  */
+USBH_StatusTypeDef USBH_MSC_Write(USBH_HandleTypeDef *phost,
+                                     uint8_t lun,
+                                     uint32_t address,
+                                     uint8_t *pbuf,
+                                     uint32_t length)
+{
+  MSC_HandleTypeDef *MSC_Handle;   
+  
+  if ((phost->device.is_connected == 0) || 
+      (phost->gState != HOST_CLASS) || 
+      (phost->pActiveClass == NULL))
+  {
+    return  USBH_FAIL;
+  }
+  MSC_Handle =  phost->pActiveClass->pData;
+  if ((lun >= MSC_Handle->max_lun) ||
+      (MSC_Handle->state != MSC_IDLE) ||
+      (MSC_Handle->unit[lun].state != MSC_IDLE))
+  {
+    return  USBH_FAIL;
+  }
+  MSC_Handle->state = MSC_WRITE;
+  MSC_Handle->unit[lun].state = MSC_WRITE;
+  MSC_Handle->rw_lun = lun;
+  USBH_MSC_SCSI_Write(phost,
+                     lun,
+                     address,
+                     pbuf,
+                     length);
+  
+  return USBH_MSC_RdWrWait(phost, lun, length);
+}
+
+/**
+  * @brief  USBH_MSC_RdWrWait 
+  *         The function waits for the end of the operation started by
+  *         USBH_MSC_Read, USBH_MSC_Write or USBH_MSC_CheckUnit
+  * @param  phost: Host handle
+  * @param  lun: logical Unit Number
+  * @param  length: number of sector of the operation
+  * @retval USBH Status
+  */
+static USBH_StatusTypeDef USBH_MSC_RdWrWait(USBH_HandleTypeDef *phost, uint8_t lun, uint32_t length)
+{
+  MSC_HandleTypeDef *MSC_Handle =  phost->pActiveClass->pData;
+#if (USBH_USE_OS == 1)
+  
+  /* Drop a release that came after the timeout of a previous operation */
+  osSemaphoreWait(MSC_Handle->rw_sem, 0);
+  
+  /* The host task runs the operation on the URB events */
+  MSC_Handle->rw_pending = 1;
+  osMessagePut ( phost->os_event, USBH_CLASS_EVENT, 0);
+  
+  if(osSemaphoreWait(MSC_Handle->rw_sem, 10000 * length) != osOK)
+  {
+    MSC_Handle->rw_pending = 0;
+    MSC_Handle->state = MSC_IDLE;
+    return USBH_FAIL;
+  }
+  
+  /* On a disconnection the handle is released with the class */
+  if(phost->device.is_connected == 0)
+  {
+    return USBH_FAIL;
+  }
+  return MSC_Handle->rw_status;
+#else
+  USBH_StatusTypeDef status;
+  uint32_t timeout;
+  
   timeout = phost->Timer + (10000 * length);
-  while (USBH_MSC_RdWrProcess(phost, lun) == USBH_BUSY)
+  while ((status = USBH_MSC_RdWrProcess(phost, lun)) == USBH_BUSY)
   {
     if((phost->Timer > timeout) || (phost->device.is_connected == 0))
     {
@@ -722,30 +1024,38 @@ USBH_StatusTypeDef USBH_MSC_Read(USBH_HandleTypeDef *phost,
     }
   }
   MSC_Handle->state = MSC_IDLE;
-  return USBH_OK;
+  return status;
+#endif
 }
 
 /**
-  * @brief  USBH_MSC_Write 
-  *         The function performs a Write operation 
+  * @brief  USBH_MSC_WriteStart 
+  *         The function starts a Write operation and returns without
+  *         waiting for its completion, which is polled with USBH_MSC_RdWrPoll
   * @param  phost: Host handle
   * @param  lun: logical Unit Number
   * @param  address: sector address
-  * @param  pbuf: pointer to data
+  * @param  pbuf: pointer to data, kept until the operation is completed
   * @param  length: number of sector to write
   * @retval USBH Status
   */
-USBH_StatusTypeDef USBH_MSC_Write(USBH_HandleTypeDef *phost,
+USBH_StatusTypeDef USBH_MSC_WriteStart(USBH_HandleTypeDef *phost,
                                      uint8_t lun,
                                      uint32_t address,
                                      uint8_t *pbuf,
                                      uint32_t length)
 {
-  uint32_t timeout;
-  MSC_HandleTypeDef *MSC_Handle =  phost->pActiveClass->pData;   
+  MSC_HandleTypeDef *MSC_Handle;   
   
   if ((phost->device.is_connected == 0) || 
       (phost->gState != HOST_CLASS) || 
+      (phost->pActiveClass == NULL))
+  {
+    return  USBH_FAIL;
+  }
+  MSC_Handle =  phost->pActiveClass->pData;
+  if ((lun >= MSC_Handle->max_lun) ||
+      (MSC_Handle->state != MSC_IDLE) ||
       (MSC_Handle->unit[lun].state != MSC_IDLE))
   {
     return  USBH_FAIL;
@@ -759,19 +1069,351 @@ USBH_StatusTypeDef USBH_MSC_Write(USBH_HandleTypeDef *phost,
                      pbuf,
                      length);
   
-  timeout = phost->Timer + (10000 * length);
-  while (USBH_MSC_RdWrProcess(phost, lun) == USBH_BUSY)
+  MSC_Handle->timer = phost->Timer + (10000 * length);
+  return USBH_OK;
+}
+
+/**
+  * @brief  USBH_MSC_RdWrPoll 
+  *         The function runs one step of the operation started with
+  *         USBH_MSC_WriteStart
+  * @param  phost: Host handle
+  * @param  lun: logical Unit Number
+  * @retval USBH_BUSY while the operation is in progress, then USBH_OK or
+  *         USBH_FAIL (sense data in the unit, timeout or disconnection)
+  */
+USBH_StatusTypeDef USBH_MSC_RdWrPoll(USBH_HandleTypeDef *phost, uint8_t lun)
+{
+  MSC_HandleTypeDef *MSC_Handle;
+  USBH_StatusTypeDef status;
+  
+  /* The class is released on a disconnection */
+  if ((phost->gState != HOST_CLASS) || (phost->pActiveClass == NULL))
   {
-    if((phost->Timer > timeout) || (phost->device.is_connected == 0))
+    return  USBH_FAIL;
+  }
+  MSC_Handle =  phost->pActiveClass->pData;
+  status = USBH_MSC_RdWrProcess(phost, lun);
+  if(status == USBH_BUSY)
+  {
+    if((phost->Timer > MSC_Handle->timer) || (phost->device.is_connected == 0))
     {
       MSC_Handle->state = MSC_IDLE;
       return USBH_FAIL;
     }
+    return USBH_BUSY;
   }
   MSC_Handle->state = MSC_IDLE;
+  return status;
+}
+
+/**
+  * @brief  USBH_MSC_StreamWrite 
+  *         The function queues a Write operation and returns without
+  *         waiting for it. The queued writes are run by the class process,
+  *         on the URB events with USBH_USE_OS, the ones that follow each 
+  *         other on the medium in one WRITE10 command, and the commands
+  *         back to back.
+  * @param  phost: Host handle
+  * @param  lun: logical Unit Number, the same for all the queued writes
+  * @param  address: sector address
+  * @param  pbuf: pointer to data, kept until the write is completed
+  * @param  length: number of sector to write
+  * @retval USBH_OK if queued, USBH_BUSY if the queue is full, USBH_FAIL
+  */
+USBH_StatusTypeDef USBH_MSC_StreamWrite(USBH_HandleTypeDef *phost,
+                                     uint8_t lun,
+                                     uint32_t address,
+                                     uint8_t *pbuf,
+                                     uint32_t length)
+{
+  MSC_HandleTypeDef *MSC_Handle;
+  MSC_StreamTypeDef *stream;
+  MSC_StreamReqTypeDef *req;
+  uint32_t count;
+  
+  if ((phost->device.is_connected == 0) || 
+      (phost->gState != HOST_CLASS) || 
+      (phost->pActiveClass == NULL))
+  {
+    return  USBH_FAIL;
+  }
+  MSC_Handle =  phost->pActiveClass->pData;
+  stream = &MSC_Handle->stream;
+  if ((lun >= MSC_Handle->max_lun) ||
+      (length == 0) || (length > 0xFFFF))
+  {
+    return  USBH_FAIL;
+  }
+  
+  count = stream->queued - stream->completed;
+  if (count == 0)
+  {
+    if ((MSC_Handle->state != MSC_IDLE) || (MSC_Handle->unit[lun].state != MSC_IDLE))
+    {
+      return  USBH_FAIL;
+    }
+    stream->lun = lun;
+  }
+  else if (stream->lun != lun)
+  {
+    return  USBH_FAIL;
+  }
+  else if (count == USBH_MSC_STREAM_DEPTH)
+  {
+    return  USBH_BUSY;
+  }
+  
+  req = &stream->req[stream->queued % USBH_MSC_STREAM_DEPTH];
+  req->address = address;
+  req->pbuf = pbuf;
+  req->length = length;
+  stream->queued++;
+  
+#if (USBH_USE_OS == 1)
+  osMessagePut ( phost->os_event, USBH_CLASS_EVENT, 0);
+#else
+  if (stream->cmd_count == 0)
+  {
+    USBH_MSC_StreamStep(phost);
+  }
+#endif
   return USBH_OK;
 }
 
+/**
+  * @brief  USBH_MSC_StreamProcess 
+  *         The function returns the state of the queued writes, to be called
+  *         until it returns a status other than USBH_BUSY. Without 
+  *         USBH_USE_OS it also runs them, as USBH_Process does.
+  * @param  phost: Host handle
+  * @retval USBH_BUSY while writes are queued, then USBH_OK or USBH_FAIL 
+  *         (sense data in the unit, timeout or disconnection). After a 
+  *         failure the queue is emptied: the writes after the completed
+  *         ones are lost
+  */
+USBH_StatusTypeDef USBH_MSC_StreamProcess(USBH_HandleTypeDef *phost)
+{
+  MSC_HandleTypeDef *MSC_Handle;
+  MSC_StreamTypeDef *stream;
+  
+  /* The class is released on a disconnection */
+  if ((phost->gState != HOST_CLASS) || (phost->pActiveClass == NULL))
+  {
+    return  USBH_FAIL;
+  }
+  MSC_Handle =  phost->pActiveClass->pData;
+  stream = &MSC_Handle->stream;
+  
+#if (USBH_USE_OS == 0)
+  USBH_MSC_StreamStep(phost);
+#endif
+  if (stream->queued != stream->completed)
+  {
+    return USBH_BUSY;
+  }
+  return stream->status;
+}
+
+/**
+  * @brief  USBH_MSC_StreamWait 
+  *         The function waits until a queued write is completed, to make
+  *         room in the queue, or all of them are. With USBH_USE_OS the 
+  *         calling thread, which must not be the host task, is blocked 
+  *         until the host task completes a command.
+  * @param  phost: Host handle
+  * @retval USBH_BUSY while writes are queued, then USBH_OK or USBH_FAIL, as
+  *         USBH_MSC_StreamProcess
+  */
+USBH_StatusTypeDef USBH_MSC_StreamWait(USBH_HandleTypeDef *phost)
+{
+  MSC_HandleTypeDef *MSC_Handle;
+  MSC_StreamTypeDef *stream;
+  uint32_t completed;
+#if (USBH_USE_OS == 1)
+  uint32_t timeout = 0;
+  uint32_t i;
+#endif
+  
+  /* The class is released on a disconnection */
+  if ((phost->gState != HOST_CLASS) || (phost->pActiveClass == NULL))
+  {
+    return  USBH_FAIL;
+  }
+  MSC_Handle =  phost->pActiveClass->pData;
+  stream = &MSC_Handle->stream;
+  completed = stream->completed;
+#if (USBH_USE_OS == 1)
+  for (i = completed; i != stream->queued; i++)
+  {
+    timeout += 10000 * stream->req[i % USBH_MSC_STREAM_DEPTH].length;
+  }
+  
+  /* Released by the host task at the end of each command */
+  while (stream->completed == completed)
+  {
+    if (stream->queued == completed)
+    {
+      break;
+    }
+    if ((osSemaphoreWait(MSC_Handle->rw_sem, timeout) != osOK) ||
+        (phost->device.is_connected == 0))
+    {
+      return USBH_FAIL;
+    }
+  }
+#else
+  
+  while ((stream->completed == completed) && (stream->queued != completed))
+  {
+    if (phost->device.is_connected == 0)
+    {
+      return USBH_FAIL;
+    }
+    USBH_MSC_StreamStep(phost);
+  }
+#endif
+  if (stream->queued != stream->completed)
+  {
+    return USBH_BUSY;
+  }
+  return stream->status;
+}
+
+/**
+  * @brief  USBH_MSC_StreamCompleted 
+  *         The function returns the number of writes of the stream completed
+  *         since the class was started. The writes are completed in the 
+  *         order of USBH_MSC_StreamWrite, and their buffers can be reused.
+  *         The writes lost after a failure are counted as well.
+  * @param  phost: Host handle
+  * @retval Completed writes
+  */
+uint32_t USBH_MSC_StreamCompleted(USBH_HandleTypeDef *phost)
+{
+  MSC_HandleTypeDef *MSC_Handle;
+  
+  if ((phost->gState != HOST_CLASS) || (phost->pActiveClass == NULL))
+  {
+    return 0;
+  }
+  MSC_Handle =  phost->pActiveClass->pData;
+  return MSC_Handle->stream.completed;
+}
+
+/**
+  * @brief  USBH_MSC_StreamStep 
+  *         The function runs the queued writes: it starts the oldest one
+  *         when the class is idle and completes the command in progress.
+  *         It is called by the class process, by the host task with
+  *         USBH_USE_OS.
+  * @param  phost: Host handle
+  * @retval None
+  */
+static void USBH_MSC_StreamStep(USBH_HandleTypeDef *phost)
+{
+  MSC_HandleTypeDef *MSC_Handle =  phost->pActiveClass->pData;
+  MSC_StreamTypeDef *stream = &MSC_Handle->stream;
+  USBH_StatusTypeDef status;
+  uint32_t completed;
+  
+  if (stream->cmd_count == 0)
+  {
+    /* Nothing queued, or a Read/Write of the application in progress */
+    if ((stream->queued == stream->completed) ||
+        (MSC_Handle->state != MSC_IDLE) || 
+        (MSC_Handle->unit[stream->lun].state != MSC_IDLE))
+    {
+      return;
+    }
+    MSC_Handle->state = MSC_WRITE;
+    MSC_Handle->rw_lun = stream->lun;
+    USBH_MSC_StreamStart(phost);
+  }
+  
+  status = USBH_MSC_RdWrProcess(phost, stream->lun);
+  if(status == USBH_BUSY)
+  {
+    if((phost->Timer <= MSC_Handle->timer) && (phost->device.is_connected != 0))
+    {
+      return;
+    }
+    status = USBH_FAIL;
+  }
+  
+  if(status == USBH_OK)
+  {
+    completed = stream->completed + stream->cmd_count;
+    if(stream->queued != completed)
+    {
+      /* Send the CBW of the next command right away */
+      stream->completed = completed;
+      USBH_MSC_StreamStart(phost);
+      USBH_MSC_RdWrProcess(phost, stream->lun);
+#if (USBH_USE_OS == 1)
+      osSemaphoreRelease(MSC_Handle->rw_sem);
+#endif
+      return;
+    }
+  }
+  else
+  {
+    completed = stream->queued;
+  }
+  
+  /* The class is idle again before the writes are reported completed */
+  MSC_Handle->hbot.seg_len = 0;
+  stream->cmd_count = 0;
+  stream->status = status;
+  MSC_Handle->state = MSC_IDLE;
+  stream->completed = completed;
+#if (USBH_USE_OS == 1)
+  osSemaphoreRelease(MSC_Handle->rw_sem);
+#endif
+}
+
+/**
+  * @brief  USBH_MSC_StreamStart 
+  *         The function issues the WRITE10 command of the oldest queued
+  *         write, merged with the next ones that follow it on the medium
+  * @param  phost: Host handle
+  * @retval None
+  */
+static void USBH_MSC_StreamStart(USBH_HandleTypeDef *phost)
+{
+  MSC_HandleTypeDef *MSC_Handle =  phost->pActiveClass->pData;
+  MSC_StreamTypeDef *stream = &MSC_Handle->stream;
+  uint32_t head = stream->completed;
+  uint32_t count = stream->queued - head;
+  MSC_StreamReqTypeDef *req = &stream->req[head % USBH_MSC_STREAM_DEPTH];
+  MSC_StreamReqTypeDef *next;
+  uint32_t length = req->length;
+  
+  stream->cmd_count = 1;
+  while(stream->cmd_count < count)
+  {
+    next = &stream->req[(head + stream->cmd_count) % USBH_MSC_STREAM_DEPTH];
+    if((next->address != req->address + length) || (length + next->length > 0xFFFF))
+    {
+      break;
+    }
+    length += next->length;
+    stream->cmd_count++;
+  }
+  
+  MSC_Handle->unit[stream->lun].state = MSC_WRITE;
+  USBH_MSC_SCSI_Write(phost,
+                     stream->lun,
+                     req->address,
+                     req->pbuf,
+                     length);
+  
+  /* The data stage goes through the buffers of the merged writes */
+  stream->seg = head % USBH_MSC_STREAM_DEPTH;
+  MSC_Handle->hbot.seg_len = req->length * BOT_PAGE_LENGTH;
+  MSC_Handle->timer = phost->Timer + (10000 * length);
+}
+
 /**
   * @}
   */ 
@@ -83,6 +83,8 @@
 */ 
 static USBH_StatusTypeDef USBH_MSC_BOT_Abort(USBH_HandleTypeDef *phost, uint8_t lun, uint8_t dir);
 static BOT_CSWStatusTypeDef USBH_MSC_DecodeCSW(USBH_HandleTypeDef *phost);
+static void USBH_MSC_BOT_SendData(USBH_HandleTypeDef *phost);
+static void USBH_MSC_BOT_DataSent(USBH_HandleTypeDef *phost);
 /**
 * @}
 */ 
@@ -157,6 +159,7 @@ USBH_StatusTypeDef USBH_MSC_BOT_Init(USBH_HandleTypeDef *phost)
   MSC_Handle->hbot.cbw.field.Tag = BOT_CBW_TAG;
   MSC_Handle->hbot.state = BOT_SEND_CBW;    
   MSC_Handle->hbot.cmd_state = BOT_CMD_SEND;   
+  MSC_Handle->hbot.seg_len = 0;
   
   return USBH_OK;
 }
@@ -177,7 +180,6 @@ USBH_StatusTypeDef USBH_MSC_BOT_Process (USBH_HandleTypeDef *phost, uint8_t lun)
   BOT_CSWStatusTypeDef CSW_Status = BOT_CSW_CMD_FAILED;
   USBH_URBStateTypeDef URB_Status = USBH_URB_IDLE;
   MSC_HandleTypeDef *MSC_Handle =  phost->pActiveClass->pData;
-  uint8_t toggle = 0;
   
   switch (MSC_Handle->hbot.state)
   {
@@ -306,12 +308,7 @@ USBH_StatusTypeDef USBH_MSC_BOT_Process (USBH_HandleTypeDef *phost, uint8_t lun)
     
   case BOT_DATA_OUT:
     
-    USBH_BulkSendData (phost,
-                       MSC_Handle->hbot.pbuf, 
-                       MSC_Handle->OutEpSize , 
-                       MSC_Handle->OutPipe,
-                       1);
-    
+    USBH_MSC_BOT_SendData(phost);
     
     MSC_Handle->hbot.state  = BOT_DATA_OUT_WAIT;
     break;
@@ -322,33 +319,22 @@ USBH_StatusTypeDef USBH_MSC_BOT_Process (USBH_HandleTypeDef *phost, uint8_t lun)
     if(URB_Status == USBH_URB_DONE)
     {
       /* Adjudt Data pointer and data length */
-      if(MSC_Handle->hbot.cbw.field.DataTransferLength > MSC_Handle->OutEpSize)
-      {
-          MSC_Handle->hbot.pbuf += MSC_Handle->OutEpSize;
-          MSC_Handle->hbot.cbw.field.DataTransferLength -= MSC_Handle->OutEpSize; 
-      }
-      else
-      {
-        MSC_Handle->hbot.cbw.field.DataTransferLength = 0;
-      } 
+      USBH_MSC_BOT_DataSent(phost);
       
       /* More Data To be Sent */
       if(MSC_Handle->hbot.cbw.field.DataTransferLength > 0)
       {
-        USBH_BulkSendData (phost,
-                           MSC_Handle->hbot.pbuf, 
-                           MSC_Handle->OutEpSize , 
-                           MSC_Handle->OutPipe,
-                           1);
+        /* The next URB wakes the host task when it is completed */
+        USBH_MSC_BOT_SendData(phost);
       }
       else
       {
         /* If value was 0, and successful transfer, then change the state */
         MSC_Handle->hbot.state  = BOT_RECEIVE_CSW;
-      }  
 #if (USBH_USE_OS == 1)
-    osMessagePut ( phost->os_event, USBH_URB_EVENT, 0);
-#endif       
+        osMessagePut ( phost->os_event, USBH_URB_EVENT, 0);
+#endif 
+      }  
     }
     
     else if(URB_Status == USBH_URB_NOTREADY)
@@ -423,6 +409,8 @@ USBH_StatusTypeDef USBH_MSC_BOT_Process (USBH_HandleTypeDef *phost, uint8_t lun)
     
     if (error == USBH_OK)
     {
+      /* The halt is cleared with the data toggle of the endpoint */
+      USBH_LL_SetToggle(phost, MSC_Handle->InPipe, 0);
       MSC_Handle->hbot.state = BOT_RECEIVE_CSW;
     }
     else if (error == USBH_UNRECOVERED_ERROR)
@@ -437,10 +425,8 @@ USBH_StatusTypeDef USBH_MSC_BOT_Process (USBH_HandleTypeDef *phost, uint8_t lun)
     
     if ( error == USBH_OK)
     { 
-      
-      toggle = USBH_LL_GetToggle(phost, MSC_Handle->OutPipe); 
-      USBH_LL_SetToggle(phost, MSC_Handle->OutPipe, 1- toggle);   
-      USBH_LL_SetToggle(phost, MSC_Handle->InPipe, 0);  
+      /* The halt is cleared with the data toggle of the endpoint */
+      USBH_LL_SetToggle(phost, MSC_Handle->OutPipe, 0);   
       MSC_Handle->hbot.state = BOT_ERROR_IN;        
     }
     else if (error == USBH_UNRECOVERED_ERROR)
@@ -496,6 +482,57 @@ static USBH_StatusTypeDef USBH_MSC_BOT_Abort(USBH_HandleTypeDef *phost, uint8_t
   return status;
 }
 
+/**
+  * @brief  USBH_MSC_BOT_SendData 
+  *         The function sends the next packet of the data OUT stage.
+  * @param  phost: Host handle
+  * @retval None
+  */
+static void USBH_MSC_BOT_SendData(USBH_HandleTypeDef *phost)
+{
+  MSC_HandleTypeDef *MSC_Handle =  phost->pActiveClass->pData;
+  
+  USBH_BulkSendData (phost,
+                     MSC_Handle->hbot.pbuf, 
+                     MSC_Handle->OutEpSize, 
+                     MSC_Handle->OutPipe,
+                     1);
+}
+
+/**
+  * @brief  USBH_MSC_BOT_DataSent 
+  *         The function accounts the packet acknowledged by the device and
+  *         moves to the next buffer of the stream at the end of the current
+  *         one. The buffers of the stream hold whole sectors, a packet never
+  *         spans two of them.
+  * @param  phost: Host handle
+  * @retval None
+  */
+static void USBH_MSC_BOT_DataSent(USBH_HandleTypeDef *phost)
+{
+  MSC_HandleTypeDef *MSC_Handle =  phost->pActiveClass->pData;
+  
+  if(MSC_Handle->hbot.cbw.field.DataTransferLength <= MSC_Handle->OutEpSize)
+  {
+    MSC_Handle->hbot.cbw.field.DataTransferLength = 0;
+    return;
+  }
+  MSC_Handle->hbot.pbuf += MSC_Handle->OutEpSize;
+  MSC_Handle->hbot.cbw.field.DataTransferLength -= MSC_Handle->OutEpSize; 
+  
+  if(MSC_Handle->hbot.seg_len != 0)
+  {
+    MSC_Handle->hbot.seg_len -= MSC_Handle->OutEpSize;
+    if(MSC_Handle->hbot.seg_len == 0)
+    {
+      /* Next write of the stream merged in this command */
+      MSC_Handle->stream.seg = (MSC_Handle->stream.seg + 1) % USBH_MSC_STREAM_DEPTH;
+      MSC_Handle->hbot.pbuf = MSC_Handle->stream.req[MSC_Handle->stream.seg].pbuf;
+      MSC_Handle->hbot.seg_len = MSC_Handle->stream.req[MSC_Handle->stream.seg].length * BOT_PAGE_LENGTH;
+    }
+  }
+}
+
 /**
   * @brief  USBH_MSC_BOT_DecodeCSW
   *         This function decodes the CSW received by the device and updates the
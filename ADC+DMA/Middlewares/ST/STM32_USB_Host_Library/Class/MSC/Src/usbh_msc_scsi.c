@@ -121,6 +121,9 @@ USBH_StatusTypeDef USBH_MSC_SCSI_TestUnitReady (USBH_HandleTypeDef *phost,
     
     MSC_Handle->hbot.state = BOT_SEND_CBW;
     MSC_Handle->hbot.cmd_state = BOT_CMD_WAIT;
+#if (USBH_USE_OS == 1)
+    osMessagePut ( phost->os_event, USBH_URB_EVENT, 0);
+#endif
     error = USBH_BUSY; 
     break;
     
@@ -165,6 +168,9 @@ USBH_StatusTypeDef USBH_MSC_SCSI_ReadCapacity (USBH_HandleTypeDef *phost,
     MSC_Handle->hbot.state = BOT_SEND_CBW;
     
     MSC_Handle->hbot.cmd_state = BOT_CMD_WAIT;
+#if (USBH_USE_OS == 1)
+    osMessagePut ( phost->os_event, USBH_URB_EVENT, 0);
+#endif
     MSC_Handle->hbot.pbuf = (uint8_t *)MSC_Handle->hbot.data;
     error = USBH_BUSY; 
     break;
@@ -225,6 +231,9 @@ USBH_StatusTypeDef USBH_MSC_SCSI_Inquiry (USBH_HandleTypeDef *phost,
     MSC_Handle->hbot.state = BOT_SEND_CBW;
 
     MSC_Handle->hbot.cmd_state = BOT_CMD_WAIT;
+#if (USBH_USE_OS == 1)
+    osMessagePut ( phost->os_event, USBH_URB_EVENT, 0);
+#endif
     MSC_Handle->hbot.pbuf = (uint8_t *)MSC_Handle->hbot.data;
     error = USBH_BUSY; 
     break;
@@ -287,6 +296,9 @@ USBH_StatusTypeDef USBH_MSC_SCSI_RequestSense (USBH_HandleTypeDef *phost,
     
     MSC_Handle->hbot.state = BOT_SEND_CBW;
     MSC_Handle->hbot.cmd_state = BOT_CMD_WAIT;
+#if (USBH_USE_OS == 1)
+    osMessagePut ( phost->os_event, USBH_URB_EVENT, 0);
+#endif
     MSC_Handle->hbot.pbuf = (uint8_t *)MSC_Handle->hbot.data;
     error = USBH_BUSY; 
     break;
@@ -356,6 +368,9 @@ USBH_StatusTypeDef USBH_MSC_SCSI_Write(USBH_HandleTypeDef *phost,
     
     MSC_Handle->hbot.state = BOT_SEND_CBW;
     MSC_Handle->hbot.cmd_state = BOT_CMD_WAIT;
+#if (USBH_USE_OS == 1)
+    osMessagePut ( phost->os_event, USBH_URB_EVENT, 0);
+#endif
     MSC_Handle->hbot.pbuf = pbuf;
     error = USBH_BUSY; 
     break;
@@ -416,6 +431,9 @@ USBH_StatusTypeDef USBH_MSC_SCSI_Read(USBH_HandleTypeDef *phost,
     
     MSC_Handle->hbot.state = BOT_SEND_CBW;
     MSC_Handle->hbot.cmd_state = BOT_CMD_WAIT;
+#if (USBH_USE_OS == 1)
+    osMessagePut ( phost->os_event, USBH_URB_EVENT, 0);
+#endif
     MSC_Handle->hbot.pbuf = pbuf;
     error = USBH_BUSY; 
     break;
@@ -320,6 +320,7 @@ typedef enum
 typedef enum 
 {
   HOST_IDLE =0,
+  HOST_DEV_DEBOUNCE,
   HOST_DEV_WAIT_FOR_ATTACHMENT,  
   HOST_DEV_ATTACHED,
   HOST_DEV_DISCONNECTED,  
@@ -332,6 +333,7 @@ typedef enum
   HOST_CLASS,
   HOST_SUSPENDED,
   HOST_ABORT_STATE,  
+  HOST_REENUMERATE,
 }HOST_StateTypeDef;  
 
 /* Following states are used for EnumerationState */
@@ -340,6 +342,7 @@ typedef enum
   ENUM_IDLE = 0,
   ENUM_GET_FULL_DEV_DESC,
   ENUM_SET_ADDR,
+  ENUM_SET_ADDR_RECOVERY,
   ENUM_GET_CFG_DESC,
   ENUM_GET_FULL_CFG_DESC,
   ENUM_GET_MFC_STRING_DESC,
@@ -453,6 +456,7 @@ typedef struct _USBH_HandleTypeDef
   uint32_t              ClassNumber;
   uint32_t              Pipes[15];
   __IO uint32_t         Timer;
+  uint32_t              Timeout;      /* End of a wait of the state machines, in Timer ticks */
   uint8_t               id;  
   void*                 pData;                  
   void                 (* pUser )(struct _USBH_HandleTypeDef *pHandle, uint8_t id);
@@ -51,6 +51,12 @@
 #define USBH_ADDRESS_DEFAULT                     0
 #define USBH_ADDRESS_ASSIGNED                    1      
 #define USBH_MPS_DEFAULT                         0x40
+
+/* Waits of the state machines, in ms of the Host timer */
+#define USBH_CONNECT_DELAY                       200    /* Debounce, before the port reset */
+#define USBH_RESET_RECOVERY                      100    /* After the port reset */
+#define USBH_SET_ADDRESS_RECOVERY                2
+#define USBH_REENUMERATE_DELAY                   200    /* VBUS off, for the device to see the disconnection */
 /**
   * @}
   */ 
@@ -77,6 +83,7 @@
 static USBH_StatusTypeDef  USBH_HandleEnum    (USBH_HandleTypeDef *phost);
 static void                USBH_HandleSof     (USBH_HandleTypeDef *phost);
 static USBH_StatusTypeDef  DeInitStateMachine(USBH_HandleTypeDef *phost);
+static uint8_t             USBH_TimerElapsed  (USBH_HandleTypeDef *phost);
 
 #if (USBH_USE_OS == 1)  
 static void USBH_Process_OS(void const * argument);
@@ -178,6 +185,7 @@ static USBH_StatusTypeDef  DeInitStateMachine(USBH_HandleTypeDef *phost)
   phost->EnumState = ENUM_IDLE;
   phost->RequestState = CMD_SEND;
   phost->Timer = 0;  
+  phost->Timeout = 0;
   
   phost->Control.state = CTRL_SETUP;
   phost->Control.pipe_size = USBH_MPS_DEFAULT;  
@@ -373,18 +381,19 @@ USBH_StatusTypeDef  USBH_ReEnumerate   (USBH_HandleTypeDef *phost)
   /*Stop Host */ 
   USBH_Stop(phost);
 
-  /*Device has disconnected, so wait for 200 ms */  
-  USBH_Delay(200);
-  
   /* Set State machines in default state */
   DeInitStateMachine(phost);
+  
+  if(phost->pActiveClass != NULL)
+  {
+    phost->pActiveClass->DeInit(phost); 
+    phost->pActiveClass = NULL;
+  }     
    
-  /* Start again the host */
-  USBH_Start(phost);
+  /* Device has disconnected, USBH_Process starts again the host 200 ms later */
+  phost->Timeout = phost->Timer + USBH_REENUMERATE_DELAY;
+  phost->gState = HOST_REENUMERATE;
       
-#if (USBH_USE_OS == 1)
-      osMessagePut ( phost->os_event, USBH_PORT_EVENT, 0);
-#endif  
   return USBH_OK;  
 }
 
@@ -406,8 +415,15 @@ USBH_StatusTypeDef  USBH_Process(USBH_HandleTypeDef *phost)
     if (phost->device.is_connected)  
     {
       /* Wait for 200 ms after connection */
+      phost->Timeout = phost->Timer + USBH_CONNECT_DELAY;
+      phost->gState = HOST_DEV_DEBOUNCE; 
+    }
+    break;
+    
+  case HOST_DEV_DEBOUNCE:
+    if (USBH_TimerElapsed(phost))
+    {
       phost->gState = HOST_DEV_WAIT_FOR_ATTACHMENT; 
-      USBH_Delay(200); 
       USBH_LL_ResetPort(phost);
 #if (USBH_USE_OS == 1)
       osMessagePut ( phost->os_event, USBH_PORT_EVENT, 0);
@@ -420,10 +436,13 @@ USBH_StatusTypeDef  USBH_Process(USBH_HandleTypeDef *phost)
     
   case HOST_DEV_ATTACHED :
     
+    /* Wait for 100 ms after Reset, from the port enable */
+    if (!USBH_TimerElapsed(phost))
+    {
+      break;
+    }
+    
     USBH_UsrLog("USB Device Attached");  
-      
-    /* Wait for 100 ms after Reset */
-    USBH_Delay(100); 
           
     phost->device.speed = USBH_LL_GetSpeed(phost);
     
@@ -593,6 +612,18 @@ USBH_StatusTypeDef  USBH_Process(USBH_HandleTypeDef *phost)
     }     
     break;
     
+  case HOST_REENUMERATE:
+    if (USBH_TimerElapsed(phost))
+    {
+      /* Start again the host */
+      phost->gState = HOST_IDLE;
+      USBH_Start(phost);
+#if (USBH_USE_OS == 1)
+      osMessagePut ( phost->os_event, USBH_PORT_EVENT, 0);
+#endif
+    }
+    break;
+    
   case HOST_ABORT_STATE:
   default :
     break;
@@ -658,7 +689,15 @@ static USBH_StatusTypeDef USBH_HandleEnum (USBH_HandleTypeDef *phost)
     /* set address */
     if ( USBH_SetAddress(phost, USBH_DEVICE_ADDRESS) == USBH_OK)
     {
-      USBH_Delay(2);
+      /* Wait for 2 ms, the device takes the address */
+      phost->Timeout = phost->Timer + USBH_SET_ADDRESS_RECOVERY;
+      phost->EnumState = ENUM_SET_ADDR_RECOVERY;
+    }
+    break;
+    
+  case ENUM_SET_ADDR_RECOVERY:
+    if (USBH_TimerElapsed(phost))
+    {
       phost->device.address = USBH_DEVICE_ADDRESS;
       
       /* user callback for device address assigned */
@@ -682,6 +721,9 @@ static USBH_StatusTypeDef USBH_HandleEnum (USBH_HandleTypeDef *phost)
                            phost->device.speed,
                            USBH_EP_CONTROL,
                            phost->Control.pipe_size);        
+#if (USBH_USE_OS == 1)
+      osMessagePut ( phost->os_event, USBH_STATE_CHANGED_EVENT, 0);
+#endif
     }
     break;
     
@@ -803,6 +845,27 @@ void  USBH_LL_IncTimer  (USBH_HandleTypeDef *phost)
 {
   phost->Timer ++;
   USBH_HandleSof(phost);
+  
+#if (USBH_USE_OS == 1)
+  if(phost->Timer == phost->Timeout)
+  {
+    /* End of a wait of the state machines */
+    osMessagePut ( phost->os_event, USBH_PORT_EVENT, 0);
+  }
+#endif  
+}
+
+/**
+  * @brief  USBH_TimerElapsed 
+  *         Tells whether the wait started with phost->Timeout is over.
+  *         The Host timer is driven by USBH_LL_IncTimer, from the SOF and
+  *         from a 1 ms tick of the low level driver while the port is disabled.
+  * @param  phost: Host Handle
+  * @retval 1 when the Host timer has reached phost->Timeout
+  */
+static uint8_t  USBH_TimerElapsed  (USBH_HandleTypeDef *phost)
+{
+  return ((int32_t)(phost->Timer - phost->Timeout) >= 0);
 }
 
 /**
@@ -838,6 +901,7 @@ USBH_StatusTypeDef  USBH_LL_Connect  (USBH_HandleTypeDef *phost)
   } 
   else if(phost->gState == HOST_DEV_WAIT_FOR_ATTACHMENT )
   {
+    phost->Timeout = phost->Timer + USBH_RESET_RECOVERY;
     phost->gState = HOST_DEV_ATTACHED ;
   }
 #if (USBH_USE_OS == 1)
@@ -873,7 +937,11 @@ USBH_StatusTypeDef  USBH_LL_Disconnect  (USBH_HandleTypeDef *phost)
   /* Start the low level driver  */
   USBH_LL_Start(phost);
   
-  phost->gState = HOST_DEV_DISCONNECTED;
+  /* The disconnection caused by USBH_ReEnumerate is awaited in HOST_REENUMERATE */
+  if(phost->gState != HOST_REENUMERATE)
+  {
+    phost->gState = HOST_DEV_DISCONNECTED;
+  }
   
 #if (USBH_USE_OS == 1)
   osMessagePut ( phost->os_event, USBH_PORT_EVENT, 0);
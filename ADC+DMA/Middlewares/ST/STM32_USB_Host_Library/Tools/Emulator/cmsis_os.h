@@ -0,0 +1,145 @@
+/**
+  ******************************************************************************
+  * @file    cmsis_os.h
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   CMSIS-RTOS subset used by the USB Host Library, emulated on the
+  *          host by the cooperative scheduler of usbh_emu_os.c
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __CMSIS_OS_H
+#define __CMSIS_OS_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/* Same values as the cmsis_os.h of FreeRTOS */
+typedef enum
+{
+  osPriorityIdle          = -3,
+  osPriorityLow           = -2,
+  osPriorityBelowNormal   = -1,
+  osPriorityNormal        =  0,
+  osPriorityAboveNormal   = +1,
+  osPriorityHigh          = +2,
+  osPriorityRealtime      = +3,
+  osPriorityError         =  0x84,
+}osPriority;
+
+typedef enum
+{
+  osOK                    =     0,
+  osEventMessage          =  0x10,
+  osEventTimeout          =  0x40,
+  osErrorParameter        =  0x80,
+  osErrorResource         =  0x81,
+  osErrorOS               =  0xFF,
+}osStatus;
+
+typedef void (*os_pthread) (void const *argument);
+
+typedef struct os_thread_cb     *osThreadId;
+typedef struct os_semaphore_cb  *osSemaphoreId;
+typedef struct os_messageQ_cb   *osMessageQId;
+
+typedef const struct os_thread_def
+{
+  char                   *name;
+  os_pthread             pthread;
+  osPriority             tpriority;
+  uint32_t               instances;
+  uint32_t               stacksize;   /* In words, as xTaskCreate */
+}osThreadDef_t;
+
+typedef const struct os_semaphore_def
+{
+  uint32_t               dummy;
+}osSemaphoreDef_t;
+
+typedef const struct os_messageQ_def
+{
+  uint32_t               queue_sz;
+  uint32_t               item_sz;
+}osMessageQDef_t;
+
+typedef struct
+{
+  osStatus               status;
+  union
+  {
+    uint32_t             v;
+    void                 *p;
+  }value;
+  union
+  {
+    osMessageQId         message_id;
+  }def;
+}osEvent;
+
+/* Exported constants --------------------------------------------------------*/
+#define osWaitForever             0xFFFFFFFF
+
+/* As the FreeRTOSConfig.h of the application */
+#define configMINIMAL_STACK_SIZE  ((unsigned short)128)
+
+/* Exported macro ------------------------------------------------------------*/
+#define osThreadDef(name, thread, priority, instances, stacksz)  \
+osThreadDef_t os_thread_def_##name = \
+{ #name, (thread), (priority), (instances), (stacksz) }
+#define osThread(name)  &os_thread_def_##name
+
+#define osSemaphoreDef(name)  \
+osSemaphoreDef_t os_semaphore_def_##name = { 0 }
+#define osSemaphore(name)  &os_semaphore_def_##name
+
+#define osMessageQDef(name, queue_sz, type)  \
+osMessageQDef_t os_messageQ_def_##name = \
+{ (queue_sz), sizeof (type) }
+#define osMessageQ(name)  &os_messageQ_def_##name
+
+/* Exported functions ------------------------------------------------------- */
+osThreadId    osThreadCreate(osThreadDef_t *thread_def, void *argument);
+osThreadId    osThreadGetId(void);
+osStatus      osDelay(uint32_t millisec);
+
+osSemaphoreId osSemaphoreCreate(osSemaphoreDef_t *semaphore_def, int32_t count);
+int32_t       osSemaphoreWait(osSemaphoreId semaphore_id, uint32_t millisec);
+osStatus      osSemaphoreRelease(osSemaphoreId semaphore_id);
+osStatus      osSemaphoreDelete(osSemaphoreId semaphore_id);
+
+osMessageQId  osMessageCreate(osMessageQDef_t *queue_def, osThreadId thread_id);
+osStatus      osMessagePut(osMessageQId queue_id, uint32_t info, uint32_t millisec);
+osEvent       osMessageGet(osMessageQId queue_id, uint32_t millisec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CMSIS_OS_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
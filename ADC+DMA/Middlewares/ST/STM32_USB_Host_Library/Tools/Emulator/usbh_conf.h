@@ -0,0 +1,112 @@
+/**
+  ******************************************************************************
+  * @file    usbh_conf.h
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Configuration of the USB Host library on the host emulator: the
+  *          usbh_conf.h of the application without the CMSIS device header
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT(c) 2015 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software 
+  * distributed under the License is distributed on an "AS IS" BASIS, 
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __USBH_CONF__H__
+#define __USBH_CONF__H__
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define __IO    volatile
+
+/* Exported types ------------------------------------------------------------*/
+#define USBH_MAX_NUM_ENDPOINTS                2
+#define USBH_MAX_NUM_INTERFACES               2
+#define USBH_MAX_NUM_CONFIGURATION            1
+#define USBH_MAX_NUM_SUPPORTED_CLASS          1
+#define USBH_KEEP_CFG_DESCRIPTOR              0
+#define USBH_MAX_SIZE_CONFIGURATION           0x200
+#define USBH_MAX_DATA_BUFFER                  0x200
+#define USBH_DEBUG_LEVEL                      0
+#ifndef USBH_USE_OS
+#define USBH_USE_OS                           0
+#endif
+#define USBH_MSC_STREAM_DEPTH                 4
+/* Alignment of the bulk buffers, checked as by the DMA of the OTG HS core.
+   Build with -DUSBH_DMA_ALIGN=1 for the OTG FS core of the application */
+#ifndef USBH_DMA_ALIGN
+#define USBH_DMA_ALIGN                        4
+#endif
+    
+/** @defgroup USBH_Exported_Macros
+  * @{
+  */ 
+
+ /* Memory management macros */   
+#define USBH_malloc               malloc
+#define USBH_free                 free
+#define USBH_memset               memset
+#define USBH_memcpy               memcpy
+
+ /* CMSIS OS macros, on the scheduler of usbh_emu_os.c */
+#if (USBH_USE_OS == 1)
+  #include "cmsis_os.h"
+  #define   USBH_PROCESS_PRIO          osPriorityAboveNormal
+  #define   USBH_PROCESS_STACK_SIZE    (8 * configMINIMAL_STACK_SIZE)
+#endif
+    
+ /* DEBUG macros */  
+#if (USBH_DEBUG_LEVEL > 0)
+#define  USBH_UsrLog(...)   printf(__VA_ARGS__);\
+                            printf("\n");
+#else
+#define USBH_UsrLog(...)   
+#endif 
+                            
+                            
+#if (USBH_DEBUG_LEVEL > 1)
+
+#define  USBH_ErrLog(...)   printf("ERROR: ") ;\
+                            printf(__VA_ARGS__);\
+                            printf("\n");
+#else
+#define USBH_ErrLog(...)   
+#endif 
+                            
+#if (USBH_DEBUG_LEVEL > 2)                         
+#define  USBH_DbgLog(...)   printf("DEBUG : ") ;\
+                            printf(__VA_ARGS__);\
+                            printf("\n");
+#else
+#define USBH_DbgLog(...)                         
+#endif
+                            
+                              
+#if (USBH_MAX_NUM_CONFIGURATION > 1)
+#error This USB Host Library version Supports only 1 configuration!
+#endif
+    
+    
+#endif /* __USB_CONF_H */
+    
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
+
@@ -0,0 +1,861 @@
+/**
+  ******************************************************************************
+  * @file    usbh_conf_emu.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   USB Host low level driver on a host emulator of the USB OTG FS
+  *          controller, in place of the HAL_HCD driver of usbh_conf.c
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbh_core.h"
+#include "usbh_emu.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Host channel, as the channels of the OTG FS core */
+typedef struct
+{
+  uint8_t  ep_addr;                 /* Endpoint address, bit 7 for IN */
+  uint8_t  dev_addr;                /* Device address */
+  uint8_t  ep_type;
+  uint16_t mps;
+  uint8_t  dir_in;                  /* Direction of the URB */
+  uint8_t  token;                   /* USBH_PID_SETUP or USBH_PID_DATA */
+  uint8_t  toggle_in;
+  uint8_t  toggle_out;
+  uint8_t  *buff;
+  uint16_t length;
+  uint16_t count;                   /* Transferred bytes */
+  uint8_t  state;                   /* EMU_CH_xxx */
+  USBH_URBStateTypeDef urb_state;   /* Reported to the stack */
+  USBH_URBStateTypeDef end_state;   /* Reported once the URB is completed */
+  uint64_t next;                    /* Time of the next transaction or of the completion */
+}EMU_ChannelTypeDef;
+
+/* Port events, the interrupts of the port */
+typedef enum
+{
+  EMU_PORT_NONE = 0,
+  EMU_PORT_CONNECT,
+  EMU_PORT_ENABLE,
+  EMU_PORT_DISCONNECT,
+}EMU_PortEventTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define EMU_CHANNELS              11
+
+#define EMU_CH_IDLE               0
+#define EMU_CH_XFER               1 /* Transactions on the bus */
+#define EMU_CH_DONE               2 /* Completion interrupt pending */
+
+/* Full speed bus: 12 Mbit/s, 1 ms frames */
+#define EMU_BIT_TIME(bits)        (((uint64_t)(bits) * 1000) / 12)
+#define EMU_FRAME_NS              1000000ULL
+#define EMU_SOF_NS                EMU_BIT_TIME(48)
+#define EMU_EOF_NS                EMU_BIT_TIME(32)
+
+/* Token, data and handshake packets with the inter packet delays */
+#define EMU_DATA_NS(len)          EMU_BIT_TIME(121 + 8 * (len))
+#define EMU_HANDSHAKE_NS          EMU_BIT_TIME(70)
+#define EMU_TIMEOUT_NS            (3 * EMU_BIT_TIME(70))
+
+/* Channel halt and interrupt handling of the HAL after the last packet of
+   a URB, before the stack sees its new state */
+#define EMU_URB_NS                15000ULL
+
+/* Time between VBUS on and the pull-up of the device, and port reset */
+#define EMU_ATTACH_NS             2000000ULL
+#define EMU_RESET_MS              10
+#define EMU_ENABLE_NS             50000ULL
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static USBH_HandleTypeDef *Emu_Host = NULL;
+static EMU_ChannelTypeDef Emu_Channel[EMU_CHANNELS];
+
+/* Emulated time in ns */
+static uint64_t Emu_Now = 0;
+static uint64_t Emu_BusFree = 0;
+static uint64_t Emu_NextSof = 0;
+
+/* Port */
+static uint8_t  Emu_Plugged = 1;
+static uint8_t  Emu_Vbus = 0;
+static uint8_t  Emu_Connected = 0;
+static uint8_t  Emu_Enabled = 0;
+static EMU_PortEventTypeDef Emu_PortEvent = EMU_PORT_NONE;
+static uint64_t Emu_PortTime = 0;
+
+/* Timing */
+static uint32_t Emu_StepTime = 1000;      /* CPU time of a pass, in ns */
+static uint32_t Emu_NakRate = 0;          /* Injected NAKs, per mille */
+static uint32_t Emu_Random = 1;
+static uint8_t  Emu_InAdvance = 0;
+
+/* Idle CPU of the scheduler of usbh_emu_os.c */
+static uint8_t  Emu_StopOnWake = 0;
+static uint8_t  Emu_Woken = 0;
+
+/* Private function prototypes -----------------------------------------------*/
+static void EMU_Advance(uint64_t until);
+static void EMU_Step(void);
+static void EMU_Transaction(EMU_ChannelTypeDef *ch);
+static void EMU_Complete(EMU_ChannelTypeDef *ch, USBH_URBStateTypeDef state);
+static void EMU_PortSchedule(EMU_PortEventTypeDef event, uint64_t time);
+static void EMU_AbortChannels(void);
+static uint8_t EMU_InjectNak(void);
+
+/* Private functions ---------------------------------------------------------*/
+
+/*******************************************************************************
+                       Emulator control
+*******************************************************************************/
+/**
+  * @brief  Sets the timing of the emulated device.
+  * @param  latency_us: Media access time of the READ(10) and WRITE(10)
+  *         commands, in us
+  * @param  nak_permille: Rate of the transactions NAKed by the device at
+  *         random, beside the SETUP transactions, per mille
+  * @retval None
+  */
+void USBH_EMU_SetTiming(uint32_t latency_us, uint32_t nak_permille)
+{
+  EMU_MSC_SetLatency(latency_us * 1000);
+  Emu_NakRate = (nak_permille < 1000) ? nak_permille : 999;
+}
+
+/**
+  * @brief  Sets the CPU time taken by each USBH_LL_SubmitURB and
+  *         USBH_LL_GetURBState call, that is a pass through the state machines
+  *         of the stack.
+  * @param  step_ns: Time in ns, 1000 by default
+  * @retval None
+  */
+void USBH_EMU_SetStepTime(uint32_t step_ns)
+{
+  Emu_StepTime = step_ns;
+}
+
+/**
+  * @brief  Plugs or unplugs the emulated device.
+  * @param  plugged: 1 to plug, 0 to unplug
+  * @retval None
+  */
+void USBH_EMU_Plug(uint8_t plugged)
+{
+  if(plugged && !Emu_Plugged)
+  {
+    Emu_Plugged = 1;
+    if(Emu_Vbus)
+    {
+      EMU_PortSchedule(EMU_PORT_CONNECT, Emu_Now + EMU_ATTACH_NS);
+    }
+  }
+  else if(!plugged && Emu_Plugged)
+  {
+    Emu_Plugged = 0;
+    EMU_PortSchedule(EMU_PORT_DISCONNECT, Emu_Now);
+  }
+}
+
+/**
+  * @brief  Lets the emulated time run, with its interrupts, as the
+  *         application code between two calls of USBH_Process.
+  * @param  us: Time in us
+  * @retval None
+  */
+void USBH_EMU_Run(uint32_t us)
+{
+  EMU_Advance(Emu_Now + (uint64_t)us * 1000);
+}
+
+/**
+  * @brief  Returns the emulated time.
+  * @param  None
+  * @retval Time in us
+  */
+uint64_t USBH_EMU_GetTime(void)
+{
+  return Emu_Now / 1000;
+}
+
+/**
+  * @brief  Returns the counters of the emulated bus and device.
+  * @param  stats: Receives the counters
+  * @retval None
+  */
+void USBH_EMU_GetStats(USBH_EMU_StatsTypeDef *stats)
+{
+  *stats = EMU_Stats;
+}
+
+/**
+  * @brief  Clears the counters of the emulated bus and device.
+  * @param  None
+  * @retval None
+  */
+void USBH_EMU_ResetStats(void)
+{
+  memset(&EMU_Stats, 0, sizeof(EMU_Stats));
+}
+
+/*******************************************************************************
+                       Emulated controller
+*******************************************************************************/
+/**
+  * @brief  Runs the emulated time up to a date: start of frames, port events,
+  *         transactions and completions of the URBs, in their order. The
+  *         callbacks of the stack are called as from the interrupt handler.
+  * @param  until: Date in ns
+  * @retval None
+  */
+static void EMU_Advance(uint64_t until)
+{
+  EMU_ChannelTypeDef *ch, *next_ch;
+  uint64_t t, start;
+  uint8_t  i, what;
+
+  if(Emu_InAdvance)
+  {
+    return;
+  }
+  Emu_InAdvance = 1;
+
+  for(;;)
+  {
+    t = until;
+    what = 0;
+    next_ch = NULL;
+
+    if((Emu_PortEvent != EMU_PORT_NONE) && (Emu_PortTime <= t))
+    {
+      t = Emu_PortTime;
+      what = 1;
+    }
+    if((Emu_Host != NULL) && (Emu_NextSof <= t) && (Emu_NextSof < t || what == 0))
+    {
+      t = Emu_NextSof;
+      what = 2;
+    }
+    for(i = 0; i < EMU_CHANNELS; i++)
+    {
+      ch = &Emu_Channel[i];
+      if(ch->state == EMU_CH_DONE)
+      {
+        start = ch->next;
+      }
+      else if(ch->state == EMU_CH_XFER)
+      {
+        start = (ch->next > Emu_BusFree) ? ch->next : Emu_BusFree;
+      }
+      else
+      {
+        continue;
+      }
+      if((start < t) || ((start == t) && (what == 0) && (next_ch == NULL)))
+      {
+        t = start;
+        what = 3;
+        next_ch = ch;
+      }
+    }
+    if(what == 0)
+    {
+      break;
+    }
+    Emu_Now = t;
+
+    switch(what)
+    {
+    case 1:
+      what = Emu_PortEvent;
+      Emu_PortEvent = EMU_PORT_NONE;
+      if((what == EMU_PORT_CONNECT) && Emu_Plugged && Emu_Vbus && !Emu_Connected)
+      {
+        Emu_Connected = 1;
+        USBH_LL_Connect(Emu_Host);
+      }
+      else if((what == EMU_PORT_ENABLE) && Emu_Connected)
+      {
+        Emu_Enabled = 1;
+        Emu_NextSof = Emu_Now;
+        USBH_LL_Connect(Emu_Host);
+      }
+      else if((what == EMU_PORT_DISCONNECT) && Emu_Connected)
+      {
+        Emu_Connected = 0;
+        Emu_Enabled = 0;
+        EMU_AbortChannels();
+        USBH_LL_Disconnect(Emu_Host);
+      }
+      break;
+
+    case 2:
+      /* SOF, or the SysTick of usbh_conf.c while the port is disabled */
+      if(Emu_Enabled)
+      {
+        if(Emu_BusFree < Emu_Now + EMU_SOF_NS)
+        {
+          Emu_BusFree = Emu_Now + EMU_SOF_NS;
+        }
+        EMU_Stats.sofs++;
+      }
+      Emu_NextSof += EMU_FRAME_NS;
+      USBH_LL_IncTimer(Emu_Host);
+      break;
+
+    default:
+      if(next_ch->state == EMU_CH_DONE)
+      {
+        next_ch->state = EMU_CH_IDLE;
+        next_ch->urb_state = next_ch->end_state;
+#if (USBH_USE_OS == 1)
+        /* As HAL_HCD_HC_NotifyURBChange_Callback */
+        USBH_LL_NotifyURBChange(Emu_Host);
+#endif
+      }
+      else
+      {
+        EMU_Transaction(next_ch);
+      }
+      break;
+    }
+
+    if(Emu_StopOnWake && Emu_Woken)
+    {
+      /* A thread is ready, the idle time ends with this interrupt */
+      Emu_InAdvance = 0;
+      return;
+    }
+  }
+
+  Emu_Now = until;
+  Emu_InAdvance = 0;
+}
+
+/**
+  * @brief  Runs the emulated time for a pass of the stack.
+  * @param  None
+  * @retval None
+  */
+static void EMU_Step(void)
+{
+  EMU_Stats.calls++;
+  EMU_Advance(Emu_Now + Emu_StepTime);
+#if (USBH_USE_OS == 1)
+  EMU_OS_Preempt();
+#endif
+}
+
+/*******************************************************************************
+                       Scheduler hooks (usbh_emu_os.c)
+*******************************************************************************/
+/**
+  * @brief  Lets the emulated time run with no thread ready, up to a date or
+  *         to the interrupt that readies a thread.
+  * @param  until_us: Date in us
+  * @retval None
+  */
+void EMU_Idle(uint64_t until_us)
+{
+  uint64_t start = Emu_Now;
+
+  Emu_Woken = 0;
+  Emu_StopOnWake = 1;
+  EMU_Advance(until_us * 1000);
+  Emu_StopOnWake = 0;
+  EMU_Stats.idle_ns += Emu_Now - start;
+}
+
+/**
+  * @brief  Ends the idle time, called when a thread is readied.
+  * @param  None
+  * @retval None
+  */
+void EMU_Wake(void)
+{
+  Emu_Woken = 1;
+}
+
+/**
+  * @brief  Runs the emulated time for a context switch, as long as a pass of
+  *         the stack.
+  * @param  None
+  * @retval None
+  */
+void EMU_Switch(void)
+{
+  EMU_Stats.switches++;
+  EMU_Advance(Emu_Now + Emu_StepTime);
+}
+
+/**
+  * @brief  Tells whether the code runs from an interrupt of the emulator.
+  * @param  None
+  * @retval 1 in the callbacks of the stack called by the emulated time
+  */
+uint8_t EMU_InInterrupt(void)
+{
+  return Emu_InAdvance;
+}
+
+/**
+  * @brief  Runs the next transaction of a channel on the bus.
+  * @param  ch: Channel
+  * @retval None
+  */
+static void EMU_Transaction(EMU_ChannelTypeDef *ch)
+{
+  uint8_t  packet[64];
+  uint16_t n, mps;
+  uint8_t  pid;
+  uint64_t duration;
+  EMU_HandshakeTypeDef hs;
+
+  mps = (ch->mps < sizeof(packet)) ? ch->mps : sizeof(packet);
+  n = ch->length - ch->count;
+  if(n > mps)
+  {
+    n = mps;
+  }
+  duration = (ch->token == USBH_PID_SETUP) ? EMU_DATA_NS(8) : EMU_DATA_NS(n);
+
+  /* A transaction does not cross the end of the frame */
+  if(Emu_Enabled && (Emu_Now + duration > Emu_NextSof - EMU_EOF_NS))
+  {
+    Emu_BusFree = Emu_NextSof;
+    return;
+  }
+
+  if(!Emu_Enabled || !EMU_MSC_IsOpen() || (ch->dev_addr != EMU_MSC_GetAddress()))
+  {
+    /* No answer of the device, 3 errors */
+    Emu_BusFree = Emu_Now + EMU_TIMEOUT_NS;
+    EMU_Complete(ch, USBH_URB_ERROR);
+    return;
+  }
+
+  if(ch->token == USBH_PID_SETUP)
+  {
+    Emu_BusFree = Emu_Now + duration;
+    EMU_MSC_Setup(ch->buff);
+    EMU_Stats.packets++;
+    ch->count = USBH_SETUP_PKT_SIZE;
+    EMU_Complete(ch, USBH_URB_DONE);
+    return;
+  }
+
+  if(!ch->dir_in)
+  {
+    Emu_BusFree = Emu_Now + duration;
+    hs = EMU_InjectNak() ? EMU_NAK :
+         EMU_MSC_Out(ch->ep_addr, ch->toggle_out, ch->buff + ch->count, n, Emu_Now);
+    if(hs == EMU_ACK)
+    {
+      EMU_Stats.packets++;
+      ch->count += n;
+      if(ch->ep_type != USB_EP_TYPE_CTRL)
+      {
+        ch->toggle_out ^= 1;
+      }
+      if(ch->count >= ch->length)
+      {
+        EMU_Complete(ch, USBH_URB_DONE);
+      }
+    }
+    else if(hs == EMU_NAK)
+    {
+      /* The HAL halts the channel on a NAK of an OUT transaction */
+      EMU_Stats.naks++;
+      EMU_Complete(ch, USBH_URB_NOTREADY);
+    }
+    else
+    {
+      EMU_Stats.stalls++;
+      EMU_Complete(ch, USBH_URB_STALL);
+    }
+    return;
+  }
+
+  hs = EMU_InjectNak() ? EMU_NAK : EMU_MSC_In(ch->ep_addr, &pid, packet, &n, Emu_Now);
+  if(hs == EMU_ACK)
+  {
+    Emu_BusFree = Emu_Now + EMU_DATA_NS(n);
+    EMU_Stats.packets++;
+    if(n > ch->length - ch->count)
+    {
+      /* Babble */
+      EMU_Stats.errors++;
+      EMU_Complete(ch, USBH_URB_ERROR);
+      return;
+    }
+    if((ch->ep_type != USB_EP_TYPE_CTRL) && (pid != ch->toggle_in))
+    {
+      /* Data toggle mismatch: the packet is acknowledged and dropped */
+      EMU_Stats.errors++;
+      return;
+    }
+    if(ch->ep_type != USB_EP_TYPE_CTRL)
+    {
+      ch->toggle_in ^= 1;
+    }
+    memcpy(ch->buff + ch->count, packet, n);
+    ch->count += n;
+    if((n < ch->mps) || (ch->count >= ch->length))
+    {
+      EMU_Complete(ch, USBH_URB_DONE);
+    }
+  }
+  else if(hs == EMU_NAK)
+  {
+    Emu_BusFree = Emu_Now + EMU_HANDSHAKE_NS;
+    EMU_Stats.naks++;
+    if(ch->ep_type == USB_EP_TYPE_INTR)
+    {
+      EMU_Complete(ch, USBH_URB_NOTREADY);
+    }
+    /* Bulk and control IN transactions are retried by the HAL */
+  }
+  else
+  {
+    Emu_BusFree = Emu_Now + EMU_HANDSHAKE_NS;
+    EMU_Stats.stalls++;
+    EMU_Complete(ch, USBH_URB_STALL);
+  }
+}
+
+/**
+  * @brief  Ends the transactions of a URB, its new state is seen by the stack
+  *         after the interrupt handling of the HAL.
+  * @param  ch: Channel
+  * @param  state: Final state of the URB
+  * @retval None
+  */
+static void EMU_Complete(EMU_ChannelTypeDef *ch, USBH_URBStateTypeDef state)
+{
+  ch->state = EMU_CH_DONE;
+  ch->end_state = state;
+  ch->next = Emu_BusFree + EMU_URB_NS;
+}
+
+/**
+  * @brief  Schedules a port interrupt.
+  * @param  event: Event
+  * @param  time: Date of the event in ns
+  * @retval None
+  */
+static void EMU_PortSchedule(EMU_PortEventTypeDef event, uint64_t time)
+{
+  Emu_PortEvent = event;
+  Emu_PortTime = time;
+}
+
+/**
+  * @brief  Halts all the channels.
+  * @param  None
+  * @retval None
+  */
+static void EMU_AbortChannels(void)
+{
+  uint8_t i;
+
+  for(i = 0; i < EMU_CHANNELS; i++)
+  {
+    Emu_Channel[i].state = EMU_CH_IDLE;
+  }
+}
+
+/**
+  * @brief  Draws an injected NAK.
+  * @param  None
+  * @retval 1 to NAK the transaction
+  */
+static uint8_t EMU_InjectNak(void)
+{
+  if(Emu_NakRate == 0)
+  {
+    return 0;
+  }
+  Emu_Random = Emu_Random * 1103515245 + 12345;
+  return (((Emu_Random >> 16) & 0x7FFF) % 1000) < Emu_NakRate;
+}
+
+/*******************************************************************************
+                       LL Driver Interface (USB Host Library --> Emulator)
+*******************************************************************************/
+/**
+  * @brief  Initializes the Low Level portion of the Host driver.
+  * @param  phost: Host handle
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_LL_Init(USBH_HandleTypeDef *phost)
+{
+  Emu_Host = phost;
+  Emu_NextSof = Emu_Now;
+  phost->pData = Emu_Channel;
+  memset(Emu_Channel, 0, sizeof(Emu_Channel));
+  USBH_LL_SetTimer(phost, 0);
+  return USBH_OK;
+}
+
+/**
+  * @brief  De-Initializes the Low Level portion of the Host driver.
+  * @param  phost: Host handle
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_LL_DeInit(USBH_HandleTypeDef *phost)
+{
+  EMU_AbortChannels();
+  Emu_Host = NULL;
+  return USBH_OK;
+}
+
+/**
+  * @brief  Starts the Low Level portion of the Host driver.
+  * @param  phost: Host handle
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_LL_Start(USBH_HandleTypeDef *phost)
+{
+  return USBH_OK;
+}
+
+/**
+  * @brief  Stops the Low Level portion of the Host driver.
+  * @param  phost: Host handle
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_LL_Stop(USBH_HandleTypeDef *phost)
+{
+  EMU_AbortChannels();
+  return USBH_OK;
+}
+
+/**
+  * @brief  Returns the USB Host Speed from the Low Level Driver.
+  * @param  phost: Host handle
+  * @retval USBH Speeds
+  */
+USBH_SpeedTypeDef USBH_LL_GetSpeed(USBH_HandleTypeDef *phost)
+{
+  return USBH_SPEED_FULL;
+}
+
+/**
+  * @brief  Resets the Host Port of the Low Level Driver.
+  * @param  phost: Host handle
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_LL_ResetPort(USBH_HandleTypeDef *phost)
+{
+  /* Reset signaling of 10 ms, in a HAL_Delay of the HAL */
+  Emu_Enabled = 0;
+  EMU_AbortChannels();
+  EMU_MSC_BusReset();
+  EMU_Advance(Emu_Now + EMU_RESET_MS * 1000000ULL);
+  if(Emu_Connected)
+  {
+    EMU_PortSchedule(EMU_PORT_ENABLE, Emu_Now + EMU_ENABLE_NS);
+  }
+  return USBH_OK;
+}
+
+/**
+  * @brief  Returns the last transferred packet size.
+  * @param  phost: Host handle
+  * @param  pipe: Pipe index
+  * @retval Packet Size
+  */
+uint32_t USBH_LL_GetLastXferSize(USBH_HandleTypeDef *phost, uint8_t pipe)
+{
+  return Emu_Channel[pipe].count;
+}
+
+/**
+  * @brief  Opens a pipe of the Low Level Driver.
+  * @param  phost: Host handle
+  * @param  pipe: Pipe index
+  * @param  epnum: Endpoint Number
+  * @param  dev_address: Device USB address
+  * @param  speed: Device Speed
+  * @param  ep_type: Endpoint Type
+  * @param  mps: Endpoint Max Packet Size
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_LL_OpenPipe(USBH_HandleTypeDef *phost,
+                                    uint8_t pipe,
+                                    uint8_t epnum,
+                                    uint8_t dev_address,
+                                    uint8_t speed,
+                                    uint8_t ep_type,
+                                    uint16_t mps)
+{
+  EMU_ChannelTypeDef *ch = &Emu_Channel[pipe];
+
+  ch->ep_addr = epnum;
+  ch->dev_addr = dev_address;
+  ch->ep_type = ep_type;
+  ch->mps = mps;
+  ch->state = EMU_CH_IDLE;
+  ch->urb_state = USBH_URB_IDLE;
+  return USBH_OK;
+}
+
+/**
+  * @brief  Closes a pipe of the Low Level Driver.
+  * @param  phost: Host handle
+  * @param  pipe: Pipe index
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_LL_ClosePipe(USBH_HandleTypeDef *phost, uint8_t pipe)
+{
+  Emu_Channel[pipe].state = EMU_CH_IDLE;
+  return USBH_OK;
+}
+
+/**
+  * @brief  Submits a new URB to the low level driver.
+  * @param  phost: Host handle
+  * @param  pipe: Pipe index
+  * @param  direction: 0 for OUT, 1 for IN
+  * @param  ep_type: Endpoint Type
+  * @param  token: 0 for PID_SETUP, 1 for PID_DATA
+  * @param  pbuff: pointer to URB data
+  * @param  length: length of URB data
+  * @param  do_ping: activate do ping protocol (for high speed only)
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_LL_SubmitURB(USBH_HandleTypeDef *phost,
+                                     uint8_t pipe,
+                                     uint8_t direction,
+                                     uint8_t ep_type,
+                                     uint8_t token,
+                                     uint8_t* pbuff,
+                                     uint16_t length,
+                                     uint8_t do_ping)
+{
+  EMU_ChannelTypeDef *ch = &Emu_Channel[pipe];
+
+  ch->dir_in = direction;
+  ch->ep_type = ep_type;
+  ch->token = token;
+  ch->buff = pbuff;
+  ch->length = length;
+  ch->count = 0;
+  ch->urb_state = USBH_URB_IDLE;
+  ch->state = EMU_CH_XFER;
+  ch->next = Emu_Now;
+  EMU_Stats.urbs++;
+  if((ep_type == USB_EP_TYPE_BULK) && (length > 0) &&
+     ((size_t)pbuff & (USBH_DMA_ALIGN - 1)))
+  {
+    /* The DMA of the core cannot reach this buffer */
+    EMU_Stats.errors++;
+  }
+  EMU_Step();
+  return USBH_OK;
+}
+
+/**
+  * @brief  Gets a URB state from the low level driver.
+  * @param  phost: Host handle
+  * @param  pipe: Pipe index
+  * @retval URB state
+  */
+USBH_URBStateTypeDef USBH_LL_GetURBState(USBH_HandleTypeDef *phost, uint8_t pipe)
+{
+  EMU_Step();
+  return Emu_Channel[pipe].urb_state;
+}
+
+/**
+  * @brief  Drives VBUS.
+  * @param  phost: Host handle
+  * @param  state: 1 to activate VBUS, 0 to deactivate it
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_LL_DriverVBUS(USBH_HandleTypeDef *phost, uint8_t state)
+{
+  Emu_Vbus = state;
+  if(state && Emu_Plugged && !Emu_Connected)
+  {
+    EMU_PortSchedule(EMU_PORT_CONNECT, Emu_Now + EMU_ATTACH_NS);
+  }
+  else if(!state && Emu_Connected)
+  {
+    EMU_PortSchedule(EMU_PORT_DISCONNECT, Emu_Now);
+  }
+  return USBH_OK;
+}
+
+/**
+  * @brief  Sets toggle for a pipe.
+  * @param  phost: Host handle
+  * @param  pipe: Pipe index
+  * @param  toggle: toggle (0/1)
+  * @retval USBH Status
+  */
+USBH_StatusTypeDef USBH_LL_SetToggle(USBH_HandleTypeDef *phost, uint8_t pipe, uint8_t toggle)
+{
+  if(Emu_Channel[pipe].ep_addr & 0x80)
+  {
+    Emu_Channel[pipe].toggle_in = toggle;
+  }
+  else
+  {
+    Emu_Channel[pipe].toggle_out = toggle;
+  }
+  return USBH_OK;
+}
+
+/**
+  * @brief  Returns the current toggle of a pipe.
+  * @param  phost: Host handle
+  * @param  pipe: Pipe index
+  * @retval toggle (0/1)
+  */
+uint8_t USBH_LL_GetToggle(USBH_HandleTypeDef *phost, uint8_t pipe)
+{
+  if(Emu_Channel[pipe].ep_addr & 0x80)
+  {
+    return Emu_Channel[pipe].toggle_in;
+  }
+  return Emu_Channel[pipe].toggle_out;
+}
+
+/**
+  * @brief  Delay routine for the USB Host Library, the emulated time runs
+  *         with its interrupts. With USBH_USE_OS the thread is blocked and
+  *         the others run, as with osDelay in usbh_conf.c.
+  * @param  Delay: Delay in ms
+  * @retval None
+  */
+void USBH_Delay(uint32_t Delay)
+{
+#if (USBH_USE_OS == 1)
+  osDelay(Delay);
+#else
+  EMU_Advance(Emu_Now + (uint64_t)Delay * 1000000);
+#endif
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
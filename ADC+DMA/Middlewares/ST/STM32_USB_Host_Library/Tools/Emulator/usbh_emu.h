@@ -0,0 +1,111 @@
+/**
+  ******************************************************************************
+  * @file    usbh_emu.h
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Header file of the host emulator of the USB OTG FS controller
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __USBH_EMU_H
+#define __USBH_EMU_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/**
+  * @brief  Counters of the emulated bus and device
+  */
+typedef struct
+{
+  uint32_t calls;           /*!< Calls of the stack to USBH_LL_SubmitURB and USBH_LL_GetURBState */
+  uint32_t urbs;            /*!< Submitted URBs                                                  */
+  uint32_t packets;         /*!< Acknowledged transactions                                       */
+  uint32_t naks;            /*!< NAKed transactions                                              */
+  uint32_t stalls;          /*!< STALLed transactions                                            */
+  uint32_t sofs;            /*!< Start of frames                                                 */
+  uint32_t commands;        /*!< SCSI commands received by the device                            */
+  uint32_t status_commands; /*!< Commands other than READ(10) and WRITE(10)                      */
+  uint32_t sectors_read;    /*!< Sectors sent by the device                                      */
+  uint32_t sectors_written; /*!< Sectors written by the device                                   */
+  uint32_t errors;          /*!< Protocol errors: data toggle, phase, babble, invalid CBW, DMA   */
+  uint32_t switches;        /*!< Context switches between threads (USBH_USE_OS)                  */
+  uint64_t idle_ns;         /*!< Time with no thread ready to run (USBH_USE_OS)                  */
+}USBH_EMU_StatsTypeDef;
+
+/**
+  * @brief  Handshake of the emulated device to a transaction
+  */
+typedef enum
+{
+  EMU_ACK = 0,
+  EMU_NAK,
+  EMU_STALL,
+}EMU_HandshakeTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+/* Emulator control, for the host test programs */
+uint8_t  USBH_EMU_Open(const char *path, uint32_t sectors);
+void     USBH_EMU_Close(void);
+uint8_t  USBH_EMU_OpenLun(uint8_t lun, const char *path, uint32_t sectors);
+void     USBH_EMU_CloseLun(uint8_t lun);
+void     USBH_EMU_SetTiming(uint32_t latency_us, uint32_t nak_permille);
+void     USBH_EMU_SetStepTime(uint32_t step_ns);
+void     USBH_EMU_Plug(uint8_t plugged);
+void     USBH_EMU_Run(uint32_t us);
+uint64_t USBH_EMU_GetTime(void);
+void     USBH_EMU_GetStats(USBH_EMU_StatsTypeDef *stats);
+void     USBH_EMU_ResetStats(void);
+
+/* Emulated mass storage device (usbh_emu_msc.c), called by the bus of
+   usbh_conf_emu.c */
+extern USBH_EMU_StatsTypeDef EMU_Stats;
+
+uint8_t              EMU_MSC_IsOpen(void);
+void                 EMU_MSC_SetLatency(uint32_t latency_ns);
+void                 EMU_MSC_BusReset(void);
+uint8_t              EMU_MSC_GetAddress(void);
+void                 EMU_MSC_Setup(const uint8_t *setup);
+EMU_HandshakeTypeDef EMU_MSC_Out(uint8_t ep, uint8_t pid, const uint8_t *buff, uint16_t length, uint64_t now);
+EMU_HandshakeTypeDef EMU_MSC_In(uint8_t ep, uint8_t *pid, uint8_t *buff, uint16_t *length, uint64_t now);
+
+/* Cooperative scheduler of the CMSIS-RTOS functions (usbh_emu_os.c) and its
+   hooks in the emulated clock of usbh_conf_emu.c */
+void     EMU_OS_Preempt(void);
+void     EMU_Idle(uint64_t until_us);
+void     EMU_Wake(void);
+void     EMU_Switch(void);
+uint8_t  EMU_InInterrupt(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __USBH_EMU_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,826 @@
+/**
+  ******************************************************************************
+  * @file    usbh_emu_bench.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Host benchmark and regression test of the MSC class and of FatFs
+  *          over USB, on the host emulator of the USB OTG FS controller
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "usbh_core.h"
+#include "usbh_msc.h"
+#include "ff_gen_drv.h"
+#include "drivers/usbh_diskio.h"
+#include "disk_log.h"
+#include "usbh_emu.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum
+{
+  APPLICATION_IDLE = 0,
+  APPLICATION_READY,
+  APPLICATION_DISCONNECT,
+}Bench_StateTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define CHUNK_SIZE        32768   /* USBH_MSC_Read/Write and f_read/f_write size */
+#define ENUM_TIMEOUT_US   10000000
+#define DISK_MB           64      /* Size of the emulated disk */
+#define LUNS              2       /* Units of the device in BENCH_Luns */
+#define ROW_SIZE          32      /* Longest CSV row of BENCH_Log */
+
+#define CHECK(x)  do { FRESULT r_ = (x); if (r_ != FR_OK) { \
+                    printf("%s failed (%d) at line %d\n", #x, r_, __LINE__); exit(1); } } while (0)
+#define CHECK_USBH(x)  do { if ((x) != USBH_OK) { \
+                    printf("%s failed at line %d\n", #x, __LINE__); exit(1); } } while (0)
+
+/* Private variables ---------------------------------------------------------*/
+USBH_HandleTypeDef hUSB_Host;
+static Bench_StateTypeDef Appli_state = APPLICATION_IDLE;
+static uint32_t Loop_Time = 10;           /* Application time between USBH_Process, in us */
+static uint64_t App_Time;                 /* Time of the application loop, in us */
+static uint64_t Max_Process;              /* Longest USBH_Process call, in us */
+static uint32_t Max_Frames;               /* Most SOFs during a USBH_Process call */
+#if (USBH_USE_OS == 1)
+static osMessageQId Appli_Event;          /* Posted by USBH_UserProcess */
+#endif
+
+static uint8_t Buffer[CHUNK_SIZE + 1];   /* + 1 for the unaligned f_write/f_read */
+static uint8_t Check[CHUNK_SIZE];
+static uint8_t Stream[USBH_MSC_STREAM_DEPTH][CHUNK_SIZE];
+static unsigned long Errors;
+static char Lun_Path[LUNS][4];            /* Volumes of the units */
+
+/* Private function prototypes -----------------------------------------------*/
+static void USBH_UserProcess(USBH_HandleTypeDef *phost, uint8_t id);
+#if (USBH_USE_OS == 0)
+static void BENCH_Process(void);
+#endif
+static void BENCH_CheckLoop(const char *name);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  User Process, as in the main.c of the application
+  * @param  phost: Host handle
+  * @param  id: Host Library user message ID
+  * @retval None
+  */
+static void USBH_UserProcess(USBH_HandleTypeDef *phost, uint8_t id)
+{
+  switch(id)
+  {
+  case HOST_USER_DISCONNECTION:
+    Appli_state = APPLICATION_DISCONNECT;
+    break;
+
+  case HOST_USER_CLASS_ACTIVE:
+    Appli_state = APPLICATION_READY;
+    break;
+
+  default:
+    break;
+  }
+#if (USBH_USE_OS == 1)
+  /* Called by the host thread, or the disconnect interrupt */
+  osMessagePut(Appli_Event, id, 0);
+#endif
+}
+
+/**
+  * @brief  Returns the host time
+  * @param  None
+  * @retval Time in s
+  */
+static double BENCH_Now(void)
+{
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/**
+  * @brief  Fills a buffer with the data of an offset of the disk or file
+  * @param  buff: Buffer
+  * @param  ofs: Offset of the buffer
+  * @param  len: Number of bytes
+  * @retval None
+  */
+static void BENCH_Pattern(uint8_t *buff, uint32_t ofs, uint32_t len)
+{
+  uint32_t i;
+
+  for(i = 0; i < len; i++)
+  {
+    buff[i] = (uint8_t)((ofs + i) * 13 + ((ofs + i) >> 9));
+  }
+}
+
+/**
+  * @brief  Calls USBH_Process and records the longest call, in time and in
+  *         frames the main loop could not serve
+  * @param  None
+  * @retval None
+  */
+#if (USBH_USE_OS == 0)
+static void BENCH_Process(void)
+{
+  USBH_EMU_StatsTypeDef st;
+  uint64_t t = USBH_EMU_GetTime();
+  uint32_t sofs;
+
+  USBH_EMU_GetStats(&st);
+  sofs = st.sofs;
+  USBH_Process(&hUSB_Host);
+  USBH_EMU_GetStats(&st);
+  t = USBH_EMU_GetTime() - t;
+  if(t > Max_Process)
+  {
+    Max_Process = t;
+  }
+  if(st.sofs - sofs > Max_Frames)
+  {
+    Max_Frames = st.sofs - sofs;
+  }
+}
+#endif
+
+/**
+  * @brief  Checks that no USBH_Process call of the enumeration took more than
+  *         a frame: the host state machine waits on the Host timer and the
+  *         main loop keeps running
+  * @param  name: Name of the phase
+  * @retval None
+  */
+static void BENCH_CheckLoop(const char *name)
+{
+#if (USBH_USE_OS == 0)
+  printf("  %-24s : %7.1f ms  %7lu SOFs in the longest USBH_Process call\n",
+         name, Max_Process / 1000.0, (unsigned long)Max_Frames);
+  if(Max_Frames > 1)
+  {
+    printf("  the main loop missed frames\n");
+    Errors++;
+  }
+#endif
+  Max_Process = 0;
+  Max_Frames = 0;
+}
+
+/**
+  * @brief  Runs the main loop of the application until a state is reached.
+  *         With USBH_USE_OS the host thread runs the stack and the
+  *         application waits for the events of USBH_UserProcess.
+  * @param  state: Awaited state
+  * @retval Emulated time taken in us, 0 on timeout
+  */
+static uint64_t BENCH_WaitState(Bench_StateTypeDef state)
+{
+  uint64_t start = USBH_EMU_GetTime();
+
+  while(Appli_state != state)
+  {
+    if(USBH_EMU_GetTime() - start > ENUM_TIMEOUT_US)
+    {
+      return 0;
+    }
+#if (USBH_USE_OS == 1)
+    osMessageGet(Appli_Event, ENUM_TIMEOUT_US / 1000);
+#else
+    BENCH_Process();
+    USBH_EMU_Run(Loop_Time);
+    App_Time += Loop_Time;
+#endif
+  }
+  return USBH_EMU_GetTime() - start;
+}
+
+/**
+  * @brief  Returns the share of the CPU used by the stack: the emulated time
+  *         neither idle nor in the application loop.
+  * @param  st: Counters of the period
+  * @param  us: Emulated time of the period in us
+  * @param  app: Time of the application loop in the period, in us
+  * @retval Percentage
+  */
+static double BENCH_Cpu(const USBH_EMU_StatsTypeDef *st, uint64_t us, uint64_t app)
+{
+  if(us == 0)
+  {
+    return 0.0;
+  }
+  return 100.0 * (us - st->idle_ns / 1000 - app) / us;
+}
+
+/**
+  * @brief  Prints the rate of a transfer and the bus counters
+  * @param  name: Name of the test
+  * @param  bytes: Number of bytes transferred
+  * @param  us: Emulated time in us
+  * @param  host: Host time in s
+  * @retval None
+  */
+static void BENCH_Report(const char *name, uint32_t bytes, uint64_t us, double host)
+{
+  USBH_EMU_StatsTypeDef st;
+
+  USBH_EMU_GetStats(&st);
+  Errors += st.errors;
+  printf("  %-24s %5lu KB : %7.1f KB/s  %5lu cmds %7lu URBs %7lu packets %6lu NAKs %5.1f %% CPU  (%.2f s host)\n",
+         name, (unsigned long)(bytes >> 10), us ? (bytes / 1024.0) / (us * 1e-6) : 0.0,
+         (unsigned long)st.commands, (unsigned long)st.urbs, (unsigned long)st.packets,
+         (unsigned long)st.naks, BENCH_Cpu(&st, us, 0), host);
+}
+
+/**
+  * @brief  Writes and reads back the disk with USBH_MSC_Write and USBH_MSC_Read
+  * @param  size: Number of bytes
+  * @param  chunk: Sectors per command
+  * @retval None
+  */
+static void BENCH_Raw(uint32_t size, uint32_t chunk)
+{
+  uint32_t ofs, n;
+  uint64_t t;
+  double h;
+
+  USBH_EMU_ResetStats();
+  t = USBH_EMU_GetTime();
+  h = BENCH_Now();
+  for(ofs = 0; ofs < size; ofs += n)
+  {
+    n = (size - ofs < chunk * 512) ? size - ofs : chunk * 512;
+    BENCH_Pattern(Buffer, ofs, n);
+    CHECK_USBH(USBH_MSC_Write(&hUSB_Host, 0, ofs / 512, Buffer, n / 512));
+  }
+  BENCH_Report("USBH_MSC_Write", size, USBH_EMU_GetTime() - t, BENCH_Now() - h);
+
+  USBH_EMU_ResetStats();
+  t = USBH_EMU_GetTime();
+  h = BENCH_Now();
+  for(ofs = 0; ofs < size; ofs += n)
+  {
+    n = (size - ofs < chunk * 512) ? size - ofs : chunk * 512;
+    CHECK_USBH(USBH_MSC_Read(&hUSB_Host, 0, ofs / 512, Buffer, n / 512));
+    BENCH_Pattern(Check, ofs, n);
+    if(memcmp(Buffer, Check, n) != 0)
+    {
+      printf("  data mismatch at offset %lu\n", (unsigned long)ofs);
+      Errors++;
+      break;
+    }
+  }
+  BENCH_Report("USBH_MSC_Read", size, USBH_EMU_GetTime() - t, BENCH_Now() - h);
+}
+
+/**
+  * @brief  Writes the disk after the area of BENCH_Raw with USBH_MSC_StreamWrite,
+  *         keeping the queue full, and reads it back
+  * @param  size: Number of bytes
+  * @param  chunk: Sectors per write
+  * @retval None
+  */
+static void BENCH_Stream(uint32_t size, uint32_t chunk)
+{
+  USBH_StatusTypeDef status = USBH_BUSY;
+  uint32_t ofs, n, queued = 0, done;
+  uint64_t t;
+  double h;
+
+  USBH_EMU_ResetStats();
+  t = USBH_EMU_GetTime();
+  h = BENCH_Now();
+  done = USBH_MSC_StreamCompleted(&hUSB_Host);
+  for(ofs = 0; ofs < size; ofs += n)
+  {
+    /* Blocked until a write completes when the queue is full */
+    if(queued - (USBH_MSC_StreamCompleted(&hUSB_Host) - done) == USBH_MSC_STREAM_DEPTH)
+    {
+      status = USBH_MSC_StreamWait(&hUSB_Host);
+      if(status == USBH_FAIL)
+      {
+        break;
+      }
+    }
+    n = (size - ofs < chunk * 512) ? size - ofs : chunk * 512;
+    BENCH_Pattern(Stream[queued % USBH_MSC_STREAM_DEPTH], size + ofs, n);
+    CHECK_USBH(USBH_MSC_StreamWrite(&hUSB_Host, 0, (size + ofs) / 512,
+                                    Stream[queued % USBH_MSC_STREAM_DEPTH], n / 512));
+    queued++;
+  }
+  while(status != USBH_FAIL)
+  {
+    /* Until the last write is completed */
+    status = USBH_MSC_StreamWait(&hUSB_Host);
+    if(status == USBH_OK)
+    {
+      break;
+    }
+  }
+  if(status == USBH_FAIL)
+  {
+    printf("  USBH_MSC_StreamWait failed after %lu writes\n",
+           (unsigned long)(USBH_MSC_StreamCompleted(&hUSB_Host) - done));
+    Errors++;
+    return;
+  }
+  BENCH_Report("USBH_MSC_StreamWrite", size, USBH_EMU_GetTime() - t, BENCH_Now() - h);
+
+  for(ofs = 0; ofs < size; ofs += n)
+  {
+    n = (size - ofs < CHUNK_SIZE) ? size - ofs : CHUNK_SIZE;
+    CHECK_USBH(USBH_MSC_Read(&hUSB_Host, 0, (size + ofs) / 512, Buffer, n / 512));
+    BENCH_Pattern(Check, size + ofs, n);
+    if(memcmp(Buffer, Check, n) != 0)
+    {
+      printf("  stream data mismatch at offset %lu\n", (unsigned long)ofs);
+      Errors++;
+      break;
+    }
+  }
+}
+
+/**
+  * @brief  Writes a file and reads it back
+  * @param  buff: Buffer of f_write and f_read, of CHUNK_SIZE bytes
+  * @param  file: Path of the file
+  * @param  wname: Name of the f_write measure
+  * @param  rname: Name of the f_read measure
+  * @param  size: Size of the file
+  * @retval None
+  */
+static void BENCH_File(uint8_t *buff, const char *file, const char *wname, const char *rname,
+                       uint32_t size)
+{
+  FIL fil;
+  UINT bw;
+  uint32_t ofs, n;
+  uint64_t t;
+  double h;
+
+  USBH_EMU_ResetStats();
+  t = USBH_EMU_GetTime();
+  h = BENCH_Now();
+  CHECK(f_open(&fil, file, FA_CREATE_ALWAYS | FA_WRITE));
+  for(ofs = 0; ofs < size; ofs += n)
+  {
+    n = (size - ofs < CHUNK_SIZE) ? size - ofs : CHUNK_SIZE;
+    BENCH_Pattern(buff, ofs, n);
+    CHECK(f_write(&fil, buff, n, &bw));
+  }
+  CHECK(f_close(&fil));
+  BENCH_Report(wname, size, USBH_EMU_GetTime() - t, BENCH_Now() - h);
+
+  USBH_EMU_ResetStats();
+  t = USBH_EMU_GetTime();
+  h = BENCH_Now();
+  CHECK(f_open(&fil, file, FA_READ));
+  for(ofs = 0; ofs < size; ofs += n)
+  {
+    n = (size - ofs < CHUNK_SIZE) ? size - ofs : CHUNK_SIZE;
+    CHECK(f_read(&fil, buff, n, &bw));
+    BENCH_Pattern(Check, ofs, n);
+    if((bw != n) || (memcmp(buff, Check, n) != 0))
+    {
+      printf("  file data mismatch at offset %lu\n", (unsigned long)ofs);
+      Errors++;
+      break;
+    }
+  }
+  CHECK(f_close(&fil));
+  BENCH_Report(rname, size, USBH_EMU_GetTime() - t, BENCH_Now() - h);
+}
+
+/**
+  * @brief  Creates a file system on the disk, writes a file and reads it back
+  *         from an aligned buffer, then from an unaligned one
+  * @param  size: Size of the file
+  * @retval None
+  */
+static void BENCH_FatFs(uint32_t size)
+{
+  FATFS fs;
+  char path[4];
+
+  FATFS_LinkDriver(&USBH_Driver, path);
+  CHECK(f_mount(&fs, path, 0));
+  CHECK(f_mkfs(path, 0, 4096));
+  CHECK(f_mount(&fs, path, 1));
+
+  BENCH_File(Buffer, "seq.bin", "f_write", "f_read", size);
+  BENCH_File(Buffer + 1, "seq.bin", "f_write unaligned", "f_read unaligned", size);
+
+  f_mount(NULL, path, 0);
+  FATFS_UnLinkDriver(path);
+}
+
+/**
+  * @brief  Formats a row of the CSV log, as write_register_in_file does
+  * @param  row: Buffer of ROW_SIZE bytes
+  * @param  i: Index of the row
+  * @retval Length of the row
+  */
+static UINT BENCH_Row(char *row, uint32_t i)
+{
+  return (UINT)sprintf(row, "%lu, %lu\r\n", (unsigned long)i, (unsigned long)((i * 2654435761u) >> 20));
+}
+
+/**
+  * @brief  Checks the log file of a volume: the header then the rows the
+  *         volume holds
+  * @param  vol: Volume
+  * @param  rows: Rows written to the log
+  * @param  step: 1 if the volume holds all the rows, otherwise the number of
+  *         volumes of the stripe
+  * @retval None
+  */
+static void BENCH_CheckLog(uint8_t vol, uint32_t rows, uint32_t step)
+{
+  char file[16];
+  char row[ROW_SIZE];
+  FIL fil;
+  UINT br, len;
+  uint8_t *data;
+  uint32_t i, pos;
+
+  sprintf(file, "%slog.csv", Lun_Path[vol]);
+  CHECK(f_open(&fil, file, FA_READ));
+  data = malloc(f_size(&fil) + 1);
+  CHECK(f_read(&fil, data, f_size(&fil), &br));
+  CHECK(f_close(&fil));
+  if((br < 17) || (memcmp(data, "indice, valores\r\n", 17) != 0))
+  {
+    printf("  log header missing on volume %u\n", vol);
+    Errors++;
+    free(data);
+    return;
+  }
+  pos = 17;
+  for(i = (step == 1) ? 0 : vol; i < rows; i += step)
+  {
+    len = BENCH_Row(row, i);
+    if((pos + len > br) || (memcmp(&data[pos], row, len) != 0))
+    {
+      printf("  log row %lu missing on volume %u\n", (unsigned long)i, vol);
+      Errors++;
+      break;
+    }
+    pos += len;
+  }
+  if((i >= rows) && (pos != br))
+  {
+    printf("  log of volume %u is %lu bytes too long\n", vol, (unsigned long)(br - pos));
+    Errors++;
+  }
+  free(data);
+}
+
+/**
+  * @brief  Writes the CSV log with disk_log over some of the volumes and
+  *         checks the files
+  * @param  name: Name of the measure
+  * @param  mode: DISK_LOG_MIRROR or DISK_LOG_STRIPE
+  * @param  vols: Volumes of the log
+  * @param  size: Size of the log
+  * @param  fail: Row before which the medium of the last unit is removed,
+  *         0 for none
+  * @retval None
+  */
+static void BENCH_Log(const char *name, DiskLog_ModeTypeDef mode, uint8_t vols, uint32_t size,
+                      uint32_t fail)
+{
+  DiskLog_TypeDef log;
+  char row[ROW_SIZE];
+  uint32_t i, bytes;
+  uint8_t vol;
+  UINT len;
+  uint64_t t;
+  double h;
+
+  USBH_EMU_ResetStats();
+  t = USBH_EMU_GetTime();
+  h = BENCH_Now();
+  DiskLog_Init(&log, mode);
+  for(vol = 0; vol < vols; vol++)
+  {
+    CHECK(DiskLog_AddVolume(&log, Lun_Path[vol], "log.csv", size));
+  }
+  CHECK(DiskLog_WriteAll(&log, "indice, valores\r\n", 17));
+  for(i = 0, bytes = 17; bytes < size; i++)
+  {
+    if((fail != 0) && (i == fail))
+    {
+      USBH_EMU_CloseLun(vols - 1);
+    }
+    len = BENCH_Row(row, i);
+    CHECK(DiskLog_Write(&log, row, len));
+    bytes += len;
+  }
+  if((fail != 0) && (DiskLog_Volumes(&log) != vols - 1))
+  {
+    printf("  %u volumes left after the failure of a unit\n", DiskLog_Volumes(&log));
+    Errors++;
+  }
+  CHECK(DiskLog_Close(&log));
+  BENCH_Report(name, bytes, USBH_EMU_GetTime() - t, BENCH_Now() - h);
+
+  for(vol = 0; vol < vols; vol++)
+  {
+    if((fail == 0) || (vol != vols - 1))
+    {
+      BENCH_CheckLog(vol, i, (mode == DISK_LOG_MIRROR) ? 1 : vols);
+    }
+  }
+}
+
+/**
+  * @brief  Appends rows to a file of a volume, as the application does for
+  *         each capture, and counts the SCSI commands of a cycle
+  * @param  name: Name of the measure
+  * @param  vol: Volume
+  * @param  mount: 1 to mount the volume for each row, 0 to keep it mounted
+  * @param  cycles: Number of rows
+  * @retval None
+  */
+static void BENCH_Cycles(const char *name, uint8_t vol, uint8_t mount, uint32_t cycles)
+{
+  USBH_EMU_StatsTypeDef st;
+  FATFS fs;
+  FIL fil;
+  char file[16];
+  char row[ROW_SIZE];
+  uint32_t i, failed = 0;
+  UINT bw;
+
+  sprintf(file, "%scycle.csv", Lun_Path[vol]);
+  if(!mount)
+  {
+    f_mount(&fs, Lun_Path[vol], 1);
+  }
+  USBH_EMU_ResetStats();
+  for(i = 0; i < cycles; i++)
+  {
+    if((mount && (f_mount(&fs, Lun_Path[vol], 1) != FR_OK)) ||
+       (f_open(&fil, file, FA_OPEN_ALWAYS | FA_WRITE) != FR_OK))
+    {
+      failed++;
+      continue;
+    }
+    if((f_lseek(&fil, f_size(&fil)) != FR_OK) ||
+       (f_write(&fil, row, BENCH_Row(row, i), &bw) != FR_OK) ||
+       (f_close(&fil) != FR_OK))
+    {
+      failed++;
+    }
+  }
+  USBH_EMU_GetStats(&st);
+  Errors += failed;
+  printf("  %-24s : %5.1f commands per cycle, %3lu status commands, %3lu of %lu cycles failed\n",
+         name, (double)st.commands / cycles, (unsigned long)st.status_commands,
+         (unsigned long)failed, (unsigned long)cycles);
+}
+
+/**
+  * @brief  Plugs the device again with a second unit, a file system on each
+  *         one, and measures the files and the CSV log over both
+  * @param  image: Image file of the second unit, deleted at the end
+  * @param  size: Size of the files
+  * @retval None
+  */
+static void BENCH_Luns(const char *image, uint32_t size)
+{
+  FATFS fs[LUNS];
+  char name[32];
+  uint8_t lun;
+
+  unlink(image);
+  if(USBH_EMU_OpenLun(1, image, DISK_MB * 2048))
+  {
+    printf("Cannot open %s\n", image);
+    Errors++;
+    return;
+  }
+  USBH_EMU_Plug(0);
+  if(BENCH_WaitState(APPLICATION_DISCONNECT) == 0)
+  {
+    printf("Disconnection not seen\n");
+    Errors++;
+    return;
+  }
+  USBH_EMU_Plug(1);
+  if(BENCH_WaitState(APPLICATION_READY) == 0)
+  {
+    printf("Enumeration timeout with %u LUNs, host state %d\n", LUNS, hUSB_Host.gState);
+    Errors++;
+    return;
+  }
+  if(USBH_MSC_GetMaxLUN(&hUSB_Host) != LUNS)
+  {
+    printf("  %u LUNs seen instead of %u\n", USBH_MSC_GetMaxLUN(&hUSB_Host), LUNS);
+    Errors++;
+    return;
+  }
+
+  for(lun = 0; lun < LUNS; lun++)
+  {
+    if(FATFS_LinkDriverEx(&USBH_Driver, Lun_Path[lun], lun) != 0)
+    {
+      printf("  cannot link the LUN %u\n", lun);
+      Errors++;
+      return;
+    }
+    CHECK(f_mount(&fs[lun], Lun_Path[lun], 0));
+    CHECK(f_mkfs(Lun_Path[lun], 0, 4096));
+    CHECK(f_mount(&fs[lun], Lun_Path[lun], 1));
+  }
+  for(lun = 0; lun < LUNS; lun++)
+  {
+    sprintf(name, "%sseq.bin", Lun_Path[lun]);
+    BENCH_File(Buffer, name, lun ? "f_write LUN 1" : "f_write LUN 0",
+               lun ? "f_read LUN 1" : "f_read LUN 0", size);
+  }
+
+  BENCH_Log("log 1 volume", DISK_LOG_MIRROR, 1, size, 0);
+  BENCH_Log("log mirror", DISK_LOG_MIRROR, LUNS, size, 0);
+  BENCH_Log("log stripe", DISK_LOG_STRIPE, LUNS, size, 0);
+  BENCH_Log("log mirror, LUN 1 lost", DISK_LOG_MIRROR, LUNS, size, 1000);
+
+  /* The medium of LUN 1 is back: the first command reports the change */
+  BENCH_Cycles("mount/append LUN 0", 0, 1, 100);
+  BENCH_Cycles("append LUN 0", 0, 0, 100);
+  USBH_EMU_OpenLun(1, image, 0);
+  BENCH_Cycles("mount/append LUN 1 back", 1, 1, 100);
+  BENCH_Cycles("append LUN 1 back", 1, 0, 100);
+
+  for(lun = 0; lun < LUNS; lun++)
+  {
+    f_mount(NULL, Lun_Path[lun], 0);
+    FATFS_UnLinkDriver(Lun_Path[lun]);
+  }
+  USBH_EMU_CloseLun(1);
+  unlink(image);
+}
+
+int main(int argc, char **argv)
+{
+  const char *image = "usbh_emu.img";
+  char image_lun[256];
+  uint32_t latency = 200, naks = 0, step = 1000, size_mb = 2, chunk = 64;
+  uint64_t t;
+  USBH_EMU_StatsTypeDef st;
+  int opt;
+
+  while((opt = getopt(argc, argv, "f:l:k:c:p:s:b:")) != -1)
+  {
+    switch(opt)
+    {
+    case 'f': image = optarg; break;
+    case 'l': latency = strtoul(optarg, NULL, 0); break;
+    case 'k': naks = strtoul(optarg, NULL, 0); break;
+    case 'c': step = strtoul(optarg, NULL, 0); break;
+    case 'p': Loop_Time = strtoul(optarg, NULL, 0); break;
+    case 's': size_mb = strtoul(optarg, NULL, 0); break;
+    case 'b': chunk = strtoul(optarg, NULL, 0); break;
+    default:
+      printf("usage: %s [-f image] [-l latency_us] [-k naks] [-c step_ns] [-p loop_us] [-s MB] [-b sectors]\n"
+             "  -f  image file of the disk (default usbh_emu.img), deleted at the end;\n"
+             "      the one of the second LUN is its name with .lun1 appended\n"
+             "  -l  media access time of the reads and writes (default 200 us)\n"
+             "  -k  NAKs injected at random, per mille of the transactions (default 0)\n"
+             "  -c  CPU time of a pass through the state machines (default 1000 ns)\n"
+             "  -p  application time between two USBH_Process calls (default 10 us)\n"
+             "  -s  size of the transfers (1 to 32 MB, default 2)\n"
+             "  -b  sectors per USBH_MSC_Read/Write command (1 to 64, default 64)\n", argv[0]);
+      return 1;
+    }
+  }
+  if((size_mb == 0) || (size_mb > 32) || (chunk == 0) || (chunk > CHUNK_SIZE / 512))
+  {
+    printf("Invalid size\n");
+    return 1;
+  }
+
+  unlink(image);
+  if(USBH_EMU_Open(image, DISK_MB * 2048))
+  {
+    printf("Cannot open %s\n", image);
+    return 1;
+  }
+  USBH_EMU_SetTiming(latency, naks);
+  USBH_EMU_SetStepTime(step);
+#if (USBH_USE_OS == 1)
+  printf("USB host emulator, %u MB MSC disk, %lu us latency, %lu per mille NAKs, %lu ns steps, host thread\n",
+         DISK_MB, (unsigned long)latency, (unsigned long)naks, (unsigned long)step);
+  osMessageQDef(Appli_Queue, 4, uint16_t);
+  Appli_Event = osMessageCreate(osMessageQ(Appli_Queue), NULL);
+#else
+  printf("USB host emulator, %u MB MSC disk, %lu us latency, %lu per mille NAKs, %lu ns steps, %lu us loop\n",
+         DISK_MB, (unsigned long)latency, (unsigned long)naks, (unsigned long)step, (unsigned long)Loop_Time);
+#endif
+
+  /* Init Host Library, as the application */
+  USBH_Init(&hUSB_Host, USBH_UserProcess, 0);
+  USBH_RegisterClass(&hUSB_Host, USBH_MSC_CLASS);
+  USBH_EMU_ResetStats();
+  App_Time = 0;
+  t = USBH_EMU_GetTime();
+  USBH_Start(&hUSB_Host);
+  /* No class is active yet, the units are not known */
+  if((uint8_t)USBH_MSC_GetMaxLUN(&hUSB_Host) != 0xFF)
+  {
+    printf("  LUNs seen before the enumeration\n");
+    Errors++;
+  }
+  if(BENCH_WaitState(APPLICATION_READY) == 0)
+  {
+    printf("Enumeration timeout, host state %d\n", hUSB_Host.gState);
+    return 1;
+  }
+  t = USBH_EMU_GetTime() - t;
+  USBH_EMU_GetStats(&st);
+  Errors += st.errors;
+  printf("  enumeration              : %7.1f ms  %7lu LL calls %7lu switches %5lu URBs %6lu SOFs %5.1f %% CPU\n",
+         t / 1000.0, (unsigned long)st.calls, (unsigned long)st.switches, (unsigned long)st.urbs,
+         (unsigned long)st.sofs, BENCH_Cpu(&st, t, App_Time));
+  BENCH_CheckLoop("  main loop");
+
+  BENCH_Raw(size_mb << 20, chunk);
+  BENCH_Stream(size_mb << 20, chunk);
+  BENCH_FatFs(size_mb << 20);
+
+  /* Unplug and plug again, the disk is enumerated again */
+  CHECK_USBH(USBH_MSC_Read(&hUSB_Host, 0, 0, Check, 8));
+  USBH_EMU_Plug(0);
+  if(BENCH_WaitState(APPLICATION_DISCONNECT) == 0)
+  {
+    printf("Disconnection not seen\n");
+    return 1;
+  }
+  USBH_EMU_GetStats(&st);
+  Errors += st.errors;
+  USBH_EMU_Plug(1);
+  USBH_EMU_ResetStats();
+  App_Time = 0;
+  Max_Process = 0;
+  Max_Frames = 0;
+  t = BENCH_WaitState(APPLICATION_READY);
+  if(t == 0)
+  {
+    printf("Enumeration timeout after the plug, host state %d\n", hUSB_Host.gState);
+    return 1;
+  }
+  USBH_EMU_GetStats(&st);
+  Errors += st.errors;
+  printf("  re-enumeration           : %7.1f ms  %7lu LL calls %7lu switches %5lu URBs %6lu SOFs %5.1f %% CPU\n",
+         t / 1000.0, (unsigned long)st.calls, (unsigned long)st.switches, (unsigned long)st.urbs,
+         (unsigned long)st.sofs, BENCH_Cpu(&st, t, App_Time));
+  BENCH_CheckLoop("  main loop");
+  USBH_EMU_ResetStats();
+  CHECK_USBH(USBH_MSC_Read(&hUSB_Host, 0, 0, Buffer, 8));
+  if(memcmp(Buffer, Check, 8 * 512) != 0)
+  {
+    printf("  data mismatch after the plug\n");
+    Errors++;
+  }
+
+  snprintf(image_lun, sizeof(image_lun), "%s.lun1", image);
+  BENCH_Luns(image_lun, size_mb << 20);
+
+  USBH_EMU_GetStats(&st);
+  Errors += st.errors;
+  printf("  protocol errors          : %lu\n", Errors);
+
+  USBH_Stop(&hUSB_Host);
+  USBH_EMU_Close();
+  unlink(image);
+  return (Errors != 0);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
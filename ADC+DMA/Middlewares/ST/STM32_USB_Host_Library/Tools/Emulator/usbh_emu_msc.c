@@ -0,0 +1,971 @@
+/**
+  ******************************************************************************
+  * @file    usbh_emu_msc.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Emulated Bulk-Only Transport mass storage device on an image file,
+  *          for the host emulator of the USB OTG FS controller
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#define _XOPEN_SOURCE 700
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include "usbh_emu.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Stages of the control endpoint */
+typedef enum
+{
+  CTL_IDLE = 0,
+  CTL_DATA_IN,
+  CTL_DATA_OUT,
+  CTL_STATUS_IN,
+  CTL_STATUS_OUT,
+  CTL_STALL,
+}EMU_CtlStageTypeDef;
+
+/* Stages of the Bulk-Only Transport */
+typedef enum
+{
+  BOT_CBW = 0,
+  BOT_DATA_IN,
+  BOT_DATA_OUT,
+  BOT_CSW,
+}EMU_BotStageTypeDef;
+
+/* Source or destination of the data stage */
+typedef enum
+{
+  DATA_BUFFER = 0,
+  DATA_READ,
+  DATA_WRITE,
+}EMU_DataTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+/* Block Size in Bytes */
+#define BLOCK_SIZE                512
+
+/* Logical units the device can report, each with its own image file */
+#define EMU_MAX_LUN               2
+
+/* Max packet size of the control and bulk endpoints, full speed */
+#define EMU_MPS                   64
+
+#define EMU_EP_IN                 0x81
+#define EMU_EP_OUT                0x01
+
+#define EMU_CBW_SIGNATURE         0x43425355
+#define EMU_CSW_SIGNATURE         0x53425355
+
+/* Private macro -------------------------------------------------------------*/
+#define EMU_BE32(p)   (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) | \
+                       ((uint32_t)(p)[2] << 8) | (uint32_t)(p)[3])
+#define EMU_LE32(p)   (((uint32_t)(p)[3] << 24) | ((uint32_t)(p)[2] << 16) | \
+                       ((uint32_t)(p)[1] << 8) | (uint32_t)(p)[0])
+
+/* Private variables ---------------------------------------------------------*/
+USBH_EMU_StatsTypeDef EMU_Stats;
+
+static const uint8_t EMU_DeviceDesc[18] =
+{
+  0x12, 0x01, 0x00, 0x02,       /* bLength, DEVICE, bcdUSB 2.00 */
+  0x00, 0x00, 0x00, EMU_MPS,    /* Class in the interface, bMaxPacketSize0 */
+  0x83, 0x04, 0x20, 0x57,       /* idVendor 0x0483, idProduct 0x5720 */
+  0x00, 0x01, 0x01, 0x02,       /* bcdDevice 1.00, iManufacturer, iProduct */
+  0x03, 0x01,                   /* iSerialNumber, bNumConfigurations */
+};
+
+static const uint8_t EMU_ConfigDesc[32] =
+{
+  0x09, 0x02, 0x20, 0x00,       /* bLength, CONFIGURATION, wTotalLength */
+  0x01, 0x01, 0x00, 0x80, 0x32, /* 1 interface, value 1, bus powered, 100 mA */
+  0x09, 0x04, 0x00, 0x00,       /* bLength, INTERFACE, number 0, alternate 0 */
+  0x02, 0x08, 0x06, 0x50, 0x00, /* 2 endpoints, MSC, SCSI transparent, BOT */
+  0x07, 0x05, EMU_EP_IN, 0x02,  /* Bulk IN */
+  EMU_MPS, 0x00, 0x00,
+  0x07, 0x05, EMU_EP_OUT, 0x02, /* Bulk OUT */
+  EMU_MPS, 0x00, 0x00,
+};
+
+static const char * const EMU_Strings[] =
+{
+  "STMicroelectronics",
+  "USBH Emulator Disk",
+  "000000000001",
+};
+
+static const uint8_t EMU_Inquiry[36] =
+{
+  0x00, 0x80, 0x02, 0x02,       /* Direct access, removable, SPC-2 */
+  31,   0x00, 0x00, 0x00,       /* Additional length */
+  'S', 'T', 'M', ' ', ' ', ' ', ' ', ' ',
+  'U', 'S', 'B', 'H', ' ', 'E', 'm', 'u',
+  'l', 'a', 't', 'o', 'r', ' ', ' ', ' ',
+  '1', '.', '0', '0',
+};
+
+/* Image files, one per logical unit */
+static int      Emu_fd[EMU_MAX_LUN] = { -1, -1 };
+static uint32_t Emu_Sectors[EMU_MAX_LUN];
+static uint8_t  Emu_Luns = 1;             /* Units reported by GET_MAX_LUN */
+static uint32_t Emu_Latency = 0;          /* Media access time, in ns */
+
+/* Device state */
+static uint8_t  Emu_Address;
+static uint8_t  Emu_PendingAddress;
+static uint8_t  Emu_Config;
+
+/* Control endpoint */
+static EMU_CtlStageTypeDef Ctl_Stage;
+static uint8_t  Ctl_Buff[256];
+static uint16_t Ctl_Length;
+static uint16_t Ctl_Pos;
+static uint16_t Ctl_Requested;
+
+/* Bulk endpoints */
+static uint8_t  Bulk_ToggleIn, Bulk_ToggleOut;
+static uint8_t  Bulk_HaltIn, Bulk_HaltOut;
+
+/* Bulk-Only Transport */
+static EMU_BotStageTypeDef Bot_Stage;
+static EMU_DataTypeDef Bot_Data;
+static uint32_t Bot_Tag;
+static uint32_t Bot_Residue;              /* Left of dCBWDataTransferLength */
+static uint32_t Bot_Length;               /* Left of the data of the device */
+static uint8_t  Bot_Status;
+static uint64_t Bot_Ready;                /* The device NAKs until this time */
+static uint8_t  Bot_Buff[BLOCK_SIZE];
+static uint16_t Bot_Pos;
+static uint16_t Bot_BuffLength;
+static uint32_t Bot_Lba;
+static uint8_t  Bot_Lun;                  /* Unit of the current command */
+
+/* SCSI sense data, per unit */
+static uint8_t  Sense_Key[EMU_MAX_LUN], Sense_Asc[EMU_MAX_LUN];
+static uint8_t  Unit_Attention[EMU_MAX_LUN];
+
+/* Private function prototypes -----------------------------------------------*/
+static void EMU_MSC_Command(const uint8_t *cbw, uint64_t now);
+static void EMU_MSC_SetSense(uint8_t key, uint8_t asc);
+static void EMU_MSC_EndData(void);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Opens the image file of the emulated disk, it is created if needed.
+  *         The device has a single logical unit, the one of the file.
+  * @param  path: Path of the image file
+  * @param  sectors: Size of the disk in sectors, the file is resized to it.
+  *         0 to use the size of an existing file.
+  * @retval Returns 0 in case of success, otherwise 1.
+  */
+uint8_t USBH_EMU_Open(const char *path, uint32_t sectors)
+{
+  USBH_EMU_Close();
+  if(USBH_EMU_OpenLun(0, path, sectors) != 0)
+  {
+    return 1;
+  }
+  EMU_MSC_BusReset();
+  return 0;
+}
+
+/**
+  * @brief  Opens the image file of a logical unit, it is created if needed.
+  *         The medium of the unit changes. A unit above the ones the device
+  *         reports is added to them: the host sees it once it enumerates
+  *         the device again.
+  * @param  lun: Logical unit, below EMU_MAX_LUN
+  * @param  path: Path of the image file
+  * @param  sectors: Size of the disk in sectors, the file is resized to it.
+  *         0 to use the size of an existing file.
+  * @retval Returns 0 in case of success, otherwise 1.
+  */
+uint8_t USBH_EMU_OpenLun(uint8_t lun, const char *path, uint32_t sectors)
+{
+  off_t size;
+
+  if(lun >= EMU_MAX_LUN)
+  {
+    return 1;
+  }
+  USBH_EMU_CloseLun(lun);
+  Emu_fd[lun] = open(path, O_RDWR | O_CREAT, 0644);
+  if(Emu_fd[lun] < 0)
+  {
+    return 1;
+  }
+  if(sectors != 0)
+  {
+    /* The image is sparse, only the written sectors take space */
+    if(ftruncate(Emu_fd[lun], (off_t)sectors * BLOCK_SIZE) != 0)
+    {
+      USBH_EMU_CloseLun(lun);
+      return 1;
+    }
+  }
+  else
+  {
+    size = lseek(Emu_fd[lun], 0, SEEK_END);
+    sectors = (size > 0) ? (uint32_t)(size / BLOCK_SIZE) : 0;
+  }
+  Emu_Sectors[lun] = sectors;
+  if(Emu_Luns <= lun)
+  {
+    Emu_Luns = lun + 1;
+  }
+  Unit_Attention[lun] = 1;
+  return 0;
+}
+
+/**
+  * @brief  Writes the image files to the storage and closes them. The device
+  *         returns to a single logical unit.
+  * @param  None
+  * @retval None
+  */
+void USBH_EMU_Close(void)
+{
+  uint8_t lun;
+
+  for(lun = 0; lun < EMU_MAX_LUN; lun++)
+  {
+    USBH_EMU_CloseLun(lun);
+  }
+  Emu_Luns = 1;
+}
+
+/**
+  * @brief  Writes the image file of a logical unit to the storage and closes
+  *         it: the unit stays, without medium. A command running on the unit
+  *         fails.
+  * @param  lun: Logical unit
+  * @retval None
+  */
+void USBH_EMU_CloseLun(uint8_t lun)
+{
+  if(lun >= EMU_MAX_LUN)
+  {
+    return;
+  }
+  if(Emu_fd[lun] >= 0)
+  {
+    fsync(Emu_fd[lun]);
+    close(Emu_fd[lun]);
+    Emu_fd[lun] = -1;
+  }
+  Emu_Sectors[lun] = 0;
+}
+
+/**
+  * @brief  Returns whether an image file is open.
+  * @param  None
+  * @retval 1 if a unit of the device has a medium, otherwise 0
+  */
+uint8_t EMU_MSC_IsOpen(void)
+{
+  uint8_t lun;
+
+  for(lun = 0; lun < EMU_MAX_LUN; lun++)
+  {
+    if(Emu_fd[lun] >= 0)
+    {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+  * @brief  Sets the media access time of the READ(10) and WRITE(10)
+  *         commands: the device NAKs the first data packet of a read, and
+  *         the CSW of a write, during this time.
+  * @param  latency_ns: Access time in ns
+  * @retval None
+  */
+void EMU_MSC_SetLatency(uint32_t latency_ns)
+{
+  Emu_Latency = latency_ns;
+}
+
+/**
+  * @brief  Returns the device to its default state, as after a bus reset.
+  * @param  None
+  * @retval None
+  */
+void EMU_MSC_BusReset(void)
+{
+  uint8_t lun;
+
+  Emu_Address = 0;
+  Emu_PendingAddress = 0;
+  Emu_Config = 0;
+  Ctl_Stage = CTL_IDLE;
+  Bulk_ToggleIn = Bulk_ToggleOut = 0;
+  Bulk_HaltIn = Bulk_HaltOut = 0;
+  Bot_Stage = BOT_CBW;
+  Bot_Ready = 0;
+  /* The first command after a reset reports the medium change */
+  for(lun = 0; lun < EMU_MAX_LUN; lun++)
+  {
+    Unit_Attention[lun] = 1;
+    Sense_Key[lun] = 0;
+    Sense_Asc[lun] = 0;
+  }
+}
+
+/**
+  * @brief  Returns the USB address the device answers to.
+  * @param  None
+  * @retval Address
+  */
+uint8_t EMU_MSC_GetAddress(void)
+{
+  return Emu_Address;
+}
+
+/**
+  * @brief  Handles a SETUP transaction, which is always acknowledged.
+  * @param  setup: The 8 bytes of the request
+  * @retval None
+  */
+void EMU_MSC_Setup(const uint8_t *setup)
+{
+  uint8_t  type = setup[0];
+  uint8_t  request = setup[1];
+  uint16_t value = setup[2] | (setup[3] << 8);
+  uint16_t index = setup[4] | (setup[5] << 8);
+  uint16_t length = setup[6] | (setup[7] << 8);
+  uint16_t size = 0;
+  const char *str;
+  uint8_t  supported = 1;
+
+  Ctl_Requested = length;
+  Ctl_Pos = 0;
+  Ctl_Length = 0;
+
+  switch((type << 8) | request)
+  {
+  case 0x8006: /* GET_DESCRIPTOR */
+    switch(value >> 8)
+    {
+    case 1:
+      size = sizeof(EMU_DeviceDesc);
+      memcpy(Ctl_Buff, EMU_DeviceDesc, size);
+      break;
+
+    case 2:
+      size = sizeof(EMU_ConfigDesc);
+      memcpy(Ctl_Buff, EMU_ConfigDesc, size);
+      break;
+
+    case 3:
+      if((value & 0xFF) == 0)
+      {
+        /* Language ID, US English */
+        size = 4;
+        Ctl_Buff[2] = 0x09;
+        Ctl_Buff[3] = 0x04;
+      }
+      else if((value & 0xFF) <= 3)
+      {
+        /* UTF-16LE of the ASCII string */
+        for(str = EMU_Strings[(value & 0xFF) - 1], size = 2; *str; str++)
+        {
+          Ctl_Buff[size++] = (uint8_t)*str;
+          Ctl_Buff[size++] = 0;
+        }
+      }
+      else
+      {
+        supported = 0;
+      }
+      Ctl_Buff[0] = (uint8_t)size;
+      Ctl_Buff[1] = 0x03;
+      break;
+
+    default:
+      supported = 0;
+      break;
+    }
+    break;
+
+  case 0x8000: /* GET_STATUS */
+  case 0x8100:
+  case 0x8200:
+    size = 2;
+    Ctl_Buff[0] = Ctl_Buff[1] = 0;
+    if((type == 0x82) && (((index == EMU_EP_IN) && Bulk_HaltIn) ||
+                          ((index == EMU_EP_OUT) && Bulk_HaltOut)))
+    {
+      Ctl_Buff[0] = 1;
+    }
+    break;
+
+  case 0x8008: /* GET_CONFIGURATION */
+    size = 1;
+    Ctl_Buff[0] = Emu_Config;
+    break;
+
+  case 0x0005: /* SET_ADDRESS, applied at the end of the status stage */
+    Emu_PendingAddress = value & 0x7F;
+    break;
+
+  case 0x0009: /* SET_CONFIGURATION */
+    Emu_Config = (uint8_t)value;
+    Bulk_ToggleIn = Bulk_ToggleOut = 0;
+    Bulk_HaltIn = Bulk_HaltOut = 0;
+    Bot_Stage = BOT_CBW;
+    break;
+
+  case 0x0201: /* CLEAR_FEATURE (ENDPOINT_HALT) */
+    if(index == EMU_EP_IN)
+    {
+      Bulk_HaltIn = 0;
+      Bulk_ToggleIn = 0;
+    }
+    else if(index == EMU_EP_OUT)
+    {
+      Bulk_HaltOut = 0;
+      Bulk_ToggleOut = 0;
+    }
+    break;
+
+  case 0x010B: /* SET_INTERFACE */
+    break;
+
+  case 0xA1FE: /* GET_MAX_LUN */
+    size = 1;
+    Ctl_Buff[0] = Emu_Luns - 1;
+    break;
+
+  case 0x21FF: /* Bulk-Only Mass Storage Reset */
+    Bot_Stage = BOT_CBW;
+    Bot_Ready = 0;
+    break;
+
+  default:
+    supported = 0;
+    break;
+  }
+
+  if(supported == 0)
+  {
+    Ctl_Stage = CTL_STALL;
+  }
+  else if(length == 0)
+  {
+    Ctl_Stage = CTL_STATUS_IN;
+  }
+  else if(type & 0x80)
+  {
+    Ctl_Length = (size < length) ? size : length;
+    Ctl_Stage = CTL_DATA_IN;
+  }
+  else
+  {
+    Ctl_Stage = CTL_DATA_OUT;
+  }
+}
+
+/**
+  * @brief  Handles an OUT transaction.
+  * @param  ep: Endpoint address
+  * @param  pid: Data toggle of the packet, 0 for DATA0 or 1 for DATA1
+  * @param  buff: Data of the packet
+  * @param  length: Length of the packet, up to the max packet size
+  * @param  now: Emulated time in ns
+  * @retval Handshake of the device
+  */
+EMU_HandshakeTypeDef EMU_MSC_Out(uint8_t ep, uint8_t pid, const uint8_t *buff, uint16_t length, uint64_t now)
+{
+  uint16_t n;
+
+  if((ep & 0x7F) == 0)
+  {
+    switch(Ctl_Stage)
+    {
+    case CTL_DATA_OUT:
+      /* No request of the device takes data, the data is discarded */
+      Ctl_Pos += length;
+      if((Ctl_Pos >= Ctl_Requested) || (length < EMU_MPS))
+      {
+        Ctl_Stage = CTL_STATUS_IN;
+      }
+      return EMU_ACK;
+
+    case CTL_DATA_IN:
+    case CTL_STATUS_OUT:
+      /* Status stage of a read request, possibly before all the data */
+      Ctl_Stage = CTL_IDLE;
+      return EMU_ACK;
+
+    default:
+      EMU_Stats.errors++;
+      return EMU_STALL;
+    }
+  }
+
+  if((ep != EMU_EP_OUT) || (Emu_Config == 0))
+  {
+    EMU_Stats.errors++;
+    return EMU_STALL;
+  }
+  if(Bulk_HaltOut)
+  {
+    return EMU_STALL;
+  }
+  if(pid != Bulk_ToggleOut)
+  {
+    /* Retry of a packet already received: acknowledged and ignored */
+    EMU_Stats.errors++;
+    return EMU_ACK;
+  }
+
+  switch(Bot_Stage)
+  {
+  case BOT_CBW:
+    Bulk_ToggleOut ^= 1;
+    if((length != 31) || (EMU_LE32(buff) != EMU_CBW_SIGNATURE))
+    {
+      /* Invalid CBW: both endpoints stall until a reset recovery */
+      EMU_Stats.errors++;
+      Bulk_HaltIn = Bulk_HaltOut = 1;
+      return EMU_ACK;
+    }
+    EMU_MSC_Command(buff, now);
+    return EMU_ACK;
+
+  case BOT_DATA_OUT:
+    if(now < Bot_Ready)
+    {
+      return EMU_NAK;
+    }
+    Bulk_ToggleOut ^= 1;
+    if(length > Bot_Residue)
+    {
+      EMU_Stats.errors++;
+      length = (uint16_t)Bot_Residue;
+    }
+    Bot_Residue -= length;
+    while((length > 0) && (Bot_Length > 0))
+    {
+      n = BLOCK_SIZE - Bot_Pos;
+      if(n > length)
+      {
+        n = length;
+      }
+      memcpy(&Bot_Buff[Bot_Pos], buff, n);
+      buff += n;
+      length -= n;
+      Bot_Pos += n;
+      Bot_Length -= n;
+      if((Bot_Pos == BLOCK_SIZE) && (Bot_Data == DATA_WRITE))
+      {
+        if(pwrite(Emu_fd[Bot_Lun], Bot_Buff, BLOCK_SIZE, (off_t)Bot_Lba * BLOCK_SIZE) != BLOCK_SIZE)
+        {
+          EMU_MSC_SetSense(0x03, 0x0C);     /* MEDIUM ERROR, WRITE ERROR */
+          Bot_Status = 1;
+        }
+        EMU_Stats.sectors_written++;
+        Bot_Lba++;
+        Bot_Pos = 0;
+      }
+    }
+    if(Bot_Residue == 0)
+    {
+      Bot_Stage = BOT_CSW;
+      if(Bot_Data == DATA_WRITE)
+      {
+        Bot_Ready = now + Emu_Latency;
+      }
+    }
+    else if(Bot_Length == 0)
+    {
+      /* The host sends more data than the command takes */
+      Bulk_HaltOut = 1;
+      Bot_Stage = BOT_CSW;
+    }
+    return EMU_ACK;
+
+  default:
+    /* The host sends data while the device expects to send */
+    EMU_Stats.errors++;
+    return EMU_NAK;
+  }
+}
+
+/**
+  * @brief  Handles an IN transaction.
+  * @param  ep: Endpoint address
+  * @param  pid: Data toggle of the packet sent
+  * @param  buff: Receives the data of the packet, max packet size bytes
+  * @param  length: Receives the length of the packet
+  * @param  now: Emulated time in ns
+  * @retval Handshake of the device
+  */
+EMU_HandshakeTypeDef EMU_MSC_In(uint8_t ep, uint8_t *pid, uint8_t *buff, uint16_t *length, uint64_t now)
+{
+  uint16_t n, m;
+  uint8_t  *p;
+
+  *length = 0;
+  *pid = 1;
+  if((ep & 0x7F) == 0)
+  {
+    switch(Ctl_Stage)
+    {
+    case CTL_DATA_IN:
+      n = Ctl_Length - Ctl_Pos;
+      if(n > EMU_MPS)
+      {
+        n = EMU_MPS;
+      }
+      memcpy(buff, &Ctl_Buff[Ctl_Pos], n);
+      Ctl_Pos += n;
+      *length = n;
+      /* Ends with a short packet, or when the requested length is sent */
+      if((n < EMU_MPS) || (Ctl_Pos >= Ctl_Requested))
+      {
+        Ctl_Stage = CTL_STATUS_OUT;
+      }
+      return EMU_ACK;
+
+    case CTL_STATUS_IN:
+      Ctl_Stage = CTL_IDLE;
+      Emu_Address = Emu_PendingAddress;
+      return EMU_ACK;
+
+    case CTL_STATUS_OUT:
+      /* Data IN after the end of the data: the host keeps getting NAKs */
+      return EMU_NAK;
+
+    default:
+      return EMU_STALL;
+    }
+  }
+
+  if((ep != EMU_EP_IN) || (Emu_Config == 0))
+  {
+    EMU_Stats.errors++;
+    return EMU_STALL;
+  }
+  if(Bulk_HaltIn)
+  {
+    return EMU_STALL;
+  }
+  if(now < Bot_Ready)
+  {
+    return EMU_NAK;
+  }
+
+  switch(Bot_Stage)
+  {
+  case BOT_DATA_IN:
+    n = EMU_MPS;
+    if(n > Bot_Length)
+    {
+      n = (uint16_t)Bot_Length;
+    }
+    for(p = buff, m = n; m > 0; )
+    {
+      if(Bot_Pos == Bot_BuffLength)
+      {
+        /* Next sector of a READ(10) */
+        if(pread(Emu_fd[Bot_Lun], Bot_Buff, BLOCK_SIZE, (off_t)Bot_Lba * BLOCK_SIZE) != BLOCK_SIZE)
+        {
+          memset(Bot_Buff, 0, BLOCK_SIZE);
+        }
+        EMU_Stats.sectors_read++;
+        Bot_Lba++;
+        Bot_Pos = 0;
+        Bot_BuffLength = BLOCK_SIZE;
+      }
+      n = Bot_BuffLength - Bot_Pos;
+      if(n > m)
+      {
+        n = m;
+      }
+      memcpy(p, &Bot_Buff[Bot_Pos], n);
+      Bot_Pos += n;
+      p += n;
+      m -= n;
+    }
+    n = (uint16_t)(p - buff);
+    Bot_Length -= n;
+    Bot_Residue -= n;
+    *length = n;
+    *pid = Bulk_ToggleIn;
+    Bulk_ToggleIn ^= 1;
+    if(Bot_Length == 0)
+    {
+      EMU_MSC_EndData();
+    }
+    return EMU_ACK;
+
+  case BOT_CSW:
+    buff[0] = EMU_CSW_SIGNATURE & 0xFF;
+    buff[1] = (EMU_CSW_SIGNATURE >> 8) & 0xFF;
+    buff[2] = (EMU_CSW_SIGNATURE >> 16) & 0xFF;
+    buff[3] = (EMU_CSW_SIGNATURE >> 24) & 0xFF;
+    memcpy(&buff[4], &Bot_Tag, 4);
+    buff[8] = Bot_Residue & 0xFF;
+    buff[9] = (Bot_Residue >> 8) & 0xFF;
+    buff[10] = (Bot_Residue >> 16) & 0xFF;
+    buff[11] = (Bot_Residue >> 24) & 0xFF;
+    buff[12] = Bot_Status;
+    *length = 13;
+    *pid = Bulk_ToggleIn;
+    Bulk_ToggleIn ^= 1;
+    Bot_Stage = BOT_CBW;
+    return EMU_ACK;
+
+  default:
+    /* The host expects data while the device has nothing to send */
+    EMU_Stats.errors++;
+    return EMU_NAK;
+  }
+}
+
+/**
+  * @brief  Decodes a CBW and prepares the data stage and the CSW.
+  * @param  cbw: The 31 bytes of the CBW
+  * @param  now: Emulated time in ns
+  * @retval None
+  */
+static void EMU_MSC_Command(const uint8_t *cbw, uint64_t now)
+{
+  const uint8_t *cb = &cbw[15];
+  uint32_t lba, blocks;
+  uint8_t  dir_in = (cbw[12] & 0x80) != 0;
+  uint8_t  device_in = 1;
+  uint32_t alloc;
+  uint8_t  unit;
+
+  memcpy(&Bot_Tag, &cbw[4], 4);
+  Bot_Residue = EMU_LE32(&cbw[8]);
+  Bot_Status = 0;
+  Bot_Length = 0;
+  Bot_Data = DATA_BUFFER;
+  Bot_Pos = 0;
+  Bot_BuffLength = 0;
+  Bot_Lun = cbw[13] & 0x0F;
+  unit = (Bot_Lun < Emu_Luns);
+  EMU_Stats.commands++;
+  if((cb[0] != 0x28) && (cb[0] != 0x2A))
+  {
+    EMU_Stats.status_commands++;
+  }
+
+  if(!unit && (cb[0] != 0x12) && (cb[0] != 0x03))
+  {
+    /* No unit at this LUN: only INQUIRY and REQUEST SENSE answer */
+    Bot_Status = 1;
+  }
+  else if(unit && (Emu_fd[Bot_Lun] < 0) && (cb[0] != 0x12) && (cb[0] != 0x03))
+  {
+    EMU_MSC_SetSense(0x02, 0x3A);           /* NOT READY, MEDIUM NOT PRESENT */
+    Bot_Status = 1;
+  }
+  else if(unit && Unit_Attention[Bot_Lun] && (cb[0] != 0x12) && (cb[0] != 0x03))
+  {
+    EMU_MSC_SetSense(0x06, 0x28);           /* UNIT ATTENTION, MEDIUM CHANGED */
+    Unit_Attention[Bot_Lun] = 0;
+    Bot_Status = 1;
+  }
+  else
+  {
+    switch(cb[0])
+    {
+    case 0x00: /* TEST UNIT READY */
+      break;
+
+    case 0x03: /* REQUEST SENSE, fixed format */
+      memset(Bot_Buff, 0, 18);
+      Bot_Buff[0] = 0x70;
+      Bot_Buff[7] = 10;
+      if(unit)
+      {
+        Bot_Buff[2] = Sense_Key[Bot_Lun];
+        Bot_Buff[12] = Sense_Asc[Bot_Lun];
+      }
+      else
+      {
+        Bot_Buff[2] = 0x05;                 /* ILLEGAL REQUEST */
+        Bot_Buff[12] = 0x25;                /* LOGICAL UNIT NOT SUPPORTED */
+      }
+      alloc = cb[4];
+      Bot_Length = (alloc < 18) ? alloc : 18;
+      EMU_MSC_SetSense(0, 0);
+      break;
+
+    case 0x12: /* INQUIRY */
+      memcpy(Bot_Buff, EMU_Inquiry, sizeof(EMU_Inquiry));
+      if(!unit)
+      {
+        Bot_Buff[0] = 0x7F;                 /* No device at this LUN */
+      }
+      alloc = (cb[3] << 8) | cb[4];
+      Bot_Length = (alloc < sizeof(EMU_Inquiry)) ? alloc : sizeof(EMU_Inquiry);
+      break;
+
+    case 0x1A: /* MODE SENSE(6), header only, not write protected */
+      memset(Bot_Buff, 0, 4);
+      Bot_Buff[0] = 3;
+      alloc = cb[4];
+      Bot_Length = (alloc < 4) ? alloc : 4;
+      break;
+
+    case 0x1E: /* PREVENT ALLOW MEDIUM REMOVAL */
+      break;
+
+    case 0x25: /* READ CAPACITY(10) */
+      lba = Emu_Sectors[Bot_Lun] - 1;
+      Bot_Buff[0] = lba >> 24;
+      Bot_Buff[1] = lba >> 16;
+      Bot_Buff[2] = lba >> 8;
+      Bot_Buff[3] = lba;
+      Bot_Buff[4] = 0;
+      Bot_Buff[5] = 0;
+      Bot_Buff[6] = BLOCK_SIZE >> 8;
+      Bot_Buff[7] = BLOCK_SIZE & 0xFF;
+      Bot_Length = 8;
+      break;
+
+    case 0x28: /* READ(10) */
+    case 0x2A: /* WRITE(10) */
+      lba = EMU_BE32(&cb[2]);
+      blocks = (cb[7] << 8) | cb[8];
+      if(((uint64_t)lba + blocks) > Emu_Sectors[Bot_Lun])
+      {
+        EMU_MSC_SetSense(0x05, 0x21);       /* ILLEGAL REQUEST, LBA OUT OF RANGE */
+        Bot_Status = 1;
+        break;
+      }
+      if(Bot_Residue != blocks * BLOCK_SIZE)
+      {
+        /* Cases (4), (5), (9), (11) and (13) of the BOT specification */
+        Bot_Status = 2;
+        break;
+      }
+      Bot_Lba = lba;
+      Bot_Length = blocks * BLOCK_SIZE;
+      Bot_Ready = now + Emu_Latency;
+      if(cb[0] == 0x28)
+      {
+        Bot_Data = DATA_READ;
+      }
+      else
+      {
+        Bot_Data = DATA_WRITE;
+        device_in = 0;
+        /* The access time is taken before the CSW */
+        Bot_Ready = 0;
+      }
+      break;
+
+    default:
+      EMU_MSC_SetSense(0x05, 0x20);         /* ILLEGAL REQUEST, INVALID COMMAND */
+      Bot_Status = 1;
+      break;
+    }
+  }
+
+  if(Bot_Data == DATA_BUFFER)
+  {
+    /* Response of the command in Bot_Buff */
+    Bot_BuffLength = (uint16_t)Bot_Length;
+  }
+  if(Bot_Length > Bot_Residue)
+  {
+    /* Device intends to transfer more than the host expects */
+    Bot_Length = Bot_Residue;
+    Bot_Status = 2;
+  }
+  if((Bot_Length != 0) && (dir_in != device_in))
+  {
+    /* Direction mismatch: the data stage of the host is stalled */
+    Bot_Length = 0;
+    Bot_Status = 2;
+  }
+
+  if(Bot_Residue == 0)
+  {
+    Bot_Stage = BOT_CSW;
+  }
+  else if(dir_in)
+  {
+    Bot_Stage = BOT_DATA_IN;
+    if(Bot_Length == 0)
+    {
+      EMU_MSC_EndData();
+    }
+  }
+  else
+  {
+    Bot_Stage = BOT_DATA_OUT;
+    if(Bot_Length == 0)
+    {
+      Bulk_HaltOut = 1;
+      Bot_Stage = BOT_CSW;
+    }
+  }
+  if(Bot_Status == 2)
+  {
+    EMU_Stats.errors++;
+  }
+}
+
+/**
+  * @brief  Ends the data IN stage, the IN endpoint stalls if the host
+  *         expects more data.
+  * @param  None
+  * @retval None
+  */
+static void EMU_MSC_EndData(void)
+{
+  if(Bot_Residue != 0)
+  {
+    Bulk_HaltIn = 1;
+  }
+  Bot_Stage = BOT_CSW;
+}
+
+/**
+  * @brief  Sets the sense data reported by the next REQUEST SENSE of the unit
+  *         of the current command.
+  * @param  key: Sense key
+  * @param  asc: Additional sense code
+  * @retval None
+  */
+static void EMU_MSC_SetSense(uint8_t key, uint8_t asc)
+{
+  if(Bot_Lun < Emu_Luns)
+  {
+    Sense_Key[Bot_Lun] = key;
+    Sense_Asc[Bot_Lun] = asc;
+  }
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,454 @@
+/**
+  ******************************************************************************
+  * @file    usbh_emu_os.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Cooperative scheduler of the host emulator, running the threads,
+  *          message queues and semaphores of the USB Host Library built with
+  *          USBH_USE_OS on the emulated clock
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <ucontext.h>
+#include "cmsis_os.h"
+#include "usbh_emu.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Thread, the main() of the program is the first one */
+struct os_thread_cb
+{
+  ucontext_t  ctx;
+  os_pthread  pthread;
+  const void  *argument;
+  osPriority  priority;
+  uint8_t     ready;
+  void        *wait_obj;    /* Queue or semaphore waited for */
+  uint64_t    wake;         /* End of the wait in us, UINT64_MAX for ever */
+};
+
+struct os_messageQ_cb
+{
+  uint32_t    *items;
+  uint32_t    size;
+  uint32_t    head;
+  uint32_t    count;
+};
+
+struct os_semaphore_cb
+{
+  int32_t     count;
+  int32_t     max;
+};
+
+/* Private define ------------------------------------------------------------*/
+#define OS_THREADS            8
+#define OS_STACK_SIZE         (256 * 1024)  /* Host stack of a thread */
+
+/* Longest time with every thread blocked for ever before the deadlock is
+   reported, in us */
+#define OS_DEADLOCK_US        60000000ULL
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static struct os_thread_cb Os_Thread[OS_THREADS] =
+{
+  { .priority = osPriorityNormal, .ready = 1, .wake = UINT64_MAX },
+};
+static uint32_t Os_Threads = 1;
+static struct os_thread_cb *Os_Current = &Os_Thread[0];
+
+/* Private function prototypes -----------------------------------------------*/
+static void OS_Entry(void);
+static void OS_SwitchTo(struct os_thread_cb *thread);
+static struct os_thread_cb *OS_Highest(void);
+static void OS_Schedule(void);
+static void OS_Block(void *obj, uint32_t millisec, uint64_t start);
+static void OS_Unblock(void *obj);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Entry of the threads created by osThreadCreate.
+  * @param  None
+  * @retval None
+  */
+static void OS_Entry(void)
+{
+  Os_Current->pthread(Os_Current->argument);
+  printf("Thread function returned\n");
+  exit(1);
+}
+
+/**
+  * @brief  Switches to a thread, with the CPU time of a context switch.
+  * @param  thread: Thread to run
+  * @retval None
+  */
+static void OS_SwitchTo(struct os_thread_cb *thread)
+{
+  struct os_thread_cb *prev = Os_Current;
+
+  if(thread == prev)
+  {
+    return;
+  }
+  EMU_Switch();
+  Os_Current = thread;
+  swapcontext(&prev->ctx, &thread->ctx);
+}
+
+/**
+  * @brief  Returns the ready thread of highest priority, the current one
+  *         first among those of the same priority.
+  * @param  None
+  * @retval Thread, NULL if none is ready
+  */
+static struct os_thread_cb *OS_Highest(void)
+{
+  struct os_thread_cb *best = Os_Current->ready ? Os_Current : NULL;
+  uint32_t i;
+
+  for(i = 0; i < Os_Threads; i++)
+  {
+    if(Os_Thread[i].ready && ((best == NULL) || (Os_Thread[i].priority > best->priority)))
+    {
+      best = &Os_Thread[i];
+    }
+  }
+  return best;
+}
+
+/**
+  * @brief  Runs the ready thread of highest priority. With no thread ready,
+  *         the emulated time runs idle up to the first timeout or to the
+  *         interrupt that readies a thread.
+  * @param  None
+  * @retval None
+  */
+static void OS_Schedule(void)
+{
+  struct os_thread_cb *next;
+  uint64_t until, now;
+  uint32_t i;
+  uint8_t idle = 0;
+
+  while((next = OS_Highest()) == NULL)
+  {
+    idle = 1;
+    now = USBH_EMU_GetTime();
+    until = now + OS_DEADLOCK_US;
+    for(i = 0; i < Os_Threads; i++)
+    {
+      if(Os_Thread[i].wake < until)
+      {
+        until = Os_Thread[i].wake;
+      }
+    }
+    EMU_Idle(until);
+
+    now = USBH_EMU_GetTime();
+    for(i = 0; i < Os_Threads; i++)
+    {
+      if(!Os_Thread[i].ready && (Os_Thread[i].wake <= now))
+      {
+        Os_Thread[i].ready = 1;
+      }
+    }
+    if((OS_Highest() == NULL) && (now >= until))
+    {
+      printf("Deadlock: every thread waits for ever\n");
+      exit(1);
+    }
+  }
+  if((next == Os_Current) && idle)
+  {
+    /* Switch from the idle task */
+    EMU_Switch();
+  }
+  OS_SwitchTo(next);
+}
+
+/**
+  * @brief  Blocks the current thread on an object, up to a timeout.
+  * @param  obj: Queue or semaphore, NULL for a delay
+  * @param  millisec: Timeout in ms, osWaitForever for none
+  * @param  start: Start of the wait in us
+  * @retval None
+  */
+static void OS_Block(void *obj, uint32_t millisec, uint64_t start)
+{
+  Os_Current->wait_obj = obj;
+  Os_Current->wake = (millisec == osWaitForever) ? UINT64_MAX : start + (uint64_t)millisec * 1000;
+  Os_Current->ready = 0;
+  OS_Schedule();
+  Os_Current->wait_obj = NULL;
+  Os_Current->wake = UINT64_MAX;
+}
+
+/**
+  * @brief  Readies the threads blocked on an object. Out of an interrupt,
+  *         a thread of higher priority runs at once.
+  * @param  obj: Queue or semaphore
+  * @retval None
+  */
+static void OS_Unblock(void *obj)
+{
+  uint32_t i;
+
+  for(i = 0; i < Os_Threads; i++)
+  {
+    if(!Os_Thread[i].ready && (Os_Thread[i].wait_obj == obj))
+    {
+      Os_Thread[i].ready = 1;
+      EMU_Wake();
+    }
+  }
+  EMU_OS_Preempt();
+}
+
+/**
+  * @brief  Runs a thread of higher priority readied by an interrupt, at the
+  *         end of the handler as the PendSV of the port.
+  * @param  None
+  * @retval None
+  */
+void EMU_OS_Preempt(void)
+{
+  struct os_thread_cb *next;
+
+  if(EMU_InInterrupt())
+  {
+    return;
+  }
+  next = OS_Highest();
+  if((next != NULL) && (next->priority > Os_Current->priority))
+  {
+    OS_SwitchTo(next);
+  }
+}
+
+/*******************************************************************************
+                       CMSIS-RTOS functions
+*******************************************************************************/
+/**
+  * @brief  Creates a thread, ready to run.
+  * @param  thread_def: Thread definition
+  * @param  argument: Argument of the thread function
+  * @retval Thread ID, NULL on error
+  */
+osThreadId osThreadCreate(osThreadDef_t *thread_def, void *argument)
+{
+  struct os_thread_cb *thread;
+
+  if(Os_Threads >= OS_THREADS)
+  {
+    return NULL;
+  }
+  thread = &Os_Thread[Os_Threads];
+  getcontext(&thread->ctx);
+  thread->ctx.uc_stack.ss_sp = malloc(OS_STACK_SIZE);
+  thread->ctx.uc_stack.ss_size = OS_STACK_SIZE;
+  thread->ctx.uc_link = NULL;
+  if(thread->ctx.uc_stack.ss_sp == NULL)
+  {
+    return NULL;
+  }
+  makecontext(&thread->ctx, OS_Entry, 0);
+  thread->pthread = thread_def->pthread;
+  thread->argument = argument;
+  thread->priority = thread_def->tpriority;
+  thread->wait_obj = NULL;
+  thread->wake = UINT64_MAX;
+  thread->ready = 1;
+  Os_Threads++;
+
+  EMU_OS_Preempt();
+  return thread;
+}
+
+/**
+  * @brief  Returns the current thread.
+  * @param  None
+  * @retval Thread ID
+  */
+osThreadId osThreadGetId(void)
+{
+  return Os_Current;
+}
+
+/**
+  * @brief  Blocks the current thread for a time.
+  * @param  millisec: Time in ms
+  * @retval osOK
+  */
+osStatus osDelay(uint32_t millisec)
+{
+  uint64_t start = USBH_EMU_GetTime();
+
+  while(USBH_EMU_GetTime() - start < (uint64_t)millisec * 1000)
+  {
+    OS_Block(NULL, millisec, start);
+  }
+  return osOK;
+}
+
+/**
+  * @brief  Creates a semaphore.
+  * @param  semaphore_def: Semaphore definition
+  * @param  count: Available tokens, also the maximum
+  * @retval Semaphore ID, NULL on error
+  */
+osSemaphoreId osSemaphoreCreate(osSemaphoreDef_t *semaphore_def, int32_t count)
+{
+  osSemaphoreId sem = malloc(sizeof(struct os_semaphore_cb));
+
+  if(sem != NULL)
+  {
+    sem->count = count;
+    sem->max = count;
+  }
+  return sem;
+}
+
+/**
+  * @brief  Takes a token of a semaphore.
+  * @param  semaphore_id: Semaphore ID
+  * @param  millisec: Timeout in ms
+  * @retval osOK, osErrorOS on timeout
+  */
+int32_t osSemaphoreWait(osSemaphoreId semaphore_id, uint32_t millisec)
+{
+  uint64_t start = USBH_EMU_GetTime();
+
+  while(semaphore_id->count == 0)
+  {
+    if((millisec != osWaitForever) &&
+       (USBH_EMU_GetTime() - start >= (uint64_t)millisec * 1000))
+    {
+      return osErrorOS;
+    }
+    OS_Block(semaphore_id, millisec, start);
+  }
+  semaphore_id->count--;
+  return osOK;
+}
+
+/**
+  * @brief  Gives back a token of a semaphore.
+  * @param  semaphore_id: Semaphore ID
+  * @retval osOK, osErrorOS if all the tokens are available
+  */
+osStatus osSemaphoreRelease(osSemaphoreId semaphore_id)
+{
+  if(semaphore_id->count >= semaphore_id->max)
+  {
+    return osErrorOS;
+  }
+  semaphore_id->count++;
+  OS_Unblock(semaphore_id);
+  return osOK;
+}
+
+/**
+  * @brief  Deletes a semaphore.
+  * @param  semaphore_id: Semaphore ID
+  * @retval osOK
+  */
+osStatus osSemaphoreDelete(osSemaphoreId semaphore_id)
+{
+  free(semaphore_id);
+  return osOK;
+}
+
+/**
+  * @brief  Creates a message queue.
+  * @param  queue_def: Queue definition
+  * @param  thread_id: Not used
+  * @retval Queue ID, NULL on error
+  */
+osMessageQId osMessageCreate(osMessageQDef_t *queue_def, osThreadId thread_id)
+{
+  osMessageQId q = malloc(sizeof(struct os_messageQ_cb));
+
+  if(q != NULL)
+  {
+    q->items = malloc(queue_def->queue_sz * sizeof(uint32_t));
+    q->size = queue_def->queue_sz;
+    q->head = 0;
+    q->count = 0;
+  }
+  return q;
+}
+
+/**
+  * @brief  Puts a message in a queue, from a thread or an interrupt.
+  * @param  queue_id: Queue ID
+  * @param  info: Message
+  * @param  millisec: Not used, a full queue drops the message
+  * @retval osOK, osErrorOS if the queue is full
+  */
+osStatus osMessagePut(osMessageQId queue_id, uint32_t info, uint32_t millisec)
+{
+  if(queue_id->count >= queue_id->size)
+  {
+    return osErrorOS;
+  }
+  queue_id->items[(queue_id->head + queue_id->count) % queue_id->size] = info;
+  queue_id->count++;
+  OS_Unblock(queue_id);
+  return osOK;
+}
+
+/**
+  * @brief  Gets a message from a queue.
+  * @param  queue_id: Queue ID
+  * @param  millisec: Timeout in ms
+  * @retval Event with the message, or the osEventTimeout status
+  */
+osEvent osMessageGet(osMessageQId queue_id, uint32_t millisec)
+{
+  uint64_t start = USBH_EMU_GetTime();
+  osEvent event;
+
+  event.def.message_id = queue_id;
+  event.value.v = 0;
+  while(queue_id->count == 0)
+  {
+    if((millisec != osWaitForever) &&
+       (USBH_EMU_GetTime() - start >= (uint64_t)millisec * 1000))
+    {
+      event.status = (millisec == 0) ? osOK : osEventTimeout;
+      return event;
+    }
+    OS_Block(queue_id, millisec, start);
+  }
+  event.value.v = queue_id->items[queue_id->head];
+  queue_id->head = (queue_id->head + 1) % queue_id->size;
+  queue_id->count--;
+  event.status = osEventMessage;
+  return event;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
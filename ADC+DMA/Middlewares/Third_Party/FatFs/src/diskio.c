@@ -48,7 +48,9 @@ extern Disk_drvTypeDef  disk;
 /* Private functions ---------------------------------------------------------*/
 
 /**
-  * @brief  Initializes a Drive
+  * @brief  Initializes a Drive. FatFs calls it to mount the volume, when
+  *         disk_status reports it not initialized: the driver is initialized
+  *         again if it reports so too, a removed medium for instance.
   * @param  pdrv: Physical drive number (0..)
   * @retval DSTATUS: Operation status
   */
@@ -56,10 +58,15 @@ DSTATUS disk_initialize(BYTE pdrv)
 {
   DSTATUS stat = RES_OK;
   
-  if(disk.is_initialized[pdrv] == 0)
+  if((disk.is_initialized[pdrv] == 0) ||
+     (disk.drv[pdrv]->disk_status(disk.lun[pdrv]) & STA_NOINIT))
   { 
+#if _DISK_ASYNC > 0
+    /* The error of a queued write belongs to the previous mount */
+    FATFS_AsyncFlush(pdrv);
+#endif /* _DISK_ASYNC > 0 */
     disk.is_initialized[pdrv] = 1;
-    stat = disk.drv[pdrv]->disk_initialize();
+    stat = disk.drv[pdrv]->disk_initialize(disk.lun[pdrv]);
   }
   return stat;
 }
@@ -73,7 +80,7 @@ DSTATUS disk_status(BYTE pdrv)
 {
   DSTATUS stat;
   
-  stat = disk.drv[pdrv]->disk_status();
+  stat = disk.drv[pdrv]->disk_status(disk.lun[pdrv]);
   return stat;
 }
 
@@ -89,7 +96,10 @@ DRESULT disk_read(BYTE pdrv, BYTE *buff, DWORD sector, BYTE count)
 {
   DRESULT res;
  
-  res = disk.drv[pdrv]->disk_read(buff, sector, count);
+#if _DISK_ASYNC > 0
+  FATFS_AsyncWait(pdrv, sector, count);
+#endif /* _DISK_ASYNC > 0 */
+  res = disk.drv[pdrv]->disk_read(disk.lun[pdrv], buff, sector, count);
   return res;
 }
 
@@ -106,11 +116,74 @@ DRESULT disk_write(BYTE pdrv, const BYTE *buff, DWORD sector, BYTE count)
 {
   DRESULT res;
   
-  res = disk.drv[pdrv]->disk_write(buff, sector, count);
+#if _DISK_ASYNC > 0
+  if(disk.drv[pdrv]->disk_write_start != NULL)
+  {
+    if(count <= _DISK_ASYNC_SECTORS)
+    {
+      return FATFS_AsyncWrite(pdrv, NULL, buff, sector, count, NULL);
+    }
+    /* Too large to be queued, write it in place after the queued ones */
+    res = FATFS_AsyncFlush(pdrv);
+    if(res != RES_OK)
+    {
+      return res;
+    }
+  }
+  /* The driver may still be busy with a queued write of another unit */
+  FATFS_AsyncWait(pdrv, sector, count);
+#endif /* _DISK_ASYNC > 0 */
+  res = disk.drv[pdrv]->disk_write(disk.lun[pdrv], buff, sector, count);
   return res;
 }
 #endif /* _USE_WRITE == 1 */
 
+/**
+  * @brief  Writes a sector and the following Sector(s) in one transfer
+  * @param  pdrv: Physical drive number (0..)
+  * @param  *head: Data of the first sector
+  * @param  *buff: Data of the following sectors
+  * @param  sector: Sector address (LBA)
+  * @param  count: Number of sectors to write, the first one included (2..128)
+  * @retval DRESULT: Operation result
+  */
+#if _USE_WRITEV == 1
+DRESULT disk_writev(BYTE pdrv, const BYTE *head, const BYTE *buff, DWORD sector, BYTE count)
+{
+  DRESULT res;
+  
+#if _DISK_ASYNC > 0
+  if(disk.drv[pdrv]->disk_write_start != NULL)
+  {
+    if(count <= _DISK_ASYNC_SECTORS)
+    {
+      return FATFS_AsyncWrite(pdrv, head, buff, sector, count, NULL);
+    }
+    res = FATFS_AsyncFlush(pdrv);
+    if(res != RES_OK)
+    {
+      return res;
+    }
+  }
+  FATFS_AsyncWait(pdrv, sector, count);
+#endif /* _DISK_ASYNC > 0 */
+  if(disk.drv[pdrv]->disk_writev != NULL)
+  {
+    res = disk.drv[pdrv]->disk_writev(disk.lun[pdrv], head, buff, sector, count);
+  }
+  else
+  {
+    /* The driver cannot gather, write the first sector on its own */
+    res = disk.drv[pdrv]->disk_write(disk.lun[pdrv], head, sector, 1);
+    if(res == RES_OK)
+    {
+      res = disk.drv[pdrv]->disk_write(disk.lun[pdrv], buff, sector + 1, count - 1);
+    }
+  }
+  return res;
+}
+#endif /* _USE_WRITEV == 1 */
+
 /**
   * @brief  I/O control operation  
   * @param  pdrv: Physical drive number (0..)
@@ -123,7 +196,19 @@ DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void *buff)
 {
   DRESULT res;
 
-  res = disk.drv[pdrv]->disk_ioctl(cmd, buff);
+#if _DISK_ASYNC > 0
+  if(cmd == CTRL_SYNC)
+  {
+    /* Flush barrier: all the queued writes reach the drive first */
+    res = FATFS_AsyncFlush(pdrv);
+    if(res != RES_OK)
+    {
+      return res;
+    }
+  }
+  FATFS_AsyncWait(pdrv, 0, 0);
+#endif /* _DISK_ASYNC > 0 */
+  res = disk.drv[pdrv]->disk_ioctl(disk.lun[pdrv], cmd, buff);
   return res;
 }
 #endif /* _USE_IOCTL == 1 */
@@ -0,0 +1,306 @@
+/**
+  ******************************************************************************
+  * @file    filedisk_diskio.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   POSIX image file Disk I/O driver, for host tests
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software 
+  * distributed under the License is distributed on an "AS IS" BASIS, 
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#define _XOPEN_SOURCE 700
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include "ff_gen_drv.h"
+#include "filedisk_diskio.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Block Size in Bytes */
+#define BLOCK_SIZE                512
+
+/* Private variables ---------------------------------------------------------*/
+/* Disk status */
+static volatile DSTATUS Stat = STA_NOINIT;
+
+static int      FileDisk_fd = -1;
+static DWORD    FileDisk_Sectors = 0;
+
+/* Injected timing of the commands */
+static uint32_t FileDisk_Latency = 0;     /* Per command, in us */
+static uint32_t FileDisk_Bandwidth = 0;   /* In kB/s, 0 for no limit */
+static struct timespec FileDisk_Busy;     /* End of the last command */
+
+/* Private function prototypes -----------------------------------------------*/
+DSTATUS FILEDISK_initialize (BYTE);
+DSTATUS FILEDISK_status (BYTE);
+DRESULT FILEDISK_read (BYTE, BYTE*, DWORD, BYTE);
+#if _USE_WRITE == 1
+  DRESULT FILEDISK_write (BYTE, const BYTE*, DWORD, BYTE);
+#endif /* _USE_WRITE == 1 */
+#if _USE_IOCTL == 1
+  DRESULT FILEDISK_ioctl (BYTE, BYTE, void*);
+#endif /* _USE_IOCTL == 1 */
+
+static void FILEDISK_Delay (uint32_t bytes);
+  
+Diskio_drvTypeDef  FILEDISK_Driver =
+{
+  FILEDISK_initialize,
+  FILEDISK_status,
+  FILEDISK_read, 
+#if  _USE_WRITE == 1
+  FILEDISK_write,
+#endif /* _USE_WRITE == 1 */  
+#if  _USE_IOCTL == 1
+  FILEDISK_ioctl,
+#endif /* _USE_IOCTL == 1 */
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Opens the image file of the disk, it is created if needed.
+  * @param  path: Path of the image file
+  * @param  sectors: Size of the disk in sectors, the file is resized to it.
+  *         0 to use the size of an existing file.
+  * @retval Returns 0 in case of success, otherwise 1.
+  */
+uint8_t FILEDISK_Open(const char *path, DWORD sectors)
+{
+  off_t size;
+  
+  FILEDISK_Close();
+  FileDisk_fd = open(path, O_RDWR | O_CREAT, 0644);
+  if(FileDisk_fd < 0)
+  {
+    return 1;
+  }
+  if(sectors != 0)
+  {
+    /* The image is sparse, only the written sectors take space */
+    if(ftruncate(FileDisk_fd, (off_t)sectors * BLOCK_SIZE) != 0)
+    {
+      FILEDISK_Close();
+      return 1;
+    }
+  }
+  else
+  {
+    size = lseek(FileDisk_fd, 0, SEEK_END);
+    sectors = (size > 0) ? (DWORD)(size / BLOCK_SIZE) : 0;
+  }
+  FileDisk_Sectors = sectors;
+  Stat = STA_NOINIT;
+  return 0;
+}
+
+/**
+  * @brief  Writes the image file to the storage and closes it.
+  * @param  None
+  * @retval None
+  */
+void FILEDISK_Close(void)
+{
+  if(FileDisk_fd >= 0)
+  {
+    fsync(FileDisk_fd);
+    close(FileDisk_fd);
+    FileDisk_fd = -1;
+  }
+  FileDisk_Sectors = 0;
+  Stat = STA_NOINIT;
+}
+
+/**
+  * @brief  Sets the timing of a simulated device. Each command takes the
+  *         latency plus the transfer time at the bandwidth, the commands do
+  *         not overlap.
+  * @param  latency_us: Latency of a command in us, 0 for none
+  * @param  bandwidth_kBps: Transfer rate in kB/s, 0 for no limit
+  * @retval None
+  */
+void FILEDISK_SetTiming(uint32_t latency_us, uint32_t bandwidth_kBps)
+{
+  FileDisk_Latency = latency_us;
+  FileDisk_Bandwidth = bandwidth_kBps;
+  clock_gettime(CLOCK_MONOTONIC, &FileDisk_Busy);
+}
+
+/**
+  * @brief  Waits for the simulated duration of a command
+  * @param  bytes: Number of bytes transferred
+  * @retval None
+  */
+static void FILEDISK_Delay(uint32_t bytes)
+{
+  struct timespec now;
+  uint64_t ns;
+  
+  if((FileDisk_Latency == 0) && (FileDisk_Bandwidth == 0))
+  {
+    return;
+  }
+  ns = (uint64_t)FileDisk_Latency * 1000;
+  if(FileDisk_Bandwidth != 0)
+  {
+    ns += (uint64_t)bytes * 1000000 / FileDisk_Bandwidth;
+  }
+  
+  /* The command starts when the previous one is done, or now */
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  if((now.tv_sec > FileDisk_Busy.tv_sec) ||
+     ((now.tv_sec == FileDisk_Busy.tv_sec) && (now.tv_nsec > FileDisk_Busy.tv_nsec)))
+  {
+    FileDisk_Busy = now;
+  }
+  ns += FileDisk_Busy.tv_nsec;
+  FileDisk_Busy.tv_sec += ns / 1000000000;
+  FileDisk_Busy.tv_nsec = ns % 1000000000;
+  while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &FileDisk_Busy, NULL) != 0)
+  {
+  }
+}
+
+/**
+  * @brief  Initializes a Drive
+  * @param  lun: Not used
+  * @retval DSTATUS: Operation status
+  */
+DSTATUS FILEDISK_initialize(BYTE lun)
+{
+  Stat = STA_NOINIT;
+  
+  if((FileDisk_fd >= 0) && (FileDisk_Sectors != 0))
+  {
+    Stat &= ~STA_NOINIT;
+  }
+  return Stat;
+}
+
+/**
+  * @brief  Gets Disk Status
+  * @param  lun: Not used
+  * @retval DSTATUS: Operation status
+  */
+DSTATUS FILEDISK_status(BYTE lun)
+{
+  return Stat;
+}
+
+/**
+  * @brief  Reads Sector(s) 
+  * @param  lun: Not used
+  * @param  *buff: Data buffer to store read data
+  * @param  sector: Sector address (LBA)
+  * @param  count: Number of sectors to read (1..128)
+  * @retval DRESULT: Operation result
+  */
+DRESULT FILEDISK_read(BYTE lun, BYTE *buff, DWORD sector, BYTE count)
+{
+  size_t size = (size_t)count * BLOCK_SIZE;
+  
+  if (Stat & STA_NOINIT) return RES_NOTRDY;
+  if ((sector >= FileDisk_Sectors) || (count > FileDisk_Sectors - sector)) return RES_PARERR;
+  
+  FILEDISK_Delay(size);
+  if (pread(FileDisk_fd, buff, size, (off_t)sector * BLOCK_SIZE) != (ssize_t)size)
+  {
+    return RES_ERROR;
+  }
+  return RES_OK;
+}
+
+/**
+  * @brief  Writes Sector(s)
+  * @param  lun: Not used
+  * @param  *buff: Data to be written
+  * @param  sector: Sector address (LBA)
+  * @param  count: Number of sectors to write (1..128)
+  * @retval DRESULT: Operation result
+  */
+#if _USE_WRITE == 1
+DRESULT FILEDISK_write(BYTE lun, const BYTE *buff, DWORD sector, BYTE count)
+{
+  size_t size = (size_t)count * BLOCK_SIZE;
+  
+  if (Stat & STA_NOINIT) return RES_NOTRDY;
+  if ((sector >= FileDisk_Sectors) || (count > FileDisk_Sectors - sector)) return RES_PARERR;
+  
+  FILEDISK_Delay(size);
+  if (pwrite(FileDisk_fd, buff, size, (off_t)sector * BLOCK_SIZE) != (ssize_t)size)
+  {
+    return RES_ERROR;
+  }
+  return RES_OK;
+}
+#endif /* _USE_WRITE == 1 */
+
+/**
+  * @brief  I/O control operation
+  * @param  lun: Not used
+  * @param  cmd: Control code
+  * @param  *buff: Buffer to send/receive control data
+  * @retval DRESULT: Operation result
+  */
+#if _USE_IOCTL == 1
+DRESULT FILEDISK_ioctl(BYTE lun, BYTE cmd, void *buff)
+{
+  DRESULT res = RES_ERROR;
+  
+  if (Stat & STA_NOINIT) return RES_NOTRDY;
+  
+  switch (cmd)
+  {
+  /* The data is in the page cache of the host, it is written to the storage
+     by FILEDISK_Close */
+  case CTRL_SYNC :
+    res = RES_OK;
+    break;
+  
+  /* Get number of sectors on the disk (DWORD) */
+  case GET_SECTOR_COUNT :
+    *(DWORD*)buff = FileDisk_Sectors;
+    res = RES_OK;
+    break;
+  
+  /* Get R/W sector size (WORD) */
+  case GET_SECTOR_SIZE :
+    *(WORD*)buff = BLOCK_SIZE;
+    res = RES_OK;
+    break;
+  
+  /* Get erase block size in unit of sector (DWORD) */
+  case GET_BLOCK_SIZE :
+    *(DWORD*)buff = 1;
+    res = RES_OK;
+    break;
+  
+  default:
+    res = RES_PARERR;
+  }
+  
+  return res;
+}
+#endif /* _USE_IOCTL == 1 */
+  
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,215 @@
+/**
+  ******************************************************************************
+  * @file    ramdisk_diskio.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   RAM Disk I/O driver
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software 
+  * distributed under the License is distributed on an "AS IS" BASIS, 
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "ff_gen_drv.h"
+#include "ramdisk_diskio.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Block Size in Bytes */
+#define BLOCK_SIZE                512
+
+/* Number of sectors of the static disk, 0 if the memory is always attached
+   with RAMDISK_Attach (heap, external RAM...) */
+#ifndef RAMDISK_SECTORS
+ #define RAMDISK_SECTORS          0
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+/* Disk status */
+static volatile DSTATUS Stat = STA_NOINIT;
+
+#if RAMDISK_SECTORS > 0
+static uint32_t RamDisk_Buffer[RAMDISK_SECTORS * BLOCK_SIZE / 4];
+static BYTE *RamDisk_Mem = (BYTE *)RamDisk_Buffer;
+#else
+static BYTE *RamDisk_Mem = NULL;
+#endif
+static DWORD RamDisk_Sectors = RAMDISK_SECTORS;
+
+/* Private function prototypes -----------------------------------------------*/
+DSTATUS RAMDISK_initialize (BYTE);
+DSTATUS RAMDISK_status (BYTE);
+DRESULT RAMDISK_read (BYTE, BYTE*, DWORD, BYTE);
+#if _USE_WRITE == 1
+  DRESULT RAMDISK_write (BYTE, const BYTE*, DWORD, BYTE);
+#endif /* _USE_WRITE == 1 */
+#if _USE_IOCTL == 1
+  DRESULT RAMDISK_ioctl (BYTE, BYTE, void*);
+#endif /* _USE_IOCTL == 1 */
+  
+Diskio_drvTypeDef  RAMDISK_Driver =
+{
+  RAMDISK_initialize,
+  RAMDISK_status,
+  RAMDISK_read, 
+#if  _USE_WRITE == 1
+  RAMDISK_write,
+#endif /* _USE_WRITE == 1 */  
+#if  _USE_IOCTL == 1
+  RAMDISK_ioctl,
+#endif /* _USE_IOCTL == 1 */
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Attaches the memory of the disk. It is called before the volume is
+  *         mounted, the content of the memory is kept.
+  * @param  mem: Memory of the disk, NULL for the static disk
+  * @param  sectors: Number of sectors of mem
+  * @retval Returns 0 in case of success, otherwise 1.
+  */
+uint8_t RAMDISK_Attach(BYTE *mem, DWORD sectors)
+{
+  if(mem == NULL)
+  {
+#if RAMDISK_SECTORS > 0
+    mem = (BYTE *)RamDisk_Buffer;
+    sectors = RAMDISK_SECTORS;
+#else
+    return 1;
+#endif
+  }
+  RamDisk_Mem = mem;
+  RamDisk_Sectors = sectors;
+  Stat = STA_NOINIT;
+  return 0;
+}
+
+/**
+  * @brief  Initializes a Drive
+  * @param  lun: Not used
+  * @retval DSTATUS: Operation status
+  */
+DSTATUS RAMDISK_initialize(BYTE lun)
+{
+  Stat = STA_NOINIT;
+  
+  if((RamDisk_Mem != NULL) && (RamDisk_Sectors != 0))
+  {
+    Stat &= ~STA_NOINIT;
+  }
+  return Stat;
+}
+
+/**
+  * @brief  Gets Disk Status
+  * @param  lun: Not used
+  * @retval DSTATUS: Operation status
+  */
+DSTATUS RAMDISK_status(BYTE lun)
+{
+  return Stat;
+}
+
+/**
+  * @brief  Reads Sector(s) 
+  * @param  lun: Not used
+  * @param  *buff: Data buffer to store read data
+  * @param  sector: Sector address (LBA)
+  * @param  count: Number of sectors to read (1..128)
+  * @retval DRESULT: Operation result
+  */
+DRESULT RAMDISK_read(BYTE lun, BYTE *buff, DWORD sector, BYTE count)
+{
+  if (Stat & STA_NOINIT) return RES_NOTRDY;
+  if ((sector >= RamDisk_Sectors) || (count > RamDisk_Sectors - sector)) return RES_PARERR;
+  
+  memcpy(buff, RamDisk_Mem + (size_t)sector * BLOCK_SIZE, (size_t)count * BLOCK_SIZE);
+  return RES_OK;
+}
+
+/**
+  * @brief  Writes Sector(s)
+  * @param  lun: Not used
+  * @param  *buff: Data to be written
+  * @param  sector: Sector address (LBA)
+  * @param  count: Number of sectors to write (1..128)
+  * @retval DRESULT: Operation result
+  */
+#if _USE_WRITE == 1
+DRESULT RAMDISK_write(BYTE lun, const BYTE *buff, DWORD sector, BYTE count)
+{
+  if (Stat & STA_NOINIT) return RES_NOTRDY;
+  if ((sector >= RamDisk_Sectors) || (count > RamDisk_Sectors - sector)) return RES_PARERR;
+  
+  memcpy(RamDisk_Mem + (size_t)sector * BLOCK_SIZE, buff, (size_t)count * BLOCK_SIZE);
+  return RES_OK;
+}
+#endif /* _USE_WRITE == 1 */
+
+/**
+  * @brief  I/O control operation
+  * @param  lun: Not used
+  * @param  cmd: Control code
+  * @param  *buff: Buffer to send/receive control data
+  * @retval DRESULT: Operation result
+  */
+#if _USE_IOCTL == 1
+DRESULT RAMDISK_ioctl(BYTE lun, BYTE cmd, void *buff)
+{
+  DRESULT res = RES_ERROR;
+  
+  if (Stat & STA_NOINIT) return RES_NOTRDY;
+  
+  switch (cmd)
+  {
+  /* Make sure that no pending write process */
+  case CTRL_SYNC :
+    res = RES_OK;
+    break;
+  
+  /* Get number of sectors on the disk (DWORD) */
+  case GET_SECTOR_COUNT :
+    *(DWORD*)buff = RamDisk_Sectors;
+    res = RES_OK;
+    break;
+  
+  /* Get R/W sector size (WORD) */
+  case GET_SECTOR_SIZE :
+    *(WORD*)buff = BLOCK_SIZE;
+    res = RES_OK;
+    break;
+  
+  /* Get erase block size in unit of sector (DWORD) */
+  case GET_BLOCK_SIZE :
+    *(DWORD*)buff = 1;
+    res = RES_OK;
+    break;
+  
+  default:
+    res = RES_PARERR;
+  }
+  
+  return res;
+}
+#endif /* _USE_IOCTL == 1 */
+  
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
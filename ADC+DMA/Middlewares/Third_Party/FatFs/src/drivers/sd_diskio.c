@@ -39,14 +39,14 @@
 static volatile DSTATUS Stat = STA_NOINIT;
 
 /* Private function prototypes -----------------------------------------------*/
-DSTATUS SD_initialize (void);
-DSTATUS SD_status (void);
-DRESULT SD_read (BYTE*, DWORD, BYTE);
+DSTATUS SD_initialize (BYTE);
+DSTATUS SD_status (BYTE);
+DRESULT SD_read (BYTE, BYTE*, DWORD, BYTE);
 #if _USE_WRITE == 1
-  DRESULT SD_write (const BYTE*, DWORD, BYTE);
+  DRESULT SD_write (BYTE, const BYTE*, DWORD, BYTE);
 #endif /* _USE_WRITE == 1 */
 #if _USE_IOCTL == 1
-  DRESULT SD_ioctl (BYTE, void*);
+  DRESULT SD_ioctl (BYTE, BYTE, void*);
 #endif  /* _USE_IOCTL == 1 */
   
 Diskio_drvTypeDef  SD_Driver =
@@ -67,10 +67,10 @@ Diskio_drvTypeDef  SD_Driver =
 
 /**
   * @brief  Initializes a Drive
-  * @param  None
+  * @param  lun: Not used
   * @retval DSTATUS: Operation status
   */
-DSTATUS SD_initialize(void)
+DSTATUS SD_initialize(BYTE lun)
 {
   Stat = STA_NOINIT;
   
@@ -85,10 +85,10 @@ DSTATUS SD_initialize(void)
 
 /**
   * @brief  Gets Disk Status
-  * @param  None
+  * @param  lun: Not used
   * @retval DSTATUS: Operation status
   */
-DSTATUS SD_status(void)
+DSTATUS SD_status(BYTE lun)
 {
   Stat = STA_NOINIT;
 
@@ -102,12 +102,13 @@ DSTATUS SD_status(void)
 
 /**
   * @brief  Reads Sector(s)
+  * @param  lun: Not used
   * @param  *buff: Data buffer to store read data
   * @param  sector: Sector address (LBA)
   * @param  count: Number of sectors to read (1..128)
   * @retval DRESULT: Operation result
   */
-DRESULT SD_read(BYTE *buff, DWORD sector, BYTE count)
+DRESULT SD_read(BYTE lun, BYTE *buff, DWORD sector, BYTE count)
 {
   DRESULT res = RES_OK;
   
@@ -124,13 +125,14 @@ DRESULT SD_read(BYTE *buff, DWORD sector, BYTE count)
 
 /**
   * @brief  Writes Sector(s)
+  * @param  lun: Not used
   * @param  *buff: Data to be written
   * @param  sector: Sector address (LBA)
   * @param  count: Number of sectors to write (1..128)
   * @retval DRESULT: Operation result
   */
 #if _USE_WRITE == 1
-DRESULT SD_write(const BYTE *buff, DWORD sector, BYTE count)
+DRESULT SD_write(BYTE lun, const BYTE *buff, DWORD sector, BYTE count)
 {
   DRESULT res = RES_OK;
   
@@ -147,12 +149,13 @@ DRESULT SD_write(const BYTE *buff, DWORD sector, BYTE count)
 
 /**
   * @brief  I/O control operation
+  * @param  lun: Not used
   * @param  cmd: Control code
   * @param  *buff: Buffer to send/receive control data
   * @retval DRESULT: Operation result
   */
 #if _USE_IOCTL == 1
-DRESULT SD_ioctl(BYTE cmd, void *buff)
+DRESULT SD_ioctl(BYTE lun, BYTE cmd, void *buff)
 {
   DRESULT res = RES_ERROR;
   SD_CardInfo CardInfo;
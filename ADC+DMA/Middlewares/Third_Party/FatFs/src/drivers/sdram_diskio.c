@@ -39,14 +39,14 @@
 static volatile DSTATUS Stat = STA_NOINIT;
 
 /* Private function prototypes -----------------------------------------------*/
-DSTATUS SDRAMDISK_initialize (void);
-DSTATUS SDRAMDISK_status (void);
-DRESULT SDRAMDISK_read (BYTE*, DWORD, BYTE);
+DSTATUS SDRAMDISK_initialize (BYTE);
+DSTATUS SDRAMDISK_status (BYTE);
+DRESULT SDRAMDISK_read (BYTE, BYTE*, DWORD, BYTE);
 #if _USE_WRITE == 1
-  DRESULT SDRAMDISK_write (const BYTE*, DWORD, BYTE);
+  DRESULT SDRAMDISK_write (BYTE, const BYTE*, DWORD, BYTE);
 #endif /* _USE_WRITE == 1 */
 #if _USE_IOCTL == 1
-  DRESULT SDRAMDISK_ioctl (BYTE, void*);
+  DRESULT SDRAMDISK_ioctl (BYTE, BYTE, void*);
 #endif /* _USE_IOCTL == 1 */
   
 Diskio_drvTypeDef  SDRAMDISK_Driver =
@@ -66,10 +66,10 @@ Diskio_drvTypeDef  SDRAMDISK_Driver =
 
 /**
   * @brief  Initializes a Drive
-  * @param  None
+  * @param  lun: Not used
   * @retval DSTATUS: Operation status
   */
-DSTATUS SDRAMDISK_initialize(void)
+DSTATUS SDRAMDISK_initialize(BYTE lun)
 {
   Stat = STA_NOINIT;
   
@@ -82,10 +82,10 @@ DSTATUS SDRAMDISK_initialize(void)
 
 /**
   * @brief  Gets Disk Status
-  * @param  None
+  * @param  lun: Not used
   * @retval DSTATUS: Operation status
   */
-DSTATUS SDRAMDISK_status(void)
+DSTATUS SDRAMDISK_status(BYTE lun)
 {
   Stat = STA_NOINIT;
   
@@ -96,12 +96,13 @@ DSTATUS SDRAMDISK_status(void)
 
 /**
   * @brief  Reads Sector(s)
+  * @param  lun: Not used
   * @param  *buff: Data buffer to store read data
   * @param  sector: Sector address (LBA)
   * @param  count: Number of sectors to read (1..128)
   * @retval DRESULT: Operation result
   */
-DRESULT SDRAMDISK_read(BYTE *buff, DWORD sector, BYTE count)
+DRESULT SDRAMDISK_read(BYTE lun, BYTE *buff, DWORD sector, BYTE count)
 {
   uint32_t *pSrcBuffer = (uint32_t *)buff;
   uint32_t BufferSize = (BLOCK_SIZE * count)/4; 
@@ -117,13 +118,14 @@ DRESULT SDRAMDISK_read(BYTE *buff, DWORD sector, BYTE count)
 
 /**
   * @brief  Writes Sector(s)
+  * @param  lun: Not used
   * @param  *buff: Data to be written
   * @param  sector: Sector address (LBA)
   * @param  count: Number of sectors to write (1..128)
   * @retval DRESULT: Operation result
   */
 #if _USE_WRITE == 1
-DRESULT SDRAMDISK_write(const BYTE *buff, DWORD sector, BYTE count)
+DRESULT SDRAMDISK_write(BYTE lun, const BYTE *buff, DWORD sector, BYTE count)
 { 
   uint32_t *pDstBuffer = (uint32_t *)buff;
   uint32_t BufferSize = (BLOCK_SIZE * count)/4 + count; 
@@ -140,12 +142,13 @@ DRESULT SDRAMDISK_write(const BYTE *buff, DWORD sector, BYTE count)
 
 /**
   * @brief  I/O control operation
+  * @param  lun: Not used
   * @param  cmd: Control code
   * @param  *buff: Buffer to send/receive control data
   * @retval DRESULT: Operation result
   */
 #if _USE_IOCTL == 1
-DRESULT SDRAMDISK_ioctl(BYTE cmd, void *buff)
+DRESULT SDRAMDISK_ioctl(BYTE lun, BYTE cmd, void *buff)
 {
   DRESULT res = RES_ERROR;
   
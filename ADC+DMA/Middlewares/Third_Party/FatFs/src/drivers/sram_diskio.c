@@ -39,14 +39,14 @@
 static volatile DSTATUS Stat = STA_NOINIT;
 
 /* Private function prototypes -----------------------------------------------*/
-DSTATUS SRAMDISK_initialize (void);
-DSTATUS SRAMDISK_status (void);
-DRESULT SRAMDISK_read (BYTE*, DWORD, BYTE);
+DSTATUS SRAMDISK_initialize (BYTE);
+DSTATUS SRAMDISK_status (BYTE);
+DRESULT SRAMDISK_read (BYTE, BYTE*, DWORD, BYTE);
 #if _USE_WRITE == 1
-  DRESULT SRAMDISK_write (const BYTE*, DWORD, BYTE);
+  DRESULT SRAMDISK_write (BYTE, const BYTE*, DWORD, BYTE);
 #endif /* _USE_WRITE == 1 */
 #if _USE_IOCTL == 1
-  DRESULT SRAMDISK_ioctl (BYTE, void*);
+  DRESULT SRAMDISK_ioctl (BYTE, BYTE, void*);
 #endif /* _USE_IOCTL == 1 */
   
 Diskio_drvTypeDef  SRAMDISK_Driver =
@@ -66,10 +66,10 @@ Diskio_drvTypeDef  SRAMDISK_Driver =
 
 /**
   * @brief  Initializes a Drive
-  * @param  None
+  * @param  lun: Not used
   * @retval DSTATUS: Operation status
   */
-DSTATUS SRAMDISK_initialize(void)
+DSTATUS SRAMDISK_initialize(BYTE lun)
 {
   Stat = STA_NOINIT;
   
@@ -82,10 +82,10 @@ DSTATUS SRAMDISK_initialize(void)
 
 /**
   * @brief  Gets Disk Status
-  * @param  None
+  * @param  lun: Not used
   * @retval DSTATUS: Operation status
   */
-DSTATUS SRAMDISK_status(void)
+DSTATUS SRAMDISK_status(BYTE lun)
 {
   Stat = STA_NOINIT;
   
@@ -96,12 +96,13 @@ DSTATUS SRAMDISK_status(void)
 
 /**
   * @brief  Reads Sector(s) 
+  * @param  lun: Not used
   * @param  *buff: Data buffer to store read data
   * @param  sector: Sector address (LBA)
   * @param  count: Number of sectors to read (1..128)
   * @retval DRESULT: Operation result
   */
-DRESULT SRAMDISK_read(BYTE *buff, DWORD sector, BYTE count)
+DRESULT SRAMDISK_read(BYTE lun, BYTE *buff, DWORD sector, BYTE count)
 {
   uint32_t BufferSize = (BLOCK_SIZE * count); 
   uint8_t *pSramAddress = (uint8_t *) (SRAM_DEVICE_ADDR + (sector * BLOCK_SIZE)); 
@@ -116,13 +117,14 @@ DRESULT SRAMDISK_read(BYTE *buff, DWORD sector, BYTE count)
 
 /**
   * @brief  Writes Sector(s)
+  * @param  lun: Not used
   * @param  *buff: Data to be written
   * @param  sector: Sector address (LBA)
   * @param  count: Number of sectors to write (1..128)
   * @retval DRESULT: Operation result
   */
 #if _USE_WRITE == 1
-DRESULT SRAMDISK_write(const BYTE *buff, DWORD sector, BYTE count)
+DRESULT SRAMDISK_write(BYTE lun, const BYTE *buff, DWORD sector, BYTE count)
 {
   uint32_t BufferSize = (BLOCK_SIZE * count) + count; 
   uint8_t *pSramAddress = (uint8_t *) (SRAM_DEVICE_ADDR + (sector * BLOCK_SIZE)); 
@@ -138,12 +140,13 @@ DRESULT SRAMDISK_write(const BYTE *buff, DWORD sector, BYTE count)
 
 /**
   * @brief  I/O control operation
+  * @param  lun: Not used
   * @param  cmd: Control code
   * @param  *buff: Buffer to send/receive control data
   * @retval DRESULT: Operation result
   */
 #if _USE_IOCTL == 1
-DRESULT SRAMDISK_ioctl(BYTE cmd, void *buff)
+DRESULT SRAMDISK_ioctl(BYTE lun, BYTE cmd, void *buff)
 {
   DRESULT res = RES_ERROR;
   
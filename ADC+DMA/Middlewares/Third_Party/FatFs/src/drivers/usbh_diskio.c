@@ -31,21 +31,52 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+/* Number of sectors of the bounce buffer used for unaligned or gathered data */
+#ifndef USBH_BOUNCE_SECTORS
+ #define USBH_BOUNCE_SECTORS  8
+#endif
+
+/* Alignment of the data buffers required by the host controller, in bytes:
+   4 when the core moves the data by DMA, 1 when the CPU copies the FIFO */
+#ifndef USBH_DMA_ALIGN
+ #define USBH_DMA_ALIGN  4
+#endif
+
+/* Private macro -------------------------------------------------------------*/
+#define USBH_IS_ALIGNED(p)  (((size_t)(p) & (USBH_DMA_ALIGN - 1)) == 0)
+
 /* Private variables ---------------------------------------------------------*/
 extern USBH_HandleTypeDef  HOST_HANDLE;
+/* Shared by the units: the device runs one command at a time */
+static DWORD bounce[USBH_BOUNCE_SECTORS * _MAX_SS / 4];
 
 /* Private function prototypes -----------------------------------------------*/
-DSTATUS USBH_initialize (void);
-DSTATUS USBH_status (void);
-DRESULT USBH_read (BYTE*, DWORD, BYTE);
+DSTATUS USBH_initialize (BYTE);
+DSTATUS USBH_status (BYTE);
+DRESULT USBH_read (BYTE, BYTE*, DWORD, BYTE);
 
 #if _USE_WRITE == 1
-  DRESULT USBH_write (const BYTE*, DWORD, BYTE);
+  DRESULT USBH_write (BYTE, const BYTE*, DWORD, BYTE);
 #endif /* _USE_WRITE == 1 */
 
 #if _USE_IOCTL == 1
-  DRESULT USBH_ioctl (BYTE, void*);
+  DRESULT USBH_ioctl (BYTE, BYTE, void*);
 #endif /* _USE_IOCTL == 1 */
+
+#if _USE_WRITEV == 1
+  DRESULT USBH_writev (BYTE, const BYTE*, const BYTE*, DWORD, BYTE);
+#endif /* _USE_WRITEV == 1 */
+
+#if _DISK_ASYNC > 0
+  DRESULT USBH_write_start (BYTE, const BYTE*, DWORD, BYTE);
+  uint8_t USBH_write_done (BYTE, DRESULT*);
+  void    USBH_write_wait (BYTE);
+#endif /* _DISK_ASYNC > 0 */
+
+#if _USE_WRITE == 1
+static DRESULT USBH_write_sectors (BYTE, const BYTE*, const BYTE*, DWORD, BYTE);
+static DRESULT USBH_write_error (BYTE);
+#endif /* _USE_WRITE == 1 */
   
 Diskio_drvTypeDef  USBH_Driver =
 {
@@ -58,83 +89,120 @@ Diskio_drvTypeDef  USBH_Driver =
 #if  _USE_IOCTL == 1
   USBH_ioctl,
 #endif /* _USE_IOCTL == 1 */
+#if  _USE_WRITEV == 1
+  USBH_writev,
+#endif /* _USE_WRITEV == 1 */
+#if  _DISK_ASYNC > 0
+  USBH_write_start,
+  USBH_write_done,
+  USBH_write_wait,
+#endif /* _DISK_ASYNC > 0 */
 };
 
 /* Private functions ---------------------------------------------------------*/
 
 /**
-  * @brief  Initializes a Drive
-  * @param  None
+  * @brief  Initializes a Drive: the state and the capacity of the unit are
+  *         read again if a command failed since the enumeration
+  * @param  lun: Logical unit number
   * @retval DSTATUS: Operation status
   */
-DSTATUS USBH_initialize(void)
+DSTATUS USBH_initialize(BYTE lun)
 {
-  return RES_OK;
+  DSTATUS stat = STA_NOINIT;
+  
+  /* No MSC class before the enumeration and after a disconnection */
+  if((HOST_HANDLE.gState != HOST_CLASS) || (HOST_HANDLE.pActiveClass == NULL))
+  {
+    return stat;
+  }
+  if(USBH_MSC_CheckUnit(&HOST_HANDLE, lun) == USBH_OK)
+  {
+    stat &= ~STA_NOINIT;
+  }
+  
+  return stat;
 }
 
 /**
-  * @brief  Gets Disk Status
-  * @param  None
+  * @brief  Gets Disk Status, kept by the MSC class without a command to
+  *         the device
+  * @param  lun: Logical unit number
   * @retval DSTATUS: Operation status
   */
-DSTATUS USBH_status(void)
+DSTATUS USBH_status(BYTE lun)
 {
-  DRESULT res = RES_ERROR;
+  DSTATUS stat = STA_NOINIT;
   
-  if(USBH_MSC_UnitIsReady(&HOST_HANDLE, 0))
+  /* No MSC class before the enumeration and after a disconnection */
+  if((HOST_HANDLE.gState != HOST_CLASS) || (HOST_HANDLE.pActiveClass == NULL))
   {
-    res = RES_OK;
+    return stat;
   }
-  else
+  if(USBH_MSC_UnitIsReady(&HOST_HANDLE, lun))
   {
-    res = RES_ERROR;
+    stat &= ~STA_NOINIT;
   }
   
-  return res;
+  return stat;
 }
 
 /**
   * @brief  Reads Sector(s) 
+  * @param  lun: Logical unit number
   * @param  *buff: Data buffer to store read data
   * @param  sector: Sector address (LBA)
   * @param  count: Number of sectors to read (1..128)
   * @retval DRESULT: Operation result
   */
-DRESULT USBH_read(BYTE *buff, DWORD sector, BYTE count)
+DRESULT USBH_read(BYTE lun, BYTE *buff, DWORD sector, BYTE count)
 {
   DRESULT res = RES_ERROR;
   MSC_LUNTypeDef info;
   USBH_StatusTypeDef  status = USBH_OK;
-  DWORD scratch [_MAX_SS / 4];
+  BYTE *p;
   
-  if ((DWORD)buff & 3) /* DMA Alignment issue, do single up to aligned buffer */
+  if (USBH_IS_ALIGNED(buff))
+  {
+    status = USBH_MSC_Read(&HOST_HANDLE, lun, sector, buff, count);
+  }
+  else
   {
-    while ((count--)&&(status == USBH_OK))
+    /* DMA Alignment issue: read all the sectors but the last one at the next
+       aligned address of buff and move them down, then the last one through
+       the aligned bounce buffer */
+    if (count > 1)
     {
-      status = USBH_MSC_Read(&HOST_HANDLE, 0, sector + count, (uint8_t *)scratch, 1);
+      p = buff + USBH_DMA_ALIGN - ((size_t)buff & (USBH_DMA_ALIGN - 1));
+      status = USBH_MSC_Read(&HOST_HANDLE, lun, sector, p, count - 1);
       if(status == USBH_OK)
       {
-        memcpy (&buff[count * _MAX_SS] ,scratch, _MAX_SS);
+        memmove (buff, p, (count - 1) * _MAX_SS);
+        buff += (count - 1) * _MAX_SS;
+        sector += count - 1;
       }
-      else
+    }
+    if(status == USBH_OK)
+    {
+      status = USBH_MSC_Read(&HOST_HANDLE, lun, sector, (uint8_t *)bounce, 1);
+      if(status == USBH_OK)
       {
-        break;
+        memcpy (buff, bounce, _MAX_SS);
       }
     }
   }
-  else
-  {
-    status = USBH_MSC_Read(&HOST_HANDLE, 0, sector, buff, count);
-  }
   
   if(status == USBH_OK)
   {
     res = RES_OK;
   }
+  else if(USBH_MSC_GetLUNInfo(&HOST_HANDLE, lun, &info) != USBH_OK)
+  {
+    /* The device was disconnected */
+    res = RES_NOTRDY;
+  }
   else
   {
-    USBH_MSC_GetLUNInfo(&HOST_HANDLE, 0, &info); 
-    
     switch (info.sense.asc)
     {
     case SCSI_ASC_LOGICAL_UNIT_NOT_READY:
@@ -155,35 +223,78 @@ DRESULT USBH_read(BYTE *buff, DWORD sector, BYTE count)
 
 /**
   * @brief  Writes Sector(s)
+  * @param  lun: Logical unit number
   * @param  *buff: Data to be written
   * @param  sector: Sector address (LBA)
   * @param  count: Number of sectors to write (1..128)
   * @retval DRESULT: Operation result
   */
 #if _USE_WRITE == 1
-DRESULT USBH_write(const BYTE *buff, DWORD sector, BYTE count)
+DRESULT USBH_write(BYTE lun, const BYTE *buff, DWORD sector, BYTE count)
+{
+  return USBH_write_sectors(lun, NULL, buff, sector, count);
+}
+#endif /* _USE_WRITE == 1 */
+
+/**
+  * @brief  Writes a sector and the following Sector(s) in one transfer
+  * @param  lun: Logical unit number
+  * @param  *head: Data of the first sector
+  * @param  *buff: Data of the following sectors
+  * @param  sector: Sector address (LBA)
+  * @param  count: Number of sectors to write, the first one included (2..128)
+  * @retval DRESULT: Operation result
+  */
+#if _USE_WRITEV == 1
+DRESULT USBH_writev(BYTE lun, const BYTE *head, const BYTE *buff, DWORD sector, BYTE count)
+{
+  return USBH_write_sectors(lun, head, buff, sector, count);
+}
+#endif /* _USE_WRITEV == 1 */
+
+/**
+  * @brief  Writes an optional first sector and the following Sector(s)
+  * @param  lun: Logical unit number
+  * @param  *head: Data of the first sector, NULL if all come from buff
+  * @param  *buff: Data of the (following) sectors
+  * @param  sector: Sector address (LBA)
+  * @param  count: Number of sectors to write (1..128)
+  * @retval DRESULT: Operation result
+  */
+#if _USE_WRITE == 1
+static DRESULT USBH_write_sectors(BYTE lun, const BYTE *head, const BYTE *buff, DWORD sector, BYTE count)
 {
   DRESULT res = RES_ERROR; 
-  MSC_LUNTypeDef info;
   USBH_StatusTypeDef  status = USBH_OK;  
-  DWORD scratch [_MAX_SS / 4];  
+  BYTE n;
   
-  if ((DWORD)buff & 3) /* DMA Alignment issue, do single up to aligned buffer */
+  while ((count > 0) && (status == USBH_OK))
   {
-    while (count--)
+    if ((head == NULL) && USBH_IS_ALIGNED(buff))
     {
-      memcpy (scratch, &buff[count * _MAX_SS], _MAX_SS);
-      
-      status = USBH_MSC_Write(&HOST_HANDLE, 0, sector + count, (BYTE *)scratch, 1) ;
-      if(status == USBH_FAIL)
+      /* Aligned data, write the remaining sectors directly */
+      n = count;
+      status = USBH_MSC_Write(&HOST_HANDLE, lun, sector, (BYTE *)buff, n);
+    }
+    else
+    {
+      /* Gathered data or DMA alignment issue, write through the aligned bounce buffer */
+      n = 0;
+      if (head != NULL)
+      {
+        memcpy (bounce, head, _MAX_SS);
+        head = NULL;
+        n = 1;
+      }
+      for ( ; (n < count) && (n < USBH_BOUNCE_SECTORS); n++)
       {
-        break;
+        memcpy ((BYTE *)bounce + n * _MAX_SS, buff, _MAX_SS);
+        buff += _MAX_SS;
       }
+      status = USBH_MSC_Write(&HOST_HANDLE, lun, sector, (BYTE *)bounce, n);
     }
-  }
-  else
-  {
-    status = USBH_MSC_Write(&HOST_HANDLE, 0, sector, (BYTE *)buff, count);
+    sector += n;
+    count -= n;
   }
   
   if(status == USBH_OK)
@@ -192,40 +303,114 @@ DRESULT USBH_write(const BYTE *buff, DWORD sector, BYTE count)
   }
   else
   {
-    USBH_MSC_GetLUNInfo(&HOST_HANDLE, 0, &info); 
+    res = USBH_write_error(lun);
+  }
+  
+  return res;   
+}
+
+/**
+  * @brief  Gets the result of a failed write from the sense data
+  * @param  lun: Logical unit number
+  * @retval DRESULT: Operation result
+  */
+static DRESULT USBH_write_error(BYTE lun)
+{
+  DRESULT res = RES_ERROR; 
+  MSC_LUNTypeDef info;
+  
+  if(USBH_MSC_GetLUNInfo(&HOST_HANDLE, lun, &info) != USBH_OK)
+  {
+    /* The device was disconnected */
+    return RES_NOTRDY;
+  }
+  
+  switch (info.sense.asc)
+  {
+  case SCSI_ASC_WRITE_PROTECTED:
+    USBH_ErrLog("USB Disk is Write protected!");
+    res = RES_WRPRT;
+    break;
     
-    switch (info.sense.asc)
-    {
-    case SCSI_ASC_WRITE_PROTECTED:
-      USBH_ErrLog("USB Disk is Write protected!");
-      res = RES_WRPRT;
-      break;
-      
-    case SCSI_ASC_LOGICAL_UNIT_NOT_READY:
-    case SCSI_ASC_MEDIUM_NOT_PRESENT:
-    case SCSI_ASC_NOT_READY_TO_READY_CHANGE:
-      USBH_ErrLog("USB Disk is not ready!");      
-      res = RES_NOTRDY;
-      break; 
-      
-    default:
-      res = RES_ERROR;
-      break;
-    }
+  case SCSI_ASC_LOGICAL_UNIT_NOT_READY:
+  case SCSI_ASC_MEDIUM_NOT_PRESENT:
+  case SCSI_ASC_NOT_READY_TO_READY_CHANGE:
+    USBH_ErrLog("USB Disk is not ready!");      
+    res = RES_NOTRDY;
+    break; 
+    
+  default:
+    res = RES_ERROR;
+    break;
   }
   
   return res;   
 }
 #endif /* _USE_WRITE == 1 */
 
+/**
+  * @brief  Starts a Write of Sector(s), completed with USBH_write_done
+  * @param  lun: Logical unit number
+  * @param  *buff: Data to be written, aligned to USBH_DMA_ALIGN and kept until completion
+  * @param  sector: Sector address (LBA)
+  * @param  count: Number of sectors to write (1..128)
+  * @retval DRESULT: Operation result
+  */
+#if _DISK_ASYNC > 0
+DRESULT USBH_write_start(BYTE lun, const BYTE *buff, DWORD sector, BYTE count)
+{
+  if (!USBH_IS_ALIGNED(buff))
+  {
+    return RES_PARERR;
+  }
+  if (USBH_MSC_StreamWrite(&HOST_HANDLE, lun, sector, (BYTE *)buff, count) != USBH_OK)
+  {
+    return USBH_write_error(lun);
+  }
+  return RES_OK;
+}
+
+/**
+  * @brief  Polls the Write started with USBH_write_start
+  * @param  lun: Logical unit number
+  * @param  *res: Operation result, set once the Write is completed
+  * @retval 1 if the Write is completed, 0 while it is in progress
+  */
+uint8_t USBH_write_done(BYTE lun, DRESULT *res)
+{
+  USBH_StatusTypeDef  status;
+  
+  status = USBH_MSC_StreamProcess(&HOST_HANDLE);
+  if(status == USBH_BUSY)
+  {
+    return 0;
+  }
+  *res = (status == USBH_OK) ? RES_OK : USBH_write_error(lun);
+  return 1;
+}
+
+/**
+  * @brief  Waits for the end of the Write started with USBH_write_start.
+  *         With USBH_USE_OS the host task completes it and the caller is
+  *         blocked meanwhile.
+  * @param  lun: Logical unit number
+  * @retval None
+  */
+void USBH_write_wait(BYTE lun)
+{
+  USBH_MSC_StreamWait(&HOST_HANDLE);
+}
+#endif /* _DISK_ASYNC > 0 */
+
 /**
   * @brief  I/O control operation
+  * @param  lun: Logical unit number
   * @param  cmd: Control code
   * @param  *buff: Buffer to send/receive control data
   * @retval DRESULT: Operation result
   */
 #if _USE_IOCTL == 1
-DRESULT USBH_ioctl(BYTE cmd, void *buff)
+DRESULT USBH_ioctl(BYTE lun, BYTE cmd, void *buff)
 {
   DRESULT res = RES_ERROR;
   MSC_LUNTypeDef info;
@@ -239,7 +424,7 @@ DRESULT USBH_ioctl(BYTE cmd, void *buff)
     
   /* Get number of sectors on the disk (DWORD) */  
   case GET_SECTOR_COUNT : 
-    if(USBH_MSC_GetLUNInfo(&HOST_HANDLE, 0, &info) == USBH_OK)
+    if(USBH_MSC_GetLUNInfo(&HOST_HANDLE, lun, &info) == USBH_OK)
     {
       *(DWORD*)buff = info.capacity.block_nbr;
       res = RES_OK;
@@ -252,7 +437,7 @@ DRESULT USBH_ioctl(BYTE cmd, void *buff)
     
   /* Get R/W sector size (WORD) */  
   case GET_SECTOR_SIZE :	
-    if(USBH_MSC_GetLUNInfo(&HOST_HANDLE, 0, &info) == USBH_OK)
+    if(USBH_MSC_GetLUNInfo(&HOST_HANDLE, lun, &info) == USBH_OK)
     {
       *(DWORD*)buff = info.capacity.block_size;
       res = RES_OK;
@@ -266,7 +451,7 @@ DRESULT USBH_ioctl(BYTE cmd, void *buff)
     /* Get erase block size in unit of sector (DWORD) */ 
   case GET_BLOCK_SIZE : 
     
-    if(USBH_MSC_GetLUNInfo(&HOST_HANDLE, 0, &info) == USBH_OK)
+    if(USBH_MSC_GetLUNInfo(&HOST_HANDLE, lun, &info) == USBH_OK)
     {
       *(DWORD*)buff = info.capacity.block_size;
       res = RES_OK;
@@ -144,7 +144,63 @@
 #define LEAVE_FF(fs, res)	return res
 #endif
 
-#define	ABORT(fs, res)		{ fp->err = (BYTE)(res); LEAVE_FF(fs, res); }
+/* At _FS_REENTRANT == 2, the file functions lock the file object and then the
+/  volume, and f_read/f_write release the volume lock between the sectors so
+/  that the accesses to other files can go on. */
+#if _FS_REENTRANT == 2
+#define	LEAVE_FP(fp, res)	{ unlock_fp(fp, res); return res; }
+#define	YIELD_FS(fp)		do { unlock_fs((fp)->fs, FR_OK); if (!lock_fs((fp)->fs)) { ff_rel_grant((fp)->sobj); return FR_TIMEOUT; } } while (0)
+#else
+#define	validate_fp(fp)		validate(fp)
+#define	LEAVE_FP(fp, res)	LEAVE_FF((fp)->fs, res)
+#define	YIELD_FS(fp)		do { } while (0)
+#endif
+
+#define	ABORT(fs, res)		{ fp->err = (BYTE)(res); LEAVE_FP(fp, res); }
+
+
+/* Size of the file data to be preserved on a partial sector write. The
+/  area allocated by f_expand has no data to be read into the sector buffer. */
+#if _USE_EXPAND && !_FS_READONLY
+#define VALID_SIZE(fp)	((fp)->vsize)
+#else
+#define VALID_SIZE(fp)	((fp)->fsize)
+#endif
+
+
+/* Sector cache */
+#if _FS_CACHE && _FS_TINY
+#error _FS_CACHE cannot be used at tiny cfg.
+#endif
+
+
+/* Free cluster map */
+#if _FS_FREEMAP && _FS_READONLY
+#error _FS_FREEMAP must be 0 at read-only cfg.
+#endif
+
+
+/* Directory hash index */
+#if _FS_DIRHASH && (_FS_DIRHASH < 16 || _FS_DIRHASH > 32768)
+#error Wrong _FS_DIRHASH setting
+#endif
+#define DH_FULL		(_FS_DIRHASH / 4 * 3)	/* Maximum number of names in the index */
+
+
+/* Vectored transfer */
+#if _USE_WRITEV
+#if _FS_TINY
+#error _USE_WRITEV cannot be used at tiny cfg.
+#endif
+#define MAX_XFER	128		/* Maximum number of sectors in a direct transfer */
+#endif
+
+
+/* Append log */
+#if _USE_LOG && (!_USE_EXPAND || _FS_READONLY)
+#error _USE_LOG needs _USE_EXPAND at read/write cfg.
+#endif
+#define	LOG_HDR		8		/* Size of the record header (length, inverted length and CRC) */
 
 
 /* File access control feature */
@@ -629,6 +685,22 @@ void unlock_fs (
 #endif
 
 
+#if _FS_REENTRANT == 2
+static
+void unlock_fp (
+	FIL* fp,		/* File object */
+	FRESULT res		/* Result code to be returned */
+)
+{
+	if (res != FR_INVALID_OBJECT &&
+		res != FR_TIMEOUT) {
+		unlock_fs(fp->fs, res);
+		ff_rel_grant(fp->sobj);
+	}
+}
+#endif
+
+
 
 
 /*-----------------------------------------------------------------------*/
@@ -748,25 +820,159 @@ void clear_lock (	/* Clear lock entries of the volume */
 /*-----------------------------------------------------------------------*/
 #if !_FS_READONLY
 static
-FRESULT sync_window (
-	FATFS* fs		/* File system object */
+FRESULT write_sector (	/* FR_OK: successful, FR_DISK_ERR: failed */
+	FATFS* fs,			/* File system object */
+	const BYTE* buff,	/* Sector data to be written */
+	DWORD sect			/* Sector number */
 )
 {
-	DWORD wsect;
 	UINT nf;
 
 
+	if (disk_write(fs->drv, buff, sect, 1))
+		return FR_DISK_ERR;
+	if (sect - fs->fatbase < fs->fsize) {		/* Is it in the FAT area? */
+		for (nf = fs->n_fats; nf >= 2; nf--) {	/* Reflect the change to all FAT copies */
+			sect += fs->fsize;
+			disk_write(fs->drv, buff, sect, 1);
+		}
+	}
+	return FR_OK;
+}
+#endif
+
+
+#if _FS_CACHE
+/* The sector cache holds the sectors that recently left the window. A
+/  sector is never in the window and in the cache at the same time. */
+
+static
+void drop_cache (
+	FATFS* fs,		/* File system object */
+	DWORD sect		/* Sector number to be removed from the cache (0xFFFFFFFF:all) */
+)
+{
+	UINT i;
+
+
+	for (i = 0; i < _FS_CACHE; i++) {
+		if (sect == 0xFFFFFFFF || fs->csect[i] == sect) {
+			fs->csect[i] = 0xFFFFFFFF;
+			fs->cstamp[i] = 0;
+			fs->cflag[i] = 0;
+		}
+	}
+}
+
+
+#if !_FS_READONLY
+static
+FRESULT flush_cache (	/* FR_OK: successful, FR_DISK_ERR: failed */
+	FATFS* fs		/* File system object */
+)
+{
+	DWORD sect, ofs;
+	UINT i, n, nf;
+
+
+	/* Write the dirty sectors in ascending order, then the FAT sectors
+	   again to each FAT copy in the same order */
+	for (nf = 0; nf < fs->n_fats; nf++) {
+		ofs = nf * fs->fsize;
+		sect = 0;
+		for (;;) {
+			n = _FS_CACHE;						/* Find the lowest dirty sector not written yet */
+			for (i = 0; i < _FS_CACHE; i++) {
+				if (fs->cflag[i] && fs->csect[i] >= sect && (n == _FS_CACHE || fs->csect[i] < fs->csect[n]))
+					n = i;
+			}
+			if (n == _FS_CACHE) break;
+			sect = fs->csect[n];
+			if (nf == 0) {
+				if (disk_write(fs->drv, fs->cbuf.d8[n], sect, 1))
+					return FR_DISK_ERR;
+			} else {
+				if (sect - fs->fatbase < fs->fsize)	/* Reflect the FAT sector to the FAT copy */
+					disk_write(fs->drv, fs->cbuf.d8[n], sect + ofs, 1);
+			}
+			sect++;
+		}
+	}
+	for (i = 0; i < _FS_CACHE; i++) fs->cflag[i] = 0;
+
+	return FR_OK;
+}
+#endif
+
+
+static
+FRESULT load_cache (	/* FR_OK: successful, FR_DISK_ERR: failed */
+	FATFS* fs,		/* File system object */
+	DWORD sector	/* Sector number to make appearance in the fs->win.d8[] */
+)
+{
+	UINT i, n, t, *s, *d;
+	BYTE hit, dirty = 0;
+
+
+	for (n = 0; n < _FS_CACHE && fs->csect[n] != sector; n++) ;	/* Find the sector in the cache */
+	hit = (n < _FS_CACHE) ? 1 : 0;
+	if (hit) {								/* Exchange the window with the cached sector */
+		s = fs->win.d32; d = fs->cbuf.d32[n];
+		for (i = SS(fs) / 4; i; i--) {
+			t = *d; *d++ = *s; *s++ = t;
+		}
+		dirty = fs->cflag[n];
+	} else {								/* Move the window into the least recently used entry */
+		for (n = 0, i = 1; i < _FS_CACHE; i++) {
+			if (fs->cstamp[i] < fs->cstamp[n]) n = i;
+		}
+#if !_FS_READONLY
+		if (fs->cflag[n]) {					/* Write back the entry if it is dirty */
+			if (write_sector(fs, fs->cbuf.d8[n], fs->csect[n]) != FR_OK)
+				return FR_DISK_ERR;
+			fs->cflag[n] = 0;
+		}
+#endif
+		if (fs->winsect != 0xFFFFFFFF)
+			mem_cpy(fs->cbuf.d8[n], fs->win.d8, SS(fs));
+	}
+	if (fs->winsect != 0xFFFFFFFF) {		/* The sector leaving the window becomes the most recently used entry */
+		fs->csect[n] = fs->winsect;
+		fs->cflag[n] = fs->wflag;
+		fs->cstamp[n] = ++fs->ctime;
+	} else {
+		fs->csect[n] = 0xFFFFFFFF;
+		fs->cflag[n] = 0;
+		fs->cstamp[n] = 0;
+	}
+	fs->wflag = dirty;
+	fs->winsect = sector;
+	if (!hit) {								/* Load the sector from the disk */
+		if (disk_read(fs->drv, fs->win.d8, sector, 1)) {
+			fs->winsect = 0xFFFFFFFF;		/* Invalidate window */
+			return FR_DISK_ERR;
+		}
+	}
+
+	return FR_OK;
+}
+#endif /* _FS_CACHE */
+
+
+#if !_FS_READONLY
+static
+FRESULT sync_window (
+	FATFS* fs		/* File system object */
+)
+{
 	if (fs->wflag) {	/* Write back the sector if it is dirty */
-		wsect = fs->winsect;	/* Current sector number */
-		if (disk_write(fs->drv, fs->win.d8, wsect, 1))
+		if (write_sector(fs, fs->win.d8, fs->winsect) != FR_OK)
 			return FR_DISK_ERR;
 		fs->wflag = 0;
-		if (wsect - fs->fatbase < fs->fsize) {		/* Is it in the FAT area? */
-			for (nf = fs->n_fats; nf >= 2; nf--) {	/* Reflect the change to all FAT copies */
-				wsect += fs->fsize;
-				disk_write(fs->drv, fs->win.d8, wsect, 1);
-			}
-		}
+#if _FS_CACHE
+		drop_cache(fs, fs->winsect);	/* The window may have been set to a sector directly */
+#endif
 	}
 	return FR_OK;
 }
@@ -780,6 +986,10 @@ FRESULT move_window (
 )
 {
 	if (sector != fs->winsect) {	/* Changed current window */
+#if _FS_CACHE
+		if (load_cache(fs, sector) != FR_OK)
+			return FR_DISK_ERR;
+#else
 #if !_FS_READONLY
 		if (sync_window(fs) != FR_OK)
 			return FR_DISK_ERR;
@@ -787,6 +997,7 @@ FRESULT move_window (
 		if (disk_read(fs->drv, fs->win.d8, sector, 1))
 			return FR_DISK_ERR;
 		fs->winsect = sector;
+#endif
 	}
 
 	return FR_OK;
@@ -808,6 +1019,10 @@ FRESULT sync_fs (	/* FR_OK: successful, FR_DISK_ERR: failed */
 
 
 	res = sync_window(fs);
+#if _FS_CACHE
+	if (res == FR_OK)
+		res = flush_cache(fs);
+#endif
 	if (res == FR_OK) {
 		/* Update FSINFO sector if needed */
 		if (fs->fs_type == FS_FAT32 && fs->fsi_flag == 1) {
@@ -822,6 +1037,9 @@ FRESULT sync_fs (	/* FR_OK: successful, FR_DISK_ERR: failed */
 			fs->winsect = fs->volbase + 1;
 			disk_write(fs->drv, fs->win.d8, fs->winsect, 1);
 			fs->fsi_flag = 0;
+#if _FS_CACHE
+			drop_cache(fs, fs->winsect);
+#endif
 		}
 		/* Make sure that no pending write process in the physical drive */
 		if (disk_ioctl(fs->drv, CTRL_SYNC, 0) != RES_OK)
@@ -959,6 +1177,118 @@ FRESULT put_fat (
 
 
 
+/*-----------------------------------------------------------------------*/
+/* FAT handling - Free cluster map                                       */
+/*-----------------------------------------------------------------------*/
+#if _FS_FREEMAP
+/* The free cluster map holds the number of free clusters in each group of
+/  (1 << fs->fmap_sft) clusters. A group is counted on the FAT when the
+/  allocator or f_getfree needs it first, nothing is scanned at mount time.
+/  Groups without free cluster are skipped without reading the FAT. */
+
+static
+void init_fmap (
+	FATFS* fs		/* File system object */
+)
+{
+	UINT i;
+	BYTE sft;
+
+
+	for (sft = 7; ((fs->n_fatent - 1) >> sft) >= _FS_FREEMAP; sft++) ;	/* Smallest group size that fits in the map */
+	fs->fmap_sft = (sft <= 15) ? sft : 0;	/* Disable the map if a group is too large for a WORD counter */
+	for (i = 0; i < _FS_FREEMAP; i++)
+		fs->fmap[i] = 0xFFFF;				/* Not counted yet */
+}
+
+
+static
+FRESULT count_fmap (
+	FATFS* fs,		/* File system object */
+	UINT grp		/* Group number to be counted if not counted yet */
+)
+{
+	DWORD clst, ecl, stat, n;
+
+
+	if (fs->fmap[grp] != 0xFFFF) return FR_OK;	/* Already counted */
+
+	clst = (DWORD)grp << fs->fmap_sft;
+	ecl = clst + ((DWORD)1 << fs->fmap_sft);
+	if (clst < 2) clst = 2;
+	if (ecl > fs->n_fatent) ecl = fs->n_fatent;
+	for (n = 0; clst < ecl; clst++) {
+		stat = get_fat(fs, clst);
+		if (stat == 0xFFFFFFFF) return FR_DISK_ERR;
+		if (stat == 1) return FR_INT_ERR;
+		if (stat == 0) n++;
+	}
+	fs->fmap[grp] = (WORD)n;
+
+	return FR_OK;
+}
+
+
+static
+void update_fmap (
+	FATFS* fs,		/* File system object */
+	DWORD clst,		/* Cluster# allocated or released */
+	BYTE rel		/* 0:Allocated, 1:Released */
+)
+{
+	WORD *cnt;
+
+
+	if (fs->fmap_sft) {
+		cnt = &fs->fmap[clst >> fs->fmap_sft];
+		if (*cnt != 0xFFFF) {				/* Keep the counted groups up to date */
+			if (rel) (*cnt)++; else (*cnt)--;
+		}
+	}
+}
+
+
+static
+DWORD find_free (	/* 0:No free cluster, 1:Internal error, 0xFFFFFFFF:Disk error, >=2:Free cluster# */
+	FATFS* fs,		/* File system object */
+	DWORD scl		/* Cluster# to start the search after */
+)
+{
+	DWORD ncl, ecl, cs, left;
+	UINT grp;
+	FRESULT res;
+
+
+	ncl = scl;
+	left = fs->n_fatent - 2;					/* Number of clusters to be checked */
+	while (left) {
+		ncl++;									/* Next cluster */
+		if (ncl >= fs->n_fatent) ncl = 2;		/* Wrap around */
+		grp = (UINT)(ncl >> fs->fmap_sft);
+		res = count_fmap(fs, grp);
+		if (res != FR_OK) return (res == FR_DISK_ERR) ? 0xFFFFFFFF : 1;
+		if (fs->fmap[grp] == 0) {				/* No free cluster in the group, skip to the next group */
+			ecl = ((DWORD)grp + 1) << fs->fmap_sft;
+			if (ecl > fs->n_fatent) ecl = fs->n_fatent;
+			if (ecl - ncl >= left) break;
+			left -= ecl - ncl;
+			ncl = ecl - 1;
+			continue;
+		}
+		cs = get_fat(fs, ncl);					/* Get the cluster status */
+		if (cs == 0) return ncl;				/* Found a free cluster */
+		if (cs == 0xFFFFFFFF || cs == 1)		/* An error occurred */
+			return cs;
+		left--;
+	}
+
+	return 0;	/* No free cluster */
+}
+#endif /* _FS_FREEMAP */
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* FAT handling - Remove a cluster chain                                 */
 /*-----------------------------------------------------------------------*/
@@ -991,6 +1321,9 @@ FRESULT remove_chain (
 				fs->free_clust++;
 				fs->fsi_flag |= 1;
 			}
+#if _FS_FREEMAP
+			update_fmap(fs, clst, 1);			/* Update free cluster map */
+#endif
 #if _USE_ERASE
 			if (ecl + 1 == nxt) {	/* Is next cluster contiguous? */
 				ecl = nxt;
@@ -1037,18 +1370,26 @@ DWORD create_chain (	/* 0:No free cluster, 1:Internal error, 0xFFFFFFFF:Disk err
 		scl = clst;
 	}
 
-	ncl = scl;				/* Start cluster */
-	for (;;) {
-		ncl++;							/* Next cluster */
-		if (ncl >= fs->n_fatent) {		/* Wrap around */
-			ncl = 2;
-			if (ncl > scl) return 0;	/* No free cluster */
+#if _FS_FREEMAP
+	if (fs->fmap_sft) {		/* Find a free cluster with the free cluster map */
+		ncl = find_free(fs, scl);
+		if (ncl < 2 || ncl == 0xFFFFFFFF) return ncl;
+	} else
+#endif
+	{
+		ncl = scl;				/* Start cluster */
+		for (;;) {
+			ncl++;							/* Next cluster */
+			if (ncl >= fs->n_fatent) {		/* Wrap around */
+				ncl = 2;
+				if (ncl > scl) return 0;	/* No free cluster */
+			}
+			cs = get_fat(fs, ncl);			/* Get the cluster status */
+			if (cs == 0) break;				/* Found a free cluster */
+			if (cs == 0xFFFFFFFF || cs == 1)/* An error occurred */
+				return cs;
+			if (ncl == scl) return 0;		/* No free cluster */
 		}
-		cs = get_fat(fs, ncl);			/* Get the cluster status */
-		if (cs == 0) break;				/* Found a free cluster */
-		if (cs == 0xFFFFFFFF || cs == 1)/* An error occurred */
-			return cs;
-		if (ncl == scl) return 0;		/* No free cluster */
 	}
 
 	res = put_fat(fs, ncl, 0x0FFFFFFF);	/* Mark the new cluster "last link" */
@@ -1061,6 +1402,9 @@ DWORD create_chain (	/* 0:No free cluster, 1:Internal error, 0xFFFFFFFF:Disk err
 			fs->free_clust--;
 			fs->fsi_flag |= 1;
 		}
+#if _FS_FREEMAP
+		update_fmap(fs, ncl, 0);		/* Update free cluster map */
+#endif
 	} else {
 		ncl = (res == FR_DISK_ERR) ? 0xFFFFFFFF : 1;
 	}
@@ -1217,6 +1561,22 @@ FRESULT dir_next (	/* FR_OK:Succeeded, FR_NO_FILE:End of table, FR_DENIED:Could
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Directory handling - Start cluster of the directory hash index        */
+/*-----------------------------------------------------------------------*/
+#if _FS_DIRHASH
+static
+DWORD dh_dir (			/* Start cluster of the directory (root directory of FAT32 as its cluster#) */
+	DIR* dp				/* Pointer to the directory object */
+)
+{
+	return (!dp->sclust && dp->fs->fs_type == FS_FAT32) ? dp->fs->dirbase : dp->sclust;
+}
+#endif
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Directory handling - Reserve directory entry                          */
 /*-----------------------------------------------------------------------*/
@@ -1230,15 +1590,26 @@ FRESULT dir_alloc (
 {
 	FRESULT res;
 	UINT n;
+	WORD idx = 0;
+#if _FS_DIRHASH
+	WORD fb = 0xFFFF;
+#endif
 
 
-	res = dir_sdi(dp, 0);
+#if _FS_DIRHASH
+	if (dp->fs->dh_clust == dh_dir(dp))	/* Indexed directory has no blank entry before dh_free */
+		idx = dp->fs->dh_free;
+#endif
+	res = dir_sdi(dp, idx);
 	if (res == FR_OK) {
 		n = 0;
 		do {
 			res = move_window(dp->fs, dp->sect);
 			if (res != FR_OK) break;
 			if (dp->dir[0] == DDE || dp->dir[0] == 0) {	/* Is it a blank entry? */
+#if _FS_DIRHASH
+				if (fb == 0xFFFF) fb = dp->index;	/* First blank entry */
+#endif
 				if (++n == nent) break;	/* A block of contiguous entries is found */
 			} else {
 				n = 0;					/* Not a blank entry. Restart to search */
@@ -1246,6 +1617,10 @@ FRESULT dir_alloc (
 			res = dir_next(dp, 1);		/* Next entry with table stretch enabled */
 		} while (res == FR_OK);
 	}
+#if _FS_DIRHASH
+	if (res == FR_OK && dp->fs->dh_clust == dh_dir(dp))	/* Blank entries before the block are left */
+		dp->fs->dh_free = (fb < dp->index - nent + 1) ? fb : dp->index;
+#endif
 	if (res == FR_NO_FILE) res = FR_DENIED;	/* No directory entry to allocate */
 	return res;
 }
@@ -1467,8 +1842,10 @@ BYTE sum_sfn (
 /*-----------------------------------------------------------------------*/
 
 static
-FRESULT dir_find (
-	DIR* dp			/* Pointer to the directory object linked to the file name */
+FRESULT dir_scan (
+	DIR* dp,		/* Pointer to the directory object linked to the file name */
+	WORD idx,		/* Index to start the search */
+	int one			/* 0:Search up to end of table, 1:Check only the object at idx */
 )
 {
 	FRESULT res;
@@ -1477,7 +1854,7 @@ FRESULT dir_find (
 	BYTE a, ord, sum;
 #endif
 
-	res = dir_sdi(dp, 0);			/* Rewind directory object */
+	res = dir_sdi(dp, idx);			/* Rewind directory object */
 	if (res != FR_OK) return res;
 
 #if _USE_LFN
@@ -1514,6 +1891,9 @@ FRESULT dir_find (
 		if (!(dir[DIR_Attr] & AM_VOL) && !mem_cmp(dir, dp->fn, 11)) /* Is it a valid entry? */
 			break;
 #endif
+		if (one && (dir[DIR_Name] == DDE || (dir[DIR_Attr] & AM_MASK) != AM_LFN)) {	/* The object did not match */
+			res = FR_NO_FILE; break;
+		}
 		res = dir_next(dp, 0);		/* Next entry */
 	} while (res == FR_OK);
 
@@ -1522,67 +1902,328 @@ FRESULT dir_find (
 
 
 
+#if _FS_DIRHASH
+/* The directory hash index holds the names of the objects in one directory
+/  as hash values tied to the index of the first entry of the object (LFN or
+/  SFN), so that a name is found without reading the whole directory. A hit
+/  is checked on the directory entries, the hash values are only a filter.
+/  The index is built on the first directory searched and is taken over by
+/  a larger directory whose table had to be read to the end. A directory
+/  with more names than the index can hold is searched as before. */
 
-/*-----------------------------------------------------------------------*/
-/* Read an object from the directory                                     */
-/*-----------------------------------------------------------------------*/
-#if _FS_MINIMIZE <= 1 || _USE_LABEL || _FS_RPATH >= 2
 static
-FRESULT dir_read (
-	DIR* dp,		/* Pointer to the directory object */
-	int vol			/* Filtered by 0:file/directory or 1:volume label */
+DWORD dh_sfn (			/* Hash value of an SFN */
+	const BYTE* sfn		/* Pointer to the SFN (11 bytes) */
 )
 {
-	FRESULT res;
-	BYTE a, c, *dir;
-#if _USE_LFN
-	BYTE ord = 0xFF, sum = 0xFF;
-#endif
+	DWORD h = 2166136261;
+	UINT n = 11;
 
-	res = FR_NO_FILE;
-	while (dp->sect) {
-		res = move_window(dp->fs, dp->sect);
-		if (res != FR_OK) break;
-		dir = dp->dir;					/* Ptr to the directory entry of current index */
-		c = dir[DIR_Name];
-		if (c == 0) { res = FR_NO_FILE; break; }	/* Reached to end of table */
-		a = dir[DIR_Attr] & AM_MASK;
-#if _USE_LFN	/* LFN configuration */
-		if (c == DDE || (!_FS_RPATH && c == '.') || (int)(a == AM_VOL) != vol) {	/* An entry without valid data */
-			ord = 0xFF;
-		} else {
-			if (a == AM_LFN) {			/* An LFN entry is found */
-				if (c & LLE) {			/* Is it start of LFN sequence? */
-					sum = dir[LDIR_Chksum];
-					c &= ~LLE; ord = c;
-					dp->lfn_idx = dp->index;
-				}
-				/* Check LFN validity and capture it */
-				ord = (c == ord && sum == dir[LDIR_Chksum] && pick_lfn(dp->lfn, dir)) ? ord - 1 : 0xFF;
-			} else {					/* An SFN entry is found */
-				if (ord || sum != sum_sfn(dir))	/* Is there a valid LFN? */
-					dp->lfn_idx = 0xFFFF;		/* It has no LFN. */
-				break;
-			}
-		}
-#else		/* Non LFN configuration */
-		if (c != DDE && (_FS_RPATH || c != '.') && a != AM_LFN && (int)(a == AM_VOL) == vol)	/* Is it a valid entry? */
-			break;
-#endif
-		res = dir_next(dp, 0);				/* Next entry */
-		if (res != FR_OK) break;
-	}
+	do h = (h ^ *sfn++) * 16777619; while (--n);
+	return h;
+}
 
-	if (res != FR_OK) dp->sect = 0;
 
-	return res;
-}
-#endif	/* _FS_MINIMIZE <= 1 || _USE_LABEL || _FS_RPATH >= 2 */
+#if _USE_LFN
+static
+DWORD dh_seg (			/* Hash value of an LFN segment (0:Empty segment) */
+	const BYTE* dir		/* Pointer to the LFN entry */
+)
+{
+	DWORD h;
+	WCHAR wc;
+	UINT s;
 
 
+	wc = LD_WORD(dir+LfnOfs[0]);
+	if (!wc) return 0;
+	h = 2166136261 ^ (dir[LDIR_Ord] & ~LLE);	/* Segments are hashed separately, they are stored in reverse order */
+	s = 0;
+	do {
+		h = (h ^ ff_wtoupper(wc)) * 16777619;
+	} while (++s < 13 && (wc = LD_WORD(dir+LfnOfs[s])) != 0);
+	return h;
+}
 
 
-/*-----------------------------------------------------------------------*/
+static
+DWORD dh_lfn (			/* Hash value of an LFN, sum of the hash values of the segments */
+	const WCHAR* lfn	/* Pointer to the LFN */
+)
+{
+	DWORD h = 0, hs;
+	UINT i = 0, n;
+	BYTE ord = 0;
+
+
+	while (lfn[i]) {
+		hs = 2166136261 ^ ++ord;
+		n = 13;
+		do {
+			hs = (hs ^ ff_wtoupper(lfn[i++])) * 16777619;
+		} while (--n && lfn[i]);
+		h += hs;
+	}
+	return h;
+}
+#endif
+
+
+static
+void dh_put (
+	FATFS* fs,		/* File system object */
+	DWORD hash,		/* Hash value of the name */
+	WORD idx		/* Index of the first entry of the object */
+)
+{
+	UINT i;
+	WORD tag;
+
+
+	if (fs->dh_clust == 1) return;			/* Index not in use */
+	if (fs->dh_cnt >= DH_FULL) {			/* Too many names: the directory is searched without index */
+		fs->dh_over = fs->dh_clust;
+		fs->dh_clust = 1;
+		return;
+	}
+	tag = (WORD)(hash ^ (hash >> 16));
+	if (!tag) tag = 1;
+	for (i = tag % _FS_DIRHASH; fs->dh_tbl[i]; i = (i + 1) % _FS_DIRHASH) ;	/* Find an empty slot */
+	fs->dh_tbl[i] = (DWORD)tag << 16 | idx;
+	fs->dh_cnt++;
+}
+
+
+#if !_FS_READONLY && !_FS_MINIMIZE
+static
+void dh_del (
+	FATFS* fs,		/* File system object */
+	WORD sidx,		/* Index range of the entries of the removed object */
+	WORD eidx
+)
+{
+	UINT i, j, k, h;
+	WORD idx;
+
+
+	for (i = 0; i < _FS_DIRHASH; ) {
+		idx = (WORD)fs->dh_tbl[i];
+		if (!fs->dh_tbl[i] || idx < sidx || idx > eidx) {
+			i++; continue;
+		}
+		j = i;								/* Delete the slot and move up the following slots of the cluster */
+		for (;;) {
+			fs->dh_tbl[j] = 0;
+			k = j;
+			do {
+				k = (k + 1) % _FS_DIRHASH;
+				if (!fs->dh_tbl[k]) break;
+				h = (fs->dh_tbl[k] >> 16) % _FS_DIRHASH;	/* Home slot of the name */
+			} while (j < k ? (j < h && h <= k) : (j < h || h <= k));	/* Left in place if the home is in (j, k] */
+			if (!fs->dh_tbl[k]) break;
+			fs->dh_tbl[j] = fs->dh_tbl[k];
+			j = k;
+		}
+		fs->dh_cnt--;
+	}
+}
+#endif
+
+
+static
+FRESULT dh_build (
+	DIR* dp			/* Pointer to the directory object to be indexed */
+)
+{
+	FRESULT res;
+	FATFS *fs = dp->fs;
+	BYTE c, *dir;
+#if _USE_LFN
+	BYTE a, ord = 0xFF, sum = 0xFF;
+	WORD is = 0;
+	DWORD h = 0;
+#endif
+
+
+	mem_set(fs->dh_tbl, 0, sizeof fs->dh_tbl);
+	fs->dh_cnt = 0;
+	fs->dh_free = 0xFFFF;
+	fs->dh_clust = dh_dir(dp);
+	res = dir_sdi(dp, 0);
+	while (res == FR_OK) {
+		res = move_window(fs, dp->sect);
+		if (res != FR_OK) break;
+		dir = dp->dir;
+		c = dir[DIR_Name];
+		if ((c == 0 || c == DDE) && fs->dh_free == 0xFFFF)
+			fs->dh_free = dp->index;		/* First blank entry */
+		if (c == 0) break;					/* Reached to end of table */
+#if _USE_LFN	/* Same validation of the entries as dir_find */
+		a = dir[DIR_Attr] & AM_MASK;
+		if (c == DDE || ((a & AM_VOL) && a != AM_LFN)) {
+			ord = 0xFF;
+		} else {
+			if (a == AM_LFN) {
+				if (c & LLE) {
+					sum = dir[LDIR_Chksum];
+					c &= ~LLE; ord = c;
+					is = dp->index; h = 0;
+				}
+				if (c == ord && sum == dir[LDIR_Chksum]) {
+					h += dh_seg(dir); ord--;
+				} else {
+					ord = 0xFF;
+				}
+			} else {
+				if (!ord && sum == sum_sfn(dir)) {	/* The object has an LFN */
+					dh_put(fs, h, is);
+				} else {
+					is = dp->index;
+				}
+				dh_put(fs, dh_sfn(dir), is);
+				ord = 0xFF;
+			}
+		}
+#else
+		if (c != DDE && !(dir[DIR_Attr] & AM_VOL))
+			dh_put(fs, dh_sfn(dir), dp->index);
+#endif
+		res = dir_next(dp, 0);
+	}
+	fs->dh_nent = dp->index;
+	if (fs->dh_free > dp->index) fs->dh_free = dp->index;
+	if (res == FR_NO_FILE) res = FR_OK;
+	if (res != FR_OK) fs->dh_clust = 1;		/* Discard the index on error */
+
+	return res;
+}
+
+
+static
+FRESULT dh_find (	/* FR_OK:Found, FR_NO_FILE:Not found */
+	DIR* dp			/* Pointer to the directory object linked to the file name */
+)
+{
+	FRESULT res;
+	FATFS *fs = dp->fs;
+	DWORD hash[2], v;
+	UINT n = 0, i, k;
+	WORD tag;
+
+
+#if _USE_LFN
+	if (dp->lfn && dp->lfn[0]) hash[n++] = dh_lfn(dp->lfn);
+	if (!(dp->fn[NS] & NS_LOSS)) hash[n++] = dh_sfn(dp->fn);
+#else
+	hash[n++] = dh_sfn(dp->fn);
+#endif
+	for (k = 0; k < n; k++) {
+		tag = (WORD)(hash[k] ^ (hash[k] >> 16));
+		if (!tag) tag = 1;
+		for (i = tag % _FS_DIRHASH; (v = fs->dh_tbl[i]) != 0; i = (i + 1) % _FS_DIRHASH) {
+			if ((WORD)(v >> 16) == tag) {	/* Check the object tied to the hash value */
+				res = dir_scan(dp, (WORD)v, 1);
+				if (res != FR_NO_FILE) return res;
+			}
+		}
+	}
+
+	return FR_NO_FILE;
+}
+#endif /* _FS_DIRHASH */
+
+
+static
+FRESULT dir_find (
+	DIR* dp			/* Pointer to the directory object linked to the file name */
+)
+{
+#if _FS_DIRHASH
+	FRESULT res;
+	DWORD dcl = dh_dir(dp);
+
+
+	if (dp->fs->dh_clust == 1 && dcl != dp->fs->dh_over) {	/* Build the index if not in use */
+		res = dh_build(dp);
+		if (res != FR_OK) return res;
+	}
+	if (dp->fs->dh_clust == dcl)			/* Look up the name in the index */
+		return dh_find(dp);
+
+	res = dir_scan(dp, 0, 0);
+	if (res == FR_NO_FILE && dp->index > dp->fs->dh_nent && dcl != dp->fs->dh_over) {	/* A larger directory takes over the index */
+		res = dh_build(dp);
+		if (res == FR_OK) res = FR_NO_FILE;
+	}
+	return res;
+#else
+	return dir_scan(dp, 0, 0);
+#endif
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Read an object from the directory                                     */
+/*-----------------------------------------------------------------------*/
+#if _FS_MINIMIZE <= 1 || _USE_LABEL || _FS_RPATH >= 2
+static
+FRESULT dir_read (
+	DIR* dp,		/* Pointer to the directory object */
+	int vol			/* Filtered by 0:file/directory or 1:volume label */
+)
+{
+	FRESULT res;
+	BYTE a, c, *dir;
+#if _USE_LFN
+	BYTE ord = 0xFF, sum = 0xFF;
+#endif
+
+	res = FR_NO_FILE;
+	while (dp->sect) {
+		res = move_window(dp->fs, dp->sect);
+		if (res != FR_OK) break;
+		dir = dp->dir;					/* Ptr to the directory entry of current index */
+		c = dir[DIR_Name];
+		if (c == 0) { res = FR_NO_FILE; break; }	/* Reached to end of table */
+		a = dir[DIR_Attr] & AM_MASK;
+#if _USE_LFN	/* LFN configuration */
+		if (c == DDE || (!_FS_RPATH && c == '.') || (int)(a == AM_VOL) != vol) {	/* An entry without valid data */
+			ord = 0xFF;
+		} else {
+			if (a == AM_LFN) {			/* An LFN entry is found */
+				if (c & LLE) {			/* Is it start of LFN sequence? */
+					sum = dir[LDIR_Chksum];
+					c &= ~LLE; ord = c;
+					dp->lfn_idx = dp->index;
+				}
+				/* Check LFN validity and capture it */
+				ord = (c == ord && sum == dir[LDIR_Chksum] && pick_lfn(dp->lfn, dir)) ? ord - 1 : 0xFF;
+			} else {					/* An SFN entry is found */
+				if (ord || sum != sum_sfn(dir))	/* Is there a valid LFN? */
+					dp->lfn_idx = 0xFFFF;		/* It has no LFN. */
+				break;
+			}
+		}
+#else		/* Non LFN configuration */
+		if (c != DDE && (_FS_RPATH || c != '.') && a != AM_LFN && (int)(a == AM_VOL) == vol)	/* Is it a valid entry? */
+			break;
+#endif
+		res = dir_next(dp, 0);				/* Next entry */
+		if (res != FR_OK) break;
+	}
+
+	if (res != FR_OK) dp->sect = 0;
+
+	return res;
+}
+#endif	/* _FS_MINIMIZE <= 1 || _USE_LABEL || _FS_RPATH >= 2 */
+
+
+
+
+/*-----------------------------------------------------------------------*/
 /* Register an object to the directory                                   */
 /*-----------------------------------------------------------------------*/
 #if !_FS_READONLY
@@ -1596,6 +2237,9 @@ FRESULT dir_register (	/* FR_OK:Successful, FR_DENIED:No free entry or too many
 	WORD n, ne;
 	BYTE sn[12], *fn, sum;
 	WCHAR *lfn;
+#if _FS_DIRHASH
+	WORD is;
+#endif
 
 
 	fn = dp->fn; lfn = dp->lfn;
@@ -1623,6 +2267,9 @@ FRESULT dir_register (	/* FR_OK:Successful, FR_DENIED:No free entry or too many
 		ne = 1;
 	}
 	res = dir_alloc(dp, ne);		/* Allocate entries */
+#if _FS_DIRHASH
+	is = (WORD)(dp->index - ne + 1);	/* Index of the first entry */
+#endif
 
 	if (res == FR_OK && --ne) {		/* Set LFN entry if needed */
 		res = dir_sdi(dp, (WORD)(dp->index - ne));
@@ -1652,6 +2299,17 @@ FRESULT dir_register (	/* FR_OK:Successful, FR_DENIED:No free entry or too many
 			dp->fs->wflag = 1;
 		}
 	}
+#if _FS_DIRHASH
+	if (res == FR_OK && dp->fs->dh_clust == dh_dir(dp)) {	/* Add the object to the directory index */
+#if _USE_LFN
+		if (sn[NS] & NS_LFN) dh_put(dp->fs, dh_lfn(lfn), is);
+		dh_put(dp->fs, dh_sfn(dp->fn), is);
+#else
+		dh_put(dp->fs, dh_sfn(dp->fn), dp->index);
+#endif
+		if (dp->index > dp->fs->dh_nent) dp->fs->dh_nent = dp->index;
+	}
+#endif
 
 	return res;
 }
@@ -1676,6 +2334,12 @@ FRESULT dir_remove (	/* FR_OK: Successful, FR_DISK_ERR: A disk error */
 	i = dp->index;	/* SFN index */
 	res = dir_sdi(dp, (WORD)((dp->lfn_idx == 0xFFFF) ? i : dp->lfn_idx));	/* Goto the SFN or top of the LFN entries */
 	if (res == FR_OK) {
+#if _FS_DIRHASH
+		if (dp->fs->dh_clust == dh_dir(dp)) {	/* Remove the object from the directory index */
+			dh_del(dp->fs, dp->index, i);
+			if (dp->index < dp->fs->dh_free) dp->fs->dh_free = dp->index;
+		}
+#endif
 		do {
 			res = move_window(dp->fs, dp->sect);
 			if (res != FR_OK) break;
@@ -1690,6 +2354,12 @@ FRESULT dir_remove (	/* FR_OK: Successful, FR_DISK_ERR: A disk error */
 #else			/* Non LFN configuration */
 	res = dir_sdi(dp, dp->index);
 	if (res == FR_OK) {
+#if _FS_DIRHASH
+		if (dp->fs->dh_clust == dh_dir(dp)) {	/* Remove the object from the directory index */
+			dh_del(dp->fs, dp->index, dp->index);
+			if (dp->index < dp->fs->dh_free) dp->fs->dh_free = dp->index;
+		}
+#endif
 		res = move_window(dp->fs, dp->sect);
 		if (res == FR_OK) {
 			*dp->dir = DDE;			/* Mark the entry "deleted" */
@@ -2093,6 +2763,9 @@ BYTE check_fs (	/* 0:FAT boor sector, 1:Valid boor sector but not FAT, 2:Not a b
 )
 {
 	fs->wflag = 0; fs->winsect = 0xFFFFFFFF;	/* Invaidate window */
+#if _FS_CACHE
+	drop_cache(fs, 0xFFFFFFFF);					/* Invalidate sector cache */
+#endif
 	if (move_window(fs, sect) != FR_OK)			/* Load boot record */
 		return 3;
 
@@ -2239,6 +2912,12 @@ FRESULT find_volume (	/* FR_OK(0): successful, !=0: any error occurred */
 	}
 	if (fs->fsize < (szbfat + (SS(fs) - 1)) / SS(fs))	/* (BPB_FATSz must not be less than required) */
 		return FR_NO_FILESYSTEM;
+#if _FS_FREEMAP
+	init_fmap(fs);										/* Free cluster map (counted on demand) */
+#endif
+#if _FS_DIRHASH
+	fs->dh_clust = fs->dh_over = 1;						/* Directory hash index (built on demand) */
+#endif
 
 #if !_FS_READONLY
 	/* Initialize cluster allocation information */
@@ -2301,6 +2980,30 @@ FRESULT validate (	/* FR_OK(0): The object is valid, !=0: Invalid */
 }
 
 
+#if _FS_REENTRANT == 2
+static
+FRESULT validate_fp (	/* FR_OK(0): The object is valid, !=0: Invalid */
+	FIL* fp				/* Pointer to the file object to check validity */
+)
+{
+	if (!fp || !fp->fs || !fp->fs->fs_type || fp->fs->id != fp->id)
+		return FR_INVALID_OBJECT;
+
+	if (!ff_req_grant(fp->sobj))	/* Lock the file object first */
+		return FR_TIMEOUT;
+	if (!lock_fs(fp->fs)) {			/* and then the file system */
+		ff_rel_grant(fp->sobj);
+		return FR_TIMEOUT;
+	}
+
+	if (disk_status(fp->fs->drv) & STA_NOINIT)
+		return FR_NOT_READY;
+
+	return FR_OK;
+}
+#endif
+
+
 
 
 /*--------------------------------------------------------------------------
@@ -2471,11 +3174,22 @@ FRESULT f_open (
 #endif
 		FREE_BUF();
 
+#if _FS_REENTRANT == 2
+		if (res == FR_OK && !ff_cre_syncobj(dj.fs->drv, &fp->sobj)) {	/* Create the file lock */
+#if _FS_LOCK
+			dec_lock(fp->lockid);
+#endif
+			res = FR_INT_ERR;
+		}
+#endif
 		if (res == FR_OK) {
 			fp->flag = mode;					/* File access mode */
 			fp->err = 0;						/* Clear error flag */
 			fp->sclust = ld_clust(dj.fs, dir);	/* File start cluster */
 			fp->fsize = LD_DWORD(dir+DIR_FileSize);	/* File size */
+#if _USE_EXPAND && !_FS_READONLY
+			fp->vsize = fp->fsize;
+#endif
 			fp->fptr = 0;						/* File pointer */
 			fp->dsect = 0;
 #if _USE_FASTSEEK
@@ -2506,23 +3220,27 @@ FRESULT f_read (
 	FRESULT res;
 	DWORD clst, sect, remain;
 	UINT rcnt, cc;
+#if _USE_WRITEV
+	UINT n;
+#endif
 	BYTE csect, *rbuff = (BYTE*)buff;
 
 
 	*br = 0;	/* Clear read byte counter */
 
-	res = validate(fp);							/* Check validity */
-	if (res != FR_OK) LEAVE_FF(fp->fs, res);
+	res = validate_fp(fp);							/* Check validity */
+	if (res != FR_OK) LEAVE_FP(fp, res);
 	if (fp->err)								/* Check error */
-		LEAVE_FF(fp->fs, (FRESULT)fp->err);
+		LEAVE_FP(fp, (FRESULT)fp->err);
 	if (!(fp->flag & FA_READ)) 					/* Check access mode */
-		LEAVE_FF(fp->fs, FR_DENIED);
+		LEAVE_FP(fp, FR_DENIED);
 	remain = fp->fsize - fp->fptr;
 	if (btr > remain) btr = (UINT)remain;		/* Truncate btr by remaining bytes */
 
 	for ( ;  btr;								/* Repeat until all data read */
 		rbuff += rcnt, fp->fptr += rcnt, *br += rcnt, btr -= rcnt) {
 		if ((fp->fptr % SS(fp->fs)) == 0) {		/* On the sector boundary? */
+			if (*br) YIELD_FS(fp);				/* Let other files access the volume */
 			csect = (BYTE)(fp->fptr / SS(fp->fs) & (fp->fs->csize - 1));	/* Sector offset in the cluster */
 			if (!csect) {						/* On the cluster boundary? */
 				if (fp->fptr == 0) {			/* On the top of the file? */
@@ -2544,9 +3262,20 @@ FRESULT f_read (
 			sect += csect;
 			cc = btr / SS(fp->fs);				/* When remaining bytes >= sector size, */
 			if (cc) {							/* Read maximum contiguous sectors directly */
+#if _USE_WRITEV
+				for (n = fp->fs->csize - csect; n < cc && n < MAX_XFER; n += fp->fs->csize) {	/* Continue over contiguous clusters */
+					clst = get_fat(fp->fs, fp->clust);
+					if (clst == 0xFFFFFFFF) ABORT(fp->fs, FR_DISK_ERR);
+					if (clst != fp->clust + 1) break;
+					fp->clust = clst;
+				}
+				if (cc > n) cc = n;				/* Clip at the end of the contiguous clusters */
+				if (cc > MAX_XFER) cc = MAX_XFER;
+#else
 				if (csect + cc > fp->fs->csize)	/* Clip at cluster boundary */
 					cc = fp->fs->csize - csect;
-				if (disk_read(fp->fs->drv, rbuff, sect, cc))
+#endif
+				if (disk_read(fp->fs->drv, rbuff, sect, (BYTE)cc))
 					ABORT(fp->fs, FR_DISK_ERR);
 #if !_FS_READONLY && _FS_MINIMIZE <= 2			/* Replace one of the read sectors with cached data if it contains a dirty sector */
 #if _FS_TINY
@@ -2586,7 +3315,7 @@ FRESULT f_read (
 #endif
 	}
 
-	LEAVE_FF(fp->fs, FR_OK);
+	LEAVE_FP(fp, FR_OK);
 }
 
 
@@ -2607,23 +3336,27 @@ FRESULT f_write (
 	FRESULT res;
 	DWORD clst, sect;
 	UINT wcnt, cc;
+#if _USE_WRITEV
+	UINT n, lim;
+#endif
 	const BYTE *wbuff = (const BYTE*)buff;
 	BYTE csect;
 
 
 	*bw = 0;	/* Clear write byte counter */
 
-	res = validate(fp);						/* Check validity */
-	if (res != FR_OK) LEAVE_FF(fp->fs, res);
+	res = validate_fp(fp);						/* Check validity */
+	if (res != FR_OK) LEAVE_FP(fp, res);
 	if (fp->err)							/* Check error */
-		LEAVE_FF(fp->fs, (FRESULT)fp->err);
+		LEAVE_FP(fp, (FRESULT)fp->err);
 	if (!(fp->flag & FA_WRITE))				/* Check access mode */
-		LEAVE_FF(fp->fs, FR_DENIED);
+		LEAVE_FP(fp, FR_DENIED);
 	if (fp->fptr + btw < fp->fptr) btw = 0;	/* File size cannot reach 4GB */
 
 	for ( ;  btw;							/* Repeat until all data written */
 		wbuff += wcnt, fp->fptr += wcnt, *bw += wcnt, btw -= wcnt) {
 		if ((fp->fptr % SS(fp->fs)) == 0) {	/* On the sector boundary? */
+			if (*bw) YIELD_FS(fp);			/* Let other files access the volume */
 			csect = (BYTE)(fp->fptr / SS(fp->fs) & (fp->fs->csize - 1));	/* Sector offset in the cluster */
 			if (!csect) {					/* On the cluster boundary? */
 				if (fp->fptr == 0) {		/* On the top of the file? */
@@ -2646,7 +3379,7 @@ FRESULT f_write (
 #if _FS_TINY
 			if (fp->fs->winsect == fp->dsect && sync_window(fp->fs))	/* Write-back sector cache */
 				ABORT(fp->fs, FR_DISK_ERR);
-#else
+#elif !_USE_WRITEV
 			if (fp->flag & FA__DIRTY) {		/* Write-back sector cache */
 				if (disk_write(fp->fs->drv, fp->buf.d8, fp->dsect, 1))
 					ABORT(fp->fs, FR_DISK_ERR);
@@ -2658,10 +3391,41 @@ FRESULT f_write (
 			sect += csect;
 			cc = btw / SS(fp->fs);			/* When remaining bytes >= sector size, */
 			if (cc) {						/* Write maximum contiguous sectors directly */
+#if _USE_WRITEV
+				if ((fp->flag & FA__DIRTY) && fp->dsect + 1 != sect) {	/* Write-back sector cache if it does not precede the data */
+					if (disk_write(fp->fs->drv, fp->buf.d8, fp->dsect, 1))
+						ABORT(fp->fs, FR_DISK_ERR);
+					fp->flag &= ~FA__DIRTY;
+				}
+				lim = (fp->flag & FA__DIRTY) ? MAX_XFER - 1 : MAX_XFER;	/* A gathered sector cache takes one sector of the transfer */
+				for (n = fp->fs->csize - csect; n < cc && n < lim; n += fp->fs->csize) {	/* Continue over contiguous clusters */
+#if _USE_FASTSEEK
+					if (fp->cltbl)
+						clst = clmt_clust(fp, fp->fptr + (DWORD)n * SS(fp->fs));	/* Get cluster# from the CLMT */
+					else
+#endif
+						clst = create_chain(fp->fs, fp->clust);	/* Follow or stretch cluster chain on the FAT */
+					if (clst == 1) ABORT(fp->fs, FR_INT_ERR);
+					if (clst == 0xFFFFFFFF) ABORT(fp->fs, FR_DISK_ERR);
+					if (clst != fp->clust + 1) break;	/* Not contiguous or disk full */
+					fp->clust = clst;
+				}
+				if (cc > n) cc = n;			/* Clip at the end of the contiguous clusters */
+				if (cc > lim) cc = lim;		/* fp->clust holds the last sector of the transfer */
+				if (fp->flag & FA__DIRTY) {	/* Gather the sector cache and the data into a transfer */
+					if (disk_writev(fp->fs->drv, fp->buf.d8, wbuff, fp->dsect, (BYTE)(cc + 1)))
+						ABORT(fp->fs, FR_DISK_ERR);
+					fp->flag &= ~FA__DIRTY;
+				} else {
+					if (disk_write(fp->fs->drv, wbuff, sect, (BYTE)cc))
+						ABORT(fp->fs, FR_DISK_ERR);
+				}
+#else
 				if (csect + cc > fp->fs->csize)	/* Clip at cluster boundary */
 					cc = fp->fs->csize - csect;
 				if (disk_write(fp->fs->drv, wbuff, sect, cc))
 					ABORT(fp->fs, FR_DISK_ERR);
+#endif
 #if _FS_MINIMIZE <= 2
 #if _FS_TINY
 				if (fp->fs->winsect - sect < cc) {	/* Refill sector cache if it gets invalidated by the direct write */
@@ -2679,13 +3443,20 @@ FRESULT f_write (
 				continue;
 			}
 #if _FS_TINY
-			if (fp->fptr >= fp->fsize) {	/* Avoid silly cache filling at growing edge */
+			if (fp->fptr >= VALID_SIZE(fp)) {	/* Avoid silly cache filling at growing edge */
 				if (sync_window(fp->fs)) ABORT(fp->fs, FR_DISK_ERR);
 				fp->fs->winsect = sect;
 			}
 #else
+#if _USE_WRITEV
+			if (fp->flag & FA__DIRTY) {		/* Write-back sector cache */
+				if (disk_write(fp->fs->drv, fp->buf.d8, fp->dsect, 1))
+					ABORT(fp->fs, FR_DISK_ERR);
+				fp->flag &= ~FA__DIRTY;
+			}
+#endif
 			if (fp->dsect != sect) {		/* Fill sector cache with file data */
-				if (fp->fptr < fp->fsize &&
+				if (fp->fptr < VALID_SIZE(fp) &&
 					disk_read(fp->fs->drv, fp->buf.d8, sect, 1))
 						ABORT(fp->fs, FR_DISK_ERR);
 			}
@@ -2706,9 +3477,12 @@ FRESULT f_write (
 	}
 
 	if (fp->fptr > fp->fsize) fp->fsize = fp->fptr;	/* Update file size if needed */
+#if _USE_EXPAND
+	if (fp->fptr > fp->vsize) fp->vsize = fp->fptr;	/* Update size of the written data */
+#endif
 	fp->flag |= FA__WRITTEN;						/* Set file change flag */
 
-	LEAVE_FF(fp->fs, FR_OK);
+	LEAVE_FP(fp, FR_OK);
 }
 
 
@@ -2727,14 +3501,14 @@ FRESULT f_sync (
 	BYTE *dir;
 
 
-	res = validate(fp);					/* Check validity of the object */
+	res = validate_fp(fp);					/* Check validity of the object */
 	if (res == FR_OK) {
 		if (fp->flag & FA__WRITTEN) {	/* Has the file been written? */
 			/* Write-back dirty buffer */
 #if !_FS_TINY
 			if (fp->flag & FA__DIRTY) {
 				if (disk_write(fp->fs->drv, fp->buf.d8, fp->dsect, 1))
-					LEAVE_FF(fp->fs, FR_DISK_ERR);
+					LEAVE_FP(fp, FR_DISK_ERR);
 				fp->flag &= ~FA__DIRTY;
 			}
 #endif
@@ -2755,7 +3529,7 @@ FRESULT f_sync (
 		}
 	}
 
-	LEAVE_FF(fp->fs, res);
+	LEAVE_FP(fp, res);
 }
 
 #endif /* !_FS_READONLY */
@@ -2779,7 +3553,7 @@ FRESULT f_close (
     if (res == FR_OK)
 #endif
     {
-        res = validate(fp);             /* Lock volume */
+        res = validate_fp(fp);             /* Lock volume */
         if (res == FR_OK) {
 #if _FS_REENTRANT
             FATFS *fs = fp->fs;
@@ -2791,6 +3565,11 @@ FRESULT f_close (
                 fp->fs = 0;             /* Invalidate file object */
 #if _FS_REENTRANT
             unlock_fs(fs, FR_OK);       /* Unlock volume */
+#endif
+#if _FS_REENTRANT == 2
+            ff_rel_grant(fp->sobj);     /* Unlock and delete the file lock */
+            if (res == FR_OK && !ff_del_syncobj(fp->sobj))
+                res = FR_INT_ERR;
 #endif
         }
     }
@@ -2947,10 +3726,10 @@ FRESULT f_lseek (
 	FRESULT res;
 
 
-	res = validate(fp);					/* Check validity of the object */
-	if (res != FR_OK) LEAVE_FF(fp->fs, res);
+	res = validate_fp(fp);					/* Check validity of the object */
+	if (res != FR_OK) LEAVE_FP(fp, res);
 	if (fp->err)						/* Check error */
-		LEAVE_FF(fp->fs, (FRESULT)fp->err);
+		LEAVE_FP(fp, (FRESULT)fp->err);
 
 #if _USE_FASTSEEK
 	if (fp->cltbl) {	/* Fast seek */
@@ -3087,7 +3866,7 @@ FRESULT f_lseek (
 #endif
 	}
 
-	LEAVE_FF(fp->fs, res);
+	LEAVE_FP(fp, res);
 }
 
 
@@ -3286,6 +4065,15 @@ FRESULT f_getfree (
 			/* Get number of free clusters */
 			fat = fs->fs_type;
 			n = 0;
+#if _FS_FREEMAP
+			if (fs->fmap_sft) {	/* Count the groups not counted yet and sum up the free cluster map */
+				for (i = 0; i <= (UINT)((fs->n_fatent - 1) >> fs->fmap_sft); i++) {
+					res = count_fmap(fs, i);
+					if (res != FR_OK) break;
+					n += fs->fmap[i];
+				}
+			} else
+#endif
 			if (fat == FS_FAT12) {
 				clst = 2;
 				do {
@@ -3337,7 +4125,7 @@ FRESULT f_truncate (
 	DWORD ncl;
 
 
-	res = validate(fp);						/* Check validity of the object */
+	res = validate_fp(fp);						/* Check validity of the object */
 	if (res == FR_OK) {
 		if (fp->err) {						/* Check error */
 			res = (FRESULT)fp->err;
@@ -3349,6 +4137,9 @@ FRESULT f_truncate (
 	if (res == FR_OK) {
 		if (fp->fsize > fp->fptr) {
 			fp->fsize = fp->fptr;	/* Set file size to current R/W point */
+#if _USE_EXPAND
+			if (fp->vsize > fp->fptr) fp->vsize = fp->fptr;
+#endif
 			fp->flag |= FA__WRITTEN;
 			if (fp->fptr == 0) {	/* When set file size to zero, remove entire cluster chain */
 				res = remove_chain(fp->fs, fp->sclust);
@@ -3375,7 +4166,7 @@ FRESULT f_truncate (
 		if (res != FR_OK) fp->err = (FRESULT)res;
 	}
 
-	LEAVE_FF(fp->fs, res);
+	LEAVE_FP(fp, res);
 }
 
 
@@ -3438,6 +4229,10 @@ FRESULT f_unlink (
 				if (res == FR_OK) {
 					if (dclst)				/* Remove the cluster chain if exist */
 						res = remove_chain(dj.fs, dclst);
+#if _FS_DIRHASH
+					if (dclst == dj.fs->dh_clust) dj.fs->dh_clust = 1;	/* The indexed directory is removed */
+					if (dclst == dj.fs->dh_over) dj.fs->dh_over = 1;
+#endif
 					if (res == FR_OK) res = sync_fs(dj.fs);
 				}
 			}
@@ -3851,43 +4646,396 @@ FRESULT f_setlabel (
 
 
 /*-----------------------------------------------------------------------*/
-/* Forward data to the stream directly (available on only tiny cfg)      */
+/* Allocate a Contiguous Cluster Chain to the File                       */
 /*-----------------------------------------------------------------------*/
-#if _USE_FORWARD && _FS_TINY
+#if _USE_EXPAND && !_FS_READONLY
 
-FRESULT f_forward (
+FRESULT f_expand (
+	FIL* fp,		/* Pointer to the file object */
+	DWORD fsz,		/* File size to be expanded to */
+	BYTE opt		/* Operation mode 0:Find and prepare or 1:Find and allocate */
+)
+{
+	FRESULT res;
+	FATFS *fs;
+	DWORD n, clst, scl, ncl, tcl, ecl, lclst;
+
+
+	res = validate_fp(fp);								/* Check validity of the object */
+	if (res != FR_OK) LEAVE_FP(fp, res);
+	if (fp->err)									/* Check error */
+		LEAVE_FP(fp, (FRESULT)fp->err);
+	if (fsz == 0 || fp->fsize != 0 || !(fp->flag & FA_WRITE))	/* Check if in valid condition */
+		LEAVE_FP(fp, FR_DENIED);
+	fs = fp->fs;
+	n = (DWORD)fs->csize * SS(fs);					/* Cluster size */
+	tcl = fsz / n + ((fsz & (n - 1)) ? 1 : 0);		/* Number of clusters required */
+	if (tcl > fs->n_fatent - 2 ||					/* Check if the volume can hold it at all */
+		(fs->free_clust <= fs->n_fatent - 2 && tcl > fs->free_clust))
+		LEAVE_FP(fp, FR_DENIED);
+	if (fp->sclust) {								/* Release the clusters left by f_lseek/f_write on an empty file */
+		res = remove_chain(fs, fp->sclust);
+		if (res != FR_OK) ABORT(fs, res);
+		fp->sclust = fp->clust = 0;
+		fp->fptr = 0;
+	}
+
+	/* Find a contiguous free block in a single pass over the FAT. The
+	   entries are read in ascending order, so each FAT sector is loaded
+	   into the window only once. */
+	clst = fs->last_clust;							/* Start from the suggested point */
+	if (clst < 2 || clst >= fs->n_fatent) clst = 2;
+	scl = clst; ncl = 0;
+	ecl = fs->n_fatent - 2;							/* Number of clusters left to check */
+	for (;;) {
+#if _FS_FREEMAP
+		if (fs->fmap_sft && fs->fmap[clst >> fs->fmap_sft] == 0) {	/* No free cluster in the group, skip it */
+			n = (((clst >> fs->fmap_sft) + 1) << fs->fmap_sft) - clst;	/* Number of clusters to the next group */
+			if (clst + n > fs->n_fatent) n = fs->n_fatent - clst;
+			ncl = 0;
+			if (ecl > n) ecl -= n; else ecl = 0;
+			clst += n;
+			if (clst >= fs->n_fatent) clst = 2;
+			if (!ecl) { res = FR_DENIED; break; }
+			continue;
+		}
+#endif
+		n = get_fat(fs, clst);						/* Get the cluster status */
+		if (n == 1) { res = FR_INT_ERR; break; }
+		if (n == 0xFFFFFFFF) { res = FR_DISK_ERR; break; }
+		if (n == 0) {								/* Is it a free cluster? */
+			if (ncl == 0) scl = clst;				/* Top of a free block */
+			if (++ncl == tcl) break;				/* Found a free block large enough */
+		} else {
+			ncl = 0;								/* Not free, the block is broken */
+		}
+		if (++clst >= fs->n_fatent) {				/* Wrap around (a block cannot span the end of the FAT) */
+			clst = 2; ncl = 0;
+		}
+		if (ecl) ecl--;								/* After a full lap, only finish the current block */
+		if (!ecl && !ncl) { res = FR_DENIED; break; }	/* No contiguous free block on the volume */
+	}
+
+	if (res == FR_OK) {
+		if (opt) {
+			/* Create the cluster chain. The entries are consecutive, so the
+			   FAT sectors are written back (to every FAT copy) once each. */
+			for (clst = scl, n = tcl; n; clst++, n--) {
+				res = put_fat(fs, clst, (n == 1) ? 0x0FFFFFFF : clst + 1);
+				if (res != FR_OK) break;
+#if _FS_FREEMAP
+				update_fmap(fs, clst, 0);
+#endif
+			}
+			lclst = scl + tcl - 1;
+		} else {
+			lclst = scl - 1;						/* Make the block the next allocation point */
+		}
+	}
+	if (res == FR_OK) {
+		fs->last_clust = lclst;						/* Update FSINFO */
+		if (opt) {
+			fp->sclust = scl;						/* Set the chain to the file */
+			fp->fsize = fsz;
+			fp->flag |= FA__WRITTEN;
+			if (fs->free_clust != 0xFFFFFFFF) {
+				fs->free_clust -= tcl;
+				fs->fsi_flag |= 1;
+			}
+		}
+	} else {
+		if (res != FR_DENIED) ABORT(fs, res);
+	}
+
+	LEAVE_FP(fp, res);
+}
+#endif /* _USE_EXPAND && !_FS_READONLY */
+
+
+
+
+#if _USE_LOG
+/*-----------------------------------------------------------------------*/
+/* Append Log - CRC-32 of the record                                     */
+/*-----------------------------------------------------------------------*/
+
+static
+DWORD log_crc (		/* Updated CRC */
+	DWORD crc,		/* CRC of the preceding data */
+	const BYTE* p,	/* Data */
+	UINT n			/* Number of bytes */
+)
+{
+	static const DWORD tbl[16] = {	/* CRC-32 (0xEDB88320) of each nibble */
+		0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+		0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+	};
+
+
+	while (n--) {
+		crc ^= *p++;
+		crc = (crc >> 4) ^ tbl[crc & 15];
+		crc = (crc >> 4) ^ tbl[crc & 15];
+	}
+	return crc;
+}
+
+
+/* The CRC covers the offset of the record, so that stale data left in the
+/  preallocated area by an earlier file does not pass for a record. */
+static
+DWORD log_hdr_crc (	/* CRC of the record header */
+	DWORD ofs,		/* Offset of the record in the file */
+	const BYTE* hdr	/* Record header */
+)
+{
+	BYTE b[4];
+
+
+	ST_DWORD(b, ofs);
+	return log_crc(log_crc(0xFFFFFFFF, b, 4), hdr, 4);
+}
+
+
+static
+FRESULT log_size (	/* Set the size of the log file to be committed */
+	FIL* fp,		/* Pointer to the file object */
+	DWORD ofs,		/* Size of the valid records */
+	BYTE sync		/* 1: Write the FAT to the disk first */
+)
+{
+	FRESULT res;
+
+
+	res = validate_fp(fp);
+	if (res == FR_OK) {
+		fp->fsize = fp->vsize = ofs;	/* The chain beyond the size stays with the file */
+		fp->flag |= FA__WRITTEN;
+		if (sync) res = sync_fs(fp->fs);
+	}
+	LEAVE_FP(fp, res);
+}
+
+
+static
+FRESULT log_tell (	/* Get the offset of the next record */
+	FIL* fp,		/* Pointer to the file object */
+	DWORD* ofs		/* Pointer to the variable to return the offset */
+)
+{
+	FRESULT res;
+
+
+	res = validate_fp(fp);
+	if (res == FR_OK) *ofs = fp->fptr;
+	LEAVE_FP(fp, res);
+}
+
+
+static
+FRESULT log_flush (	/* Write the records to the disk before the size is committed */
+	FIL* fp			/* Pointer to the file object */
+)
+{
+	FRESULT res;
+
+
+	res = validate_fp(fp);
+	if (res == FR_OK && (fp->flag & FA__WRITTEN)) {
+#if _FS_TINY
+		res = sync_window(fp->fs);
+#else
+		if (fp->flag & FA__DIRTY) {
+			if (disk_write(fp->fs->drv, fp->buf.d8, fp->dsect, 1))
+				LEAVE_FP(fp, FR_DISK_ERR);
+			fp->flag &= ~FA__DIRTY;
+		}
+#endif
+		if (res == FR_OK && disk_ioctl(fp->fs->drv, CTRL_SYNC, 0) != RES_OK)
+			res = FR_DISK_ERR;
+	}
+	LEAVE_FP(fp, res);
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Append Log - Open and Recover                                         */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_logopen (
+	FIL* fp,			/* Pointer to the blank file object */
+	const TCHAR* path,	/* Pointer to the file name */
+	DWORD fsz			/* Size of the area to be preallocated to a new log */
+)
+{
+	FRESULT res;
+	DWORD ofs, crc, sum;
+	UINT n, br;
+	BYTE b[32];
+
+
+	res = f_open(fp, path, FA_OPEN_ALWAYS | FA_READ | FA_WRITE);
+	if (res != FR_OK) return res;
+
+	if (fp->fsize == 0) {
+		ofs = 0;
+		if (fsz && !fp->sclust) {
+			/* Preallocate the clusters and commit the chain with a zero size. The
+			   FAT is written before the directory entry that points to it. */
+			res = f_expand(fp, fsz, 1);
+			if (res == FR_OK) {
+				res = log_size(fp, 0, 1);
+			} else if (res == FR_DENIED) {
+				res = FR_OK;		/* No contiguous area, the log grows cluster by cluster */
+			}
+		}
+	} else {
+		/* Scan the records up to the committed size and trim the file after
+		   the last valid one: a commit can reach the disk before the data. */
+		ofs = 0;
+		for (;;) {
+			res = f_read(fp, b, LOG_HDR, &br);
+			if (res != FR_OK || br != LOG_HDR) break;
+			n = LD_WORD(b);
+			if ((n ^ LD_WORD(b+2)) != 0xFFFF || ofs + LOG_HDR + n > fp->fsize) break;
+			sum = LD_DWORD(b+4);
+			crc = log_hdr_crc(ofs, b);
+			for ( ; n; n -= br) {			/* Check the CRC of the data */
+				res = f_read(fp, b, n < sizeof b ? n : sizeof b, &br);
+				if (res != FR_OK || !br) break;
+				crc = log_crc(crc, b, br);
+			}
+			if (res != FR_OK || n || ~crc != sum) break;
+			ofs = fp->fptr;					/* End of the last valid record */
+		}
+		if (res == FR_OK && ofs < fp->fsize) res = log_size(fp, ofs, 0);
+	}
+	if (res == FR_OK) res = f_sync(fp);
+	if (res == FR_OK) res = f_lseek(fp, ofs);
+	if (res != FR_OK) f_close(fp);
+
+	return res;
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Append Log - Write a Record                                           */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_logwrite (
+	FIL* fp,			/* Pointer to the log file object */
+	const void* buff,	/* Pointer to the data of the record */
+	UINT btw			/* Number of bytes of the record (0..65535) */
+)
+{
+	FRESULT res;
+	DWORD ofs;
+	UINT bw;
+	BYTE hdr[LOG_HDR];
+
+
+	if (btw > 0xFFFF) return FR_INVALID_PARAMETER;
+	res = log_tell(fp, &ofs);			/* Check validity of the object */
+	if (res != FR_OK) return res;
+	ST_WORD(hdr, btw);
+	ST_WORD(hdr+2, ~btw);
+	ST_DWORD(hdr+4, ~log_crc(log_hdr_crc(ofs, hdr), (const BYTE*)buff, btw));
+
+	res = f_write(fp, hdr, LOG_HDR, &bw);
+	if (res == FR_OK && bw == LOG_HDR)
+		res = f_write(fp, buff, btw, &bw);
+	if (res == FR_OK && bw != btw) {	/* Volume full, remove the partial record */
+		res = f_lseek(fp, ofs);
+		if (res == FR_OK) res = f_truncate(fp);
+		if (res == FR_OK) res = FR_DENIED;
+	}
+
+	return res;
+}
+
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Append Log - Commit the Records                                       */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_logcommit (
+	FIL* fp				/* Pointer to the log file object */
+)
+{
+	FRESULT res;
+
+
+	/* The records reach the disk before the directory entry that covers
+	   them: a stale record of a deleted log at the same offset would pass
+	   the CRC check of f_logopen */
+	res = log_flush(fp);
+	if (res == FR_OK) res = f_sync(fp);
+
+	return res;
+}
+#endif /* _USE_LOG */
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Forward data to the stream directly                                   */
+/*-----------------------------------------------------------------------*/
+#if _USE_FORWARD
+
+FRESULT f_stream (
 	FIL* fp, 						/* Pointer to the file object */
 	UINT (*func)(const BYTE*,UINT),	/* Pointer to the streaming function */
+	BYTE* buff,						/* Pointer to the chunk buffer (NULL: sector buffer only) */
+	UINT bsz,						/* Size of the chunk buffer in unit of byte */
 	UINT btf,						/* Number of bytes to forward */
 	UINT* bf						/* Pointer to number of bytes forwarded */
 )
 {
 	FRESULT res;
-	DWORD remain, clst, sect;
-	UINT rcnt;
-	BYTE csect;
+	DWORD remain, clst, sect, scl;
+	UINT rcnt, cc;
+#if _USE_WRITEV
+	UINT n;
+#endif
+	BYTE csect, *sbuff;
 
 
 	*bf = 0;	/* Clear transfer byte counter */
 
-	res = validate(fp);								/* Check validity of the object */
-	if (res != FR_OK) LEAVE_FF(fp->fs, res);
+	res = validate_fp(fp);								/* Check validity of the object */
+	if (res != FR_OK) LEAVE_FP(fp, res);
 	if (fp->err)									/* Check error */
-		LEAVE_FF(fp->fs, (FRESULT)fp->err);
+		LEAVE_FP(fp, (FRESULT)fp->err);
 	if (!(fp->flag & FA_READ))						/* Check access mode */
-		LEAVE_FF(fp->fs, FR_DENIED);
+		LEAVE_FP(fp, FR_DENIED);
 
 	remain = fp->fsize - fp->fptr;
 	if (btf > remain) btf = (UINT)remain;			/* Truncate btf by remaining bytes */
+	if (!buff) bsz = 0;
 
 	for ( ;  btf && (*func)(0, 0);					/* Repeat until all data transferred or stream becomes busy */
 		fp->fptr += rcnt, *bf += rcnt, btf -= rcnt) {
 		csect = (BYTE)(fp->fptr / SS(fp->fs) & (fp->fs->csize - 1));	/* Sector offset in the cluster */
 		if ((fp->fptr % SS(fp->fs)) == 0) {			/* On the sector boundary? */
+			if (*bf) YIELD_FS(fp);					/* Let other files access the volume */
 			if (!csect) {							/* On the cluster boundary? */
-				clst = (fp->fptr == 0) ?			/* On the top of the file? */
-					fp->sclust : get_fat(fp->fs, fp->clust);
-				if (clst <= 1) ABORT(fp->fs, FR_INT_ERR);
+				if (fp->fptr == 0) {				/* On the top of the file? */
+					clst = fp->sclust;				/* Follow from the origin */
+				} else {							/* Middle or end of the file */
+#if _USE_FASTSEEK
+					if (fp->cltbl)
+						clst = clmt_clust(fp, fp->fptr);	/* Get cluster# from the CLMT */
+					else
+#endif
+						clst = get_fat(fp->fs, fp->clust);	/* Follow cluster chain on the FAT */
+				}
+				if (clst < 2) ABORT(fp->fs, FR_INT_ERR);
 				if (clst == 0xFFFFFFFF) ABORT(fp->fs, FR_DISK_ERR);
 				fp->clust = clst;					/* Update current cluster */
 			}
@@ -3895,16 +5043,94 @@ FRESULT f_forward (
 		sect = clust2sect(fp->fs, fp->clust);		/* Get current data sector */
 		if (!sect) ABORT(fp->fs, FR_INT_ERR);
 		sect += csect;
+		cc = 0;
+		if ((fp->fptr % SS(fp->fs)) == 0)			/* Number of whole sectors fit in the chunk buffer */
+			cc = ((btf < bsz) ? btf : bsz) / SS(fp->fs);
+		if (cc) {									/* Read contiguous sectors into the chunk buffer */
+			scl = fp->clust;
+#if _USE_WRITEV
+			for (n = fp->fs->csize - csect; n < cc && n < MAX_XFER; n += fp->fs->csize) {	/* Continue over contiguous clusters */
+				clst = get_fat(fp->fs, fp->clust);
+				if (clst == 0xFFFFFFFF) ABORT(fp->fs, FR_DISK_ERR);
+				if (clst != fp->clust + 1) break;
+				fp->clust = clst;
+			}
+			if (cc > n) cc = n;						/* Clip at the end of the contiguous clusters */
+			if (cc > MAX_XFER) cc = MAX_XFER;
+#else
+			if (csect + cc > fp->fs->csize)			/* Clip at cluster boundary */
+				cc = fp->fs->csize - csect;
+#endif
+			if (disk_read(fp->fs->drv, buff, sect, (BYTE)cc))
+				ABORT(fp->fs, FR_DISK_ERR);
+#if !_FS_READONLY && _FS_MINIMIZE <= 2				/* Replace one of the read sectors with cached data if it contains a dirty sector */
+#if _FS_TINY
+			if (fp->fs->wflag && fp->fs->winsect - sect < cc)
+				mem_cpy(buff + ((fp->fs->winsect - sect) * SS(fp->fs)), fp->fs->win.d8, SS(fp->fs));
+#else
+			if ((fp->flag & FA__DIRTY) && fp->dsect - sect < cc)
+				mem_cpy(buff + ((fp->dsect - sect) * SS(fp->fs)), fp->buf.d8, SS(fp->fs));
+#endif
+#endif
+			rcnt = (*func)(buff, SS(fp->fs) * cc);	/* Forward the chunk */
+			if (!rcnt) ABORT(fp->fs, FR_INT_ERR);
+			fp->clust = scl + (csect * SS(fp->fs) + rcnt - 1) / SS(fp->fs) / fp->fs->csize;	/* Cluster of the last byte forwarded */
+			if (rcnt % SS(fp->fs)) {				/* Stopped in the middle of a sector? */
+				sect += rcnt / SS(fp->fs);
+#if !_FS_TINY
+				if (fp->dsect != sect) {			/* Put the sector in the sector cache from the chunk */
+#if !_FS_READONLY
+					if (fp->flag & FA__DIRTY) {		/* Write-back dirty sector cache */
+						if (disk_write(fp->fs->drv, fp->buf.d8, fp->dsect, 1))
+							ABORT(fp->fs, FR_DISK_ERR);
+						fp->flag &= ~FA__DIRTY;
+					}
+#endif
+					mem_cpy(fp->buf.d8, buff + (rcnt / SS(fp->fs) * SS(fp->fs)), SS(fp->fs));
+				}
+#endif
+				fp->dsect = sect;
+			}
+			continue;
+		}
+#if _FS_TINY
 		if (move_window(fp->fs, sect))				/* Move sector window */
 			ABORT(fp->fs, FR_DISK_ERR);
+		sbuff = fp->fs->win.d8;
+#else
+		if (fp->dsect != sect) {					/* Load data sector if not in cache */
+#if !_FS_READONLY
+			if (fp->flag & FA__DIRTY) {				/* Write-back dirty sector cache */
+				if (disk_write(fp->fs->drv, fp->buf.d8, fp->dsect, 1))
+					ABORT(fp->fs, FR_DISK_ERR);
+				fp->flag &= ~FA__DIRTY;
+			}
+#endif
+			if (disk_read(fp->fs->drv, fp->buf.d8, sect, 1))	/* Fill sector cache */
+				ABORT(fp->fs, FR_DISK_ERR);
+		}
+		sbuff = fp->buf.d8;
+#endif
 		fp->dsect = sect;
-		rcnt = SS(fp->fs) - (WORD)(fp->fptr % SS(fp->fs));	/* Forward data from sector window */
+		rcnt = SS(fp->fs) - (WORD)(fp->fptr % SS(fp->fs));	/* Forward data from sector buffer */
 		if (rcnt > btf) rcnt = btf;
-		rcnt = (*func)(&fp->fs->win.d8[(WORD)fp->fptr % SS(fp->fs)], rcnt);
+		rcnt = (*func)(&sbuff[(WORD)fp->fptr % SS(fp->fs)], rcnt);
 		if (!rcnt) ABORT(fp->fs, FR_INT_ERR);
 	}
 
-	LEAVE_FF(fp->fs, FR_OK);
+	LEAVE_FP(fp, FR_OK);
+}
+
+
+
+FRESULT f_forward (
+	FIL* fp, 						/* Pointer to the file object */
+	UINT (*func)(const BYTE*,UINT),	/* Pointer to the streaming function */
+	UINT btf,						/* Number of bytes to forward */
+	UINT* bf						/* Pointer to number of bytes forwarded */
+)
+{
+	return f_stream(fp, func, 0, 0, btf, bf);	/* Forward from the sector buffer only */
 }
 #endif /* _USE_FORWARD */
 
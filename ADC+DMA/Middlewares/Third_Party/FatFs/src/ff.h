@@ -107,6 +107,28 @@ typedef struct {
 	DWORD	dirbase;		/* Root directory start sector (FAT32:Cluster#) */
 	DWORD	database;		/* Data start sector */
 	DWORD	winsect;		/* Current sector appearing in the win[] */
+#if _FS_FREEMAP
+	WORD	fmap[_FS_FREEMAP];	/* Number of free clusters in each cluster group (0xFFFF:Not counted yet) */
+	BYTE	fmap_sft;		/* Cluster group size (1 << fmap_sft clusters, 0:Map disabled) */
+#endif
+#if _FS_CACHE
+  union{
+	UINT	d32[_FS_CACHE][_MAX_SS/4]; /* Force 32bits alignement */
+	BYTE	d8[_FS_CACHE][_MAX_SS];	/* Sector cache for Directory and FAT */
+  }cbuf;
+	DWORD	csect[_FS_CACHE];	/* Sector number of each cache entry (0xFFFFFFFF:Empty) */
+	DWORD	cstamp[_FS_CACHE];	/* Time stamp of the last use of each cache entry */
+	DWORD	ctime;			/* Time stamp counter */
+	BYTE	cflag[_FS_CACHE];	/* Cache entry flags (b0:dirty) */
+#endif
+#if _FS_DIRHASH
+	DWORD	dh_clust;		/* Start cluster of the indexed directory (1:Index not in use) */
+	DWORD	dh_over;		/* Start cluster of a directory too large for the index (1:None) */
+	WORD	dh_nent;		/* Number of entries in the table of the indexed directory */
+	WORD	dh_cnt;			/* Number of names in the index */
+	WORD	dh_free;		/* Index of the first entry that can be blank in the indexed directory */
+	DWORD	dh_tbl[_FS_DIRHASH];	/* Name hash table (b31-16:Hash tag, b15-0:Entry index, 0:Empty) */
+#endif
 
 } FATFS;
 
@@ -127,6 +149,9 @@ typedef struct {
 	BYTE	err;			/* Abort flag (error code) */
 	DWORD	fptr;			/* File read/write pointer (Zeroed on file open) */
 	DWORD	fsize;			/* File size */
+#if _USE_EXPAND && !_FS_READONLY
+	DWORD	vsize;			/* Size of the written data (the rest of fsize is the area allocated by f_expand) */
+#endif
 	DWORD	sclust;			/* File data start cluster (0:no data cluster, always 0 when fsize is 0) */
 	DWORD	clust;			/* Current cluster of fpter */
 	DWORD	dsect;			/* Current data sector of fpter */
@@ -140,6 +165,9 @@ typedef struct {
 #if _FS_LOCK
 	UINT	lockid;			/* File lock ID (index of file semaphore table Files[]) */
 #endif
+#if _FS_REENTRANT == 2
+	_SYNC_t	sobj;			/* Identifier of sync object of the file */
+#endif
 } FIL;
 
 
@@ -223,8 +251,13 @@ FRESULT f_close (FIL* fp);											/* Close an open file object */
 FRESULT f_read (FIL* fp, void* buff, UINT btr, UINT* br);			/* Read data from a file */
 FRESULT f_write (FIL* fp, const void* buff, UINT btw, UINT* bw);	/* Write data to a file */
 FRESULT f_forward (FIL* fp, UINT(*func)(const BYTE*,UINT), UINT btf, UINT* bf);	/* Forward data to the stream */
+FRESULT f_stream (FIL* fp, UINT(*func)(const BYTE*,UINT), BYTE* buff, UINT bsz, UINT btf, UINT* bf);	/* Forward data to the stream in multi-sector chunks */
 FRESULT f_lseek (FIL* fp, DWORD ofs);								/* Move file pointer of a file object */
 FRESULT f_truncate (FIL* fp);										/* Truncate file */
+FRESULT f_expand (FIL* fp, DWORD fsz, BYTE opt);					/* Allocate a contiguous block to the file */
+FRESULT f_logopen (FIL* fp, const TCHAR* path, DWORD fsz);			/* Open an append log and recover its last commit */
+FRESULT f_logwrite (FIL* fp, const void* buff, UINT btw);			/* Append a record to the log */
+FRESULT f_logcommit (FIL* fp);										/* Commit the records of the log */
 FRESULT f_sync (FIL* fp);											/* Flush cached data of a writing file */
 FRESULT f_opendir (DIR* dp, const TCHAR* path);						/* Open a directory */
 FRESULT f_closedir (DIR* dp);										/* Close an open directory */
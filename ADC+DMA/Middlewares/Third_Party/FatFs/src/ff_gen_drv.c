@@ -27,41 +27,95 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "ff_gen_drv.h"
+#include <string.h>
 
 /* Private typedef -----------------------------------------------------------*/
+#if _DISK_ASYNC > 0
+/** 
+  * @brief  Queued write  
+  */ 
+typedef struct
+{
+  BYTE                    pdrv;       /*!< Physical drive number         */
+  BYTE                    count;      /*!< Number of sectors             */
+  DWORD                   sector;     /*!< Sector address (LBA)          */
+  FATFS_WriteCallback     callback;   /*!< Completion callback, or NULL  */
+
+}Async_reqTypeDef;
+#endif /* _DISK_ASYNC > 0 */
+
 /* Private define ------------------------------------------------------------*/
+#if (_DISK_ASYNC > 0) && _FS_REENTRANT
+/* The queue is shared by the drives and run by the thread of FatFs */
+#error _DISK_ASYNC needs _FS_REENTRANT = 0
+#endif
+
 /* Private variables ---------------------------------------------------------*/
 Disk_drvTypeDef  disk = {0};
 
+#if _DISK_ASYNC > 0
+/* Queue of the writes, the oldest one is sent to the drive first */
+static uint32_t          async_buf[_DISK_ASYNC][_DISK_ASYNC_SECTORS * _MAX_SS / 4];
+static Async_reqTypeDef  async_req[_DISK_ASYNC];
+static __IO uint8_t      async_head = 0;
+static __IO uint8_t      async_nbr = 0;
+static __IO uint8_t      async_busy = 0;      /* The oldest write is started */
+static DRESULT           async_err[_VOLUMES]; /* First failed write of each drive */
+#endif /* _DISK_ASYNC > 0 */
+
 /* Private function prototypes -----------------------------------------------*/
+#if _DISK_ASYNC > 0
+static void FATFS_AsyncBlock(void);
+#endif /* _DISK_ASYNC > 0 */
+
 /* Private functions ---------------------------------------------------------*/
 
 /**
-  * @brief  Links a compatible diskio driver and increments the number of active
-  *         linked drivers.          
+  * @brief  Links a unit of a compatible diskio driver to the first free
+  *         volume and increments the number of active linked drivers. A
+  *         driver may be linked several times, once per unit (LUN).
   * @note   The number of linked drivers (volumes) is up to 10 due to FatFs limits
   * @param  drv: pointer to the disk IO Driver structure
   * @param  path: pointer to the logical drive path 
+  * @param  lun: unit of the driver, passed to its functions
   * @retval Returns 0 in case of success, otherwise 1.
   */
-uint8_t FATFS_LinkDriver(Diskio_drvTypeDef *drv, char *path)
+uint8_t FATFS_LinkDriverEx(Diskio_drvTypeDef *drv, char *path, BYTE lun)
 {
   uint8_t ret = 1;
   uint8_t DiskNum = 0;
-  if(disk.nbr <= _VOLUMES)
+  
+  for(DiskNum = 0; DiskNum < _VOLUMES; DiskNum++)
   {
-    disk.is_initialized[disk.nbr] = 0;
-    disk.drv[disk.nbr] = drv;  
-    DiskNum = disk.nbr++;
-    path[0] = DiskNum + '0';
-    path[1] = ':';
-    path[2] = '/';
-    path[3] = 0;
-    ret = 0;
+    if(disk.drv[DiskNum] == 0)
+    {
+      disk.is_initialized[DiskNum] = 0;
+      disk.drv[DiskNum] = drv;
+      disk.lun[DiskNum] = lun;
+      disk.nbr++;
+      path[0] = DiskNum + '0';
+      path[1] = ':';
+      path[2] = '/';
+      path[3] = 0;
+      ret = 0;
+      break;
+    }
   }
   return ret;
 }
 
+/**
+  * @brief  Links a compatible diskio driver, its unit 0, and increments the
+  *         number of active linked drivers.
+  * @param  drv: pointer to the disk IO Driver structure
+  * @param  path: pointer to the logical drive path 
+  * @retval Returns 0 in case of success, otherwise 1.
+  */
+uint8_t FATFS_LinkDriver(Diskio_drvTypeDef *drv, char *path)
+{
+  return FATFS_LinkDriverEx(drv, path, 0);
+}
+
 /**
   * @brief  Unlinks a diskio driver and decrements the number of active linked
   *         drivers.
@@ -76,9 +130,15 @@ uint8_t FATFS_UnLinkDriver(char *path)
   if(disk.nbr >= 1)
   {    
     DiskNum = path[0] - '0';
-    if(DiskNum <= disk.nbr)
+    if((DiskNum < _VOLUMES) && (disk.drv[DiskNum] != 0))
     {
-      disk.drv[disk.nbr--] = 0;
+#if _DISK_ASYNC > 0
+      FATFS_AsyncFlush(DiskNum);
+      FATFS_AsyncWait(DiskNum, 0, 0);
+#endif /* _DISK_ASYNC > 0 */
+      disk.drv[DiskNum] = 0;
+      disk.lun[DiskNum] = 0;
+      disk.nbr--;
       ret = 0;
     }
   }
@@ -95,6 +155,196 @@ uint8_t FATFS_GetAttachedDriversNbr(void)
 {
   return disk.nbr;
 }
+
+#if _DISK_ASYNC > 0
+/**
+  * @brief  Checks whether writes of a drive are queued.
+  * @param  pdrv: Physical drive number (0..)
+  * @param  sector: Sector address (LBA)
+  * @param  count: Number of sectors, 0 for the whole drive
+  * @retval Returns 1 if a queued write overlaps the sectors, otherwise 0.
+  */
+static uint8_t FATFS_AsyncPending(BYTE pdrv, DWORD sector, BYTE count)
+{
+  uint8_t i;
+  Async_reqTypeDef *req;
+  
+  for(i = 0; i < async_nbr; i++)
+  {
+    req = &async_req[(async_head + i) % _DISK_ASYNC];
+    if((req->pdrv == pdrv) &&
+       ((count == 0) || 
+        ((req->sector < sector + count) && (sector < req->sector + req->count))))
+    {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+  * @brief  Queues a write of Sector(s). The data is copied and the function
+  *         returns once the write is queued, it waits only when the queue is
+  *         full. The queue is shared by the drives: it is run by the thread
+  *         of FatFs only.
+  * @param  pdrv: Physical drive number (0..)
+  * @param  *head: Data of the first sector, or NULL if it is in buff
+  * @param  *buff: Data to be written (following the first sector if head is set)
+  * @param  sector: Sector address (LBA)
+  * @param  count: Number of sectors to write (1.._DISK_ASYNC_SECTORS)
+  * @param  callback: Called when the write is completed, may be NULL
+  * @retval DRESULT: RES_OK if queued, otherwise the error of a previous
+  *         write of the drive, which is then cleared.
+  */
+DRESULT FATFS_AsyncWrite(BYTE pdrv, const BYTE *head, const BYTE *buff, DWORD sector, BYTE count, FATFS_WriteCallback callback)
+{
+  DRESULT res;
+  uint8_t idx;
+  uint8_t *dst;
+  
+  if((count == 0) || (count > _DISK_ASYNC_SECTORS))
+  {
+    return RES_PARERR;
+  }
+  res = async_err[pdrv];
+  async_err[pdrv] = RES_OK;
+  if(res != RES_OK)
+  {
+    return res;
+  }
+  
+  while(async_nbr == _DISK_ASYNC)
+  {
+    FATFS_AsyncBlock();
+  }
+  
+  idx = (async_head + async_nbr) % _DISK_ASYNC;
+  dst = (uint8_t *)async_buf[idx];
+  if(head != NULL)
+  {
+    memcpy(dst, head, _MAX_SS);
+    memcpy(dst + _MAX_SS, buff, (count - 1) * _MAX_SS);
+  }
+  else
+  {
+    memcpy(dst, buff, count * _MAX_SS);
+  }
+  async_req[idx].pdrv = pdrv;
+  async_req[idx].count = count;
+  async_req[idx].sector = sector;
+  async_req[idx].callback = callback;
+  async_nbr++;
+  
+  /* Start it if the drive is idle */
+  FATFS_AsyncProcess();
+  return RES_OK;
+}
+
+/**
+  * @brief  Waits for all the queued writes of a drive.
+  * @param  pdrv: Physical drive number (0..)
+  * @retval DRESULT: The error of the first failed write since the last call,
+  *         which is then cleared, otherwise RES_OK.
+  */
+DRESULT FATFS_AsyncFlush(BYTE pdrv)
+{
+  DRESULT res;
+  
+  while(FATFS_AsyncPending(pdrv, 0, 0))
+  {
+    FATFS_AsyncBlock();
+  }
+  res = async_err[pdrv];
+  async_err[pdrv] = RES_OK;
+  return res;
+}
+
+/**
+  * @brief  Waits until a drive can be accessed directly: the write in
+  *         progress on its driver, which the other units of the driver
+  *         share, is completed and no queued write overlaps the sectors.
+  * @param  pdrv: Physical drive number (0..)
+  * @param  sector: Sector address (LBA)
+  * @param  count: Number of sectors, 0 for the whole drive
+  * @retval None
+  */
+void FATFS_AsyncWait(BYTE pdrv, DWORD sector, BYTE count)
+{
+  while(((async_busy != 0) && (disk.drv[async_req[async_head].pdrv] == disk.drv[pdrv])) ||
+        FATFS_AsyncPending(pdrv, sector, count))
+  {
+    FATFS_AsyncBlock();
+  }
+}
+
+/**
+  * @brief  Drives the queued writes: starts the oldest one and completes it
+  *         when the drive reports the end of the transfer. It is called by
+  *         the functions above and should be called periodically by the
+  *         application (main loop or task) to keep the queue moving.
+  * @param  None
+  * @retval None
+  */
+void FATFS_AsyncProcess(void)
+{
+  Async_reqTypeDef req;
+  DRESULT res = RES_OK;
+  
+  if(async_nbr == 0)
+  {
+    return;
+  }
+  req = async_req[async_head];
+  if(async_busy == 0)
+  {
+    res = disk.drv[req.pdrv]->disk_write_start(disk.lun[req.pdrv], (BYTE *)async_buf[async_head], req.sector, req.count);
+    if(res == RES_OK)
+    {
+      async_busy = 1;
+    }
+  }
+  
+  /* Completed, or failed to start */
+  if((async_busy == 0) || (disk.drv[req.pdrv]->disk_write_done(disk.lun[req.pdrv], &res) != 0))
+  {
+    if((res != RES_OK) && (async_err[req.pdrv] == RES_OK))
+    {
+      async_err[req.pdrv] = res;
+    }
+    async_busy = 0;
+    async_head = (async_head + 1) % _DISK_ASYNC;
+    async_nbr--;
+    if(req.callback != NULL)
+    {
+      req.callback(req.pdrv, req.sector, req.count, res);
+    }
+  }
+}
+
+/**
+  * @brief  Runs the queue for the functions above that wait for it. While
+  *         the oldest write is in progress, the drive blocks the caller
+  *         until it is completed if it implements disk_write_wait, instead
+  *         of being polled.
+  * @param  None
+  * @retval None
+  */
+static void FATFS_AsyncBlock(void)
+{
+  uint8_t nbr = async_nbr;
+  BYTE pdrv;
+  
+  FATFS_AsyncProcess();
+  if((async_busy != 0) && (async_nbr == nbr))
+  {
+    pdrv = async_req[async_head].pdrv;
+    if(disk.drv[pdrv]->disk_write_wait != NULL)
+    {
+      disk.drv[pdrv]->disk_write_wait(disk.lun[pdrv]);
+    }
+  }
+}
+#endif /* _DISK_ASYNC > 0 */
  
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
 
@@ -40,19 +40,29 @@
 /* Exported types ------------------------------------------------------------*/
 
    /** 
-  * @brief  Disk IO Driver structure definition  
+  * @brief  Disk IO Driver structure definition. The first parameter of the
+  *         functions is the unit of the driver the volume is linked to, the
+  *         logical unit of a multi-LUN device.
   */ 
 typedef struct
 {
-  DSTATUS (*disk_initialize) (void);                     /*!< Initialize Disk Drive                     */
-  DSTATUS (*disk_status)     (void);                     /*!< Get Disk Status                           */
-  DRESULT (*disk_read)       (BYTE*, DWORD, BYTE);       /*!< Read Sector(s)                            */
+  DSTATUS (*disk_initialize) (BYTE);                           /*!< Initialize Disk Drive                     */
+  DSTATUS (*disk_status)     (BYTE);                           /*!< Get Disk Status                           */
+  DRESULT (*disk_read)       (BYTE, BYTE*, DWORD, BYTE);       /*!< Read Sector(s)                            */
 #if _USE_WRITE == 1 
-  DRESULT (*disk_write)      (const BYTE*, DWORD, BYTE); /*!< Write Sector(s) when _USE_WRITE = 0       */
+  DRESULT (*disk_write)      (BYTE, const BYTE*, DWORD, BYTE); /*!< Write Sector(s) when _USE_WRITE = 0       */
 #endif /* _USE_WRITE == 1 */
 #if _USE_IOCTL == 1  
-  DRESULT (*disk_ioctl)      (BYTE, void*);              /*!< I/O control operation when _USE_IOCTL = 1 */
+  DRESULT (*disk_ioctl)      (BYTE, BYTE, void*);              /*!< I/O control operation when _USE_IOCTL = 1 */
 #endif /* _USE_IOCTL == 1 */
+#if _USE_WRITEV == 1
+  DRESULT (*disk_writev)     (BYTE, const BYTE*, const BYTE*, DWORD, BYTE); /*!< Write gathered Sector(s) when _USE_WRITEV = 1, may be NULL */
+#endif /* _USE_WRITEV == 1 */
+#if _DISK_ASYNC > 0
+  DRESULT (*disk_write_start)(BYTE, const BYTE*, DWORD, BYTE); /*!< Start a Write of Sector(s) when _DISK_ASYNC > 0, may be NULL */
+  uint8_t (*disk_write_done) (BYTE, DRESULT*);                 /*!< Poll the started Write, 1 and its result once completed       */
+  void    (*disk_write_wait) (BYTE);                           /*!< Block until the started Write is completed, may be NULL       */
+#endif /* _DISK_ASYNC > 0 */
 
 }Diskio_drvTypeDef;
 
@@ -63,16 +73,31 @@ typedef struct
 { 
   uint8_t                 is_initialized[_VOLUMES];
   Diskio_drvTypeDef       *drv[_VOLUMES];
+  uint8_t                 lun[_VOLUMES];
   __IO uint8_t            nbr;
 
 }Disk_drvTypeDef;
 
+#if _DISK_ASYNC > 0
+/** 
+  * @brief  Completion callback of a queued write  
+  */ 
+typedef void (*FATFS_WriteCallback)(BYTE pdrv, DWORD sector, BYTE count, DRESULT res);
+#endif /* _DISK_ASYNC > 0 */
+
 /* Exported constants --------------------------------------------------------*/
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
+uint8_t FATFS_LinkDriverEx(Diskio_drvTypeDef *drv, char *path, BYTE lun);
 uint8_t FATFS_LinkDriver(Diskio_drvTypeDef *drv, char *path);
 uint8_t FATFS_UnLinkDriver(char *path);
 uint8_t FATFS_GetAttachedDriversNbr(void);
+#if _DISK_ASYNC > 0
+DRESULT FATFS_AsyncWrite(BYTE pdrv, const BYTE *head, const BYTE *buff, DWORD sector, BYTE count, FATFS_WriteCallback callback);
+DRESULT FATFS_AsyncFlush(BYTE pdrv);
+void    FATFS_AsyncWait(BYTE pdrv, DWORD sector, BYTE count);
+void    FATFS_AsyncProcess(void);
+#endif /* _DISK_ASYNC > 0 */
 
 #ifdef __cplusplus
 }
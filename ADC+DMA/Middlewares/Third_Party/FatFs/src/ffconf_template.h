@@ -36,6 +36,36 @@
 /  data transfer. This reduces memory consumption 512 bytes each file object. */
 
 
+#define _FS_CACHE            0      /* 0:Disable or >=1:Number of cached sectors */
+/* When _FS_CACHE is set to 1 or more, the file system object keeps the
+/  directory and FAT sectors that leave the window in a write-back cache of
+/  _FS_CACHE sectors with least recently used replacement. Dirty sectors are
+/  written to the disk (and to all FAT copies) when they are evicted or when
+/  the file system is synchronized. Each sector costs _MAX_SS bytes in the
+/  file system object. It cannot be used with _FS_TINY. */
+
+
+#define _FS_FREEMAP          0      /* 0:Disable or >=1:Number of free cluster counters */
+/* When _FS_FREEMAP is set to 1 or more, the file system object keeps the
+/  number of free clusters in each of up to _FS_FREEMAP groups of clusters.
+/  The groups are counted on the FAT when they are needed first, then the
+/  cluster allocation skips full groups without reading the FAT and f_getfree
+/  sums up the map. It takes 2 * _FS_FREEMAP bytes in the file system object.
+/  The map is not used on a volume that needs groups of more than 32768
+/  clusters. _FS_READONLY must be 0 to enable this feature. */
+
+
+#define _FS_DIRHASH          0      /* 0:Disable or 16-32768:Number of slots of the index */
+/* When _FS_DIRHASH is set to 16 or more, the file system object keeps a hash
+/  index of the names (SFN and LFN) in one directory, so that f_open and the
+/  other functions find an object there without reading the whole directory.
+/  The index is built on the first directory searched, and moves to a larger
+/  directory when a search has to read that one to the end. It holds up to
+/  3/4 * _FS_DIRHASH names (one per object, two if the object has an LFN) and
+/  takes 4 * _FS_DIRHASH bytes in the file system object. A directory with
+/  more names is searched without the index. */
+
+
 #define _FS_READONLY         0      /* 0:Read/Write or 1:Read only */
 /* Setting _FS_READONLY to 1 defines read only configuration. This removes
 /  writing functions, f_write, f_sync, f_unlink, f_mkdir, f_chmod, f_rename,
@@ -64,12 +94,31 @@
 /* To enable fast seek feature, set _USE_FASTSEEK to 1. */
 
 
+#define _USE_EXPAND          0      /* 0:Disable or 1:Enable */
+/* To enable f_expand function, set _USE_EXPAND to 1 and set _FS_READONLY to 0.
+/  f_expand allocates a contiguous cluster block to a file in a single pass. */
+
+
+#define _USE_WRITEV          0      /* 0:Disable or 1:Enable */
+/* When _USE_WRITEV is set to 1, f_read and f_write continue a direct transfer
+/  over contiguous clusters, and f_write sends the dirty sector buffer and the
+/  whole sectors that follow it on the disk to disk_writev in one transfer.
+/  _FS_TINY must be 0 to enable this feature. */
+
+
+#define _USE_LOG             0      /* 0:Disable or 1:Enable */
+/* To enable the append log functions f_logopen and f_logwrite, set _USE_LOG
+/  to 1. The log is written in records with a CRC in preallocated clusters and
+/  f_logcommit commits the size in the directory entry. f_logopen
+/  trims the log after the last valid record. _USE_EXPAND must be 1. */
+
+
 #define _USE_LABEL           0      /* 0:Disable or 1:Enable */
 /* To enable volume label functions, set _USE_LAVEL to 1 */
 
 
 #define _USE_FORWARD         0      /* 0:Disable or 1:Enable */
-/* To enable f_forward function, set _USE_FORWARD to 1 and set _FS_TINY to 1. */
+/* To enable f_forward and f_stream functions, set _USE_FORWARD to 1. */
 
 
 /*-----------------------------------------------------------------------------/
@@ -175,6 +224,20 @@
 /  should be added to the disk_ioctl() function. */
 
 
+#define _DISK_ASYNC    0 /* 0:Disable or >=1:Number of queued writes */
+#define _DISK_ASYNC_SECTORS  4 /* Maximum number of sectors of a queued write */
+/* When _DISK_ASYNC is set to 1 or more, disk_write() copies the data to a queue
+/  of _DISK_ASYNC buffers of _DISK_ASYNC_SECTORS sectors and returns, and the
+/  writes are sent to the drive in the background by FATFS_AsyncProcess(). It is
+/  used by the drivers that implement the disk_write_start and disk_write_done
+/  members, the others are written in place. Larger writes wait for the queue
+/  to be written. disk_read() waits for the queued writes of the sectors it
+/  reads and CTRL_SYNC of disk_ioctl(), issued by f_sync(), waits for all of
+/  them and returns the first error. The waits block in the disk_write_wait
+/  member of the driver when it has one, otherwise they poll the drive. The
+/  queue is shared by the drives and needs _FS_REENTRANT = 0. */
+
+
 #define _FS_NOFSINFO    0 /* 0 or 1 */
 /* If you need to know the correct free space on the FAT32 volume, set this
 /  option to 1 and f_getfree() function at first time after volume mount will
@@ -207,16 +270,21 @@
 /* A header file that defines sync object types on the O/S, such as
 /  windows.h, ucos_ii.h and semphr.h, must be included prior to ff.h. */
 
-#define _FS_REENTRANT    1  /* 0:Disable or 1:Enable */
+#define _FS_REENTRANT    1  /* 0:Disable, 1:Volume lock or 2:Volume and file locks */
 #define _FS_TIMEOUT      1000 /* Timeout period in unit of time ticks */
-#define _SYNC_t          osSemaphoreId /* O/S dependent type of sync object. e.g. HANDLE, OS_EVENT*, ID and etc.. */
+#define _SYNC_t          osMutexId /* O/S dependent type of sync object. e.g. HANDLE, OS_EVENT*, ID and etc.. */
 
 /* The _FS_REENTRANT option switches the re-entrancy (thread safe) of the FatFs module.
 /
 /   0: Disable re-entrancy. _SYNC_t and _FS_TIMEOUT have no effect.
 /   1: Enable re-entrancy. Also user provided synchronization handlers,
 /      ff_req_grant(), ff_rel_grant(), ff_del_syncobj() and ff_cre_syncobj()
-/      function must be added to the project. */
+/      function must be added to the project.
+/   2: Enable re-entrancy with a lock for each open file in addition to the
+/      volume lock. f_read and f_write give up the volume lock between the
+/      sectors, so that a long access to a file does not hold off the accesses
+/      to other files on the same volume. A sync object is created for each
+/      open file. */
 
 
 #define _FS_LOCK    2      /* 0:Disable or >=1:Enable */
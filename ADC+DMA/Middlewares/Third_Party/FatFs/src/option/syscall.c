@@ -13,6 +13,8 @@
  This function is called in f_mount function to create a new
  synchronization object, such as semaphore and mutex. When a zero is
  returned, the f_mount function fails with FR_INT_ERR.
+ At _FS_REENTRANT == 2, it is also called in f_open function to create
+ the lock of the file object.
 */
 
 int ff_cre_syncobj (	/* TRUE:Function succeeded, FALSE:Could not create due to any error */
@@ -22,8 +24,8 @@ int ff_cre_syncobj (	/* TRUE:Function succeeded, FALSE:Could not create due to a
 {
   int ret;
   
-  osSemaphoreDef(SEM);
-  *sobj = osSemaphoreCreate(osSemaphore(SEM), 1);		
+  osMutexDef(MTX);
+  *sobj = osMutexCreate(osMutex(MTX));
   ret = (*sobj != NULL);
   
   return ret;
@@ -43,8 +45,7 @@ int ff_del_syncobj (	/* TRUE:Function succeeded, FALSE:Could not delete due to a
 	_SYNC_t sobj		/* Sync object tied to the logical drive to be deleted */
 )
 {
-  osSemaphoreDelete (sobj);
-  return 1;
+  return (osMutexDelete(sobj) == osOK);
 }
 
 
@@ -62,7 +63,7 @@ int ff_req_grant (	/* TRUE:Got a grant to access the volume, FALSE:Could not get
 {
   int ret = 0;
   
-  if(osSemaphoreWait(sobj, _FS_TIMEOUT) == osOK)
+  if(osMutexWait(sobj, _FS_TIMEOUT) == osOK)
   {
     ret = 1;
   }
@@ -82,7 +83,7 @@ void ff_rel_grant (
 	_SYNC_t sobj	/* Sync object to be signaled */
 )
 {
-  osSemaphoreRelease(sobj);
+  osMutexRelease(sobj);
 }
 
 #endif
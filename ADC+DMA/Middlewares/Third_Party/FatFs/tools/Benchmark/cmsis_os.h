@@ -0,0 +1,128 @@
+/**
+  ******************************************************************************
+  * @file    cmsis_os.h
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   CMSIS-RTOS mutexes of option/syscall.c on POSIX threads, for the
+  *          reentrant builds of the host benchmark
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __CMSIS_OS_H
+#define __CMSIS_OS_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum
+{
+  osOK                    =     0,
+  osErrorTimeoutResource  =  0x41,
+  osErrorResource         =  0x81,
+  osErrorParameter        =  0x80,
+  osErrorOS               =  0xFF,
+}osStatus;
+
+typedef struct
+{
+  uint32_t dummy;
+}osMutexDef_t;
+
+typedef pthread_mutex_t *osMutexId;
+
+/* Exported constants --------------------------------------------------------*/
+#define osWaitForever     0xFFFFFFFF
+
+/* Exported macro ------------------------------------------------------------*/
+#define osMutexDef(name)  const osMutexDef_t os_mutex_def_##name = { 0 }
+#define osMutex(name)     &os_mutex_def_##name
+
+/* Exported variables --------------------------------------------------------*/
+/* Mutexes created and not deleted, for the leak check of the benchmark */
+extern volatile int osMutexCount;
+
+/* Exported functions --------------------------------------------------------*/
+static inline osMutexId osMutexCreate(const osMutexDef_t *mutex_def)
+{
+  pthread_mutex_t *m = malloc(sizeof(pthread_mutex_t));
+
+  (void)mutex_def;
+  if((m != NULL) && (pthread_mutex_init(m, NULL) != 0))
+  {
+    free(m);
+    m = NULL;
+  }
+  if(m != NULL)
+  {
+    __sync_fetch_and_add(&osMutexCount, 1);
+  }
+  return m;
+}
+
+static inline osStatus osMutexWait(osMutexId mutex_id, uint32_t millisec)
+{
+  struct timespec t;
+
+  if(millisec == osWaitForever)
+  {
+    return (pthread_mutex_lock(mutex_id) == 0) ? osOK : osErrorOS;
+  }
+  clock_gettime(CLOCK_REALTIME, &t);
+  t.tv_sec += millisec / 1000;
+  t.tv_nsec += (millisec % 1000) * 1000000L;
+  if(t.tv_nsec >= 1000000000L)
+  {
+    t.tv_sec++;
+    t.tv_nsec -= 1000000000L;
+  }
+  switch(pthread_mutex_timedlock(mutex_id, &t))
+  {
+  case 0:         return osOK;
+  case ETIMEDOUT: return osErrorTimeoutResource;
+  default:        return osErrorOS;
+  }
+}
+
+static inline osStatus osMutexRelease(osMutexId mutex_id)
+{
+  return (pthread_mutex_unlock(mutex_id) == 0) ? osOK : osErrorResource;
+}
+
+static inline osStatus osMutexDelete(osMutexId mutex_id)
+{
+  if(pthread_mutex_destroy(mutex_id) != 0)
+  {
+    return osErrorResource;
+  }
+  free(mutex_id);
+  __sync_fetch_and_sub(&osMutexCount, 1);
+  return osOK;
+}
+
+#endif /* __CMSIS_OS_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
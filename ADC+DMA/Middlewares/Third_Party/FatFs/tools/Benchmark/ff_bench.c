@@ -0,0 +1,2085 @@
+/**
+  ******************************************************************************
+  * @file    ff_bench.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Host benchmark of FatFs on the RAM disk or image file drivers
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#if _FS_REENTRANT
+#include <pthread.h>
+#endif
+#include "ff_gen_drv.h"
+#include "drivers/ramdisk_diskio.h"
+#include "drivers/filedisk_diskio.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  const char *name;
+  uint32_t    size_mb;      /* Volume size */
+  UINT        au;           /* Cluster size in bytes */
+}Bench_VolumeTypeDef;
+
+typedef enum
+{
+  UPLOAD_READ = 0,          /* f_read into a buffer, then send */
+  UPLOAD_FORWARD,           /* f_forward, send from the sector buffer */
+  UPLOAD_STREAM             /* f_stream, send multi-sector chunks */
+}Bench_UploadTypeDef;
+
+typedef struct
+{
+  DWORD       sector;
+  BYTE        data[512];    /* Content before the first write */
+}Bench_SectorTypeDef;
+
+typedef struct
+{
+  Bench_SectorTypeDef *sect;
+  UINT        count;
+  UINT        max;
+}Bench_SectorListTypeDef;
+
+typedef enum
+{
+  CUT_OFF = 0,              /* Writes go to the RAM disk */
+  CUT_UNDO,                 /* Writes are recorded to restore the image */
+  CUT_ARMED                 /* ...and the power is cut after Cut_Left sectors */
+}Bench_CutTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define CHUNK_SIZE        32768   /* f_write/f_read size of the sequential tests */
+#define SMALL_FILES       256     /* Number of files of the small file test */
+#define SMALL_SIZE        1000    /* Size of a small file */
+#define DIR_PASSES        20      /* Passes over the directory */
+#define SEEK_OPS          2000    /* Random accesses of the seek test */
+#define OPEN_OPS          1000    /* f_open of the many file test */
+#define CLMT_SIZE         64      /* First cluster link map table of the fast-seek test */
+#define EXPAND_SIZE       (8UL << 20) /* Log of the f_expand test */
+#define EXPAND_SYNC       65536   /* Bytes per f_sync of the f_expand test */
+#define EXPAND_RECORD     26      /* Small record of the f_expand test */
+#define EXPAND_HOLES      4000    /* One cluster files of the fragmented volume */
+#define CACHE_LOG_SIZE    (2UL << 20) /* Log of the sector cache test */
+#define CACHE_LOG2_SIZE   (500UL << 10) /* Each of the two interleaved logs */
+#define CACHE_RECORD      128     /* Record of the logs */
+#define CACHE_SYNC        4096    /* Bytes per f_sync of a log */
+#define CACHE_FILES       600     /* Files created in one directory */
+#define FREEMAP_USED      95      /* Percentage of the clusters used by the free map test */
+#define FREEMAP_HOLE      65536   /* One free cluster every FREEMAP_HOLE in the used area */
+#define FREEMAP_FILES     100     /* Files of 8 clusters written on the full volume */
+#define FREEMAP_RESCANS   20      /* Files allocated from cluster 2 */
+#define ASYNC_FILES       4       /* Files of the queued write test */
+#define ASYNC_ROWS        2048    /* CSV rows per file */
+#define ASYNC_ROW_TIME    30      /* CPU time to make a row, in us */
+#define ASYNC_LATENCY     1000    /* Disk time of the queued write test, in us per command */
+#define ASYNC_SECTOR_TIME 500     /* Disk time of the queued write test, in us per sector */
+#define ASYNC_POLL_TIME   1       /* CPU time of a poll of the busy disk, in us */
+#define ASYNC_FILE_SIZE   (256 * 1024) /* File of the random access check */
+#define ASYNC_OPS         3000    /* Random accesses of the check */
+#define LOCK_RECORDS      6000    /* Records of the logger of the lock test */
+#define LOCK_SYNC         50      /* Records per f_sync of the logger */
+#define LOCK_FILE_SIZE    (512 * 1024) /* File checked by the reader of the lock test */
+#define LOCK_READ_SIZE    65536   /* f_read size of the reader */
+#define LOCK_LATENCY      100     /* Disk latency of the lock test, in us per command */
+#define LOCK_SECTOR_TIME  5       /* Disk transfer time of the lock test, in us per sector */
+#define LOG_RECORDS       1500    /* Records of the power cut test */
+#define LOG_COMMIT        5       /* Records per f_logcommit */
+#define LOG_APPEND        10      /* Records appended after the recovery */
+#define LOG_RECORD_MAX    64      /* Largest record */
+#define LOG_PREALLOC      (128 * 1024) /* Area preallocated to a log */
+#define LOG_OLD_RECORDS   400     /* Records of the deleted log */
+#define LOG_CUT_ALL       64      /* Power cut after each of the first sector writes... */
+#define LOG_CUT_STEP      7       /* ...then after every LOG_CUT_STEP */
+#define UNALIGNED_HEAD    100     /* Unaligned write: partial first sector... */
+#define UNALIGNED_SIZE    200000  /* ...then one f_write of more than 128 sectors */
+
+#define CHECK(x)  do { FRESULT r_ = (x); if (r_ != FR_OK) { \
+                    printf("%s failed (%d) at line %d\n", #x, r_, __LINE__); exit(1); } } while (0)
+#define CHECK_FULL(ok)  do { if (!(ok)) { \
+                    printf("volume full at line %d\n", __LINE__); exit(1); } } while (0)
+
+/* Private variables ---------------------------------------------------------*/
+static const Bench_VolumeTypeDef Volumes[] =
+{
+  { "FAT16",   64,  2048 },
+  { "FAT16", 1024, 32768 },
+  { "FAT32", 1024,  4096 },
+  { "FAT32", 3072, 32768 },
+};
+
+/* The benchmark counts the commands of the driver it links */
+static Diskio_drvTypeDef *Target;
+static unsigned long Rd_Cmd, Rd_Sect, Wr_Cmd, Wr_Sect;
+
+/* Slow disk of the lock test, which also checks that the driver is never
+   entered by two threads */
+static uint32_t Disk_Latency, Disk_SectorTime;
+static volatile int Disk_Busy;
+
+#if _DISK_ASYNC > 0
+/* Simulated time of the queued write test, in us: the CPU time and the
+   end of the command of the disk, which runs beside the CPU */
+static int Sim_On, Sim_Fail;
+static double Sim_Now, Sim_Done, Sim_Blocked;
+static unsigned long Sim_Polls;
+static DRESULT Sim_Result;
+#endif
+
+#if _USE_LOG
+/* Power cut of the log test: the writes after Cut_Left sectors are lost,
+   the one in progress is torn, and the write-back cache of the device
+   loses a random part of the sectors written since the last CTRL_SYNC,
+   or since the start of the run if Cut_Reorder is set */
+static Bench_CutTypeDef Cut_Mode;
+static int Cut_Done, Cut_Reorder;
+static unsigned long Cut_Left;
+static DWORD Cut_Rnd;
+static Bench_SectorListTypeDef Cut_Undo, Cut_Cache;
+#endif
+
+static BYTE Buffer[CHUNK_SIZE];
+static BYTE Check[CHUNK_SIZE];
+static int Upload_Sock;
+
+/* RAM disk of the tests chosen with -t, and its FAT area, whose reads are
+   counted apart */
+static BYTE *Ram_Mem;
+static size_t Ram_Size;
+static DWORD Fat_Start, Fat_End;
+static unsigned long Fat_Rd;
+
+#if _FS_REENTRANT
+volatile int osMutexCount;        /* Sync objects alive, see cmsis_os.h */
+static volatile int Lock_Done;
+static double Lock_Sum, Lock_Max;
+static unsigned long Lock_Passes, Lock_Files, Lock_Getfree;
+#endif
+
+/* Private function prototypes -----------------------------------------------*/
+static DSTATUS BENCH_initialize (BYTE);
+static DSTATUS BENCH_status (BYTE);
+static DRESULT BENCH_read (BYTE, BYTE*, DWORD, BYTE);
+static DRESULT BENCH_write (BYTE, const BYTE*, DWORD, BYTE);
+static DRESULT BENCH_ioctl (BYTE, BYTE, void*);
+static void BENCH_DiskEnter (BYTE count);
+static void BENCH_DiskLeave (void);
+#if _USE_LOG
+static DRESULT BENCH_CutWrite (const BYTE *buff, DWORD sector, BYTE count);
+#endif
+#if _DISK_ASYNC > 0
+static DRESULT BENCH_write_start (BYTE, const BYTE*, DWORD, BYTE);
+static uint8_t BENCH_write_done (BYTE, DRESULT*);
+static void BENCH_write_wait (BYTE);
+static void BENCH_SimCommand (BYTE count, int wait);
+#endif
+
+static Diskio_drvTypeDef  BENCH_Driver =
+{
+  BENCH_initialize,
+  BENCH_status,
+  BENCH_read,
+  BENCH_write,
+  BENCH_ioctl,
+#if _DISK_ASYNC > 0
+#if _USE_WRITEV == 1
+  NULL,
+#endif
+  BENCH_write_start,
+  BENCH_write_done,
+  NULL,
+#endif
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+static DSTATUS BENCH_initialize(BYTE lun)
+{
+  return Target->disk_initialize(lun);
+}
+
+static DSTATUS BENCH_status(BYTE lun)
+{
+  return Target->disk_status(lun);
+}
+
+static DRESULT BENCH_read(BYTE lun, BYTE *buff, DWORD sector, BYTE count)
+{
+  DRESULT res;
+
+  BENCH_DiskEnter(count);
+  Rd_Cmd++;
+  Rd_Sect += count;
+  if((sector < Fat_End) && (sector + count > Fat_Start))
+  {
+    Fat_Rd++;
+  }
+#if _DISK_ASYNC > 0
+  BENCH_SimCommand(count, 1);
+#endif
+  res = Target->disk_read(lun, buff, sector, count);
+  BENCH_DiskLeave();
+  return res;
+}
+
+static DRESULT BENCH_write(BYTE lun, const BYTE *buff, DWORD sector, BYTE count)
+{
+  DRESULT res;
+
+  BENCH_DiskEnter(count);
+  Wr_Cmd++;
+  Wr_Sect += count;
+#if _DISK_ASYNC > 0
+  BENCH_SimCommand(count, 1);
+#endif
+#if _USE_LOG
+  if(Cut_Mode != CUT_OFF)
+  {
+    res = BENCH_CutWrite(buff, sector, count);
+  }
+  else
+#endif
+  res = Target->disk_write(lun, buff, sector, count);
+  BENCH_DiskLeave();
+  return res;
+}
+
+static DRESULT BENCH_ioctl(BYTE lun, BYTE cmd, void *buff)
+{
+#if _USE_LOG
+  if((Cut_Mode == CUT_ARMED) && (cmd == CTRL_SYNC))
+  {
+    if(Cut_Done)
+    {
+      return RES_ERROR;
+    }
+    if(!Cut_Reorder)
+    {
+      Cut_Cache.count = 0;    /* The cache of the device is written */
+    }
+  }
+#endif
+  return Target->disk_ioctl(lun, cmd, buff);
+}
+
+#if _USE_LOG
+/**
+  * @brief  Gets a random number of the power cut
+  * @param  None
+  * @retval Random number, 0 to 32767
+  */
+static UINT BENCH_CutRandom(void)
+{
+  Cut_Rnd = Cut_Rnd * 1103515245 + 12345;
+  return (Cut_Rnd >> 16) & 0x7FFF;
+}
+
+/**
+  * @brief  Keeps the content of a sector before its first write
+  * @param  list: Sectors kept
+  * @param  sector: Sector address (LBA)
+  * @retval None
+  */
+static void BENCH_CutKeep(Bench_SectorListTypeDef *list, DWORD sector)
+{
+  UINT i;
+
+  for(i = 0; i < list->count; i++)
+  {
+    if(list->sect[i].sector == sector)
+    {
+      return;
+    }
+  }
+  if(list->count == list->max)
+  {
+    list->max = list->max ? list->max * 2 : 64;
+    list->sect = realloc(list->sect, list->max * sizeof(Bench_SectorTypeDef));
+    if(list->sect == NULL)
+    {
+      printf("Cannot allocate the sector list\n");
+      exit(1);
+    }
+  }
+  list->sect[list->count].sector = sector;
+  memcpy(list->sect[list->count].data, Ram_Mem + (size_t)sector * 512, 512);
+  list->count++;
+}
+
+/**
+  * @brief  Writes sectors of the RAM disk, up to the power cut
+  * @param  buff: Data to be written
+  * @param  sector: Sector address (LBA)
+  * @param  count: Number of sectors
+  * @retval RES_ERROR once the power is cut
+  */
+static DRESULT BENCH_CutWrite(const BYTE *buff, DWORD sector, BYTE count)
+{
+  BYTE *p;
+  BYTE i;
+
+  for(i = 0; i < count; i++)
+  {
+    if((Cut_Mode == CUT_ARMED) && Cut_Done)
+    {
+      return RES_ERROR;
+    }
+    p = Ram_Mem + (size_t)(sector + i) * 512;
+    BENCH_CutKeep(&Cut_Undo, sector + i);
+    if(Cut_Mode == CUT_ARMED)
+    {
+      BENCH_CutKeep(&Cut_Cache, sector + i);
+      if(Cut_Left == 0)
+      {
+        /* The power fails in the middle of this sector */
+        memcpy(p, buff + i * 512, BENCH_CutRandom() % 512);
+        Cut_Done = 1;
+        return RES_ERROR;
+      }
+      Cut_Left--;
+    }
+    memcpy(p, buff + i * 512, 512);
+  }
+  return RES_OK;
+}
+
+/**
+  * @brief  Ends the power cut: the device cache loses each sector written
+  *         since the last CTRL_SYNC with a chance of one in two
+  * @param  None
+  * @retval None
+  */
+static void BENCH_CutReboot(void)
+{
+  UINT i;
+
+  for(i = 0; i < Cut_Cache.count; i++)
+  {
+    if(BENCH_CutRandom() & 1)
+    {
+      memcpy(Ram_Mem + (size_t)Cut_Cache.sect[i].sector * 512, Cut_Cache.sect[i].data, 512);
+    }
+  }
+  Cut_Cache.count = 0;
+  Cut_Mode = CUT_UNDO;
+}
+
+/**
+  * @brief  Restores the sectors written since the start of the recording
+  * @param  None
+  * @retval None
+  */
+static void BENCH_CutRestore(void)
+{
+  UINT i;
+
+  for(i = 0; i < Cut_Undo.count; i++)
+  {
+    memcpy(Ram_Mem + (size_t)Cut_Undo.sect[i].sector * 512, Cut_Undo.sect[i].data, 512);
+  }
+  Cut_Undo.count = 0;
+  Cut_Mode = CUT_OFF;
+}
+#endif
+
+#if _DISK_ASYNC > 0
+/**
+  * @brief  Starts a write, which ends in the simulated time of the disk
+  * @param  lun: Unit
+  * @param  buff: Data to be written
+  * @param  sector: Sector address (LBA)
+  * @param  count: Number of sectors
+  * @retval RES_OK, the result is given by BENCH_write_done
+  */
+static DRESULT BENCH_write_start(BYTE lun, const BYTE *buff, DWORD sector, BYTE count)
+{
+  Wr_Cmd++;
+  Wr_Sect += count;
+  Sim_Result = Target->disk_write(lun, buff, sector, count);
+  if(Sim_Fail)
+  {
+    Sim_Fail = 0;
+    Sim_Result = RES_ERROR;
+  }
+  BENCH_SimCommand(count, 0);
+  return RES_OK;
+}
+
+/**
+  * @brief  Polls the started write, each poll of a busy disk takes CPU time
+  * @param  lun: Unit
+  * @param  res: Result of the write, once completed
+  * @retval 1 if the write is completed
+  */
+static uint8_t BENCH_write_done(BYTE lun, DRESULT *res)
+{
+  Sim_Polls++;
+  if(Sim_Now < Sim_Done)
+  {
+    Sim_Now += ASYNC_POLL_TIME;
+    Sim_Blocked += ASYNC_POLL_TIME;
+    return 0;
+  }
+  *res = Sim_Result;
+  return 1;
+}
+
+/**
+  * @brief  Blocks until the end of the started write, as a driver that
+  *         waits for the interrupt of the disk
+  * @param  lun: Unit
+  * @retval None
+  */
+static void BENCH_write_wait(BYTE lun)
+{
+  if(Sim_Now < Sim_Done)
+  {
+    Sim_Blocked += Sim_Done - Sim_Now;
+    Sim_Now = Sim_Done;
+  }
+}
+
+/**
+  * @brief  Runs a command on the simulated disk, after the one in progress
+  * @param  count: Number of sectors
+  * @param  wait: The CPU waits for the end of the command
+  * @retval None
+  */
+static void BENCH_SimCommand(BYTE count, int wait)
+{
+  if(!Sim_On)
+  {
+    return;
+  }
+  Sim_Done = ((Sim_Done > Sim_Now) ? Sim_Done : Sim_Now) + ASYNC_LATENCY + ASYNC_SECTOR_TIME * count;
+  if(wait)
+  {
+    Sim_Blocked += Sim_Done - Sim_Now;
+    Sim_Now = Sim_Done;
+  }
+}
+#endif
+
+/**
+  * @brief  Starts a command of the disk: checks that no other command runs
+  *         and waits for the time of the slow disk
+  * @param  count: Number of sectors
+  * @retval None
+  */
+static void BENCH_DiskEnter(BYTE count)
+{
+  struct timespec t;
+  uint32_t us;
+
+  if(__sync_lock_test_and_set(&Disk_Busy, 1))
+  {
+    printf("  disk driver entered by two threads\n");
+    abort();
+  }
+  us = Disk_Latency + Disk_SectorTime * count;
+  if(us)
+  {
+    t.tv_sec = us / 1000000;
+    t.tv_nsec = (us % 1000000) * 1000L;
+    nanosleep(&t, NULL);
+  }
+}
+
+/**
+  * @brief  Ends a command of the disk
+  * @param  None
+  * @retval None
+  */
+static void BENCH_DiskLeave(void)
+{
+  __sync_lock_release(&Disk_Busy);
+}
+
+/**
+  * @brief  Gets the time
+  * @param  None
+  * @retval Monotonic time in seconds
+  */
+static double BENCH_Now(void)
+{
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/**
+  * @brief  Resets the command counters
+  * @param  None
+  * @retval None
+  */
+static void BENCH_ResetCounters(void)
+{
+  Rd_Cmd = Rd_Sect = Wr_Cmd = Wr_Sect = 0;
+}
+
+/**
+  * @brief  Fills a buffer with the data of an offset of a file
+  * @param  buff: Buffer
+  * @param  ofs: File offset of the buffer
+  * @param  len: Number of bytes
+  * @retval None
+  */
+static void BENCH_Pattern(BYTE *buff, DWORD ofs, UINT len)
+{
+  UINT i;
+
+  for(i = 0; i < len; i++)
+  {
+    buff[i] = (BYTE)((ofs + i) * 13 + ((ofs + i) >> 9));
+  }
+}
+
+/**
+  * @brief  Sends file data to the upload socket, f_forward/f_stream sink
+  * @param  p: Data to send
+  * @param  btf: Number of bytes, 0 to sense the stream
+  * @retval Number of bytes sent, or 1 when the stream is ready
+  */
+static UINT BENCH_Sink(const BYTE *p, UINT btf)
+{
+  UINT cnt = 0;
+  ssize_t n;
+
+  if(btf == 0)
+  {
+    return 1;
+  }
+  while(cnt < btf)
+  {
+    n = send(Upload_Sock, p + cnt, btf - cnt, 0);
+    if(n <= 0)
+    {
+      break;
+    }
+    cnt += n;
+  }
+  return cnt;
+}
+
+/**
+  * @brief  Receives an upload in a child process and checks its data
+  * @param  sock: Receiving end of the socket pair
+  * @param  size: Expected number of bytes
+  * @retval None, the child exits with 0 when the data is correct
+  */
+static void BENCH_Receiver(int sock, DWORD size)
+{
+  static BYTE rx[CHUNK_SIZE], ref[CHUNK_SIZE];
+  DWORD ofs = 0;
+  ssize_t n;
+  int ok = 1;
+
+  while((n = recv(sock, rx, sizeof(rx), 0)) > 0)
+  {
+    BENCH_Pattern(ref, ofs, n);
+    if(memcmp(rx, ref, n) != 0)
+    {
+      ok = 0;
+    }
+    ofs += n;
+  }
+  _exit((ok && (ofs == size)) ? 0 : 1);
+}
+
+/**
+  * @brief  Uploads a file to a socket read by a child process
+  * @param  mode: Read function of the upload
+  * @param  size: File size
+  * @retval None
+  */
+static void BENCH_Upload(Bench_UploadTypeDef mode, DWORD size)
+{
+  static const char *const label[] = {"f_read + send   ", "f_forward       ", "f_stream 32 KB  "};
+  FIL fil;
+  UINT bw;
+  DWORD ofs;
+  int sv[2], status;
+  pid_t pid;
+  double t;
+
+  if(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0)
+  {
+    printf("  socketpair failed\n");
+    exit(1);
+  }
+  fflush(stdout);
+  pid = fork();
+  if(pid == 0)
+  {
+    close(sv[0]);
+    BENCH_Receiver(sv[1], size);
+  }
+  close(sv[1]);
+  Upload_Sock = sv[0];
+
+  BENCH_ResetCounters();
+  t = BENCH_Now();
+  CHECK(f_open(&fil, "seq.bin", FA_READ));
+  for(ofs = 0; ofs < size; ofs += bw)
+  {
+    switch(mode)
+    {
+    case UPLOAD_READ:
+      CHECK(f_read(&fil, Buffer, CHUNK_SIZE, &bw));
+      bw = BENCH_Sink(Buffer, bw);
+      break;
+    case UPLOAD_FORWARD:
+      CHECK(f_forward(&fil, BENCH_Sink, CHUNK_SIZE, &bw));
+      break;
+    default:
+      CHECK(f_stream(&fil, BENCH_Sink, Buffer, CHUNK_SIZE, CHUNK_SIZE, &bw));
+      break;
+    }
+    if(bw == 0)
+    {
+      printf("  upload stopped at %lu\n", (unsigned long)ofs);
+      exit(1);
+    }
+  }
+  CHECK(f_close(&fil));
+  close(sv[0]);
+  waitpid(pid, &status, 0);
+  t = BENCH_Now() - t;
+  if(!WIFEXITED(status) || (WEXITSTATUS(status) != 0))
+  {
+    printf("  upload data error\n");
+    exit(1);
+  }
+  printf("  upload %s: %8.2f MB/s  %6lu reads,  %6.1f sectors/read\n",
+         label[mode], size / t / 1048576, Rd_Cmd, (double)Rd_Sect / Rd_Cmd);
+}
+
+/**
+  * @brief  Writes a file with a short f_write then a long one, and checks
+  *         the data read back
+  * @param  None
+  * @retval None
+  */
+static void BENCH_Unaligned(void)
+{
+  const UINT size = UNALIGNED_HEAD + UNALIGNED_SIZE;
+  BYTE *data, *back;
+  FIL fil;
+  UINT bw, i;
+
+  data = malloc(size);
+  back = malloc(size);
+  BENCH_Pattern(data, 0, size);
+  CHECK(f_open(&fil, "unalign.bin", FA_CREATE_ALWAYS | FA_WRITE));
+  CHECK(f_write(&fil, data, UNALIGNED_HEAD, &bw));
+  CHECK(f_write(&fil, data + UNALIGNED_HEAD, UNALIGNED_SIZE, &bw));
+  CHECK_FULL(bw == UNALIGNED_SIZE);
+  CHECK(f_close(&fil));
+
+  CHECK(f_open(&fil, "unalign.bin", FA_READ));
+  CHECK(f_read(&fil, back, size, &bw));
+  CHECK(f_close(&fil));
+  for(i = 0; (i < size) && (data[i] == back[i]); i++)
+  {
+  }
+  if((bw != size) || (i != size))
+  {
+    printf("  unaligned write data error at %u\n", i);
+    exit(1);
+  }
+  printf("  unaligned write   %u + %u B : data checked\n", UNALIGNED_HEAD, UNALIGNED_SIZE);
+  CHECK(f_unlink("unalign.bin"));
+  free(back);
+  free(data);
+}
+
+/**
+  * @brief  Runs the tests on a volume
+  * @param  path: Logical drive path
+  * @param  vol: Volume parameters
+  * @param  seq_mb: Size of the sequential file in MB
+  * @param  nfiles: Number of files of the many file test
+  * @retval None
+  */
+static void BENCH_Volume(char *path, const Bench_VolumeTypeDef *vol, uint32_t seq_mb, uint32_t nfiles)
+{
+  DWORD *clmt;
+  FATFS fs;
+  FIL fil, pad;
+  DIR dir;
+  FILINFO fno;
+  UINT bw, i, n, pass;
+  DWORD ofs, size, rnd;
+  double t;
+  char name[20];
+
+  CHECK(f_mount(&fs, path, 0));
+  CHECK(f_mkfs(path, 0, vol->au));
+  CHECK(f_mount(&fs, path, 1));
+  printf("\n%s, %u-byte clusters, %lu MB volume (%lu clusters)\n",
+         (fs.fs_type == FS_FAT32) ? "FAT32" : (fs.fs_type == FS_FAT16) ? "FAT16" : "FAT12",
+         (unsigned)(fs.csize * 512), (unsigned long)vol->size_mb, (unsigned long)(fs.n_fatent - 2));
+  if(strcmp(vol->name, (fs.fs_type == FS_FAT32) ? "FAT32" : "FAT16") != 0)
+  {
+    printf("  (expected %s)\n", vol->name);
+  }
+
+  /* Sequential write */
+  size = seq_mb << 20;
+  BENCH_ResetCounters();
+  t = BENCH_Now();
+  CHECK(f_open(&fil, "seq.bin", FA_CREATE_ALWAYS | FA_WRITE));
+  for(ofs = 0; ofs < size; ofs += CHUNK_SIZE)
+  {
+    BENCH_Pattern(Buffer, ofs, CHUNK_SIZE);
+    CHECK(f_write(&fil, Buffer, CHUNK_SIZE, &bw));
+    CHECK_FULL(bw == CHUNK_SIZE);
+  }
+  CHECK(f_close(&fil));
+  t = BENCH_Now() - t;
+  printf("  sequential write  %5lu KB     : %8.2f MB/s  %6lu writes, %6.1f sectors/write\n",
+         (unsigned long)(size >> 10), size / t / 1048576, Wr_Cmd, (double)Wr_Sect / Wr_Cmd);
+
+  /* Sequential read */
+  BENCH_ResetCounters();
+  t = BENCH_Now();
+  CHECK(f_open(&fil, "seq.bin", FA_READ));
+  for(ofs = 0; ofs < size; ofs += CHUNK_SIZE)
+  {
+    CHECK(f_read(&fil, Buffer, CHUNK_SIZE, &bw));
+    BENCH_Pattern(Check, ofs, CHUNK_SIZE);
+    if((bw != CHUNK_SIZE) || (memcmp(Buffer, Check, CHUNK_SIZE) != 0))
+    {
+      printf("  data error at %lu\n", (unsigned long)ofs);
+      exit(1);
+    }
+  }
+  CHECK(f_close(&fil));
+  t = BENCH_Now() - t;
+  printf("  sequential read   %5lu KB     : %8.2f MB/s  %6lu reads,  %6.1f sectors/read\n",
+         (unsigned long)(size >> 10), size / t / 1048576, Rd_Cmd, (double)Rd_Sect / Rd_Cmd);
+
+  /* Unaligned write of more than MAX_XFER sectors: the first sector is in
+     the file buffer when the large f_write starts */
+  BENCH_Unaligned();
+
+  /* Upload of the sequential file to a socket */
+  BENCH_Upload(UPLOAD_READ, size);
+  BENCH_Upload(UPLOAD_FORWARD, size);
+  BENCH_Upload(UPLOAD_STREAM, size);
+
+  /* Small file create */
+  CHECK(f_mkdir("small"));
+  BENCH_Pattern(Buffer, 0, SMALL_SIZE);
+  BENCH_ResetCounters();
+  t = BENCH_Now();
+  for(i = 0; i < SMALL_FILES; i++)
+  {
+    sprintf(name, "small/f%04u.dat", i);
+    CHECK(f_open(&fil, name, FA_CREATE_NEW | FA_WRITE));
+    CHECK(f_write(&fil, Buffer, SMALL_SIZE, &bw));
+    CHECK(f_close(&fil));
+  }
+  t = BENCH_Now() - t;
+  printf("  small file create %3u x %4u B : %8.0f files/s  %5.1f reads, %5.1f writes per file\n",
+         SMALL_FILES, SMALL_SIZE, SMALL_FILES / t, (double)Rd_Cmd / SMALL_FILES, (double)Wr_Cmd / SMALL_FILES);
+
+  /* Directory enumeration */
+  BENCH_ResetCounters();
+  t = BENCH_Now();
+  n = 0;
+  for(pass = 0; pass < DIR_PASSES; pass++)
+  {
+    CHECK(f_opendir(&dir, "small"));
+    for(;;)
+    {
+      CHECK(f_readdir(&dir, &fno));
+      if(fno.fname[0] == 0) break;
+      n++;
+    }
+    CHECK(f_closedir(&dir));
+  }
+  t = BENCH_Now() - t;
+  if(n != SMALL_FILES * DIR_PASSES)
+  {
+    printf("  directory has %u entries\n", n / DIR_PASSES);
+    exit(1);
+  }
+  printf("  directory read    %3u x %2u     : %8.0f entries/s  %5.1f sectors read per pass\n",
+         SMALL_FILES, DIR_PASSES, n / t, (double)Rd_Sect / DIR_PASSES);
+
+  /* Random access on a fragmented file: f_lseek follows the FAT chain, then
+     with the cluster link map table (fast-seek) */
+  CHECK(f_open(&fil, "frag.bin", FA_CREATE_ALWAYS | FA_WRITE));
+  CHECK(f_open(&pad, "pad.bin", FA_CREATE_ALWAYS | FA_WRITE));
+  size = (seq_mb << 20) / 2;
+  for(ofs = 0; ofs < size; ofs += fs.csize * 512)
+  {
+    BENCH_Pattern(Buffer, ofs, fs.csize * 512 > CHUNK_SIZE ? CHUNK_SIZE : fs.csize * 512);
+    for(n = 0; n < fs.csize * 512; n += bw)
+    {
+      CHECK(f_write(&fil, Buffer, fs.csize * 512 - n > CHUNK_SIZE ? CHUNK_SIZE : fs.csize * 512 - n, &bw));
+      CHECK_FULL(bw != 0);
+    }
+    CHECK(f_write(&pad, Buffer, 1, &bw));
+    CHECK_FULL(bw != 0);
+    CHECK(f_sync(&pad));
+    CHECK(f_lseek(&pad, f_size(&pad) + fs.csize * 512 - 1));
+  }
+  CHECK(f_close(&pad));
+  CHECK(f_close(&fil));
+
+  for(pass = 0; pass < 2; pass++)
+  {
+    CHECK(f_open(&fil, "frag.bin", FA_READ));
+    if(pass == 1)
+    {
+      /* The table is sized by a first try, which returns the number of items needed */
+      clmt = malloc(CLMT_SIZE * sizeof(DWORD));
+      fil.cltbl = clmt;
+      clmt[0] = CLMT_SIZE;
+      if(f_lseek(&fil, CREATE_LINKMAP) == FR_NOT_ENOUGH_CORE)
+      {
+        clmt = realloc(clmt, clmt[0] * sizeof(DWORD));
+        fil.cltbl = clmt;
+        CHECK(f_lseek(&fil, CREATE_LINKMAP));
+      }
+      printf("  fast-seek table   %5lu items  : %8lu bytes\n", (unsigned long)clmt[0], (unsigned long)clmt[0] * 4);
+    }
+    BENCH_ResetCounters();
+    rnd = 1;
+    t = BENCH_Now();
+    for(i = 0; i < SEEK_OPS; i++)
+    {
+      rnd = rnd * 1103515245 + 12345;
+      ofs = (rnd >> 8) % (size - 512);
+      CHECK(f_lseek(&fil, ofs));
+      CHECK(f_read(&fil, Buffer, 512, &bw));
+    }
+    t = BENCH_Now() - t;
+    CHECK(f_close(&fil));
+    if(pass == 1)
+    {
+      free(clmt);
+    }
+    printf("  %s %4u x 512 B : %8.0f ops/s    %5.2f sectors read per op\n",
+           pass ? "fast-seek + read " : "f_lseek + read   ", SEEK_OPS, SEEK_OPS / t, (double)Rd_Sect / SEEK_OPS);
+  }
+
+  /* Create and open in a directory of many files (numbered logs) */
+  if(nfiles)
+  {
+    CHECK(f_mkdir("logs"));
+    BENCH_ResetCounters();
+    t = BENCH_Now();
+    for(i = 0; i < nfiles; i++)
+    {
+      sprintf(name, "logs/%u.csv", i);
+      CHECK(f_open(&fil, name, FA_CREATE_NEW | FA_WRITE));
+      CHECK(f_close(&fil));
+    }
+    t = BENCH_Now() - t;
+    printf("  many files create %5lu files  : %8.0f files/s  %5.1f sectors read per file\n",
+           (unsigned long)nfiles, nfiles / t, (double)Rd_Sect / nfiles);
+
+    BENCH_ResetCounters();
+    rnd = 1;
+    t = BENCH_Now();
+    for(i = 0; i < OPEN_OPS; i++)
+    {
+      rnd = rnd * 1103515245 + 12345;
+      sprintf(name, "logs/%lu.csv", (unsigned long)((rnd >> 8) % nfiles));
+      CHECK(f_open(&fil, name, FA_READ));
+      CHECK(f_close(&fil));
+    }
+    t = BENCH_Now() - t;
+    printf("  many files open   %5u opens  : %8.0f opens/s  %5.1f sectors read per open\n",
+           OPEN_OPS, OPEN_OPS / t, (double)Rd_Sect / OPEN_OPS);
+  }
+
+  CHECK(f_mount(NULL, path, 0));
+}
+
+/**
+  * @brief  Makes a volume on a RAM disk and mounts it, for the tests that do
+  *         not run on the four volumes
+  * @param  path: Logical drive path, returned
+  * @param  fs: File system object
+  * @param  size_mb: Volume size
+  * @param  au: Cluster size in bytes
+  * @retval None
+  */
+static void BENCH_RamVolume(char *path, FATFS *fs, uint32_t size_mb, UINT au)
+{
+  DWORD sectors = size_mb * 2048;
+
+  Ram_Size = (size_t)sectors * 512;
+  Ram_Mem = mmap(NULL, Ram_Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if((Ram_Mem == MAP_FAILED) || RAMDISK_Attach(Ram_Mem, sectors))
+  {
+    printf("Cannot allocate the RAM disk\n");
+    exit(1);
+  }
+  Target = &RAMDISK_Driver;
+  FATFS_LinkDriver(&BENCH_Driver, path);
+  CHECK(f_mount(fs, path, 0));
+  CHECK(f_mkfs(path, 0, au));
+  CHECK(f_mount(fs, path, 1));
+}
+
+/**
+  * @brief  Unmounts the volume of BENCH_RamVolume and frees the RAM disk
+  * @param  path: Logical drive path
+  * @retval None
+  */
+static void BENCH_RamRelease(char *path)
+{
+  CHECK(f_mount(NULL, path, 0));
+  FATFS_UnLinkDriver(path);
+  munmap(Ram_Mem, Ram_Size);
+}
+
+/**
+  * @brief  Counts the free clusters of a volume from the FAT on the disk,
+  *         without FatFs
+  * @param  fs: File system object of the volume
+  * @retval Number of free clusters
+  */
+static DWORD BENCH_FreeScan(FATFS *fs)
+{
+  const BYTE *fat = Ram_Mem + (size_t)fs->fatbase * 512;
+  DWORD clst, n = 0;
+
+  for(clst = 2; clst < fs->n_fatent; clst++)
+  {
+    if(((fs->fs_type == FS_FAT32) ? (LD_DWORD(fat + clst * 4) & 0x0FFFFFFF) : LD_WORD(fat + clst * 2)) == 0)
+    {
+      n++;
+    }
+  }
+  return n;
+}
+
+/**
+  * @brief  Sets the area of the FAT copies of a volume, whose reads are
+  *         counted apart
+  * @param  fs: File system object of the volume
+  * @retval None
+  */
+static void BENCH_FatArea(FATFS *fs)
+{
+  Fat_Start = fs->fatbase;
+  Fat_End = fs->fatbase + fs->fsize * fs->n_fats;
+  Fat_Rd = 0;
+}
+
+/**
+  * @brief  Counts the fragments of a file, from its cluster link map table
+  * @param  name: File name
+  * @retval Number of runs of contiguous clusters
+  */
+static DWORD BENCH_Fragments(const char *name)
+{
+  DWORD tbl[2] = { 2, 0 };
+  FIL fil;
+  FRESULT res;
+
+  CHECK(f_open(&fil, name, FA_READ));
+  fil.cltbl = tbl;
+  res = f_lseek(&fil, CREATE_LINKMAP);    /* Too small, returns the size needed */
+  fil.cltbl = NULL;
+  CHECK(f_close(&fil));
+  if((res != FR_OK) && (res != FR_NOT_ENOUGH_CORE))
+  {
+    CHECK(res);
+  }
+  return (tbl[0] - 1) / 2;
+}
+
+/**
+  * @brief  Appends a log with an f_sync every EXPAND_SYNC bytes, with or
+  *         without a preallocation, and checks it
+  * @param  label: Name of the case
+  * @param  rec: Bytes per f_write
+  * @param  expand: Preallocate the log with f_expand
+  * @retval None
+  */
+static void BENCH_ExpandCase(const char *label, UINT rec, int expand)
+{
+  FIL fil;
+  UINT bw;
+  DWORD ofs, n;
+
+  BENCH_ResetCounters();
+  Fat_Rd = 0;
+  CHECK(f_open(&fil, "log.bin", FA_CREATE_ALWAYS | FA_WRITE));
+  if(expand)
+  {
+    CHECK(f_expand(&fil, EXPAND_SIZE, 1));
+  }
+  for(ofs = 0; ofs < EXPAND_SIZE; ofs += n)
+  {
+    n = (EXPAND_SIZE - ofs < rec) ? EXPAND_SIZE - ofs : rec;
+    BENCH_Pattern(Buffer, ofs, n);
+    CHECK(f_write(&fil, Buffer, n, &bw));
+    CHECK_FULL(bw == n);
+    if(((ofs + n) % EXPAND_SYNC) < n)
+    {
+      CHECK(f_sync(&fil));
+    }
+  }
+  CHECK(f_truncate(&fil));
+  CHECK(f_close(&fil));
+  printf("  %-30s %6lu  %8lu  %9lu\n", label, Fat_Rd, Wr_Cmd, (unsigned long)BENCH_Fragments("log.bin"));
+
+  CHECK(f_open(&fil, "log.bin", FA_READ));
+  for(ofs = 0; ofs < EXPAND_SIZE; ofs += CHUNK_SIZE)
+  {
+    CHECK(f_read(&fil, Buffer, CHUNK_SIZE, &bw));
+    BENCH_Pattern(Check, ofs, CHUNK_SIZE);
+    if((bw != CHUNK_SIZE) || (memcmp(Buffer, Check, CHUNK_SIZE) != 0))
+    {
+      printf("  data error at %lu\n", (unsigned long)ofs);
+      exit(1);
+    }
+  }
+  CHECK(f_close(&fil));
+  CHECK(f_unlink("log.bin"));
+}
+
+/**
+  * @brief  Compares the free clusters counted by FatFs with the FAT
+  * @param  fs: File system object of the volume
+  * @retval 0 if they are the same
+  */
+static int BENCH_ExpandFree(FATFS *fs)
+{
+  FATFS *pfs;
+  DWORD nclst;
+
+  CHECK(f_getfree("", &nclst, &pfs));
+  if(nclst != BENCH_FreeScan(fs))
+  {
+    printf("  %lu free clusters counted, %lu in the FAT\n", (unsigned long)nclst, (unsigned long)BENCH_FreeScan(fs));
+    return 1;
+  }
+  return 0;
+}
+
+/**
+  * @brief  Appends a log on an empty and on a fragmented volume, with and
+  *         without f_expand
+  * @param  None
+  * @retval 0 on success
+  */
+static int BENCH_Expand(void)
+{
+  FATFS fs;
+  FIL fil;
+  UINT bw, i;
+  char path[4], name[20];
+
+  BENCH_RamVolume(path, &fs, 512, 4096);
+  BENCH_FatArea(&fs);
+  printf("f_expand test, FAT32, %u-byte clusters, %lu KB log, f_sync every %u KB\n",
+         (unsigned)(fs.csize * 512), EXPAND_SIZE >> 10, EXPAND_SYNC >> 10);
+  printf("                                 FAT rd  wr cmds  fragments\n");
+  BENCH_ExpandCase("26 B records, no prealloc", EXPAND_RECORD, 0);
+  BENCH_ExpandCase("26 B records, f_expand", EXPAND_RECORD, 1);
+  BENCH_ExpandCase("4 KB writes, no prealloc", 4096, 0);
+  BENCH_ExpandCase("4 KB writes, f_expand", 4096, 1);
+  if(BENCH_ExpandFree(&fs) != 0)
+  {
+    return 1;
+  }
+  BENCH_RamRelease(path);
+
+  /* On a new volume, one cluster files, every other one deleted, and no
+     allocation hint as after a mount without FSINFO */
+  BENCH_RamVolume(path, &fs, 512, 4096);
+  BENCH_FatArea(&fs);
+  CHECK(f_mkdir("holes"));
+  memset(Buffer, 0x55, fs.csize * 512);
+  for(i = 0; i < EXPAND_HOLES; i++)
+  {
+    sprintf(name, "holes/%u", i);
+    CHECK(f_open(&fil, name, FA_CREATE_NEW | FA_WRITE));
+    CHECK(f_write(&fil, Buffer, fs.csize * 512, &bw));
+    CHECK(f_close(&fil));
+  }
+  for(i = 0; i < EXPAND_HOLES; i += 2)
+  {
+    sprintf(name, "holes/%u", i);
+    CHECK(f_unlink(name));
+  }
+  fs.last_clust = 0;
+  BENCH_ExpandCase("fragmented, 4 KB, no prealloc", 4096, 0);
+  fs.last_clust = 0;
+  BENCH_ExpandCase("fragmented, 4 KB, f_expand", 4096, 1);
+  if(BENCH_ExpandFree(&fs) != 0)
+  {
+    return 1;
+  }
+  BENCH_RamRelease(path);
+  printf("  data checked, free clusters as in the FAT\n");
+  return 0;
+}
+
+/**
+  * @brief  Hashes sectors of the RAM disk, to compare the images left by two
+  *         builds
+  * @param  sector: First sector
+  * @param  count: Number of sectors
+  * @retval FNV-1a hash of the sectors
+  */
+static unsigned long long BENCH_Hash(DWORD sector, DWORD count)
+{
+  unsigned long long h = 14695981039346656037ULL;
+  size_t i;
+
+  for(i = (size_t)sector * 512; i < ((size_t)sector + count) * 512; i++)
+  {
+    h = (h ^ Ram_Mem[i]) * 1099511628211ULL;
+  }
+  return h;
+}
+
+/**
+  * @brief  Appends records to logs in turn, with an f_sync of each one every
+  *         CACHE_SYNC bytes
+  * @param  fil: Open logs
+  * @param  nfil: Number of logs
+  * @param  size: Bytes appended to each log
+  * @retval None
+  */
+static void BENCH_CacheLogs(FIL *fil, UINT nfil, DWORD size)
+{
+  DWORD ofs;
+  UINT bw, i;
+
+  for(ofs = 0; ofs < size; ofs += CACHE_RECORD)
+  {
+    for(i = 0; i < nfil; i++)
+    {
+      BENCH_Pattern(Buffer, ofs + i, CACHE_RECORD);
+      CHECK(f_write(&fil[i], Buffer, CACHE_RECORD, &bw));
+      CHECK_FULL(bw == CACHE_RECORD);
+      if(((ofs + CACHE_RECORD) % CACHE_SYNC) == 0)
+      {
+        CHECK(f_sync(&fil[i]));
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Counts the commands of log and directory workloads, which go
+  *         through the sector cache of the FAT and directory sectors
+  * @param  None
+  * @retval 0 on success
+  */
+static int BENCH_Cache(void)
+{
+  FATFS fs;
+  FILINFO fno;
+  FIL fil[2];
+  UINT i;
+  char path[4], name[20], label[40];
+
+  BENCH_RamVolume(path, &fs, 512, 4096);
+  printf("Sector cache test, _FS_CACHE %d, FAT32, %u-byte clusters\n", _FS_CACHE, (unsigned)(fs.csize * 512));
+  printf("                                           rd      wr\n");
+
+  BENCH_ResetCounters();
+  CHECK(f_open(&fil[0], "log.bin", FA_CREATE_ALWAYS | FA_WRITE));
+  BENCH_CacheLogs(fil, 1, CACHE_LOG_SIZE);
+  CHECK(f_close(&fil[0]));
+  sprintf(label, "log append %lu KB, f_sync per %u KB", CACHE_LOG_SIZE >> 10, CACHE_SYNC >> 10);
+  printf("  %-36s %6lu  %6lu\n", label, Rd_Cmd, Wr_Cmd);
+
+  BENCH_ResetCounters();
+  CHECK(f_open(&fil[0], "log1.bin", FA_CREATE_ALWAYS | FA_WRITE));
+  CHECK(f_open(&fil[1], "log2.bin", FA_CREATE_ALWAYS | FA_WRITE));
+  BENCH_CacheLogs(fil, 2, CACHE_LOG2_SIZE);
+  CHECK(f_close(&fil[1]));
+  CHECK(f_close(&fil[0]));
+  sprintf(label, "two logs interleaved, 2 x %lu KB", CACHE_LOG2_SIZE >> 10);
+  printf("  %-36s %6lu  %6lu\n", label, Rd_Cmd, Wr_Cmd);
+
+  CHECK(f_mkdir("dir"));
+  BENCH_ResetCounters();
+  for(i = 0; i < CACHE_FILES; i++)
+  {
+    sprintf(name, "dir/f%u.dat", i);
+    CHECK(f_open(&fil[0], name, FA_CREATE_NEW | FA_WRITE));
+    CHECK(f_close(&fil[0]));
+  }
+  sprintf(label, "create %u files in a directory", CACHE_FILES);
+  printf("  %-36s %6lu  %6lu\n", label, Rd_Cmd, Wr_Cmd);
+
+  BENCH_ResetCounters();
+  for(i = 0; i < CACHE_FILES; i++)
+  {
+    sprintf(name, "dir/f%u.dat", i);
+    CHECK(f_stat(name, &fno));
+  }
+  sprintf(label, "f_stat %u files", CACHE_FILES);
+  printf("  %-36s %6lu  %6lu\n", label, Rd_Cmd, Wr_Cmd);
+
+  BENCH_ResetCounters();
+  for(i = 0; i < CACHE_FILES; i += 3)
+  {
+    sprintf(name, "dir/f%u.dat", i);
+    CHECK(f_unlink(name));
+  }
+  sprintf(label, "f_unlink %u files", CACHE_FILES / 3);
+  printf("  %-36s %6lu  %6lu\n", label, Rd_Cmd, Wr_Cmd);
+
+  CHECK(f_mount(NULL, path, 0));
+  printf("  image hash %016llx\n", BENCH_Hash(0, Ram_Size / 512));
+  CHECK(f_mount(&fs, path, 0));
+  BENCH_RamRelease(path);
+  return 0;
+}
+
+/**
+  * @brief  Writes files of a number of clusters
+  * @param  fs: File system object of the volume
+  * @param  first: Number of the first file
+  * @param  nfiles: Number of files
+  * @param  nclst: Clusters per file
+  * @param  rescan: Allocate from the start of the volume, without a hint
+  * @retval None
+  */
+static void BENCH_FreemapFiles(FATFS *fs, UINT first, UINT nfiles, UINT nclst, int rescan)
+{
+  FIL fil;
+  UINT bw, i, n;
+  char name[20];
+
+  memset(Buffer, 0xAA, fs->csize * 512);
+  for(i = first; i < first + nfiles; i++)
+  {
+    if(rescan)
+    {
+      fs->last_clust = 0;
+    }
+    sprintf(name, "f%u.bin", i);
+    CHECK(f_open(&fil, name, FA_CREATE_ALWAYS | FA_WRITE));
+    for(n = 0; n < nclst; n++)
+    {
+      CHECK(f_write(&fil, Buffer, fs->csize * 512, &bw));
+      CHECK_FULL(bw == fs->csize * 512);
+    }
+    CHECK(f_close(&fil));
+  }
+}
+
+/**
+  * @brief  Counts the sectors read by the allocation and f_getfree on a
+  *         large, nearly full volume, whose FSINFO is invalid
+  * @param  None
+  * @retval 0 on success
+  */
+static int BENCH_Freemap(void)
+{
+  FATFS fs, *pfs;
+  DWORD clst, used, nclst, n;
+  BYTE *fat;
+  char path[4];
+
+  BENCH_RamVolume(path, &fs, 32768, 32768);
+  printf("Free cluster map test, _FS_FREEMAP %d, FAT32, %u-byte clusters, %lu clusters\n",
+         _FS_FREEMAP, (unsigned)(fs.csize * 512), (unsigned long)(fs.n_fatent - 2));
+
+  /* The volume is filled in its FAT copies: the first FREEMAP_USED percent
+     of the clusters are used but one every FREEMAP_HOLE, and FSINFO has no
+     free count nor hint */
+  CHECK(f_mount(NULL, path, 0));
+  used = (DWORD)((unsigned long long)(fs.n_fatent - 2) * FREEMAP_USED / 100);
+  for(n = 0; n < fs.n_fats; n++)
+  {
+    fat = Ram_Mem + ((size_t)fs.fatbase + n * fs.fsize) * 512;
+    for(clst = 3; clst < used + 2; clst++)
+    {
+      if((clst % FREEMAP_HOLE) != 0)
+      {
+        ST_DWORD(fat + clst * 4, 0x0FFFFFFF);
+      }
+    }
+  }
+  ST_DWORD(Ram_Mem + ((size_t)fs.volbase + 1) * 512 + 488, 0xFFFFFFFF);
+  ST_DWORD(Ram_Mem + ((size_t)fs.volbase + 1) * 512 + 492, 0xFFFFFFFF);
+  printf("                                             sectors read\n");
+
+  BENCH_ResetCounters();
+  CHECK(f_mount(&fs, path, 1));
+  BENCH_FreemapFiles(&fs, 0, 1, 1, 0);
+  printf("  mount + first allocation                  %8lu\n", Rd_Sect);
+
+  BENCH_ResetCounters();
+  CHECK(f_getfree("", &nclst, &pfs));
+  printf("  first f_getfree                           %8lu\n", Rd_Sect);
+
+  BENCH_ResetCounters();
+  BENCH_FreemapFiles(&fs, 1, FREEMAP_FILES, 8, 0);
+  printf("  %u files x 8 clusters                    %8lu\n", FREEMAP_FILES, Rd_Sect);
+
+  BENCH_ResetCounters();
+  BENCH_FreemapFiles(&fs, 1 + FREEMAP_FILES, FREEMAP_RESCANS, 1, 1);
+  printf("  %u files with allocation from cluster 2   %8lu\n", FREEMAP_RESCANS, Rd_Sect);
+
+  BENCH_ResetCounters();
+  fs.free_clust = 0xFFFFFFFF;
+  CHECK(f_getfree("", &nclst, &pfs));
+  printf("  f_getfree with free count invalidated     %8lu\n", Rd_Sect);
+
+  if(nclst != BENCH_FreeScan(&fs))
+  {
+    printf("  %lu free clusters counted, %lu in the FAT\n", (unsigned long)nclst, (unsigned long)BENCH_FreeScan(&fs));
+    return 1;
+  }
+  printf("  %lu free clusters as in the FAT, FAT hash %016llx\n",
+         (unsigned long)nclst, BENCH_Hash(fs.fatbase, fs.fsize * fs.n_fats));
+  BENCH_RamRelease(path);
+  return 0;
+}
+
+#if _DISK_ASYNC > 0
+/**
+  * @brief  Writes CSV files as the application, a row at a time, and
+  *         polls the queue between the rows
+  * @param  queued: Queue the writes, otherwise write in place
+  * @param  wait: The driver blocks the waits for the queue, otherwise they
+  *         poll it
+  * @retval None
+  */
+static void BENCH_AsyncRun(int queued, int wait)
+{
+  FATFS fs;
+  FIL fil;
+  UINT bw, i, f;
+  int len;
+  char path[4], name[20], row[32];
+
+  BENCH_Driver.disk_write_start = queued ? BENCH_write_start : NULL;
+  BENCH_Driver.disk_write_wait = wait ? BENCH_write_wait : NULL;
+  BENCH_RamVolume(path, &fs, 64, 2048);
+  BENCH_ResetCounters();
+  Sim_Now = Sim_Done = Sim_Blocked = 0;
+  Sim_Polls = 0;
+  Sim_On = 1;
+  for(f = 0; f < ASYNC_FILES; f++)
+  {
+    sprintf(name, "%u.csv", f);
+    CHECK(f_open(&fil, name, FA_CREATE_ALWAYS | FA_WRITE));
+    CHECK(f_write(&fil, "indice, valores\r\n", 17, &bw));
+    for(i = 0; i < ASYNC_ROWS; i++)
+    {
+      Sim_Now += ASYNC_ROW_TIME;
+      len = sprintf(row, "%u, %f \r\n", i, (double)((i * 37 + f) % 1000) / 7);
+      CHECK(f_write(&fil, row, len, &bw));
+      CHECK_FULL(bw == (UINT)len);
+      FATFS_AsyncProcess();
+    }
+    CHECK(f_close(&fil));
+  }
+  Sim_On = 0;
+  CHECK(f_mount(NULL, path, 0));
+  printf("  %-7s %u files x %u rows : %7.1f ms total  %7.1f ms blocked on the disk  %5lu writes  %6lu polls  image %016llx\n",
+         !queued ? "sync:" : (wait ? "waited:" : "polled:"), ASYNC_FILES, ASYNC_ROWS, Sim_Now / 1000,
+         Sim_Blocked / 1000, Wr_Cmd, Sim_Polls, BENCH_Hash(0, Ram_Size / 512));
+  CHECK(f_mount(&fs, path, 0));
+  BENCH_RamRelease(path);
+}
+
+/**
+  * @brief  Checks random accesses to a file through the queue, and the
+  *         report of a failed queued write
+  * @param  None
+  * @retval 0 on success
+  */
+static int BENCH_AsyncCheck(void)
+{
+  static BYTE ref[ASYNC_FILE_SIZE], back[ASYNC_FILE_SIZE];
+  FATFS fs;
+  FIL fil;
+  UINT bw, i, k, len;
+  DWORD ofs, rnd = 1;
+  FRESULT res;
+  char path[4];
+
+  BENCH_Driver.disk_write_start = BENCH_write_start;
+  BENCH_Driver.disk_write_wait = BENCH_write_wait;
+  BENCH_RamVolume(path, &fs, 64, 2048);
+  Sim_Now = Sim_Done = Sim_Blocked = 0;
+  Sim_On = 1;
+  BENCH_Pattern(ref, 0, ASYNC_FILE_SIZE);
+  CHECK(f_open(&fil, "rnd.bin", FA_CREATE_ALWAYS | FA_WRITE | FA_READ));
+  CHECK(f_write(&fil, ref, ASYNC_FILE_SIZE, &bw));
+  for(i = 0; i < ASYNC_OPS; i++)
+  {
+    rnd = rnd * 1103515245 + 12345;
+    ofs = (rnd >> 8) % (ASYNC_FILE_SIZE - 4096);
+    len = 1 + (rnd >> 4) % 4096;
+    CHECK(f_lseek(&fil, ofs));
+    if(rnd & 0x80000000)
+    {
+      for(k = 0; k < len; k++)
+      {
+        ref[ofs + k] = (BYTE)(rnd + k);
+      }
+      CHECK(f_write(&fil, ref + ofs, len, &bw));
+    }
+    else
+    {
+      CHECK(f_read(&fil, back, len, &bw));
+      if(memcmp(back, ref + ofs, len) != 0)
+      {
+        printf("  random access data error at %lu\n", (unsigned long)ofs);
+        return 1;
+      }
+    }
+    if((i % 100) == 99)
+    {
+      CHECK(f_sync(&fil));
+    }
+    Sim_Now += ASYNC_ROW_TIME;
+    FATFS_AsyncProcess();
+  }
+  CHECK(f_close(&fil));
+  CHECK(f_mount(NULL, path, 0));
+  CHECK(f_mount(&fs, path, 1));
+  CHECK(f_open(&fil, "rnd.bin", FA_READ));
+  CHECK(f_read(&fil, back, ASYNC_FILE_SIZE, &bw));
+  CHECK(f_close(&fil));
+  if((bw != ASYNC_FILE_SIZE) || (memcmp(back, ref, ASYNC_FILE_SIZE) != 0))
+  {
+    printf("  random access data error after the remount\n");
+    return 1;
+  }
+  printf("  %u random f_read/f_write checked after a remount\n", ASYNC_OPS);
+
+  /* A queued write fails after the f_write returned */
+  CHECK(f_open(&fil, "fail.bin", FA_CREATE_ALWAYS | FA_WRITE));
+  CHECK(f_write(&fil, ref, 512, &bw));
+  Sim_Fail = 1;
+  res = f_sync(&fil);
+  f_close(&fil);
+  Sim_On = 0;
+  if(res != FR_DISK_ERR)
+  {
+    printf("  f_sync returned %d after a failed write\n", res);
+    return 1;
+  }
+  printf("  failed queued write reported by f_sync\n");
+  BENCH_RamRelease(path);
+  return 0;
+}
+
+/**
+  * @brief  Compares the application workload written in place and through
+  *         the write queue, on a simulated slow disk
+  * @param  None
+  * @retval 0 on success
+  */
+static int BENCH_Async(void)
+{
+  printf("Queued write test, _DISK_ASYNC %d x %d sectors, %u us + %u us/sector disk, %u us per row\n",
+         _DISK_ASYNC, _DISK_ASYNC_SECTORS, ASYNC_LATENCY, ASYNC_SECTOR_TIME, ASYNC_ROW_TIME);
+  BENCH_AsyncRun(0, 0);
+  BENCH_AsyncRun(1, 0);
+  BENCH_AsyncRun(1, 1);
+  return BENCH_AsyncCheck();
+}
+#endif
+
+#if _USE_LOG
+/**
+  * @brief  Makes a record of the power cut test
+  * @param  i: Record number
+  * @param  rec: Record
+  * @retval Size of the record
+  */
+static UINT BENCH_LogRecord(UINT i, BYTE *rec)
+{
+  UINT k, len = 1 + (i * 7919) % LOG_RECORD_MAX;
+
+  for(k = 0; k < len; k++)
+  {
+    rec[k] = (BYTE)(i * 31 + k);
+  }
+  return len;
+}
+
+/**
+  * @brief  Appends records to the log and commits them, until the power is cut
+  * @param  first: Number of the first record
+  * @param  count: Number of records
+  * @retval Number of records committed
+  */
+static UINT BENCH_LogAppend(UINT first, UINT count)
+{
+  BYTE rec[LOG_RECORD_MAX];
+  FIL fil;
+  UINT i, done = 0;
+
+  if(f_logopen(&fil, "data.log", LOG_PREALLOC) != FR_OK)
+  {
+    return 0;
+  }
+  for(i = 0; i < count; i++)
+  {
+    if(f_logwrite(&fil, rec, BENCH_LogRecord(first + i, rec)) != FR_OK)
+    {
+      return done;
+    }
+    if(((i % LOG_COMMIT) == LOG_COMMIT - 1) || (i == count - 1))
+    {
+      if(f_logcommit(&fil) != FR_OK)
+      {
+        return done;
+      }
+      done = i + 1;
+    }
+  }
+  return (f_close(&fil) == FR_OK) ? done : 0;
+}
+
+/**
+  * @brief  Opens the log after a reboot and checks that it holds the records
+  *         in order, up to its size
+  * @param  trimmed: Incremented if f_logopen trimmed the committed size
+  * @retval Number of records, -1 on error
+  */
+static int BENCH_LogCheck(unsigned long *trimmed)
+{
+  BYTE hdr[8], rec[LOG_RECORD_MAX], ref[LOG_RECORD_MAX];
+  FILINFO fno;
+  FIL fil;
+  UINT br, len;
+  int n = 0;
+
+  fno.fsize = 0;
+  f_stat("data.log", &fno);
+  CHECK(f_logopen(&fil, "data.log", LOG_PREALLOC));
+  if(fil.fsize < fno.fsize)
+  {
+    (*trimmed)++;
+  }
+  CHECK(f_lseek(&fil, 0));    /* f_logopen leaves the log at its end */
+  while(fil.fptr < fil.fsize)
+  {
+    len = BENCH_LogRecord(n, ref);
+    CHECK(f_read(&fil, hdr, 8, &br));
+    if((br != 8) || (LD_WORD(hdr) != len) || (fil.fptr + len > fil.fsize))
+    {
+      n = -1;
+      break;
+    }
+    CHECK(f_read(&fil, rec, len, &br));
+    if((br != len) || (memcmp(rec, ref, len) != 0))
+    {
+      n = -1;
+      break;
+    }
+    n++;
+  }
+  CHECK(f_close(&fil));
+  return n;
+}
+
+/**
+  * @brief  Cuts the power while the log is appended, after each sector write
+  *         in turn, and checks the recovered log after each cut
+  * @param  label: Name of the volume
+  * @param  size_mb: Volume size
+  * @param  au: Cluster size in bytes
+  * @param  reorder: The device cache ignores CTRL_SYNC, so that a committed
+  *         size can reach the disk without its records
+  * @retval Number of failed recoveries
+  */
+static int BENCH_LogVolume(const char *label, uint32_t size_mb, UINT au, int reorder)
+{
+  static BYTE old[100];
+  FATFS fs;
+  FIL fil;
+  UINT i, done;
+  unsigned long cut, cuts = 0, trimmed = 0, sectors = 0;
+  int n, failed = 0;
+  char path[4], name[16];
+
+  BENCH_RamVolume(path, &fs, size_mb, au);
+
+  /* A deleted log leaves its records in the clusters the new log reuses.
+     Without the order of CTRL_SYNC they would pass for records of the new
+     log, so that run starts on a blank volume. */
+  if(!reorder)
+  {
+    memset(old, 0xA5, sizeof(old));
+    CHECK(f_logopen(&fil, "old.log", LOG_PREALLOC));
+    for(i = 0; i < LOG_OLD_RECORDS; i++)
+    {
+      CHECK(f_logwrite(&fil, old, sizeof(old)));
+    }
+    CHECK(f_close(&fil));
+    CHECK(f_unlink("old.log"));
+  }
+
+  for(cut = 0; ; cut += (cut < LOG_CUT_ALL) ? 1 : LOG_CUT_STEP)
+  {
+    BENCH_ResetCounters();
+    Cut_Rnd = cut + 1;
+    Cut_Left = cut;
+    Cut_Done = 0;
+    Cut_Reorder = reorder;
+    if(reorder)
+    {
+      /* The preallocation is on the disk, the cache only holds the appends */
+      Cut_Mode = CUT_UNDO;
+      CHECK(f_logopen(&fil, "data.log", LOG_PREALLOC));
+      CHECK(f_close(&fil));
+      BENCH_ResetCounters();
+    }
+    Cut_Mode = CUT_ARMED;
+    done = BENCH_LogAppend(0, LOG_RECORDS);
+    sectors = Wr_Sect;
+    BENCH_CutReboot();
+
+    /* The log holds every committed record, or a valid prefix of them if
+       the cache lost records under a committed size, then appends after
+       them */
+    CHECK(f_mount(NULL, path, 0));
+    CHECK(f_mount(&fs, path, 1));
+    n = BENCH_LogCheck(&trimmed);
+    if((n < 0) || (!reorder && ((UINT)n < done)) ||
+       (BENCH_LogAppend(n, LOG_APPEND) != LOG_APPEND) ||
+       (BENCH_LogCheck(&trimmed) != n + LOG_APPEND))
+    {
+      if(failed++ < 10)
+      {
+        printf("  cut after %lu sectors: %u records committed, %d recovered\n", cut, done, n);
+      }
+    }
+    CHECK(f_mount(NULL, path, 0));
+    BENCH_CutRestore();
+    CHECK(f_mount(&fs, path, 1));
+    if(!Cut_Done)
+    {
+      break;
+    }
+    cuts++;
+  }
+  if(reorder && (trimmed == 0))
+  {
+    failed++;                 /* The cuts did not reach the recovery */
+  }
+  Cut_Reorder = 0;
+  sprintf(name, "%s%s,", label, reorder ? " no sync" : "");
+  printf("  %-14s %5u-byte clusters : %4lu cuts, %lu failed, %3lu logs trimmed by f_logopen, %lu sectors for %u commits\n",
+         name, au, cuts, (unsigned long)failed, trimmed, sectors, (LOG_RECORDS + LOG_COMMIT - 1) / LOG_COMMIT);
+  BENCH_RamRelease(path);
+  return failed;
+}
+
+/**
+  * @brief  Cuts the power while a log is appended, on a disk with a
+  *         write-back cache, and checks the recovery of f_logopen
+  * @param  None
+  * @retval 0 on success
+  */
+static int BENCH_Log(void)
+{
+  int failed;
+
+#if _DISK_ASYNC > 0
+  BENCH_Driver.disk_write_start = NULL;   /* The cut is made on the writes in place */
+#endif
+  printf("Power cut test, %u records, f_logcommit every %u, cut after each of the first %u sector writes, then every %u\n",
+         LOG_RECORDS, LOG_COMMIT, LOG_CUT_ALL, LOG_CUT_STEP);
+  failed = BENCH_LogVolume("FAT16", 16, 2048, 0);
+  failed += BENCH_LogVolume("FAT32", 64, 512, 0);
+  failed += BENCH_LogVolume("FAT16", 16, 2048, 1);
+  return failed ? 1 : 0;
+}
+#endif
+
+#if _FS_REENTRANT
+/**
+  * @brief  Logger thread of the lock test: appends records and syncs
+  * @param  arg: Not used
+  * @retval None
+  */
+static void *BENCH_LockLogger(void *arg)
+{
+  FIL fil;
+  UINT bw, i;
+  char rec[32];
+  int len;
+  double t;
+
+  CHECK(f_open(&fil, "lock.log", FA_CREATE_ALWAYS | FA_WRITE));
+  for(i = 0; i < LOCK_RECORDS; i++)
+  {
+    len = sprintf(rec, "%06u, %08lx\r\n", i, (unsigned long)(i * 2654435761u));
+    t = BENCH_Now();
+    CHECK(f_write(&fil, rec, len, &bw));
+    t = BENCH_Now() - t;
+    CHECK_FULL(bw == (UINT)len);
+    Lock_Sum += t;
+    if(t > Lock_Max)
+    {
+      Lock_Max = t;
+    }
+    if(((i + 1) % LOCK_SYNC) == 0)
+    {
+      CHECK(f_sync(&fil));
+    }
+  }
+  CHECK(f_close(&fil));
+  Lock_Done = 1;
+  return NULL;
+}
+
+/**
+  * @brief  Reader thread of the lock test: reads a fragmented file in large
+  *         f_read calls and checks it, until the logger is done
+  * @param  arg: Not used
+  * @retval None
+  */
+static void *BENCH_LockReader(void *arg)
+{
+  static BYTE rx[LOCK_READ_SIZE], ref[LOCK_READ_SIZE];
+  FIL fil;
+  UINT br;
+  DWORD ofs;
+
+  while(!Lock_Done)
+  {
+    CHECK(f_open(&fil, "lock.bin", FA_READ));
+    for(ofs = 0; ofs < LOCK_FILE_SIZE; ofs += LOCK_READ_SIZE)
+    {
+      CHECK(f_read(&fil, rx, LOCK_READ_SIZE, &br));
+      BENCH_Pattern(ref, ofs, LOCK_READ_SIZE);
+      if((br != LOCK_READ_SIZE) || (memcmp(rx, ref, LOCK_READ_SIZE) != 0))
+      {
+        printf("  reader data error at %lu\n", (unsigned long)ofs);
+        exit(1);
+      }
+    }
+    CHECK(f_close(&fil));
+    Lock_Passes++;
+  }
+  return NULL;
+}
+
+/**
+  * @brief  Directory thread of the lock test: creates, stats and deletes
+  *         files and gets the free space, until the logger is done
+  * @param  arg: Not used
+  * @retval None
+  */
+static void *BENCH_LockDir(void *arg)
+{
+  static const char data[100] = "directory thread";
+  FILINFO fno;
+  FATFS *fs;
+  FIL fil;
+  UINT bw;
+  DWORD nclst;
+  char name[20];
+
+  while(!Lock_Done)
+  {
+    sprintf(name, "tmp/%lu.tmp", Lock_Files % 64);
+    CHECK(f_open(&fil, name, FA_CREATE_NEW | FA_WRITE));
+    CHECK(f_write(&fil, data, sizeof(data), &bw));
+    CHECK(f_close(&fil));
+    CHECK(f_stat(name, &fno));
+    if(fno.fsize != sizeof(data))
+    {
+      printf("  %s has %lu bytes\n", name, (unsigned long)fno.fsize);
+      exit(1);
+    }
+    CHECK(f_unlink(name));
+    Lock_Files++;
+    if((Lock_Files % 16) == 0)
+    {
+      CHECK(f_getfree("", &nclst, &fs));
+      Lock_Getfree++;
+    }
+  }
+  return NULL;
+}
+
+/**
+  * @brief  Runs a logger, a reader and a directory thread on one volume,
+  *         with the disk driver checked for concurrent calls
+  * @param  None
+  * @retval 0 on success
+  */
+static int BENCH_Lock(void)
+{
+  pthread_t th[3];
+  FATFS fs, *pfs;
+  FIL fil, pad;
+  UINT bw, i, len;
+  DWORD ofs, nclst;
+  char path[4], rec[32], line[32];
+
+  printf("Lock test, _FS_REENTRANT %d, %u us + %u us/sector disk\n",
+         _FS_REENTRANT, LOCK_LATENCY, LOCK_SECTOR_TIME);
+  BENCH_RamVolume(path, &fs, 1024, 4096);
+
+  /* The checked file is fragmented: each cluster is followed by one of
+     another file, so its reads stop at every cluster */
+  CHECK(f_mkdir("tmp"));
+  CHECK(f_open(&fil, "lock.bin", FA_CREATE_ALWAYS | FA_WRITE));
+  CHECK(f_open(&pad, "pad.bin", FA_CREATE_ALWAYS | FA_WRITE));
+  for(ofs = 0; ofs < LOCK_FILE_SIZE; ofs += fs.csize * 512)
+  {
+    BENCH_Pattern(Buffer, ofs, fs.csize * 512);
+    CHECK(f_write(&fil, Buffer, fs.csize * 512, &bw));
+    CHECK(f_sync(&fil));
+    CHECK(f_write(&pad, Buffer, fs.csize * 512, &bw));
+    CHECK(f_sync(&pad));
+  }
+  CHECK(f_close(&pad));
+  CHECK(f_close(&fil));
+
+  Disk_Latency = LOCK_LATENCY;
+  Disk_SectorTime = LOCK_SECTOR_TIME;
+  pthread_create(&th[0], NULL, BENCH_LockLogger, NULL);
+  pthread_create(&th[1], NULL, BENCH_LockReader, NULL);
+  pthread_create(&th[2], NULL, BENCH_LockDir, NULL);
+  for(i = 0; i < 3; i++)
+  {
+    pthread_join(th[i], NULL);
+  }
+  Disk_Latency = Disk_SectorTime = 0;
+
+  printf("  logger f_write   %5u records : %8.2f ms avg  %8.2f ms max\n",
+         LOCK_RECORDS, Lock_Sum / LOCK_RECORDS * 1000, Lock_Max * 1000);
+  printf("  reader           %5lu passes  : %u KB in %u KB f_read, data checked\n",
+         Lock_Passes, LOCK_FILE_SIZE / 1024, LOCK_READ_SIZE / 1024);
+  printf("  directory        %5lu files   : create, stat, unlink, %lu f_getfree\n",
+         Lock_Files, Lock_Getfree);
+
+  /* The log is read back after a remount, and the free clusters counted
+     by FatFs are compared with a scan of the FAT */
+  CHECK(f_getfree("", &nclst, &pfs));
+  CHECK(f_mount(NULL, path, 0));
+  CHECK(f_mount(&fs, path, 1));
+  CHECK(f_open(&fil, "lock.log", FA_READ));
+  for(i = 0; i < LOCK_RECORDS; i++)
+  {
+    len = sprintf(rec, "%06u, %08lx\r\n", i, (unsigned long)(i * 2654435761u));
+    CHECK(f_read(&fil, line, len, &bw));
+    if((bw != len) || (memcmp(line, rec, len) != 0))
+    {
+      printf("  log data error at record %u\n", i);
+      return 1;
+    }
+  }
+  CHECK(f_close(&fil));
+  if(nclst != BENCH_FreeScan(&fs))
+  {
+    printf("  %lu free clusters counted, %lu in the FAT\n", (unsigned long)nclst, (unsigned long)BENCH_FreeScan(&fs));
+    return 1;
+  }
+  BENCH_RamRelease(path);
+  if(osMutexCount != 0)
+  {
+    printf("  %d sync objects not deleted\n", osMutexCount);
+    return 1;
+  }
+  printf("  log checked, %lu free clusters as in the FAT, no sync object left\n", (unsigned long)nclst);
+  return 0;
+}
+#endif
+
+/**
+  * @brief  Runs a test other than the one of the four volumes
+  * @param  name: Name of the test
+  * @retval 0 on success
+  */
+static int BENCH_Test(const char *name)
+{
+  if(strcmp(name, "expand") == 0)
+  {
+    return BENCH_Expand();
+  }
+  if(strcmp(name, "cache") == 0)
+  {
+    return BENCH_Cache();
+  }
+  if(strcmp(name, "freemap") == 0)
+  {
+    return BENCH_Freemap();
+  }
+  if(strcmp(name, "async") == 0)
+  {
+#if _DISK_ASYNC > 0
+    return BENCH_Async();
+#else
+    printf("The queued write test needs a build with -D_DISK_ASYNC=4\n");
+    return 1;
+#endif
+  }
+  if(strcmp(name, "log") == 0)
+  {
+#if _USE_LOG
+    return BENCH_Log();
+#else
+    printf("The power cut test needs a build with -D_USE_LOG=1\n");
+    return 1;
+#endif
+  }
+  if(strcmp(name, "lock") == 0)
+  {
+#if _FS_REENTRANT
+    return BENCH_Lock();
+#else
+    printf("The lock test needs a build with -D_FS_REENTRANT=1 or 2\n");
+    return 1;
+#endif
+  }
+  printf("Unknown test %s\n", name);
+  return 1;
+}
+
+/**
+  * @brief  Main program
+  * @param  argc, argv: Options, see the usage
+  * @retval 0 on success
+  */
+int main(int argc, char **argv)
+{
+  const char *image = "ff_bench.img", *test = "volumes";
+  uint32_t latency = 0, bandwidth = 0, seq_mb = 8, nfiles = 1000;
+  int ram = 0, opt;
+  char path[4];
+  BYTE *mem = NULL;
+  size_t mem_size = 0;
+  unsigned v;
+
+  while((opt = getopt(argc, argv, "rf:l:b:s:n:t:")) != -1)
+  {
+    switch(opt)
+    {
+    case 'r': ram = 1; break;
+    case 'f': image = optarg; break;
+    case 'l': latency = strtoul(optarg, NULL, 0); break;
+    case 'b': bandwidth = strtoul(optarg, NULL, 0); break;
+    case 's': seq_mb = strtoul(optarg, NULL, 0); break;
+    case 'n': nfiles = strtoul(optarg, NULL, 0); break;
+    case 't': test = optarg; break;
+    default:
+      printf("usage: %s [-r | -f image] [-l latency_us] [-b kB/s] [-s MB] [-n files] [-t test]\n"
+             "  -r  RAM disk (default: image file ff_bench.img)\n"
+             "  -l  latency of each command of the image file disk\n"
+             "  -b  bandwidth cap of the image file disk\n"
+             "  -s  size of the sequential file (1 to 16 MB, default 8)\n"
+             "  -n  number of files of the many file test (0 to 20000, default 1000)\n"
+             "  -t  test: volumes (default), expand, cache, freemap, async, log or lock, on a RAM disk\n", argv[0]);
+      return 1;
+    }
+  }
+  if(strcmp(test, "volumes") != 0)
+  {
+    return BENCH_Test(test);
+  }
+  if((seq_mb == 0) || (seq_mb > 16))
+  {
+    printf("The sequential file size must be 1 to 16 MB\n");
+    return 1;
+  }
+  if(nfiles > 20000)
+  {
+    printf("The number of files must be 0 to 20000\n");
+    return 1;
+  }
+
+  printf("FatFs benchmark on the %s", ram ? "RAM disk" : "image file disk");
+  if(!ram && (latency || bandwidth))
+  {
+    printf(", %lu us latency, %lu kB/s", (unsigned long)latency, (unsigned long)bandwidth);
+  }
+  printf("\n");
+
+  for(v = 0; v < sizeof(Volumes) / sizeof(Volumes[0]); v++)
+  {
+    DWORD sectors = Volumes[v].size_mb * 2048;
+
+    if(ram)
+    {
+      /* Pages are only taken by the written sectors */
+      mem_size = (size_t)sectors * 512;
+      mem = mmap(NULL, mem_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+      if((mem == MAP_FAILED) || RAMDISK_Attach(mem, sectors))
+      {
+        printf("Cannot allocate the RAM disk\n");
+        return 1;
+      }
+      Target = &RAMDISK_Driver;
+    }
+    else
+    {
+      unlink(image);
+      if(FILEDISK_Open(image, sectors))
+      {
+        printf("Cannot open %s\n", image);
+        return 1;
+      }
+      FILEDISK_SetTiming(latency, bandwidth);
+      Target = &FILEDISK_Driver;
+    }
+
+    FATFS_LinkDriver(&BENCH_Driver, path);
+    BENCH_Volume(path, &Volumes[v], seq_mb, nfiles);
+    FATFS_UnLinkDriver(path);
+
+    if(ram)
+    {
+      munmap(mem, mem_size);
+    }
+    else
+    {
+      FILEDISK_Close();
+      unlink(image);
+    }
+  }
+  return 0;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,307 @@
+/*---------------------------------------------------------------------------/
+/  FatFs - FAT file system module configuration file  R0.10b (C)ChaN, 2014
+/----------------------------------------------------------------------------/
+/
+/ CAUTION! Do not forget to make clean the project after any changes to
+/ the configuration options.
+/
+/----------------------------------------------------------------------------*/
+#ifndef _FFCONF
+#define _FFCONF 80960 /* Revision ID */
+
+/*-----------------------------------------------------------------------------/
+/ Additional user header to be used  
+/-----------------------------------------------------------------------------*/
+/* Host build of the benchmark: no HAL, the types used by ff_gen_drv.h */
+#include <stddef.h>
+#include <stdint.h>
+#define __IO volatile
+
+/*-----------------------------------------------------------------------------/
+/ Functions and Buffer Configurations
+/-----------------------------------------------------------------------------*/
+
+#define _FS_TINY             0      /* 0:Normal or 1:Tiny */
+/* When _FS_TINY is set to 1, FatFs uses the sector buffer in the file system
+/  object instead of the sector buffer in the individual file object for file
+/  data transfer. This reduces memory consumption 512 bytes each file object. */
+
+
+#ifndef _FS_CACHE
+#define _FS_CACHE            4      /* 0:Disable or >=1:Number of cached sectors */
+#endif
+/* When _FS_CACHE is set to 1 or more, the file system object keeps the
+/  directory and FAT sectors that leave the window in a write-back cache of
+/  _FS_CACHE sectors with least recently used replacement. Dirty sectors are
+/  written to the disk (and to all FAT copies) when they are evicted or when
+/  the file system is synchronized. Each sector costs _MAX_SS bytes in the
+/  file system object. It cannot be used with _FS_TINY. */
+
+
+#ifndef _FS_FREEMAP
+#define _FS_FREEMAP          512      /* 0:Disable or >=1:Number of free cluster counters */
+#endif
+/* When _FS_FREEMAP is set to 1 or more, the file system object keeps the
+/  number of free clusters in each of up to _FS_FREEMAP groups of clusters.
+/  The groups are counted on the FAT when they are needed first, then the
+/  cluster allocation skips full groups without reading the FAT and f_getfree
+/  sums up the map. It takes 2 * _FS_FREEMAP bytes in the file system object.
+/  The map is not used on a volume that needs groups of more than 32768
+/  clusters. _FS_READONLY must be 0 to enable this feature. */
+
+
+#define _FS_DIRHASH          16384      /* 0:Disable or 16-32768:Number of slots of the index */
+/* When _FS_DIRHASH is set to 16 or more, the file system object keeps a hash
+/  index of the names (SFN and LFN) in one directory, so that f_open and the
+/  other functions find an object there without reading the whole directory.
+/  The index is built on the first directory searched, and moves to a larger
+/  directory when a search has to read that one to the end. It holds up to
+/  3/4 * _FS_DIRHASH names (one per object, two if the object has an LFN) and
+/  takes 4 * _FS_DIRHASH bytes in the file system object. A directory with
+/  more names is searched without the index. */
+
+
+#define _FS_READONLY         0      /* 0:Read/Write or 1:Read only */
+/* Setting _FS_READONLY to 1 defines read only configuration. This removes
+/  writing functions, f_write, f_sync, f_unlink, f_mkdir, f_chmod, f_rename,
+/  f_truncate and useless f_getfree. */
+
+
+#define _FS_MINIMIZE         0      /* 0 to 3 */
+/* The _FS_MINIMIZE option defines minimization level to remove some functions.
+/
+/   0: Full function.
+/   1: f_stat, f_getfree, f_unlink, f_mkdir, f_chmod, f_truncate, f_utime 
+/      and f_rename are removed.
+/   2: f_opendir and f_readdir are removed in addition to 1.
+/   3: f_lseek is removed in addition to 2. */
+
+
+#define _USE_STRFUNC         2      /* 0:Disable or 1-2:Enable */
+/* To enable string functions, set _USE_STRFUNC to 1 or 2. */
+
+
+#define _USE_MKFS            1      /* 0:Disable or 1:Enable */
+/* To enable f_mkfs function, set _USE_MKFS to 1 and set _FS_READONLY to 0 */
+
+
+#define _USE_FASTSEEK        1      /* 0:Disable or 1:Enable */
+/* To enable fast seek feature, set _USE_FASTSEEK to 1. */
+
+
+#define _USE_EXPAND          1      /* 0:Disable or 1:Enable */
+/* To enable f_expand function, set _USE_EXPAND to 1 and set _FS_READONLY to 0.
+/  f_expand allocates a contiguous cluster block to a file in a single pass. */
+
+
+#define _USE_WRITEV          1      /* 0:Disable or 1:Enable */
+/* When _USE_WRITEV is set to 1, f_read and f_write continue a direct transfer
+/  over contiguous clusters, and f_write sends the dirty sector buffer and the
+/  whole sectors that follow it on the disk to disk_writev in one transfer.
+/  _FS_TINY must be 0 to enable this feature. */
+
+
+#ifndef _USE_LOG
+#define _USE_LOG             0      /* 0:Disable or 1:Enable */
+#endif
+/* To enable the append log functions f_logopen and f_logwrite, set _USE_LOG
+/  to 1. The log is written in records with a CRC in preallocated clusters and
+/  f_logcommit commits the size in the directory entry. f_logopen
+/  trims the log after the last valid record. _USE_EXPAND must be 1. */
+
+
+#define _USE_LABEL           0      /* 0:Disable or 1:Enable */
+/* To enable volume label functions, set _USE_LAVEL to 1 */
+
+
+#define _USE_FORWARD         1      /* 0:Disable or 1:Enable */
+/* To enable f_forward and f_stream functions, set _USE_FORWARD to 1. */
+
+
+/*-----------------------------------------------------------------------------/
+/ Local and Namespace Configurations
+/-----------------------------------------------------------------------------*/
+
+#define _CODE_PAGE         1252
+/* The _CODE_PAGE specifies the OEM code page to be used on the target system.
+/  Incorrect setting of the code page can cause a file open failure.
+/
+/   932  - Japanese Shift-JIS (DBCS, OEM, Windows)
+/   936  - Simplified Chinese GBK (DBCS, OEM, Windows)
+/   949  - Korean (DBCS, OEM, Windows)
+/   950  - Traditional Chinese Big5 (DBCS, OEM, Windows)
+/   1250 - Central Europe (Windows)
+/   1251 - Cyrillic (Windows)
+/   1252 - Latin 1 (Windows)
+/   1253 - Greek (Windows)
+/   1254 - Turkish (Windows)
+/   1255 - Hebrew (Windows)
+/   1256 - Arabic (Windows)
+/   1257 - Baltic (Windows)
+/   1258 - Vietnam (OEM, Windows)
+/   437  - U.S. (OEM)
+/   720  - Arabic (OEM)
+/   737  - Greek (OEM)
+/   775  - Baltic (OEM)
+/   850  - Multilingual Latin 1 (OEM)
+/   858  - Multilingual Latin 1 + Euro (OEM)
+/   852  - Latin 2 (OEM)
+/   855  - Cyrillic (OEM)
+/   866  - Russian (OEM)
+/   857  - Turkish (OEM)
+/   862  - Hebrew (OEM)
+/   874  - Thai (OEM, Windows)
+/ 1    - ASCII only (Valid for non LFN cfg.)
+*/
+
+
+#define _USE_LFN     0  /* 0 to 3 */
+#define _MAX_LFN     255  /* Maximum LFN length to handle (12 to 255) */
+/* The _USE_LFN option switches the LFN feature.
+/
+/   0: Disable LFN feature. _MAX_LFN has no effect.
+/   1: Enable LFN with static working buffer on the BSS. Always NOT reentrant.
+/   2: Enable LFN with dynamic working buffer on the STACK.
+/   3: Enable LFN with dynamic working buffer on the HEAP.
+/
+/  To enable LFN feature, Unicode handling functions ff_convert() and ff_wtoupper()
+/  function must be added to the project.
+/  The LFN working buffer occupies (_MAX_LFN + 1) * 2 bytes. When use stack for the
+/  working buffer, take care on stack overflow. When use heap memory for the working
+/  buffer, memory management functions, ff_memalloc() and ff_memfree(), must be added
+/  to the project. */
+
+
+#define _LFN_UNICODE    0 /* 0:ANSI/OEM or 1:Unicode */
+/* To switch the character encoding on the FatFs API to Unicode, enable LFN feature
+/  and set _LFN_UNICODE to 1. */
+
+
+#define _STRF_ENCODE    3 /* 0:ANSI/OEM, 1:UTF-16LE, 2:UTF-16BE, 3:UTF-8 */
+/* When Unicode API is enabled, character encoding on the all FatFs API is switched
+/  to Unicode. This option selects the character encoding on the file to be read/written
+/  via string functions, f_gets(), f_putc(), f_puts and f_printf().
+/  This option has no effect when _LFN_UNICODE is 0. */
+
+
+#define _FS_RPATH       0 /* 0 to 2 */
+/* The _FS_RPATH option configures relative path feature.
+/
+/   0: Disable relative path feature and remove related functions.
+/   1: Enable relative path. f_chdrive() and f_chdir() function are available.
+/   2: f_getcwd() function is available in addition to 1.
+/
+/  Note that output of the f_readdir() fnction is affected by this option. */
+
+
+/*---------------------------------------------------------------------------/
+/ Drive/Volume Configurations
+/----------------------------------------------------------------------------*/
+
+#define _VOLUMES    1
+/* Number of volumes (logical drives) to be used. */
+
+
+#define _MULTI_PARTITION     0 /* 0:Single partition, 1:Enable multiple partition */
+/* When set to 0, each volume is bound to the same physical drive number and
+/ it can mount only first primaly partition. When it is set to 1, each volume
+/ is tied to the partitions listed in VolToPart[]. */
+
+
+#define	_MIN_SS                 512
+#define	_MAX_SS                 512
+/* These options configure the range of sector size to be supported. (512, 1024, 2048 or
+/  4096) Always set both 512 for most systems, all memory card and harddisk. But a larger
+/  value may be required for on-board flash memory and some type of optical media.
+/  When _MAX_SS is larger than _MIN_SS, FatFs is configured to variable sector size and
+/  GET_SECTOR_SIZE command must be implemented to the disk_ioctl() function. */
+
+
+#define _USE_ERASE     0 /* 0:Disable or 1:Enable */
+/* To enable sector erase feature, set _USE_ERASE to 1. Also CTRL_ERASE_SECTOR command
+/  should be added to the disk_ioctl() function. */
+
+
+#ifndef _DISK_ASYNC
+#define _DISK_ASYNC    0 /* 0:Disable or >=1:Number of queued writes */
+#endif
+#define _DISK_ASYNC_SECTORS  4 /* Maximum number of sectors of a queued write */
+/* When _DISK_ASYNC is set to 1 or more, disk_write() copies the data to a queue
+/  of _DISK_ASYNC buffers of _DISK_ASYNC_SECTORS sectors and returns, and the
+/  writes are sent to the drive in the background by FATFS_AsyncProcess(). It is
+/  used by the drivers that implement the disk_write_start and disk_write_done
+/  members, the others are written in place. Larger writes wait for the queue
+/  to be written. disk_read() waits for the queued writes of the sectors it
+/  reads and CTRL_SYNC of disk_ioctl(), issued by f_sync(), waits for all of
+/  them and returns the first error. The waits block in the disk_write_wait
+/  member of the driver when it has one, otherwise they poll the drive. The
+/  queue is shared by the drives and needs _FS_REENTRANT = 0. */
+
+
+#define _FS_NOFSINFO    0 /* 0 or 1 */
+/* If you need to know the correct free space on the FAT32 volume, set this
+/  option to 1 and f_getfree() function at first time after volume mount will
+/  force a full FAT scan.
+/
+/  0: Load all informations in the FSINFO if available.
+/  1: Do not trust free cluster count in the FSINFO.
+*/
+
+
+/*---------------------------------------------------------------------------/
+/ System Configurations
+/----------------------------------------------------------------------------*/
+
+#define _WORD_ACCESS    0 /* 0 or 1 */
+/* The _WORD_ACCESS option is an only platform dependent option. It defines
+/  which access method is used to the word data on the FAT volume.
+/
+/   0: Byte-by-byte access. Always compatible with all platforms.
+/   1: Word access. Do not choose this unless under both the following conditions.
+/
+/  * Byte order on the memory is little-endian.
+/  * Address miss-aligned word access is always allowed for all instructions.
+/
+/  If it is the case, _WORD_ACCESS can also be set to 1 to improve performance
+/  and reduce code size.
+*/
+
+
+/* A header file that defines sync object types on the O/S, such as
+/  windows.h, ucos_ii.h and semphr.h, must be included prior to ff.h. */
+
+/* The benchmark is built with -D_FS_REENTRANT=1 or 2 for its lock test, on
+/  the CMSIS-RTOS mutexes of cmsis_os.h over POSIX threads */
+#ifndef _FS_REENTRANT
+#define _FS_REENTRANT    0  /* 0:Disable, 1:Volume lock or 2:Volume and file locks */
+#endif
+#define _FS_TIMEOUT      1000 /* Timeout period in unit of time ticks */
+#if _FS_REENTRANT
+#include "cmsis_os.h"
+#define _SYNC_t          osMutexId /* O/S dependent type of sync object. e.g. HANDLE, OS_EVENT*, ID and etc.. */
+#else
+#define _SYNC_t          0 /* O/S dependent type of sync object. e.g. HANDLE, OS_EVENT*, ID and etc.. */
+#endif
+
+/* The _FS_REENTRANT option switches the re-entrancy (thread safe) of the FatFs module.
+/
+/   0: Disable re-entrancy. _SYNC_t and _FS_TIMEOUT have no effect.
+/   1: Enable re-entrancy. Also user provided synchronization handlers,
+/      ff_req_grant(), ff_rel_grant(), ff_del_syncobj() and ff_cre_syncobj()
+/      function must be added to the project.
+/   2: Enable re-entrancy with a lock for each open file in addition to the
+/      volume lock. f_read and f_write give up the volume lock between the
+/      sectors, so that a long access to a file does not hold off the accesses
+/      to other files on the same volume. A sync object is created for each
+/      open file. */
+
+
+#ifndef _FS_LOCK
+#define _FS_LOCK    2      /* 0:Disable or >=1:Enable */
+#endif
+/* To enable file lock control feature, set _FS_LOCK to 1 or greater.
+   The value defines how many files can be opened simultaneously. */
+
+
+#endif /* _FFCONFIG */
+
@@ -0,0 +1,72 @@
+/**
+  ******************************************************************************
+  * @file    ADC/ADC_RegularConversion_DMA/Inc/disk_log.h
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Header for disk_log.c module
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __DISK_LOG_H
+#define __DISK_LOG_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "ff.h"
+
+/* Exported types ------------------------------------------------------------*/
+/**
+  * @brief  Distribution of the records over the volumes
+  */
+typedef enum
+{
+  DISK_LOG_MIRROR = 0,      /* Every record on all the volumes           */
+  DISK_LOG_STRIPE,          /* Each record on the next volume, in turn   */
+}DiskLog_ModeTypeDef;
+
+/**
+  * @brief  Log file written on several volumes. A volume that fails is
+  *         dropped and the log goes on with the others.
+  */
+typedef struct
+{
+  FIL                  file[_VOLUMES];
+  uint8_t              nbr;         /* Volumes added                          */
+  uint8_t              active;      /* Mask of the volumes still written      */
+  uint8_t              next;        /* Volume of the next record, stripe mode */
+  DiskLog_ModeTypeDef  mode;
+}DiskLog_TypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void    DiskLog_Init(DiskLog_TypeDef *log, DiskLog_ModeTypeDef mode);
+FRESULT DiskLog_AddVolume(DiskLog_TypeDef *log, const char *path, const char *name, DWORD size);
+FRESULT DiskLog_WriteAll(DiskLog_TypeDef *log, const void *data, UINT len);
+FRESULT DiskLog_Write(DiskLog_TypeDef *log, const void *data, UINT len);
+FRESULT DiskLog_Sync(DiskLog_TypeDef *log);
+FRESULT DiskLog_Close(DiskLog_TypeDef *log);
+uint8_t DiskLog_Volumes(const DiskLog_TypeDef *log);
+
+#endif /* __DISK_LOG_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -50,6 +50,22 @@
 /* FatFs includes component */
 #include "ff_gen_drv.h"
 #include "usbh_diskio.h"
+#include "ramdisk_diskio.h"
+#include "disk_log.h"
+
+/* USB Device core, streaming of the spectra to a PC */
+#include "usbd_core.h"
+#include "usbd_desc.h"
+#include "usbd_cdc.h"
+#include "usbd_cdc_interface.h"
+
+/* USB Device MSC, export of the capture log volume */
+#include "usbd_msc.h"
+#include "usbd_storage.h"
+
+/* USB Device vendor class, streaming of the raw samples (USBD_STREAM_RAW) */
+#include "usbd_vendor.h"
+#include "usbd_raw_interface.h"
 
 /* Exported types ------------------------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
@@ -79,6 +95,19 @@
 #define ADCx_DMA_IRQn                   DMA2_Stream0_IRQn
 #define ADCx_DMA_IRQHandler             DMA2_Stream0_IRQHandler
 
+/* Sample rate of ADCx: PCLK2 / 8 = 9 MHz, 28 + 12 cycles per conversion */
+#define ADCx_SAMPLE_RATE_HZ             225000
+
+/* Definition for the ID and VBUS pins of the USB OTG FS connector (CN5),
+   read at reset: with a PC cable, ID floats and the PC drives VBUS, the board
+   is a CDC device streaming the spectra (a vendor class device streaming the
+   raw samples with USBD_STREAM_RAW), or with the user button held the MSC
+   device of the capture log volume. Else it is the host of a USB disk */
+#define USB_ID_GPIO_CLK_ENABLE()        __GPIOA_CLK_ENABLE()
+#define USB_ID_PIN                      GPIO_PIN_10
+#define USB_VBUS_PIN                    GPIO_PIN_9
+#define USB_ID_GPIO_PORT                GPIOA
+
 
 /* Exported macro ------------------------------------------------------------*/
 
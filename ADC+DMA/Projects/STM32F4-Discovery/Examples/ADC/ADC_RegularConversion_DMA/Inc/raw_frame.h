@@ -0,0 +1,111 @@
+/**
+  ******************************************************************************
+  * @file    ADC/ADC_RegularConversion_DMA/Inc/raw_frame.h
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Protocol of the raw sample streaming on the USB vendor class: the
+  *          frames of the bulk IN endpoint and the control requests. Shared
+  *          by the device and the programs of the PC.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __RAW_FRAME_H
+#define __RAW_FRAME_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/**
+  * @brief  Header of a frame, little endian. It is followed by samples
+  *         uint16 ADC codes, written there by the DMA, then by zeros up to a
+  *         multiple of the packet size, so that every frame starts a USB
+  *         packet and ends with a full one.
+  */
+typedef struct
+{
+  uint32_t magic;        /*!< RAW_FRAME_MAGIC                                         */
+  uint32_t seq;          /*!< Frame number, the dropped frames are counted too       */
+  uint32_t dropped;      /*!< Frames dropped by the device since the configuration   */
+  uint32_t sample_rate;  /*!< Sample rate of the ADC in Hz                           */
+  uint16_t samples;      /*!< Number of samples                                      */
+  uint16_t packet;       /*!< Packet size the frame is padded to                     */
+  uint32_t length;       /*!< Size of the frame in bytes, header and padding included */
+  uint32_t tick;         /*!< Time of the last sample, in ms since the reset         */
+  uint16_t trigger;      /*!< Sample of the trigger, RAW_FRAME_NO_TRIGGER if none    */
+  uint16_t bits;         /*!< Resolution of the samples                              */
+}RAW_FrameHeaderTypeDef;
+
+/**
+  * @brief  Data of RAW_REQ_GET_STATUS, little endian
+  */
+typedef struct
+{
+  uint32_t sample_rate;  /*!< Sample rate set, in Hz                                 */
+  uint8_t  state;        /*!< RAW_STATE_xxx                                          */
+  uint8_t  trigger_mode; /*!< RAW_TRIGGER_xxx                                        */
+  uint16_t trigger_level;/*!< ADC code of the trigger                                */
+  uint32_t seq;          /*!< Sequence number of the next frame                      */
+  uint32_t sent;         /*!< Frames sent since the configuration                    */
+  uint32_t dropped;      /*!< Frames dropped since the configuration                 */
+}RAW_StatusTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+#define RAW_FRAME_MAGIC                 0x46574152U   /* "RAWF" */
+#define RAW_FRAME_HEADER_SIZE           32U
+#define RAW_FRAME_NO_TRIGGER            0xFFFFU
+#define RAW_STATUS_SIZE                 20U
+
+/* Vendor requests to the interface (bmRequestType 0x41 or 0xC1), wIndex is
+   the interface number. A request the device cannot honour is STALLed. */
+#define RAW_REQ_START                   0x01  /* wValue: frames to send, 0 until RAW_REQ_STOP    */
+#define RAW_REQ_STOP                    0x02  /* The frames already queued are still sent        */
+#define RAW_REQ_SET_RATE                0x03  /* wValue: rate in units of 100 Hz, while stopped  */
+#define RAW_REQ_SET_TRIGGER             0x04  /* wValue: level (bits 0-11), mode (bits 12-13)    */
+#define RAW_REQ_GET_STATUS              0x05  /* IN, RAW_STATUS_SIZE bytes of RAW_StatusTypeDef  */
+
+/* Trigger modes. Without a trigger the frames are sent from the start. With
+   one, a frame is sent only if it holds a crossing of the level: with a
+   count of frames, the first one and the following ones; with no count,
+   each frame holding a crossing. */
+#define RAW_TRIGGER_NONE                0
+#define RAW_TRIGGER_RISING              1
+#define RAW_TRIGGER_FALLING             2
+
+/* States of the capture */
+#define RAW_STATE_IDLE                  0
+#define RAW_STATE_ARMED                 1     /* Waiting for the trigger */
+#define RAW_STATE_RUNNING               2
+
+/* Exported macro ------------------------------------------------------------*/
+/* Size of a frame of n samples padded to packets of p bytes */
+#define RAW_FRAME_SIZE(n, p)            \
+  ((((RAW_FRAME_HEADER_SIZE + 2U * (n)) + (p) - 1U) / (p)) * (p))
+
+/* wValue of RAW_REQ_SET_TRIGGER */
+#define RAW_TRIGGER_VALUE(mode, level)  ((uint16_t)(((mode) << 12) | ((level) & 0x0FFFU)))
+
+/* Exported functions ------------------------------------------------------- */
+
+#endif /* __RAW_FRAME_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,66 @@
+/**
+  ******************************************************************************
+  * @file    ADC/ADC_RegularConversion_DMA/Inc/spectrum_frame.h
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Format of the spectrum frames streamed on the USB CDC interface,
+  *          shared by the firmware and the host reader.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __SPECTRUM_FRAME_H
+#define __SPECTRUM_FRAME_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/**
+  * @brief  Header of a frame, little endian. It is followed by bins float32
+  *         magnitudes, then by zeros up to a multiple of the packet size, so
+  *         that every frame starts a USB packet and ends with a full one.
+  */
+typedef struct
+{
+  uint32_t magic;        /*!< SPECTRUM_FRAME_MAGIC                                    */
+  uint32_t seq;          /*!< Frame number, the dropped frames are counted too       */
+  uint32_t dropped;      /*!< Frames dropped by the device since the port was opened */
+  uint32_t sample_rate;  /*!< Sample rate of the ADC in Hz, bin k is at k * rate / N */
+  uint16_t bins;         /*!< Number of magnitudes, N / 2                            */
+  uint16_t packet;       /*!< Packet size the frame is padded to                     */
+  uint32_t length;       /*!< Size of the frame in bytes, header and padding included */
+}SPECTRUM_FrameHeaderTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+#define SPECTRUM_FRAME_MAGIC            0x43455053U   /* "SPEC" */
+#define SPECTRUM_FRAME_HEADER_SIZE      24U
+
+/* Exported macro ------------------------------------------------------------*/
+/* Size of a frame of n bins padded to packets of p bytes */
+#define SPECTRUM_FRAME_SIZE(n, p)       \
+  ((((SPECTRUM_FRAME_HEADER_SIZE + 4U * (n)) + (p) - 1U) / (p)) * (p))
+
+/* Exported functions ------------------------------------------------------- */
+
+#endif /* __SPECTRUM_FRAME_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,58 @@
+/**
+  ******************************************************************************
+  * @file    ADC/ADC_RegularConversion_DMA/Inc/usbd_cdc_interface.h
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Header for usbd_cdc_interface.c file.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __USBD_CDC_IF_H
+#define __USBD_CDC_IF_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbd_cdc.h"
+#include "spectrum_frame.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/* Largest spectrum streamed, SAMPLES_SIZE / 2 magnitudes */
+#define CDC_STREAM_MAX_BINS             2048
+
+/* Size of a frame buffer: the frames are padded to full packets, the host
+   sees the end of a transfer without a zero length packet */
+#define CDC_STREAM_FRAME_SIZE           SPECTRUM_FRAME_SIZE(CDC_STREAM_MAX_BINS, CDC_DATA_FS_MAX_PACKET_SIZE)
+
+/* One frame on the bus while the next one is computed */
+#define CDC_STREAM_BUFFERS              2
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+extern USBD_CDC_ItfTypeDef  USBD_CDC_fops;
+
+float   *CDC_Stream_GetFrame(void);
+void     CDC_Stream_SendFrame(uint16_t bins, uint32_t sample_rate);
+void     CDC_Stream_GetStats(uint32_t *sent, uint32_t *dropped);
+
+#endif /* __USBD_CDC_IF_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,67 @@
+/**
+  ******************************************************************************
+  * @file    ADC/ADC_RegularConversion_DMA/Inc/usbd_raw_interface.h
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Header for usbd_raw_interface.c file.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __USBD_RAW_IF_H
+#define __USBD_RAW_IF_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbd_vendor.h"
+#include "raw_frame.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/* Samples of a frame: 4.6 ms at the default rate */
+#define RAW_STREAM_SAMPLES              1024
+
+/* Size of a frame buffer: the frames are padded to full packets, the host
+   sees the end of a transfer without a zero length packet */
+#define RAW_STREAM_FRAME_SIZE           RAW_FRAME_SIZE(RAW_STREAM_SAMPLES, VENDOR_DATA_FS_MAX_PACKET_SIZE)
+
+/* Frame pool: two are written by the DMA, the others wait for the bus */
+#define RAW_STREAM_FRAMES               8
+
+/* Rate of a new configuration, the one of the spectra (ADCx_SAMPLE_RATE_HZ) */
+#define RAW_STREAM_DEFAULT_RATE         225000
+#define RAW_STREAM_BITS                 12
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+extern USBD_VENDOR_ItfTypeDef  USBD_RAW_fops;
+
+uint16_t *RAW_Stream_FrameCplt(uint16_t *samples, uint32_t tick);
+void      RAW_Stream_GetStats(uint32_t *sent, uint32_t *dropped);
+
+/* Capture of the samples, provided by the application. Called in the USB
+   interrupt, whose priority the DMA interrupt of the capture shares. */
+uint32_t  RAW_Capture_SetRate(uint32_t rate);
+void      RAW_Capture_Start(uint16_t *mem0, uint16_t *mem1, uint16_t samples);
+void      RAW_Capture_Stop(void);
+
+#endif /* __USBD_RAW_IF_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
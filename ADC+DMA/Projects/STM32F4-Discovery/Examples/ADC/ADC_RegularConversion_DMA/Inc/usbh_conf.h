@@ -45,6 +45,18 @@
 #define USBH_MAX_DATA_BUFFER                  0x200
 #define USBH_DEBUG_LEVEL                      0
 #define USBH_USE_OS                           0
+#define USBH_MSC_STREAM_DEPTH                 4
+/* The OTG FS core runs without DMA (hhcd.Init.dma_enable = 0): the CPU copies
+   the FIFO, usbh_diskio can pass buffers of any alignment */
+#define USBH_DMA_ALIGN                        1
+
+/* CMSIS OS macros */   
+#if (USBH_USE_OS == 1)
+  #include "cmsis_os.h"
+  /* Above the application thread, so that the URB events are served at once */
+  #define   USBH_PROCESS_PRIO          osPriorityAboveNormal
+  #define   USBH_PROCESS_STACK_SIZE    (8 * configMINIMAL_STACK_SIZE)
+#endif
     
 /** @defgroup USBH_Exported_Macros
   * @{
@@ -0,0 +1,277 @@
+/**
+  ******************************************************************************
+  * @file    ADC/ADC_RegularConversion_DMA/Src/disk_log.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Log file mirrored or striped over several FatFs volumes, the
+  *          logical units of a USB disk for instance.
+  *
+  *          In mirror mode each record is written to all the volumes, any
+  *          of them holds the whole log. In stripe mode the records go to
+  *          the volumes in turn, each volume holds a share of them and the
+  *          records carry their own order key (the index column of the CSV
+  *          rows) for the PC to merge the files. A volume whose write fails
+  *          is dropped: its file keeps what was written before, the records
+  *          go on to the other volumes and the log fails only when none is
+  *          left.
+  *
+  *          The volumes of one USB device share its bus, on which one
+  *          command runs at a time: mirroring over two of its LUNs halves
+  *          the rate of the log, striping keeps it. Striping over
+  *          independent drives, which run in parallel, adds up their rates.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "disk_log.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Longest path of a log file: drive, name and terminator */
+#define DISK_LOG_PATH_SIZE               32
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static FRESULT DiskLog_Put(DiskLog_TypeDef *log, uint8_t vol, const void *data, UINT len);
+static void    DiskLog_Drop(DiskLog_TypeDef *log, uint8_t vol);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Initializes a log with no volume.
+  * @param  log: Log
+  * @param  mode: DISK_LOG_MIRROR or DISK_LOG_STRIPE
+  * @retval None
+  */
+void DiskLog_Init(DiskLog_TypeDef *log, DiskLog_ModeTypeDef mode)
+{
+  log->nbr = 0;
+  log->active = 0;
+  log->next = 0;
+  log->mode = mode;
+}
+
+/**
+  * @brief  Creates the log file on a mounted volume and adds the volume to
+  *         the log.
+  * @param  log: Log
+  * @param  path: Logical drive path of the volume, "0:/" for instance
+  * @param  name: Name of the file, replaced if it exists
+  * @param  size: Space reserved to the file in one contiguous block, 0 for
+  *         none. When the volume has no free block that large the file is
+  *         extended cluster by cluster instead.
+  * @retval FR_OK, otherwise the error of f_open and the volume is not added
+  */
+FRESULT DiskLog_AddVolume(DiskLog_TypeDef *log, const char *path, const char *name, DWORD size)
+{
+  char file_path[DISK_LOG_PATH_SIZE];
+  FRESULT res;
+
+  if(log->nbr == _VOLUMES)
+  {
+    return FR_TOO_MANY_OPEN_FILES;
+  }
+  snprintf(file_path, sizeof(file_path), "%s%s", path, name);
+  res = f_open(&log->file[log->nbr], file_path, FA_CREATE_ALWAYS | FA_WRITE);
+  if(res != FR_OK)
+  {
+    return res;
+  }
+  if(size != 0)
+  {
+    f_expand(&log->file[log->nbr], size, 1);
+  }
+  log->active |= 1 << log->nbr;
+  log->nbr++;
+  return FR_OK;
+}
+
+/**
+  * @brief  Writes data to all the volumes, whatever the mode: the header of
+  *         the file for instance.
+  * @param  log: Log
+  * @param  data: Data
+  * @param  len: Number of bytes
+  * @retval FR_OK if a volume at least took the data, otherwise the error
+  *         of the last one
+  */
+FRESULT DiskLog_WriteAll(DiskLog_TypeDef *log, const void *data, UINT len)
+{
+  FRESULT res = FR_NOT_READY;
+  uint8_t vol;
+
+  for(vol = 0; vol < log->nbr; vol++)
+  {
+    if(log->active & (1 << vol))
+    {
+      if(DiskLog_Put(log, vol, data, len) == FR_OK)
+      {
+        res = FR_OK;
+      }
+      else if(res != FR_OK)
+      {
+        res = FR_DISK_ERR;
+      }
+    }
+  }
+  return res;
+}
+
+/**
+  * @brief  Writes a record: to all the volumes in mirror mode, to the next
+  *         volume in stripe mode. A record the next volume fails to take is
+  *         written to the following one.
+  * @param  log: Log
+  * @param  data: Record
+  * @param  len: Number of bytes
+  * @retval FR_OK if a volume at least took the record, otherwise an error:
+  *         no volume is left
+  */
+FRESULT DiskLog_Write(DiskLog_TypeDef *log, const void *data, UINT len)
+{
+  uint8_t vol;
+  uint8_t i;
+
+  if(log->mode == DISK_LOG_MIRROR)
+  {
+    return DiskLog_WriteAll(log, data, len);
+  }
+
+  for(i = 0; i < log->nbr; i++)
+  {
+    vol = (log->next + i) % log->nbr;
+    if((log->active & (1 << vol)) && (DiskLog_Put(log, vol, data, len) == FR_OK))
+    {
+      log->next = (vol + 1) % log->nbr;
+      return FR_OK;
+    }
+  }
+  return (log->nbr == 0) ? FR_NOT_READY : FR_DISK_ERR;
+}
+
+/**
+  * @brief  Flushes the cached data of the files to the volumes.
+  * @param  log: Log
+  * @retval FR_OK if a volume at least is left, otherwise an error
+  */
+FRESULT DiskLog_Sync(DiskLog_TypeDef *log)
+{
+  uint8_t vol;
+
+  for(vol = 0; vol < log->nbr; vol++)
+  {
+    if((log->active & (1 << vol)) && (f_sync(&log->file[vol]) != FR_OK))
+    {
+      DiskLog_Drop(log, vol);
+    }
+  }
+  return (log->active != 0) ? FR_OK : FR_DISK_ERR;
+}
+
+/**
+  * @brief  Releases the space reserved and not used, and closes the files.
+  * @param  log: Log
+  * @retval FR_OK if a volume at least holds its whole share of the log,
+  *         otherwise an error
+  */
+FRESULT DiskLog_Close(DiskLog_TypeDef *log)
+{
+  uint8_t vol;
+
+  for(vol = 0; vol < log->nbr; vol++)
+  {
+    if(log->active & (1 << vol))
+    {
+      if((f_truncate(&log->file[vol]) != FR_OK) || (f_close(&log->file[vol]) != FR_OK))
+      {
+        log->active &= ~(1 << vol);
+      }
+    }
+  }
+  vol = log->active;
+  log->nbr = 0;
+  log->active = 0;
+  return (vol != 0) ? FR_OK : FR_DISK_ERR;
+}
+
+/**
+  * @brief  Returns the number of volumes still written.
+  * @param  log: Log
+  * @retval Number of volumes
+  */
+uint8_t DiskLog_Volumes(const DiskLog_TypeDef *log)
+{
+  uint8_t vol;
+  uint8_t n = 0;
+
+  for(vol = 0; vol < log->nbr; vol++)
+  {
+    if(log->active & (1 << vol))
+    {
+      n++;
+    }
+  }
+  return n;
+}
+
+/**
+  * @brief  Writes data to the file of a volume, and drops the volume if it
+  *         fails or is full.
+  * @param  log: Log
+  * @param  vol: Volume index in the log
+  * @param  data: Data
+  * @param  len: Number of bytes
+  * @retval FRESULT: FR_DENIED when the volume is full
+  */
+static FRESULT DiskLog_Put(DiskLog_TypeDef *log, uint8_t vol, const void *data, UINT len)
+{
+  FRESULT res;
+  UINT bw;
+
+  res = f_write(&log->file[vol], data, len, &bw);
+  if((res == FR_OK) && (bw != len))
+  {
+    res = FR_DENIED;
+  }
+  if(res != FR_OK)
+  {
+    DiskLog_Drop(log, vol);
+  }
+  return res;
+}
+
+/**
+  * @brief  Stops writing a volume. Its file is closed, the data already on
+  *         the volume stays.
+  * @param  log: Log
+  * @param  vol: Volume index in the log
+  * @retval None
+  */
+static void DiskLog_Drop(DiskLog_TypeDef *log, uint8_t vol)
+{
+  log->active &= ~(1 << vol);
+  f_close(&log->file[vol]);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -63,12 +63,57 @@
 
 /* Private define ------------------------------------------------------------*/
 #define SAMPLES_SIZE 4096
+#define LOG_FILE_SIZE_MAX ( SAMPLES_SIZE * 32 ) /* Space preallocated to a CSV file */
+#if ( SAMPLES_SIZE / 2 ) > CDC_STREAM_MAX_BINS
+#error "The spectrum does not fit in the frames of usbd_cdc_interface.c"
+#endif
+
+/* Logical units of the USB disk written, one volume each (_VOLUMES of
+   ffconf.h), and the distribution of the CSV rows over them: DISK_LOG_MIRROR
+   writes every row to each unit, DISK_LOG_STRIPE the rows to the units in
+   turn, the index column orders them back */
+#define USBDISK_LUNS      2
+#define USBDISK_LOG_MODE  DISK_LOG_MIRROR
+#if USBDISK_LUNS > _VOLUMES
+#error "Each logical unit of the USB disk needs a volume, raise _VOLUMES in ffconf.h"
+#endif
+
+/* Capture log volume, exported by the MSC device: a RAM disk in the 64 kB of
+   CCM RAM, which the linker files of the example leave unused */
+#define LOG_VOLUME_ADDR     CCMDATARAM_BASE
+#define LOG_VOLUME_SECTORS  128
+#define LOG_FILE_NAME       "log.csv"
+#define LOG_PERIOD_MS       1000 /* One row per period, the volume holds about 23 min */
+
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
-FATFS USBDISKFatFs;           /* File system object for USB disk logical drive */
-FIL MyFile;                   /* File object */
-char USBDISKPath[4];          /* USB Host logical drive path */
+FATFS USBDISKFatFs[USBDISK_LUNS]; /* File system objects of the USB disk logical units */
+DiskLog_TypeDef DiskLog;      /* CSV file, on each logical unit */
+char USBDISKPath[USBDISK_LUNS][4]; /* USB Host logical drive paths */
 USBH_HandleTypeDef hUSB_Host; /* USB Host handle */
+USBD_HandleTypeDef USBD_Device; /* USB Device handle */
+
+/* Role of the USB OTG FS port, read from the connector at reset */
+bool usb_device_mode = false;
+
+/* Export of the capture log volume instead of the streaming, chosen with the
+   user button at reset */
+bool usb_msc_mode = false;
+
+/* Streaming of the raw samples instead of the spectra, USBD_STREAM_RAW of
+   usbd_conf.h: the PC drives the capture */
+bool usb_raw_mode = false;
+
+FATFS LogFatFs;               /* File system object for the capture log volume */
+FIL LogFile;                  /* Log file, open for appending */
+char LogPath[4];              /* Capture log volume logical drive path */
+static bool log_ready = false;
+static uint32_t log_captures = 0;
+static uint32_t log_last_tick = 0;
+
+/* USB Host started, its state machine is then run by the main loop without
+   the OS */
+static bool usb_host_started = false;
 
 typedef enum {
   APPLICATION_IDLE = 0,  
@@ -78,6 +123,17 @@ typedef enum {
 
 MSC_ApplicationTypeDef Appli_state = APPLICATION_IDLE;
 
+#if (USBH_USE_OS == 1)
+/* Events of the application thread */
+typedef enum {
+  DISCONNECTION_EVENT = 1,
+  CONNECTION_EVENT,
+  CONVERSION_EVENT,
+}MSC_ApplicationEventTypeDef;
+
+osMessageQId AppliEvent;
+#endif
+
 /* ADC handler declaration */
 ADC_HandleTypeDef    AdcHandle;
 State_Type estadoAtual;
@@ -107,6 +163,19 @@ void (*tabela_estados[8]) () = {Configurado, DadosCapturados, DadosSalvos, UsomP
 static void USBH_UserProcess(USBH_HandleTypeDef *phost, uint8_t id);
 
 static void write_register_in_file( const float raw_data[], const uint32_t size_raw_data );
+static bool usb_disk_link( void );
+static void usb_disk_mount( bool mount );
+static bool usb_cable_is_pc( void );
+static void stream_spectrum( void );
+static void log_volume_init( void );
+static void log_spectrum( void );
+#if (USBD_STREAM_RAW == 1)
+static void raw_capture_m0_cplt( DMA_HandleTypeDef *hdma );
+static void raw_capture_m1_cplt( DMA_HandleTypeDef *hdma );
+#endif
+#if (USBH_USE_OS == 1)
+static void StartThread(void const *argument);
+#endif
 
 /* Private functions ---------------------------------------------------------*/
 
@@ -134,6 +203,15 @@ int main(void)
   BSP_LED_Init(LED4);
   BSP_LED_Init(LED5);
   
+  /*##-0- Select the USB role from the cable plugged #########################*/
+  usb_device_mode = usb_cable_is_pc();
+  
+  if( usb_device_mode == true )
+  {
+    BSP_PB_Init(BUTTON_KEY, BUTTON_MODE_GPIO);
+    usb_msc_mode = ( BSP_PB_GetState(BUTTON_KEY) != 0 );
+  }
+  
   /*##-1- Configure the ADC peripheral #######################################*/
   AdcHandle.Instance = ADCx;
   
@@ -167,9 +245,65 @@ int main(void)
     /* Channel Configuration Error */
     Error_Handler(); 
   }
+  
+  if( usb_msc_mode == true )
+  {
+    /* Mount the log volume, then Init Device Library, add the MSC class and
+       the read-only storage of the volume: the PC reads it in the USB
+       interrupt while the capture goes on */
+    log_volume_init();
+    USBD_Init(&USBD_Device, &MSC_Desc, 0);
+    USBD_RegisterClass(&USBD_Device, USBD_MSC_CLASS);
+    USBD_MSC_RegisterStorage(&USBD_Device, &USBD_DISK_fops);
+    USBD_Start(&USBD_Device);
+  }
+  else if( usb_device_mode == true )
+  {
+#if (USBD_STREAM_RAW == 1)
+    /* Init Device Library, add the vendor class and the raw streaming
+       interface: the capture is started by the PC and runs in the DMA and
+       USB interrupts, the main loop has nothing to do */
+    usb_raw_mode = true;
+    USBD_Init(&USBD_Device, &RAW_Desc, 0);
+    USBD_RegisterClass(&USBD_Device, USBD_VENDOR_CLASS);
+    USBD_VENDOR_RegisterInterface(&USBD_Device, &USBD_RAW_fops);
+    USBD_Start(&USBD_Device);
+#else
+    /* Init Device Library, add the CDC class and the streaming interface:
+       the device runs in the USB interrupt */
+    USBD_Init(&USBD_Device, &VCP_Desc, 0);
+    USBD_RegisterClass(&USBD_Device, USBD_CDC_CLASS);
+    USBD_CDC_RegisterInterface(&USBD_Device, &USBD_CDC_fops);
+    USBD_Start(&USBD_Device);
+#endif
+  }
+#if (USBH_USE_OS == 0)
+  else if( usb_disk_link() == true )
+  {
+    /* Link the USB Host disk I/O driver, once per logical unit, and start the
+       host once: the main loop runs one step of the enumeration per pass and
+       the disk is mounted when its class is active */
+    USBH_Init(&hUSB_Host, USBH_UserProcess, 0);
+    USBH_RegisterClass(&hUSB_Host, USBH_MSC_CLASS);
+    USBH_Start(&hUSB_Host);
+    usb_host_started = true;
+  }
+#endif
 
+#if (USBH_USE_OS == 1)
+  /* Create the application thread, the USB host runs in the thread created by
+     USBH_Init and serves the bus while the FFT is computed */
+  osThreadDef(USER_Thread, StartThread, osPriorityNormal, 0, 8 * configMINIMAL_STACK_SIZE);
+  osThreadCreate(osThread(USER_Thread), NULL);
+  
+  /* Create the queue of the application events, before the ADC can post one */
+  osMessageQDef(osqueue, 4, uint16_t);
+  AppliEvent = osMessageCreate(osMessageQ(osqueue), NULL);
+#endif
+  
   /*##-3- Start the conversion process and enable interrupt ##################*/  
-  if(HAL_ADC_Start_DMA(&AdcHandle,(uint32_t*)&uhADCxConvertedValue, SAMPLES_SIZE) != HAL_OK)
+  if( ( usb_raw_mode == false ) &&
+      ( HAL_ADC_Start_DMA(&AdcHandle,(uint32_t*)&uhADCxConvertedValue, SAMPLES_SIZE) != HAL_OK ) )
   {
     /* Start Conversation Error */
     Error_Handler(); 
@@ -177,35 +311,42 @@ int main(void)
   
   conversion_done = false;
   
+#if (USBH_USE_OS == 1)
+  /* Start the scheduler, the threads run from here */
+  osKernelStart(NULL, NULL);
+#endif
+  
   /* Infinite loop */
   while (1)
   {
-      if( conversion_done == true )
+      if( usb_host_started == true )
+      {
+          /* USB Host Background task, it never waits for the disk */
+          USBH_Process(&hUSB_Host);
+      }
+      
+      if( ( conversion_done == true ) && ( usb_msc_mode == true ) )
+      {
+          conversion_done = false;
+          log_spectrum();
+      }
+      else if( ( conversion_done == true ) && ( usb_device_mode == true ) )
+      {
+          conversion_done = false;
+          stream_spectrum();
+      }
+      else if( conversion_done == true )
       {
           conversion_done = false;
           arm_rfft_fast_init_f32( &S, SAMPLES_SIZE );
           arm_rfft_fast_f32( &S, ( float * ) uhADCxConvertedValue, fft_out, 0 );
           /* after this point the result of fft wil be in fft_out */
           
-          if(FATFS_LinkDriver(&USBH_Driver, USBDISKPath) == 0)
+          /* The frames captured before the disk is enumerated are not saved:
+             the logical units are only known from then */
+          if( Appli_state == APPLICATION_START )
           {
-            /*##-2- Init Host Library ################################################*/
-            USBH_Init(&hUSB_Host, USBH_UserProcess, 0);
-            
-            /*##-3- Add Supported Class ##############################################*/
-            USBH_RegisterClass(&hUSB_Host, USBH_MSC_CLASS);
-            
-            /*##-4- Start Host Process ###############################################*/
-            USBH_Start(&hUSB_Host);
-            
-            /*##-5- Run Application (Blocking mode) ##################################*/
-            /* USB Host Background task */
-            USBH_Process(&hUSB_Host);
-  
-            f_mount(&USBDISKFatFs, (TCHAR const*)USBDISKPath, 0);
             write_register_in_file( ( float const* ) uhADCxConvertedValue, SAMPLES_SIZE );
-            FATFS_UnLinkDriver(USBDISKPath);
-            
           }
       }
       else
@@ -214,6 +355,86 @@ int main(void)
   }
 }
 
+#if (USBH_USE_OS == 1)
+/**
+  * @brief  Application thread
+  * @param  argument: Not used
+  * @retval None
+  */
+static void StartThread(void const *argument)
+{
+  osEvent event;
+  
+  if( usb_device_mode == true )
+  {
+    /* The USB Device needs no thread, only the spectra are sent or logged
+       from here */
+    for( ;; )
+    {
+      event = osMessageGet(AppliEvent, osWaitForever);
+      
+      if( ( event.status == osEventMessage ) && ( event.value.v == CONVERSION_EVENT ) )
+      {
+        conversion_done = false;
+        if( usb_msc_mode == true )
+        {
+          log_spectrum();
+        }
+        else
+        {
+          stream_spectrum();
+        }
+      }
+    }
+  }
+  
+  /* Link the USB Host disk I/O driver, once per logical unit, and start the
+     host once: the enumeration and the class requests then run in the USB
+     host thread */
+  if( usb_disk_link() == true )
+  {
+    USBH_Init(&hUSB_Host, USBH_UserProcess, 0);
+    USBH_RegisterClass(&hUSB_Host, USBH_MSC_CLASS);
+    USBH_Start(&hUSB_Host);
+    
+    for( ;; )
+    {
+      event = osMessageGet(AppliEvent, osWaitForever);
+      
+      if(event.status == osEventMessage)
+      {
+        switch(event.value.v)
+        {
+        case CONNECTION_EVENT:
+          usb_disk_mount( true );
+          Appli_state = APPLICATION_START;
+          break;
+          
+        case DISCONNECTION_EVENT:
+          Appli_state = APPLICATION_IDLE;
+          usb_disk_mount( false );
+          break;
+          
+        case CONVERSION_EVENT:
+          conversion_done = false;
+          arm_rfft_fast_init_f32( &S, SAMPLES_SIZE );
+          arm_rfft_fast_f32( &S, ( float * ) uhADCxConvertedValue, fft_out, 0 );
+          
+          /* The sectors are written by the USB host thread, this one waits */
+          if( Appli_state == APPLICATION_START )
+          {
+            write_register_in_file( ( float const* ) uhADCxConvertedValue, SAMPLES_SIZE );
+          }
+          break;
+          
+        default:
+          break;
+        }
+      }
+    }
+  }
+}
+#endif
 
 static void write_register_in_file( const float raw_data[], const uint32_t size_raw_data )
 {
@@ -221,24 +442,53 @@ static void write_register_in_file( const float raw_data[], const uint32_t size_
   uint8_t name_file_str[8];
   uint32_t idx_array = 0;
   uint8_t buffer[64];
+  int len;
+  uint8_t lun;
+  uint8_t luns;
   
   sprintf( ( char* ) name_file_str, "%d.csv", name_file );
   
-  if( f_open( &MyFile, ( char const* ) name_file_str, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK ) 
+  /* The units the disk has, 0xFF before its enumeration */
+  luns = ( uint8_t ) USBH_MSC_GetMaxLUN( &hUSB_Host );
+  if( luns > USBDISK_LUNS )
+  {
+    luns = ( luns == 0xFF ) ? 0 : USBDISK_LUNS;
+  }
+  
+  /* Reserve a contiguous area for the whole file on each unit, the rows are
+     then written without cluster allocation. If a disk has no free block that
+     large the file is extended cluster by cluster as before. */
+  DiskLog_Init( &DiskLog, USBDISK_LOG_MODE );
+  for( lun = 0; lun < luns; lun++ )
+  {
+    DiskLog_AddVolume( &DiskLog, USBDISKPath[lun], ( char const* ) name_file_str, LOG_FILE_SIZE_MAX );
+  }
+  
+  if( DiskLog_Volumes( &DiskLog ) == 0 ) 
   {
   }
   else
   {
-    f_puts( "indice, valores\r\n", &MyFile );
+    /* The header on each unit, in both modes */
+    DiskLog_WriteAll( &DiskLog, "indice, valores\r\n", 17 );
       
     for( idx_array = 0; idx_array < size_raw_data; idx_array++ )
     {
-      sprintf( ( char* ) buffer, "%d, %f \r\n", idx_array, raw_data[idx_array] ); 
-      f_puts( ( char* ) buffer, &MyFile );
+      len = sprintf( ( char* ) buffer, "%d, %f \r\n", idx_array, raw_data[idx_array] ); 
+      if( DiskLog_Write( &DiskLog, buffer, len ) != FR_OK )
+      {
+        break; /* No unit left */
+      }
+#if _DISK_ASYNC > 0
+      FATFS_AsyncProcess(); /* Keep the queued sectors moving while formatting */
+#endif
     }/* end if-else */
     
-    f_close( &MyFile );
-    ++name_file; /* file write succesfully, inc the name to the next file */
+    /* Release the preallocated space not used */
+    if( DiskLog_Close( &DiskLog ) == FR_OK )
+    {
+      ++name_file; /* file write succesfully, inc the name to the next file */
+    }
     if( name_file > 1000 )
     {
       name_file = 0;
@@ -250,6 +500,371 @@ static void write_register_in_file( const float raw_data[], const uint32_t size_
   
 }/*end write_register_in_file()-----------------------------------------------*/
 
+/**
+  * @brief  Links the USB Host disk I/O driver once per logical unit of the
+  *         disk, USBDISKPath[lun] is the drive of the unit.
+  * @param  None
+  * @retval true if all the units are linked
+  */
+static bool usb_disk_link( void )
+{
+  uint8_t lun;
+  
+  for( lun = 0; lun < USBDISK_LUNS; lun++ )
+  {
+    if( FATFS_LinkDriverEx( &USBH_Driver, USBDISKPath[lun], lun ) != 0 )
+    {
+      while( lun > 0 )
+      {
+        FATFS_UnLinkDriver( USBDISKPath[--lun] );
+      }
+      return false;
+    }
+  }
+  return true;
+}/*end usb_disk_link()--------------------------------------------------------*/
+
+/**
+  * @brief  Registers or unregisters the file systems of the logical units of
+  *         the USB disk. A unit the disk lacks fails only when it is used.
+  * @param  mount: true to register, false to unregister
+  * @retval None
+  */
+static void usb_disk_mount( bool mount )
+{
+  uint8_t lun;
+  
+  for( lun = 0; lun < USBDISK_LUNS; lun++ )
+  {
+    f_mount( ( mount == true ) ? &USBDISKFatFs[lun] : NULL, ( TCHAR const* ) USBDISKPath[lun], 0 );
+  }
+}/*end usb_disk_mount()-------------------------------------------------------*/
+
+/**
+  * @brief  Tells the cable plugged in the USB OTG FS connector at reset.
+  * @param  None
+  * @retval true for a PC cable: ID floating and VBUS driven by the PC. An
+  *         OTG cable grounds ID, and VBUS is off until the host powers it.
+  */
+static bool usb_cable_is_pc( void )
+{
+  GPIO_InitTypeDef GPIO_InitStruct;
+  
+  USB_ID_GPIO_CLK_ENABLE();
+  
+  GPIO_InitStruct.Pin = USB_ID_PIN;
+  GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
+  GPIO_InitStruct.Pull = GPIO_PULLUP;
+  HAL_GPIO_Init(USB_ID_GPIO_PORT, &GPIO_InitStruct);
+  
+  GPIO_InitStruct.Pin = USB_VBUS_PIN;
+  GPIO_InitStruct.Pull = GPIO_NOPULL;
+  HAL_GPIO_Init(USB_ID_GPIO_PORT, &GPIO_InitStruct);
+  
+  /* Let the pull-up charge the ID line of the cable */
+  HAL_Delay(2);
+  
+  /* The MSP of the PCD or HCD driver gives the pins to the OTG core after */
+  return ( HAL_GPIO_ReadPin(USB_ID_GPIO_PORT, USB_ID_PIN) == GPIO_PIN_SET ) &&
+         ( HAL_GPIO_ReadPin(USB_ID_GPIO_PORT, USB_VBUS_PIN) == GPIO_PIN_SET );
+}
+
+/**
+  * @brief  Sends the spectrum of the last capture to the PC, then restarts the
+  *         capture. When the PC has not read the previous frames yet the
+  *         spectrum is dropped without computing it: the capture never waits
+  *         for the USB.
+  * @param  None
+  * @retval None
+  */
+static void stream_spectrum( void )
+{
+  float *samples = ( float * ) uhADCxConvertedValue;
+  float *bins = CDC_Stream_GetFrame();
+  uint32_t idx;
+  
+  if( bins != NULL )
+  {
+    /* The DMA is stopped, the samples are converted in place */
+    for( idx = 0; idx < SAMPLES_SIZE; idx++ )
+    {
+      samples[idx] = ( float ) uhADCxConvertedValue[idx];
+    }
+    
+    arm_rfft_fast_init_f32( &S, SAMPLES_SIZE );
+    arm_rfft_fast_f32( &S, samples, fft_out, 0 );
+    
+    /* The magnitudes go straight to the frame. fft_out[1] is the Nyquist
+       bin, packed with the real DC bin */
+    arm_cmplx_mag_f32( fft_out, bins, SAMPLES_SIZE / 2 );
+    bins[0] = fabsf( fft_out[0] );
+    
+    CDC_Stream_SendFrame( SAMPLES_SIZE / 2, ADCx_SAMPLE_RATE_HZ );
+  }
+  
+  /* Next capture, while the frame is on the bus */
+  if(HAL_ADC_Start_DMA(&AdcHandle,(uint32_t*)&uhADCxConvertedValue, SAMPLES_SIZE) != HAL_OK)
+  {
+    Error_Handler(); 
+  }
+}/*end stream_spectrum()------------------------------------------------------*/
+
+/**
+  * @brief  Mounts the capture log volume and opens its log file for
+  *         appending, then gives the volume to the storage of the MSC device.
+  *         The CCM RAM keeps the volume over a reset: it is formatted only
+  *         when it holds no file system, after a power on.
+  * @param  None
+  * @retval None
+  */
+static void log_volume_init( void )
+{
+  char path[16];
+  
+  RAMDISK_Attach( ( BYTE * ) LOG_VOLUME_ADDR, LOG_VOLUME_SECTORS );
+  if( FATFS_LinkDriver( &RAMDISK_Driver, LogPath ) != 0 )
+  {
+    return;
+  }
+  
+  if( f_mount( &LogFatFs, ( TCHAR const* ) LogPath, 1 ) == FR_NO_FILESYSTEM )
+  {
+    /* No partition table and one sector per cluster: FAT12, 93 sectors of
+       data after the 32 sectors of the root directory */
+    f_mkfs( ( TCHAR const* ) LogPath, 1, 512 );
+    f_mount( &LogFatFs, ( TCHAR const* ) LogPath, 1 );
+  }
+  
+  sprintf( path, "%s%s", LogPath, LOG_FILE_NAME );
+  if( f_open( &LogFile, path, FA_OPEN_ALWAYS | FA_WRITE ) == FR_OK )
+  {
+    f_lseek( &LogFile, f_size( &LogFile ) );
+    if( f_size( &LogFile ) == 0 )
+    {
+      /* f_puts ends the line with CR LF */
+      f_puts( "captura, tempo_ms, media, pico_hz, magnitude\n", &LogFile );
+    }
+    log_ready = ( f_sync( &LogFile ) == FR_OK );
+  }
+  
+  /* Exported even when the file could not be opened: the PC sees what the
+     volume holds */
+  STORAGE_Attach( &RAMDISK_Driver );
+}/*end log_volume_init()------------------------------------------------------*/
+
+/**
+  * @brief  Appends a row to the log file for the first capture of each
+  *         LOG_PERIOD_MS: mean, strongest bin and its magnitude. Then
+  *         restarts the capture. The volume is updated with the USB interrupt
+  *         masked, the PC reading it sees the data, FAT and directory entry
+  *         of a row all written or not at all. Once the volume is full, the
+  *         logging stops after the last whole row.
+  * @param  None
+  * @retval None
+  */
+static void log_spectrum( void )
+{
+  float *samples = ( float * ) uhADCxConvertedValue;
+  float power, peak = 0;
+  uint32_t idx, peak_bin = 1;
+  char row[64];
+  UINT len, written;
+  DWORD size;
+  
+  ++log_captures;
+  
+  if( ( log_ready == true ) && ( HAL_GetTick() - log_last_tick >= LOG_PERIOD_MS ) )
+  {
+    log_last_tick = HAL_GetTick();
+    
+    /* The DMA is stopped, the samples are converted in place */
+    for( idx = 0; idx < SAMPLES_SIZE; idx++ )
+    {
+      samples[idx] = ( float ) uhADCxConvertedValue[idx];
+    }
+    
+    arm_rfft_fast_init_f32( &S, SAMPLES_SIZE );
+    arm_rfft_fast_f32( &S, samples, fft_out, 0 );
+    
+    /* The DC bin and the Nyquist bin, packed in fft_out[0] and fft_out[1],
+       are left out of the peak */
+    for( idx = 1; idx < SAMPLES_SIZE / 2; idx++ )
+    {
+      power = fft_out[2 * idx] * fft_out[2 * idx] + fft_out[2 * idx + 1] * fft_out[2 * idx + 1];
+      if( power > peak )
+      {
+        peak = power;
+        peak_bin = idx;
+      }
+    }
+    
+    len = sprintf( row, "%lu, %lu, %.1f, %lu, %.1f\r\n",
+                   ( unsigned long ) log_captures, ( unsigned long ) log_last_tick,
+                   fft_out[0] / SAMPLES_SIZE,
+                   ( unsigned long ) ( peak_bin * ADCx_SAMPLE_RATE_HZ / SAMPLES_SIZE ),
+                   sqrtf( peak ) );
+    
+    HAL_NVIC_DisableIRQ( OTG_FS_IRQn );
+    size = f_size( &LogFile );
+    if( ( f_write( &LogFile, row, len, &written ) != FR_OK ) || ( written != len ) )
+    {
+      f_lseek( &LogFile, size );
+      f_truncate( &LogFile );
+      log_ready = false;
+    }
+    f_sync( &LogFile );
+    HAL_NVIC_EnableIRQ( OTG_FS_IRQn );
+  }
+  
+  /* Next capture */
+  if(HAL_ADC_Start_DMA(&AdcHandle,(uint32_t*)&uhADCxConvertedValue, SAMPLES_SIZE) != HAL_OK)
+  {
+    Error_Handler(); 
+  }
+}/*end log_spectrum()---------------------------------------------------------*/
+
+#if (USBD_STREAM_RAW == 1)
+/**
+  * @brief  Sets the sample rate of the raw capture: the fastest pair of ADC
+  *         clock prescaler and sampling time not above the rate asked. Called
+  *         with the capture stopped.
+  * @param  rate: Rate asked, in Hz
+  * @retval Rate set, in Hz, or 0 if the rate asked is below the slowest one:
+  *         the setting is kept
+  */
+uint32_t RAW_Capture_SetRate( uint32_t rate )
+{
+  static const uint32_t prescalers[] = { ADC_CLOCKPRESCALER_PCLK_DIV2, ADC_CLOCKPRESCALER_PCLK_DIV4,
+                                         ADC_CLOCKPRESCALER_PCLK_DIV6, ADC_CLOCKPRESCALER_PCLK_DIV8 };
+  static const uint32_t sampling_times[] = { ADC_SAMPLETIME_3CYCLES, ADC_SAMPLETIME_15CYCLES,
+                                             ADC_SAMPLETIME_28CYCLES, ADC_SAMPLETIME_56CYCLES,
+                                             ADC_SAMPLETIME_84CYCLES, ADC_SAMPLETIME_112CYCLES,
+                                             ADC_SAMPLETIME_144CYCLES, ADC_SAMPLETIME_480CYCLES };
+  static const uint16_t sampling_cycles[] = { 3, 15, 28, 56, 84, 112, 144, 480 };
+  ADC_ChannelConfTypeDef sConfig;
+  uint32_t pclk2 = HAL_RCC_GetPCLK2Freq();
+  uint32_t best = 0, value;
+  uint8_t p, s, best_p = 0, best_s = 0;
+  
+  /* 12 cycles of conversion after the sampling */
+  for( p = 0; p < 4; p++ )
+  {
+    for( s = 0; s < 8; s++ )
+    {
+      value = pclk2 / ( 2 * ( p + 1 ) ) / ( sampling_cycles[s] + 12 );
+      if( ( value <= rate ) && ( value > best ) )
+      {
+        best = value;
+        best_p = p;
+        best_s = s;
+      }
+    }
+  }
+  if( best == 0 )
+  {
+    return 0;
+  }
+  
+  AdcHandle.Init.ClockPrescaler = prescalers[best_p];
+  HAL_ADC_Init( &AdcHandle );
+  
+  sConfig.Channel = ADCx_CHANNEL;
+  sConfig.Rank = 1;
+  sConfig.SamplingTime = sampling_times[best_s];
+  sConfig.Offset = 0;
+  HAL_ADC_ConfigChannel( &AdcHandle, &sConfig );
+  
+  return best;
+}
+
+/**
+  * @brief  Starts the raw capture: the DMA runs in double buffer mode, the
+  *         samples go as half words straight to the frames of the USB
+  *         interface, with no gap between them.
+  * @param  mem0: Samples of the first frame
+  * @param  mem1: Samples of the second frame
+  * @param  samples: Samples of a frame
+  * @retval None
+  */
+void RAW_Capture_Start( uint16_t *mem0, uint16_t *mem1, uint16_t samples )
+{
+  DMA_HandleTypeDef *hdma = AdcHandle.DMA_Handle;
+  uint16_t i;
+  
+  hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+  hdma->Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+  HAL_DMA_Init( hdma );
+  hdma->XferCpltCallback = raw_capture_m0_cplt;
+  hdma->XferM1CpltCallback = raw_capture_m1_cplt;
+  hdma->XferHalfCpltCallback = NULL;
+  hdma->XferErrorCallback = NULL;
+  
+  /* The frames are handed to the USB device from the DMA interrupt: it must
+     not preempt the USB interrupt, nor be preempted by it */
+  HAL_NVIC_SetPriority( ADCx_DMA_IRQn, USBD_IRQ_PRIORITY, 0 );
+  
+  /* No flag left by the previous capture */
+  __HAL_DMA_CLEAR_FLAG( hdma, __HAL_DMA_GET_TC_FLAG_INDEX( hdma ) | __HAL_DMA_GET_HT_FLAG_INDEX( hdma ) |
+                              __HAL_DMA_GET_TE_FLAG_INDEX( hdma ) | __HAL_DMA_GET_FE_FLAG_INDEX( hdma ) |
+                              __HAL_DMA_GET_DME_FLAG_INDEX( hdma ) );
+  HAL_DMAEx_MultiBufferStart_IT( hdma, ( uint32_t ) &AdcHandle.Instance->DR,
+                                 ( uint32_t ) mem0, ( uint32_t ) mem1, samples );
+  __HAL_DMA_DISABLE_IT( hdma, DMA_IT_HT );
+  
+  /* Then the ADC, as HAL_ADC_Start_DMA does */
+  AdcHandle.State = HAL_ADC_STATE_BUSY_REG;
+  AdcHandle.Instance->CR2 |= ADC_CR2_DMA;
+  if( ( AdcHandle.Instance->CR2 & ADC_CR2_ADON ) != ADC_CR2_ADON )
+  {
+    __HAL_ADC_ENABLE( &AdcHandle );
+    
+    /* Tstab of the ADC */
+    for( i = 0; i <= 540; i++ )
+    {
+      __NOP();
+    }
+  }
+  AdcHandle.Instance->CR2 |= ADC_CR2_SWSTART;
+}
+
+/**
+  * @brief  Stops the raw capture, the frames being written are left as they
+  *         are.
+  * @param  None
+  * @retval None
+  */
+void RAW_Capture_Stop( void )
+{
+  HAL_ADC_Stop_DMA( &AdcHandle );
+}
+
+/**
+  * @brief  End of the frame of memory 0, the DMA writes memory 1: memory 0
+  *         gets the frame after it.
+  * @param  hdma: DMA handle of the ADC
+  * @retval None
+  */
+static void raw_capture_m0_cplt( DMA_HandleTypeDef *hdma )
+{
+  uint16_t *next = RAW_Stream_FrameCplt( ( uint16_t * ) hdma->Instance->M0AR, HAL_GetTick() );
+  
+  HAL_DMAEx_ChangeMemory( hdma, ( uint32_t ) next, MEMORY0 );
+}
+
+/**
+  * @brief  End of the frame of memory 1, the DMA writes memory 0: memory 1
+  *         gets the frame after it.
+  * @param  hdma: DMA handle of the ADC
+  * @retval None
+  */
+static void raw_capture_m1_cplt( DMA_HandleTypeDef *hdma )
+{
+  uint16_t *next = RAW_Stream_FrameCplt( ( uint16_t * ) hdma->Instance->M1AR, HAL_GetTick() );
+  
+  HAL_DMAEx_ChangeMemory( hdma, ( uint32_t ) next, MEMORY1 );
+}
+#endif /* USBD_STREAM_RAW */
+
 /**
   * @brief  User Process
   * @param  phost: Host handle
@@ -267,11 +882,24 @@ static void USBH_UserProcess(USBH_HandleTypeDef *phost, uint8_t id)
   // Appli_state = APPLICATION_IDLE;
     BSP_LED_Off(LED4); 
     BSP_LED_Off(LED5);  
-    f_mount(NULL, (TCHAR const*)"", 0);          
+#if (USBH_USE_OS == 1)
+    /* Called by the USB host thread: the volume is released by the application
+       thread, which owns the file system */
+    osMessagePut(AppliEvent, DISCONNECTION_EVENT, 0);
+#else
+    Appli_state = APPLICATION_IDLE;
+    usb_disk_mount( false );
+#endif
     break;
     
   case HOST_USER_CLASS_ACTIVE:
     //Appli_state = APPLICATION_START;
+#if (USBH_USE_OS == 1)
+    osMessagePut(AppliEvent, CONNECTION_EVENT, 0);
+#else
+    usb_disk_mount( true );
+    Appli_state = APPLICATION_START;
+#endif
     break;
     
   default:
@@ -361,6 +989,9 @@ void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* AdcHandle)
   HAL_ADC_Stop_DMA(AdcHandle);
   BSP_LED_On(LED4);
     conversion_done = true;
+#if (USBH_USE_OS == 1)
+  osMessagePut(AppliEvent, CONVERSION_EVENT, 0);
+#endif
 }
 
 #ifdef  USE_FULL_ASSERT
@@ -109,7 +109,13 @@ void HAL_ADC_MspInit(ADC_HandleTypeDef* hadc)
 
   /*##-4- Configure the NVIC for DMA #########################################*/
   /* NVIC configuration for DMA transfer complete interrupt */
+#if (USBH_USE_OS == 1)
+  /* The conversion complete callback wakes the application thread: the
+     priority must not be above configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY */
+  HAL_NVIC_SetPriority(ADCx_DMA_IRQn, 6, 0);   
+#else
   HAL_NVIC_SetPriority(ADCx_DMA_IRQn, 0, 0);   
+#endif
   HAL_NVIC_EnableIRQ(ADCx_DMA_IRQn);
 }
   
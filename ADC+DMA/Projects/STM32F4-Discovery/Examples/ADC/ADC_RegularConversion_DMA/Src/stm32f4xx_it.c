@@ -42,6 +42,10 @@
 #include "stm32f4xx_it.h"
 
 extern HCD_HandleTypeDef hhcd;
+extern PCD_HandleTypeDef hpcd;
+#if (USBH_USE_OS == 1)
+extern void xPortSysTickHandler(void);
+#endif
    
 
 /** @addtogroup STM32F4xx_HAL_Examples
@@ -132,9 +136,12 @@ void UsageFault_Handler(void)
   * @param  None
   * @retval None
   */
+#if (USBH_USE_OS == 0)
+/* With USBH_USE_OS, FreeRTOSConfig.h maps it to vPortSVCHandler */
 void SVC_Handler(void)
 {
 }
+#endif
 
 /**
   * @brief  This function handles Debug Monitor exception.
@@ -150,9 +157,12 @@ void DebugMon_Handler(void)
   * @param  None
   * @retval None
   */
+#if (USBH_USE_OS == 0)
+/* With USBH_USE_OS, FreeRTOSConfig.h maps it to xPortPendSVHandler */
 void PendSV_Handler(void)
 {
 }
+#endif
 
 /**
   * @brief  This function handles SysTick Handler.
@@ -161,6 +171,14 @@ void PendSV_Handler(void)
   */
 void SysTick_Handler(void)
 {
+  HAL_IncTick();
+  HAL_SYSTICK_IRQHandler();
+#if (USBH_USE_OS == 1)
+  if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+  {
+    xPortSysTickHandler();
+  }
+#endif
 }
 
 /******************************************************************************/
@@ -187,7 +205,15 @@ void ADCx_DMA_IRQHandler(void)
   */
 void OTG_FS_IRQHandler(void)
 {
-  HAL_HCD_IRQHandler(&hhcd);
+  /* Only the driver of the role chosen at reset is initialized */
+  if(hpcd.Instance == USB_OTG_FS)
+  {
+    HAL_PCD_IRQHandler(&hpcd);
+  }
+  else
+  {
+    HAL_HCD_IRQHandler(&hhcd);
+  }
 }
 
 /**
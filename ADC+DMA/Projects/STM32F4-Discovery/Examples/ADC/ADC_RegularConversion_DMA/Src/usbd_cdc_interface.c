@@ -0,0 +1,354 @@
+/**
+  ******************************************************************************
+  * @file    ADC/ADC_RegularConversion_DMA/Src/usbd_cdc_interface.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   USBD CDC interface streaming the spectra to the PC.
+  *
+  *          The spectra are sent as frames (spectrum_frame.h) on the CDC IN
+  *          endpoint, from two buffers: one is on the bus while the next
+  *          spectrum is written to the other. When both are busy, because
+  *          the PC does not read as fast as the capture, the whole frame is
+  *          dropped and counted: the capture is never stalled by the USB.
+  *          Frames are sent only while the port is open (DTR set).
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbd_cdc_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum {
+  STREAM_FREE = 0,
+  STREAM_FILLING,      /* Given to the application by CDC_Stream_GetFrame */
+  STREAM_QUEUED,       /* Waiting for the end of the transfer of the other one */
+  STREAM_SENDING,
+}STREAM_BufferStateTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define APP_RX_DATA_SIZE  CDC_DATA_FS_MAX_PACKET_SIZE
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+USBD_CDC_LineCodingTypeDef LineCoding =
+  {
+    115200, /* baud rate*/
+    0x00,   /* stop bits-1*/
+    0x00,   /* parity - none*/
+    0x08    /* nb. of bits 8*/
+  };
+
+/* Frame buffers, word aligned for the float magnitudes */
+static uint32_t StreamBuffer[CDC_STREAM_BUFFERS][CDC_STREAM_FRAME_SIZE / 4];
+static __IO STREAM_BufferStateTypeDef StreamState[CDC_STREAM_BUFFERS];
+static uint8_t  StreamFill;                /* Buffer in STREAM_FILLING */
+static __IO uint8_t  StreamOpen = 0;       /* DTR of the last SET_CONTROL_LINE_STATE */
+static __IO uint32_t StreamSeq = 0;
+static __IO uint32_t StreamSent = 0;
+static __IO uint32_t StreamDropped = 0;
+
+/* The PC sends nothing, its data are discarded */
+static uint8_t UserRxBuffer[APP_RX_DATA_SIZE];
+
+/* USB handler declaration */
+extern USBD_HandleTypeDef  USBD_Device;
+
+/* Private function prototypes -----------------------------------------------*/
+static int8_t CDC_Itf_Init(void);
+static int8_t CDC_Itf_DeInit(void);
+static int8_t CDC_Itf_Control(uint8_t cmd, uint8_t* pbuf, uint16_t length);
+static int8_t CDC_Itf_Receive(uint8_t* pbuf, uint32_t *Len);
+static int8_t CDC_Itf_TransmitCplt(uint8_t* pbuf, uint32_t *Len, uint8_t epnum);
+
+static void CDC_Stream_Reset(void);
+static void CDC_Stream_Start(uint8_t idx);
+
+USBD_CDC_ItfTypeDef USBD_CDC_fops =
+{
+  CDC_Itf_Init,
+  CDC_Itf_DeInit,
+  CDC_Itf_Control,
+  CDC_Itf_Receive,
+  CDC_Itf_TransmitCplt
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  CDC_Itf_Init
+  *         Initializes the CDC media low layer
+  * @param  None
+  * @retval Result of the operation: USBD_OK if all operations are OK else USBD_FAIL
+  */
+static int8_t CDC_Itf_Init(void)
+{
+  /* A new configuration: the stream restarts when the port is opened */
+  CDC_Stream_Reset();
+  StreamSeq = 0;
+  StreamSent = 0;
+  StreamDropped = 0;
+
+  USBD_CDC_SetTxBuffer(&USBD_Device, (uint8_t *)StreamBuffer[0], 0);
+  USBD_CDC_SetRxBuffer(&USBD_Device, UserRxBuffer);
+
+  return (USBD_OK);
+}
+
+/**
+  * @brief  CDC_Itf_DeInit
+  *         DeInitializes the CDC media low layer
+  * @param  None
+  * @retval Result of the operation: USBD_OK if all operations are OK else USBD_FAIL
+  */
+static int8_t CDC_Itf_DeInit(void)
+{
+  /* Reset or unplug: the transfer in progress is lost */
+  CDC_Stream_Reset();
+
+  return (USBD_OK);
+}
+
+/**
+  * @brief  CDC_Itf_Control
+  *         Manage the CDC class requests
+  * @param  Cmd: Command code
+  * @param  Buf: Buffer containing command data (request parameters), or the
+  *              USBD_SetupReqTypedef of the request when Len is 0
+  * @param  Len: Number of data to be sent (in bytes)
+  * @retval Result of the operation: USBD_OK if all operations are OK else USBD_FAIL
+  */
+static int8_t CDC_Itf_Control (uint8_t cmd, uint8_t* pbuf, uint16_t length)
+{
+  switch (cmd)
+  {
+  case CDC_SET_LINE_CODING:
+    /* Accepted and reported back, the stream does not depend on it */
+    LineCoding.bitrate    = (uint32_t)(pbuf[0] | (pbuf[1] << 8) |\
+                            (pbuf[2] << 16) | (pbuf[3] << 24));
+    LineCoding.format     = pbuf[4];
+    LineCoding.paritytype = pbuf[5];
+    LineCoding.datatype   = pbuf[6];
+    break;
+
+  case CDC_GET_LINE_CODING:
+    pbuf[0] = (uint8_t)(LineCoding.bitrate);
+    pbuf[1] = (uint8_t)(LineCoding.bitrate >> 8);
+    pbuf[2] = (uint8_t)(LineCoding.bitrate >> 16);
+    pbuf[3] = (uint8_t)(LineCoding.bitrate >> 24);
+    pbuf[4] = LineCoding.format;
+    pbuf[5] = LineCoding.paritytype;
+    pbuf[6] = LineCoding.datatype;
+    break;
+
+  case CDC_SET_CONTROL_LINE_STATE:
+    /* DTR is set while a program has the port open */
+    StreamOpen = (((USBD_SetupReqTypedef *)pbuf)->wValue & 0x01) ? 1 : 0;
+    break;
+
+  default:
+    break;
+  }
+
+  return (USBD_OK);
+}
+
+/**
+  * @brief  CDC_Itf_DataRx
+  *         Data received over USB OUT endpoint, discarded.
+  * @param  Buf: Buffer of data received
+  * @param  Len: Number of data received (in bytes)
+  * @retval Result of the operation: USBD_OK if all operations are OK else USBD_FAIL
+  */
+static int8_t CDC_Itf_Receive(uint8_t* Buf, uint32_t *Len)
+{
+  USBD_CDC_ReceivePacket(&USBD_Device);
+  return (USBD_OK);
+}
+
+/**
+  * @brief  CDC_Itf_TransmitCplt
+  *         A frame has been sent: its buffer is released and the queued frame,
+  *         if any, is started. Called in the USB interrupt.
+  * @param  Buf: Buffer of the data sent
+  * @param  Len: Number of data sent (in bytes)
+  * @param  epnum: IN endpoint number
+  * @retval Result of the operation: USBD_OK if all operations are OK else USBD_FAIL
+  */
+static int8_t CDC_Itf_TransmitCplt(uint8_t* Buf, uint32_t *Len, uint8_t epnum)
+{
+  uint8_t idx;
+
+  for(idx = 0; idx < CDC_STREAM_BUFFERS; idx++)
+  {
+    if(StreamState[idx] == STREAM_SENDING)
+    {
+      StreamState[idx] = STREAM_FREE;
+      StreamSent++;
+    }
+  }
+
+  for(idx = 0; idx < CDC_STREAM_BUFFERS; idx++)
+  {
+    if(StreamState[idx] == STREAM_QUEUED)
+    {
+      CDC_Stream_Start(idx);
+      break;
+    }
+  }
+  return (USBD_OK);
+}
+
+/**
+  * @brief  Releases the buffers on the bus. The one being filled stays with
+  *         the application, CDC_Stream_SendFrame releases it.
+  * @param  None
+  * @retval None
+  */
+static void CDC_Stream_Reset(void)
+{
+  uint8_t idx;
+
+  StreamOpen = 0;
+  for(idx = 0; idx < CDC_STREAM_BUFFERS; idx++)
+  {
+    if(StreamState[idx] != STREAM_FILLING)
+    {
+      StreamState[idx] = STREAM_FREE;
+    }
+  }
+}
+
+/**
+  * @brief  Starts the transfer of a frame, with the USB interrupt masked.
+  * @param  idx: Buffer of the frame
+  * @retval None
+  */
+static void CDC_Stream_Start(uint8_t idx)
+{
+  SPECTRUM_FrameHeaderTypeDef *header = (SPECTRUM_FrameHeaderTypeDef *)StreamBuffer[idx];
+
+  USBD_CDC_SetTxBuffer(&USBD_Device, (uint8_t *)StreamBuffer[idx], header->length);
+
+  if(USBD_CDC_TransmitPacket(&USBD_Device) == USBD_OK)
+  {
+    StreamState[idx] = STREAM_SENDING;
+  }
+  else
+  {
+    /* Not configured any more */
+    StreamState[idx] = STREAM_FREE;
+    StreamDropped++;
+  }
+}
+
+/**
+  * @brief  Gives a buffer for the magnitudes of the next spectrum.
+  * @param  None
+  * @retval Room for CDC_STREAM_MAX_BINS floats, or NULL if the frame is
+  *         dropped: the port is closed or both buffers are on the bus.
+  */
+float *CDC_Stream_GetFrame(void)
+{
+  uint8_t idx;
+
+  if(StreamOpen == 0)
+  {
+    return NULL;
+  }
+
+  /* Only the USB interrupt frees a buffer, none is taken behind our back */
+  for(idx = 0; idx < CDC_STREAM_BUFFERS; idx++)
+  {
+    if(StreamState[idx] == STREAM_FREE)
+    {
+      StreamState[idx] = STREAM_FILLING;
+      StreamFill = idx;
+      return (float *)&StreamBuffer[idx][SPECTRUM_FRAME_HEADER_SIZE / 4];
+    }
+  }
+
+  /* The PC is late: the sequence number shows the gap to the reader */
+  StreamSeq++;
+  StreamDropped++;
+  return NULL;
+}
+
+/**
+  * @brief  Sends the frame given by the last CDC_Stream_GetFrame, at once if
+  *         the IN endpoint is idle, else after the frame on the bus.
+  * @param  bins: Number of magnitudes written, up to CDC_STREAM_MAX_BINS
+  * @param  sample_rate: Sample rate of the ADC in Hz
+  * @retval None
+  */
+void CDC_Stream_SendFrame(uint16_t bins, uint32_t sample_rate)
+{
+  SPECTRUM_FrameHeaderTypeDef *header = (SPECTRUM_FrameHeaderTypeDef *)StreamBuffer[StreamFill];
+  uint32_t end = SPECTRUM_FRAME_HEADER_SIZE + 4 * bins;
+  uint8_t idx;
+
+  header->magic       = SPECTRUM_FRAME_MAGIC;
+  header->seq         = StreamSeq++;
+  header->dropped     = StreamDropped;
+  header->sample_rate = sample_rate;
+  header->bins        = bins;
+  header->packet      = CDC_DATA_FS_MAX_PACKET_SIZE;
+  header->length      = SPECTRUM_FRAME_SIZE(bins, CDC_DATA_FS_MAX_PACKET_SIZE);
+
+  /* Zero padding up to the last packet */
+  memset((uint8_t *)StreamBuffer[StreamFill] + end, 0, header->length - end);
+
+  __disable_irq();
+  if(StreamOpen == 0)
+  {
+    StreamState[StreamFill] = STREAM_FREE;
+  }
+  else
+  {
+    StreamState[StreamFill] = STREAM_QUEUED;
+
+    for(idx = 0; idx < CDC_STREAM_BUFFERS; idx++)
+    {
+      if(StreamState[idx] == STREAM_SENDING)
+      {
+        break;
+      }
+    }
+    if(idx == CDC_STREAM_BUFFERS)
+    {
+      CDC_Stream_Start(StreamFill);
+    }
+  }
+  __enable_irq();
+}
+
+/**
+  * @brief  Counters of the stream since the configuration.
+  * @param  sent: Frames sent
+  * @param  dropped: Frames dropped
+  * @retval None
+  */
+void CDC_Stream_GetStats(uint32_t *sent, uint32_t *dropped)
+{
+  *sent = StreamSent;
+  *dropped = StreamDropped;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
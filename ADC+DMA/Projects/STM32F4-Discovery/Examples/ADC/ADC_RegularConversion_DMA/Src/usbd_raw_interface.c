@@ -0,0 +1,481 @@
+/**
+  ******************************************************************************
+  * @file    ADC/ADC_RegularConversion_DMA/Src/usbd_raw_interface.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   USBD vendor class interface streaming the raw ADC samples.
+  *
+  *          The frames (raw_frame.h) live in a pool. The capture DMA, in
+  *          double buffer mode, writes the samples of two of them in place;
+  *          at the end of each one this module writes its header, queues it
+  *          for the bulk IN endpoint and gives the DMA a free frame for the
+  *          next but one: the frame is sent from where it was captured, with
+  *          no copy, and the capture has no gap. When no frame is free,
+  *          because the PC does not read as fast as the capture, the frame
+  *          just captured is dropped and counted, its buffer captures again:
+  *          the capture is never stalled by the USB.
+  *
+  *          The PC starts and stops the capture, sets its rate and trigger
+  *          with the vendor requests of raw_frame.h. Everything here runs
+  *          in the USB interrupt and in the DMA interrupt of the capture,
+  *          which have the same priority: no masking is needed.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbd_raw_interface.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef enum {
+  FRAME_FREE = 0,
+  FRAME_CAPTURE,       /* Written by the DMA */
+  FRAME_QUEUED,        /* Waiting for the end of the transfer of the other ones */
+  FRAME_SENDING,
+}RAW_FrameStateTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define RAW_NO_FRAME    0xFF
+
+/* Private macro -------------------------------------------------------------*/
+#define RAW_SAMPLES(idx)  ((uint16_t *)((uint8_t *)FrameBuffer[idx] + RAW_FRAME_HEADER_SIZE))
+
+/* Private variables ---------------------------------------------------------*/
+/* Frame buffers, word aligned for the DMA and the FIFO of the endpoint. The
+   padding after the samples is never written, it stays zero */
+static uint32_t FrameBuffer[RAW_STREAM_FRAMES][RAW_STREAM_FRAME_SIZE / 4];
+static RAW_FrameStateTypeDef FrameState[RAW_STREAM_FRAMES];
+
+/* Frames to send, oldest first */
+static uint8_t  FrameQueue[RAW_STREAM_FRAMES];
+static uint8_t  QueueHead;
+static uint8_t  QueueCount;
+static uint8_t  FrameSending = RAW_NO_FRAME;
+
+static uint8_t  StreamState = RAW_STATE_IDLE;
+static uint32_t StreamRate = 0;
+static uint16_t StreamLeft;                /* Frames still to send, when counted */
+static uint8_t  StreamCounted;
+static uint32_t StreamSeq = 0;
+static uint32_t StreamSent = 0;
+static uint32_t StreamDropped = 0;
+
+static uint8_t  TriggerMode = RAW_TRIGGER_NONE;
+static uint16_t TriggerLevel = 0;
+static uint16_t LastSample;                /* Of the previous frame, for a crossing at its end */
+static uint8_t  LastValid;
+
+/* USB handler declaration */
+extern USBD_HandleTypeDef  USBD_Device;
+
+/* Private function prototypes -----------------------------------------------*/
+static int8_t RAW_Itf_Init(void);
+static int8_t RAW_Itf_DeInit(void);
+static int8_t RAW_Itf_Control(USBD_SetupReqTypedef *req, uint8_t *pbuf, uint16_t *length);
+static int8_t RAW_Itf_TransmitCplt(uint8_t *pbuf, uint32_t length);
+
+static int8_t   RAW_Stream_Start(uint16_t frames);
+static void     RAW_Stream_Stop(void);
+static void     RAW_Stream_Send(void);
+static uint16_t RAW_Stream_Trigger(const uint16_t *samples);
+static uint8_t  RAW_Stream_FreeFrame(void);
+
+USBD_VENDOR_ItfTypeDef USBD_RAW_fops =
+{
+  RAW_Itf_Init,
+  RAW_Itf_DeInit,
+  RAW_Itf_Control,
+  RAW_Itf_TransmitCplt
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  RAW_Itf_Init
+  *         A new configuration: stopped, default rate and no trigger.
+  * @param  None
+  * @retval Result of the operation: USBD_OK if all operations are OK else USBD_FAIL
+  */
+static int8_t RAW_Itf_Init(void)
+{
+  RAW_Stream_Stop();
+  StreamSeq = 0;
+  StreamSent = 0;
+  StreamDropped = 0;
+  TriggerMode = RAW_TRIGGER_NONE;
+  TriggerLevel = 0;
+  StreamRate = RAW_Capture_SetRate(RAW_STREAM_DEFAULT_RATE);
+
+  return (USBD_OK);
+}
+
+/**
+  * @brief  RAW_Itf_DeInit
+  *         Reset or unplug: the capture stops, the frames queued are lost.
+  * @param  None
+  * @retval Result of the operation: USBD_OK if all operations are OK else USBD_FAIL
+  */
+static int8_t RAW_Itf_DeInit(void)
+{
+  uint8_t idx;
+
+  RAW_Stream_Stop();
+  for(idx = 0; idx < RAW_STREAM_FRAMES; idx++)
+  {
+    FrameState[idx] = FRAME_FREE;
+  }
+  QueueCount = 0;
+  FrameSending = RAW_NO_FRAME;
+
+  return (USBD_OK);
+}
+
+/**
+  * @brief  RAW_Itf_Control
+  *         Manage the vendor requests of raw_frame.h
+  * @param  req: Setup request
+  * @param  pbuf: Receives the data of RAW_REQ_GET_STATUS
+  * @param  length: Receives their number
+  * @retval USBD_OK, or USBD_FAIL to STALL a request unknown or not possible
+  *         in the current state
+  */
+static int8_t RAW_Itf_Control(USBD_SetupReqTypedef *req, uint8_t *pbuf, uint16_t *length)
+{
+  uint32_t rate;
+
+  if(req->bRequest == RAW_REQ_GET_STATUS)
+  {
+    if((req->bmRequest & 0x80) == 0)
+    {
+      return (USBD_FAIL);
+    }
+    pbuf[0]  = (uint8_t)(StreamRate);
+    pbuf[1]  = (uint8_t)(StreamRate >> 8);
+    pbuf[2]  = (uint8_t)(StreamRate >> 16);
+    pbuf[3]  = (uint8_t)(StreamRate >> 24);
+    pbuf[4]  = StreamState;
+    pbuf[5]  = TriggerMode;
+    pbuf[6]  = LOBYTE(TriggerLevel);
+    pbuf[7]  = HIBYTE(TriggerLevel);
+    pbuf[8]  = (uint8_t)(StreamSeq);
+    pbuf[9]  = (uint8_t)(StreamSeq >> 8);
+    pbuf[10] = (uint8_t)(StreamSeq >> 16);
+    pbuf[11] = (uint8_t)(StreamSeq >> 24);
+    pbuf[12] = (uint8_t)(StreamSent);
+    pbuf[13] = (uint8_t)(StreamSent >> 8);
+    pbuf[14] = (uint8_t)(StreamSent >> 16);
+    pbuf[15] = (uint8_t)(StreamSent >> 24);
+    pbuf[16] = (uint8_t)(StreamDropped);
+    pbuf[17] = (uint8_t)(StreamDropped >> 8);
+    pbuf[18] = (uint8_t)(StreamDropped >> 16);
+    pbuf[19] = (uint8_t)(StreamDropped >> 24);
+    *length = RAW_STATUS_SIZE;
+    return (USBD_OK);
+  }
+
+  /* The other requests have no data stage */
+  if((req->bmRequest & 0x80) || (req->wLength != 0))
+  {
+    return (USBD_FAIL);
+  }
+
+  switch(req->bRequest)
+  {
+  case RAW_REQ_START:
+    return RAW_Stream_Start(req->wValue);
+
+  case RAW_REQ_STOP:
+    RAW_Stream_Stop();
+    break;
+
+  case RAW_REQ_SET_RATE:
+    if((StreamState != RAW_STATE_IDLE) || (req->wValue == 0))
+    {
+      return (USBD_FAIL);
+    }
+    rate = RAW_Capture_SetRate(req->wValue * 100U);
+    if(rate == 0)
+    {
+      /* Below the slowest rate of the ADC: the previous rate is kept */
+      return (USBD_FAIL);
+    }
+    StreamRate = rate;
+    break;
+
+  case RAW_REQ_SET_TRIGGER:
+    if((StreamState != RAW_STATE_IDLE) || ((req->wValue >> 12) > RAW_TRIGGER_FALLING))
+    {
+      return (USBD_FAIL);
+    }
+    TriggerMode = req->wValue >> 12;
+    TriggerLevel = req->wValue & 0x0FFF;
+    break;
+
+  default:
+    return (USBD_FAIL);
+  }
+
+  return (USBD_OK);
+}
+
+/**
+  * @brief  RAW_Itf_TransmitCplt
+  *         A frame has been sent: its buffer is released and the next frame
+  *         queued, if any, is started. Called in the USB interrupt.
+  * @param  pbuf: Buffer of the data sent
+  * @param  length: Number of data sent (in bytes)
+  * @retval Result of the operation: USBD_OK if all operations are OK else USBD_FAIL
+  */
+static int8_t RAW_Itf_TransmitCplt(uint8_t *pbuf, uint32_t length)
+{
+  if(FrameSending != RAW_NO_FRAME)
+  {
+    FrameState[FrameSending] = FRAME_FREE;
+    FrameSending = RAW_NO_FRAME;
+    StreamSent++;
+  }
+  RAW_Stream_Send();
+
+  return (USBD_OK);
+}
+
+/**
+  * @brief  Starts the capture into two free frames.
+  * @param  frames: Frames to send, 0 until RAW_REQ_STOP
+  * @retval USBD_OK, or USBD_FAIL if running, or if the frames of the previous
+  *         capture still hold the pool
+  */
+static int8_t RAW_Stream_Start(uint16_t frames)
+{
+  uint8_t mem0, mem1;
+
+  if(StreamState != RAW_STATE_IDLE)
+  {
+    return (USBD_FAIL);
+  }
+  mem0 = RAW_Stream_FreeFrame();
+  if(mem0 == RAW_NO_FRAME)
+  {
+    return (USBD_FAIL);
+  }
+  FrameState[mem0] = FRAME_CAPTURE;
+  mem1 = RAW_Stream_FreeFrame();
+  if(mem1 == RAW_NO_FRAME)
+  {
+    FrameState[mem0] = FRAME_FREE;
+    return (USBD_FAIL);
+  }
+  FrameState[mem1] = FRAME_CAPTURE;
+
+  StreamLeft = frames;
+  StreamCounted = (frames != 0);
+  StreamState = (TriggerMode == RAW_TRIGGER_NONE) ? RAW_STATE_RUNNING : RAW_STATE_ARMED;
+  LastValid = 0;
+
+  RAW_Capture_Start(RAW_SAMPLES(mem0), RAW_SAMPLES(mem1), RAW_STREAM_SAMPLES);
+  return (USBD_OK);
+}
+
+/**
+  * @brief  Stops the capture. The frames queued are still sent.
+  * @param  None
+  * @retval None
+  */
+static void RAW_Stream_Stop(void)
+{
+  uint8_t idx;
+
+  if(StreamState != RAW_STATE_IDLE)
+  {
+    RAW_Capture_Stop();
+    StreamState = RAW_STATE_IDLE;
+  }
+  for(idx = 0; idx < RAW_STREAM_FRAMES; idx++)
+  {
+    if(FrameState[idx] == FRAME_CAPTURE)
+    {
+      FrameState[idx] = FRAME_FREE;
+    }
+  }
+}
+
+/**
+  * @brief  Starts the transfer of the oldest frame queued, if the IN
+  *         endpoint is idle.
+  * @param  None
+  * @retval None
+  */
+static void RAW_Stream_Send(void)
+{
+  uint8_t idx;
+
+  while((FrameSending == RAW_NO_FRAME) && (QueueCount > 0))
+  {
+    idx = FrameQueue[QueueHead];
+    QueueHead = (QueueHead + 1) % RAW_STREAM_FRAMES;
+    QueueCount--;
+
+    if(USBD_VENDOR_Transmit(&USBD_Device, (uint8_t *)FrameBuffer[idx], RAW_STREAM_FRAME_SIZE) == USBD_OK)
+    {
+      FrameState[idx] = FRAME_SENDING;
+      FrameSending = idx;
+    }
+    else
+    {
+      /* Not configured any more */
+      FrameState[idx] = FRAME_FREE;
+      StreamDropped++;
+    }
+  }
+}
+
+/**
+  * @brief  Looks for a crossing of the trigger level.
+  * @param  samples: Samples of the frame
+  * @retval Index of the first sample past the level, RAW_FRAME_NO_TRIGGER if
+  *         none
+  */
+static uint16_t RAW_Stream_Trigger(const uint16_t *samples)
+{
+  uint16_t prev = LastValid ? LastSample : samples[0];
+  uint16_t idx;
+
+  for(idx = 0; idx < RAW_STREAM_SAMPLES; idx++)
+  {
+    if(((TriggerMode == RAW_TRIGGER_RISING) && (prev < TriggerLevel) && (samples[idx] >= TriggerLevel)) ||
+       ((TriggerMode == RAW_TRIGGER_FALLING) && (prev >= TriggerLevel) && (samples[idx] < TriggerLevel)))
+    {
+      return idx;
+    }
+    prev = samples[idx];
+  }
+  return RAW_FRAME_NO_TRIGGER;
+}
+
+/**
+  * @brief  Finds a free frame of the pool.
+  * @param  None
+  * @retval Index of the frame, RAW_NO_FRAME if none
+  */
+static uint8_t RAW_Stream_FreeFrame(void)
+{
+  uint8_t idx;
+
+  for(idx = 0; idx < RAW_STREAM_FRAMES; idx++)
+  {
+    if(FrameState[idx] == FRAME_FREE)
+    {
+      return idx;
+    }
+  }
+  return RAW_NO_FRAME;
+}
+
+/**
+  * @brief  End of a frame of the capture, called in its DMA interrupt: the
+  *         frame is queued for the PC, or dropped.
+  * @param  samples: Samples written, RAW_STREAM_SAMPLES
+  * @param  tick: Time in ms
+  * @retval Samples of the frame the DMA writes after the one it is writing
+  *         now: samples again if the frame is not sent.
+  */
+uint16_t *RAW_Stream_FrameCplt(uint16_t *samples, uint32_t tick)
+{
+  RAW_FrameHeaderTypeDef *header;
+  uint16_t trigger = RAW_FRAME_NO_TRIGGER;
+  uint8_t idx = ((uint8_t *)samples - (uint8_t *)FrameBuffer) / RAW_STREAM_FRAME_SIZE;
+  uint8_t next;
+
+  if(StreamState == RAW_STATE_IDLE)
+  {
+    /* Stopped by a request while the interrupt was pending */
+    return samples;
+  }
+
+  if(TriggerMode != RAW_TRIGGER_NONE)
+  {
+    trigger = RAW_Stream_Trigger(samples);
+    LastSample = samples[RAW_STREAM_SAMPLES - 1];
+    LastValid = 1;
+  }
+
+  if(StreamState == RAW_STATE_ARMED)
+  {
+    if(trigger == RAW_FRAME_NO_TRIGGER)
+    {
+      /* Nothing to send yet, not a drop */
+      return samples;
+    }
+    if(StreamCounted)
+    {
+      /* The frames following the trigger are sent whatever they hold */
+      StreamState = RAW_STATE_RUNNING;
+    }
+  }
+
+  next = RAW_Stream_FreeFrame();
+  if(next == RAW_NO_FRAME)
+  {
+    /* The PC is late: the sequence number shows the gap to the reader */
+    StreamSeq++;
+    StreamDropped++;
+  }
+  else
+  {
+    header = (RAW_FrameHeaderTypeDef *)FrameBuffer[idx];
+    header->magic       = RAW_FRAME_MAGIC;
+    header->seq         = StreamSeq++;
+    header->dropped     = StreamDropped;
+    header->sample_rate = StreamRate;
+    header->samples     = RAW_STREAM_SAMPLES;
+    header->packet      = VENDOR_DATA_FS_MAX_PACKET_SIZE;
+    header->length      = RAW_STREAM_FRAME_SIZE;
+    header->tick        = tick;
+    header->trigger     = trigger;
+    header->bits        = RAW_STREAM_BITS;
+
+    FrameState[idx] = FRAME_QUEUED;
+    FrameQueue[(QueueHead + QueueCount) % RAW_STREAM_FRAMES] = idx;
+    QueueCount++;
+    FrameState[next] = FRAME_CAPTURE;
+    samples = RAW_SAMPLES(next);
+    RAW_Stream_Send();
+  }
+
+  if(StreamCounted && (--StreamLeft == 0))
+  {
+    RAW_Stream_Stop();
+  }
+  return samples;
+}
+
+/**
+  * @brief  Counters of the stream since the configuration.
+  * @param  sent: Frames sent
+  * @param  dropped: Frames dropped
+  * @retval None
+  */
+void RAW_Stream_GetStats(uint32_t *sent, uint32_t *dropped)
+{
+  *sent = StreamSent;
+  *dropped = StreamDropped;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,222 @@
+/**
+  ******************************************************************************
+  * @file    ADC/ADC_RegularConversion_DMA/Src/usbd_storage.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Memory management layer of the MSC device: exports a FatFs disk
+  *          drive read-only, the capture log volume.
+  *
+  *          The drive stays mounted by the application, which keeps logging
+  *          while the PC reads: the sectors are read from the driver in the
+  *          USB interrupt, all the sectors of a packet of the class
+  *          (MSC_MEDIA_PACKET) in one call. The application masks the USB
+  *          interrupt while it updates the volume, so that the PC never
+  *          reads a sector half written. The PC keeps the FAT and directory
+  *          it has read: the rows logged after it mounted the drive show up
+  *          once the drive is plugged again.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "usbd_storage.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define STORAGE_LUN_NBR                  1
+
+/* Largest read of the drivers, in sectors */
+#define STORAGE_MAX_READ                 128
+
+/* Unit of the driver exported as the LUN 0 */
+#define STORAGE_DRV_UNIT                 0
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Drive exported, NULL until the application attaches it */
+static Diskio_drvTypeDef *StorageDrv = NULL;
+
+/* USB Mass storage Standard Inquiry Data */
+int8_t STORAGE_Inquirydata[] = { /* 36 */
+  /* LUN 0 */
+  0x00,
+  0x80,
+  0x02,
+  0x02,
+  (STANDARD_INQUIRY_DATA_LEN - 5),
+  0x00,
+  0x00,
+  0x00,
+  'S', 'T', 'M', ' ', ' ', ' ', ' ', ' ', /* Manufacturer: 8 bytes  */
+  'C', 'a', 'p', 't', 'u', 'r', 'e', ' ', /* Product     : 16 Bytes */
+  'L', 'o', 'g', ' ', ' ', ' ', ' ', ' ',
+  '1', '.', '0', '0',                     /* Version     : 4 Bytes  */
+};
+
+/* Private function prototypes -----------------------------------------------*/
+int8_t STORAGE_Init(uint8_t lun);
+int8_t STORAGE_GetCapacity(uint8_t lun, uint32_t *block_num, uint16_t *block_size);
+int8_t STORAGE_IsReady(uint8_t lun);
+int8_t STORAGE_IsWriteProtected(uint8_t lun);
+int8_t STORAGE_Read(uint8_t lun, uint8_t *buf, uint32_t blk_addr, uint16_t blk_len);
+int8_t STORAGE_Write(uint8_t lun, uint8_t *buf, uint32_t blk_addr, uint16_t blk_len);
+int8_t STORAGE_GetMaxLun(void);
+
+USBD_StorageTypeDef USBD_DISK_fops = {
+  STORAGE_Init,
+  STORAGE_GetCapacity,
+  STORAGE_IsReady,
+  STORAGE_IsWriteProtected,
+  STORAGE_Read,
+  STORAGE_Write,
+  STORAGE_GetMaxLun,
+  STORAGE_Inquirydata,
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Gives the drive to export. It is initialized by the mount of the
+  *         application, before the USB device is started.
+  * @param  drv: Disk I/O driver of the drive
+  * @retval None
+  */
+void STORAGE_Attach(Diskio_drvTypeDef *drv)
+{
+  StorageDrv = drv;
+}
+
+/**
+  * @brief  Initializes the storage unit (medium)
+  * @param  lun: Logical unit number
+  * @retval Status (0 : Ok / -1 : Error)
+  */
+int8_t STORAGE_Init(uint8_t lun)
+{
+  /* The drive belongs to FatFs, which has initialized it */
+  return (StorageDrv != NULL) ? 0 : -1;
+}
+
+/**
+  * @brief  Returns the medium capacity.
+  * @param  lun: Logical unit number
+  * @param  block_num: Number of total block number
+  * @param  block_size: Block size
+  * @retval Status (0: Ok / -1: Error)
+  */
+int8_t STORAGE_GetCapacity(uint8_t lun, uint32_t *block_num, uint16_t *block_size)
+{
+  DWORD sectors;
+  WORD size;
+
+  if((StorageDrv == NULL) ||
+     (StorageDrv->disk_ioctl(STORAGE_DRV_UNIT, GET_SECTOR_COUNT, &sectors) != RES_OK) ||
+     (StorageDrv->disk_ioctl(STORAGE_DRV_UNIT, GET_SECTOR_SIZE, &size) != RES_OK))
+  {
+    return -1;
+  }
+  *block_num = sectors;
+  *block_size = size;
+  return 0;
+}
+
+/**
+  * @brief  Checks whether the medium is ready.
+  * @param  lun: Logical unit number
+  * @retval Status (0: Ok / -1: Error)
+  */
+int8_t STORAGE_IsReady(uint8_t lun)
+{
+  if((StorageDrv == NULL) || (StorageDrv->disk_status(STORAGE_DRV_UNIT) & STA_NOINIT))
+  {
+    return -1;
+  }
+  return 0;
+}
+
+/**
+  * @brief  Checks whether the medium is write protected: always, the volume
+  *         is written by the application only.
+  * @param  lun: Logical unit number
+  * @retval Status (0: write enabled / -1: otherwise)
+  */
+int8_t STORAGE_IsWriteProtected(uint8_t lun)
+{
+  return -1;
+}
+
+/**
+  * @brief  Reads data from the medium, all the blocks in one read of the
+  *         driver when it can take them.
+  * @param  lun: Logical unit number
+  * @param  buf: Receives the data
+  * @param  blk_addr: Logical block address
+  * @param  blk_len: Blocks number
+  * @retval Status (0: Ok / -1: Error)
+  */
+int8_t STORAGE_Read(uint8_t lun, uint8_t *buf, uint32_t blk_addr, uint16_t blk_len)
+{
+  WORD size;
+  BYTE count;
+
+  if((StorageDrv == NULL) || (StorageDrv->disk_ioctl(STORAGE_DRV_UNIT, GET_SECTOR_SIZE, &size) != RES_OK))
+  {
+    return -1;
+  }
+
+  while(blk_len > 0)
+  {
+    count = (blk_len < STORAGE_MAX_READ) ? blk_len : STORAGE_MAX_READ;
+    if(StorageDrv->disk_read(STORAGE_DRV_UNIT, buf, blk_addr, count) != RES_OK)
+    {
+      return -1;
+    }
+    buf += (uint32_t)count * size;
+    blk_addr += count;
+    blk_len -= count;
+  }
+  return 0;
+}
+
+/**
+  * @brief  Writes data into the medium: refused, the medium is write
+  *         protected.
+  * @param  lun: Logical unit number
+  * @param  buf: Data to write
+  * @param  blk_addr: Logical block address
+  * @param  blk_len: Blocks number
+  * @retval Status (0 : Ok / -1 : Error)
+  */
+int8_t STORAGE_Write(uint8_t lun, uint8_t *buf, uint32_t blk_addr, uint16_t blk_len)
+{
+  return -1;
+}
+
+/**
+  * @brief  Returns the Max Supported LUNs.
+  * @param  None
+  * @retval Lun(s) number
+  */
+int8_t STORAGE_GetMaxLun(void)
+{
+  return(STORAGE_LUN_NBR - 1);
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -31,7 +31,7 @@
 
 HCD_HandleTypeDef hhcd;
 
-#define HOST_POWERSW_CLK_ENABLE()          __HAL_RCC_GPIOC_CLK_ENABLE()
+#define HOST_POWERSW_CLK_ENABLE()          __GPIOC_CLK_ENABLE()
 #define HOST_POWERSW_PORT                  GPIOC
 #define HOST_POWERSW_VBUS                  GPIO_PIN_0
 
@@ -51,7 +51,7 @@ void HAL_HCD_MspInit(HCD_HandleTypeDef *hhcd)
   if(hhcd->Instance == USB_OTG_FS)
   {
     /* Configure USB FS GPIOs */
-    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __GPIOA_CLK_ENABLE();
     HOST_POWERSW_CLK_ENABLE();
     
     /* Configure DM DP Pins */
@@ -76,7 +76,7 @@ void HAL_HCD_MspInit(HCD_HandleTypeDef *hhcd)
     HAL_GPIO_Init(HOST_POWERSW_PORT, &GPIO_InitStruct);
     
     /* Enable USB FS Clocks */ 
-    __HAL_RCC_USB_OTG_FS_CLK_ENABLE();
+    __USB_OTG_FS_CLK_ENABLE();
     
     /* Set USBFS Interrupt to the lowest priority */
     HAL_NVIC_SetPriority(OTG_FS_IRQn, 5, 0);
@@ -95,7 +95,7 @@ void HAL_HCD_MspDeInit(HCD_HandleTypeDef *hhcd)
   if(hhcd->Instance == USB_OTG_FS)
   {  
     /* Disable USB FS Clocks */ 
-    __HAL_RCC_USB_OTG_FS_CLK_DISABLE();
+    __USB_OTG_FS_CLK_DISABLE();
   }
 }
 
@@ -113,6 +113,23 @@ void HAL_HCD_SOF_Callback(HCD_HandleTypeDef *hhcd)
   USBH_LL_IncTimer (hhcd->pData);
 }
 
+/**
+  * @brief  SysTick callback.
+  *         The port sends no SOF while it is disabled: the 1 ms tick runs the
+  *         Host timer then, for the debounce of the connection.
+  * @param  None
+  * @retval None
+  */
+void HAL_SYSTICK_Callback(void)
+{
+  USB_OTG_GlobalTypeDef *USBx = hhcd.Instance;
+  
+  if((hhcd.pData != NULL) && ((USBx_HPRT0 & USB_OTG_HPRT_PENA) == 0))
+  {
+    USBH_LL_IncTimer (hhcd.pData);
+  }
+}
+
 /**
   * @brief  Connect callback.
   * @param  hhcd: HCD handle
@@ -142,7 +159,10 @@ void HAL_HCD_Disconnect_Callback(HCD_HandleTypeDef *hhcd)
   */
 void HAL_HCD_HC_NotifyURBChange_Callback(HCD_HandleTypeDef *hhcd, uint8_t chnum, HCD_URBStateTypeDef urb_state)
 {
-  /* To be used with OS to sync URB state with the global state machine */
+#if (USBH_USE_OS == 1)
+  /* Wake the host task, which waits for the URB events */
+  USBH_LL_NotifyURBChange(hhcd->pData);
+#endif
 }
 
 /*******************************************************************************
@@ -387,7 +407,8 @@ USBH_StatusTypeDef USBH_LL_DriverVBUS(USBH_HandleTypeDef *phost, uint8_t state)
     HAL_GPIO_WritePin(GPIOC, GPIO_PIN_0, GPIO_PIN_RESET);
   }
   
-  HAL_Delay(200);
+  /* No wait here: the host core debounces the connection and waits after
+     VBUS off on its own Host timer */
   return USBH_OK;  
 }
 
@@ -433,13 +454,18 @@ uint8_t USBH_LL_GetToggle(USBH_HandleTypeDef *phost, uint8_t pipe)
 }
 
 /**
-  * @brief  Delay routine for the USB Host Library
+  * @brief  Delay routine for the USB Host Library, with USBH_USE_OS the
+  *         calling thread is blocked and the other ones run
   * @param  Delay: Delay in ms
   * @retval None
   */
 void USBH_Delay(uint32_t Delay)
 {
+#if (USBH_USE_OS == 1)
+  osDelay(Delay);
+#else
   HAL_Delay(Delay);  
+#endif
 }
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
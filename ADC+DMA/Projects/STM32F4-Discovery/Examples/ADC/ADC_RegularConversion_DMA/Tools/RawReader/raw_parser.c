@@ -0,0 +1,231 @@
+/**
+  ******************************************************************************
+  * @file    ADC/ADC_RegularConversion_DMA/Tools/RawReader/raw_parser.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Splits the bulk IN stream of the raw sample streaming in
+  *          frames.
+  *
+  *          The frames are found by their header, so that a recorded stream
+  *          can be read from any point. The gaps in the sequence numbers are
+  *          counted, apart from those the device reports as dropped. The
+  *          samples are checked against the resolution of the header.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "raw_parser.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+#define RD16(p)   ((uint16_t)((p)[0] | ((p)[1] << 8)))
+#define RD32(p)   ((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8) | \
+                   ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24))
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t RAW_ReadHeader(const uint8_t *p, RAW_FrameHeaderTypeDef *header);
+static void    RAW_Frame(RAW_ParserTypeDef *parser, const RAW_FrameHeaderTypeDef *header);
+static void    RAW_Skip(RAW_ParserTypeDef *parser, uint32_t n);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Decodes and checks a frame header.
+  * @param  p: RAW_FRAME_HEADER_SIZE bytes of the stream
+  * @param  header: Receives the header
+  * @retval 1 if the header is valid
+  */
+static uint8_t RAW_ReadHeader(const uint8_t *p, RAW_FrameHeaderTypeDef *header)
+{
+  header->magic       = RD32(p);
+  header->seq         = RD32(p + 4);
+  header->dropped     = RD32(p + 8);
+  header->sample_rate = RD32(p + 12);
+  header->samples     = RD16(p + 16);
+  header->packet      = RD16(p + 18);
+  header->length      = RD32(p + 20);
+  header->tick        = RD32(p + 24);
+  header->trigger     = RD16(p + 28);
+  header->bits        = RD16(p + 30);
+
+  if((header->magic != RAW_FRAME_MAGIC) ||
+     (header->samples == 0) || (header->samples > RAW_PARSER_MAX_SAMPLES) ||
+     (header->packet < 8) || (header->packet > RAW_PARSER_MAX_PACKET) ||
+     ((header->packet & (header->packet - 1)) != 0) ||
+     (header->bits == 0) || (header->bits > 16) ||
+     ((header->trigger != RAW_FRAME_NO_TRIGGER) && (header->trigger >= header->samples)))
+  {
+    return 0;
+  }
+  return (header->length == RAW_FRAME_SIZE(header->samples, header->packet)) ? 1 : 0;
+}
+
+/**
+  * @brief  Counts and delivers the complete frame at the start of the buffer.
+  * @param  parser: Parser
+  * @param  header: Its header
+  * @retval None
+  */
+static void RAW_Frame(RAW_ParserTypeDef *parser, const RAW_FrameHeaderTypeDef *header)
+{
+  const uint8_t *p = parser->buff + RAW_FRAME_HEADER_SIZE;
+  uint32_t end = RAW_FRAME_HEADER_SIZE + 2 * header->samples;
+  uint32_t i, gap;
+
+  for(i = end; i < header->length; i++)
+  {
+    if(parser->buff[i] != 0)
+    {
+      /* Not a frame: a header found in the samples of another one */
+      parser->errors++;
+      RAW_Skip(parser, 1);
+      return;
+    }
+  }
+  for(i = 0; i < header->samples; i++, p += 2)
+  {
+    parser->samples[i] = RD16(p);
+    if((header->bits < 16) && (parser->samples[i] >> header->bits))
+    {
+      parser->errors++;
+      RAW_Skip(parser, 1);
+      return;
+    }
+  }
+
+  if(parser->synced)
+  {
+    gap = header->seq - parser->next_seq;
+    if((int32_t)gap < 0)
+    {
+      /* Sequence restarted by a new configuration of the device */
+      parser->restarts++;
+    }
+    else
+    {
+      parser->missed += gap;
+      parser->dropped += header->dropped - parser->last_dropped;
+    }
+  }
+  parser->synced = 1;
+  parser->next_seq = header->seq + 1;
+  parser->last_dropped = header->dropped;
+  parser->frames++;
+  if(header->trigger != RAW_FRAME_NO_TRIGGER)
+  {
+    parser->triggered++;
+  }
+
+  if(parser->callback != NULL)
+  {
+    parser->callback(header, parser->samples, parser->context);
+  }
+
+  RAW_Skip(parser, header->length);
+}
+
+/**
+  * @brief  Removes bytes from the start of the buffer.
+  * @param  parser: Parser
+  * @param  n: Number of bytes
+  * @retval None
+  */
+static void RAW_Skip(RAW_ParserTypeDef *parser, uint32_t n)
+{
+  memmove(parser->buff, parser->buff + n, parser->fill - n);
+  parser->fill -= n;
+}
+
+/**
+  * @brief  Initializes a parser.
+  * @param  parser: Parser
+  * @param  callback: Function called for each frame, may be NULL
+  * @param  context: Passed to the callback
+  * @retval None
+  */
+void RAW_ParserInit(RAW_ParserTypeDef *parser, RAW_FrameCallbackTypeDef callback, void *context)
+{
+  memset(parser, 0, sizeof(*parser));
+  parser->callback = callback;
+  parser->context = context;
+}
+
+/**
+  * @brief  Feeds bytes read from the endpoint, the complete frames are
+  *         delivered.
+  * @param  parser: Parser
+  * @param  data: Bytes read
+  * @param  length: Number of bytes
+  * @retval None
+  */
+void RAW_Parse(RAW_ParserTypeDef *parser, const uint8_t *data, uint32_t length)
+{
+  RAW_FrameHeaderTypeDef header;
+  const uint8_t *magic;
+  uint32_t n, i;
+
+  parser->bytes += length;
+
+  while(length > 0)
+  {
+    n = sizeof(parser->buff) - parser->fill;
+    n = (length < n) ? length : n;
+    memcpy(parser->buff + parser->fill, data, n);
+    parser->fill += n;
+    data += n;
+    length -= n;
+
+    while(parser->fill >= RAW_FRAME_HEADER_SIZE)
+    {
+      if(RAW_ReadHeader(parser->buff, &header) == 0)
+      {
+        /* Out of sync: on to the next magic number */
+        if(header.magic == RAW_FRAME_MAGIC)
+        {
+          parser->errors++;
+        }
+        magic = NULL;
+        for(i = 1; i + 4 <= parser->fill; i++)
+        {
+          if(RD32(parser->buff + i) == RAW_FRAME_MAGIC)
+          {
+            magic = parser->buff + i;
+            break;
+          }
+        }
+        i = (magic != NULL) ? (uint32_t)(magic - parser->buff) : parser->fill - 3;
+        parser->skipped += i;
+        RAW_Skip(parser, i);
+        continue;
+      }
+      if(parser->fill < header.length)
+      {
+        break;
+      }
+      RAW_Frame(parser, &header);
+    }
+  }
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
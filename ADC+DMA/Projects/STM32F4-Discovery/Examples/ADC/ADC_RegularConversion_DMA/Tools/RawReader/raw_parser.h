@@ -0,0 +1,83 @@
+/**
+  ******************************************************************************
+  * @file    ADC/ADC_RegularConversion_DMA/Tools/RawReader/raw_parser.h
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Header for raw_parser.c file.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __RAW_PARSER_H
+#define __RAW_PARSER_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "raw_frame.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define RAW_PARSER_MAX_SAMPLES          16384
+#define RAW_PARSER_MAX_PACKET           1024
+#define RAW_PARSER_BUFFER_SIZE          \
+  (RAW_FRAME_HEADER_SIZE + 2 * RAW_PARSER_MAX_SAMPLES + RAW_PARSER_MAX_PACKET)
+
+/* Exported types ------------------------------------------------------------*/
+/* Called for each valid frame, the samples are in the host byte order */
+typedef void (*RAW_FrameCallbackTypeDef)(const RAW_FrameHeaderTypeDef *header,
+                                         const uint16_t *samples, void *context);
+
+/**
+  * @brief  State and counters of a reader of the bulk IN stream
+  */
+typedef struct
+{
+  uint8_t  buff[RAW_PARSER_BUFFER_SIZE];
+  uint16_t samples[RAW_PARSER_MAX_SAMPLES];
+  uint32_t fill;
+  uint8_t  synced;          /*!< A frame was received, next_seq is valid               */
+  uint32_t next_seq;
+  uint32_t last_dropped;    /*!< Dropped counter of the last frame                     */
+  uint64_t bytes;           /*!< Bytes received                                        */
+  uint32_t frames;          /*!< Valid frames                                          */
+  uint32_t triggered;       /*!< Of the frames, those holding a trigger                */
+  uint32_t missed;          /*!< Frames missing in the sequence numbers                */
+  uint32_t dropped;         /*!< Of the missed frames, those dropped by the device     */
+  uint32_t restarts;        /*!< The device restarted its sequence (new configuration) */
+  uint32_t skipped;         /*!< Bytes skipped to find the start of a frame            */
+  uint32_t errors;          /*!< Invalid headers, samples out of range, padding not zero */
+  RAW_FrameCallbackTypeDef callback;
+  void     *context;
+}RAW_ParserTypeDef;
+
+/* Exported functions ------------------------------------------------------- */
+void RAW_ParserInit(RAW_ParserTypeDef *parser, RAW_FrameCallbackTypeDef callback, void *context);
+void RAW_Parse(RAW_ParserTypeDef *parser, const uint8_t *data, uint32_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RAW_PARSER_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
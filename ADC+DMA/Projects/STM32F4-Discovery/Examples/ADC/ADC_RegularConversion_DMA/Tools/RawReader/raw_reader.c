@@ -0,0 +1,448 @@
+/**
+  ******************************************************************************
+  * @file    ADC/ADC_RegularConversion_DMA/Tools/RawReader/raw_reader.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Reader of the raw samples streamed by the board on its USB vendor
+  *          interface, for Linux: the usbfs device of the board is driven
+  *          with its ioctls, no USB library is needed.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <linux/usbdevice_fs.h>
+#include "raw_parser.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define READ_SIZE       16384
+#define RAW_VID         0x0483
+#define RAW_PID         0x5721
+#define RAW_INTERFACE   0
+#define RAW_IN_EP       0x81
+#define TIMEOUT_MS      1000
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static RAW_ParserTypeDef Parser;
+static FILE *Csv = NULL;
+static FILE *Record = NULL;
+static volatile sig_atomic_t Stop = 0;
+
+/* Last frame */
+static uint32_t LastRate = 0;
+static uint16_t LastMin = 0, LastMax = 0;
+
+/* Private function prototypes -----------------------------------------------*/
+static void   OnFrame(const RAW_FrameHeaderTypeDef *header, const uint16_t *samples, void *context);
+static void   OnSignal(int sig);
+static int    OpenDevice(const char *path, uint8_t *usb);
+static int    Request(int fd, uint8_t bmRequest, uint8_t bRequest, uint16_t wValue,
+                      uint16_t wLength, void *data);
+static int    Configure(int fd, uint32_t rate, uint8_t mode, uint16_t level, uint16_t frames);
+static double Now(void);
+static void   Report(double elapsed, double interval, uint64_t bytes, uint32_t frames);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Frame callback of the parser: CSV row and range of the samples.
+  * @param  header: Frame header
+  * @param  samples: ADC codes
+  * @param  context: Not used
+  * @retval None
+  */
+static void OnFrame(const RAW_FrameHeaderTypeDef *header, const uint16_t *samples, void *context)
+{
+  uint32_t i;
+
+  LastMin = LastMax = samples[0];
+  for(i = 1; i < header->samples; i++)
+  {
+    LastMin = (samples[i] < LastMin) ? samples[i] : LastMin;
+    LastMax = (samples[i] > LastMax) ? samples[i] : LastMax;
+  }
+  LastRate = header->sample_rate;
+
+  if(Csv != NULL)
+  {
+    fprintf(Csv, "%u,%u,%u,%d", header->seq, header->sample_rate, header->tick,
+            (header->trigger == RAW_FRAME_NO_TRIGGER) ? -1 : (int)header->trigger);
+    for(i = 0; i < header->samples; i++)
+    {
+      fprintf(Csv, ",%u", samples[i]);
+    }
+    fputc('\n', Csv);
+  }
+}
+
+/**
+  * @brief  Ends the reading on Ctrl-C.
+  * @param  sig: Signal number
+  * @retval None
+  */
+static void OnSignal(int sig)
+{
+  Stop = 1;
+}
+
+/**
+  * @brief  Opens the usbfs device of the board and claims its interface.
+  *         Any other file is read as it is, for a recorded stream.
+  * @param  path: /dev/bus/usb/BBB/DDD, a file, or "-" for the standard input
+  * @param  usb: Receives 1 for the board
+  * @retval File descriptor, -1 on error
+  */
+static int OpenDevice(const char *path, uint8_t *usb)
+{
+  uint8_t desc[18];
+  unsigned int itf = RAW_INTERFACE;
+  struct stat st;
+  int fd;
+
+  *usb = 0;
+  if(strcmp(path, "-") == 0)
+  {
+    return STDIN_FILENO;
+  }
+
+  fd = open(path, O_RDWR);
+  if((fd < 0) && ((errno == EACCES) || (errno == EROFS)))
+  {
+    /* A recorded stream the user cannot write */
+    fd = open(path, O_RDONLY);
+  }
+  if(fd < 0)
+  {
+    fprintf(stderr, "%s: %s\n", path, strerror(errno));
+    return -1;
+  }
+  if((fstat(fd, &st) != 0) || !S_ISCHR(st.st_mode))
+  {
+    return fd;
+  }
+
+  /* usbfs gives the device descriptor first */
+  if((read(fd, desc, sizeof(desc)) != sizeof(desc)) ||
+     ((desc[8] | (desc[9] << 8)) != RAW_VID) || ((desc[10] | (desc[11] << 8)) != RAW_PID))
+  {
+    fprintf(stderr, "%s: not the raw stream device %04X:%04X\n", path, RAW_VID, RAW_PID);
+    close(fd);
+    return -1;
+  }
+  if(ioctl(fd, USBDEVFS_CLAIMINTERFACE, &itf) != 0)
+  {
+    fprintf(stderr, "%s: claim interface: %s\n", path, strerror(errno));
+    close(fd);
+    return -1;
+  }
+  *usb = 1;
+  return fd;
+}
+
+/**
+  * @brief  Vendor request to the interface.
+  * @param  fd: usbfs device
+  * @param  bmRequest: 0x41 (OUT) or 0xC1 (IN)
+  * @param  bRequest, wValue, wLength: Request
+  * @param  data: Data of an IN request
+  * @retval Bytes received, -1 if the device STALLed the request
+  */
+static int Request(int fd, uint8_t bmRequest, uint8_t bRequest, uint16_t wValue,
+                   uint16_t wLength, void *data)
+{
+  struct usbdevfs_ctrltransfer ctrl;
+
+  ctrl.bRequestType = bmRequest;
+  ctrl.bRequest = bRequest;
+  ctrl.wValue = wValue;
+  ctrl.wIndex = RAW_INTERFACE;
+  ctrl.wLength = wLength;
+  ctrl.timeout = TIMEOUT_MS;
+  ctrl.data = data;
+  return ioctl(fd, USBDEVFS_CONTROL, &ctrl);
+}
+
+/**
+  * @brief  Stops the capture of a previous run, sets the rate and the
+  *         trigger, then starts the capture.
+  * @param  fd: usbfs device
+  * @param  rate: Sample rate in Hz, 0 to keep the one set
+  * @param  mode, level: Trigger
+  * @param  frames: Frames to capture, 0 until the end of the reading
+  * @retval 0, -1 on error
+  */
+static int Configure(int fd, uint32_t rate, uint8_t mode, uint16_t level, uint16_t frames)
+{
+  uint8_t status[RAW_STATUS_SIZE];
+  uint8_t flush[READ_SIZE];
+  struct usbdevfs_bulktransfer bulk;
+
+  if(Request(fd, 0x41, RAW_REQ_STOP, 0, 0, NULL) < 0)
+  {
+    fprintf(stderr, "stop: %s\n", strerror(errno));
+    return -1;
+  }
+
+  /* The frames of the previous run still queued */
+  bulk.ep = RAW_IN_EP;
+  bulk.len = sizeof(flush);
+  bulk.timeout = 100;
+  bulk.data = flush;
+  while(ioctl(fd, USBDEVFS_BULK, &bulk) > 0)
+  {
+  }
+
+  if((rate != 0) && (Request(fd, 0x41, RAW_REQ_SET_RATE, (uint16_t)((rate + 99) / 100), 0, NULL) < 0))
+  {
+    fprintf(stderr, "rate %u Hz refused\n", rate);
+    return -1;
+  }
+  if(Request(fd, 0x41, RAW_REQ_SET_TRIGGER, RAW_TRIGGER_VALUE(mode, level), 0, NULL) < 0)
+  {
+    fprintf(stderr, "trigger refused\n");
+    return -1;
+  }
+  if(Request(fd, 0xC1, RAW_REQ_GET_STATUS, 0, sizeof(status), status) != sizeof(status))
+  {
+    fprintf(stderr, "status: %s\n", strerror(errno));
+    return -1;
+  }
+  printf("sample rate %u Hz, trigger %s at %u\n",
+         status[0] | (status[1] << 8) | (status[2] << 16) | ((uint32_t)status[3] << 24),
+         (status[5] == RAW_TRIGGER_RISING) ? "rising" :
+         (status[5] == RAW_TRIGGER_FALLING) ? "falling" : "none", status[6] | (status[7] << 8));
+
+  if(Request(fd, 0x41, RAW_REQ_START, frames, 0, NULL) < 0)
+  {
+    fprintf(stderr, "start: %s\n", strerror(errno));
+    return -1;
+  }
+  return 0;
+}
+
+/**
+  * @brief  Monotonic time.
+  * @param  None
+  * @retval Time in s
+  */
+static double Now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+  * @brief  Prints a line of statistics.
+  * @param  elapsed: Time since the start, in s
+  * @param  interval: Time since the last line, in s
+  * @param  bytes: Bytes received in the interval
+  * @param  frames: Frames received in the interval
+  * @retval None
+  */
+static void Report(double elapsed, double interval, uint64_t bytes, uint32_t frames)
+{
+  printf("%7.1f s %7.1f frames/s %6.3f MB/s  frames %u  triggered %u  dropped by the device %u"
+         "  lost %u  skipped %u bytes  errors %u  %u Hz, codes %u-%u\n",
+         elapsed, frames / interval, bytes / interval / 1e6,
+         Parser.frames, Parser.triggered, Parser.dropped, Parser.missed - Parser.dropped,
+         Parser.skipped, Parser.errors, LastRate, LastMin, LastMax);
+  fflush(stdout);
+}
+
+/**
+  * @brief  Main program.
+  * @param  argc, argv: raw_reader [-r Hz] [-T rising|falling:level]
+  *         [-n frames] [-t s] [-o file.csv] [-w file] device
+  * @retval 0, 1 on error
+  */
+int main(int argc, char **argv)
+{
+  static const char usage[] = "usage: %s [-r rate_Hz] [-T rising|falling:level] [-n frames] [-t seconds]"
+                              " [-o file.csv] [-w file] device\n";
+  static uint8_t buff[READ_SIZE];
+  struct usbdevfs_bulktransfer bulk;
+  const char *csv = NULL, *record = NULL;
+  uint32_t rate = 0, max_frames = 0, last_frames = 0;
+  uint16_t level = 0;
+  uint8_t  mode = RAW_TRIGGER_NONE, usb;
+  double max_time = 0, start, last, t;
+  uint64_t last_bytes = 0;
+  char *sep;
+  int opt, fd, n;
+
+  while((opt = getopt(argc, argv, "r:T:n:t:o:w:")) != -1)
+  {
+    switch(opt)
+    {
+    case 'r': rate = strtoul(optarg, NULL, 0); break;
+    case 'n': max_frames = strtoul(optarg, NULL, 0); break;
+    case 't': max_time = atof(optarg); break;
+    case 'o': csv = optarg; break;
+    case 'w': record = optarg; break;
+    case 'T':
+      sep = strchr(optarg, ':');
+      mode = (strncmp(optarg, "rising", 6) == 0) ? RAW_TRIGGER_RISING :
+             (strncmp(optarg, "falling", 7) == 0) ? RAW_TRIGGER_FALLING : RAW_TRIGGER_NONE;
+      level = (sep != NULL) ? (uint16_t)strtoul(sep + 1, NULL, 0) : 2048;
+      if((mode == RAW_TRIGGER_NONE) || (level > 0x0FFF))
+      {
+        fprintf(stderr, usage, argv[0]);
+        return 1;
+      }
+      break;
+    default:
+      fprintf(stderr, usage, argv[0]);
+      return 1;
+    }
+  }
+  if((optind != argc - 1) || (max_frames > 0xFFFF))
+  {
+    fprintf(stderr, usage, argv[0]);
+    return 1;
+  }
+
+  if(csv != NULL)
+  {
+    Csv = fopen(csv, "w");
+    if(Csv == NULL)
+    {
+      fprintf(stderr, "%s: %s\n", csv, strerror(errno));
+      return 1;
+    }
+  }
+  if(record != NULL)
+  {
+    Record = fopen(record, "wb");
+    if(Record == NULL)
+    {
+      fprintf(stderr, "%s: %s\n", record, strerror(errno));
+      return 1;
+    }
+  }
+
+  fd = OpenDevice(argv[optind], &usb);
+  if(fd < 0)
+  {
+    return 1;
+  }
+  if(usb && (Configure(fd, rate, mode, level, (uint16_t)max_frames) != 0))
+  {
+    close(fd);
+    return 1;
+  }
+
+  signal(SIGINT, OnSignal);
+  RAW_ParserInit(&Parser, OnFrame, NULL);
+  start = last = Now();
+
+  while(!Stop)
+  {
+    if(usb)
+    {
+      /* The frames are whole packets: a read ends on a frame or fills the
+         buffer */
+      bulk.ep = RAW_IN_EP;
+      bulk.len = sizeof(buff);
+      bulk.timeout = TIMEOUT_MS;
+      bulk.data = buff;
+      n = ioctl(fd, USBDEVFS_BULK, &bulk);
+      if((n < 0) && (errno == ETIMEDOUT))
+      {
+        /* Waiting for the trigger */
+        n = 0;
+      }
+    }
+    else
+    {
+      n = read(fd, buff, sizeof(buff));
+      if(n == 0)
+      {
+        /* End of a recorded stream */
+        break;
+      }
+    }
+    if(n < 0)
+    {
+      if(errno == EINTR)
+      {
+        continue;
+      }
+      fprintf(stderr, "read: %s\n", strerror(errno));
+      break;
+    }
+    if(Record != NULL)
+    {
+      fwrite(buff, 1, n, Record);
+    }
+    RAW_Parse(&Parser, buff, (uint32_t)n);
+
+    t = Now();
+    if(t - last >= 1.0)
+    {
+      Report(t - start, t - last, Parser.bytes - last_bytes, Parser.frames - last_frames);
+      last = t;
+      last_bytes = Parser.bytes;
+      last_frames = Parser.frames;
+    }
+    if(((max_frames != 0) && (Parser.frames >= max_frames)) ||
+       ((max_time != 0) && (t - start >= max_time)))
+    {
+      break;
+    }
+  }
+
+  t = Now();
+  printf("total:\n");
+  Report(t - start, (t > start) ? t - start : 1, Parser.bytes, Parser.frames);
+
+  if(usb)
+  {
+    Request(fd, 0x41, RAW_REQ_STOP, 0, 0, NULL);
+  }
+  if(Csv != NULL)
+  {
+    fclose(Csv);
+  }
+  if(Record != NULL)
+  {
+    fclose(Record);
+  }
+  if(fd != STDIN_FILENO)
+  {
+    close(fd);
+  }
+  return (Parser.errors != 0) ? 1 : 0;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,221 @@
+/**
+  ******************************************************************************
+  * @file    ADC/ADC_RegularConversion_DMA/Tools/SpectrumReader/spectrum_parser.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Splits the byte stream of the CDC port in spectrum frames.
+  *
+  *          The frames are found by their header, so that the reader can
+  *          start in the middle of the stream and recover from bytes lost by
+  *          the serial driver of the PC. The gaps in the sequence numbers
+  *          are counted, apart from those the device reports as dropped.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "spectrum_parser.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+#define RD16(p)   ((uint16_t)((p)[0] | ((p)[1] << 8)))
+#define RD32(p)   ((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8) | \
+                   ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24))
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t SPECTRUM_ReadHeader(const uint8_t *p, SPECTRUM_FrameHeaderTypeDef *header);
+static void    SPECTRUM_Frame(SPECTRUM_ParserTypeDef *parser, const SPECTRUM_FrameHeaderTypeDef *header);
+static void    SPECTRUM_Skip(SPECTRUM_ParserTypeDef *parser, uint32_t n);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Decodes and checks a frame header.
+  * @param  p: SPECTRUM_FRAME_HEADER_SIZE bytes of the stream
+  * @param  header: Receives the header
+  * @retval 1 if the header is valid
+  */
+static uint8_t SPECTRUM_ReadHeader(const uint8_t *p, SPECTRUM_FrameHeaderTypeDef *header)
+{
+  header->magic       = RD32(p);
+  header->seq         = RD32(p + 4);
+  header->dropped     = RD32(p + 8);
+  header->sample_rate = RD32(p + 12);
+  header->bins        = RD16(p + 16);
+  header->packet      = RD16(p + 18);
+  header->length      = RD32(p + 20);
+
+  if((header->magic != SPECTRUM_FRAME_MAGIC) ||
+     (header->bins == 0) || (header->bins > SPECTRUM_PARSER_MAX_BINS) ||
+     (header->packet < 8) || (header->packet > SPECTRUM_PARSER_MAX_PACKET) ||
+     ((header->packet & (header->packet - 1)) != 0))
+  {
+    return 0;
+  }
+  return (header->length == SPECTRUM_FRAME_SIZE(header->bins, header->packet)) ? 1 : 0;
+}
+
+/**
+  * @brief  Counts and delivers the complete frame at the start of the buffer.
+  * @param  parser: Parser
+  * @param  header: Its header
+  * @retval None
+  */
+static void SPECTRUM_Frame(SPECTRUM_ParserTypeDef *parser, const SPECTRUM_FrameHeaderTypeDef *header)
+{
+  const uint8_t *p = parser->buff + SPECTRUM_FRAME_HEADER_SIZE;
+  uint32_t end = SPECTRUM_FRAME_HEADER_SIZE + 4 * header->bins;
+  uint32_t i, gap;
+  union
+  {
+    uint32_t u;
+    float    f;
+  }value;
+
+  for(i = end; i < header->length; i++)
+  {
+    if(parser->buff[i] != 0)
+    {
+      /* Not a frame: a header found in the data of another one */
+      parser->errors++;
+      SPECTRUM_Skip(parser, 1);
+      return;
+    }
+  }
+
+  if(parser->synced)
+  {
+    gap = header->seq - parser->next_seq;
+    if((int32_t)gap < 0)
+    {
+      /* Sequence restarted by a new configuration of the device */
+      parser->restarts++;
+    }
+    else
+    {
+      parser->missed += gap;
+      parser->dropped += header->dropped - parser->last_dropped;
+    }
+  }
+  parser->synced = 1;
+  parser->next_seq = header->seq + 1;
+  parser->last_dropped = header->dropped;
+  parser->frames++;
+
+  if(parser->callback != NULL)
+  {
+    for(i = 0; i < header->bins; i++, p += 4)
+    {
+      value.u = RD32(p);
+      parser->bins[i] = value.f;
+    }
+    parser->callback(header, parser->bins, parser->context);
+  }
+
+  SPECTRUM_Skip(parser, header->length);
+}
+
+/**
+  * @brief  Removes bytes from the start of the buffer.
+  * @param  parser: Parser
+  * @param  n: Number of bytes
+  * @retval None
+  */
+static void SPECTRUM_Skip(SPECTRUM_ParserTypeDef *parser, uint32_t n)
+{
+  memmove(parser->buff, parser->buff + n, parser->fill - n);
+  parser->fill -= n;
+}
+
+/**
+  * @brief  Initializes a parser.
+  * @param  parser: Parser
+  * @param  callback: Function called for each frame, may be NULL
+  * @param  context: Passed to the callback
+  * @retval None
+  */
+void SPECTRUM_ParserInit(SPECTRUM_ParserTypeDef *parser,
+                         SPECTRUM_FrameCallbackTypeDef callback, void *context)
+{
+  memset(parser, 0, sizeof(*parser));
+  parser->callback = callback;
+  parser->context = context;
+}
+
+/**
+  * @brief  Feeds bytes read from the port, the complete frames are delivered.
+  * @param  parser: Parser
+  * @param  data: Bytes read
+  * @param  length: Number of bytes
+  * @retval None
+  */
+void SPECTRUM_Parse(SPECTRUM_ParserTypeDef *parser, const uint8_t *data, uint32_t length)
+{
+  SPECTRUM_FrameHeaderTypeDef header;
+  const uint8_t *magic;
+  uint32_t n, i;
+
+  parser->bytes += length;
+
+  while(length > 0)
+  {
+    n = sizeof(parser->buff) - parser->fill;
+    n = (length < n) ? length : n;
+    memcpy(parser->buff + parser->fill, data, n);
+    parser->fill += n;
+    data += n;
+    length -= n;
+
+    while(parser->fill >= SPECTRUM_FRAME_HEADER_SIZE)
+    {
+      if(SPECTRUM_ReadHeader(parser->buff, &header) == 0)
+      {
+        /* Out of sync: on to the next magic number */
+        if(header.magic == SPECTRUM_FRAME_MAGIC)
+        {
+          parser->errors++;
+        }
+        magic = NULL;
+        for(i = 1; i + 4 <= parser->fill; i++)
+        {
+          if(RD32(parser->buff + i) == SPECTRUM_FRAME_MAGIC)
+          {
+            magic = parser->buff + i;
+            break;
+          }
+        }
+        i = (magic != NULL) ? (uint32_t)(magic - parser->buff) : parser->fill - 3;
+        parser->skipped += i;
+        SPECTRUM_Skip(parser, i);
+        continue;
+      }
+      if(parser->fill < header.length)
+      {
+        break;
+      }
+      SPECTRUM_Frame(parser, &header);
+    }
+  }
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
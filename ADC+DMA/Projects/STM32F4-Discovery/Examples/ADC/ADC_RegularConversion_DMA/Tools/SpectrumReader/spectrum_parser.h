@@ -0,0 +1,83 @@
+/**
+  ******************************************************************************
+  * @file    ADC/ADC_RegularConversion_DMA/Tools/SpectrumReader/spectrum_parser.h
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Header for spectrum_parser.c file.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __SPECTRUM_PARSER_H
+#define __SPECTRUM_PARSER_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "spectrum_frame.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define SPECTRUM_PARSER_MAX_BINS        8192
+#define SPECTRUM_PARSER_MAX_PACKET      1024
+#define SPECTRUM_PARSER_BUFFER_SIZE     \
+  (SPECTRUM_FRAME_HEADER_SIZE + 4 * SPECTRUM_PARSER_MAX_BINS + SPECTRUM_PARSER_MAX_PACKET)
+
+/* Exported types ------------------------------------------------------------*/
+/* Called for each valid frame, the magnitudes are in the host byte order */
+typedef void (*SPECTRUM_FrameCallbackTypeDef)(const SPECTRUM_FrameHeaderTypeDef *header,
+                                              const float *bins, void *context);
+
+/**
+  * @brief  State and counters of a reader of the byte stream of the port
+  */
+typedef struct
+{
+  uint8_t  buff[SPECTRUM_PARSER_BUFFER_SIZE];
+  float    bins[SPECTRUM_PARSER_MAX_BINS];
+  uint32_t fill;
+  uint8_t  synced;          /*!< A frame was received, next_seq is valid               */
+  uint32_t next_seq;
+  uint32_t last_dropped;    /*!< Dropped counter of the last frame                     */
+  uint64_t bytes;           /*!< Bytes received                                        */
+  uint32_t frames;          /*!< Valid frames                                          */
+  uint32_t missed;          /*!< Frames missing in the sequence numbers                */
+  uint32_t dropped;         /*!< Of the missed frames, those dropped by the device     */
+  uint32_t restarts;        /*!< The device restarted its sequence (new configuration) */
+  uint32_t skipped;         /*!< Bytes skipped to find the start of a frame            */
+  uint32_t errors;          /*!< Invalid headers, padding not zero                     */
+  SPECTRUM_FrameCallbackTypeDef callback;
+  void     *context;
+}SPECTRUM_ParserTypeDef;
+
+/* Exported functions ------------------------------------------------------- */
+void SPECTRUM_ParserInit(SPECTRUM_ParserTypeDef *parser,
+                         SPECTRUM_FrameCallbackTypeDef callback, void *context);
+void SPECTRUM_Parse(SPECTRUM_ParserTypeDef *parser, const uint8_t *data, uint32_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SPECTRUM_PARSER_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,288 @@
+/**
+  ******************************************************************************
+  * @file    ADC/ADC_RegularConversion_DMA/Tools/SpectrumReader/spectrum_reader.c
+  * @author  MCD Application Team
+  * @version V1.1.0
+  * @date    19-October-2026
+  * @brief   Reader of the spectra streamed by the board on its USB CDC port,
+  *          for Linux and the other POSIX systems.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2014 STMicroelectronics</center></h2>
+  *
+  * Licensed under MCD-ST Liberty SW License Agreement V2, (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        http://www.st.com/software_license_agreement_liberty_v2
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include "spectrum_parser.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define READ_SIZE       16384
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static SPECTRUM_ParserTypeDef Parser;
+static FILE *Csv = NULL;
+static volatile sig_atomic_t Stop = 0;
+
+/* Strongest bin of the last frame */
+static uint32_t PeakBin = 0;
+static float    PeakMag = 0;
+static uint32_t PeakRate = 0;
+static uint16_t PeakBins = 0;
+
+/* Private function prototypes -----------------------------------------------*/
+static void   OnFrame(const SPECTRUM_FrameHeaderTypeDef *header, const float *bins, void *context);
+static void   OnSignal(int sig);
+static int    OpenPort(const char *path);
+static double Now(void);
+static void   Report(double elapsed, double interval, uint64_t bytes, uint32_t frames);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Frame callback of the parser: CSV row and peak of the spectrum.
+  * @param  header: Frame header
+  * @param  bins: Magnitudes
+  * @param  context: Not used
+  * @retval None
+  */
+static void OnFrame(const SPECTRUM_FrameHeaderTypeDef *header, const float *bins, void *context)
+{
+  uint32_t i;
+
+  /* Bin 0 is the DC, left out of the peak */
+  PeakBin = 1;
+  for(i = 2; i < header->bins; i++)
+  {
+    if(bins[i] > bins[PeakBin])
+    {
+      PeakBin = i;
+    }
+  }
+  PeakMag = bins[PeakBin];
+  PeakRate = header->sample_rate;
+  PeakBins = header->bins;
+
+  if(Csv != NULL)
+  {
+    fprintf(Csv, "%u,%u", header->seq, header->sample_rate);
+    for(i = 0; i < header->bins; i++)
+    {
+      fprintf(Csv, ",%g", bins[i]);
+    }
+    fputc('\n', Csv);
+  }
+}
+
+/**
+  * @brief  Ends the reading on Ctrl-C.
+  * @param  sig: Signal number
+  * @retval None
+  */
+static void OnSignal(int sig)
+{
+  Stop = 1;
+}
+
+/**
+  * @brief  Opens the port in raw mode with DTR set, the device sends the
+  *         frames only while DTR is set. Any other file is read as it is,
+  *         for a recorded stream.
+  * @param  path: Device or file, "-" for the standard input
+  * @retval File descriptor, -1 on error
+  */
+static int OpenPort(const char *path)
+{
+  struct termios tio;
+  int fd, bits = TIOCM_DTR | TIOCM_RTS;
+
+  if(strcmp(path, "-") == 0)
+  {
+    return STDIN_FILENO;
+  }
+
+  fd = open(path, O_RDONLY | O_NOCTTY);
+  if(fd < 0)
+  {
+    fprintf(stderr, "%s: %s\n", path, strerror(errno));
+    return -1;
+  }
+
+  if(isatty(fd))
+  {
+    if(tcgetattr(fd, &tio) == 0)
+    {
+      /* The line coding means nothing to the device, the port runs at the
+         speed of the USB */
+      cfmakeraw(&tio);
+      tio.c_cc[VMIN] = 1;
+      tio.c_cc[VTIME] = 0;
+      tcsetattr(fd, TCSANOW, &tio);
+    }
+    tcflush(fd, TCIFLUSH);
+    ioctl(fd, TIOCMBIS, &bits);
+  }
+  return fd;
+}
+
+/**
+  * @brief  Monotonic time.
+  * @param  None
+  * @retval Time in s
+  */
+static double Now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+  * @brief  Prints a line of statistics.
+  * @param  elapsed: Time since the start, in s
+  * @param  interval: Time since the last line, in s
+  * @param  bytes: Bytes received in the interval
+  * @param  frames: Frames received in the interval
+  * @retval None
+  */
+static void Report(double elapsed, double interval, uint64_t bytes, uint32_t frames)
+{
+  double peak_hz = PeakBins ? (double)PeakBin * PeakRate / (2.0 * PeakBins) : 0;
+
+  printf("%7.1f s %7.1f frames/s %6.3f MB/s  frames %u  dropped by the device %u"
+         "  lost %u  skipped %u bytes  errors %u  peak %.0f Hz (%g)\n",
+         elapsed, frames / interval, bytes / interval / 1e6,
+         Parser.frames, Parser.dropped, Parser.missed - Parser.dropped,
+         Parser.skipped, Parser.errors, peak_hz, PeakMag);
+  fflush(stdout);
+}
+
+/**
+  * @brief  Main program.
+  * @param  argc, argv: spectrum_reader [-o file.csv] [-n frames] [-t s] port
+  * @retval 0, 1 on error
+  */
+int main(int argc, char **argv)
+{
+  static uint8_t buff[READ_SIZE];
+  const char *csv = NULL;
+  uint32_t max_frames = 0, last_frames = 0;
+  double max_time = 0, start, last, t;
+  uint64_t last_bytes = 0;
+  ssize_t n;
+  int opt, fd;
+
+  while((opt = getopt(argc, argv, "o:n:t:")) != -1)
+  {
+    switch(opt)
+    {
+    case 'o': csv = optarg; break;
+    case 'n': max_frames = strtoul(optarg, NULL, 0); break;
+    case 't': max_time = atof(optarg); break;
+    default:
+      fprintf(stderr, "usage: %s [-o file.csv] [-n frames] [-t seconds] port\n", argv[0]);
+      return 1;
+    }
+  }
+  if(optind != argc - 1)
+  {
+    fprintf(stderr, "usage: %s [-o file.csv] [-n frames] [-t seconds] port\n", argv[0]);
+    return 1;
+  }
+
+  if(csv != NULL)
+  {
+    Csv = fopen(csv, "w");
+    if(Csv == NULL)
+    {
+      fprintf(stderr, "%s: %s\n", csv, strerror(errno));
+      return 1;
+    }
+  }
+
+  fd = OpenPort(argv[optind]);
+  if(fd < 0)
+  {
+    return 1;
+  }
+
+  signal(SIGINT, OnSignal);
+  SPECTRUM_ParserInit(&Parser, OnFrame, NULL);
+  start = last = Now();
+
+  while(!Stop)
+  {
+    n = read(fd, buff, sizeof(buff));
+    if(n < 0)
+    {
+      if(errno == EINTR)
+      {
+        continue;
+      }
+      fprintf(stderr, "read: %s\n", strerror(errno));
+      break;
+    }
+    if(n == 0)
+    {
+      /* End of a recorded stream, or the board was unplugged */
+      break;
+    }
+    SPECTRUM_Parse(&Parser, buff, (uint32_t)n);
+
+    t = Now();
+    if(t - last >= 1.0)
+    {
+      Report(t - start, t - last, Parser.bytes - last_bytes, Parser.frames - last_frames);
+      last = t;
+      last_bytes = Parser.bytes;
+      last_frames = Parser.frames;
+    }
+    if(((max_frames != 0) && (Parser.frames >= max_frames)) ||
+       ((max_time != 0) && (t - start >= max_time)))
+    {
+      break;
+    }
+  }
+
+  t = Now();
+  printf("total:\n");
+  Report(t - start, (t > start) ? t - start : 1, Parser.bytes, Parser.frames);
+
+  if(Csv != NULL)
+  {
+    fclose(Csv);
+  }
+  if(fd != STDIN_FILENO)
+  {
+    close(fd);
+  }
+  return (Parser.errors != 0) ? 1 : 0;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
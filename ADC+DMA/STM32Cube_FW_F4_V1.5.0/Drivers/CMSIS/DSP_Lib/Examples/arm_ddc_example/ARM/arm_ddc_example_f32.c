@@ -0,0 +1,335 @@
+/* ----------------------------------------------------------------------
+* Copyright (C) 2010-2014 ARM Limited. All rights reserved.
+*
+* $Date:         19. October 2026
+* $Revision:     V1.4.4
+*
+* Project:       CMSIS DSP Library
+* Title:         arm_ddc_example_f32.c
+*
+* Description:   Example code for the digital down converter on the
+*                halves of a circular ADC DMA buffer
+*
+* Target Processor: Cortex-M4/Cortex-M3
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions
+* are met:
+*   - Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   - Redistributions in binary form must reproduce the above copyright
+*     notice, this list of conditions and the following disclaimer in
+*     the documentation and/or other materials provided with the
+*     distribution.
+*   - Neither the name of ARM LIMITED nor the names of its contributors
+*     may be used to endorse or promote products derived from this
+*     software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+ * -------------------------------------------------------------------- */
+
+
+/**
+ * @ingroup groupExamples
+ */
+
+/**
+ * @defgroup DDCExample Digital Down Converter Example
+ *
+ * \par Description:
+ * \par
+ * Shows how a narrow band of the ADC signal is analyzed with a 128 point
+ * complex FFT instead of a 4096 point real FFT of the whole frame. The
+ * digital down converter runs on each half of a circular DMA buffer, as
+ * from the half transfer and transfer complete callbacks of the ADC.
+ *
+ * \par Algorithm:
+ * \par
+ * The ADC codes of a 4096 word circular DMA buffer are simulated: two tones
+ * inside the band of interest, at <code>CENTER_FREQ + 5</code> and
+ * <code>CENTER_FREQ - 20</code> baseband bins, and a strong tone outside of it.
+ * Each half buffer is converted to floating-point and passed to
+ * <code>arm_ddc_f32()</code>: NCO at <code>CENTER_FREQ</code>, 4 stage CIC
+ * decimating by 16 and a 48 tap compensating FIR decimating by 2.
+ * The 64 complex samples of two consecutive halves form a baseband frame
+ * that is transformed with <code>arm_cfft_f32()</code>.
+ * \par
+ * The test checks the frequency shift and the decimation: the tones must be
+ * found in bins 5 and 128-20 with half of their amplitude, and all the other
+ * bins, where the out of band tone would alias, must be 70 dB below.
+ * The first frame is skipped while the filters settle.
+ * \par
+ * The compensating FIR is a Kaiser windowed (beta = 6) inverse of the CIC
+ * response up to 0.175 of the CIC output rate, with a raised cosine
+ * transition to 0.29. Its passband ripple is 0.2 dB and, with the CIC,
+ * the bands that alias into the output are attenuated by more than 95 dB.
+ *
+ * \par Variables Description:
+ * \par
+ * \li \c adcBuffer circular DMA buffer of 12-bit ADC codes
+ * \li \c basebandFrame complex baseband frame, then its spectrum
+ * \li \c magnitude magnitude of the baseband spectrum
+ * \li \c cycleCount cycles: DDC of one half buffer, 128 point CFFT, 4096 point real FFT of the same frame
+ *
+ * \par CMSIS DSP Software Library Functions Used:
+ * \par
+ * - arm_ddc_init_f32()
+ * - arm_ddc_f32()
+ * - arm_cfft_f32()
+ * - arm_cmplx_mag_f32()
+ * - arm_max_f32()
+ * - arm_rfft_fast_init_f32()
+ * - arm_rfft_fast_f32()
+ *
+ * <b> Refer  </b>
+ * \link arm_ddc_example_f32.c \endlink
+ *
+ */
+
+
+/** \example arm_ddc_example_f32.c
+  */
+
+#include "arm_math.h"
+#include "arm_const_structs.h"
+
+#define ADC_BUFFER_SIZE     4096                /* Circular DMA buffer, in ADC samples */
+#define HALF_BUFFER_SIZE    (ADC_BUFFER_SIZE / 2)
+#define CIC_STAGES          4
+#define CIC_DECIMATION      16
+#define FIR_DECIMATION      2
+#define NUM_TAPS            48
+#define OUT_PER_HALF        (HALF_BUFFER_SIZE / (CIC_DECIMATION * FIR_DECIMATION))
+#define FFT_SIZE            (2 * OUT_PER_HALF)  /* Baseband frame, in complex samples */
+#define NUM_FRAMES          4
+
+#define CENTER_FREQ         0.2f                /* Relative to the ADC sample rate */
+#define BIN_WIDTH           (1.0 / (CIC_DECIMATION * FIR_DECIMATION * FFT_SIZE))
+#define TONE1_BIN           5
+#define TONE1_AMPLITUDE     0.5
+#define TONE2_BIN           (-20)
+#define TONE2_AMPLITUDE     0.2
+#define BLOCKER_FREQ        0.23                /* Out of band tone */
+#define BLOCKER_AMPLITUDE   0.25
+
+#define GAIN_TOLERANCE      0.05f
+#define SPUR_LIMIT          3.16e-4f            /* -70 dB */
+
+/* ----------------------------------------------------------------------
+* DWT cycle counter of the Cortex-M3/M4 debug unit, the counts stay 0 on
+* a PC
+* ------------------------------------------------------------------- */
+#if defined(ARM_MATH_HOST)
+#include <stdio.h>
+static volatile uint32_t DEM_CR, DWT_CTRL, DWT_CYCCNT;
+#else
+#define DEM_CR          (*(volatile uint32_t *) 0xE000EDFCu)
+#define DWT_CTRL        (*(volatile uint32_t *) 0xE0001000u)
+#define DWT_CYCCNT      (*(volatile uint32_t *) 0xE0001004u)
+#endif
+
+/* ----------------------------------------------------------------------
+* CIC compensating FIR, time reversed, DC gain 1
+* ------------------------------------------------------------------- */
+float32_t firCoeffs[NUM_TAPS] = {
+  2.5296494e-06f, 6.45500028e-06f, -7.9029368e-06f, 2.82554816e-05f,
+  3.97668467e-05f, -0.000156277265f, -0.000151379432f, 0.000361520634f,
+  0.000313868472f, -0.000458946931f, -0.000101397149f, 0.000191934584f,
+  -0.0017402382f, 0.000248684296f, 0.00753730375f, 0.000754440326f,
+  -0.0204757373f, -0.00761727186f, 0.0442565481f, 0.0304665413f,
+  -0.0844492049f, -0.100974365f, 0.156117701f, 0.475807171f,
+  0.475807171f, 0.156117701f, -0.100974365f, -0.0844492049f,
+  0.0304665413f, 0.0442565481f, -0.00761727186f, -0.0204757373f,
+  0.000754440326f, 0.00753730375f, 0.000248684296f, -0.0017402382f,
+  0.000191934584f, -0.000101397149f, -0.000458946931f, 0.000313868472f,
+  0.000361520634f, -0.000151379432f, -0.000156277265f, 3.97668467e-05f,
+  2.82554816e-05f, -7.9029368e-06f, 6.45500028e-06f, 2.5296494e-06f
+};
+
+/* ----------------------------------------------------------------------
+* Buffers
+* ------------------------------------------------------------------- */
+uint32_t adcBuffer[ADC_BUFFER_SIZE];             /* Word transfers, as in ADC_RegularConversion_DMA */
+float32_t adcBlock[HALF_BUFFER_SIZE];
+float32_t adcFrame[ADC_BUFFER_SIZE];
+float32_t rfftOutput[ADC_BUFFER_SIZE];
+
+arm_ddc_instance_f32 S;
+float32_t firState[2 * (NUM_TAPS + HALF_BUFFER_SIZE / CIC_DECIMATION - 1)];
+q31_t cicState[4 * CIC_STAGES];
+float32_t ddcScratch[2 * HALF_BUFFER_SIZE / CIC_DECIMATION];
+
+float32_t basebandFrame[2 * FFT_SIZE];
+float32_t magnitude[FFT_SIZE];
+uint32_t framePos = 0u;
+
+uint32_t cycleCount[3];
+
+/* ----------------------------------------------------------------------
+* ADC model: the tones quantized to 12 bits
+* ------------------------------------------------------------------- */
+static uint32_t sampleIndex = 0u;
+
+static void adc_fill(uint32_t * pBuffer, uint32_t numSamples)
+{
+  float64_t n, x;
+  uint32_t i;
+
+  for (i = 0u; i < numSamples; i++)
+  {
+    n = (float64_t) sampleIndex++;
+    x = TONE1_AMPLITUDE * cos(2.0 * PI * (CENTER_FREQ + TONE1_BIN * BIN_WIDTH) * n)
+      + TONE2_AMPLITUDE * cos(2.0 * PI * (CENTER_FREQ + TONE2_BIN * BIN_WIDTH) * n)
+      + BLOCKER_AMPLITUDE * cos(2.0 * PI * BLOCKER_FREQ * n);
+
+    pBuffer[i] = (uint32_t) (2048.0 + floor(2047.0 * x + 0.5));
+  }
+}
+
+/* ----------------------------------------------------------------------
+* Processing of one half of the DMA buffer, called from
+* HAL_ADC_ConvHalfCpltCallback() with the first half and from
+* HAL_ADC_ConvCpltCallback() with the second half
+* ------------------------------------------------------------------- */
+static uint32_t ddc_half_buffer(const uint32_t * pHalf)
+{
+  uint32_t i, start, frameDone = 0u;
+
+  /* 12-bit codes to [-1 +1) */
+  for (i = 0u; i < HALF_BUFFER_SIZE; i++)
+  {
+    adcBlock[i] = ((float32_t) pHalf[i] - 2048.0f) * (1.0f / 2048.0f);
+  }
+
+  start = DWT_CYCCNT;
+  arm_ddc_f32(&S, adcBlock, &basebandFrame[2u * framePos], HALF_BUFFER_SIZE);
+  cycleCount[0] = DWT_CYCCNT - start;
+
+  framePos += OUT_PER_HALF;
+
+  if(framePos == FFT_SIZE)
+  {
+    start = DWT_CYCCNT;
+    arm_cfft_f32(&arm_cfft_sR_f32_len128, basebandFrame, 0, 1);
+    cycleCount[1] = DWT_CYCCNT - start;
+
+    arm_cmplx_mag_f32(basebandFrame, magnitude, FFT_SIZE);
+
+    framePos = 0u;
+    frameDone = 1u;
+  }
+
+  return (frameDone);
+}
+
+/* ----------------------------------------------------------------------
+* Digital down converter test
+* ------------------------------------------------------------------- */
+
+int32_t main(void)
+{
+  arm_status status;
+  arm_rfft_fast_instance_f32 rfft;
+  float32_t peak, expected, spur;
+  uint32_t frame, half, bin, peakIndex, start, i;
+  uint32_t bin1 = TONE1_BIN;
+  uint32_t bin2 = FFT_SIZE + TONE2_BIN;
+
+  /* Enable the DWT cycle counter */
+  DEM_CR |= (1u << 24);
+  DWT_CYCCNT = 0u;
+  DWT_CTRL |= 1u;
+
+  status = arm_ddc_init_f32(&S, CENTER_FREQ, CIC_STAGES, CIC_DECIMATION, NUM_TAPS, FIR_DECIMATION,
+                            firCoeffs, firState, cicState, ddcScratch, HALF_BUFFER_SIZE);
+
+  for (frame = 0u; (frame < NUM_FRAMES) && (status == ARM_MATH_SUCCESS); frame++)
+  {
+    for (half = 0u; half < 2u; half++)
+    {
+      /* The DMA fills one half while the other one is processed */
+      adc_fill(&adcBuffer[half * HALF_BUFFER_SIZE], HALF_BUFFER_SIZE);
+
+      if(ddc_half_buffer(&adcBuffer[half * HALF_BUFFER_SIZE]) == 0u)
+      {
+        continue;
+      }
+
+      /* Skip the first frame, where the filters are not settled */
+      if(frame == 0u)
+      {
+        continue;
+      }
+
+      /* Tone 1: strongest bin, half of the amplitude in the complex baseband */
+      arm_max_f32(magnitude, FFT_SIZE, &peak, &peakIndex);
+      expected = 0.5f * TONE1_AMPLITUDE * FFT_SIZE;
+
+      if((peakIndex != bin1) || (fabsf(peak - expected) > GAIN_TOLERANCE * expected))
+      {
+        status = ARM_MATH_TEST_FAILURE;
+      }
+
+      /* Tone 2, below the center frequency */
+      expected = 0.5f * TONE2_AMPLITUDE * FFT_SIZE;
+
+      if(fabsf(magnitude[bin2] - expected) > GAIN_TOLERANCE * expected)
+      {
+        status = ARM_MATH_TEST_FAILURE;
+      }
+
+      /* Everything else, including the aliases of the out of band tone */
+      for (bin = 0u; bin < FFT_SIZE; bin++)
+      {
+        spur = magnitude[bin] / peak;
+
+        if((bin != bin1) && (bin != bin2) && (spur > SPUR_LIMIT))
+        {
+          status = ARM_MATH_TEST_FAILURE;
+        }
+      }
+    }
+  }
+
+  /* Cost of the full band analysis of the same frame */
+  for (i = 0u; i < ADC_BUFFER_SIZE; i++)
+  {
+    adcFrame[i] = ((float32_t) adcBuffer[i] - 2048.0f) * (1.0f / 2048.0f);
+  }
+
+  arm_rfft_fast_init_f32(&rfft, ADC_BUFFER_SIZE);
+
+  start = DWT_CYCCNT;
+  arm_rfft_fast_f32(&rfft, adcFrame, rfftOutput, 0);
+  cycleCount[2] = DWT_CYCCNT - start;
+
+#if defined(ARM_MATH_HOST)
+  printf("%s\n", (status == ARM_MATH_SUCCESS) ? "PASS" : "FAIL");
+
+  return ((status == ARM_MATH_SUCCESS) ? 0 : 1);
+#else
+  /* ----------------------------------------------------------------------
+  ** Loop here if the signals fail the PASS check.
+  ** This denotes a test failure
+  ** ------------------------------------------------------------------- */
+  if( status != ARM_MATH_SUCCESS)
+  {
+    while(1);
+  }
+
+  while(1);                             /* main function does not return */
+#endif
+}
+
+ /** \endlink */
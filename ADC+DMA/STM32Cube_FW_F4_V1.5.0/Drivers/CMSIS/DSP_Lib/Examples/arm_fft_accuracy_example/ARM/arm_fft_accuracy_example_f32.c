@@ -0,0 +1,573 @@
+/* ----------------------------------------------------------------------
+* Copyright (C) 2010-2014 ARM Limited. All rights reserved.
+*
+* $Date:         19. October 2026
+* $Revision:     V1.4.4
+*
+* Project:       CMSIS DSP Library
+* Title:         arm_fft_accuracy_example_f32.c
+*
+* Description:   Accuracy, speed and memory test bench for the FFT
+*                functions on 12-bit signals
+*
+* Target Processor: Cortex-M4/Cortex-M3
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions
+* are met:
+*   - Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   - Redistributions in binary form must reproduce the above copyright
+*     notice, this list of conditions and the following disclaimer in
+*     the documentation and/or other materials provided with the
+*     distribution.
+*   - Neither the name of ARM LIMITED nor the names of its contributors
+*     may be used to endorse or promote products derived from this
+*     software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+ * -------------------------------------------------------------------- */
+
+/**
+ * @ingroup groupExamples
+ */
+
+/**
+ * @defgroup FFTAccuracyExample FFT Accuracy Test Bench
+ *
+ * \par Description:
+ * \par
+ * Runs every complex and real FFT flavor of the library (radix-2, radix-4 and
+ * the mixed radix CFFT in floating-point, Q31 and Q15, the real FFTs and the
+ * block floating-point Q15 CFFT) on the same 12-bit input and reports, for each
+ * of them, the signal to noise ratio against a double precision reference, the
+ * cycles per transform and the bytes of data buffers and tables it needs.
+ * The question it answers is how much of a 12-bit ultrasound capture survives
+ * a \c FFT_LEN point transform in each number format.
+ *
+ * \par Algorithm:
+ * \par
+ * Three input signals are used:
+ * - a full scale Gaussian windowed tone burst with 1 LSB of noise, quantized to 12 bits,
+ * - the same burst at -40 dBFS, which shows the precision lost by the fixed
+ *   down-scaling of the fixed-point transforms,
+ * - an optional recorded capture of \c FFT_LEN raw ADC samples. Point \c pRecorded
+ *   at the buffer filled by the ADC DMA (right aligned, 12 bits) to include it.
+ *
+ * \par
+ * The 12-bit samples are left aligned to Q15, shifted to Q31 or divided by 32768
+ * for floating-point, so every flavor sees exactly the same values. The reference
+ * is a radix-2 FFT of those values computed in double precision.
+ * Since the input is real, bins 1 to <code>FFT_LEN/2-1</code> are compared.
+ *
+ * \par
+ * The fixed-point transforms scale their output down by a power of two that
+ * depends on the flavor and the length. The test bench finds that power of two
+ * from a least squares fit of the output to the reference, stores it in \c gainExp
+ * and applies it before the error is measured, so the SNR only shows the
+ * rounding noise of the transform. For the block floating-point CFFT
+ * \c gainExp equals the block exponent returned by the function.
+ *
+ * \par Variables Description:
+ * \par
+ * \li \c snr signal to noise ratio in dB, per flavor and signal (0 when the signal is not run)
+ * \li \c gainExp power of two applied to the output of each flavor
+ * \li \c cycleCount cycles per transform read from the DWT cycle counter
+ * \li \c memBytes bytes of data buffers, instance and tables of each flavor
+ * \li \c bfpExponent block exponent returned by arm_cfft_bfp_q15() for each signal
+ *
+ * \par CMSIS DSP Software Library Functions Used:
+ * \par
+ * - arm_cfft_radix2_init_f32(), arm_cfft_radix2_f32()
+ * - arm_cfft_radix4_init_f32(), arm_cfft_radix4_f32()
+ * - arm_cfft_f32()
+ * - arm_rfft_fast_init_f32(), arm_rfft_fast_f32()
+ * - arm_cfft_radix2_init_q31(), arm_cfft_radix2_q31()
+ * - arm_cfft_radix4_init_q31(), arm_cfft_radix4_q31()
+ * - arm_cfft_q31()
+ * - arm_rfft_init_q31(), arm_rfft_q31()
+ * - arm_cfft_radix2_init_q15(), arm_cfft_radix2_q15()
+ * - arm_cfft_radix4_init_q15(), arm_cfft_radix4_q15()
+ * - arm_cfft_q15()
+ * - arm_rfft_init_q15(), arm_rfft_q15()
+ * - arm_cfft_bfp_q15()
+ *
+ * <b> Refer  </b>
+ * \link arm_fft_accuracy_example_f32.c \endlink
+ *
+ */
+
+
+/** \example arm_fft_accuracy_example_f32.c
+  */
+
+#include "arm_math.h"
+#include "arm_common_tables.h"
+#include "arm_const_structs.h"
+
+#define FFT_LEN             4096
+#define NUM_SIGNALS         3
+#define ADC_BITS            12
+#define SNR_THRESHOLD_F32   100
+
+/* ----------------------------------------------------------------------
+* FFT flavors under test
+* ------------------------------------------------------------------- */
+#define CFFT_RADIX2_F32     0
+#define CFFT_RADIX4_F32     1
+#define CFFT_F32            2
+#define RFFT_FAST_F32       3
+#define CFFT_RADIX2_Q31     4
+#define CFFT_RADIX4_Q31     5
+#define CFFT_Q31            6
+#define RFFT_Q31            7
+#define CFFT_RADIX2_Q15     8
+#define CFFT_RADIX4_Q15     9
+#define CFFT_Q15            10
+#define RFFT_Q15            11
+#define CFFT_BFP_Q15        12
+#define NUM_FLAVORS         13
+
+/* ----------------------------------------------------------------------
+* DWT cycle counter of the Cortex-M3/M4 debug unit, the counts stay 0 on
+* a PC
+* ------------------------------------------------------------------- */
+#if defined(ARM_MATH_HOST)
+#include <stdio.h>
+static volatile uint32_t DEM_CR, DWT_CTRL, DWT_CYCCNT;
+#else
+#define DEM_CR          (*(volatile uint32_t *) 0xE000EDFCu)
+#define DWT_CTRL        (*(volatile uint32_t *) 0xE0001000u)
+#define DWT_CYCCNT      (*(volatile uint32_t *) 0xE0001004u)
+#endif
+
+/* ----------------------------------------------------------------------
+* Recorded capture of FFT_LEN right aligned 12-bit ADC samples, or NULL
+* ------------------------------------------------------------------- */
+const uint16_t *pRecorded = NULL;
+
+/* ----------------------------------------------------------------------
+* Work buffer, shared by the reference and every flavor.
+* The real FFTs use the first FFT_LEN values as input and the
+* following 2*FFT_LEN values as output.
+* ------------------------------------------------------------------- */
+union
+{
+  float64_t ref[2 * FFT_LEN];
+  float32_t f32[2 * FFT_LEN];
+  q31_t q31[3 * FFT_LEN];
+  q15_t q15[3 * FFT_LEN];
+} work;
+
+q15_t signal[FFT_LEN];                    /* 12-bit input left aligned to Q15 */
+float32_t refSpectrum[FFT_LEN];           /* reference bins 0 to FFT_LEN/2-1 */
+float32_t testSpectrum[FFT_LEN];          /* bins of the flavor under test */
+
+float32_t snr[NUM_FLAVORS][NUM_SIGNALS];
+int32_t gainExp[NUM_FLAVORS][NUM_SIGNALS];
+uint32_t cycleCount[NUM_FLAVORS][NUM_SIGNALS];
+uint32_t memBytes[NUM_FLAVORS];
+int8_t bfpExponent[NUM_SIGNALS];
+
+/* ----------------------------------------------------------------------
+* Bytes of the tables that are static to arm_rfft_init_q31.c and
+* arm_rfft_init_q15.c (realCoefA and realCoefB, 8192 values each)
+* ------------------------------------------------------------------- */
+#define RFFT_COEF_BYTES_Q31     (2u * 8192u * sizeof(q31_t))
+#define RFFT_COEF_BYTES_Q15     (2u * 8192u * sizeof(q15_t))
+
+/* ----------------------------------------------------------------------
+* Instances of the flavors that need an init call
+* ------------------------------------------------------------------- */
+arm_cfft_radix2_instance_f32 radix2_f32;
+arm_cfft_radix4_instance_f32 radix4_f32;
+arm_rfft_fast_instance_f32 rfftFast_f32;
+arm_cfft_radix2_instance_q31 radix2_q31;
+arm_cfft_radix4_instance_q31 radix4_q31;
+arm_rfft_instance_q31 rfft_q31;
+arm_cfft_radix2_instance_q15 radix2_q15;
+arm_cfft_radix4_instance_q15 radix4_q15;
+arm_rfft_instance_q15 rfft_q15;
+
+/* ----------------------------------------------------------------------
+* Test signals
+* ------------------------------------------------------------------- */
+static uint32_t seed = 12345u;
+
+static void make_burst(float32_t amplitude)
+{
+  float32_t t, v;
+  int32_t s;
+  uint32_t i;
+
+  for (i = 0u; i < FFT_LEN; i++)
+  {
+    /* Gaussian windowed tone at 0.12 fs, centered in the frame */
+    t = ((float32_t) i - (FFT_LEN / 2)) / (FFT_LEN / 8);
+    v = amplitude * 2047.0f * expf(-t * t) * sinf(2.0f * PI * 0.12f * i);
+
+    /* 1 LSB of uniform noise */
+    seed = seed * 1664525u + 1013904223u;
+    v += ((float32_t) (int32_t) seed) / 2147483648.0f;
+
+    s = (int32_t) ((v < 0.0f) ? (v - 0.5f) : (v + 0.5f));
+    s = (s > 2047) ? 2047 : ((s < -2048) ? -2048 : s);
+
+    signal[i] = (q15_t) (s << (16 - ADC_BITS));
+  }
+}
+
+static void load_recording(const uint16_t * pSrc)
+{
+  uint32_t i;
+
+  /* Remove the mid-scale offset and left align to Q15 */
+  for (i = 0u; i < FFT_LEN; i++)
+  {
+    signal[i] = (q15_t) (((int32_t) pSrc[i] - (1 << (ADC_BITS - 1))) << (16 - ADC_BITS));
+  }
+}
+
+/* ----------------------------------------------------------------------
+* Double precision radix-2 reference FFT of the current signal
+* ------------------------------------------------------------------- */
+static void reference_fft(void)
+{
+  float64_t *p = work.ref;
+  float64_t angle, wr, wi, tr, ti;
+  uint32_t i, j, k, m, len;
+
+  for (i = 0u; i < FFT_LEN; i++)
+  {
+    p[2u * i] = signal[i] / 32768.0;
+    p[2u * i + 1u] = 0.0;
+  }
+
+  /* Bit reversal */
+  for (i = 0u, j = 0u; i < FFT_LEN; i++)
+  {
+    if(i < j)
+    {
+      tr = p[2u * i]; p[2u * i] = p[2u * j]; p[2u * j] = tr;
+      ti = p[2u * i + 1u]; p[2u * i + 1u] = p[2u * j + 1u]; p[2u * j + 1u] = ti;
+    }
+
+    for (m = FFT_LEN >> 1u; (m != 0u) && ((j & m) != 0u); m >>= 1u)
+    {
+      j ^= m;
+    }
+    j |= m;
+  }
+
+  /* Decimation in time butterflies */
+  for (len = 2u; len <= FFT_LEN; len <<= 1u)
+  {
+    for (k = 0u; k < (len >> 1u); k++)
+    {
+      angle = -2.0 * 3.14159265358979323846 * k / len;
+      wr = cos(angle);
+      wi = sin(angle);
+
+      for (i = k; i < FFT_LEN; i += len)
+      {
+        j = i + (len >> 1u);
+        tr = p[2u * j] * wr - p[2u * j + 1u] * wi;
+        ti = p[2u * j] * wi + p[2u * j + 1u] * wr;
+        p[2u * j] = p[2u * i] - tr;
+        p[2u * j + 1u] = p[2u * i + 1u] - ti;
+        p[2u * i] += tr;
+        p[2u * i + 1u] += ti;
+      }
+    }
+  }
+
+  for (i = 0u; i < FFT_LEN; i++)
+  {
+    refSpectrum[i] = (float32_t) p[i];
+  }
+}
+
+/* ----------------------------------------------------------------------
+* SNR of testSpectrum against refSpectrum over bins 1 to FFT_LEN/2-1,
+* after scaling the test output by the best fitting power of two
+* ------------------------------------------------------------------- */
+static float32_t spectrum_snr(int32_t * pGainExp)
+{
+  float64_t cross = 0.0, testPower = 0.0, refPower = 0.0, noise = 0.0;
+  float64_t gain, d;
+  int32_t e = 0;
+  uint32_t i;
+
+  for (i = 2u; i < FFT_LEN; i++)
+  {
+    cross += (float64_t) refSpectrum[i] * testSpectrum[i];
+    testPower += (float64_t) testSpectrum[i] * testSpectrum[i];
+    refPower += (float64_t) refSpectrum[i] * refSpectrum[i];
+  }
+
+  if((cross > 0.0) && (testPower > 0.0))
+  {
+    e = (int32_t) floor(log(cross / testPower) / log(2.0) + 0.5);
+  }
+
+  gain = ldexp(1.0, e);
+
+  for (i = 2u; i < FFT_LEN; i++)
+  {
+    d = refSpectrum[i] - gain * testSpectrum[i];
+    noise += d * d;
+  }
+
+  *pGainExp = e;
+
+  if(noise == 0.0)
+  {
+    return 200.0f;
+  }
+
+  return (float32_t) (10.0 * log10(refPower / noise));
+}
+
+/* ----------------------------------------------------------------------
+* Runs one flavor on the current signal, leaves its bins in testSpectrum
+* and returns the cycles taken by the transform
+* ------------------------------------------------------------------- */
+static uint32_t run_flavor(uint32_t flavor, uint32_t sig)
+{
+  q31_t *pOut_q31 = &work.q31[FFT_LEN];
+  q15_t *pOut_q15 = &work.q15[FFT_LEN];
+  float32_t *pOut_f32 = &work.f32[FFT_LEN];
+  uint32_t i, start, cycles = 0u;
+
+  /* Load the input: complex interleaved for the CFFTs, real for the RFFTs */
+  for (i = 0u; i < FFT_LEN; i++)
+  {
+    switch (flavor)
+    {
+    case CFFT_RADIX2_F32:
+    case CFFT_RADIX4_F32:
+    case CFFT_F32:
+      work.f32[2u * i] = signal[i] / 32768.0f;
+      work.f32[2u * i + 1u] = 0.0f;
+      break;
+    case RFFT_FAST_F32:
+      work.f32[i] = signal[i] / 32768.0f;
+      break;
+    case CFFT_RADIX2_Q31:
+    case CFFT_RADIX4_Q31:
+    case CFFT_Q31:
+      work.q31[2u * i] = (q31_t) signal[i] << 16;
+      work.q31[2u * i + 1u] = 0;
+      break;
+    case RFFT_Q31:
+      work.q31[i] = (q31_t) signal[i] << 16;
+      break;
+    case RFFT_Q15:
+      work.q15[i] = signal[i];
+      break;
+    default:
+      work.q15[2u * i] = signal[i];
+      work.q15[2u * i + 1u] = 0;
+      break;
+    }
+  }
+
+  start = DWT_CYCCNT;
+
+  switch (flavor)
+  {
+  case CFFT_RADIX2_F32:
+    arm_cfft_radix2_f32(&radix2_f32, work.f32);
+    break;
+  case CFFT_RADIX4_F32:
+    arm_cfft_radix4_f32(&radix4_f32, work.f32);
+    break;
+  case CFFT_F32:
+    arm_cfft_f32(&arm_cfft_sR_f32_len4096, work.f32, 0u, 1u);
+    break;
+  case RFFT_FAST_F32:
+    arm_rfft_fast_f32(&rfftFast_f32, work.f32, pOut_f32, 0u);
+    break;
+  case CFFT_RADIX2_Q31:
+    arm_cfft_radix2_q31(&radix2_q31, work.q31);
+    break;
+  case CFFT_RADIX4_Q31:
+    arm_cfft_radix4_q31(&radix4_q31, work.q31);
+    break;
+  case CFFT_Q31:
+    arm_cfft_q31(&arm_cfft_sR_q31_len4096, work.q31, 0u, 1u);
+    break;
+  case RFFT_Q31:
+    arm_rfft_q31(&rfft_q31, work.q31, pOut_q31);
+    break;
+  case CFFT_RADIX2_Q15:
+    arm_cfft_radix2_q15(&radix2_q15, work.q15);
+    break;
+  case CFFT_RADIX4_Q15:
+    arm_cfft_radix4_q15(&radix4_q15, work.q15);
+    break;
+  case CFFT_Q15:
+    arm_cfft_q15(&arm_cfft_sR_q15_len4096, work.q15, 0u, 1u);
+    break;
+  case RFFT_Q15:
+    arm_rfft_q15(&rfft_q15, work.q15, pOut_q15);
+    break;
+  case CFFT_BFP_Q15:
+    arm_cfft_bfp_q15(&arm_cfft_sR_q15_len4096, work.q15, 0u, 1u, &bfpExponent[sig]);
+    break;
+  }
+
+  cycles = DWT_CYCCNT - start;
+
+  /* Convert bins 0 to FFT_LEN/2-1 to floating-point */
+  for (i = 0u; i < FFT_LEN; i++)
+  {
+    switch (flavor)
+    {
+    case CFFT_RADIX2_F32:
+    case CFFT_RADIX4_F32:
+    case CFFT_F32:
+      testSpectrum[i] = work.f32[i];
+      break;
+    case RFFT_FAST_F32:
+      testSpectrum[i] = pOut_f32[i];
+      break;
+    case CFFT_RADIX2_Q31:
+    case CFFT_RADIX4_Q31:
+    case CFFT_Q31:
+      testSpectrum[i] = work.q31[i] / 2147483648.0f;
+      break;
+    case RFFT_Q31:
+      testSpectrum[i] = pOut_q31[i] / 2147483648.0f;
+      break;
+    case RFFT_Q15:
+      testSpectrum[i] = pOut_q15[i] / 32768.0f;
+      break;
+    default:
+      testSpectrum[i] = work.q15[i] / 32768.0f;
+      break;
+    }
+  }
+
+  return cycles;
+}
+
+/* ----------------------------------------------------------------------
+* Bytes of data buffers, instance and tables of each flavor
+* ------------------------------------------------------------------- */
+static void count_memory(void)
+{
+  uint32_t cplx_f32 = 2u * FFT_LEN * sizeof(float32_t);
+  uint32_t cplx_q31 = 2u * FFT_LEN * sizeof(q31_t);
+  uint32_t cplx_q15 = 2u * FFT_LEN * sizeof(q15_t);
+
+  memBytes[CFFT_RADIX2_F32] = cplx_f32 + sizeof(radix2_f32) + sizeof(twiddleCoef_4096) + sizeof(armBitRevTable);
+  memBytes[CFFT_RADIX4_F32] = cplx_f32 + sizeof(radix4_f32) + sizeof(twiddleCoef_4096) + sizeof(armBitRevTable);
+  memBytes[CFFT_F32] = cplx_f32 + sizeof(arm_cfft_instance_f32) + sizeof(twiddleCoef_4096) + sizeof(armBitRevIndexTable4096);
+  memBytes[RFFT_FAST_F32] = 2u * FFT_LEN * sizeof(float32_t) + sizeof(rfftFast_f32)
+                          + sizeof(twiddleCoef_2048) + sizeof(armBitRevIndexTable2048) + sizeof(twiddleCoef_rfft_4096);
+
+  memBytes[CFFT_RADIX2_Q31] = cplx_q31 + sizeof(radix2_q31) + sizeof(twiddleCoef_4096_q31) + sizeof(armBitRevTable);
+  memBytes[CFFT_RADIX4_Q31] = cplx_q31 + sizeof(radix4_q31) + sizeof(twiddleCoef_4096_q31) + sizeof(armBitRevTable);
+  memBytes[CFFT_Q31] = cplx_q31 + sizeof(arm_cfft_instance_q31) + sizeof(twiddleCoef_4096_q31) + sizeof(armBitRevIndexTable_fixed_4096);
+  memBytes[RFFT_Q31] = 3u * FFT_LEN * sizeof(q31_t) + sizeof(rfft_q31) + sizeof(arm_cfft_instance_q31)
+                     + sizeof(twiddleCoef_2048_q31) + sizeof(armBitRevIndexTable_fixed_2048) + RFFT_COEF_BYTES_Q31;
+
+  memBytes[CFFT_RADIX2_Q15] = cplx_q15 + sizeof(radix2_q15) + sizeof(twiddleCoef_4096_q15) + sizeof(armBitRevTable);
+  memBytes[CFFT_RADIX4_Q15] = cplx_q15 + sizeof(radix4_q15) + sizeof(twiddleCoef_4096_q15) + sizeof(armBitRevTable);
+  memBytes[CFFT_Q15] = cplx_q15 + sizeof(arm_cfft_instance_q15) + sizeof(twiddleCoef_4096_q15) + sizeof(armBitRevIndexTable_fixed_4096);
+  memBytes[RFFT_Q15] = 3u * FFT_LEN * sizeof(q15_t) + sizeof(rfft_q15) + sizeof(arm_cfft_instance_q15)
+                     + sizeof(twiddleCoef_2048_q15) + sizeof(armBitRevIndexTable_fixed_2048) + RFFT_COEF_BYTES_Q15;
+  memBytes[CFFT_BFP_Q15] = memBytes[CFFT_Q15];
+}
+
+/* ----------------------------------------------------------------------
+* FFT accuracy, speed and memory test bench
+* ------------------------------------------------------------------- */
+
+int32_t main(void)
+{
+  arm_status status = ARM_MATH_SUCCESS;
+  uint32_t flavor, sig;
+
+  /* Enable the DWT cycle counter */
+  DEM_CR |= (1u << 24);
+  DWT_CYCCNT = 0u;
+  DWT_CTRL |= 1u;
+
+  /* Forward transforms with bit reversal, so every flavor returns natural order */
+  status |= arm_cfft_radix2_init_f32(&radix2_f32, FFT_LEN, 0u, 1u);
+  status |= arm_cfft_radix4_init_f32(&radix4_f32, FFT_LEN, 0u, 1u);
+  status |= arm_rfft_fast_init_f32(&rfftFast_f32, FFT_LEN);
+  status |= arm_cfft_radix2_init_q31(&radix2_q31, FFT_LEN, 0u, 1u);
+  status |= arm_cfft_radix4_init_q31(&radix4_q31, FFT_LEN, 0u, 1u);
+  status |= arm_rfft_init_q31(&rfft_q31, FFT_LEN, 0u, 1u);
+  status |= arm_cfft_radix2_init_q15(&radix2_q15, FFT_LEN, 0u, 1u);
+  status |= arm_cfft_radix4_init_q15(&radix4_q15, FFT_LEN, 0u, 1u);
+  status |= arm_rfft_init_q15(&rfft_q15, FFT_LEN, 0u, 1u);
+
+  count_memory();
+
+  for (sig = 0u; sig < NUM_SIGNALS; sig++)
+  {
+    if(sig == 0u)
+    {
+      make_burst(1.0f);
+    }
+    else if(sig == 1u)
+    {
+      make_burst(0.01f);
+    }
+    else if(pRecorded != NULL)
+    {
+      load_recording(pRecorded);
+    }
+    else
+    {
+      continue;
+    }
+
+    reference_fft();
+
+    for (flavor = 0u; flavor < NUM_FLAVORS; flavor++)
+    {
+      cycleCount[flavor][sig] = run_flavor(flavor, sig);
+      snr[flavor][sig] = spectrum_snr(&gainExp[flavor][sig]);
+    }
+
+    if(snr[CFFT_F32][sig] < SNR_THRESHOLD_F32)
+    {
+      status = ARM_MATH_TEST_FAILURE;
+    }
+  }
+
+#if defined(ARM_MATH_HOST)
+  printf("%s\n", (status == ARM_MATH_SUCCESS) ? "PASS" : "FAIL");
+
+  return ((status == ARM_MATH_SUCCESS) ? 0 : 1);
+#else
+  /* ----------------------------------------------------------------------
+  ** Loop here if the signals fail the PASS check.
+  ** This denotes a test failure
+  ** ------------------------------------------------------------------- */
+  if( status != ARM_MATH_SUCCESS)
+  {
+    while(1);
+  }
+
+  while(1);                             /* main function does not return */
+#endif
+}
+
+ /** \endlink */
@@ -0,0 +1,288 @@
+/* ----------------------------------------------------------------------
+* Copyright (C) 2010-2014 ARM Limited. All rights reserved.
+*
+* $Date:         19. October 2026
+* $Revision:     V1.4.4
+*
+* Project:       CMSIS DSP Library
+* Title:         arm_fully_connected_example_f32.c
+*
+* Description:   Example code comparing the batched fully connected layer
+*                with the generic matrix multiplication
+*
+* Target Processor: Cortex-M4/Cortex-M3
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions
+* are met:
+*   - Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   - Redistributions in binary form must reproduce the above copyright
+*     notice, this list of conditions and the following disclaimer in
+*     the documentation and/or other materials provided with the
+*     distribution.
+*   - Neither the name of ARM LIMITED nor the names of its contributors
+*     may be used to endorse or promote products derived from this
+*     software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+ * -------------------------------------------------------------------- */
+
+/**
+ * @ingroup groupExamples
+ */
+
+/**
+ * @defgroup FullyConnectedExample Fully Connected Layer Example
+ *
+ * \par Description:
+ * \par
+ * Benchmarks the batched fully connected kernels against the generic matrix
+ * multiplication for the layer shapes used by the classifier (64x32 and 128x64),
+ * with a batch of \c NUM_VECTORS input frames.
+ *
+ * \par Algorithm:
+ * \par
+ * The reference computes <code>Y = X * W<sup>T</sup></code> with <code>arm_mat_mult_f32()</code>
+ * and <code>arm_mat_mult_q15()</code>, where the transposed weights are prepared once,
+ * the matrix instances are set up on every call and the bias and ReLU are applied
+ * in a separate pass. The batched kernels compute the same layer in a single call.
+ * The outputs of both paths are compared and the cycle counts read from the DWT
+ * cycle counter are stored in \c cycleCount for inspection in the debugger.
+ *
+ * \par
+ * In an application the weights are const tables placed in flash; here they are
+ * generated at start-up so that the example has no data file.
+ *
+ * \par Variables Description:
+ * \par
+ * \li \c cycleCount cycles per batch for each shape: mat_mult_f32, batch_f32, mat_mult_q15, batch_q15
+ * \li \c snr signal to noise ratio of the floating-point batched output against the reference
+ * \li \c maxDiff largest difference between the Q15 batched output and the reference
+ *
+ * \par CMSIS DSP Software Library Functions Used:
+ * \par
+ * - arm_mat_init_f32()
+ * - arm_mat_mult_f32()
+ * - arm_mat_init_q15()
+ * - arm_mat_mult_q15()
+ * - arm_fully_connected_init_f32()
+ * - arm_fully_connected_batch_f32()
+ * - arm_fully_connected_init_q15()
+ * - arm_fully_connected_batch_q15()
+ *
+ * <b> Refer  </b>
+ * \link arm_fully_connected_example_f32.c \endlink
+ *
+ */
+
+
+/** \example arm_fully_connected_example_f32.c
+  */
+
+#include "arm_math.h"
+#include "math_helper.h"
+
+#define NUM_SHAPES      2
+#define NUM_VECTORS     8
+#define MAX_ROWS        128
+#define MAX_COLS        64
+#define SNR_THRESHOLD   100
+
+/* ----------------------------------------------------------------------
+* DWT cycle counter of the Cortex-M3/M4 debug unit
+* ------------------------------------------------------------------- */
+#define DEM_CR          (*(volatile uint32_t *) 0xE000EDFCu)
+#define DWT_CTRL        (*(volatile uint32_t *) 0xE0001000u)
+#define DWT_CYCCNT      (*(volatile uint32_t *) 0xE0001004u)
+
+/* ----------------------------------------------------------------------
+* Layer shapes under test: outputs x inputs
+* ------------------------------------------------------------------- */
+const uint16_t numRowsTest[NUM_SHAPES] = {64, 128};
+const uint16_t numColsTest[NUM_SHAPES] = {32, 64};
+
+/* ----------------------------------------------------------------------
+* Layer buffers, shared by the floating-point and the Q15 tests
+* ------------------------------------------------------------------- */
+union
+{
+  struct
+  {
+    float32_t W[MAX_ROWS * MAX_COLS];           /* weights, row order */
+    float32_t WT[MAX_COLS * MAX_ROWS];          /* transposed weights for arm_mat_mult_f32 */
+  } f32;
+  struct
+  {
+    q15_t W[MAX_ROWS * MAX_COLS];
+    q15_t WT[MAX_COLS * MAX_ROWS];
+    q15_t state[MAX_COLS * MAX_ROWS];           /* scratch of arm_mat_mult_q15 */
+  } q15;
+} layer;
+
+float32_t bias_f32[MAX_ROWS];
+float32_t input_f32[NUM_VECTORS * MAX_COLS];
+float32_t refOut_f32[NUM_VECTORS * MAX_ROWS];
+float32_t testOut_f32[NUM_VECTORS * MAX_ROWS];
+
+q15_t bias_q15[MAX_ROWS];
+q15_t input_q15[NUM_VECTORS * MAX_COLS];
+q15_t refOut_q15[NUM_VECTORS * MAX_ROWS];
+q15_t testOut_q15[NUM_VECTORS * MAX_ROWS];
+
+uint32_t cycleCount[NUM_SHAPES][4];
+float32_t snr[NUM_SHAPES];
+uint32_t maxDiff[NUM_SHAPES];
+
+/* ----------------------------------------------------------------------
+* Deterministic test data in [-1, 1)
+* ------------------------------------------------------------------- */
+static uint32_t seed = 12345u;
+
+static float32_t rand_f32(void)
+{
+  seed = seed * 1664525u + 1013904223u;
+  return ((float32_t) (int32_t) seed) / 2147483648.0f;
+}
+
+/* ----------------------------------------------------------------------
+* Batched fully connected layer benchmark
+* ------------------------------------------------------------------- */
+
+int32_t main(void)
+{
+  arm_matrix_instance_f32 X, WT, Y;             /* reference matrix instances */
+  arm_matrix_instance_q15 Xq, WTq, Yq;
+  arm_fully_connected_instance_f32 S;
+  arm_fully_connected_instance_q15 Sq;
+  arm_status status = ARM_MATH_SUCCESS;
+  uint32_t shape, r, c, i, start;
+  uint16_t numRows, numCols;
+  q31_t acc;
+
+  /* Enable the DWT cycle counter */
+  DEM_CR |= (1u << 24);
+  DWT_CYCCNT = 0u;
+  DWT_CTRL |= 1u;
+
+  for (shape = 0u; shape < NUM_SHAPES; shape++)
+  {
+    numRows = numRowsTest[shape];
+    numCols = numColsTest[shape];
+
+    /* ------------------------------------------------------------------
+    * Floating-point layer
+    * ------------------------------------------------------------------- */
+    for (r = 0u; r < numRows; r++)
+    {
+      for (c = 0u; c < numCols; c++)
+      {
+        layer.f32.W[r * numCols + c] = rand_f32() / numCols;
+        layer.f32.WT[c * numRows + r] = layer.f32.W[r * numCols + c];
+      }
+      bias_f32[r] = rand_f32() * 0.25f;
+    }
+
+    for (i = 0u; i < NUM_VECTORS * numCols; i++)
+    {
+      input_f32[i] = rand_f32();
+    }
+
+    /* Reference: per-call matrix setup, generic product, separate bias and ReLU pass */
+    start = DWT_CYCCNT;
+    arm_mat_init_f32(&X, NUM_VECTORS, numCols, input_f32);
+    arm_mat_init_f32(&WT, numCols, numRows, layer.f32.WT);
+    arm_mat_init_f32(&Y, NUM_VECTORS, numRows, refOut_f32);
+    status = arm_mat_mult_f32(&X, &WT, &Y);
+
+    for (i = 0u; i < NUM_VECTORS * numRows; i++)
+    {
+      refOut_f32[i] += bias_f32[i % numRows];
+      refOut_f32[i] = (refOut_f32[i] > 0.0f) ? refOut_f32[i] : 0.0f;
+    }
+    cycleCount[shape][0] = DWT_CYCCNT - start;
+
+    /* Batched kernel with the fused epilogue */
+    arm_fully_connected_init_f32(&S, numRows, numCols, layer.f32.W, bias_f32, 1u);
+
+    start = DWT_CYCCNT;
+    arm_fully_connected_batch_f32(&S, input_f32, testOut_f32, NUM_VECTORS);
+    cycleCount[shape][1] = DWT_CYCCNT - start;
+
+    snr[shape] = arm_snr_f32(refOut_f32, testOut_f32, NUM_VECTORS * numRows);
+
+    if(snr[shape] < SNR_THRESHOLD)
+    {
+      status = ARM_MATH_TEST_FAILURE;
+    }
+
+    /* ------------------------------------------------------------------
+    * Q15 layer, weights scaled down by numCols so the 32-bit accumulator cannot wrap
+    * ------------------------------------------------------------------- */
+    for (r = 0u; r < numRows; r++)
+    {
+      for (c = 0u; c < numCols; c++)
+      {
+        layer.q15.W[r * numCols + c] = (q15_t) (rand_f32() * 32767.0f / numCols);
+        layer.q15.WT[c * numRows + r] = layer.q15.W[r * numCols + c];
+      }
+      bias_q15[r] = (q15_t) (rand_f32() * 8192.0f);
+    }
+
+    for (i = 0u; i < NUM_VECTORS * numCols; i++)
+    {
+      input_q15[i] = (q15_t) (rand_f32() * 32767.0f);
+    }
+
+    start = DWT_CYCCNT;
+    arm_mat_init_q15(&Xq, NUM_VECTORS, numCols, input_q15);
+    arm_mat_init_q15(&WTq, numCols, numRows, layer.q15.WT);
+    arm_mat_init_q15(&Yq, NUM_VECTORS, numRows, refOut_q15);
+    status = (status != ARM_MATH_SUCCESS) ? status : arm_mat_mult_q15(&Xq, &WTq, &Yq, layer.q15.state);
+
+    for (i = 0u; i < NUM_VECTORS * numRows; i++)
+    {
+      acc = (q31_t) refOut_q15[i] + bias_q15[i % numRows];
+      refOut_q15[i] = (q15_t) __SSAT((acc > 0) ? acc : 0, 16);
+    }
+    cycleCount[shape][2] = DWT_CYCCNT - start;
+
+    arm_fully_connected_init_q15(&Sq, numRows, numCols, layer.q15.W, bias_q15, 15, 15, 1u);
+
+    start = DWT_CYCCNT;
+    arm_fully_connected_batch_q15(&Sq, input_q15, testOut_q15, NUM_VECTORS);
+    cycleCount[shape][3] = DWT_CYCCNT - start;
+
+    /* Both paths truncate the same 2.30 sums, so they agree to one LSB */
+    maxDiff[shape] = arm_compare_fixed_q15(refOut_q15, testOut_q15, NUM_VECTORS * numRows);
+
+    if(maxDiff[shape] > 1u)
+    {
+      status = ARM_MATH_TEST_FAILURE;
+    }
+  }
+
+  /* ----------------------------------------------------------------------
+  ** Loop here if the signals fail the PASS check.
+  ** This denotes a test failure
+  ** ------------------------------------------------------------------- */
+  if( status != ARM_MATH_SUCCESS)
+  {
+    while(1);
+  }
+
+  while(1);                             /* main function does not return */
+}
+
+ /** \endlink */
@@ -0,0 +1,295 @@
+/* ----------------------------------------------------------------------
+* Copyright (C) 2010-2014 ARM Limited. All rights reserved.
+*
+* $Date:         19. October 2026
+* $Revision:     V1.4.4
+*
+* Project:       CMSIS DSP Library
+* Title:         arm_moments_example_f32.c
+*
+* Description:   Example code comparing the single pass moments functions
+*                with separate statistics calls
+*
+* Target Processor: Cortex-M4/Cortex-M3
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions
+* are met:
+*   - Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   - Redistributions in binary form must reproduce the above copyright
+*     notice, this list of conditions and the following disclaimer in
+*     the documentation and/or other materials provided with the
+*     distribution.
+*   - Neither the name of ARM LIMITED nor the names of its contributors
+*     may be used to endorse or promote products derived from this
+*     software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+ * -------------------------------------------------------------------- */
+
+/**
+ * @ingroup groupExamples
+ */
+
+/**
+ * @defgroup MomentsExample Moments Example
+ *
+ * \par Description:
+ * \par
+ * Benchmarks the single pass moments functions against the separate
+ * mean, variance, rms, minimum and maximum functions that a feature
+ * extraction stage would otherwise call on the same frame.
+ *
+ * \par Algorithm:
+ * \par
+ * A frame of \c FRAME_SIZE samples (a tone with an offset and skewed noise) is processed
+ * in floating-point, Q31 and Q15. For each data type the five separate functions
+ * are timed together and compared with one call of the moments function.
+ * The fixed-point results must be identical to the separate calls. The Q31 rms
+ * value is checked against the floating-point one instead, because
+ * <code>arm_rms_q31()</code> accumulates in 2.62 format and wraps for a frame
+ * of this length. The skewness and kurtosis are checked against a two pass
+ * computation in double precision.
+ *
+ * \par Variables Description:
+ * \par
+ * \li \c cycleCount cycles per frame: separate f32, moments f32, separate q31, moments q31, separate q15, moments q15
+ * \li \c refSkewness, \c refKurtosis two pass reference values
+ * \li \c results_f32, \c results_q31, \c results_q15 statistics returned by the moments functions
+ *
+ * \par CMSIS DSP Software Library Functions Used:
+ * \par
+ * - arm_mean_f32(), arm_var_f32(), arm_rms_f32(), arm_min_f32(), arm_max_f32()
+ * - arm_mean_q31(), arm_var_q31(), arm_rms_q31(), arm_min_q31(), arm_max_q31()
+ * - arm_mean_q15(), arm_var_q15(), arm_rms_q15(), arm_min_q15(), arm_max_q15()
+ * - arm_moments_f32()
+ * - arm_moments_q31()
+ * - arm_moments_q15()
+ *
+ * <b> Refer  </b>
+ * \link arm_moments_example_f32.c \endlink
+ *
+ */
+
+
+/** \example arm_moments_example_f32.c
+  */
+
+#include "arm_math.h"
+
+#define FRAME_SIZE          4096
+#define REL_TOLERANCE       1.0e-4f
+#define SHAPE_TOLERANCE     1.0e-2f             /* absolute, for skewness and kurtosis */
+
+/* ----------------------------------------------------------------------
+* DWT cycle counter of the Cortex-M3/M4 debug unit, the counts stay 0 on
+* a PC
+* ------------------------------------------------------------------- */
+#if defined(ARM_MATH_HOST)
+#include <stdio.h>
+static volatile uint32_t DEM_CR, DWT_CTRL, DWT_CYCCNT;
+#else
+#define DEM_CR          (*(volatile uint32_t *) 0xE000EDFCu)
+#define DWT_CTRL        (*(volatile uint32_t *) 0xE0001000u)
+#define DWT_CYCCNT      (*(volatile uint32_t *) 0xE0001004u)
+#endif
+
+/* ----------------------------------------------------------------------
+* Test frames
+* ------------------------------------------------------------------- */
+float32_t frame_f32[FRAME_SIZE];
+q31_t frame_q31[FRAME_SIZE];
+q15_t frame_q15[FRAME_SIZE];
+
+arm_moments_result_f32 results_f32;
+arm_moments_result_q31 results_q31;
+arm_moments_result_q15 results_q15;
+
+uint32_t cycleCount[6];
+float32_t refSkewness, refKurtosis;
+
+/* ----------------------------------------------------------------------
+* Deterministic noise in [-1, 1)
+* ------------------------------------------------------------------- */
+static uint32_t seed = 12345u;
+
+static float32_t rand_f32(void)
+{
+  seed = seed * 1664525u + 1013904223u;
+  return ((float32_t) (int32_t) seed) / 2147483648.0f;
+}
+
+static uint32_t rel_error_ok(float32_t test, float32_t ref, float32_t tolerance)
+{
+  float32_t err = (test > ref) ? (test - ref) : (ref - test);
+  float32_t mag = (ref > 0.0f) ? ref : -ref;
+
+  return (err <= tolerance * mag) ? 1u : 0u;
+}
+
+static uint32_t abs_error_ok(float32_t test, float32_t ref, float32_t tolerance)
+{
+  float32_t err = (test > ref) ? (test - ref) : (ref - test);
+
+  return (err <= tolerance) ? 1u : 0u;
+}
+
+/* ----------------------------------------------------------------------
+* Single pass moments benchmark
+* ------------------------------------------------------------------- */
+
+int32_t main(void)
+{
+  arm_status status = ARM_MATH_SUCCESS;
+  float32_t mean_f32, var_f32, rms_f32, min_f32, max_f32, noise;
+  q31_t mean_q31, var_q31, rms_q31, min_q31, max_q31;
+  q15_t mean_q15, var_q15, rms_q15, min_q15, max_q15;
+  uint32_t minIndex, maxIndex, i, start;
+  float64_t mu, d, m2, m3, m4;
+
+  /* Enable the DWT cycle counter */
+  DEM_CR |= (1u << 24);
+  DWT_CYCCNT = 0u;
+  DWT_CTRL |= 1u;
+
+  /* Tone with an offset, a second harmonic and skewed noise, within [-0.5, 0.7) */
+  for (i = 0u; i < FRAME_SIZE; i++)
+  {
+    noise = rand_f32();
+    frame_f32[i] = 0.1f + 0.25f * arm_sin_f32(2.0f * PI * 0.01f * i)
+                 + 0.05f * arm_sin_f32(2.0f * PI * 0.02f * i) + 0.3f * noise * noise;
+  }
+
+  arm_float_to_q31(frame_f32, frame_q31, FRAME_SIZE);
+  arm_float_to_q15(frame_f32, frame_q15, FRAME_SIZE);
+
+  /* Two pass reference of the shape statistics */
+  mu = 0.0;
+  for (i = 0u; i < FRAME_SIZE; i++)
+  {
+    mu += frame_f32[i];
+  }
+  mu /= FRAME_SIZE;
+
+  m2 = m3 = m4 = 0.0;
+  for (i = 0u; i < FRAME_SIZE; i++)
+  {
+    d = frame_f32[i] - mu;
+    m2 += d * d;
+    m3 += d * d * d;
+    m4 += d * d * d * d;
+  }
+  m2 /= FRAME_SIZE;
+  m3 /= FRAME_SIZE;
+  m4 /= FRAME_SIZE;
+
+  refSkewness = (float32_t) (m3 / (m2 * sqrt(m2)));
+  refKurtosis = (float32_t) (m4 / (m2 * m2));
+
+  /* ------------------------------------------------------------------
+  * Floating-point
+  * ------------------------------------------------------------------- */
+  start = DWT_CYCCNT;
+  arm_mean_f32(frame_f32, FRAME_SIZE, &mean_f32);
+  arm_var_f32(frame_f32, FRAME_SIZE, &var_f32);
+  arm_rms_f32(frame_f32, FRAME_SIZE, &rms_f32);
+  arm_min_f32(frame_f32, FRAME_SIZE, &min_f32, &minIndex);
+  arm_max_f32(frame_f32, FRAME_SIZE, &max_f32, &maxIndex);
+  cycleCount[0] = DWT_CYCCNT - start;
+
+  start = DWT_CYCCNT;
+  arm_moments_f32(frame_f32, FRAME_SIZE, &results_f32);
+  cycleCount[1] = DWT_CYCCNT - start;
+
+  if((rel_error_ok(results_f32.mean, mean_f32, REL_TOLERANCE) == 0u) ||
+     (rel_error_ok(results_f32.var, var_f32, REL_TOLERANCE) == 0u) ||
+     (rel_error_ok(results_f32.rms, rms_f32, REL_TOLERANCE) == 0u) ||
+     (results_f32.min != min_f32) || (results_f32.minIndex != minIndex) ||
+     (results_f32.max != max_f32) || (results_f32.maxIndex != maxIndex) ||
+     (abs_error_ok(results_f32.skewness, refSkewness, SHAPE_TOLERANCE) == 0u) ||
+     (abs_error_ok(results_f32.kurtosis, refKurtosis, SHAPE_TOLERANCE) == 0u))
+  {
+    status = ARM_MATH_TEST_FAILURE;
+  }
+
+  /* ------------------------------------------------------------------
+  * Q31
+  * ------------------------------------------------------------------- */
+  start = DWT_CYCCNT;
+  arm_mean_q31(frame_q31, FRAME_SIZE, &mean_q31);
+  arm_var_q31(frame_q31, FRAME_SIZE, &var_q31);
+  arm_rms_q31(frame_q31, FRAME_SIZE, &rms_q31);
+  arm_min_q31(frame_q31, FRAME_SIZE, &min_q31, &minIndex);
+  arm_max_q31(frame_q31, FRAME_SIZE, &max_q31, &maxIndex);
+  cycleCount[2] = DWT_CYCCNT - start;
+
+  start = DWT_CYCCNT;
+  arm_moments_q31(frame_q31, FRAME_SIZE, &results_q31);
+  cycleCount[3] = DWT_CYCCNT - start;
+
+  if((results_q31.mean != mean_q31) || (results_q31.var != var_q31) ||
+     (rel_error_ok(results_q31.rms / 2147483648.0f, rms_f32, REL_TOLERANCE) == 0u) ||
+     (results_q31.min != min_q31) || (results_q31.minIndex != minIndex) ||
+     (results_q31.max != max_q31) || (results_q31.maxIndex != maxIndex) ||
+     (abs_error_ok(results_q31.skewness, refSkewness, SHAPE_TOLERANCE) == 0u) ||
+     (abs_error_ok(results_q31.kurtosis, refKurtosis, SHAPE_TOLERANCE) == 0u))
+  {
+    status = ARM_MATH_TEST_FAILURE;
+  }
+
+  /* ------------------------------------------------------------------
+  * Q15
+  * ------------------------------------------------------------------- */
+  start = DWT_CYCCNT;
+  arm_mean_q15(frame_q15, FRAME_SIZE, &mean_q15);
+  arm_var_q15(frame_q15, FRAME_SIZE, &var_q15);
+  arm_rms_q15(frame_q15, FRAME_SIZE, &rms_q15);
+  arm_min_q15(frame_q15, FRAME_SIZE, &min_q15, &minIndex);
+  arm_max_q15(frame_q15, FRAME_SIZE, &max_q15, &maxIndex);
+  cycleCount[4] = DWT_CYCCNT - start;
+
+  start = DWT_CYCCNT;
+  arm_moments_q15(frame_q15, FRAME_SIZE, &results_q15);
+  cycleCount[5] = DWT_CYCCNT - start;
+
+  if((results_q15.mean != mean_q15) || (results_q15.var != var_q15) ||
+     (results_q15.rms != rms_q15) ||
+     (results_q15.min != min_q15) || (results_q15.minIndex != minIndex) ||
+     (results_q15.max != max_q15) || (results_q15.maxIndex != maxIndex) ||
+     (abs_error_ok(results_q15.skewness, refSkewness, SHAPE_TOLERANCE) == 0u) ||
+     (abs_error_ok(results_q15.kurtosis, refKurtosis, SHAPE_TOLERANCE) == 0u))
+  {
+    status = ARM_MATH_TEST_FAILURE;
+  }
+
+#if defined(ARM_MATH_HOST)
+  printf("%s\n", (status == ARM_MATH_SUCCESS) ? "PASS" : "FAIL");
+
+  return ((status == ARM_MATH_SUCCESS) ? 0 : 1);
+#else
+  /* ----------------------------------------------------------------------
+  ** Loop here if the signals fail the PASS check.
+  ** This denotes a test failure
+  ** ------------------------------------------------------------------- */
+  if( status != ARM_MATH_SUCCESS)
+  {
+    while(1);
+  }
+
+  while(1);                             /* main function does not return */
+#endif
+}
+
+ /** \endlink */
@@ -184,6 +184,8 @@ const uint16_t armBitRevTable[1024] = {
 };
 
 
+#ifndef ARM_FFT_TABLES_GENERATED
+
 /*    
 * @brief  Floating-point Twiddle factors Table Generation    
 */
@@ -21182,6 +21184,8 @@ const q15_t twiddleCoef_4096_q15[6144] =
     0xFFCD, 0x8000
 };
 
+#endif /* ARM_FFT_TABLES_GENERATED */
+
 
 /**    
 * @} end of CFFT_CIFFT group    
@@ -21221,6 +21225,8 @@ const q31_t armRecipTableQ31[64] = {
   0x41CCDDB6, 0x4146A3C6, 0x40C28923, 0x40408102
 };
 
+#ifndef ARM_FFT_TABLES_GENERATED
+
 const uint16_t armBitRevIndexTable16[ARMBITREVINDEXTABLE__16_TABLE_LENGTH] = 
 {
    //8x2, size 20
@@ -26971,6 +26977,8 @@ const float32_t twiddleCoef_rfft_4096[4096] = {
     0.001533980f, -0.999998823f
 };
 
+#endif /* ARM_FFT_TABLES_GENERATED */
+
 
 /**   
  * \par    
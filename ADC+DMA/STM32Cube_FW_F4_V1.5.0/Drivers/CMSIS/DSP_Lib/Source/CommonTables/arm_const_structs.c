@@ -42,6 +42,9 @@
 
 #include "arm_const_structs.h"
 
+/* With ARM_FFT_TABLES_GENERATED the instances are defined in arm_fft_tables_gen.c */
+#ifndef ARM_FFT_TABLES_GENERATED
+
 //Floating-point structs
 
 const arm_cfft_instance_f32 arm_cfft_sR_f32_len16 = {
@@ -154,3 +157,5 @@ const arm_cfft_instance_q15 arm_cfft_sR_q15_len2048 = {
 const arm_cfft_instance_q15 arm_cfft_sR_q15_len4096 = {
 	4096, twiddleCoef_4096_q15, armBitRevIndexTable_fixed_4096, ARMBITREVINDEXTABLE_FIXED_4096_TABLE_LENGTH
 };
+
+#endif /* ARM_FFT_TABLES_GENERATED */
@@ -0,0 +1,240 @@
+/* ----------------------------------------------------------------------
+* Copyright (C) 2010-2014 ARM Limited. All rights reserved.
+*
+* $Date:        19. October 2026
+* $Revision: 	V1.4.4
+*
+* Project: 	    CMSIS DSP Library
+* Title:	    arm_ddc_f32.c
+*
+* Description:	 Floating-point digital down converter.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions
+* are met:
+*   - Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   - Redistributions in binary form must reproduce the above copyright
+*     notice, this list of conditions and the following disclaimer in
+*     the documentation and/or other materials provided with the
+*     distribution.
+*   - Neither the name of ARM LIMITED nor the names of its contributors
+*     may be used to endorse or promote products derived from this
+*     software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------- */
+
+
+#include "arm_math.h"
+#include "arm_common_tables.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @defgroup DDC Digital Down Converter
+ *
+ * Moves a narrow band around the frequency <code>centerFreq</code> of a real
+ * signal to complex baseband and reduces the sample rate by <code>R*M</code>,
+ * so that the band can be analyzed with a small complex FFT instead of a
+ * real FFT of the whole input frame.
+ *
+ * <pre>
+ *                  +------+     +-----------+     +---------------+
+ *   x[n] ---(X)--->| CIC  |---->| ...       |---->| FIR, decimate |----> y[m] = I + jQ
+ *            |     | /R   |     |           |     | by M          |
+ *            |     +------+     +-----------+     +---------------+
+ *   exp(-j*2*pi*centerFreq*n)
+ * </pre>
+ *
+ * \par Algorithm
+ * The numerically controlled oscillator (NCO) is a 32-bit phase accumulator.
+ * Its sine and cosine are read from <code>sinTable_f32</code> with linear
+ * interpolation, as in the fast math functions, which keeps the spurs below
+ * -90 dB. The input sample is multiplied by the NCO to give the in-phase
+ * and quadrature channels.
+ * \par
+ * Each channel is decimated by <code>R</code> with a cascaded
+ * integrator-comb (CIC) filter of <code>numStages</code> stages and unit
+ * differential delay. The CIC runs on integers with wrap-around arithmetic so
+ * that the integrators never lose precision. The mixer output is scaled to
+ * <code>30 - numStages*ceil(log2(R))</code> bits and the CIC output is scaled
+ * back, so the CIC has unity gain at DC.
+ * \par
+ * The CIC frequency response droops across the passband:
+ * <pre>
+ *     |H(f)| = |sin(pi*f*R) / (R*sin(pi*f))|^numStages      f relative to the input rate
+ * </pre>
+ * A floating-point FIR decimator (see \ref FIR_decimate) compensates the
+ * droop, removes the band that would alias and decimates by <code>M</code>.
+ * Its coefficients are supplied by the user.
+ *
+ * \par Streaming
+ * The NCO phase, the CIC and the FIR states are kept in the instance, so
+ * consecutive blocks of a continuous stream, such as the halves of a
+ * circular DMA buffer, can be processed one call at a time.
+ * Each call reads <code>blockSize</code> real samples and writes
+ * <code>blockSize/(R*M)</code> complex samples, interleaved
+ * <code>{real, imag, real, imag, ...}</code> as expected by
+ * <code>arm_cfft_f32()</code>.
+ *
+ * \par Instance Structure
+ * The NCO, CIC and FIR states are stored in the instance structure. A
+ * separate instance structure must be defined for each converter. The
+ * coefficient array may be shared among several instances.
+ *
+ * \par Initialization Function
+ * The function arm_ddc_init_f32() checks the parameters, sets the NCO
+ * frequency and clears the states.
+ */
+
+/**
+ * @addtogroup DDC
+ * @{
+ */
+
+/**
+ * @brief Processing function for the floating-point digital down converter.
+ * @param[in,out] *S points to an instance of the floating-point digital down converter structure.
+ * @param[in]  *pSrc points to the block of real input data.
+ * @param[out] *pDst points to the block of complex output data, blockSize/(R*M) interleaved samples.
+ * @param[in]  blockSize number of input samples to process per call.
+ * @return none.
+ *
+ * \par
+ * <code>blockSize</code> must be a multiple of <code>R*M</code> and not larger
+ * than the value passed to arm_ddc_init_f32().
+ */
+
+void arm_ddc_f32(
+  arm_ddc_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize)
+{
+  uint32_t numStages = S->numStages;             /* Number of CIC stages */
+  uint32_t numCic = blockSize / S->R;            /* Number of CIC outputs */
+  q31_t *pIntI = S->pCicState;                   /* In-phase integrators */
+  q31_t *pIntQ = pIntI + numStages;              /* Quadrature integrators */
+  q31_t *pCombI = pIntQ + numStages;             /* In-phase comb delays */
+  q31_t *pCombQ = pCombI + numStages;            /* Quadrature comb delays */
+  float32_t *pCicI = S->pScratch;                /* In-phase CIC output */
+  float32_t *pCicQ = S->pScratch + numCic;       /* Quadrature CIC output */
+  float32_t *pOutI, *pOutQ;                      /* Pointers to the CIC outputs */
+  float32_t inScale = S->cicInScale;             /* Scale of the CIC input */
+  float32_t outScale = S->cicOutScale;           /* Scale of the CIC output */
+  uint32_t phase = S->phase;                     /* NCO phase */
+  uint32_t phaseInc = S->phaseInc;               /* NCO phase increment */
+  uint16_t count = S->count;                     /* Samples left before the next CIC output */
+  float32_t in, fract, a, b;                     /* Input sample, table interpolation values */
+  float32_t sinVal, cosVal;                      /* NCO outputs */
+  uint32_t accI, accQ, prev;                     /* CIC accumulators */
+  uint32_t index, k;                             /* Table index, stage index */
+  uint32_t blkCnt;                               /* loop counter */
+
+  pOutI = pCicI;
+  pOutQ = pCicQ;
+
+  /* Mixer and CIC integrators at the input rate, combs at the decimated rate */
+  blkCnt = blockSize;
+
+  while(blkCnt > 0u)
+  {
+    /* The 9 most significant bits of the phase index the table, the other
+     * 23 bits interpolate between two entries.
+     * The cosine is the sine a quarter cycle later, which has the same fraction. */
+    index = phase >> 23;
+    fract = (float32_t) (phase & 0x7FFFFFu) * 1.1920928955e-7f;
+
+    a = sinTable_f32[index];
+    b = sinTable_f32[index + 1u];
+    sinVal = a + (fract * (b - a));
+
+    index = (phase + 0x40000000u) >> 23;
+
+    a = sinTable_f32[index];
+    b = sinTable_f32[index + 1u];
+    cosVal = a + (fract * (b - a));
+
+    phase += phaseInc;
+
+    /* Multiply by exp(-j*phase) and convert to the integer range of the CIC */
+    in = *pSrc++ * inScale;
+    accI = (uint32_t) (q31_t) (in * cosVal);
+    accQ = (uint32_t) (q31_t) (-in * sinVal);
+
+    /* Integrator stages, modulo 2^32 */
+    for (k = 0u; k < numStages; k++)
+    {
+      accI += (uint32_t) pIntI[k];
+      pIntI[k] = (q31_t) accI;
+
+      accQ += (uint32_t) pIntQ[k];
+      pIntQ[k] = (q31_t) accQ;
+    }
+
+    count--;
+
+    if(count == 0u)
+    {
+      count = S->R;
+
+      /* Comb stages on every R-th integrator output */
+      for (k = 0u; k < numStages; k++)
+      {
+        prev = accI;
+        accI -= (uint32_t) pCombI[k];
+        pCombI[k] = (q31_t) prev;
+
+        prev = accQ;
+        accQ -= (uint32_t) pCombQ[k];
+        pCombQ[k] = (q31_t) prev;
+      }
+
+      *pOutI++ = (float32_t) ((q31_t) accI) * outScale;
+      *pOutQ++ = (float32_t) ((q31_t) accQ) * outScale;
+    }
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  S->phase = phase;
+  S->count = count;
+
+  /* Compensating FIR decimators, in place: the decimator writes its outputs
+   * only over input samples that it has already read */
+  arm_fir_decimate_f32(&S->firI, pCicI, pCicI, numCic);
+  arm_fir_decimate_f32(&S->firQ, pCicQ, pCicQ, numCic);
+
+  /* Interleave the channels as complex samples */
+  blkCnt = numCic / S->firI.M;
+
+  while(blkCnt > 0u)
+  {
+    *pDst++ = *pCicI++;
+    *pDst++ = *pCicQ++;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+}
+
+/**
+ * @} end of DDC group
+ */
@@ -0,0 +1,169 @@
+/* ----------------------------------------------------------------------
+* Copyright (C) 2010-2014 ARM Limited. All rights reserved.
+*
+* $Date:        19. October 2026
+* $Revision: 	V1.4.4
+*
+* Project: 	    CMSIS DSP Library
+* Title:	    arm_ddc_init_f32.c
+*
+* Description:	 Floating-point digital down converter initialization function.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions
+* are met:
+*   - Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   - Redistributions in binary form must reproduce the above copyright
+*     notice, this list of conditions and the following disclaimer in
+*     the documentation and/or other materials provided with the
+*     distribution.
+*   - Neither the name of ARM LIMITED nor the names of its contributors
+*     may be used to endorse or promote products derived from this
+*     software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------- */
+
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupFilters
+ */
+
+/**
+ * @addtogroup DDC
+ * @{
+ */
+
+/**
+ * @brief  Initialization function for the floating-point digital down converter.
+ * @param[in,out] *S points to an instance of the floating-point digital down converter structure.
+ * @param[in] centerFreq NCO frequency normalized to the input sample rate, in the range [-0.5 0.5).
+ * @param[in] numStages number of CIC stages.
+ * @param[in] R CIC decimation factor.
+ * @param[in] numTaps number of coefficients of the compensating FIR.
+ * @param[in] M decimation factor of the compensating FIR.
+ * @param[in] *pCoeffs points to the compensating FIR coefficients.
+ * @param[in] *pState points to the FIR state buffer.
+ * @param[in] *pCicState points to the CIC state buffer.
+ * @param[in] *pScratch points to the scratch buffer.
+ * @param[in] blockSize number of input samples to process per call.
+ * @return    The function returns ARM_MATH_SUCCESS if initialization is successful, ARM_MATH_LENGTH_ERROR if
+ * <code>blockSize</code> is not a multiple of <code>R*M</code> or ARM_MATH_ARGUMENT_ERROR if the CIC gain leaves
+ * less than 12 bits for the input.
+ *
+ * <b>Description:</b>
+ * \par
+ * <code>pCoeffs</code> points to the FIR coefficients stored in time reversed order:
+ * <pre>
+ *    {b[numTaps-1], b[numTaps-2], b[N-2], ..., b[1], b[0]}
+ * </pre>
+ * The FIR runs at the CIC output rate. Its gain at DC should be 1.
+ * \par
+ * <code>pState</code> is of length <code>2*(numTaps+blockSize/R-1)</code> words,
+ * <code>pCicState</code> of length <code>4*numStages</code> words and
+ * <code>pScratch</code> of length <code>2*blockSize/R</code> words.
+ * \par
+ * The CIC gain is <code>R^numStages</code>. The input is converted to
+ * <code>30 - numStages*ceil(log2(R))</code> bits, which must be at least 12:
+ * for example 4 stages with <code>R</code> up to 16, or 3 stages with
+ * <code>R</code> up to 64. The input samples are expected in the range [-1 +1].
+ */
+
+arm_status arm_ddc_init_f32(
+  arm_ddc_instance_f32 * S,
+  float32_t centerFreq,
+  uint8_t numStages,
+  uint16_t R,
+  uint16_t numTaps,
+  uint8_t M,
+  float32_t * pCoeffs,
+  float32_t * pState,
+  q31_t * pCicState,
+  float32_t * pScratch,
+  uint32_t blockSize)
+{
+  arm_status status;
+  uint32_t numCic;                               /* Number of CIC outputs per block */
+  uint32_t bitGrowth = 0u;                       /* Number of bits added by the CIC */
+  float32_t gain = 1.0f;                         /* CIC gain */
+  uint32_t i;                                    /* Loop counter */
+
+  if((R == 0u) || (M == 0u) || ((blockSize % ((uint32_t) R * M)) != 0u))
+  {
+    /* Set status as ARM_MATH_LENGTH_ERROR */
+    status = ARM_MATH_LENGTH_ERROR;
+  }
+  else
+  {
+    /* Bit growth of the CIC: numStages * ceil(log2(R)) */
+    while((1u << bitGrowth) < R)
+    {
+      bitGrowth++;
+    }
+
+    bitGrowth *= numStages;
+
+    if((numStages == 0u) || ((bitGrowth + 12u) > 30u))
+    {
+      /* Set status as ARM_MATH_ARGUMENT_ERROR */
+      status = ARM_MATH_ARGUMENT_ERROR;
+    }
+    else
+    {
+      /* NCO phase increment, 2^32 is one cycle */
+      S->phase = 0u;
+      S->phaseInc = (uint32_t) (int32_t) (centerFreq * 4294967296.0f);
+
+      /* Assign CIC parameters */
+      S->numStages = numStages;
+      S->R = R;
+      S->count = R;
+
+      for (i = 0u; i < numStages; i++)
+      {
+        gain *= (float32_t) R;
+      }
+
+      S->cicInScale = (float32_t) (1u << (30u - bitGrowth));
+      S->cicOutScale = 1.0f / (S->cicInScale * gain);
+
+      /* Clear the integrators and the comb delays */
+      memset(pCicState, 0, (4u * numStages) * sizeof(q31_t));
+      S->pCicState = pCicState;
+
+      /* Assign scratch pointer */
+      S->pScratch = pScratch;
+
+      /* Compensating FIR decimators with separate states for the two channels */
+      numCic = blockSize / R;
+
+      arm_fir_decimate_init_f32(&S->firI, numTaps, M, pCoeffs, pState, numCic);
+      arm_fir_decimate_init_f32(&S->firQ, numTaps, M, pCoeffs,
+                                pState + (numTaps + (numCic - 1u)), numCic);
+
+      status = ARM_MATH_SUCCESS;
+    }
+  }
+
+  return (status);
+}
+
+/**
+ * @} end of DDC group
+ */
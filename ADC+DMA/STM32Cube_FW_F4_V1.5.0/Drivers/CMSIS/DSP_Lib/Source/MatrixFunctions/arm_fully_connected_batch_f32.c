@@ -0,0 +1,398 @@
+/* ----------------------------------------------------------------------
+* Copyright (C) 2010-2014 ARM Limited. All rights reserved.
+*
+* $Date:        19. October 2026
+* $Revision: 	V1.4.4
+*
+* Project: 	    CMSIS DSP Library
+* Title:	    arm_fully_connected_batch_f32.c
+*
+* Description:	 Batched floating-point fully connected layer.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions
+* are met:
+*   - Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   - Redistributions in binary form must reproduce the above copyright
+*     notice, this list of conditions and the following disclaimer in
+*     the documentation and/or other materials provided with the
+*     distribution.
+*   - Neither the name of ARM LIMITED nor the names of its contributors
+*     may be used to endorse or promote products derived from this
+*     software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupMatrix
+ */
+
+/**
+ * @defgroup FullyConnected Batched Fully Connected Layer
+ *
+ * Multiplies a constant weight matrix by a batch of input vectors,
+ * adds a bias and optionally applies a ReLU non-linearity:
+ * <pre>
+ *     pDst[v][r] = relu(pBias[r] + sum(pWeights[r][c] * pSrc[v][c], c = 0 .. numCols-1))
+ * </pre>
+ * where <code>v</code> is the vector index in the batch and <code>r</code> is the output index.
+ * The weight matrix is stored in row order (<code>numRows x numCols</code>), the
+ * <code>numVectors</code> input vectors of length <code>numCols</code> are stored one
+ * after the other in <code>pSrc</code> and the outputs of length <code>numRows</code> are
+ * written one after the other in <code>pDst</code>.
+ *
+ * \par
+ * Compared to <code>arm_mat_mult_f32()</code> the weights are never transposed or
+ * copied and the instance is set up once per layer. On Cortex-M3 and Cortex-M4 the
+ * floating-point kernel computes two outputs for four vectors per pass (the Q15 and Q7
+ * kernels two outputs for two vectors), so every weight fetched from flash is reused
+ * by several vectors of the batch while it is held in a register.
+ * Calling the functions with <code>numVectors = 1</code> gives a plain matrix-vector product.
+ *
+ * \par Init Functions
+ * There is an associated initialization function for each data type.
+ * The initialization function sets the values of the internal structure fields.
+ * The instance can also be placed in a const data section and initialized manually.
+ */
+
+/**
+ * @addtogroup FullyConnected
+ * @{
+ */
+
+/**
+ * @brief Batched floating-point fully connected layer.
+ * @param[in]       *S          points to an instance of the floating-point fully connected structure.
+ * @param[in]       *pSrc       points to the batch of input vectors (numVectors x numCols).
+ * @param[out]      *pDst       points to the batch of output vectors (numVectors x numRows).
+ * @param[in]       numVectors  number of input vectors in the batch.
+ * @return none.
+ */
+
+void arm_fully_connected_batch_f32(
+  const arm_fully_connected_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint16_t numVectors)
+{
+  float32_t *pW = S->pWeights;                   /* weight matrix pointer */
+  float32_t *pB = S->pBias;                      /* bias vector pointer */
+  uint16_t numRows = S->numRows;                 /* number of outputs */
+  uint16_t numCols = S->numCols;                 /* number of inputs */
+  uint8_t reluFlag = S->reluFlag;                /* ReLU epilogue flag */
+  float32_t *pW0;                                /* weight row pointer */
+  float32_t *px0;                                /* input vector pointer */
+  float32_t *pOut;                               /* output pointer */
+  float32_t acc0, b0;                            /* accumulator and bias */
+  uint32_t vec, row, col;                        /* loop counters */
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  float32_t *pW1;                                /* second weight row pointer */
+  float32_t *px1, *px2, *px3;                    /* input vector pointers */
+  float32_t acc1, acc2, acc3;                    /* accumulators of the first row */
+  float32_t acc4, acc5, acc6, acc7;              /* accumulators of the second row */
+  float32_t w0, w1, x0, x1, x2, x3;              /* temporary operands */
+  float32_t b1;                                  /* bias of the second row */
+  uint32_t i;                                    /* output row index */
+
+  /* First part of the processing: four vectors of the batch share every weight load.
+   ** The remaining 1 to 3 vectors are processed one at a time below. */
+  vec = numVectors >> 2u;
+
+  while(vec > 0u)
+  {
+    /* Two rows of the weight matrix are processed per pass */
+    row = numRows >> 1u;
+    i = 0u;
+
+    while(row > 0u)
+    {
+      pW0 = pW + (i * numCols);
+      pW1 = pW0 + numCols;
+      px0 = pSrc;
+      px1 = px0 + numCols;
+      px2 = px1 + numCols;
+      px3 = px2 + numCols;
+
+      acc0 = acc1 = acc2 = acc3 = 0.0f;
+      acc4 = acc5 = acc6 = acc7 = 0.0f;
+
+      col = numCols;
+
+      while(col > 0u)
+      {
+        /* Each weight is read once and applied to the four vectors */
+        w0 = *pW0++;
+        w1 = *pW1++;
+        x0 = *px0++;
+        x1 = *px1++;
+        x2 = *px2++;
+        x3 = *px3++;
+
+        acc0 += w0 * x0;
+        acc1 += w0 * x1;
+        acc2 += w0 * x2;
+        acc3 += w0 * x3;
+        acc4 += w1 * x0;
+        acc5 += w1 * x1;
+        acc6 += w1 * x2;
+        acc7 += w1 * x3;
+
+        /* Decrement the loop counter */
+        col--;
+      }
+
+      /* Fused bias and ReLU epilogue */
+      b0 = (pB != NULL) ? pB[i] : 0.0f;
+      b1 = (pB != NULL) ? pB[i + 1u] : 0.0f;
+
+      acc0 += b0;
+      acc1 += b0;
+      acc2 += b0;
+      acc3 += b0;
+      acc4 += b1;
+      acc5 += b1;
+      acc6 += b1;
+      acc7 += b1;
+
+      if(reluFlag != 0u)
+      {
+        acc0 = (acc0 > 0.0f) ? acc0 : 0.0f;
+        acc1 = (acc1 > 0.0f) ? acc1 : 0.0f;
+        acc2 = (acc2 > 0.0f) ? acc2 : 0.0f;
+        acc3 = (acc3 > 0.0f) ? acc3 : 0.0f;
+        acc4 = (acc4 > 0.0f) ? acc4 : 0.0f;
+        acc5 = (acc5 > 0.0f) ? acc5 : 0.0f;
+        acc6 = (acc6 > 0.0f) ? acc6 : 0.0f;
+        acc7 = (acc7 > 0.0f) ? acc7 : 0.0f;
+      }
+
+      pOut = pDst + i;
+      pOut[0] = acc0;
+      pOut[1] = acc4;
+      pOut += numRows;
+      pOut[0] = acc1;
+      pOut[1] = acc5;
+      pOut += numRows;
+      pOut[0] = acc2;
+      pOut[1] = acc6;
+      pOut += numRows;
+      pOut[0] = acc3;
+      pOut[1] = acc7;
+
+      i += 2u;
+
+      /* Decrement the row loop counter */
+      row--;
+    }
+
+    /* Process the last row when numRows is odd */
+    if((numRows & 1u) != 0u)
+    {
+      pW0 = pW + (i * numCols);
+      px0 = pSrc;
+      px1 = px0 + numCols;
+      px2 = px1 + numCols;
+      px3 = px2 + numCols;
+
+      acc0 = acc1 = acc2 = acc3 = 0.0f;
+
+      col = numCols;
+
+      while(col > 0u)
+      {
+        w0 = *pW0++;
+
+        acc0 += w0 * *px0++;
+        acc1 += w0 * *px1++;
+        acc2 += w0 * *px2++;
+        acc3 += w0 * *px3++;
+
+        /* Decrement the loop counter */
+        col--;
+      }
+
+      b0 = (pB != NULL) ? pB[i] : 0.0f;
+
+      acc0 += b0;
+      acc1 += b0;
+      acc2 += b0;
+      acc3 += b0;
+
+      if(reluFlag != 0u)
+      {
+        acc0 = (acc0 > 0.0f) ? acc0 : 0.0f;
+        acc1 = (acc1 > 0.0f) ? acc1 : 0.0f;
+        acc2 = (acc2 > 0.0f) ? acc2 : 0.0f;
+        acc3 = (acc3 > 0.0f) ? acc3 : 0.0f;
+      }
+
+      pOut = pDst + i;
+      pOut[0] = acc0;
+      pOut[numRows] = acc1;
+      pOut[2u * numRows] = acc2;
+      pOut[3u * numRows] = acc3;
+    }
+
+    /* Advance to the next four vectors of the batch */
+    pSrc += 4u * numCols;
+    pDst += 4u * numRows;
+
+    /* Decrement the vector loop counter */
+    vec--;
+  }
+
+  /* If numVectors is not a multiple of 4, compute the remaining vectors here.
+   ** Two rows are still processed per pass so that each input sample is loaded once. */
+  vec = numVectors % 0x4u;
+
+  while(vec > 0u)
+  {
+    row = numRows >> 1u;
+    i = 0u;
+
+    while(row > 0u)
+    {
+      pW0 = pW + (i * numCols);
+      pW1 = pW0 + numCols;
+      px0 = pSrc;
+
+      acc0 = 0.0f;
+      acc4 = 0.0f;
+
+      col = numCols;
+
+      while(col > 0u)
+      {
+        x0 = *px0++;
+
+        acc0 += *pW0++ * x0;
+        acc4 += *pW1++ * x0;
+
+        /* Decrement the loop counter */
+        col--;
+      }
+
+      acc0 += (pB != NULL) ? pB[i] : 0.0f;
+      acc4 += (pB != NULL) ? pB[i + 1u] : 0.0f;
+
+      if(reluFlag != 0u)
+      {
+        acc0 = (acc0 > 0.0f) ? acc0 : 0.0f;
+        acc4 = (acc4 > 0.0f) ? acc4 : 0.0f;
+      }
+
+      pDst[i] = acc0;
+      pDst[i + 1u] = acc4;
+
+      i += 2u;
+
+      /* Decrement the row loop counter */
+      row--;
+    }
+
+    if((numRows & 1u) != 0u)
+    {
+      pW0 = pW + (i * numCols);
+      px0 = pSrc;
+
+      acc0 = 0.0f;
+
+      col = numCols;
+
+      while(col > 0u)
+      {
+        acc0 += *pW0++ * *px0++;
+
+        /* Decrement the loop counter */
+        col--;
+      }
+
+      acc0 += (pB != NULL) ? pB[i] : 0.0f;
+
+      if((reluFlag != 0u) && (acc0 < 0.0f))
+      {
+        acc0 = 0.0f;
+      }
+
+      pDst[i] = acc0;
+    }
+
+    pSrc += numCols;
+    pDst += numRows;
+
+    /* Decrement the vector loop counter */
+    vec--;
+  }
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  vec = numVectors;
+
+  while(vec > 0u)
+  {
+    pW0 = pW;
+    pOut = pDst;
+
+    for (row = 0u; row < numRows; row++)
+    {
+      px0 = pSrc;
+      acc0 = 0.0f;
+
+      col = numCols;
+
+      while(col > 0u)
+      {
+        acc0 += *pW0++ * *px0++;
+
+        /* Decrement the loop counter */
+        col--;
+      }
+
+      b0 = (pB != NULL) ? pB[row] : 0.0f;
+      acc0 += b0;
+
+      if((reluFlag != 0u) && (acc0 < 0.0f))
+      {
+        acc0 = 0.0f;
+      }
+
+      *pOut++ = acc0;
+    }
+
+    pSrc += numCols;
+    pDst += numRows;
+
+    /* Decrement the vector loop counter */
+    vec--;
+  }
+
+#endif /* #ifndef ARM_MATH_CM0_FAMILY */
+
+}
+
+/**
+ * @} end of FullyConnected group
+ */
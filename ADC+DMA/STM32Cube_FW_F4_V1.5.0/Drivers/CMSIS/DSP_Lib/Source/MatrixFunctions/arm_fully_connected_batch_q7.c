@@ -0,0 +1,397 @@
+/* ----------------------------------------------------------------------
+* Copyright (C) 2010-2014 ARM Limited. All rights reserved.
+*
+* $Date:        19. October 2026
+* $Revision: 	V1.4.4
+*
+* Project: 	    CMSIS DSP Library
+* Title:	    arm_fully_connected_batch_q7.c
+*
+* Description:	 Batched Q7 fully connected layer.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions
+* are met:
+*   - Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   - Redistributions in binary form must reproduce the above copyright
+*     notice, this list of conditions and the following disclaimer in
+*     the documentation and/or other materials provided with the
+*     distribution.
+*   - Neither the name of ARM LIMITED nor the names of its contributors
+*     may be used to endorse or promote products derived from this
+*     software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupMatrix
+ */
+
+/**
+ * @addtogroup FullyConnected
+ * @{
+ */
+
+/**
+ * @brief Applies the bias, output shift, ReLU and saturation to one Q7 output.
+ */
+
+static __INLINE q7_t arm_fully_connected_out_q7(
+  q31_t acc,
+  q31_t bias,
+  int8_t outShift,
+  uint8_t reluFlag)
+{
+  acc = (acc + bias) >> outShift;
+
+  if((reluFlag != 0u) && (acc < 0))
+  {
+    acc = 0;
+  }
+
+  return (q7_t) __SSAT(acc, 8);
+}
+
+/**
+ * @brief Batched Q7 fully connected layer.
+ * @param[in]       *S          points to an instance of the Q7 fully connected structure.
+ * @param[in]       *pSrc       points to the batch of input vectors (numVectors x numCols).
+ * @param[out]      *pDst       points to the batch of output vectors (numVectors x numRows).
+ * @param[in]       numVectors  number of input vectors in the batch.
+ * @return none.
+ *
+ * <b>Scaling and Overflow Behavior:</b>
+ * \par
+ * The inputs to the multiplications are in 1.7 format and the products in 2.14
+ * format are accumulated in a 32-bit accumulator in 18.14 format. There is no
+ * risk of wrap around as long as numCols is less than 2^17.
+ * The bias is shifted left by <code>biasShift</code> and added to the accumulator,
+ * the sum is shifted right by <code>outShift</code>, the ReLU is applied and the
+ * result is saturated to 1.7 format. With weights, inputs and bias in 1.7 format
+ * use <code>biasShift = 7</code> and <code>outShift = 7</code>.
+ */
+
+void arm_fully_connected_batch_q7(
+  const arm_fully_connected_instance_q7 * S,
+  q7_t * pSrc,
+  q7_t * pDst,
+  uint16_t numVectors)
+{
+  q7_t *pW = S->pWeights;                        /* weight matrix pointer */
+  q7_t *pB = S->pBias;                           /* bias vector pointer */
+  uint16_t numRows = S->numRows;                 /* number of outputs */
+  uint16_t numCols = S->numCols;                 /* number of inputs */
+  int8_t biasShift = S->biasShift;               /* bias left shift */
+  int8_t outShift = S->outShift;                 /* output right shift */
+  uint8_t reluFlag = S->reluFlag;                /* ReLU epilogue flag */
+  q7_t *pW0;                                     /* weight row pointer */
+  q7_t *px0;                                     /* input vector pointer */
+  q31_t acc0;                                    /* accumulator */
+  q31_t b0;                                      /* scaled bias */
+  uint32_t vec, row, col;                        /* loop counters */
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  q7_t *pW1;                                     /* second weight row pointer */
+  q7_t *px1;                                     /* second input vector pointer */
+  q31_t acc1, acc2, acc3;                        /* accumulators */
+  q31_t in;                                      /* four packed q7 samples */
+  q31_t wA, wB;                                  /* weights unpacked to q15 pairs */
+  q31_t x0A, x0B, x1A, x1B;                      /* inputs unpacked to q15 pairs */
+  q31_t b1;                                      /* scaled bias of the second row */
+  uint32_t i, k;                                 /* output row index, remaining columns */
+
+  /* First part of the processing: two vectors of the batch share every weight load.
+   ** A remaining odd vector is processed below. */
+  vec = numVectors >> 1u;
+
+  while(vec > 0u)
+  {
+    /* Two rows of the weight matrix are processed per pass */
+    row = numRows >> 1u;
+    i = 0u;
+
+    while(row > 0u)
+    {
+      pW0 = pW + (i * numCols);
+      pW1 = pW0 + numCols;
+      px0 = pSrc;
+      px1 = px0 + numCols;
+
+      acc0 = acc1 = acc2 = acc3 = 0;
+
+      /* Four columns are consumed per iteration */
+      col = numCols >> 2u;
+
+      while(col > 0u)
+      {
+        /* Unpack four q7 samples of each input vector to two q15 pairs */
+        in = *__SIMD32(px0)++;
+        x0A = __SXTB16(__ROR(in, 8));
+        x0B = __SXTB16(in);
+        in = *__SIMD32(px1)++;
+        x1A = __SXTB16(__ROR(in, 8));
+        x1B = __SXTB16(in);
+
+        /* Each weight word is read once and applied to both vectors */
+        in = *__SIMD32(pW0)++;
+        wA = __SXTB16(__ROR(in, 8));
+        wB = __SXTB16(in);
+        acc0 = __SMLAD(wA, x0A, acc0);
+        acc0 = __SMLAD(wB, x0B, acc0);
+        acc1 = __SMLAD(wA, x1A, acc1);
+        acc1 = __SMLAD(wB, x1B, acc1);
+
+        in = *__SIMD32(pW1)++;
+        wA = __SXTB16(__ROR(in, 8));
+        wB = __SXTB16(in);
+        acc2 = __SMLAD(wA, x0A, acc2);
+        acc2 = __SMLAD(wB, x0B, acc2);
+        acc3 = __SMLAD(wA, x1A, acc3);
+        acc3 = __SMLAD(wB, x1B, acc3);
+
+        /* Decrement the loop counter */
+        col--;
+      }
+
+      /* Process the remaining 1 to 3 columns */
+      k = numCols & 3u;
+
+      while(k > 0u)
+      {
+        acc0 += (q31_t) *pW0 * *px0;
+        acc1 += (q31_t) *pW0++ * *px1;
+        acc2 += (q31_t) *pW1 * *px0++;
+        acc3 += (q31_t) *pW1++ * *px1++;
+
+        /* Decrement the loop counter */
+        k--;
+      }
+
+      /* Fused bias, scaling and ReLU epilogue */
+      b0 = (pB != NULL) ? ((q31_t) pB[i] << biasShift) : 0;
+      b1 = (pB != NULL) ? ((q31_t) pB[i + 1u] << biasShift) : 0;
+
+      pDst[i] = arm_fully_connected_out_q7(acc0, b0, outShift, reluFlag);
+      pDst[i + 1u] = arm_fully_connected_out_q7(acc2, b1, outShift, reluFlag);
+      pDst[numRows + i] = arm_fully_connected_out_q7(acc1, b0, outShift, reluFlag);
+      pDst[numRows + i + 1u] = arm_fully_connected_out_q7(acc3, b1, outShift, reluFlag);
+
+      i += 2u;
+
+      /* Decrement the row loop counter */
+      row--;
+    }
+
+    /* Process the last row when numRows is odd */
+    if((numRows & 1u) != 0u)
+    {
+      pW0 = pW + (i * numCols);
+      px0 = pSrc;
+      px1 = px0 + numCols;
+
+      acc0 = acc1 = 0;
+
+      col = numCols >> 2u;
+
+      while(col > 0u)
+      {
+        in = *__SIMD32(pW0)++;
+        wA = __SXTB16(__ROR(in, 8));
+        wB = __SXTB16(in);
+
+        in = *__SIMD32(px0)++;
+        acc0 = __SMLAD(wA, __SXTB16(__ROR(in, 8)), acc0);
+        acc0 = __SMLAD(wB, __SXTB16(in), acc0);
+        in = *__SIMD32(px1)++;
+        acc1 = __SMLAD(wA, __SXTB16(__ROR(in, 8)), acc1);
+        acc1 = __SMLAD(wB, __SXTB16(in), acc1);
+
+        /* Decrement the loop counter */
+        col--;
+      }
+
+      k = numCols & 3u;
+
+      while(k > 0u)
+      {
+        acc0 += (q31_t) *pW0 * *px0++;
+        acc1 += (q31_t) *pW0++ * *px1++;
+
+        /* Decrement the loop counter */
+        k--;
+      }
+
+      b0 = (pB != NULL) ? ((q31_t) pB[i] << biasShift) : 0;
+
+      pDst[i] = arm_fully_connected_out_q7(acc0, b0, outShift, reluFlag);
+      pDst[numRows + i] = arm_fully_connected_out_q7(acc1, b0, outShift, reluFlag);
+    }
+
+    /* Advance to the next two vectors of the batch */
+    pSrc += 2u * numCols;
+    pDst += 2u * numRows;
+
+    /* Decrement the vector loop counter */
+    vec--;
+  }
+
+  /* Process the last vector when numVectors is odd.
+   ** Two rows are still processed per pass so that each input word is loaded once. */
+  if((numVectors & 1u) != 0u)
+  {
+    row = numRows >> 1u;
+    i = 0u;
+
+    while(row > 0u)
+    {
+      pW0 = pW + (i * numCols);
+      pW1 = pW0 + numCols;
+      px0 = pSrc;
+
+      acc0 = acc2 = 0;
+
+      col = numCols >> 2u;
+
+      while(col > 0u)
+      {
+        in = *__SIMD32(px0)++;
+        x0A = __SXTB16(__ROR(in, 8));
+        x0B = __SXTB16(in);
+
+        in = *__SIMD32(pW0)++;
+        acc0 = __SMLAD(__SXTB16(__ROR(in, 8)), x0A, acc0);
+        acc0 = __SMLAD(__SXTB16(in), x0B, acc0);
+        in = *__SIMD32(pW1)++;
+        acc2 = __SMLAD(__SXTB16(__ROR(in, 8)), x0A, acc2);
+        acc2 = __SMLAD(__SXTB16(in), x0B, acc2);
+
+        /* Decrement the loop counter */
+        col--;
+      }
+
+      k = numCols & 3u;
+
+      while(k > 0u)
+      {
+        acc0 += (q31_t) *pW0++ * *px0;
+        acc2 += (q31_t) *pW1++ * *px0++;
+
+        /* Decrement the loop counter */
+        k--;
+      }
+
+      b0 = (pB != NULL) ? ((q31_t) pB[i] << biasShift) : 0;
+      b1 = (pB != NULL) ? ((q31_t) pB[i + 1u] << biasShift) : 0;
+
+      pDst[i] = arm_fully_connected_out_q7(acc0, b0, outShift, reluFlag);
+      pDst[i + 1u] = arm_fully_connected_out_q7(acc2, b1, outShift, reluFlag);
+
+      i += 2u;
+
+      /* Decrement the row loop counter */
+      row--;
+    }
+
+    if((numRows & 1u) != 0u)
+    {
+      pW0 = pW + (i * numCols);
+      px0 = pSrc;
+
+      acc0 = 0;
+
+      col = numCols >> 2u;
+
+      while(col > 0u)
+      {
+        in = *__SIMD32(pW0)++;
+        wA = __SXTB16(__ROR(in, 8));
+        wB = __SXTB16(in);
+
+        in = *__SIMD32(px0)++;
+        acc0 = __SMLAD(wA, __SXTB16(__ROR(in, 8)), acc0);
+        acc0 = __SMLAD(wB, __SXTB16(in), acc0);
+
+        /* Decrement the loop counter */
+        col--;
+      }
+
+      k = numCols & 3u;
+
+      while(k > 0u)
+      {
+        acc0 += (q31_t) *pW0++ * *px0++;
+
+        /* Decrement the loop counter */
+        k--;
+      }
+
+      b0 = (pB != NULL) ? ((q31_t) pB[i] << biasShift) : 0;
+
+      pDst[i] = arm_fully_connected_out_q7(acc0, b0, outShift, reluFlag);
+    }
+  }
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  vec = numVectors;
+
+  while(vec > 0u)
+  {
+    pW0 = pW;
+
+    for (row = 0u; row < numRows; row++)
+    {
+      px0 = pSrc;
+      acc0 = 0;
+
+      col = numCols;
+
+      while(col > 0u)
+      {
+        acc0 += (q31_t) *pW0++ * *px0++;
+
+        /* Decrement the loop counter */
+        col--;
+      }
+
+      b0 = (pB != NULL) ? ((q31_t) pB[row] << biasShift) : 0;
+
+      pDst[row] = arm_fully_connected_out_q7(acc0, b0, outShift, reluFlag);
+    }
+
+    pSrc += numCols;
+    pDst += numRows;
+
+    /* Decrement the vector loop counter */
+    vec--;
+  }
+
+#endif /* #ifndef ARM_MATH_CM0_FAMILY */
+
+}
+
+/**
+ * @} end of FullyConnected group
+ */
@@ -0,0 +1,93 @@
+/* ----------------------------------------------------------------------
+* Copyright (C) 2010-2014 ARM Limited. All rights reserved.
+*
+* $Date:        19. October 2026
+* $Revision: 	V1.4.4
+*
+* Project: 	    CMSIS DSP Library
+* Title:	    arm_fully_connected_init_q15.c
+*
+* Description:	 Q15 fully connected layer initialization function.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions
+* are met:
+*   - Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   - Redistributions in binary form must reproduce the above copyright
+*     notice, this list of conditions and the following disclaimer in
+*     the documentation and/or other materials provided with the
+*     distribution.
+*   - Neither the name of ARM LIMITED nor the names of its contributors
+*     may be used to endorse or promote products derived from this
+*     software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------- */
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupMatrix
+ */
+
+/**
+ * @addtogroup FullyConnected
+ * @{
+ */
+
+/**
+ * @brief  Q15 fully connected layer initialization.
+ * @param[in,out] *S          points to an instance of the Q15 fully connected structure.
+ * @param[in]     numRows     number of outputs (rows of the weight matrix).
+ * @param[in]     numCols     number of inputs (columns of the weight matrix).
+ * @param[in]     *pWeights   points to the weight matrix stored in row order.
+ * @param[in]     *pBias      points to the bias vector of length numRows, or NULL for no bias.
+ * @param[in]     biasShift   left shift applied to the bias before it is added to the accumulator.
+ * @param[in]     outShift    right shift applied to the accumulator before saturation.
+ * @param[in]     reluFlag    flag that selects the ReLU epilogue. value = 0: no ReLU; value = 1: negative outputs are set to zero.
+ * @return        none
+ */
+
+void arm_fully_connected_init_q15(
+  arm_fully_connected_instance_q15 * S,
+  uint16_t numRows,
+  uint16_t numCols,
+  q15_t * pWeights,
+  q15_t * pBias,
+  int8_t biasShift,
+  int8_t outShift,
+  uint8_t reluFlag)
+{
+  /* Assign layer dimensions */
+  S->numRows = numRows;
+  S->numCols = numCols;
+
+  /* Assign weight and bias pointers */
+  S->pWeights = pWeights;
+  S->pBias = pBias;
+
+  /* Assign fixed-point scaling */
+  S->biasShift = biasShift;
+  S->outShift = outShift;
+
+  /* Assign ReLU epilogue flag */
+  S->reluFlag = reluFlag;
+}
+
+/**
+ * @} end of FullyConnected group
+ */
@@ -0,0 +1,293 @@
+/* ----------------------------------------------------------------------
+* Copyright (C) 2010-2014 ARM Limited. All rights reserved.
+*
+* $Date:        19. October 2026
+* $Revision: 	V1.4.4
+*
+* Project: 	    CMSIS DSP Library
+* Title:	    arm_moments_f32.c
+*
+* Description:	 Single pass statistics of a Floating-point vector.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions
+* are met:
+*   - Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   - Redistributions in binary form must reproduce the above copyright
+*     notice, this list of conditions and the following disclaimer in
+*     the documentation and/or other materials provided with the
+*     distribution.
+*   - Neither the name of ARM LIMITED nor the names of its contributors
+*     may be used to endorse or promote products derived from this
+*     software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------- */
+
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @defgroup moments Moments
+ *
+ * Computes in a single pass over the input vector the statistics that
+ * are otherwise obtained with separate calls to the mean, variance, standard
+ * deviation, rms, minimum and maximum functions, together with the
+ * skewness and kurtosis of the vector.
+ *
+ * <pre>
+ *     mean     = sum / blockSize
+ *     var      = (sumOfSquares - sum<sup>2</sup> / blockSize) / (blockSize - 1)
+ *     std      = sqrt(var)
+ *     rms      = sqrt(sumOfSquares / blockSize)
+ *     skewness = m<sub>3</sub> / m<sub>2</sub><sup>1.5</sup>
+ *     kurtosis = m<sub>4</sub> / m<sub>2</sub><sup>2</sup>
+ *
+ *     where m<sub>k</sub> = ((pSrc[0] - mean)<sup>k</sup> + ... + (pSrc[blockSize-1] - mean)<sup>k</sup>) / blockSize
+ * </pre>
+ *
+ * The minimum and maximum values are returned with the index of their first
+ * occurrence. The kurtosis is not reduced by 3, so a Gaussian signal gives 3.
+ *
+ * There are separate functions for floating point, Q31, and Q15 data types.
+ */
+
+/**
+ * @addtogroup moments
+ * @{
+ */
+
+/**
+ * @brief Single pass statistics of a floating-point vector.
+ * @param[in]       *pSrc points to the input vector
+ * @param[in]       blockSize length of the input vector
+ * @param[out]      *pResult points to the structure that receives the statistics
+ * @return none.
+ *
+ * \par
+ * The sums are accumulated relative to the first sample of the vector,
+ * which keeps the central moments accurate when the mean is large
+ * compared to the standard deviation.
+ */
+
+void arm_moments_f32(
+  float32_t * pSrc,
+  uint32_t blockSize,
+  arm_moments_result_f32 * pResult)
+{
+  float32_t shift = pSrc[0];                     /* Reference value of the sums */
+  float32_t sum = 0.0f;                          /* Sum of the shifted samples */
+  float32_t sumOfSquares = 0.0f;                 /* Sum of squares */
+  float32_t sumOfCubes = 0.0f;                   /* Sum of cubes */
+  float32_t sumOfQuarts = 0.0f;                  /* Sum of fourth powers */
+  float32_t minVal = pSrc[0], maxVal = pSrc[0];  /* Extreme values */
+  uint32_t minIndex = 0u, maxIndex = 0u;         /* Indices of the extreme values */
+  uint32_t index = 0u;                           /* Index of the current sample */
+  uint32_t blkCnt;                               /* loop counter */
+  float32_t in, d, sq;                           /* Input value, shifted value and its square */
+  float32_t n, mean, e2, e3, e4, m2, m3, m4;     /* Moments */
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  float32_t in1, in2, in3, in4;                  /* Temporary input values */
+  float32_t d1, d2, d3, d4;                      /* Temporary shifted values */
+
+  /*loop Unrolling */
+  blkCnt = blockSize >> 2u;
+
+  /* First part of the processing with loop unrolling.  Compute 4 outputs at a time.
+   ** a second loop below computes the remaining 1 to 3 samples. */
+  while(blkCnt > 0u)
+  {
+    in1 = pSrc[0];
+    in2 = pSrc[1];
+    in3 = pSrc[2];
+    in4 = pSrc[3];
+
+    d1 = in1 - shift;
+    d2 = in2 - shift;
+    d3 = in3 - shift;
+    d4 = in4 - shift;
+
+    /* C = D[0] + D[1] + ... with D[n] = A[n] - A[0], and its powers */
+    sum += (d1 + d2) + (d3 + d4);
+
+    sq = d1 * d1;
+    sumOfSquares += sq;
+    sumOfCubes += sq * d1;
+    sumOfQuarts += sq * sq;
+    sq = d2 * d2;
+    sumOfSquares += sq;
+    sumOfCubes += sq * d2;
+    sumOfQuarts += sq * sq;
+    sq = d3 * d3;
+    sumOfSquares += sq;
+    sumOfCubes += sq * d3;
+    sumOfQuarts += sq * sq;
+    sq = d4 * d4;
+    sumOfSquares += sq;
+    sumOfCubes += sq * d4;
+    sumOfQuarts += sq * sq;
+
+    /* Extreme values */
+    if(in1 < minVal)
+    {
+      minVal = in1;
+      minIndex = index;
+    }
+    if(in1 > maxVal)
+    {
+      maxVal = in1;
+      maxIndex = index;
+    }
+    if(in2 < minVal)
+    {
+      minVal = in2;
+      minIndex = index + 1u;
+    }
+    if(in2 > maxVal)
+    {
+      maxVal = in2;
+      maxIndex = index + 1u;
+    }
+    if(in3 < minVal)
+    {
+      minVal = in3;
+      minIndex = index + 2u;
+    }
+    if(in3 > maxVal)
+    {
+      maxVal = in3;
+      maxIndex = index + 2u;
+    }
+    if(in4 < minVal)
+    {
+      minVal = in4;
+      minIndex = index + 3u;
+    }
+    if(in4 > maxVal)
+    {
+      maxVal = in4;
+      maxIndex = index + 3u;
+    }
+
+    pSrc += 4u;
+    index += 4u;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* If the blockSize is not a multiple of 4, compute any remaining output samples here.
+   ** No loop unrolling is used. */
+  blkCnt = blockSize % 0x4u;
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  /* Loop over blockSize number of values */
+  blkCnt = blockSize;
+
+#endif /* #ifndef ARM_MATH_CM0_FAMILY */
+
+  while(blkCnt > 0u)
+  {
+    in = *pSrc++;
+
+    /* C = D[0] + D[1] + ... with D[n] = A[n] - A[0], and its powers */
+    d = in - shift;
+    sq = d * d;
+    sum += d;
+    sumOfSquares += sq;
+    sumOfCubes += sq * d;
+    sumOfQuarts += sq * sq;
+
+    if(in < minVal)
+    {
+      minVal = in;
+      minIndex = index;
+    }
+    if(in > maxVal)
+    {
+      maxVal = in;
+      maxIndex = index;
+    }
+
+    index++;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  pResult->min = minVal;
+  pResult->minIndex = minIndex;
+  pResult->max = maxVal;
+  pResult->maxIndex = maxIndex;
+
+  n = (float32_t) blockSize;
+
+  /* Raw moments of the shifted samples */
+  mean = sum / n;
+  e2 = sumOfSquares / n;
+  e3 = sumOfCubes / n;
+  e4 = sumOfQuarts / n;
+
+  pResult->mean = shift + mean;
+
+  /* Mean of the squares of the input: E[(D + shift)^2] */
+  arm_sqrt_f32(e2 + shift * (2.0f * mean + shift), &pResult->rms);
+
+  /* Variance: mean of the squares minus the square of the mean */
+  if(blockSize > 1u)
+  {
+    pResult->var = (sumOfSquares - sum * mean) / (n - 1.0f);
+  }
+  else
+  {
+    pResult->var = 0.0f;
+  }
+
+  arm_sqrt_f32(pResult->var, &pResult->std);
+
+  /* Central moments, invariant to the shift */
+  m2 = e2 - mean * mean;
+  m3 = e3 - 3.0f * mean * e2 + 2.0f * mean * mean * mean;
+  m4 = e4 - 4.0f * mean * e3 + 6.0f * mean * mean * e2 - 3.0f * mean * mean * mean * mean;
+
+  if(m2 > 0.0f)
+  {
+    arm_sqrt_f32(m2, &d);
+    pResult->skewness = m3 / (m2 * d);
+    pResult->kurtosis = m4 / (m2 * m2);
+  }
+  else
+  {
+    pResult->skewness = 0.0f;
+    pResult->kurtosis = 0.0f;
+  }
+}
+
+/**
+ * @} end of moments group
+ */
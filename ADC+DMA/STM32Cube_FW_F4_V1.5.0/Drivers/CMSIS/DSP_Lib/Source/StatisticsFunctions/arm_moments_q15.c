@@ -0,0 +1,278 @@
+/* ----------------------------------------------------------------------
+* Copyright (C) 2010-2014 ARM Limited. All rights reserved.
+*
+* $Date:        19. October 2026
+* $Revision: 	V1.4.4
+*
+* Project: 	    CMSIS DSP Library
+* Title:	    arm_moments_q15.c
+*
+* Description:	 Single pass statistics of a Q15 vector.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions
+* are met:
+*   - Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   - Redistributions in binary form must reproduce the above copyright
+*     notice, this list of conditions and the following disclaimer in
+*     the documentation and/or other materials provided with the
+*     distribution.
+*   - Neither the name of ARM LIMITED nor the names of its contributors
+*     may be used to endorse or promote products derived from this
+*     software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------- */
+
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @addtogroup moments
+ * @{
+ */
+
+/**
+ * @brief Single pass statistics of a Q15 vector.
+ * @param[in]       *pSrc points to the input vector
+ * @param[in]       blockSize length of the input vector
+ * @param[out]      *pResult points to the structure that receives the statistics
+ * @return none.
+ *
+ * @details
+ * <b>Scaling and Overflow Behavior:</b>
+ *
+ * \par
+ * The mean, variance, standard deviation and rms values are computed exactly as by
+ * <code>arm_mean_q15()</code>, <code>arm_var_q15()</code>, <code>arm_std_q15()</code>
+ * and <code>arm_rms_q15()</code> and are returned in 1.15 format.
+ * The sum of squares is accumulated in a 64-bit accumulator in 34.30 format,
+ * two samples at a time with a dual 16-bit multiply accumulate.
+ * \par
+ * The sum of cubes is accumulated in 19.45 format and the sum of fourth powers,
+ * truncated by 16 bits, in 20.44 format. Both accumulators are 64 bits wide, so
+ * a full scale input does not overflow them for a blockSize up to 262144.
+ * The central moments are formed from the sums in double precision, hence the
+ * skewness and kurtosis lose precision when the mean is much larger than the
+ * standard deviation.
+ */
+
+void arm_moments_q15(
+  q15_t * pSrc,
+  uint32_t blockSize,
+  arm_moments_result_q15 * pResult)
+{
+  q31_t sum = 0;                                 /* Sum of the input samples */
+  q63_t sumOfSquares = 0;                        /* Sum of squares */
+  q63_t sumOfCubes = 0;                          /* Sum of cubes */
+  q63_t sumOfQuarts = 0;                         /* Sum of fourth powers, >> 16 */
+  q31_t meanOfSquares, squareOfMean;             /* Temporary variables */
+  q15_t minVal = 0x7FFF, maxVal = (q15_t) 0x8000; /* Extreme values */
+  uint32_t minIndex = 0u, maxIndex = 0u;         /* Indices of the extreme values */
+  uint32_t index = 0u;                           /* Index of the current sample */
+  uint32_t blkCnt;                               /* loop counter */
+  q31_t x, x2;                                   /* Sample and its square */
+  float64_t n, mu, e2, e3, e4, m2, m3, m4;       /* Moments */
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  q31_t in1, in2;                                /* Packed input values */
+
+  /*loop Unrolling */
+  blkCnt = blockSize >> 2u;
+
+  /* First part of the processing with loop unrolling.  Compute 4 outputs at a time.
+   ** a second loop below computes the remaining 1 to 3 samples. */
+  while(blkCnt > 0u)
+  {
+    /* Read 4 samples as two packed words */
+    in1 = *__SIMD32(pSrc)++;
+    in2 = *__SIMD32(pSrc)++;
+
+    /* C = A[0] + A[1] + ... and A[0] * A[0] + A[1] * A[1] + ... */
+    sum += ((in1 << 16) >> 16);
+    sum += (in1 >> 16);
+    sum += ((in2 << 16) >> 16);
+    sum += (in2 >> 16);
+    sumOfSquares = __SMLALD(in1, in1, sumOfSquares);
+    sumOfSquares = __SMLALD(in2, in2, sumOfSquares);
+
+    /* Third and fourth powers and extreme values of each sample */
+    x = ((in1 << 16) >> 16);
+    x2 = x * x;
+    sumOfCubes += (q63_t) x2 * x;
+    sumOfQuarts += ((q63_t) x2 * x2) >> 16;
+    if(x < minVal)
+    {
+      minVal = (q15_t) x;
+      minIndex = index;
+    }
+    if(x > maxVal)
+    {
+      maxVal = (q15_t) x;
+      maxIndex = index;
+    }
+
+    x = (in1 >> 16);
+    x2 = x * x;
+    sumOfCubes += (q63_t) x2 * x;
+    sumOfQuarts += ((q63_t) x2 * x2) >> 16;
+    if(x < minVal)
+    {
+      minVal = (q15_t) x;
+      minIndex = index + 1u;
+    }
+    if(x > maxVal)
+    {
+      maxVal = (q15_t) x;
+      maxIndex = index + 1u;
+    }
+
+    x = ((in2 << 16) >> 16);
+    x2 = x * x;
+    sumOfCubes += (q63_t) x2 * x;
+    sumOfQuarts += ((q63_t) x2 * x2) >> 16;
+    if(x < minVal)
+    {
+      minVal = (q15_t) x;
+      minIndex = index + 2u;
+    }
+    if(x > maxVal)
+    {
+      maxVal = (q15_t) x;
+      maxIndex = index + 2u;
+    }
+
+    x = (in2 >> 16);
+    x2 = x * x;
+    sumOfCubes += (q63_t) x2 * x;
+    sumOfQuarts += ((q63_t) x2 * x2) >> 16;
+    if(x < minVal)
+    {
+      minVal = (q15_t) x;
+      minIndex = index + 3u;
+    }
+    if(x > maxVal)
+    {
+      maxVal = (q15_t) x;
+      maxIndex = index + 3u;
+    }
+
+    index += 4u;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* If the blockSize is not a multiple of 4, compute any remaining output samples here.
+   ** No loop unrolling is used. */
+  blkCnt = blockSize % 0x4u;
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  /* Loop over blockSize number of values */
+  blkCnt = blockSize;
+
+#endif /* #ifndef ARM_MATH_CM0_FAMILY */
+
+  while(blkCnt > 0u)
+  {
+    x = *pSrc++;
+    x2 = x * x;
+
+    /* C = A[0] + A[1] + ... and A[0] * A[0] + A[1] * A[1] + ... */
+    sum += x;
+    sumOfSquares += x2;
+    sumOfCubes += (q63_t) x2 * x;
+    sumOfQuarts += ((q63_t) x2 * x2) >> 16;
+
+    if(x < minVal)
+    {
+      minVal = (q15_t) x;
+      minIndex = index;
+    }
+    if(x > maxVal)
+    {
+      maxVal = (q15_t) x;
+      maxIndex = index;
+    }
+
+    index++;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  pResult->min = minVal;
+  pResult->minIndex = minIndex;
+  pResult->max = maxVal;
+  pResult->maxIndex = maxIndex;
+
+  /* Mean value, truncated to 1.15 format */
+  pResult->mean = (q15_t) (sum / (q31_t) blockSize);
+
+  /* Truncating and saturating the mean of squares to 1.15 format */
+  arm_sqrt_q15(__SSAT((sumOfSquares / (q63_t) blockSize) >> 15, 16), &pResult->rms);
+
+  /* Variance: mean of the squares minus the square of the mean */
+  if(blockSize > 1u)
+  {
+    meanOfSquares = (q31_t) (sumOfSquares / (q63_t) (blockSize - 1));
+    squareOfMean = (q31_t) ((q63_t) sum * sum / (q63_t) (blockSize * (blockSize - 1)));
+    pResult->var = (q15_t) ((meanOfSquares - squareOfMean) >> 15);
+  }
+  else
+  {
+    pResult->var = 0;
+  }
+
+  arm_sqrt_q15(pResult->var, &pResult->std);
+
+  /* Central moments from the raw moments, in units of 1.0 */
+  n = (float64_t) blockSize;
+  mu = (float64_t) sum / (n * 32768.0);
+  e2 = (float64_t) sumOfSquares / (n * 1073741824.0);
+  e3 = (float64_t) sumOfCubes / (n * 35184372088832.0);
+  e4 = (float64_t) sumOfQuarts / (n * 17592186044416.0);
+
+  m2 = e2 - mu * mu;
+  m3 = e3 - 3.0 * mu * e2 + 2.0 * mu * mu * mu;
+  m4 = e4 - 4.0 * mu * e3 + 6.0 * mu * mu * e2 - 3.0 * mu * mu * mu * mu;
+
+  if(m2 > 0.0)
+  {
+    pResult->skewness = (float32_t) (m3 / (m2 * sqrt(m2)));
+    pResult->kurtosis = (float32_t) (m4 / (m2 * m2));
+  }
+  else
+  {
+    pResult->skewness = 0.0f;
+    pResult->kurtosis = 0.0f;
+  }
+}
+
+/**
+ * @} end of moments group
+ */
@@ -0,0 +1,254 @@
+/* ----------------------------------------------------------------------
+* Copyright (C) 2010-2014 ARM Limited. All rights reserved.
+*
+* $Date:        19. October 2026
+* $Revision: 	V1.4.4
+*
+* Project: 	    CMSIS DSP Library
+* Title:	    arm_moments_q31.c
+*
+* Description:	 Single pass statistics of a Q31 vector.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions
+* are met:
+*   - Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   - Redistributions in binary form must reproduce the above copyright
+*     notice, this list of conditions and the following disclaimer in
+*     the documentation and/or other materials provided with the
+*     distribution.
+*   - Neither the name of ARM LIMITED nor the names of its contributors
+*     may be used to endorse or promote products derived from this
+*     software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------- */
+
+
+#include "arm_math.h"
+
+/**
+ * @ingroup groupStats
+ */
+
+/**
+ * @addtogroup moments
+ * @{
+ */
+
+/**
+ * @brief Single pass statistics of a Q31 vector.
+ * @param[in]       *pSrc points to the input vector
+ * @param[in]       blockSize length of the input vector
+ * @param[out]      *pResult points to the structure that receives the statistics
+ * @return none.
+ *
+ * @details
+ * <b>Scaling and Overflow Behavior:</b>
+ *
+ * \par
+ * The mean is accumulated in a 64-bit accumulator and truncated to 1.31 format,
+ * as by <code>arm_mean_q31()</code>.
+ * The variance and standard deviation are computed as by <code>arm_var_q31()</code>
+ * and <code>arm_std_q31()</code>: the input is downshifted by 8 bits to 1.23 format
+ * and the squares are accumulated in 2.46 format with 16 guard bits.
+ * The rms value is taken from the same sum of squares. To avoid overflows the input
+ * signal must be scaled down by log2(blockSize)-16 bits.
+ * \par
+ * The sums of cubes and fourth powers are accumulated from the upper 16 bits of
+ * the input, as described for <code>arm_moments_q15()</code>. The central moments
+ * are formed from the sums in double precision.
+ */
+
+void arm_moments_q31(
+  q31_t * pSrc,
+  uint32_t blockSize,
+  arm_moments_result_q31 * pResult)
+{
+  q63_t sum = 0;                                 /* Sum of the input samples */
+  q63_t sumShifted = 0;                          /* Sum of the 1.23 input samples */
+  q63_t sumOfSquares = 0;                        /* Sum of squares, 2.46 format */
+  q63_t sumOfCubes = 0;                          /* Sum of cubes */
+  q63_t sumOfQuarts = 0;                         /* Sum of fourth powers, >> 16 */
+  q63_t meanOfSquares, squareOfMean;             /* Temporary variables */
+  q31_t minVal = 0x7FFFFFFF, maxVal = (q31_t) 0x80000000; /* Extreme values */
+  uint32_t minIndex = 0u, maxIndex = 0u;         /* Indices of the extreme values */
+  uint32_t index = 0u;                           /* Index of the current sample */
+  uint32_t blkCnt;                               /* loop counter */
+  q31_t in, x, x2;                               /* Input value, upper 16 bits and square */
+  float64_t n, mu, e2, e3, e4, m2, m3, m4;       /* Moments */
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  q31_t in1, in2;                                /* Temporary input values */
+  uint32_t k;                                    /* Inner loop counter */
+
+  /*loop Unrolling */
+  blkCnt = blockSize >> 2u;
+
+  /* First part of the processing with loop unrolling.  Compute 4 outputs at a time.
+   ** a second loop below computes the remaining 1 to 3 samples. */
+  while(blkCnt > 0u)
+  {
+    /* C = A[0] + A[1] + ... and A[0] * A[0] + A[1] * A[1] + ... */
+    in1 = pSrc[0];
+    in2 = pSrc[1];
+    sum += in1;
+    sum += in2;
+    in1 >>= 8;
+    in2 >>= 8;
+    sumShifted += in1;
+    sumShifted += in2;
+    sumOfSquares += (q63_t) in1 * in1;
+    sumOfSquares += (q63_t) in2 * in2;
+
+    in1 = pSrc[2];
+    in2 = pSrc[3];
+    sum += in1;
+    sum += in2;
+    in1 >>= 8;
+    in2 >>= 8;
+    sumShifted += in1;
+    sumShifted += in2;
+    sumOfSquares += (q63_t) in1 * in1;
+    sumOfSquares += (q63_t) in2 * in2;
+
+    /* Third and fourth powers and extreme values of each sample */
+    for (k = 0u; k < 4u; k++)
+    {
+      in = pSrc[k];
+      x = in >> 16;
+      x2 = x * x;
+      sumOfCubes += (q63_t) x2 * x;
+      sumOfQuarts += ((q63_t) x2 * x2) >> 16;
+
+      if(in < minVal)
+      {
+        minVal = in;
+        minIndex = index + k;
+      }
+      if(in > maxVal)
+      {
+        maxVal = in;
+        maxIndex = index + k;
+      }
+    }
+
+    pSrc += 4u;
+    index += 4u;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  /* If the blockSize is not a multiple of 4, compute any remaining output samples here.
+   ** No loop unrolling is used. */
+  blkCnt = blockSize % 0x4u;
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  /* Loop over blockSize number of values */
+  blkCnt = blockSize;
+
+#endif /* #ifndef ARM_MATH_CM0_FAMILY */
+
+  while(blkCnt > 0u)
+  {
+    in = *pSrc++;
+
+    /* C = A[0] + A[1] + ... and A[0] * A[0] + A[1] * A[1] + ... */
+    sum += in;
+    sumShifted += (in >> 8);
+    sumOfSquares += (q63_t) (in >> 8) * (in >> 8);
+
+    x = in >> 16;
+    x2 = x * x;
+    sumOfCubes += (q63_t) x2 * x;
+    sumOfQuarts += ((q63_t) x2 * x2) >> 16;
+
+    if(in < minVal)
+    {
+      minVal = in;
+      minIndex = index;
+    }
+    if(in > maxVal)
+    {
+      maxVal = in;
+      maxIndex = index;
+    }
+
+    index++;
+
+    /* Decrement the loop counter */
+    blkCnt--;
+  }
+
+  pResult->min = minVal;
+  pResult->minIndex = minIndex;
+  pResult->max = maxVal;
+  pResult->maxIndex = maxIndex;
+
+  /* Mean value, truncated to 1.31 format */
+  pResult->mean = (q31_t) (sum / (int32_t) blockSize);
+
+  /* Mean of squares in 2.46 format, converted to 1.31 format */
+  arm_sqrt_q31(clip_q63_to_q31((sumOfSquares / (q63_t) blockSize) >> 15), &pResult->rms);
+
+  /* Variance: mean of the squares minus the square of the mean */
+  if(blockSize > 1u)
+  {
+    meanOfSquares = sumOfSquares / (q63_t) (blockSize - 1);
+    squareOfMean = sumShifted * sumShifted / (q63_t) (blockSize * (blockSize - 1u));
+    pResult->var = (q31_t) ((meanOfSquares - squareOfMean) >> 15);
+  }
+  else
+  {
+    pResult->var = 0;
+  }
+
+  arm_sqrt_q31(pResult->var, &pResult->std);
+
+  /* Central moments from the raw moments, in units of 1.0 */
+  n = (float64_t) blockSize;
+  mu = (float64_t) sum / (n * 2147483648.0);
+  e2 = (float64_t) sumOfSquares / (n * 70368744177664.0);
+  e3 = (float64_t) sumOfCubes / (n * 35184372088832.0);
+  e4 = (float64_t) sumOfQuarts / (n * 17592186044416.0);
+
+  m2 = e2 - mu * mu;
+  m3 = e3 - 3.0 * mu * e2 + 2.0 * mu * mu * mu;
+  m4 = e4 - 4.0 * mu * e3 + 6.0 * mu * mu * e2 - 3.0 * mu * mu * mu * mu;
+
+  if(m2 > 0.0)
+  {
+    pResult->skewness = (float32_t) (m3 / (m2 * sqrt(m2)));
+    pResult->kurtosis = (float32_t) (m4 / (m2 * m2));
+  }
+  else
+  {
+    pResult->skewness = 0.0f;
+    pResult->kurtosis = 0.0f;
+  }
+}
+
+/**
+ * @} end of moments group
+ */
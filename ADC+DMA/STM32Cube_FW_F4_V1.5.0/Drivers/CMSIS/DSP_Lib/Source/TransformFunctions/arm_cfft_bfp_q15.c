@@ -0,0 +1,276 @@
+/* ----------------------------------------------------------------------
+* Copyright (C) 2010-2014 ARM Limited. All rights reserved.
+*
+* $Date:        19. October 2026
+* $Revision: 	V1.4.4
+*
+* Project: 	    CMSIS DSP Library
+* Title:	    arm_cfft_bfp_q15.c
+*
+* Description:	 Block floating-point Q15 complex FFT with adaptive per-stage scaling.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions
+* are met:
+*   - Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   - Redistributions in binary form must reproduce the above copyright
+*     notice, this list of conditions and the following disclaimer in
+*     the documentation and/or other materials provided with the
+*     distribution.
+*   - Neither the name of ARM LIMITED nor the names of its contributors
+*     may be used to endorse or promote products derived from this
+*     software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------- */
+
+
+#include "arm_math.h"
+
+extern void arm_bitreversal_16(
+    uint16_t * pSrc,
+    const uint16_t bitRevLen,
+    const uint16_t * pBitRevTable);
+
+/**
+ * @ingroup groupTransforms
+ */
+
+/**
+ * @addtogroup ComplexFFT
+ * @{
+ */
+
+/**
+ * @brief  Block floating-point Q15 complex FFT.
+ * @param[in]      *S              points to an instance of the Q15 CFFT structure.
+ * @param[in, out] *p1             points to the complex data buffer of size <code>2*fftLen</code>. Processing occurs in-place.
+ * @param[in]      ifftFlag        flag that selects forward (ifftFlag=0) or inverse (ifftFlag=1) transform.
+ * @param[in]      bitReverseFlag  flag that enables (bitReverseFlag=1) or disables (bitReverseFlag=0) bit reversal of output.
+ * @param[out]     *pExponent      points to the block exponent of the result.
+ * @return none.
+ *
+ * \par
+ * The function uses the same instance structures and tables as <code>arm_cfft_q15()</code>
+ * (for example <code>arm_cfft_sR_q15_len4096</code>) but computes the transform with
+ * radix-2 decimation in frequency stages.
+ *
+ * <b>Scaling and Overflow Behavior:</b>
+ * \par
+ * <code>arm_cfft_q15()</code> scales the data down by a fixed 1/2 per radix-2 stage,
+ * so small inputs lose log2(fftLen) bits of precision before the first butterfly.
+ * This function instead tracks the magnitude of the block and, before each stage,
+ * shifts the data right by 0, 1 or 2 bits only as far as needed to keep the
+ * butterfly outputs from overflowing.
+ * The total number of right shifts is returned in <code>*pExponent</code>;
+ * the true transform is the output buffer multiplied by <code>2^(*pExponent)</code>.
+ * For a full scale input <code>*pExponent</code> equals log2(fftLen), the same as
+ * <code>arm_cfft_q15()</code>, while low level inputs keep up to log2(fftLen) extra bits.
+ * The inverse transform is not normalized by 1/fftLen.
+ */
+
+void arm_cfft_bfp_q15(
+  const arm_cfft_instance_q15 * S,
+  q15_t * p1,
+  uint8_t ifftFlag,
+  uint8_t bitReverseFlag,
+  int8_t * pExponent)
+{
+  const q15_t *pCoef = S->pTwiddle;              /* Twiddle factor table pointer */
+  uint32_t fftLen = S->fftLen;                   /* Length of the transform */
+  uint32_t n1, n2;                               /* Butterfly span and half span */
+  uint32_t twidStep;                             /* Twiddle factor index step */
+  uint32_t i, j, l;                              /* Loop counters and indices */
+  uint32_t bits = 0u;                            /* Magnitude bits of the block */
+  uint32_t newBits;                              /* Magnitude bits of the next block */
+  uint32_t shift;                                /* Right shift applied in the stage */
+  int32_t exponent = 0;                          /* Accumulated block exponent */
+  q31_t outR, outI;                              /* Butterfly outputs */
+  q15_t in;                                      /* Temporary input value */
+
+#ifndef ARM_MATH_CM0_FAMILY
+
+  /* Run the below code for Cortex-M4 and Cortex-M3 */
+
+  q31_t xa, xb;                                  /* Packed complex inputs */
+  q31_t sum, diff;                               /* Packed butterfly sum and difference */
+  q31_t coef;                                    /* Packed twiddle factor */
+
+  /* Find the magnitude bits of the input block */
+  for (i = 0u; i < (2u * fftLen); i++)
+  {
+    in = p1[i];
+    bits |= (uint32_t) (in ^ (in >> 15));
+  }
+
+  twidStep = 1u;
+
+  for (n1 = fftLen; n1 > 1u; n1 >>= 1u)
+  {
+    n2 = n1 >> 1u;
+
+    /* Choose the smallest shift that keeps |x| below 2^13, so that the
+     * butterfly difference rotated by the twiddle factor fits in Q15 */
+    shift = (bits < 0x2000u) ? 0u : ((bits < 0x4000u) ? 1u : 2u);
+    exponent += (int32_t) shift;
+    newBits = 0u;
+
+    for (j = 0u; j < n2; j++)
+    {
+      /* Read cos and sin values of the twiddle factor */
+      coef = _SIMD32_OFFSET(pCoef + (2u * j * twidStep));
+
+      for (i = j; i < fftLen; i += n1)
+      {
+        l = i + n2;
+
+        /* Read xa (real, imag) and xb (real, imag) */
+        xa = _SIMD32_OFFSET(p1 + (2u * i));
+        xb = _SIMD32_OFFSET(p1 + (2u * l));
+
+        /* Apply the stage scaling */
+        if(shift != 0u)
+        {
+          xa = __SHADD16(xa, 0);
+          xb = __SHADD16(xb, 0);
+
+          if(shift == 2u)
+          {
+            xa = __SHADD16(xa, 0);
+            xb = __SHADD16(xb, 0);
+          }
+        }
+
+        /* xa' = xa + xb */
+        sum = __QADD16(xa, xb);
+        /* xb' = (xa - xb) * W */
+        diff = __QSUB16(xa, xb);
+
+        if(ifftFlag == 0u)
+        {
+          /* outR = dR * cos + dI * sin, outI = dI * cos - dR * sin */
+          outR = __SMUAD(coef, diff) >> 15;
+          outI = __SMUSDX(coef, diff) >> 15;
+        }
+        else
+        {
+          /* outR = dR * cos - dI * sin, outI = dI * cos + dR * sin */
+          outR = __SMUSD(coef, diff) >> 15;
+          outI = __SMUADX(coef, diff) >> 15;
+        }
+
+        _SIMD32_OFFSET(p1 + (2u * i)) = sum;
+        _SIMD32_OFFSET(p1 + (2u * l)) = __PKHBT(outR, outI, 16);
+
+        /* Track the magnitude bits of the outputs */
+        in = (q15_t) sum;
+        newBits |= (uint32_t) (in ^ (in >> 15));
+        in = (q15_t) (sum >> 16);
+        newBits |= (uint32_t) (in ^ (in >> 15));
+        newBits |= (uint32_t) (outR ^ (outR >> 15));
+        newBits |= (uint32_t) (outI ^ (outI >> 15));
+      }
+    }
+
+    bits = newBits;
+    twidStep <<= 1u;
+  }
+
+#else
+
+  /* Run the below code for Cortex-M0 */
+
+  q31_t xaR, xaI, xbR, xbI;                      /* Complex inputs */
+  q31_t dR, dI;                                  /* Butterfly difference */
+  q31_t cosVal, sinVal;                          /* Twiddle factor */
+
+  /* Find the magnitude bits of the input block */
+  for (i = 0u; i < (2u * fftLen); i++)
+  {
+    in = p1[i];
+    bits |= (uint32_t) (in ^ (in >> 15));
+  }
+
+  twidStep = 1u;
+
+  for (n1 = fftLen; n1 > 1u; n1 >>= 1u)
+  {
+    n2 = n1 >> 1u;
+
+    /* Choose the smallest shift that keeps |x| below 2^13, so that the
+     * butterfly difference rotated by the twiddle factor fits in Q15 */
+    shift = (bits < 0x2000u) ? 0u : ((bits < 0x4000u) ? 1u : 2u);
+    exponent += (int32_t) shift;
+    newBits = 0u;
+
+    for (j = 0u; j < n2; j++)
+    {
+      /* Read cos and sin values of the twiddle factor */
+      cosVal = pCoef[2u * j * twidStep];
+      sinVal = pCoef[(2u * j * twidStep) + 1u];
+
+      if(ifftFlag != 0u)
+      {
+        sinVal = -sinVal;
+      }
+
+      for (i = j; i < fftLen; i += n1)
+      {
+        l = i + n2;
+
+        /* Read and scale xa (real, imag) and xb (real, imag) */
+        xaR = p1[2u * i] >> shift;
+        xaI = p1[(2u * i) + 1u] >> shift;
+        xbR = p1[2u * l] >> shift;
+        xbI = p1[(2u * l) + 1u] >> shift;
+
+        /* xa' = xa + xb */
+        p1[2u * i] = (q15_t) (xaR + xbR);
+        p1[(2u * i) + 1u] = (q15_t) (xaI + xbI);
+
+        /* xb' = (xa - xb) * W */
+        dR = xaR - xbR;
+        dI = xaI - xbI;
+        outR = ((cosVal * dR) + (sinVal * dI)) >> 15;
+        outI = ((cosVal * dI) - (sinVal * dR)) >> 15;
+
+        p1[2u * l] = (q15_t) outR;
+        p1[(2u * l) + 1u] = (q15_t) outI;
+
+        /* Track the magnitude bits of the outputs */
+        newBits |= (uint32_t) ((xaR + xbR) ^ ((xaR + xbR) >> 15));
+        newBits |= (uint32_t) ((xaI + xbI) ^ ((xaI + xbI) >> 15));
+        newBits |= (uint32_t) (outR ^ (outR >> 15));
+        newBits |= (uint32_t) (outI ^ (outI >> 15));
+      }
+    }
+
+    bits = newBits;
+    twidStep <<= 1u;
+  }
+
+#endif /* #ifndef ARM_MATH_CM0_FAMILY */
+
+  *pExponent = (int8_t) exponent;
+
+  if(bitReverseFlag)
+    arm_bitreversal_16((uint16_t *) p1, S->bitRevLength, S->pBitRevTable);
+}
+
+/**
+ * @} end of ComplexFFT group
+ */
@@ -82,6 +82,8 @@ extern void arm_bitreversal_32(
 * stages are performed along with a single radix-2 or radix-4 stage, as needed.
 * The algorithm supports lengths of [16, 32, 64, ..., 4096] and each length uses
 * a different twiddle factor table.  
+* The length 8192 is available when the tables are generated with
+* <code>DSP_Lib/Tools/FFTTableGen</code> (<code>ARM_FFT_TABLES_GENERATED</code>).
 * \par
 * The function uses the standard FFT definition and output values may grow by a
 * factor of <code>fftLen</code> when computing the forward transform.  The
@@ -144,6 +146,8 @@ extern void arm_bitreversal_32(
 * stages are performed along with a single radix-2 stage, as needed.
 * The algorithm supports lengths of [16, 32, 64, ..., 4096] and each length uses
 * a different twiddle factor table.  
+* The length 8192 is available when the tables are generated with
+* <code>DSP_Lib/Tools/FFTTableGen</code> (<code>ARM_FFT_TABLES_GENERATED</code>).
 * \par
 * The function uses the standard FFT definition and output values may grow by a
 * factor of <code>fftLen</code> when computing the forward transform.  The
@@ -596,6 +600,7 @@ void arm_cfft_f32(
     case 16: 
     case 128:
     case 1024:
+    case 8192:
         arm_cfft_radix8by2_f32  ( (arm_cfft_instance_f32 *) S, p1);
         break;
     case 32:
@@ -110,6 +110,7 @@ void arm_cfft_q31(
         case 128:
         case 512:
         case 2048:
+        case 8192:
             arm_cfft_radix4by2_inverse_q31  ( p1, L, S->pTwiddle );
             break;
         }  
@@ -130,6 +131,7 @@ void arm_cfft_q31(
         case 128:
         case 512:
         case 2048:
+        case 8192:
             arm_cfft_radix4by2_q31  ( p1, L, S->pTwiddle );
             break;
         }  
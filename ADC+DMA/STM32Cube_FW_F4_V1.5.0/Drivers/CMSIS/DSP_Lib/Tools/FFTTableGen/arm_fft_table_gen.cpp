@@ -0,0 +1,389 @@
+/* ----------------------------------------------------------------------
+* Copyright (C) 2010-2014 ARM Limited. All rights reserved.
+*
+* $Date:        19. October 2026
+* $Revision: 	V1.4.4
+*
+* Project: 	    CMSIS DSP Library
+* Title:	    arm_fft_table_gen.cpp
+*
+* Description:	 Host program that writes the FFT tables for the sizes
+*		 configured at build time as C sources.
+*
+* Target Processor: host (C++14)
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions
+* are met:
+*   - Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   - Redistributions in binary form must reproduce the above copyright
+*     notice, this list of conditions and the following disclaimer in
+*     the documentation and/or other materials provided with the
+*     distribution.
+*   - Neither the name of ARM LIMITED nor the names of its contributors
+*     may be used to endorse or promote products derived from this
+*     software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------- */
+
+/*
+ * Writes arm_fft_tables_gen.h and arm_fft_tables_gen.c with the twiddle
+ * factor tables, bit reversal tables and arm_cfft_sR_* instances for the
+ * sizes selected when the program is compiled, and prints the flash used
+ * by those tables next to the stock set of arm_common_tables.c.
+ *
+ *   g++ -std=c++14 -O2 -DARM_FFT_CFFT_SIZES=1024,4096 -DARM_FFT_RFFT_SIZES=2048 \
+ *       -DARM_FFT_TABLE_Q31=0 arm_fft_table_gen.cpp -o arm_fft_table_gen
+ *   ./arm_fft_table_gen <include dir> <source dir>
+ *
+ * The tables are computed by the compiler (see arm_fft_tables.hpp); the
+ * program only prints them.
+ */
+
+#include "arm_fft_tables.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+/* Complex FFT sizes: 16 to 8192, powers of two */
+#ifndef ARM_FFT_CFFT_SIZES
+#define ARM_FFT_CFFT_SIZES 16, 32, 64, 128, 256, 512, 1024, 2048, 4096
+#endif
+
+/* Floating-point real FFT sizes (arm_rfft_fast_f32): 32 to 8192, powers of two */
+#ifndef ARM_FFT_RFFT_SIZES
+#define ARM_FFT_RFFT_SIZES 32, 64, 128, 256, 512, 1024, 2048, 4096
+#endif
+
+/* Data types for which the complex FFT tables are generated */
+#ifndef ARM_FFT_TABLE_F32
+#define ARM_FFT_TABLE_F32 1
+#endif
+
+#ifndef ARM_FFT_TABLE_Q31
+#define ARM_FFT_TABLE_Q31 1
+#endif
+
+#ifndef ARM_FFT_TABLE_Q15
+#define ARM_FFT_TABLE_Q15 1
+#endif
+
+using namespace arm_fft_tables;
+
+namespace
+{
+
+/* Size of the arm_cfft_instance_* structures on a 32-bit target */
+const std::size_t instanceBytes = 16u;
+
+template <std::size_t... N>
+struct size_list
+{
+  static constexpr bool contains(std::size_t v)
+  {
+    const std::size_t list[] = { 0u, N... };
+
+    for (std::size_t i = 0; i < sizeof(list) / sizeof(list[0]); i++)
+    {
+      if(list[i] == v)
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+};
+
+typedef size_list<ARM_FFT_CFFT_SIZES> cfft_sizes;
+typedef size_list<ARM_FFT_RFFT_SIZES> rfft_sizes;
+
+constexpr bool is_pow2(std::size_t n)
+{
+  return (n != 0u) && ((n & (n - 1u)) == 0u);
+}
+
+struct output
+{
+  FILE *h;
+  FILE *c;
+  std::size_t bytes;
+};
+
+/* Macro names of the table lengths, as in arm_common_tables.h */
+std::string length_macro(std::size_t n, bool fixed)
+{
+  char buf[64];
+
+  if(fixed)
+  {
+    std::snprintf(buf, sizeof(buf), "ARMBITREVINDEXTABLE_FIXED%s%u_TABLE_LENGTH",
+                  (n < 100u) ? "___" : ((n < 1000u) ? "__" : "_"), (unsigned) n);
+  }
+  else
+  {
+    std::snprintf(buf, sizeof(buf), "ARMBITREVINDEXTABLE%s%u_TABLE_LENGTH",
+                  (n < 100u) ? "__" : ((n < 1000u) ? "_" : ""), (unsigned) n);
+  }
+
+  return buf;
+}
+
+std::string float_literal(float v)
+{
+  char buf[32];
+
+  std::snprintf(buf, sizeof(buf), "%.9g", (double) v);
+
+  if(std::strpbrk(buf, ".e") == nullptr)
+  {
+    std::strcat(buf, ".0");
+  }
+
+  return std::string(buf) + "f";
+}
+
+template <std::size_t L>
+void write_f32(output & out, const char * name, const table<float, L> & t)
+{
+  std::fprintf(out.h, "extern const float32_t %s[%u];\n", name, (unsigned) L);
+  std::fprintf(out.c, "const float32_t %s[%u] = {\n", name, (unsigned) L);
+
+  for (std::size_t i = 0; i < L; i += 2u)
+  {
+    std::fprintf(out.c, "    %s, %s%s\n", float_literal(t[i]).c_str(), float_literal(t[i + 1u]).c_str(),
+                 (i + 2u < L) ? "," : "");
+  }
+
+  std::fprintf(out.c, "};\n\n");
+  out.bytes += L * sizeof(float);
+}
+
+template <typename T, std::size_t L>
+void write_fixed(output & out, const char * type, const char * name, const table<T, L> & t)
+{
+  int digits = (int) (2u * sizeof(T));
+  unsigned long mask = (sizeof(T) == 4u) ? 0xFFFFFFFFul : 0xFFFFul;
+
+  std::fprintf(out.h, "extern const %s %s[%u];\n", type, name, (unsigned) L);
+  std::fprintf(out.c, "const %s %s[%u] = {\n", type, name, (unsigned) L);
+
+  for (std::size_t i = 0; i < L; i += 2u)
+  {
+    std::fprintf(out.c, "    0x%0*lX, 0x%0*lX%s\n",
+                 digits, (unsigned long) (long) t[i] & mask,
+                 digits, (unsigned long) (long) t[i + 1u] & mask,
+                 (i + 2u < L) ? "," : "");
+  }
+
+  std::fprintf(out.c, "};\n\n");
+  out.bytes += L * sizeof(T);
+}
+
+template <std::size_t L>
+void write_bitrev(output & out, const char * name, const std::string & lengthMacro, const table<std::uint16_t, L> & t)
+{
+  std::fprintf(out.h, "#define %s ((uint16_t)%u)\n", lengthMacro.c_str(), (unsigned) L);
+  std::fprintf(out.h, "extern const uint16_t %s[%s];\n", name, lengthMacro.c_str());
+  std::fprintf(out.c, "const uint16_t %s[%s] = {\n", name, lengthMacro.c_str());
+
+  for (std::size_t i = 0; i < L; i += 2u)
+  {
+    std::fprintf(out.c, "%s%u,%u%s", ((i % 16u) == 0u) ? "   " : " ",
+                 (unsigned) t[i], (unsigned) t[i + 1u],
+                 (i + 2u < L) ? (((i % 16u) == 14u) ? ",\n" : ",") : "\n");
+  }
+
+  std::fprintf(out.c, "};\n\n");
+  out.bytes += L * sizeof(std::uint16_t);
+}
+
+void write_instance(output & out, const char * type, std::size_t n, const char * twiddle,
+                    const char * bitrev, const std::string & lengthMacro)
+{
+  std::fprintf(out.h, "extern const arm_cfft_instance_%s arm_cfft_sR_%s_len%u;\n\n", type, type, (unsigned) n);
+  std::fprintf(out.c, "const arm_cfft_instance_%s arm_cfft_sR_%s_len%u = {\n\t%u, %s, %s, %s\n};\n\n",
+               type, type, (unsigned) n, (unsigned) n, twiddle, bitrev, lengthMacro.c_str());
+  out.bytes += instanceBytes;
+}
+
+/* All the tables of one complex FFT size */
+template <std::size_t N>
+void write_cfft(output & out)
+{
+  static_assert(is_pow2(N) && (N >= 16u) && (N <= 8192u), "complex FFT sizes are powers of two from 16 to 8192");
+
+  char twiddle[64];
+  char bitrev[64];
+
+  if(ARM_FFT_TABLE_F32)
+  {
+    static constexpr auto tw = twiddle_f32<N>();
+    static constexpr auto br = bitrev_table<N, order_f32>();
+
+    std::snprintf(twiddle, sizeof(twiddle), "twiddleCoef_%u", (unsigned) N);
+    std::snprintf(bitrev, sizeof(bitrev), "armBitRevIndexTable%u", (unsigned) N);
+
+    std::fprintf(out.h, "#define ARM_FFT_TABLE_F32_%u\n", (unsigned) N);
+    write_f32(out, twiddle, tw);
+    write_bitrev(out, bitrev, length_macro(N, false), br);
+    write_instance(out, "f32", N, twiddle, bitrev, length_macro(N, false));
+  }
+
+  if(ARM_FFT_TABLE_Q31 || ARM_FFT_TABLE_Q15)
+  {
+    static constexpr auto br = bitrev_table<N, order_fixed>();
+
+    std::snprintf(bitrev, sizeof(bitrev), "armBitRevIndexTable_fixed_%u", (unsigned) N);
+    write_bitrev(out, bitrev, length_macro(N, true), br);
+  }
+
+  if(ARM_FFT_TABLE_Q31)
+  {
+    static constexpr auto tw = twiddle_q31<N>();
+
+    std::snprintf(twiddle, sizeof(twiddle), "twiddleCoef_%u_q31", (unsigned) N);
+
+    std::fprintf(out.h, "#define ARM_FFT_TABLE_Q31_%u\n", (unsigned) N);
+    write_fixed(out, "q31_t", twiddle, tw);
+    write_instance(out, "q31", N, twiddle, bitrev, length_macro(N, true));
+  }
+
+  if(ARM_FFT_TABLE_Q15)
+  {
+    static constexpr auto tw = twiddle_q15<N>();
+
+    std::snprintf(twiddle, sizeof(twiddle), "twiddleCoef_%u_q15", (unsigned) N);
+
+    std::fprintf(out.h, "#define ARM_FFT_TABLE_Q15_%u\n", (unsigned) N);
+    write_fixed(out, "q15_t", twiddle, tw);
+    write_instance(out, "q15", N, twiddle, bitrev, length_macro(N, true));
+  }
+}
+
+/* The extra table of one floating-point real FFT size */
+template <std::size_t N>
+void write_rfft(output & out)
+{
+  static_assert(is_pow2(N) && (N >= 32u) && (N <= 8192u), "real FFT sizes are powers of two from 32 to 8192");
+  static_assert(ARM_FFT_TABLE_F32 && cfft_sizes::contains(N / 2u),
+                "a real FFT of size N needs the floating-point complex FFT of size N/2");
+
+  static constexpr auto tw = twiddle_rfft_f32<N>();
+  char name[64];
+
+  std::snprintf(name, sizeof(name), "twiddleCoef_rfft_%u", (unsigned) N);
+
+  std::fprintf(out.h, "#define ARM_FFT_TABLE_RFFT_F32_%u\n", (unsigned) N);
+  write_f32(out, name, tw);
+}
+
+template <std::size_t... N>
+void write_cfft_all(output & out, size_list<N...>)
+{
+  int expand[] = { 0, (write_cfft<N>(out), 0)... };
+  (void) expand;
+}
+
+template <std::size_t... N>
+void write_rfft_all(output & out, size_list<N...>)
+{
+  int expand[] = { 0, (write_rfft<N>(out), 0)... };
+  (void) expand;
+}
+
+/* Bytes of the FFT tables and instances of arm_common_tables.c and arm_const_structs.c */
+template <std::size_t N>
+constexpr std::size_t stock_cfft_bytes()
+{
+  return (2u * N * 4u) + (3u * N / 2u * 4u) + (3u * N / 2u * 2u)
+       + (bitrev_length<N, order_f32>() * 2u) + (bitrev_length<N, order_fixed>() * 2u)
+       + (3u * instanceBytes);
+}
+
+constexpr std::size_t stock_bytes()
+{
+  return stock_cfft_bytes<16>() + stock_cfft_bytes<32>() + stock_cfft_bytes<64>()
+       + stock_cfft_bytes<128>() + stock_cfft_bytes<256>() + stock_cfft_bytes<512>()
+       + stock_cfft_bytes<1024>() + stock_cfft_bytes<2048>() + stock_cfft_bytes<4096>()
+       + (32u + 64u + 128u + 256u + 512u + 1024u + 2048u + 4096u) * 4u;
+}
+
+const char header[] =
+  "/* Generated by arm_fft_table_gen from arm_fft_tables.hpp, do not edit. */\n\n";
+
+} /* namespace */
+
+int main(int argc, char * argv[])
+{
+  output out = { nullptr, nullptr, 0u };
+  std::string hPath, cPath;
+  std::size_t stock = stock_bytes();
+
+  if(argc != 3)
+  {
+    std::fprintf(stderr, "usage: %s <include dir> <source dir>\n", argv[0]);
+    return 1;
+  }
+
+  hPath = std::string(argv[1]) + "/arm_fft_tables_gen.h";
+  cPath = std::string(argv[2]) + "/arm_fft_tables_gen.c";
+
+  out.h = std::fopen(hPath.c_str(), "w");
+  out.c = std::fopen(cPath.c_str(), "w");
+
+  if((out.h == nullptr) || (out.c == nullptr))
+  {
+    std::fprintf(stderr, "cannot create %s or %s\n", hPath.c_str(), cPath.c_str());
+    return 1;
+  }
+
+  std::fprintf(out.h, "%s#ifndef _ARM_FFT_TABLES_GEN_H\n#define _ARM_FFT_TABLES_GEN_H\n\n#include \"arm_math.h\"\n\n", header);
+  std::fprintf(out.c, "%s#ifndef ARM_FFT_TABLES_GENERATED\n"
+                      "#error \"Build the DSP library with ARM_FFT_TABLES_GENERATED defined\"\n"
+                      "#endif\n\n"
+                      "#include \"arm_math.h\"\n#include \"arm_fft_tables_gen.h\"\n\n", header);
+
+  write_cfft_all(out, cfft_sizes());
+  write_rfft_all(out, rfft_sizes());
+
+  /* Table used by the radix-2 and radix-4 functions for all sizes */
+  if(ARM_FFT_TABLE_F32 && cfft_sizes::contains(4096u))
+  {
+    std::fprintf(out.h, "#define twiddleCoef twiddleCoef_4096\n\n");
+  }
+
+  std::fprintf(out.h, "#endif /* _ARM_FFT_TABLES_GEN_H */\n");
+
+  std::fclose(out.h);
+  std::fclose(out.c);
+
+  std::printf("FFT tables written to %s and %s\n", hPath.c_str(), cPath.c_str());
+  std::printf("  generated tables and instances : %7u bytes\n", (unsigned) out.bytes);
+  std::printf("  stock arm_common_tables.c set  : %7u bytes\n", (unsigned) stock);
+  if(out.bytes <= stock)
+  {
+    std::printf("  flash saved                    : %7u bytes (%u%%)\n",
+                (unsigned) (stock - out.bytes), (unsigned) (100u * (stock - out.bytes) / stock));
+  }
+  else
+  {
+    std::printf("  flash added                    : %7u bytes\n", (unsigned) (out.bytes - stock));
+  }
+
+  return 0;
+}
@@ -0,0 +1,395 @@
+/* ----------------------------------------------------------------------
+* Copyright (C) 2010-2014 ARM Limited. All rights reserved.
+*
+* $Date:        19. October 2026
+* $Revision: 	V1.4.4
+*
+* Project: 	    CMSIS DSP Library
+* Title:	    arm_fft_tables.hpp
+*
+* Description:	 Compile time generation of the FFT twiddle factor and
+*		 bit reversal tables.
+*
+* Target Processor: Cortex-M4/Cortex-M3/Cortex-M0, host (C++14)
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions
+* are met:
+*   - Redistributions of source code must retain the above copyright
+*     notice, this list of conditions and the following disclaimer.
+*   - Redistributions in binary form must reproduce the above copyright
+*     notice, this list of conditions and the following disclaimer in
+*     the documentation and/or other materials provided with the
+*     distribution.
+*   - Neither the name of ARM LIMITED nor the names of its contributors
+*     may be used to endorse or promote products derived from this
+*     software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+* "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+* LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+* FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+* COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+* BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+* LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+* ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+* POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------- */
+
+
+#ifndef _ARM_FFT_TABLES_HPP
+#define _ARM_FFT_TABLES_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * The tables below have the layout of the tables in arm_common_tables.c, so
+ * they can be emitted as C sources by arm_fft_table_gen.cpp or placed directly
+ * in flash from C++ code, for example
+ *
+ * <pre>
+ *   static constexpr auto tw = arm_fft_tables::twiddle_f32<4096>();
+ * </pre>
+ *
+ * All values are computed at compile time in double precision.
+ */
+
+namespace arm_fft_tables
+{
+
+/* ----------------------------------------------------------------------
+* Fixed size array usable in constant expressions
+* ------------------------------------------------------------------- */
+
+template <typename T, std::size_t N>
+struct table
+{
+  T data[N];
+
+  static constexpr std::size_t length = N;
+
+  constexpr const T & operator[](std::size_t i) const { return data[i]; }
+  constexpr T & operator[](std::size_t i) { return data[i]; }
+};
+
+/* ----------------------------------------------------------------------
+* Sine and cosine of 2*pi*m/n
+* ------------------------------------------------------------------- */
+
+struct cos_sin
+{
+  double c;
+  double s;
+};
+
+constexpr double pi = 3.14159265358979323846264338327950288;
+
+/* Taylor series, accurate to double precision for |x| <= pi/4 */
+constexpr double sin_series(double x)
+{
+  double x2 = x * x;
+  double term = x;
+  double sum = x;
+
+  for (int k = 1; k < 13; k++)
+  {
+    term *= -x2 / ((2.0 * k) * (2.0 * k + 1.0));
+    sum += term;
+  }
+
+  return sum;
+}
+
+constexpr double cos_series(double x)
+{
+  double x2 = x * x;
+  double term = 1.0;
+  double sum = 1.0;
+
+  for (int k = 1; k < 13; k++)
+  {
+    term *= -x2 / ((2.0 * k - 1.0) * (2.0 * k));
+    sum += term;
+  }
+
+  return sum;
+}
+
+/* The angle is folded into the first octant with integer arithmetic in units
+ * of 2*pi/(8*n), so the symmetries of the tables are exact for any n */
+constexpr cos_sin unit_root(std::size_t m, std::size_t n)
+{
+  std::uint64_t a = (8u * (std::uint64_t) m) % (8u * (std::uint64_t) n);
+  bool negSin = false;
+  bool negCos = false;
+  bool swap = false;
+  double x = 0.0;
+  cos_sin r = { 0.0, 0.0 };
+
+  if(a > 4u * n)
+  {
+    a = 8u * n - a;
+    negSin = true;
+  }
+  if(a > 2u * n)
+  {
+    a = 4u * n - a;
+    negCos = true;
+  }
+  if(a > n)
+  {
+    a = 2u * n - a;
+    swap = true;
+  }
+
+  x = pi * (double) a / (4.0 * (double) n);
+  r.c = swap ? sin_series(x) : cos_series(x);
+  r.s = swap ? cos_series(x) : sin_series(x);
+  r.c = negCos ? -r.c : r.c;
+  r.s = negSin ? -r.s : r.s;
+
+  return r;
+}
+
+/* ----------------------------------------------------------------------
+* Conversion to fixed-point: truncation towards minus infinity and
+* saturation, as used for the tables of arm_common_tables.c
+* ------------------------------------------------------------------- */
+
+constexpr std::int64_t to_fixed(double x, int fracBits)
+{
+  double scaled = x * (double) ((std::int64_t) 1 << fracBits);
+  std::int64_t v = (std::int64_t) scaled;
+  std::int64_t maxVal = ((std::int64_t) 1 << fracBits) - 1;
+
+  if((double) v > scaled)
+  {
+    v--;
+  }
+
+  return (v > maxVal) ? maxVal : ((v < -maxVal - 1) ? (-maxVal - 1) : v);
+}
+
+/* ----------------------------------------------------------------------
+* Twiddle factor tables
+* ------------------------------------------------------------------- */
+
+/* twiddleCoef_N: cos and sin of 2*pi*i/N for i = 0 .. N-1 */
+template <std::size_t N>
+constexpr table<float, 2 * N> twiddle_f32()
+{
+  table<float, 2 * N> t = {};
+
+  for (std::size_t i = 0; i < N; i++)
+  {
+    cos_sin w = unit_root(i, N);
+    t[2 * i] = (float) w.c;
+    t[2 * i + 1] = (float) w.s;
+  }
+
+  return t;
+}
+
+/* twiddleCoef_N_q31: cos and sin of 2*pi*i/N for i = 0 .. 3N/4-1 in 1.31 format */
+template <std::size_t N>
+constexpr table<std::int32_t, 3 * N / 2> twiddle_q31()
+{
+  table<std::int32_t, 3 * N / 2> t = {};
+
+  for (std::size_t i = 0; i < 3 * N / 4; i++)
+  {
+    cos_sin w = unit_root(i, N);
+    t[2 * i] = (std::int32_t) to_fixed(w.c, 31);
+    t[2 * i + 1] = (std::int32_t) to_fixed(w.s, 31);
+  }
+
+  return t;
+}
+
+/* twiddleCoef_N_q15: cos and sin of 2*pi*i/N for i = 0 .. 3N/4-1 in 1.15 format */
+template <std::size_t N>
+constexpr table<std::int16_t, 3 * N / 2> twiddle_q15()
+{
+  table<std::int16_t, 3 * N / 2> t = {};
+
+  for (std::size_t i = 0; i < 3 * N / 4; i++)
+  {
+    cos_sin w = unit_root(i, N);
+    t[2 * i] = (std::int16_t) to_fixed(w.c, 15);
+    t[2 * i + 1] = (std::int16_t) to_fixed(w.s, 15);
+  }
+
+  return t;
+}
+
+/* twiddleCoef_rfft_N: sin and cos of 2*pi*i/N for i = 0 .. N/2-1 */
+template <std::size_t N>
+constexpr table<float, N> twiddle_rfft_f32()
+{
+  table<float, N> t = {};
+
+  for (std::size_t i = 0; i < N / 2; i++)
+  {
+    cos_sin w = unit_root(i, N);
+    t[2 * i] = (float) w.s;
+    t[2 * i + 1] = (float) w.c;
+  }
+
+  return t;
+}
+
+/* ----------------------------------------------------------------------
+* Digit reversal tables
+*
+* The transform with radices r0, r1, ... (r0 applied last) leaves output k
+* at the position obtained by reversing the digits of k in that mixed
+* radix system. The tables hold the sequence of swaps that restores the
+* natural order, as pairs of byte offsets of 8 byte complex values, the
+* format read by arm_bitreversal_32() and arm_bitreversal_16().
+* ------------------------------------------------------------------- */
+
+struct radix_list
+{
+  std::size_t radix[32];
+  std::size_t count;
+};
+
+/* Radices of arm_cfft_f32(): one radix-2 or radix-4 stage, then radix-8 stages */
+struct order_f32
+{
+  static constexpr radix_list radices(std::size_t n)
+  {
+    radix_list r = { {0}, 0 };
+    std::size_t eights = 0;
+
+    while((n % 8u) == 0u && (n > 8u || eights == 0u))
+    {
+      n /= 8u;
+      eights++;
+    }
+
+    if(n > 1u)
+    {
+      r.radix[r.count++] = n;
+    }
+    while(eights-- > 0u)
+    {
+      r.radix[r.count++] = 8u;
+    }
+
+    return r;
+  }
+};
+
+/* Radices of arm_cfft_q31() and arm_cfft_q15(): plain bit reversal */
+struct order_fixed
+{
+  static constexpr radix_list radices(std::size_t n)
+  {
+    radix_list r = { {0}, 0 };
+
+    for (; n > 1u; n >>= 1u)
+    {
+      r.radix[r.count++] = 2u;
+    }
+
+    return r;
+  }
+};
+
+/* Any mixed radix factorization, for transforms outside the library */
+template <std::size_t... R>
+struct order_mixed
+{
+  static constexpr radix_list radices(std::size_t)
+  {
+    radix_list r = { { R... }, sizeof...(R) };
+
+    return r;
+  }
+};
+
+constexpr std::size_t digit_reverse(std::size_t k, const radix_list & r)
+{
+  std::size_t digits[32] = {0};
+  std::size_t p = 0;
+
+  for (std::size_t i = 0; i < r.count; i++)
+  {
+    digits[i] = k % r.radix[i];
+    k /= r.radix[i];
+  }
+
+  for (std::size_t i = 0; i < r.count; i++)
+  {
+    p = p * r.radix[i] + digits[i];
+  }
+
+  return p;
+}
+
+/* Runs the swap sequence, optionally storing it, and returns its length */
+template <std::size_t N, typename Order>
+constexpr std::size_t digit_reversal_swaps(std::uint16_t * pTable)
+{
+  const radix_list r = Order::radices(N);
+  std::size_t cur[N] = {0};                     /* value held at each position */
+  std::size_t pos[N] = {0};                     /* position of each value */
+  std::size_t length = 0;
+
+  for (std::size_t k = 0; k < N; k++)
+  {
+    cur[k] = k;
+    pos[k] = k;
+  }
+
+  for (std::size_t k = 0; k < N; k++)
+  {
+    std::size_t want = digit_reverse(k, r);
+
+    if(cur[k] != want)
+    {
+      std::size_t j = pos[want];
+
+      if(pTable != nullptr)
+      {
+        pTable[length] = (std::uint16_t) (8u * k);
+        pTable[length + 1] = (std::uint16_t) (8u * j);
+      }
+      length += 2u;
+
+      pos[cur[k]] = j;
+      cur[j] = cur[k];
+      cur[k] = want;
+      pos[want] = k;
+    }
+  }
+
+  return length;
+}
+
+template <std::size_t N, typename Order>
+constexpr std::size_t bitrev_length()
+{
+  return digit_reversal_swaps<N, Order>(nullptr);
+}
+
+template <std::size_t N, typename Order>
+constexpr table<std::uint16_t, bitrev_length<N, Order>()> bitrev_table()
+{
+  static_assert(8u * (N - 1u) <= 0xFFFFu, "byte offsets must fit in 16 bits");
+
+  table<std::uint16_t, bitrev_length<N, Order>()> t = {};
+
+  digit_reversal_swaps<N, Order>(t.data);
+
+  return t;
+}
+
+} /* namespace arm_fft_tables */
+
+#endif /* _ARM_FFT_TABLES_HPP */
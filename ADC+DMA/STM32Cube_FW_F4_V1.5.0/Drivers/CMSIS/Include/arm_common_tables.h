@@ -48,6 +48,13 @@ extern const q15_t armRecipTableQ15[64];
 extern const q31_t armRecipTableQ31[64];
 //extern const q31_t realCoefAQ31[1024];
 //extern const q31_t realCoefBQ31[1024];
+#ifdef ARM_FFT_TABLES_GENERATED
+/* FFT tables of the sizes selected for arm_fft_table_gen (DSP_Lib/Tools/FFTTableGen) */
+#include "arm_fft_tables_gen.h"
+#else
+/* all the FFT tables are present */
+#define ARM_ALL_FFT_TABLES
+
 extern const float32_t twiddleCoef_16[32];
 extern const float32_t twiddleCoef_32[64];
 extern const float32_t twiddleCoef_64[128];
@@ -128,6 +135,8 @@ extern const uint16_t armBitRevIndexTable_fixed_1024[ARMBITREVINDEXTABLE_FIXED_1
 extern const uint16_t armBitRevIndexTable_fixed_2048[ARMBITREVINDEXTABLE_FIXED_2048_TABLE_LENGTH];
 extern const uint16_t armBitRevIndexTable_fixed_4096[ARMBITREVINDEXTABLE_FIXED_4096_TABLE_LENGTH];
 
+#endif /* ARM_FFT_TABLES_GENERATED */
+
 /* Tables for Fast Math Sine and Cosine */
 extern const float32_t sinTable_f32[FAST_MATH_TABLE_SIZE + 1];
 extern const q31_t sinTable_q31[FAST_MATH_TABLE_SIZE + 1];
@@ -46,6 +46,9 @@
 #include "arm_math.h"
 #include "arm_common_tables.h"
 
+/* Instances of the generated tables are declared in arm_fft_tables_gen.h */
+#ifndef ARM_FFT_TABLES_GENERATED
+
    extern const arm_cfft_instance_f32 arm_cfft_sR_f32_len16;
    extern const arm_cfft_instance_f32 arm_cfft_sR_f32_len32;
    extern const arm_cfft_instance_f32 arm_cfft_sR_f32_len64;
@@ -76,4 +79,6 @@
    extern const arm_cfft_instance_q15 arm_cfft_sR_q15_len2048;
    extern const arm_cfft_instance_q15 arm_cfft_sR_q15_len4096;
 
+#endif /* ARM_FFT_TABLES_GENERATED */
+
 #endif
@@ -131,6 +131,12 @@
    *
    * Initialize macro __FPU_PRESENT = 1 when building on FPU supported Targets. Enable this macro for M4bf and M4lf libraries
    *
+   * - ARM_MATH_HOST:
+   *
+   * Define macro ARM_MATH_HOST, with ARM_MATH_CM0, to build the library and the examples on a PC. The CFFT bit reversal is then
+   * taken from arm_bitreversal2.c instead of arm_bitreversal2.S, and the examples leave the DWT cycle counter alone, print
+   * PASS or FAIL and return it as the exit status.
+   *
    * <hr>
    * CMSIS-DSP in ARM::CMSIS Pack
    * -----------------------------
@@ -1807,6 +1813,160 @@ extern "C"
   float32_t * pData);
 
 
+  /**
+   * @brief Instance structure for the floating-point batched fully connected layer.
+   */
+
+  typedef struct
+  {
+    uint16_t numRows;     /**< number of outputs (rows of the weight matrix). */
+    uint16_t numCols;     /**< number of inputs (columns of the weight matrix). */
+    float32_t *pWeights;  /**< points to the weight matrix stored in row order. */
+    float32_t *pBias;     /**< points to the bias vector of length numRows, or NULL. */
+    uint8_t reluFlag;     /**< flag that selects the ReLU epilogue. */
+  } arm_fully_connected_instance_f32;
+
+  /**
+   * @brief Instance structure for the Q15 batched fully connected layer.
+   */
+
+  typedef struct
+  {
+    uint16_t numRows;     /**< number of outputs (rows of the weight matrix). */
+    uint16_t numCols;     /**< number of inputs (columns of the weight matrix). */
+    q15_t *pWeights;      /**< points to the weight matrix stored in row order. */
+    q15_t *pBias;         /**< points to the bias vector of length numRows, or NULL. */
+    int8_t biasShift;     /**< left shift applied to the bias before accumulation. */
+    int8_t outShift;      /**< right shift applied to the accumulator before saturation. */
+    uint8_t reluFlag;     /**< flag that selects the ReLU epilogue. */
+  } arm_fully_connected_instance_q15;
+
+  /**
+   * @brief Instance structure for the Q7 batched fully connected layer.
+   */
+
+  typedef struct
+  {
+    uint16_t numRows;     /**< number of outputs (rows of the weight matrix). */
+    uint16_t numCols;     /**< number of inputs (columns of the weight matrix). */
+    q7_t *pWeights;       /**< points to the weight matrix stored in row order. */
+    q7_t *pBias;          /**< points to the bias vector of length numRows, or NULL. */
+    int8_t biasShift;     /**< left shift applied to the bias before accumulation. */
+    int8_t outShift;      /**< right shift applied to the accumulator before saturation. */
+    uint8_t reluFlag;     /**< flag that selects the ReLU epilogue. */
+  } arm_fully_connected_instance_q7;
+
+  /**
+   * @brief Batched floating-point fully connected layer.
+   * @param[in]       *S          points to an instance of the floating-point fully connected structure.
+   * @param[in]       *pSrc       points to the batch of input vectors (numVectors x numCols).
+   * @param[out]      *pDst       points to the batch of output vectors (numVectors x numRows).
+   * @param[in]       numVectors  number of input vectors in the batch.
+   * @return none.
+   */
+
+  void arm_fully_connected_batch_f32(
+  const arm_fully_connected_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint16_t numVectors);
+
+  /**
+   * @brief Batched Q15 fully connected layer.
+   * @param[in]       *S          points to an instance of the Q15 fully connected structure.
+   * @param[in]       *pSrc       points to the batch of input vectors (numVectors x numCols).
+   * @param[out]      *pDst       points to the batch of output vectors (numVectors x numRows).
+   * @param[in]       numVectors  number of input vectors in the batch.
+   * @return none.
+   */
+
+  void arm_fully_connected_batch_q15(
+  const arm_fully_connected_instance_q15 * S,
+  q15_t * pSrc,
+  q15_t * pDst,
+  uint16_t numVectors);
+
+  /**
+   * @brief Batched Q7 fully connected layer.
+   * @param[in]       *S          points to an instance of the Q7 fully connected structure.
+   * @param[in]       *pSrc       points to the batch of input vectors (numVectors x numCols).
+   * @param[out]      *pDst       points to the batch of output vectors (numVectors x numRows).
+   * @param[in]       numVectors  number of input vectors in the batch.
+   * @return none.
+   */
+
+  void arm_fully_connected_batch_q7(
+  const arm_fully_connected_instance_q7 * S,
+  q7_t * pSrc,
+  q7_t * pDst,
+  uint16_t numVectors);
+
+  /**
+   * @brief  Floating-point fully connected layer initialization.
+   * @param[in,out] *S          points to an instance of the floating-point fully connected structure.
+   * @param[in]     numRows     number of outputs.
+   * @param[in]     numCols     number of inputs.
+   * @param[in]     *pWeights   points to the weight matrix stored in row order.
+   * @param[in]     *pBias      points to the bias vector, or NULL.
+   * @param[in]     reluFlag    flag that selects the ReLU epilogue.
+   * @return        none
+   */
+
+  void arm_fully_connected_init_f32(
+  arm_fully_connected_instance_f32 * S,
+  uint16_t numRows,
+  uint16_t numCols,
+  float32_t * pWeights,
+  float32_t * pBias,
+  uint8_t reluFlag);
+
+  /**
+   * @brief  Q15 fully connected layer initialization.
+   * @param[in,out] *S          points to an instance of the Q15 fully connected structure.
+   * @param[in]     numRows     number of outputs.
+   * @param[in]     numCols     number of inputs.
+   * @param[in]     *pWeights   points to the weight matrix stored in row order.
+   * @param[in]     *pBias      points to the bias vector, or NULL.
+   * @param[in]     biasShift   left shift applied to the bias.
+   * @param[in]     outShift    right shift applied to the accumulator.
+   * @param[in]     reluFlag    flag that selects the ReLU epilogue.
+   * @return        none
+   */
+
+  void arm_fully_connected_init_q15(
+  arm_fully_connected_instance_q15 * S,
+  uint16_t numRows,
+  uint16_t numCols,
+  q15_t * pWeights,
+  q15_t * pBias,
+  int8_t biasShift,
+  int8_t outShift,
+  uint8_t reluFlag);
+
+  /**
+   * @brief  Q7 fully connected layer initialization.
+   * @param[in,out] *S          points to an instance of the Q7 fully connected structure.
+   * @param[in]     numRows     number of outputs.
+   * @param[in]     numCols     number of inputs.
+   * @param[in]     *pWeights   points to the weight matrix stored in row order.
+   * @param[in]     *pBias      points to the bias vector, or NULL.
+   * @param[in]     biasShift   left shift applied to the bias.
+   * @param[in]     outShift    right shift applied to the accumulator.
+   * @param[in]     reluFlag    flag that selects the ReLU epilogue.
+   * @return        none
+   */
+
+  void arm_fully_connected_init_q7(
+  arm_fully_connected_instance_q7 * S,
+  uint16_t numRows,
+  uint16_t numCols,
+  q7_t * pWeights,
+  q7_t * pBias,
+  int8_t biasShift,
+  int8_t outShift,
+  uint8_t reluFlag);
+
+
 
   /**
    * @brief Instance structure for the Q15 PID Control.
@@ -2220,6 +2380,23 @@ void arm_cfft_q15(
     uint8_t ifftFlag,
     uint8_t bitReverseFlag);  
 
+  /**
+   * @brief  Block floating-point Q15 complex FFT.
+   * @param[in]      *S              points to an instance of the Q15 CFFT structure.
+   * @param[in, out] *p1             points to the complex data buffer. Processing occurs in-place.
+   * @param[in]      ifftFlag        flag that selects forward (ifftFlag=0) or inverse (ifftFlag=1) transform.
+   * @param[in]      bitReverseFlag  flag that enables (bitReverseFlag=1) or disables (bitReverseFlag=0) bit reversal of output.
+   * @param[out]     *pExponent      points to the block exponent of the result.
+   * @return none.
+   */
+
+void arm_cfft_bfp_q15( 
+    const arm_cfft_instance_q15 * S, 
+    q15_t * p1,
+    uint8_t ifftFlag,
+    uint8_t bitReverseFlag,
+    int8_t * pExponent);  
+
   /**
    * @brief Instance structure for the fixed-point CFFT/CIFFT function.
    */
@@ -3609,6 +3786,72 @@ void arm_rfft_fast_f32(
   uint32_t blockSize);
 
 
+  /**
+   * @brief Instance structure for the floating-point digital down converter.
+   */
+
+  typedef struct
+  {
+    uint32_t phase;                     /**< NCO phase accumulator, 2^32 is one cycle. */
+    uint32_t phaseInc;                  /**< NCO phase increment per input sample. */
+    uint8_t numStages;                  /**< number of CIC integrator and comb stages. */
+    uint16_t R;                         /**< CIC decimation factor. */
+    uint16_t count;                     /**< input samples left before the next CIC output. */
+    float32_t cicInScale;               /**< scale of the mixer output to the CIC integer range. */
+    float32_t cicOutScale;              /**< scale of the CIC output back to the input range, 1/(cicInScale*R^numStages). */
+    q31_t *pCicState;                   /**< points to the CIC state array of length 4*numStages: I and Q integrators, then I and Q combs. */
+    float32_t *pScratch;                /**< points to the CIC output array of length 2*blockSize/R. */
+    arm_fir_decimate_instance_f32 firI; /**< compensating FIR decimator of the in-phase channel. */
+    arm_fir_decimate_instance_f32 firQ; /**< compensating FIR decimator of the quadrature channel. */
+  } arm_ddc_instance_f32;
+
+  /**
+   * @brief Processing function for the floating-point digital down converter.
+   * @param[in,out] *S points to an instance of the floating-point digital down converter structure.
+   * @param[in] *pSrc points to the block of real input data.
+   * @param[out] *pDst points to the block of complex output data, blockSize/(R*M) interleaved samples.
+   * @param[in] blockSize number of input samples to process per call.
+   * @return none
+   */
+
+  void arm_ddc_f32(
+  arm_ddc_instance_f32 * S,
+  float32_t * pSrc,
+  float32_t * pDst,
+  uint32_t blockSize);
+
+  /**
+   * @brief  Initialization function for the floating-point digital down converter.
+   * @param[in,out] *S points to an instance of the floating-point digital down converter structure.
+   * @param[in] centerFreq NCO frequency normalized to the input sample rate, in the range [-0.5 0.5).
+   * @param[in] numStages number of CIC stages.
+   * @param[in] R CIC decimation factor.
+   * @param[in] numTaps number of coefficients of the compensating FIR.
+   * @param[in] M decimation factor of the compensating FIR.
+   * @param[in] *pCoeffs points to the compensating FIR coefficients.
+   * @param[in] *pState points to the FIR state buffer of length 2*(numTaps+blockSize/R-1).
+   * @param[in] *pCicState points to the CIC state buffer of length 4*numStages.
+   * @param[in] *pScratch points to the scratch buffer of length 2*blockSize/R.
+   * @param[in] blockSize number of input samples to process per call.
+   * @return    The function returns ARM_MATH_SUCCESS if initialization is successful, ARM_MATH_LENGTH_ERROR if
+   * <code>blockSize</code> is not a multiple of <code>R*M</code> or ARM_MATH_ARGUMENT_ERROR if the CIC gain leaves
+   * less than 12 bits for the input.
+   */
+
+  arm_status arm_ddc_init_f32(
+  arm_ddc_instance_f32 * S,
+  float32_t centerFreq,
+  uint8_t numStages,
+  uint16_t R,
+  uint16_t numTaps,
+  uint8_t M,
+  float32_t * pCoeffs,
+  float32_t * pState,
+  q31_t * pCicState,
+  float32_t * pScratch,
+  uint32_t blockSize);
+
+
 
   /**
    * @brief Instance structure for the Q15 FIR interpolator.
@@ -6664,6 +6907,99 @@ void arm_rfft_fast_f32(
   uint32_t blockSize,
   q15_t * pResult);
 
+  /**
+   * @brief Statistics of a floating-point vector returned by arm_moments_f32().
+   */
+
+  typedef struct
+  {
+    float32_t mean;               /**< mean value. */
+    float32_t var;                /**< variance, normalized by blockSize-1. */
+    float32_t std;                /**< standard deviation. */
+    float32_t rms;                /**< root mean square value. */
+    float32_t min;                /**< minimum value. */
+    float32_t max;                /**< maximum value. */
+    uint32_t minIndex;            /**< index of the first minimum value. */
+    uint32_t maxIndex;            /**< index of the first maximum value. */
+    float32_t skewness;           /**< skewness, m3 / m2^1.5. */
+    float32_t kurtosis;           /**< kurtosis, m4 / m2^2 (3 for a Gaussian). */
+  } arm_moments_result_f32;
+
+  /**
+   * @brief  Mean, variance, standard deviation, rms, minimum, maximum, skewness and kurtosis of a floating-point vector in one pass.
+   * @param[in]  *pSrc is input pointer
+   * @param[in]  blockSize is the number of samples to process
+   * @param[out]  *pResult points to the structure that receives the statistics.
+   * @return none.
+   */
+
+  void arm_moments_f32(
+  float32_t * pSrc,
+  uint32_t blockSize,
+  arm_moments_result_f32 * pResult);
+
+  /**
+   * @brief Statistics of a Q31 vector returned by arm_moments_q31().
+   */
+
+  typedef struct
+  {
+    q31_t mean;                   /**< mean value. */
+    q31_t var;                    /**< variance, normalized by blockSize-1. */
+    q31_t std;                    /**< standard deviation. */
+    q31_t rms;                    /**< root mean square value. */
+    q31_t min;                    /**< minimum value. */
+    q31_t max;                    /**< maximum value. */
+    uint32_t minIndex;            /**< index of the first minimum value. */
+    uint32_t maxIndex;            /**< index of the first maximum value. */
+    float32_t skewness;           /**< skewness, m3 / m2^1.5. */
+    float32_t kurtosis;           /**< kurtosis, m4 / m2^2 (3 for a Gaussian). */
+  } arm_moments_result_q31;
+
+  /**
+   * @brief  Mean, variance, standard deviation, rms, minimum, maximum, skewness and kurtosis of a Q31 vector in one pass.
+   * @param[in]  *pSrc is input pointer
+   * @param[in]  blockSize is the number of samples to process
+   * @param[out]  *pResult points to the structure that receives the statistics.
+   * @return none.
+   */
+
+  void arm_moments_q31(
+  q31_t * pSrc,
+  uint32_t blockSize,
+  arm_moments_result_q31 * pResult);
+
+  /**
+   * @brief Statistics of a Q15 vector returned by arm_moments_q15().
+   */
+
+  typedef struct
+  {
+    q15_t mean;                   /**< mean value. */
+    q15_t var;                    /**< variance, normalized by blockSize-1. */
+    q15_t std;                    /**< standard deviation. */
+    q15_t rms;                    /**< root mean square value. */
+    q15_t min;                    /**< minimum value. */
+    q15_t max;                    /**< maximum value. */
+    uint32_t minIndex;            /**< index of the first minimum value. */
+    uint32_t maxIndex;            /**< index of the first maximum value. */
+    float32_t skewness;           /**< skewness, m3 / m2^1.5. */
+    float32_t kurtosis;           /**< kurtosis, m4 / m2^2 (3 for a Gaussian). */
+  } arm_moments_result_q15;
+
+  /**
+   * @brief  Mean, variance, standard deviation, rms, minimum, maximum, skewness and kurtosis of a Q15 vector in one pass.
+   * @param[in]  *pSrc is input pointer
+   * @param[in]  blockSize is the number of samples to process
+   * @param[out]  *pResult points to the structure that receives the statistics.
+   * @return none.
+   */
+
+  void arm_moments_q15(
+  q15_t * pSrc,
+  uint32_t blockSize,
+  arm_moments_result_q15 * pResult);
+
   /**
    * @brief  Floating-point complex magnitude
    * @param[in]  *pSrc points to the complex input vector